@@ -18,7 +18,10 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "openbl_core.h"
+#include "openbl_mem.h"
+#include "openbl_perf.h"
 #include "app_openbootloader.h"
+#include "common_interface.h"
 #include <stdbool.h>
 
 /* Private typedef -----------------------------------------------------------*/
@@ -28,24 +31,71 @@
 static uint32_t NumberOfInterfaces = 0U;
 static OPENBL_HandleTypeDef a_InterfacesTable[INTERFACES_SUPPORTED];
 static OPENBL_HandleTypeDef *p_Interface;
+static uint8_t a_InterfacesInitialized[INTERFACES_SUPPORTED];
+
+/* Buffer arena shared by the command modules, word aligned to hold the special command frame */
+static uint32_t a_BufferArena[(OPENBL_BUFFER_ARENA_SIZE + 3U) / 4U];
 
 /* Private function prototypes -----------------------------------------------*/
+static void OPENBL_FastBoot(void);
+
 /* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to jump to the application without initializing the interfaces
+  *         when the bootloader has not been requested and the application is valid.
+  *         The memories are not registered yet, the jump does not go through the memory interfaces.
+  * @retval None.
+  */
+static void OPENBL_FastBoot(void)
+{
+  if ((Common_GetBootRequest() == RESET) && (OPENBL_MEM_CheckApplication(OPENBL_APP_ADDRESS) == SUCCESS))
+  {
+    Common_JumpToApplication(OPENBL_APP_ADDRESS);
+  }
+}
+
 /* Exported functions --------------------------------------------------------*/
 
 /**
   * @brief  This function is used to initialize the registered interfaces in the Open Bootloader MW.
+  *         In fast boot mode, a valid application is started first and the interfaces are not initialized.
+  *         In lazy init mode, the interfaces supporting it only arm their activity detection, they are
+  *         initialized by OPENBL_InterfaceDetection once activity is detected.
   * @retval None.
   */
 void OPENBL_Init(void)
 {
   uint32_t counter;
 
+  if (OPENBL_FAST_BOOT == 1U)
+  {
+    OPENBL_FastBoot();
+  }
+
+  if (OPENBL_PERF_ENABLE == 1U)
+  {
+    OPENBL_PERF_Init();
+  }
+
   for (counter = 0U; counter < NumberOfInterfaces; counter++)
   {
-    if (a_InterfacesTable[counter].p_Ops->Init != NULL)
+    if ((OPENBL_LAZY_INIT == 1U)
+        && (a_InterfacesTable[counter].p_Ops->ArmDetection != NULL)
+        && (a_InterfacesTable[counter].p_Ops->ActivityDetected != NULL))
     {
-      a_InterfacesTable[counter].p_Ops->Init();
+      a_InterfacesTable[counter].p_Ops->ArmDetection();
+
+      a_InterfacesInitialized[counter] = 0U;
+    }
+    else
+    {
+      if (a_InterfacesTable[counter].p_Ops->Init != NULL)
+      {
+        a_InterfacesTable[counter].p_Ops->Init();
+      }
+
+      a_InterfacesInitialized[counter] = 1U;
     }
   }
 }
@@ -99,6 +149,26 @@ ErrorStatus OPENBL_RegisterInterface(OPENBL_HandleTypeDef *Interface)
   return status;
 }
 
+/**
+  * @brief  This function is used to get the buffer used by a command module to store the host data.
+  *         Only the detected interface executes commands, so all the modules share the same arena.
+  *         The interfaces may use it before the detection only if they are the single user of it
+  *         (e.g. FDCAN frame buffers), the other modules must not touch it before being detected.
+  * @param  Size The number of bytes needed.
+  * @retval Returns a pointer to the arena, NULL if it is smaller than the requested size.
+  */
+uint8_t *OPENBL_GetBuffer(uint32_t Size)
+{
+  uint8_t *p_buffer = NULL;
+
+  if (Size <= OPENBL_BUFFER_ARENA_SIZE)
+  {
+    p_buffer = (uint8_t *)a_BufferArena;
+  }
+
+  return p_buffer;
+}
+
 /**
   * @brief  This function is used to detect if there is any activity on a given interface.
   * @retval None.
@@ -110,7 +180,18 @@ uint32_t OPENBL_InterfaceDetection(void)
 
   for (counter = 0U; counter < NumberOfInterfaces; counter++)
   {
-    if (a_InterfacesTable[counter].p_Ops->Detection != NULL)
+    /* A lazily initialized interface is initialized once there is activity on it */
+    if ((a_InterfacesInitialized[counter] == 0U) && (a_InterfacesTable[counter].p_Ops->ActivityDetected() == 1U))
+    {
+      if (a_InterfacesTable[counter].p_Ops->Init != NULL)
+      {
+        a_InterfacesTable[counter].p_Ops->Init();
+      }
+
+      a_InterfacesInitialized[counter] = 1U;
+    }
+
+    if ((a_InterfacesInitialized[counter] == 1U) && (a_InterfacesTable[counter].p_Ops->Detection != NULL))
     {
       detected = a_InterfacesTable[counter].p_Ops->Detection();
 
@@ -122,6 +203,12 @@ uint32_t OPENBL_InterfaceDetection(void)
     }
   }
 
+  /* Sleep until the next interrupt (activity, peripheral or tick) before polling the interfaces again */
+  if ((detected == 0U) && (OPENBL_LAZY_INIT == 1U))
+  {
+    Common_WaitForInterrupt();
+  }
+
   return detected;
 }
 
@@ -138,6 +225,11 @@ void OPENBL_CommandProcess(void)
   {
     command_opcode = p_Interface->p_Ops->GetCommandOpcode();
 
+    if (OPENBL_PERF_ENABLE == 1U)
+    {
+      OPENBL_PERF_CommandStart(command_opcode);
+    }
+
     switch (command_opcode)
     {
       case CMD_GET_COMMAND:
@@ -434,6 +526,118 @@ void OPENBL_CommandProcess(void)
         }
         break;
 
+      case CMD_EXT_READ_MEMORY:
+        if (p_Interface->p_Cmd->ExtendedReadMemory != NULL)
+        {
+          p_Interface->p_Cmd->ExtendedReadMemory();
+        }
+        else
+        {
+          if (p_Interface->p_Ops->SendByte != NULL)
+          {
+            p_Interface->p_Ops->SendByte(NACK_BYTE);
+          }
+        }
+        break;
+
+      case CMD_EXT_WRITE_MEMORY:
+        if (p_Interface->p_Cmd->ExtendedWriteMemory != NULL)
+        {
+          p_Interface->p_Cmd->ExtendedWriteMemory();
+        }
+        else
+        {
+          if (p_Interface->p_Ops->SendByte != NULL)
+          {
+            p_Interface->p_Ops->SendByte(NACK_BYTE);
+          }
+        }
+        break;
+
+      case CMD_GROUP_COMMAND:
+        if (p_Interface->p_Cmd->GroupCommand != NULL)
+        {
+          p_Interface->p_Cmd->GroupCommand();
+        }
+        else
+        {
+          if (p_Interface->p_Ops->SendByte != NULL)
+          {
+            p_Interface->p_Ops->SendByte(NACK_BYTE);
+          }
+        }
+        break;
+
+      case CMD_GET_STATISTICS:
+        if (p_Interface->p_Cmd->GetStatistics != NULL)
+        {
+          p_Interface->p_Cmd->GetStatistics();
+        }
+        else
+        {
+          if (p_Interface->p_Ops->SendByte != NULL)
+          {
+            p_Interface->p_Ops->SendByte(NACK_BYTE);
+          }
+        }
+        break;
+
+      case CMD_COMMIT_MEMORY:
+        if (p_Interface->p_Cmd->CommitMemory != NULL)
+        {
+          p_Interface->p_Cmd->CommitMemory();
+        }
+        else
+        {
+          if (p_Interface->p_Ops->SendByte != NULL)
+          {
+            p_Interface->p_Ops->SendByte(NACK_BYTE);
+          }
+        }
+        break;
+
+      case CMD_COMPRESSED_WRITE_MEMORY:
+        if (p_Interface->p_Cmd->CompressedWriteMemory != NULL)
+        {
+          p_Interface->p_Cmd->CompressedWriteMemory();
+        }
+        else
+        {
+          if (p_Interface->p_Ops->SendByte != NULL)
+          {
+            p_Interface->p_Ops->SendByte(NACK_BYTE);
+          }
+        }
+        break;
+
+      case CMD_PATCH_MEMORY:
+        if (p_Interface->p_Cmd->PatchMemory != NULL)
+        {
+          p_Interface->p_Cmd->PatchMemory();
+        }
+        else
+        {
+          if (p_Interface->p_Ops->SendByte != NULL)
+          {
+            p_Interface->p_Ops->SendByte(NACK_BYTE);
+          }
+        }
+        break;
+
+      case CMD_GET_BLOCK_CRC:
+        if (p_Interface->p_Cmd->GetBlockCrc != NULL)
+        {
+          p_Interface->p_Cmd->GetBlockCrc();
+        }
+        else
+        {
+          if (p_Interface->p_Ops->SendByte != NULL)
+          {
+            p_Interface->p_Ops->SendByte(NACK_BYTE);
+          }
+        }
+        break;
+
       /* Unknown command opcode */
       default:
         if (p_Interface->p_Ops->SendByte != NULL)
@@ -442,5 +646,10 @@ void OPENBL_CommandProcess(void)
         }
         break;
     }
+
+    if (OPENBL_PERF_ENABLE == 1U)
+    {
+      OPENBL_PERF_CommandEnd();
+    }
   }
 }
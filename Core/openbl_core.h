@@ -44,7 +44,9 @@ extern "C" {
 #define CMD_GET_ID                        0x02U             /* Get ID command */
 #define CMD_SPEED                         0x03U             /* Speed command */
 #define CMD_READ_MEMORY                   0x11U             /* Read Memory command */
+#define CMD_EXT_READ_MEMORY               0x12U             /* Extended Read Memory command */
 #define CMD_WRITE_MEMORY                  0x31U             /* Write Memory command */
+#define CMD_EXT_WRITE_MEMORY              0x33U             /* Extended Write Memory command */
 #define CMD_GO                            0x21U             /* GO command */
 #define CMD_READ_PROTECT                  0x82U             /* Readout Protect command */
 #define CMD_READ_UNPROTECT                0x92U             /* Readout Unprotect command */
@@ -60,7 +62,13 @@ extern "C" {
 #define CMD_NS_READ_UNPROTECT             0x93U             /* No Stretch Read Unprotect command */
 #define CMD_SPECIAL_COMMAND               0x50U             /* Special Command command */
 #define CMD_EXTENDED_SPECIAL_COMMAND      0x51U             /* Extended Special Command command */
+#define CMD_GROUP_COMMAND                 0x52U             /* Group Command command */
 #define CMD_CHECKSUM                      0xA1U             /* Checksum command */
+#define CMD_GET_STATISTICS                0xA2U             /* Get Statistics command */
+#define CMD_COMMIT_MEMORY                 0x35U             /* Commit Memory command */
+#define CMD_COMPRESSED_WRITE_MEMORY       0x36U             /* Compressed Write Memory command */
+#define CMD_PATCH_MEMORY                  0x37U             /* Patch Memory command */
+#define CMD_GET_BLOCK_CRC                 0xA3U             /* Get Block CRC command */
 
 /* Exported types ------------------------------------------------------------*/
 typedef struct
@@ -70,6 +78,8 @@ typedef struct
   uint8_t (*Detection)(void);
   uint8_t (*GetCommandOpcode)(void);
   void (*SendByte)(uint8_t Byte);
+  void (*ArmDetection)(void);          /* Optional, lazy init: arm the activity detection instead of Init */
+  uint8_t (*ActivityDetected)(void);   /* Optional, lazy init: returns 1 once activity is seen, Init is then called */
 } OPENBL_OpsTypeDef;
 
 typedef struct
@@ -94,6 +104,14 @@ typedef struct
   void (*Speed)(void);
   void (*SpecialCommand)(void);
   void (*ExtendedSpecialCommand)(void);
+  void (*ExtendedReadMemory)(void);
+  void (*ExtendedWriteMemory)(void);
+  void (*GroupCommand)(void);
+  void (*GetStatistics)(void);
+  void (*CommitMemory)(void);
+  void (*CompressedWriteMemory)(void);
+  void (*PatchMemory)(void);
+  void (*GetBlockCrc)(void);
 } OPENBL_CommandsTypeDef;
 
 typedef struct
@@ -126,6 +144,7 @@ void OPENBL_InterfacesDeInit(void);
 uint32_t OPENBL_InterfaceDetection(void);
 void OPENBL_CommandProcess(void);
 ErrorStatus OPENBL_RegisterInterface(OPENBL_HandleTypeDef *Interface);
+uint8_t *OPENBL_GetBuffer(uint32_t Size);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,284 @@
+/**
+  ******************************************************************************
+  * @file    openbl_perf.c
+  * @author  MCD Application Team
+  * @brief   Open Bootloader statistics: per command latencies, memory and transport times
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "openbl_core.h"
+#include "openbl_perf.h"
+#include "app_openbootloader.h"
+#include "common_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static OPENBL_PERF_CommandTypeDef a_PerfCommands[OPENBL_PERF_CMD_SLOTS];
+static uint32_t PerfCommandsNumber = 0U;
+
+static OPENBL_PERF_CommandTypeDef *p_PerfCommand = NULL;  /* Command being measured, NULL if none */
+static uint32_t PerfCommandStart  = 0U;                   /* Cycle count at the start of the command */
+static uint32_t PerfMemoryStart   = 0U;                   /* Cycle count at the start of the memory operation */
+static uint32_t PerfCommandMemory = 0U;                   /* Memory cycles spent in the command being measured */
+
+static uint32_t PerfBytesRead     = 0U;                   /* Bytes read through the memory layer */
+static uint32_t PerfBytesWritten  = 0U;                   /* Bytes written through the memory layer */
+static uint64_t PerfMemoryCycles  = 0U;                   /* Cycles spent in memory write and erase operations */
+static uint64_t PerfTransportCycles = 0U;                 /* Command cycles spent outside the memory layer */
+
+/* Private function prototypes -----------------------------------------------*/
+static OPENBL_PERF_CommandTypeDef *OPENBL_PERF_GetCommand(uint8_t OpCode);
+static uint32_t OPENBL_PERF_PutWord(uint8_t *pBuffer, uint32_t Value);
+static uint32_t OPENBL_PERF_PutDoubleWord(uint8_t *pBuffer, uint64_t Value);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to get the statistics entry of a command, a new one is taken on first use.
+  * @param  OpCode The command opcode.
+  * @retval Returns a pointer to the entry, NULL if all the entries are used.
+  */
+static OPENBL_PERF_CommandTypeDef *OPENBL_PERF_GetCommand(uint8_t OpCode)
+{
+  OPENBL_PERF_CommandTypeDef *p_command = NULL;
+  uint32_t counter;
+
+  for (counter = 0U; (counter < PerfCommandsNumber) && (p_command == NULL); counter++)
+  {
+    if (a_PerfCommands[counter].OpCode == OpCode)
+    {
+      p_command = &a_PerfCommands[counter];
+    }
+  }
+
+  if ((p_command == NULL) && (PerfCommandsNumber < OPENBL_PERF_CMD_SLOTS))
+  {
+    p_command            = &a_PerfCommands[PerfCommandsNumber];
+    p_command->OpCode    = OpCode;
+    p_command->MinCycles = 0xFFFFFFFFU;
+
+    PerfCommandsNumber++;
+  }
+
+  return p_command;
+}
+
+/**
+  * @brief  This function is used to store a word MSB first.
+  * @param  pBuffer Pointer to the destination buffer.
+  * @param  Value The word to be stored.
+  * @retval Returns the number of stored bytes.
+  */
+static uint32_t OPENBL_PERF_PutWord(uint8_t *pBuffer, uint32_t Value)
+{
+  pBuffer[0] = (uint8_t)(Value >> 24U);
+  pBuffer[1] = (uint8_t)(Value >> 16U);
+  pBuffer[2] = (uint8_t)(Value >> 8U);
+  pBuffer[3] = (uint8_t)Value;
+
+  return 4U;
+}
+
+/**
+  * @brief  This function is used to store a double word MSB first.
+  * @param  pBuffer Pointer to the destination buffer.
+  * @param  Value The double word to be stored.
+  * @retval Returns the number of stored bytes.
+  */
+static uint32_t OPENBL_PERF_PutDoubleWord(uint8_t *pBuffer, uint64_t Value)
+{
+  (void)OPENBL_PERF_PutWord(pBuffer, (uint32_t)(Value >> 32U));
+  (void)OPENBL_PERF_PutWord(&pBuffer[4], (uint32_t)Value);
+
+  return 8U;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to start the cycle counter used for the statistics.
+  * @retval None.
+  */
+void OPENBL_PERF_Init(void)
+{
+  Common_StartCycleCounter();
+}
+
+/**
+  * @brief  This function is called by the core before executing a command.
+  * @param  OpCode The opcode of the command to be executed.
+  * @retval None.
+  */
+void OPENBL_PERF_CommandStart(uint8_t OpCode)
+{
+  p_PerfCommand     = OPENBL_PERF_GetCommand(OpCode);
+  PerfCommandMemory = 0U;
+  PerfCommandStart  = Common_GetCycleCount();
+}
+
+/**
+  * @brief  This function is called by the core once a command is executed.
+  *         The time not spent in the memory layer is accounted as transport time, it includes
+  *         waiting for the host data, sending the responses and the protocol handling.
+  * @retval None.
+  */
+void OPENBL_PERF_CommandEnd(void)
+{
+  uint32_t cycles;
+  uint32_t limit;
+  uint32_t bucket;
+
+  cycles = Common_GetCycleCount() - PerfCommandStart;
+
+  if (cycles > PerfCommandMemory)
+  {
+    PerfTransportCycles += (uint64_t)(cycles - PerfCommandMemory);
+  }
+
+  if (p_PerfCommand != NULL)
+  {
+    p_PerfCommand->Count++;
+    p_PerfCommand->TotalCycles += (uint64_t)cycles;
+
+    if (cycles < p_PerfCommand->MinCycles)
+    {
+      p_PerfCommand->MinCycles = cycles;
+    }
+
+    if (cycles > p_PerfCommand->MaxCycles)
+    {
+      p_PerfCommand->MaxCycles = cycles;
+    }
+
+    /* Bucket i counts the executions below OPENBL_PERF_HIST_FIRST_LIMIT * 4^i cycles, the last one the others */
+    bucket = 0U;
+    limit  = OPENBL_PERF_HIST_FIRST_LIMIT;
+
+    while ((bucket < (OPENBL_PERF_HIST_BUCKETS - 1U)) && (cycles >= limit))
+    {
+      bucket++;
+      limit = (limit < (0xFFFFFFFFU >> OPENBL_PERF_HIST_SHIFT)) ? (limit << OPENBL_PERF_HIST_SHIFT) : 0xFFFFFFFFU;
+    }
+
+    if (p_PerfCommand->Histogram[bucket] != 0xFFFFU)
+    {
+      p_PerfCommand->Histogram[bucket]++;
+    }
+
+    p_PerfCommand = NULL;
+  }
+}
+
+/**
+  * @brief  This function is called by the memory layer before a write or an erase operation.
+  * @retval None.
+  */
+void OPENBL_PERF_MemoryStart(void)
+{
+  PerfMemoryStart = Common_GetCycleCount();
+}
+
+/**
+  * @brief  This function is called by the memory layer once a write or an erase operation is done.
+  * @retval None.
+  */
+void OPENBL_PERF_MemoryEnd(void)
+{
+  uint32_t cycles;
+
+  cycles = Common_GetCycleCount() - PerfMemoryStart;
+
+  PerfMemoryCycles  += (uint64_t)cycles;
+  PerfCommandMemory += cycles;
+}
+
+/**
+  * @brief  This function is used to account the bytes read through the memory layer.
+  * @param  Length The number of bytes read.
+  * @retval None.
+  */
+void OPENBL_PERF_AddBytesRead(uint32_t Length)
+{
+  PerfBytesRead += Length;
+}
+
+/**
+  * @brief  This function is used to account the bytes written through the memory layer.
+  * @param  Length The number of bytes written.
+  * @retval None.
+  */
+void OPENBL_PERF_AddBytesWritten(uint32_t Length)
+{
+  PerfBytesWritten += Length;
+}
+
+/**
+  * @brief  This function is used to build the statistics report sent by the Get Statistics command.
+  *         All the values are sent MSB first:
+  *          - Header: version (1), number of commands N (1), number of histogram buckets B (1),
+  *            histogram shift (1), cycle counter frequency in Hz (4), first bucket limit in cycles (4),
+  *            bytes read (4), bytes written (4), memory busy cycles (8), transport cycles (8)
+  *          - N entries: opcode (1), count (4), min cycles (4), max cycles (4), total cycles (8),
+  *            B histogram counters (2 each)
+  * @param  pBuffer Pointer to the buffer where the report is stored.
+  * @param  Size The size of the buffer.
+  * @retval Returns the report length, 0 if the buffer is too small.
+  */
+uint32_t OPENBL_PERF_GetStatistics(uint8_t *pBuffer, uint32_t Size)
+{
+  OPENBL_PERF_CommandTypeDef *p_command;
+  uint32_t length = 0U;
+  uint32_t counter;
+  uint32_t bucket;
+
+  if ((pBuffer != NULL) && (Size >= (OPENBL_PERF_HEADER_SIZE + (PerfCommandsNumber * OPENBL_PERF_ENTRY_SIZE))))
+  {
+    pBuffer[0] = OPENBL_PERF_VERSION;
+    pBuffer[1] = (uint8_t)PerfCommandsNumber;
+    pBuffer[2] = (uint8_t)OPENBL_PERF_HIST_BUCKETS;
+    pBuffer[3] = (uint8_t)OPENBL_PERF_HIST_SHIFT;
+    length     = 4U;
+
+    length += OPENBL_PERF_PutWord(&pBuffer[length], Common_GetCycleFrequency());
+    length += OPENBL_PERF_PutWord(&pBuffer[length], OPENBL_PERF_HIST_FIRST_LIMIT);
+    length += OPENBL_PERF_PutWord(&pBuffer[length], PerfBytesRead);
+    length += OPENBL_PERF_PutWord(&pBuffer[length], PerfBytesWritten);
+    length += OPENBL_PERF_PutDoubleWord(&pBuffer[length], PerfMemoryCycles);
+    length += OPENBL_PERF_PutDoubleWord(&pBuffer[length], PerfTransportCycles);
+
+    for (counter = 0U; counter < PerfCommandsNumber; counter++)
+    {
+      p_command = &a_PerfCommands[counter];
+
+      pBuffer[length] = p_command->OpCode;
+      length++;
+
+      length += OPENBL_PERF_PutWord(&pBuffer[length], p_command->Count);
+      length += OPENBL_PERF_PutWord(&pBuffer[length], (p_command->Count != 0U) ? p_command->MinCycles : 0U);
+      length += OPENBL_PERF_PutWord(&pBuffer[length], p_command->MaxCycles);
+      length += OPENBL_PERF_PutDoubleWord(&pBuffer[length], p_command->TotalCycles);
+
+      for (bucket = 0U; bucket < OPENBL_PERF_HIST_BUCKETS; bucket++)
+      {
+        pBuffer[length]      = (uint8_t)(p_command->Histogram[bucket] >> 8U);
+        pBuffer[length + 1U] = (uint8_t)p_command->Histogram[bucket];
+        length += 2U;
+      }
+    }
+  }
+
+  return length;
+}
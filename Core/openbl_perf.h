@@ -0,0 +1,65 @@
+/**
+  ******************************************************************************
+  * @file    openbl_perf.h
+  * @author  MCD Application Team
+  * @brief   Header for openbl_perf.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OPENBL_PERF_H
+#define OPENBL_PERF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#include "openbootloader_conf.h"
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  uint8_t OpCode;                                  /* Command opcode */
+  uint32_t Count;                                  /* Number of executions */
+  uint32_t MinCycles;                              /* Shortest execution in cycles */
+  uint32_t MaxCycles;                              /* Longest execution in cycles */
+  uint64_t TotalCycles;                            /* Sum of the execution cycles */
+  uint16_t Histogram[OPENBL_PERF_HIST_BUCKETS];    /* Executions per latency bucket, saturated */
+} OPENBL_PERF_CommandTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+#define OPENBL_PERF_VERSION               0x10U     /* Version of the statistics report */
+#define OPENBL_PERF_HIST_SHIFT            2U        /* Each histogram bucket limit is 4 times the previous one */
+#define OPENBL_PERF_HEADER_SIZE           36U       /* Size of the statistics report header */
+#define OPENBL_PERF_ENTRY_SIZE            (21U + (2U * OPENBL_PERF_HIST_BUCKETS)) /* Size of one command entry */
+#define OPENBL_PERF_REPORT_SIZE_MAX       (OPENBL_PERF_HEADER_SIZE + (OPENBL_PERF_CMD_SLOTS * OPENBL_PERF_ENTRY_SIZE))
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void OPENBL_PERF_Init(void);
+void OPENBL_PERF_CommandStart(uint8_t OpCode);
+void OPENBL_PERF_CommandEnd(void);
+void OPENBL_PERF_MemoryStart(void);
+void OPENBL_PERF_MemoryEnd(void);
+void OPENBL_PERF_AddBytesRead(uint32_t Length);
+void OPENBL_PERF_AddBytesWritten(uint32_t Length);
+uint32_t OPENBL_PERF_GetStatistics(uint8_t *pBuffer, uint32_t Size);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* OPENBL_PERF_H */
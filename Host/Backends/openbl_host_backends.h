@@ -0,0 +1,53 @@
+/**
+  ******************************************************************************
+  * @file    openbl_host_backends.h
+  * @author  MCD Application Team
+  * @brief   Header of the Linux back-ends of the host library
+  *          Each open function fills the back-end, OPENBL_HOST_DeInit closes it.
+  *          I3C has no generic Linux user space interface, its back-end is provided by the application.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OPENBL_HOST_BACKENDS_H
+#define OPENBL_HOST_BACKENDS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "openbl_host.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+#define OPENBL_HOST_SERIAL_BAUDRATE_DEFAULT  115200U   /* USART baudrate */
+#define OPENBL_HOST_SPI_SPEED_DEFAULT        1000000U  /* SPI clock in Hz */
+#define OPENBL_HOST_I2C_ADDRESS_DEFAULT      0x5AU     /* 7-bit I2C address of the device (0xB4 shifted) */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_SerialOpen(OPENBL_HOST_BackendTypeDef *pBackend, const char *pDevice,
+                                                 uint32_t BaudRate);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_SocketCanOpen(OPENBL_HOST_BackendTypeDef *pBackend, const char *pInterface,
+                                                    uint8_t FdMode);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_SpidevOpen(OPENBL_HOST_BackendTypeDef *pBackend, const char *pDevice,
+                                                 uint32_t Speed);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_I2cdevOpen(OPENBL_HOST_BackendTypeDef *pBackend, const char *pDevice,
+                                                 uint8_t Address);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OPENBL_HOST_BACKENDS_H */
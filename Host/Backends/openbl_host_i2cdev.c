@@ -0,0 +1,133 @@
+/**
+  ******************************************************************************
+  * @file    openbl_host_i2cdev.c
+  * @author  MCD Application Team
+  * @brief   Linux i2c-dev back-end of the host library, for the I2C protocol
+  *          Each send is one write transfer and each receive one read transfer to the device address.
+  *          A busy device does not acknowledge its address, the transfer fails and the engine polls again.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <linux/i2c-dev.h>
+
+#include "openbl_host.h"
+#include "openbl_host_engine.h"
+#include "openbl_host_backends.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static OPENBL_HOST_StatusTypeDef I2CDEV_Send(void *pContext, uint32_t Identifier, const uint8_t *pData,
+                                             uint32_t Length);
+static OPENBL_HOST_StatusTypeDef I2CDEV_Receive(void *pContext, uint32_t *pIdentifier, uint8_t *pData,
+                                                uint32_t *pLength, uint32_t Timeout);
+static void I2CDEV_Close(void *pContext);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to run one write transfer.
+  * @param  pContext Pointer to the file descriptor of the bus.
+  * @param  Identifier Not used.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the device acknowledged all the bytes else OPENBL_HOST_ERROR.
+  */
+static OPENBL_HOST_StatusTypeDef I2CDEV_Send(void *pContext, uint32_t Identifier, const uint8_t *pData,
+                                             uint32_t Length)
+{
+  (void)Identifier;
+
+  return (write(*(int *)pContext, pData, Length) == (ssize_t)Length) ? OPENBL_HOST_OK : OPENBL_HOST_ERROR;
+}
+
+/**
+  * @brief  This function is used to run one read transfer.
+  * @param  pContext Pointer to the file descriptor of the bus.
+  * @param  pIdentifier Not used.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  pLength Pointer to the number of bytes of the transfer.
+  * @param  Timeout Not used, the engine polls a busy device.
+  * @retval Returns OPENBL_HOST_OK if the bytes have been received else OPENBL_HOST_ERROR.
+  */
+static OPENBL_HOST_StatusTypeDef I2CDEV_Receive(void *pContext, uint32_t *pIdentifier, uint8_t *pData,
+                                                uint32_t *pLength, uint32_t Timeout)
+{
+  (void)Timeout;
+
+  *pIdentifier = 0U;
+
+  return (read(*(int *)pContext, pData, *pLength) == (ssize_t)*pLength) ? OPENBL_HOST_OK : OPENBL_HOST_ERROR;
+}
+
+/**
+  * @brief  This function is used to close the bus.
+  * @param  pContext Pointer to the file descriptor of the bus.
+  * @retval None.
+  */
+static void I2CDEV_Close(void *pContext)
+{
+  (void)close(*(int *)pContext);
+  free(pContext);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to open an i2c-dev back-end.
+  * @param  pBackend Pointer to the back-end to be filled.
+  * @param  pDevice The bus device, /dev/i2c-1 for instance.
+  * @param  Address The 7-bit address of the device.
+  * @retval Returns OPENBL_HOST_OK if the bus has been opened else OPENBL_HOST_ERROR.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_I2cdevOpen(OPENBL_HOST_BackendTypeDef *pBackend, const char *pDevice,
+                                                 uint8_t Address)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_ERROR;
+  int *p_bus;
+
+  p_bus = malloc(sizeof(int));
+
+  if (p_bus != NULL)
+  {
+    *p_bus = open(pDevice, O_RDWR);
+
+    if ((*p_bus >= 0) && (ioctl(*p_bus, I2C_SLAVE, (unsigned long)Address) == 0))
+    {
+      pBackend->pContext = p_bus;
+      pBackend->Send     = I2CDEV_Send;
+      pBackend->Receive  = I2CDEV_Receive;
+      pBackend->Close    = I2CDEV_Close;
+
+      status = OPENBL_HOST_OK;
+    }
+    else
+    {
+      if (*p_bus >= 0)
+      {
+        (void)close(*p_bus);
+      }
+
+      free(p_bus);
+    }
+  }
+
+  return status;
+}
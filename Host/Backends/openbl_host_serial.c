@@ -0,0 +1,265 @@
+/**
+  ******************************************************************************
+  * @file    openbl_host_serial.c
+  * @author  MCD Application Team
+  * @brief   Linux serial port back-end of the host library, for the USART protocol
+  *          The port runs in raw mode, 8 data bits, even parity and one stop bit.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "openbl_host.h"
+#include "openbl_host_engine.h"
+#include "openbl_host_backends.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static speed_t SERIAL_GetSpeed(uint32_t BaudRate);
+static OPENBL_HOST_StatusTypeDef SERIAL_Send(void *pContext, uint32_t Identifier, const uint8_t *pData,
+                                             uint32_t Length);
+static OPENBL_HOST_StatusTypeDef SERIAL_Receive(void *pContext, uint32_t *pIdentifier, uint8_t *pData,
+                                                uint32_t *pLength, uint32_t Timeout);
+static void SERIAL_Close(void *pContext);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to get the termios speed of a baudrate.
+  * @param  BaudRate The baudrate.
+  * @retval Returns the speed, B0 if the baudrate is not supported.
+  */
+static speed_t SERIAL_GetSpeed(uint32_t BaudRate)
+{
+  static const struct
+  {
+    uint32_t BaudRate;
+    speed_t Speed;
+  } a_speeds[] =
+  {
+    {1200U, B1200}, {2400U, B2400}, {4800U, B4800}, {9600U, B9600}, {19200U, B19200}, {38400U, B38400},
+    {57600U, B57600}, {115200U, B115200}, {230400U, B230400}, {460800U, B460800}, {921600U, B921600},
+    {1000000U, B1000000}, {2000000U, B2000000}, {3000000U, B3000000}, {4000000U, B4000000}
+  };
+  speed_t speed = B0;
+  uint32_t counter;
+
+  for (counter = 0U; counter < (sizeof(a_speeds) / sizeof(a_speeds[0])); counter++)
+  {
+    if (a_speeds[counter].BaudRate == BaudRate)
+    {
+      speed = a_speeds[counter].Speed;
+    }
+  }
+
+  return speed;
+}
+
+/**
+  * @brief  This function is used to send bytes on the serial port.
+  * @param  pContext Pointer to the file descriptor of the port.
+  * @param  Identifier Not used.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the bytes have been sent else OPENBL_HOST_ERROR.
+  */
+static OPENBL_HOST_StatusTypeDef SERIAL_Send(void *pContext, uint32_t Identifier, const uint8_t *pData,
+                                             uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  int port = *(int *)pContext;
+  ssize_t length;
+
+  (void)Identifier;
+
+  while ((Length != 0U) && (status == OPENBL_HOST_OK))
+  {
+    length = write(port, pData, Length);
+
+    if (length > 0)
+    {
+      pData  += length;
+      Length -= (uint32_t)length;
+    }
+    else if ((length < 0) && (errno != EINTR) && (errno != EAGAIN))
+    {
+      status = OPENBL_HOST_ERROR;
+    }
+    else
+    {
+      /* Interrupted, retried */
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to receive exactly the wanted number of bytes from the serial port.
+  * @param  pContext Pointer to the file descriptor of the port.
+  * @param  pIdentifier Not used.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  pLength Pointer to the number of bytes, set to the number of received bytes.
+  * @param  Timeout The time to wait for all the bytes in ms.
+  * @retval Returns OPENBL_HOST_OK if all the bytes have been received else the error.
+  */
+static OPENBL_HOST_StatusTypeDef SERIAL_Receive(void *pContext, uint32_t *pIdentifier, uint8_t *pData,
+                                                uint32_t *pLength, uint32_t Timeout)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  struct pollfd poll_fd;
+  uint32_t received = 0U;
+  uint32_t start;
+  uint32_t elapsed;
+  ssize_t length;
+
+  *pIdentifier   = 0U;
+  poll_fd.fd     = *(int *)pContext;
+  poll_fd.events = POLLIN;
+  start          = OPENBL_HOST_GetTick();
+
+  while ((received < *pLength) && (status == OPENBL_HOST_OK))
+  {
+    elapsed = OPENBL_HOST_GetTick() - start;
+
+    if (elapsed >= Timeout)
+    {
+      status = OPENBL_HOST_TIMEOUT;
+    }
+    else if (poll(&poll_fd, 1U, (int)(Timeout - elapsed)) > 0)
+    {
+      length = read(poll_fd.fd, &pData[received], *pLength - received);
+
+      if (length > 0)
+      {
+        received += (uint32_t)length;
+      }
+      else if ((length == 0) || ((errno != EINTR) && (errno != EAGAIN)))
+      {
+        status = OPENBL_HOST_ERROR;
+      }
+      else
+      {
+        /* Interrupted, retried */
+      }
+    }
+    else
+    {
+      /* Timed out or interrupted, the time is checked again */
+    }
+  }
+
+  *pLength = received;
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to close the serial port.
+  * @param  pContext Pointer to the file descriptor of the port.
+  * @retval None.
+  */
+static void SERIAL_Close(void *pContext)
+{
+  (void)close(*(int *)pContext);
+  free(pContext);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to open a serial port back-end.
+  * @param  pBackend Pointer to the back-end to be filled.
+  * @param  pDevice The serial device, /dev/ttyUSB0 for instance. Pseudo-terminals are accepted.
+  * @param  BaudRate The baudrate.
+  * @retval Returns OPENBL_HOST_OK if the port has been opened, OPENBL_HOST_UNSUPPORTED for an unknown
+  *         baudrate else OPENBL_HOST_ERROR.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_SerialOpen(OPENBL_HOST_BackendTypeDef *pBackend, const char *pDevice,
+                                                 uint32_t BaudRate)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_ERROR;
+  struct termios settings;
+  speed_t speed;
+  int *p_port;
+  int error;
+
+  speed  = SERIAL_GetSpeed(BaudRate);
+  p_port = malloc(sizeof(int));
+
+  if (speed == B0)
+  {
+    status = OPENBL_HOST_UNSUPPORTED;
+  }
+  else if (p_port != NULL)
+  {
+    *p_port = open(pDevice, O_RDWR | O_NOCTTY);
+
+    if ((*p_port >= 0) && (tcgetattr(*p_port, &settings) == 0))
+    {
+      cfmakeraw(&settings);
+
+      settings.c_cflag |= PARENB | CLOCAL | CREAD;
+      settings.c_cflag &= ~(PARODD | CSTOPB | CRTSCTS);
+
+      (void)cfsetispeed(&settings, speed);
+      (void)cfsetospeed(&settings, speed);
+
+      /* Some pseudo-terminals refuse the parity, they carry no parity bit anyway */
+      error = tcsetattr(*p_port, TCSANOW, &settings);
+
+      if (error != 0)
+      {
+        settings.c_cflag &= ~PARENB;
+        error = tcsetattr(*p_port, TCSANOW, &settings);
+      }
+
+      if (error == 0)
+      {
+        (void)tcflush(*p_port, TCIOFLUSH);
+
+        pBackend->pContext = p_port;
+        pBackend->Send     = SERIAL_Send;
+        pBackend->Receive  = SERIAL_Receive;
+        pBackend->Close    = SERIAL_Close;
+
+        status = OPENBL_HOST_OK;
+      }
+    }
+  }
+  else
+  {
+    /* Out of memory */
+  }
+
+  if ((status != OPENBL_HOST_OK) && (p_port != NULL))
+  {
+    if ((speed != B0) && (*p_port >= 0))
+    {
+      (void)close(*p_port);
+    }
+
+    free(p_port);
+  }
+
+  return status;
+}
@@ -0,0 +1,279 @@
+/**
+  ******************************************************************************
+  * @file    openbl_host_socketcan.c
+  * @author  MCD Application Team
+  * @brief   Linux SocketCAN back-end of the host library, for the CAN and FDCAN protocols
+  *          The frames use standard identifiers, the CAN FD frames use the bit rate switching.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <errno.h>
+#include <net/if.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+
+#include "openbl_host.h"
+#include "openbl_host_engine.h"
+#include "openbl_host_backends.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  int Socket;
+  uint8_t FdMode;                   /* 1 to send CAN FD frames */
+} SOCKETCAN_ContextTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define SOCKETCAN_PADDING_BYTE            0xFFU     /* Value of the bytes padding a CAN FD frame */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t SOCKETCAN_FdLength(uint32_t Length);
+static OPENBL_HOST_StatusTypeDef SOCKETCAN_Send(void *pContext, uint32_t Identifier, const uint8_t *pData,
+                                                uint32_t Length);
+static OPENBL_HOST_StatusTypeDef SOCKETCAN_Receive(void *pContext, uint32_t *pIdentifier, uint8_t *pData,
+                                                   uint32_t *pLength, uint32_t Timeout);
+static void SOCKETCAN_Close(void *pContext);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to get the smallest CAN FD frame length holding the given data.
+  * @param  Length The number of data bytes, up to CANFD_MAX_DLEN.
+  * @retval Returns the frame length: 0 to 8, 12, 16, 20, 24, 32, 48 or 64.
+  */
+static uint32_t SOCKETCAN_FdLength(uint32_t Length)
+{
+  uint32_t length;
+
+  if (Length <= 8U)
+  {
+    length = Length;
+  }
+  else if (Length <= 24U)
+  {
+    length = (Length + 3U) & ~3U;
+  }
+  else if (Length <= 32U)
+  {
+    length = 32U;
+  }
+  else if (Length <= 48U)
+  {
+    length = 48U;
+  }
+  else
+  {
+    length = CANFD_MAX_DLEN;
+  }
+
+  return length;
+}
+
+/**
+  * @brief  This function is used to send one frame.
+  * @param  pContext Pointer to the SocketCAN context.
+  * @param  Identifier The standard identifier of the frame.
+  * @param  pData Pointer to the frame data.
+  * @param  Length The number of data bytes, up to 8 for CAN and 64 for CAN FD.
+  * @retval Returns OPENBL_HOST_OK if the frame has been sent else OPENBL_HOST_ERROR.
+  */
+static OPENBL_HOST_StatusTypeDef SOCKETCAN_Send(void *pContext, uint32_t Identifier, const uint8_t *pData,
+                                                uint32_t Length)
+{
+  SOCKETCAN_ContextTypeDef *p_context = (SOCKETCAN_ContextTypeDef *)pContext;
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  struct canfd_frame frame;
+  struct pollfd poll_fd;
+  size_t size;
+  ssize_t length = -1;
+
+  (void)memset(&frame, SOCKETCAN_PADDING_BYTE, sizeof(frame));
+
+  frame.can_id = Identifier & CAN_SFF_MASK;
+
+  if (p_context->FdMode == 0U)
+  {
+    frame.len = (uint8_t)((Length < CAN_MAX_DLEN) ? Length : CAN_MAX_DLEN);
+    size      = CAN_MTU;
+  }
+  else
+  {
+    frame.len   = (uint8_t)SOCKETCAN_FdLength(Length);
+    frame.flags = CANFD_BRS;
+    size        = CANFD_MTU;
+  }
+
+  if (Length != 0U)
+  {
+    (void)memcpy(frame.data, pData, (Length < frame.len) ? Length : frame.len);
+  }
+
+  while ((length != (ssize_t)size) && (status == OPENBL_HOST_OK))
+  {
+    length = write(p_context->Socket, &frame, size);
+
+    /* The transmit queue of the controller is full, wait until it can take the frame */
+    if ((length < 0) && (errno == ENOBUFS))
+    {
+      poll_fd.fd     = p_context->Socket;
+      poll_fd.events = POLLOUT;
+
+      (void)poll(&poll_fd, 1U, 1);
+    }
+    else if ((length < 0) && (errno != EINTR) && (errno != EAGAIN))
+    {
+      status = OPENBL_HOST_ERROR;
+    }
+    else
+    {
+      /* Sent, or interrupted and retried */
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to receive one frame.
+  * @param  pContext Pointer to the SocketCAN context.
+  * @param  pIdentifier Pointer to the returned identifier of the frame.
+  * @param  pData Pointer to the buffer where the frame data is stored.
+  * @param  pLength Pointer to the size of the buffer, set to the number of stored bytes.
+  * @param  Timeout The time to wait in ms.
+  * @retval Returns OPENBL_HOST_OK if a frame has been received else the error.
+  */
+static OPENBL_HOST_StatusTypeDef SOCKETCAN_Receive(void *pContext, uint32_t *pIdentifier, uint8_t *pData,
+                                                   uint32_t *pLength, uint32_t Timeout)
+{
+  SOCKETCAN_ContextTypeDef *p_context = (SOCKETCAN_ContextTypeDef *)pContext;
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_TIMEOUT;
+  struct canfd_frame frame;
+  struct pollfd poll_fd;
+  uint32_t start;
+  uint32_t elapsed = 0U;
+  ssize_t length;
+
+  poll_fd.fd     = p_context->Socket;
+  poll_fd.events = POLLIN;
+  start          = OPENBL_HOST_GetTick();
+
+  while ((status == OPENBL_HOST_TIMEOUT) && (elapsed < Timeout))
+  {
+    if (poll(&poll_fd, 1U, (int)(Timeout - elapsed)) > 0)
+    {
+      length = read(p_context->Socket, &frame, sizeof(frame));
+
+      if ((length == (ssize_t)CAN_MTU) || (length == (ssize_t)CANFD_MTU))
+      {
+        *pIdentifier = frame.can_id & CAN_SFF_MASK;
+        *pLength     = (frame.len < *pLength) ? frame.len : *pLength;
+
+        (void)memcpy(pData, frame.data, *pLength);
+
+        status = OPENBL_HOST_OK;
+      }
+      else if ((length < 0) && (errno != EINTR) && (errno != EAGAIN))
+      {
+        status = OPENBL_HOST_ERROR;
+      }
+      else
+      {
+        /* Interrupted, retried */
+      }
+    }
+
+    elapsed = OPENBL_HOST_GetTick() - start;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to close the socket.
+  * @param  pContext Pointer to the SocketCAN context.
+  * @retval None.
+  */
+static void SOCKETCAN_Close(void *pContext)
+{
+  (void)close(((SOCKETCAN_ContextTypeDef *)pContext)->Socket);
+  free(pContext);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to open a SocketCAN back-end.
+  *         Only the standard data frames are received.
+  * @param  pBackend Pointer to the back-end to be filled.
+  * @param  pInterface The network interface, can0 for instance.
+  * @param  FdMode 1 to send CAN FD frames (FDCAN protocol), 0 for classic frames (CAN protocol).
+  * @retval Returns OPENBL_HOST_OK if the socket has been opened else OPENBL_HOST_ERROR.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_SocketCanOpen(OPENBL_HOST_BackendTypeDef *pBackend, const char *pInterface,
+                                                    uint8_t FdMode)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_ERROR;
+  SOCKETCAN_ContextTypeDef *p_context;
+  struct sockaddr_can address;
+  struct can_filter filter;
+  int enable = 1;
+
+  p_context = malloc(sizeof(SOCKETCAN_ContextTypeDef));
+
+  if (p_context != NULL)
+  {
+    (void)memset(&address, 0, sizeof(address));
+
+    address.can_family  = AF_CAN;
+    address.can_ifindex = (int)if_nametoindex(pInterface);
+
+    filter.can_id   = 0U;
+    filter.can_mask = CAN_EFF_FLAG | CAN_RTR_FLAG;
+
+    p_context->FdMode = FdMode;
+    p_context->Socket = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+
+    if ((p_context->Socket >= 0) && (address.can_ifindex != 0)
+        && (setsockopt(p_context->Socket, SOL_CAN_RAW, CAN_RAW_FILTER, &filter, sizeof(filter)) == 0)
+        && ((FdMode == 0U)
+            || (setsockopt(p_context->Socket, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable)) == 0))
+        && (bind(p_context->Socket, (struct sockaddr *)&address, sizeof(address)) == 0))
+    {
+      pBackend->pContext = p_context;
+      pBackend->Send     = SOCKETCAN_Send;
+      pBackend->Receive  = SOCKETCAN_Receive;
+      pBackend->Close    = SOCKETCAN_Close;
+
+      status = OPENBL_HOST_OK;
+    }
+    else
+    {
+      if (p_context->Socket >= 0)
+      {
+        (void)close(p_context->Socket);
+      }
+
+      free(p_context);
+    }
+  }
+
+  return status;
+}
@@ -0,0 +1,190 @@
+/**
+  ******************************************************************************
+  * @file    openbl_host_spidev.c
+  * @author  MCD Application Team
+  * @brief   Linux spidev back-end of the host library, for the SPI protocol
+  *          The bus runs in mode 0, MSB first. The host receives by clocking out dummy 0x00 bytes,
+  *          the bytes clocked in while sending are dropped.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <linux/spi/spidev.h>
+
+#include "openbl_host.h"
+#include "openbl_host_engine.h"
+#include "openbl_host_backends.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  int Device;
+  uint32_t Speed;                   /* Clock in Hz */
+} SPIDEV_ContextTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define SPIDEV_TRANSFER_SIZE              4096U     /* Largest transfer of the spidev driver, its default buffer */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static OPENBL_HOST_StatusTypeDef SPIDEV_Transfer(SPIDEV_ContextTypeDef *pContext, const uint8_t *pTxData,
+                                                 uint8_t *pRxData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef SPIDEV_Send(void *pContext, uint32_t Identifier, const uint8_t *pData,
+                                             uint32_t Length);
+static OPENBL_HOST_StatusTypeDef SPIDEV_Receive(void *pContext, uint32_t *pIdentifier, uint8_t *pData,
+                                                uint32_t *pLength, uint32_t Timeout);
+static void SPIDEV_Close(void *pContext);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to run full duplex transfers of at most SPIDEV_TRANSFER_SIZE bytes.
+  * @param  pContext Pointer to the spidev context.
+  * @param  pTxData Pointer to the data to be sent, NULL to send dummy bytes.
+  * @param  pRxData Pointer to the buffer of the received data, NULL to drop them.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the bytes have been transferred else OPENBL_HOST_ERROR.
+  */
+static OPENBL_HOST_StatusTypeDef SPIDEV_Transfer(SPIDEV_ContextTypeDef *pContext, const uint8_t *pTxData,
+                                                 uint8_t *pRxData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  struct spi_ioc_transfer transfer;
+  uint32_t length;
+
+  while ((Length != 0U) && (status == OPENBL_HOST_OK))
+  {
+    length = (Length > SPIDEV_TRANSFER_SIZE) ? SPIDEV_TRANSFER_SIZE : Length;
+
+    (void)memset(&transfer, 0, sizeof(transfer));
+
+    transfer.tx_buf        = (uintptr_t)pTxData;
+    transfer.rx_buf        = (uintptr_t)pRxData;
+    transfer.len           = length;
+    transfer.speed_hz      = pContext->Speed;
+    transfer.bits_per_word = 8U;
+
+    if (ioctl(pContext->Device, SPI_IOC_MESSAGE(1), &transfer) < 0)
+    {
+      status = OPENBL_HOST_ERROR;
+    }
+
+    pTxData = (pTxData != NULL) ? &pTxData[length] : NULL;
+    pRxData = (pRxData != NULL) ? &pRxData[length] : NULL;
+    Length -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to send bytes.
+  * @param  pContext Pointer to the spidev context.
+  * @param  Identifier Not used.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the bytes have been sent else OPENBL_HOST_ERROR.
+  */
+static OPENBL_HOST_StatusTypeDef SPIDEV_Send(void *pContext, uint32_t Identifier, const uint8_t *pData,
+                                             uint32_t Length)
+{
+  (void)Identifier;
+
+  return SPIDEV_Transfer((SPIDEV_ContextTypeDef *)pContext, pData, NULL, Length);
+}
+
+/**
+  * @brief  This function is used to receive bytes, the engine polls the device while it is busy.
+  * @param  pContext Pointer to the spidev context.
+  * @param  pIdentifier Not used.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  pLength Pointer to the number of bytes.
+  * @param  Timeout Not used, the master clocks the bytes out.
+  * @retval Returns OPENBL_HOST_OK if the bytes have been received else OPENBL_HOST_ERROR.
+  */
+static OPENBL_HOST_StatusTypeDef SPIDEV_Receive(void *pContext, uint32_t *pIdentifier, uint8_t *pData,
+                                                uint32_t *pLength, uint32_t Timeout)
+{
+  (void)Timeout;
+
+  *pIdentifier = 0U;
+
+  return SPIDEV_Transfer((SPIDEV_ContextTypeDef *)pContext, NULL, pData, *pLength);
+}
+
+/**
+  * @brief  This function is used to close the device.
+  * @param  pContext Pointer to the spidev context.
+  * @retval None.
+  */
+static void SPIDEV_Close(void *pContext)
+{
+  (void)close(((SPIDEV_ContextTypeDef *)pContext)->Device);
+  free(pContext);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to open a spidev back-end.
+  * @param  pBackend Pointer to the back-end to be filled.
+  * @param  pDevice The spidev device, /dev/spidev0.0 for instance.
+  * @param  Speed The clock in Hz.
+  * @retval Returns OPENBL_HOST_OK if the device has been opened else OPENBL_HOST_ERROR.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_SpidevOpen(OPENBL_HOST_BackendTypeDef *pBackend, const char *pDevice,
+                                                 uint32_t Speed)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_ERROR;
+  SPIDEV_ContextTypeDef *p_context;
+  uint8_t mode = SPI_MODE_0;
+  uint8_t bits = 8U;
+
+  p_context = malloc(sizeof(SPIDEV_ContextTypeDef));
+
+  if (p_context != NULL)
+  {
+    p_context->Speed  = Speed;
+    p_context->Device = open(pDevice, O_RDWR);
+
+    if ((p_context->Device >= 0)
+        && (ioctl(p_context->Device, SPI_IOC_WR_MODE, &mode) == 0)
+        && (ioctl(p_context->Device, SPI_IOC_WR_BITS_PER_WORD, &bits) == 0)
+        && (ioctl(p_context->Device, SPI_IOC_WR_MAX_SPEED_HZ, &Speed) == 0))
+    {
+      pBackend->pContext = p_context;
+      pBackend->Send     = SPIDEV_Send;
+      pBackend->Receive  = SPIDEV_Receive;
+      pBackend->Close    = SPIDEV_Close;
+
+      status = OPENBL_HOST_OK;
+    }
+    else
+    {
+      if (p_context->Device >= 0)
+      {
+        (void)close(p_context->Device);
+      }
+
+      free(p_context);
+    }
+  }
+
+  return status;
+}
@@ -0,0 +1,921 @@
+/**
+  ******************************************************************************
+  * @file    openbl_host.c
+  * @author  MCD Application Team
+  * @brief   Host side of the Open Bootloader protocols
+  *          This file provides the programming services of a host connected to an Open Bootloader device:
+  *           + Connection and reading of the device information
+  *           + Memory read, write, erase and jump
+  *           + Programming verified by the device CRC-32 or by reading back the memory
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "openbl_host.h"
+#include "openbl_host_engine.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define OPENBL_HOST_CRC32_POLYNOMIAL      0xEDB88320U /* Reflected CRC-32 polynomial, same as the device one */
+#define OPENBL_HOST_GROUP_DEFAULT         0x01U     /* Default group used for the group writes */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+
+/* Protocol engines, indexed by OPENBL_HOST_ProtocolTypeDef */
+static const OPENBL_HOST_EngineTypeDef *const a_OPENBL_HOST_Engines[] =
+{
+  &OPENBL_HOST_UsartEngine,
+  &OPENBL_HOST_I2cEngine,
+  &OPENBL_HOST_SpiEngine,
+  &OPENBL_HOST_CanEngine,
+  &OPENBL_HOST_FdcanEngine,
+  &OPENBL_HOST_I3cEngine
+};
+
+static const char *const a_OPENBL_HOST_StatusNames[] =
+{
+  "OK",
+  "error",
+  "timeout",
+  "NACK",
+  "not supported",
+  "verify error"
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static OPENBL_HOST_StatusTypeDef OPENBL_HOST_GroupProgram(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                          const uint8_t *pData, uint32_t Length);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to initialize a host handle with the default settings.
+  * @param  pHandle Pointer to the handle.
+  * @param  Protocol The protocol spoken by the device.
+  * @param  pBackend Pointer to the back-end moving the data, it must stay valid while the handle is used.
+  * @retval None.
+  */
+void OPENBL_HOST_Init(OPENBL_HOST_HandleTypeDef *pHandle, OPENBL_HOST_ProtocolTypeDef Protocol,
+                      const OPENBL_HOST_BackendTypeDef *pBackend)
+{
+  (void)memset(pHandle, 0, sizeof(*pHandle));
+
+  pHandle->Protocol       = Protocol;
+  pHandle->pBackend       = pBackend;
+  pHandle->pEngine        = a_OPENBL_HOST_Engines[Protocol];
+  pHandle->Timeout        = OPENBL_HOST_TIMEOUT_DEFAULT;
+  pHandle->EraseTimeout   = OPENBL_HOST_ERASE_TIMEOUT_DEFAULT;
+  pHandle->NodeId         = OPENBL_HOST_NO_NODE_ID;
+  pHandle->GroupId        = OPENBL_HOST_GROUP_DEFAULT;
+  pHandle->GroupBlockTime = OPENBL_HOST_GROUP_BLOCK_TIME_DEFAULT;
+}
+
+/**
+  * @brief  This function is used to release the back-end of a host handle.
+  * @param  pHandle Pointer to the handle.
+  * @retval None.
+  */
+void OPENBL_HOST_DeInit(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  if (pHandle->pBackend->Close != NULL)
+  {
+    pHandle->pBackend->Close(pHandle->pBackend->pContext);
+  }
+}
+
+/**
+  * @brief  This function is used to connect to the device and to read its version, commands and identifier.
+  *         The largest frames supported by the device are then selected for the memory transfers.
+  * @param  pHandle Pointer to the handle.
+  * @retval Returns OPENBL_HOST_OK if the device answered else the error.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_Connect(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  const OPENBL_HOST_EngineTypeDef *p_engine = pHandle->pEngine;
+  OPENBL_HOST_StatusTypeDef status;
+
+  status = p_engine->Connect(pHandle);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = p_engine->GetVersion(pHandle);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    if (p_engine->GetCommand != NULL)
+    {
+      status = p_engine->GetCommand(pHandle);
+    }
+    else
+    {
+      (void)memcpy(pHandle->Commands, p_engine->pDefaultCommands, p_engine->DefaultCommandsNumber);
+      pHandle->CommandsNumber = p_engine->DefaultCommandsNumber;
+    }
+  }
+
+  if ((status == OPENBL_HOST_OK) && (OPENBL_HOST_IsCommandSupported(pHandle, OPENBL_HOST_CMD_GET_ID) != 0U))
+  {
+    status = p_engine->GetId(pHandle);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    p_engine->Configure(pHandle);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to check whether the device supports a command.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  OpCode The command opcode.
+  * @retval Returns 1 if the command is supported else 0.
+  */
+uint8_t OPENBL_HOST_IsCommandSupported(const OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode)
+{
+  uint32_t counter;
+  uint8_t supported = 0U;
+
+  for (counter = 0U; counter < pHandle->CommandsNumber; counter++)
+  {
+    if (pHandle->Commands[counter] == OpCode)
+    {
+      supported = 1U;
+    }
+  }
+
+  return supported;
+}
+
+/**
+  * @brief  This function is used to read the device memory, in commands of ReadChunk bytes.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the memory has been read else the error.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_ReadMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                 uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  uint32_t length;
+
+  while ((Length != 0U) && (status == OPENBL_HOST_OK))
+  {
+    length = (Length > pHandle->ReadChunk) ? pHandle->ReadChunk : Length;
+    status = pHandle->pEngine->ReadMemory(pHandle, Address, pData, length);
+
+    pHandle->Statistics.Commands++;
+    pHandle->Statistics.BytesRead += (status == OPENBL_HOST_OK) ? length : 0U;
+
+    Address += length;
+    pData   += length;
+    Length  -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to write the device memory, in commands of WriteChunk bytes.
+  *         In group mode, the written data is added to the CRC-32 compared with the device one.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the memory has been written else the error.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_WriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                  const uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  uint32_t length;
+
+  while ((Length != 0U) && (status == OPENBL_HOST_OK))
+  {
+    length = (Length > pHandle->WriteChunk) ? pHandle->WriteChunk : Length;
+    status = pHandle->pEngine->WriteMemory(pHandle, Address, pData, length);
+
+    if (pHandle->GroupActive != 0U)
+    {
+      pHandle->GroupCrc = OPENBL_HOST_Crc32(pHandle->GroupCrc, pData, length);
+    }
+
+    pHandle->Statistics.Commands++;
+    pHandle->Statistics.BytesWritten += (status == OPENBL_HOST_OK) ? length : 0U;
+
+    Address += length;
+    pData   += length;
+    Length  -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to compare the device memory with the given data by reading it back.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the expected data.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_VERIFY_ERROR if the memory differs, OPENBL_HOST_OK if it matches else the error.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_VerifyMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                   const uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  uint32_t length;
+  uint8_t *p_buffer;
+
+  p_buffer = malloc((Length > pHandle->ReadChunk) ? pHandle->ReadChunk : Length);
+
+  if (p_buffer == NULL)
+  {
+    status = OPENBL_HOST_ERROR;
+  }
+
+  while ((Length != 0U) && (status == OPENBL_HOST_OK))
+  {
+    length = (Length > pHandle->ReadChunk) ? pHandle->ReadChunk : Length;
+    status = OPENBL_HOST_ReadMemory(pHandle, Address, p_buffer, length);
+
+    if ((status == OPENBL_HOST_OK) && (memcmp(p_buffer, pData, length) != 0))
+    {
+      status = OPENBL_HOST_VERIFY_ERROR;
+    }
+
+    Address += length;
+    pData   += length;
+    Length  -= length;
+  }
+
+  free(p_buffer);
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to write and verify the device memory.
+  *         When the device supports the group command and its node identifier is known, the data is
+  *         streamed without waiting for the acknowledges and checked with the CRC-32 computed by the device.
+  *         When the staging area of the device is known, the data is programmed by Commit Memory and
+  *         checked by the device. Otherwise, the memory is written then read back.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the memory has been programmed else the error.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_Program(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                              const uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status;
+
+  if ((pHandle->pEngine->GroupJoin != NULL) && (pHandle->NodeId != OPENBL_HOST_NO_NODE_ID)
+      && (OPENBL_HOST_IsCommandSupported(pHandle, OPENBL_HOST_CMD_GROUP_COMMAND) != 0U))
+  {
+    status = OPENBL_HOST_GroupProgram(pHandle, Address, pData, Length);
+  }
+  else if ((pHandle->pEngine->CommitMemory != NULL) && (pHandle->StagingSize != 0U)
+           && (OPENBL_HOST_IsCommandSupported(pHandle, OPENBL_HOST_CMD_COMMIT_MEMORY) != 0U))
+  {
+    status = OPENBL_HOST_CommitMemory(pHandle, Address, pData, Length);
+  }
+  else
+  {
+    if ((pHandle->Compression != 0U) && (pHandle->pEngine->CompressedWriteMemory != NULL)
+        && ((OPENBL_HOST_IsCommandSupported(pHandle, OPENBL_HOST_CMD_COMPRESSED_WRITE) != 0U)
+            || (pHandle->pEngine->GetCommand == NULL)))
+    {
+      status = OPENBL_HOST_CompressedWriteMemory(pHandle, Address, pData, Length);
+    }
+    else
+    {
+      status = OPENBL_HOST_WriteMemory(pHandle, Address, pData, Length);
+    }
+
+    if (status == OPENBL_HOST_OK)
+    {
+      status = OPENBL_HOST_VerifyMemory(pHandle, Address, pData, Length);
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to program the Flash through the RAM staging area of the device.
+  *         The data is written in the staging area at the speed of the link, then each staging area
+  *         is programmed at once by the device with Commit Memory, which erases the Flash pages it covers
+  *         and checks the CRC-32 of the data before and after programming it.
+  * @param  pHandle Pointer to the connected handle, with its staging area set.
+  * @param  Address The Flash start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the Flash has been programmed and checked else the error.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_CommitMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                   const uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  uint32_t length;
+
+  if ((pHandle->pEngine->CommitMemory == NULL) || (pHandle->StagingSize == 0U))
+  {
+    status = OPENBL_HOST_UNSUPPORTED;
+  }
+
+  while ((Length != 0U) && (status == OPENBL_HOST_OK))
+  {
+    length = (Length > pHandle->StagingSize) ? pHandle->StagingSize : Length;
+    status = OPENBL_HOST_WriteMemory(pHandle, pHandle->StagingAddress, pData, length);
+
+    if (status == OPENBL_HOST_OK)
+    {
+      status = pHandle->pEngine->CommitMemory(pHandle, Address, length, OPENBL_HOST_Crc32(0U, pData, length));
+
+      pHandle->Statistics.Commands++;
+    }
+
+    Address += length;
+    pData   += length;
+    Length  -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to write the device memory with Compressed Write Memory commands.
+  *         The data is compressed in the LZ4 block format by segments of OPENBL_HOST_LZ4_SEGMENT_SIZE bytes,
+  *         each command holding as many segments as fit in OPENBL_HOST_LZ4_OUTPUT_MAX bytes. The matches may
+  *         refer to any data written before, the device reads it back from its memory.
+  *         The segments which do not compress are written with Write Memory.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the memory has been written else the error.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_CompressedWriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                            const uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  OPENBL_HOST_Lz4TypeDef lz4 = {NULL, OPENBL_HOST_LZ4_TABLE_SIZE, NULL, 0U, 0U};
+  uint8_t frame[OPENBL_HOST_LZ4_OUTPUT_MAX];
+  uint32_t position = 0U;
+  uint32_t length;
+  uint32_t compressed;
+
+  lz4.pTable = malloc(OPENBL_HOST_LZ4_TABLE_SIZE * sizeof(uint32_t));
+
+  if (lz4.pTable == NULL)
+  {
+    status = OPENBL_HOST_ERROR;
+  }
+  else if (pHandle->pEngine->CompressedWriteMemory == NULL)
+  {
+    status = OPENBL_HOST_UNSUPPORTED;
+  }
+  else
+  {
+    /* No match found yet */
+    (void)memset(lz4.pTable, 0xFF, OPENBL_HOST_LZ4_TABLE_SIZE * sizeof(uint32_t));
+  }
+
+  while ((position < Length) && (status == OPENBL_HOST_OK))
+  {
+    length = OPENBL_HOST_Lz4Compress(&lz4, pData, Length, position, frame, OPENBL_HOST_LZ4_OUTPUT_MAX, &compressed);
+
+    if ((length == 0U) || (compressed >= length))
+    {
+      if (length == 0U)
+      {
+        length = ((Length - position) > OPENBL_HOST_LZ4_SEGMENT_SIZE) ? OPENBL_HOST_LZ4_SEGMENT_SIZE
+                                                                      : (Length - position);
+      }
+
+      status = OPENBL_HOST_WriteMemory(pHandle, Address + position, &pData[position], length);
+    }
+    else
+    {
+      status = pHandle->pEngine->CompressedWriteMemory(pHandle, Address + position, frame, compressed);
+
+      if (pHandle->GroupActive != 0U)
+      {
+        pHandle->GroupCrc = OPENBL_HOST_Crc32(pHandle->GroupCrc, &pData[position], length);
+      }
+
+      pHandle->Statistics.Commands++;
+      pHandle->Statistics.BytesWritten += (status == OPENBL_HOST_OK) ? length : 0U;
+    }
+
+    position += length;
+  }
+
+  free(lz4.pTable);
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to write the device memory with Patch Memory commands: a new image is built
+  *         by the device from the old one, installed in its memory, only the changes cross the link.
+  *         Each command holds the address of the old image pointer, then segments of 256 bytes encoded as
+  *         LZ4 sequences whose matches are copied from the old image around the pointer. The segments which
+  *         do not shrink are written with Write Memory. The new image must not overlap the old one.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address of the new image.
+  * @param  pData Pointer to the new image.
+  * @param  Length The number of bytes of the new image.
+  * @param  SourceAddress The start address of the old image in the device memory.
+  * @param  pSource Pointer to the old image, as installed in the device.
+  * @param  SourceLength The number of bytes of the old image.
+  * @retval Returns OPENBL_HOST_OK if the memory has been written else the error.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_PatchMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                  const uint8_t *pData, uint32_t Length, uint32_t SourceAddress,
+                                                  const uint8_t *pSource, uint32_t SourceLength)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  OPENBL_HOST_Lz4TypeDef lz4 = {NULL, OPENBL_HOST_PATCH_TABLE_SIZE, pSource, SourceLength, 0U};
+  uint8_t frame[OPENBL_HOST_LZ4_OUTPUT_MAX];
+  uint32_t position = 0U;
+  uint32_t source;
+  uint32_t length;
+  uint32_t encoded;
+
+  lz4.pTable = malloc(OPENBL_HOST_PATCH_TABLE_SIZE * sizeof(uint32_t));
+
+  if (lz4.pTable == NULL)
+  {
+    status = OPENBL_HOST_ERROR;
+  }
+  else if (pHandle->pEngine->PatchMemory == NULL)
+  {
+    status = OPENBL_HOST_UNSUPPORTED;
+  }
+  else
+  {
+    (void)memset(lz4.pTable, 0xFF, OPENBL_HOST_PATCH_TABLE_SIZE * sizeof(uint32_t));
+
+    OPENBL_HOST_Lz4IndexSource(&lz4);
+  }
+
+  while ((position < Length) && (status == OPENBL_HOST_OK))
+  {
+    /* The old image address comes first */
+    source = lz4.SourcePosition;
+    length = OPENBL_HOST_Lz4Compress(&lz4, pData, Length, position, &frame[4], OPENBL_HOST_LZ4_OUTPUT_MAX - 4U,
+                                     &encoded);
+
+    if ((length == 0U) || ((encoded + 4U) >= length))
+    {
+      if (length == 0U)
+      {
+        length = ((Length - position) > OPENBL_HOST_LZ4_SEGMENT_SIZE) ? OPENBL_HOST_LZ4_SEGMENT_SIZE
+                                                                      : (Length - position);
+      }
+
+      /* The old image pointer follows the new image */
+      lz4.SourcePosition = source + length;
+
+      status = OPENBL_HOST_WriteMemory(pHandle, Address + position, &pData[position], length);
+    }
+    else
+    {
+      (void)OPENBL_HOST_PutWord(frame, SourceAddress + source);
+
+      status = pHandle->pEngine->PatchMemory(pHandle, Address + position, frame, encoded + 4U);
+
+      if (pHandle->GroupActive != 0U)
+      {
+        pHandle->GroupCrc = OPENBL_HOST_Crc32(pHandle->GroupCrc, &pData[position], length);
+      }
+
+      pHandle->Statistics.Commands++;
+      pHandle->Statistics.BytesWritten += (status == OPENBL_HOST_OK) ? length : 0U;
+    }
+
+    position += length;
+  }
+
+  free(lz4.pTable);
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to read the CRC-32 of consecutive blocks of the device memory,
+  *         in commands of at most OPENBL_HOST_BLOCK_CRC_MAX blocks.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address of the first block.
+  * @param  BlockSize The number of bytes of each block.
+  * @param  BlocksNumber The number of blocks.
+  * @param  pCrc Pointer to the array receiving the CRC-32 of each block.
+  * @retval Returns OPENBL_HOST_OK if the CRCs have been read else the error.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_GetBlockCrc(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                  uint32_t BlockSize, uint32_t BlocksNumber, uint32_t *pCrc)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  uint8_t data[OPENBL_HOST_BLOCK_CRC_MAX * 4U];
+  uint32_t blocks;
+  uint32_t counter;
+
+  if (pHandle->pEngine->GetBlockCrc == NULL)
+  {
+    status = OPENBL_HOST_UNSUPPORTED;
+  }
+
+  while ((BlocksNumber != 0U) && (status == OPENBL_HOST_OK))
+  {
+    blocks = (BlocksNumber > OPENBL_HOST_BLOCK_CRC_MAX) ? OPENBL_HOST_BLOCK_CRC_MAX : BlocksNumber;
+    status = pHandle->pEngine->GetBlockCrc(pHandle, Address, BlockSize, blocks, data);
+
+    pHandle->Statistics.Commands++;
+
+    for (counter = 0U; (counter < blocks) && (status == OPENBL_HOST_OK); counter++)
+    {
+      pCrc[counter] = ((uint32_t)data[counter * 4U] << 24U) | ((uint32_t)data[(counter * 4U) + 1U] << 16U)
+                      | ((uint32_t)data[(counter * 4U) + 2U] << 8U) | (uint32_t)data[(counter * 4U) + 3U];
+    }
+
+    Address      += blocks * BlockSize;
+    pCrc         += blocks;
+    BlocksNumber -= blocks;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to update the device Flash with a new image, page by page.
+  *         The CRC-32 of the pages in the device is read with Get Block CRC, then only the pages which
+  *         differ from the new image are erased and programmed as with OPENBL_HOST_Program, by runs of
+  *         consecutive pages. The last page is compared on the image bytes only.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The Flash address of the image, the start of page FirstPage.
+  * @param  pData Pointer to the image.
+  * @param  Length The number of bytes of the image.
+  * @param  FirstPage The index of the first page.
+  * @param  PageSize The size of the Flash pages.
+  * @param  pPagesWritten Pointer to the returned number of programmed pages, can be NULL.
+  * @retval Returns OPENBL_HOST_OK if the Flash holds the new image else the error.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_Update(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                             const uint8_t *pData, uint32_t Length, uint32_t FirstPage,
+                                             uint32_t PageSize, uint32_t *pPagesWritten)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  uint32_t *p_crc = NULL;
+  uint32_t pages_number;
+  uint32_t first;
+  uint32_t page;
+  uint32_t length;
+  uint32_t written = 0U;
+
+  pages_number = (PageSize == 0U) ? 0U : ((Length + PageSize - 1U) / PageSize);
+
+  if ((pHandle->pEngine->GetBlockCrc == NULL)
+      || ((OPENBL_HOST_IsCommandSupported(pHandle, OPENBL_HOST_CMD_GET_BLOCK_CRC) == 0U)
+          && (pHandle->pEngine->GetCommand != NULL)))
+  {
+    status = OPENBL_HOST_UNSUPPORTED;
+  }
+  else if (pages_number == 0U)
+  {
+    /* Nothing to compare */
+  }
+  else
+  {
+    p_crc = malloc(pages_number * sizeof(uint32_t));
+
+    if (p_crc == NULL)
+    {
+      status = OPENBL_HOST_ERROR;
+    }
+  }
+
+  /* The whole pages, then the last one on the image bytes only */
+  if ((status == OPENBL_HOST_OK) && (pages_number != 0U))
+  {
+    status = OPENBL_HOST_GetBlockCrc(pHandle, Address, PageSize, Length / PageSize, p_crc);
+  }
+
+  if ((status == OPENBL_HOST_OK) && (pages_number != (Length / PageSize)))
+  {
+    status = OPENBL_HOST_GetBlockCrc(pHandle, Address + ((pages_number - 1U) * PageSize), Length % PageSize, 1U,
+                                     &p_crc[pages_number - 1U]);
+  }
+
+  /* The pages to write are left with a CRC difference */
+  for (page = 0U; (page < pages_number) && (status == OPENBL_HOST_OK); page++)
+  {
+    length = ((Length - (page * PageSize)) > PageSize) ? PageSize : (Length - (page * PageSize));
+
+    p_crc[page] ^= OPENBL_HOST_Crc32(0U, &pData[page * PageSize], length);
+  }
+
+  /* Erase and program each run of consecutive pages to write */
+  page = 0U;
+
+  while ((page < pages_number) && (status == OPENBL_HOST_OK))
+  {
+    first = page;
+
+    while ((page < pages_number) && ((p_crc[page] != 0U) == (p_crc[first] != 0U)))
+    {
+      page++;
+    }
+
+    if (p_crc[first] != 0U)
+    {
+      length = ((page * PageSize) > Length) ? (Length - (first * PageSize)) : ((page - first) * PageSize);
+      status = OPENBL_HOST_ErasePages(pHandle, FirstPage + first, page - first);
+
+      if (status == OPENBL_HOST_OK)
+      {
+        status = OPENBL_HOST_Program(pHandle, Address + (first * PageSize), &pData[first * PageSize], length);
+      }
+
+      written += page - first;
+    }
+  }
+
+  if (pPagesWritten != NULL)
+  {
+    *pPagesWritten = written;
+  }
+
+  free(p_crc);
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to erase the whole Flash of the device.
+  * @param  pHandle Pointer to the connected handle.
+  * @retval Returns OPENBL_HOST_OK if the Flash has been erased else the error.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_MassErase(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  pHandle->Statistics.Commands++;
+
+  return pHandle->pEngine->EraseMemory(pHandle, 0U, 0U);
+}
+
+/**
+  * @brief  This function is used to erase consecutive Flash pages, in commands of ErasePagesMax pages.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  FirstPage The number of the first page.
+  * @param  PagesNumber The number of pages.
+  * @retval Returns OPENBL_HOST_OK if the pages have been erased else the error.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_ErasePages(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t FirstPage,
+                                                 uint32_t PagesNumber)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  uint32_t pages;
+
+  while ((PagesNumber != 0U) && (status == OPENBL_HOST_OK))
+  {
+    pages  = (PagesNumber > pHandle->pEngine->ErasePagesMax) ? pHandle->pEngine->ErasePagesMax : PagesNumber;
+    status = pHandle->pEngine->EraseMemory(pHandle, FirstPage, pages);
+
+    pHandle->Statistics.Commands++;
+
+    FirstPage   += pages;
+    PagesNumber -= pages;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to make the device jump to an application.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The address of the application vector table.
+  * @retval Returns OPENBL_HOST_OK if the device accepted the address else the error.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_Go(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address)
+{
+  pHandle->Statistics.Commands++;
+
+  return pHandle->pEngine->Go(pHandle, Address);
+}
+
+/**
+  * @brief  This function is used to compute the CRC-32 of a buffer, as computed by the device.
+  * @param  Crc The CRC-32 of the previous data, 0 for the first buffer.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns the CRC-32.
+  */
+uint32_t OPENBL_HOST_Crc32(uint32_t Crc, const uint8_t *pData, uint32_t Length)
+{
+  uint32_t counter;
+  uint32_t crc = ~Crc;
+  uint8_t bit;
+
+  for (counter = 0U; counter < Length; counter++)
+  {
+    crc ^= (uint32_t)pData[counter];
+
+    for (bit = 0U; bit < 8U; bit++)
+    {
+      crc = ((crc & 1U) != 0U) ? ((crc >> 1U) ^ OPENBL_HOST_CRC32_POLYNOMIAL) : (crc >> 1U);
+    }
+  }
+
+  return ~crc;
+}
+
+/**
+  * @brief  This function is used to get the name of a status, for the error messages.
+  * @param  Status The status.
+  * @retval Returns the name.
+  */
+const char *OPENBL_HOST_GetStatusName(OPENBL_HOST_StatusTypeDef Status)
+{
+  return a_OPENBL_HOST_StatusNames[Status];
+}
+
+/**
+  * @brief  This function is used by the engines to send data with the back-end.
+  * @param  pHandle Pointer to the handle.
+  * @param  Identifier The frame identifier, CAN and FDCAN only.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the data has been sent else the error.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_Send(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Identifier,
+                                           const uint8_t *pData, uint32_t Length)
+{
+  return pHandle->pBackend->Send(pHandle->pBackend->pContext, Identifier, pData, Length);
+}
+
+/**
+  * @brief  This function is used by the engines to receive data with the back-end.
+  *         Each call is counted as a round trip, the host waits for the device.
+  * @param  pHandle Pointer to the handle.
+  * @param  pIdentifier Pointer to the returned frame identifier, can be NULL.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  pLength Pointer to the number of bytes wanted, set to the number of received bytes.
+  * @param  Timeout The time to wait in ms.
+  * @retval Returns OPENBL_HOST_OK if data has been received else the error.
+  */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_Receive(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t *pIdentifier,
+                                              uint8_t *pData, uint32_t *pLength, uint32_t Timeout)
+{
+  uint32_t identifier = 0U;
+
+  pHandle->Statistics.RoundTrips++;
+
+  return pHandle->pBackend->Receive(pHandle->pBackend->pContext, (pIdentifier != NULL) ? pIdentifier : &identifier,
+                                    pData, pLength, Timeout);
+}
+
+/**
+  * @brief  This function is used to store a word MSB first.
+  * @param  pBuffer Pointer to the destination buffer.
+  * @param  Value The word to be stored.
+  * @retval Returns the number of stored bytes.
+  */
+uint32_t OPENBL_HOST_PutWord(uint8_t *pBuffer, uint32_t Value)
+{
+  pBuffer[0] = (uint8_t)(Value >> 24U);
+  pBuffer[1] = (uint8_t)(Value >> 16U);
+  pBuffer[2] = (uint8_t)(Value >> 8U);
+  pBuffer[3] = (uint8_t)Value;
+
+  return 4U;
+}
+
+/**
+  * @brief  This function is used to compute the XOR checksum of a buffer.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns the XOR value.
+  */
+uint8_t OPENBL_HOST_Xor(const uint8_t *pData, uint32_t Length)
+{
+  uint32_t counter;
+  uint8_t xor = 0U;
+
+  for (counter = 0U; counter < Length; counter++)
+  {
+    xor ^= pData[counter];
+  }
+
+  return xor;
+}
+
+/**
+  * @brief  This function is used to wait, the group writes give the device time to program each block.
+  * @param  Delay The time to wait in us.
+  * @retval None.
+  */
+void OPENBL_HOST_Delay(uint32_t Delay)
+{
+  struct timespec delay;
+
+  delay.tv_sec  = (time_t)(Delay / 1000000U);
+  delay.tv_nsec = (long)(Delay % 1000000U) * 1000L;
+
+  while (nanosleep(&delay, &delay) != 0)
+  {
+  }
+}
+
+/**
+  * @brief  This function is used to get the time, the engines polling the device use it for their timeouts.
+  * @retval Returns the monotonic time in ms.
+  */
+uint32_t OPENBL_HOST_GetTick(void)
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (uint32_t)(((uint64_t)now.tv_sec * 1000U) + ((uint64_t)now.tv_nsec / 1000000U));
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to program the memory in group mode: the device joins a group, the writes
+  *         are sent without waiting for any response, then the device status and CRC-32 are read.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_VERIFY_ERROR if the device CRC-32 differs, OPENBL_HOST_OK if it matches
+  *         else the error.
+  */
+static OPENBL_HOST_StatusTypeDef OPENBL_HOST_GroupProgram(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                          const uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  OPENBL_HOST_StatusTypeDef leave_status;
+  uint32_t crc = 0U;
+  uint8_t errors = 0U;
+
+  status = pHandle->pEngine->GroupJoin(pHandle);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    pHandle->GroupActive = 1U;
+    pHandle->GroupCrc    = 0U;
+
+    status = OPENBL_HOST_WriteMemory(pHandle, Address, pData, Length);
+
+    if (status == OPENBL_HOST_OK)
+    {
+      status = pHandle->pEngine->GroupStatus(pHandle, &errors, &crc);
+    }
+
+    if ((status == OPENBL_HOST_OK) && (errors != 0U))
+    {
+      status = OPENBL_HOST_NACK;
+    }
+    else if ((status == OPENBL_HOST_OK) && (crc != pHandle->GroupCrc))
+    {
+      status = OPENBL_HOST_VERIFY_ERROR;
+    }
+    else
+    {
+      /* The status is kept */
+    }
+
+    /* Always leave the group, the device acknowledges again the following commands */
+    leave_status = pHandle->pEngine->GroupLeave(pHandle);
+
+    pHandle->GroupActive = 0U;
+
+    if (status == OPENBL_HOST_OK)
+    {
+      status = leave_status;
+    }
+  }
+
+  return status;
+}
@@ -0,0 +1,176 @@
+/**
+  ******************************************************************************
+  * @file    openbl_host.h
+  * @author  MCD Application Team
+  * @brief   Header for openbl_host.c module, host side of the Open Bootloader protocols
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OPENBL_HOST_H
+#define OPENBL_HOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum
+{
+  OPENBL_HOST_OK = 0,
+  OPENBL_HOST_ERROR,                /* Back-end error or unexpected response */
+  OPENBL_HOST_TIMEOUT,              /* No response from the device in time */
+  OPENBL_HOST_NACK,                 /* The device refused the command or its parameters */
+  OPENBL_HOST_UNSUPPORTED,          /* The device or the protocol does not support the operation */
+  OPENBL_HOST_VERIFY_ERROR          /* The memory content differs from the written data */
+} OPENBL_HOST_StatusTypeDef;
+
+typedef enum
+{
+  OPENBL_HOST_USART = 0,
+  OPENBL_HOST_I2C,
+  OPENBL_HOST_SPI,
+  OPENBL_HOST_CAN,
+  OPENBL_HOST_FDCAN,
+  OPENBL_HOST_I3C
+} OPENBL_HOST_ProtocolTypeDef;
+
+/* Back-end moving the bytes or the frames of a protocol, provided by the application:
+   - Send:    sends Length bytes. The stream protocols (USART, SPI, I3C) send a byte stream, I2C sends one
+              write transfer, CAN and FDCAN send one frame with the given identifier.
+   - Receive: *pLength holds the number of bytes wanted. The stream protocols receive exactly this number
+              of bytes, I2C runs one read transfer of this size, CAN and FDCAN receive one frame of at most
+              this size and return its identifier. *pLength is set to the number of received bytes.
+   - Close:   releases the back-end, can be NULL.
+   The stream and I2C back-ends ignore the identifiers. */
+typedef struct
+{
+  void *pContext;
+  OPENBL_HOST_StatusTypeDef (*Send)(void *pContext, uint32_t Identifier, const uint8_t *pData, uint32_t Length);
+  OPENBL_HOST_StatusTypeDef (*Receive)(void *pContext, uint32_t *pIdentifier, uint8_t *pData, uint32_t *pLength,
+                                       uint32_t Timeout);
+  void (*Close)(void *pContext);
+} OPENBL_HOST_BackendTypeDef;
+
+typedef struct
+{
+  uint32_t Commands;                /* Number of commands sent to the device */
+  uint32_t RoundTrips;              /* Number of times the host waited for the device */
+  uint64_t BytesWritten;            /* Memory bytes written */
+  uint64_t BytesRead;               /* Memory bytes read */
+} OPENBL_HOST_StatisticsTypeDef;
+
+typedef struct OPENBL_HOST_EngineStruct OPENBL_HOST_EngineTypeDef;
+
+typedef struct
+{
+  /* Settings, set to their default values by OPENBL_HOST_Init */
+  OPENBL_HOST_ProtocolTypeDef Protocol;
+  const OPENBL_HOST_BackendTypeDef *pBackend;
+  uint32_t Timeout;                 /* Time to wait for a response, in ms */
+  uint32_t EraseTimeout;            /* Time to wait for the end of an erase, in ms */
+  uint8_t Pipelining;               /* 1 to send a whole USART command before reading its acknowledges,
+                                       only for devices buffering their USART reception */
+  uint32_t NodeId;                  /* CAN/FDCAN node identifier, enables the group writes verified by CRC-32 */
+  uint8_t GroupId;                  /* Group used for the group writes */
+  uint32_t GroupBlockTime;          /* Time given to the device to program one block in group mode, in us */
+  uint32_t StagingAddress;          /* RAM staging area of the device, enables the programming by Commit Memory */
+  uint32_t StagingSize;             /* Size of the staging area, a multiple of the Flash page size, 0 if unused */
+  uint8_t Compression;              /* 1 to program with Compressed Write Memory when the device supports it,
+                                       an I2C device is assumed to support it as its command list is not read */
+
+  /* Device information, filled by OPENBL_HOST_Connect */
+  uint8_t Version;                  /* Protocol version */
+  uint16_t DeviceId;                /* Product identifier */
+  uint8_t CommandsNumber;
+  uint8_t Commands[32];             /* Supported command opcodes */
+  uint32_t WriteChunk;              /* Largest number of bytes written by one command */
+  uint32_t ReadChunk;               /* Largest number of bytes read by one command */
+
+  /* Internal state */
+  const OPENBL_HOST_EngineTypeDef *pEngine;
+  uint8_t GroupActive;              /* 1 while the device is in group mode */
+  uint32_t GroupCrc;                /* CRC-32 of the data written in group mode */
+  OPENBL_HOST_StatisticsTypeDef Statistics;
+} OPENBL_HOST_HandleTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+#define OPENBL_HOST_ACK                   0x79U     /* Acknowledge byte */
+#define OPENBL_HOST_NACK_BYTE             0x1FU     /* No acknowledge byte */
+#define OPENBL_HOST_BUSY                  0x76U     /* Busy byte sent by the I2C and SPI devices */
+
+#define OPENBL_HOST_CMD_GET_COMMAND       0x00U
+#define OPENBL_HOST_CMD_GET_VERSION       0x01U
+#define OPENBL_HOST_CMD_GET_ID            0x02U
+#define OPENBL_HOST_CMD_READ_MEMORY       0x11U
+#define OPENBL_HOST_CMD_EXT_READ_MEMORY   0x12U
+#define OPENBL_HOST_CMD_GO                0x21U
+#define OPENBL_HOST_CMD_WRITE_MEMORY      0x31U
+#define OPENBL_HOST_CMD_EXT_WRITE_MEMORY  0x33U
+#define OPENBL_HOST_CMD_LEG_ERASE_MEMORY  0x43U
+#define OPENBL_HOST_CMD_EXT_ERASE_MEMORY  0x44U
+#define OPENBL_HOST_CMD_COMMIT_MEMORY     0x35U
+#define OPENBL_HOST_CMD_COMPRESSED_WRITE  0x36U
+#define OPENBL_HOST_CMD_PATCH_MEMORY      0x37U
+#define OPENBL_HOST_CMD_GET_BLOCK_CRC     0xA3U
+#define OPENBL_HOST_CMD_GROUP_COMMAND     0x52U
+
+#define OPENBL_HOST_NO_NODE_ID            0xFFFFFFFFU /* The node identifier is unknown, no group writes */
+#define OPENBL_HOST_TIMEOUT_DEFAULT       1000U     /* Default response time in ms */
+#define OPENBL_HOST_ERASE_TIMEOUT_DEFAULT 60000U    /* Default erase time in ms */
+#define OPENBL_HOST_GROUP_BLOCK_TIME_DEFAULT 5000U  /* Default programming time of a group block in us */
+#define OPENBL_HOST_BLOCK_CRC_MAX         256U      /* Blocks of one Get Block CRC command */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void OPENBL_HOST_Init(OPENBL_HOST_HandleTypeDef *pHandle, OPENBL_HOST_ProtocolTypeDef Protocol,
+                      const OPENBL_HOST_BackendTypeDef *pBackend);
+void OPENBL_HOST_DeInit(OPENBL_HOST_HandleTypeDef *pHandle);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_Connect(OPENBL_HOST_HandleTypeDef *pHandle);
+uint8_t OPENBL_HOST_IsCommandSupported(const OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_ReadMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                 uint8_t *pData, uint32_t Length);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_WriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                  const uint8_t *pData, uint32_t Length);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_VerifyMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                   const uint8_t *pData, uint32_t Length);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_Program(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                              const uint8_t *pData, uint32_t Length);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_CommitMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                   const uint8_t *pData, uint32_t Length);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_CompressedWriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                            const uint8_t *pData, uint32_t Length);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_PatchMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                  const uint8_t *pData, uint32_t Length, uint32_t SourceAddress,
+                                                  const uint8_t *pSource, uint32_t SourceLength);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_GetBlockCrc(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                  uint32_t BlockSize, uint32_t BlocksNumber, uint32_t *pCrc);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_Update(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                             const uint8_t *pData, uint32_t Length, uint32_t FirstPage,
+                                             uint32_t PageSize, uint32_t *pPagesWritten);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_MassErase(OPENBL_HOST_HandleTypeDef *pHandle);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_ErasePages(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t FirstPage,
+                                                 uint32_t PagesNumber);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_Go(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address);
+uint32_t OPENBL_HOST_Crc32(uint32_t Crc, const uint8_t *pData, uint32_t Length);
+const char *OPENBL_HOST_GetStatusName(OPENBL_HOST_StatusTypeDef Status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OPENBL_HOST_H */
@@ -0,0 +1,108 @@
+/**
+  ******************************************************************************
+  * @file    openbl_host_engine.h
+  * @author  MCD Application Team
+  * @brief   Interface between the host core and the protocol engines
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OPENBL_HOST_ENGINE_H
+#define OPENBL_HOST_ENGINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "openbl_host.h"
+
+/* Exported types ------------------------------------------------------------*/
+
+/* Match finder of the LZ4 compression, kept from one command to the next */
+typedef struct
+{
+  uint32_t *pTable;                 /* Last position of each hashed 4-byte sequence, 0xFFFFFFFF when none */
+  uint32_t TableSize;               /* Number of entries, a power of 2 */
+  const uint8_t *pSource;           /* Old image of a delta patch, where the matches are searched, else NULL */
+  uint32_t SourceLength;
+  uint32_t SourcePosition;          /* Old image pointer of a delta patch, updated */
+} OPENBL_HOST_Lz4TypeDef;
+
+/* Protocol engine, each function runs one command of the protocol.
+   The core splits the transfers in chunks of at most WriteChunk/ReadChunk bytes and the erase in
+   commands of at most ErasePagesMax pages. */
+struct OPENBL_HOST_EngineStruct
+{
+  OPENBL_HOST_StatusTypeDef (*Connect)(OPENBL_HOST_HandleTypeDef *pHandle);
+  OPENBL_HOST_StatusTypeDef (*GetVersion)(OPENBL_HOST_HandleTypeDef *pHandle);
+  OPENBL_HOST_StatusTypeDef (*GetCommand)(OPENBL_HOST_HandleTypeDef *pHandle); /* NULL if it can not be read */
+  OPENBL_HOST_StatusTypeDef (*GetId)(OPENBL_HOST_HandleTypeDef *pHandle);
+  void (*Configure)(OPENBL_HOST_HandleTypeDef *pHandle);  /* Selects the chunks from the supported commands */
+  OPENBL_HOST_StatusTypeDef (*ReadMemory)(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address, uint8_t *pData,
+                                          uint32_t Length);
+  OPENBL_HOST_StatusTypeDef (*WriteMemory)(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                           const uint8_t *pData, uint32_t Length);
+  OPENBL_HOST_StatusTypeDef (*EraseMemory)(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t FirstPage,
+                                           uint32_t PagesNumber); /* 0 pages for a mass erase */
+  OPENBL_HOST_StatusTypeDef (*Go)(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address);
+  OPENBL_HOST_StatusTypeDef (*GroupJoin)(OPENBL_HOST_HandleTypeDef *pHandle);  /* NULL without group mode */
+  OPENBL_HOST_StatusTypeDef (*GroupStatus)(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t *pErrors, uint32_t *pCrc);
+  OPENBL_HOST_StatusTypeDef (*GroupLeave)(OPENBL_HOST_HandleTypeDef *pHandle);
+  OPENBL_HOST_StatusTypeDef (*CommitMemory)(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address, uint32_t Length,
+                                            uint32_t Crc);  /* NULL without RAM staging */
+  OPENBL_HOST_StatusTypeDef (*CompressedWriteMemory)(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                     const uint8_t *pData,
+                                                     uint32_t Length);  /* NULL without compressed writes */
+  OPENBL_HOST_StatusTypeDef (*PatchMemory)(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                           const uint8_t *pData, uint32_t Length);  /* NULL without patches */
+  OPENBL_HOST_StatusTypeDef (*GetBlockCrc)(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address, uint32_t BlockSize,
+                                           uint32_t BlocksNumber, uint8_t *pData);  /* NULL without block CRCs */
+  uint32_t ErasePagesMax;           /* Pages erased by one command */
+  const uint8_t *pDefaultCommands;  /* Commands assumed when GetCommand is NULL */
+  uint8_t DefaultCommandsNumber;
+};
+
+/* Exported constants --------------------------------------------------------*/
+#define OPENBL_HOST_LZ4_SEGMENT_SIZE      256U      /* Data compressed as a whole, a command holds whole segments */
+#define OPENBL_HOST_LZ4_OUTPUT_MAX        256U      /* Compressed bytes of one command */
+#define OPENBL_HOST_LZ4_TABLE_SIZE        4096U     /* Entries of the match finder hash table */
+#define OPENBL_HOST_PATCH_TABLE_SIZE      0x10000U  /* Entries of the hash table of an old image */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+extern const OPENBL_HOST_EngineTypeDef OPENBL_HOST_UsartEngine;
+extern const OPENBL_HOST_EngineTypeDef OPENBL_HOST_I2cEngine;
+extern const OPENBL_HOST_EngineTypeDef OPENBL_HOST_SpiEngine;
+extern const OPENBL_HOST_EngineTypeDef OPENBL_HOST_I3cEngine;
+extern const OPENBL_HOST_EngineTypeDef OPENBL_HOST_CanEngine;
+extern const OPENBL_HOST_EngineTypeDef OPENBL_HOST_FdcanEngine;
+
+/* Exported functions ------------------------------------------------------- */
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_Send(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Identifier,
+                                           const uint8_t *pData, uint32_t Length);
+OPENBL_HOST_StatusTypeDef OPENBL_HOST_Receive(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t *pIdentifier,
+                                              uint8_t *pData, uint32_t *pLength, uint32_t Timeout);
+uint32_t OPENBL_HOST_PutWord(uint8_t *pBuffer, uint32_t Value);
+uint8_t OPENBL_HOST_Xor(const uint8_t *pData, uint32_t Length);
+void OPENBL_HOST_Delay(uint32_t Delay);
+uint32_t OPENBL_HOST_GetTick(void);
+uint32_t OPENBL_HOST_Lz4Compress(OPENBL_HOST_Lz4TypeDef *pLz4, const uint8_t *pData, uint32_t Length,
+                                 uint32_t Position, uint8_t *pOutput, uint32_t OutputMax, uint32_t *pOutputLength);
+void OPENBL_HOST_Lz4IndexSource(OPENBL_HOST_Lz4TypeDef *pLz4);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OPENBL_HOST_ENGINE_H */
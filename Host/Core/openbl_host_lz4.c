@@ -0,0 +1,359 @@
+/**
+  ******************************************************************************
+  * @file    openbl_host_lz4.c
+  * @author  MCD Application Team
+  * @brief   LZ4 block encoding of the Compressed Write Memory and Patch Memory commands
+  *          The data is encoded by segments, a command holding whole segments only, so that the device
+  *          writes the Flash on the same boundaries as with Write Memory.
+  *           + Compression: the matches are searched in all the data before, up to 64 Kbytes back,
+  *             it is already in the device memory when the command runs
+  *           + Delta patch: the matches are searched in the old image, around the old image pointer
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "openbl_host.h"
+#include "openbl_host_engine.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define LZ4_MIN_MATCH                     4U        /* Shortest match, coded as a match length of 0 */
+#define LZ4_MAX_OFFSET                    0xFFFFU   /* Farthest match */
+#define LZ4_LENGTH_MASK                   0x0FU     /* Length field of the token, 15 when extra bytes follow */
+#define LZ4_MAX_DISPLACEMENT              0x7FFFU   /* Farthest move of the old image pointer, both ways */
+#define LZ4_HASH_MULTIPLIER               2654435761U /* Knuth multiplicative hash */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t LZ4_Hash(const uint8_t *pData, uint32_t TableSize);
+static uint32_t LZ4_MatchLength(const uint8_t *pOld, const uint8_t *pNew, uint32_t Max);
+static uint32_t LZ4_FindMatch(OPENBL_HOST_Lz4TypeDef *pLz4, const uint8_t *pData, uint32_t Index, uint32_t End,
+                              uint32_t *pOffset);
+static uint32_t LZ4_LengthCost(uint32_t Length);
+static uint32_t LZ4_SequenceCost(uint32_t Literals, uint32_t Match);
+static uint32_t LZ4_PutLength(uint8_t *pOutput, uint32_t Length);
+static uint32_t LZ4_PutSequence(uint8_t *pOutput, const uint8_t *pLiterals, uint32_t Literals, uint32_t Offset,
+                                uint32_t Match);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to encode the data of one Compressed Write Memory or Patch Memory command.
+  *         The matches are searched greedily, a match does not cross a segment end so that the data can be ended
+  *         at the last segment fitting in OutputMax bytes.
+  * @param  pLz4 Pointer to the match finder.
+  * @param  pData Pointer to the whole data.
+  * @param  Length The number of bytes of the whole data.
+  * @param  Position The index of the first byte to be encoded.
+  * @param  pOutput Pointer to the buffer where the sequences are stored.
+  * @param  OutputMax Size of the buffer.
+  * @param  pOutputLength Pointer to the returned number of encoded bytes.
+  * @retval Returns the number of bytes encoded, 0 if the first segment does not fit.
+  */
+uint32_t OPENBL_HOST_Lz4Compress(OPENBL_HOST_Lz4TypeDef *pLz4, const uint8_t *pData, uint32_t Length,
+                                 uint32_t Position, uint8_t *pOutput, uint32_t OutputMax, uint32_t *pOutputLength)
+{
+  uint32_t end;
+  uint32_t index = Position;
+  uint32_t anchor = Position;
+  uint32_t emitted = 0U;
+  uint32_t checkpoint = Position;
+  uint32_t checkpoint_anchor = Position;
+  uint32_t checkpoint_emitted = 0U;
+  uint32_t checkpoint_source = pLz4->SourcePosition;
+  uint32_t offset = 0U;
+  uint32_t match;
+  uint32_t cost;
+  uint8_t done = 0U;
+
+  end = ((Length - Position) > OPENBL_HOST_LZ4_SEGMENT_SIZE) ? (Position + OPENBL_HOST_LZ4_SEGMENT_SIZE) : Length;
+
+  while (done == 0U)
+  {
+    if (index == end)
+    {
+      /* Segment end: the block can be ended here by the pending literals */
+      cost = emitted + ((end > anchor) ? LZ4_SequenceCost(end - anchor, 0U) : 0U);
+
+      if (cost > OutputMax)
+      {
+        done = 1U;
+      }
+      else
+      {
+        checkpoint         = end;
+        checkpoint_anchor  = anchor;
+        checkpoint_emitted = emitted;
+        checkpoint_source  = pLz4->SourcePosition;
+
+        if (end == Length)
+        {
+          done = 1U;
+        }
+        else
+        {
+          end = ((Length - end) > OPENBL_HOST_LZ4_SEGMENT_SIZE) ? (end + OPENBL_HOST_LZ4_SEGMENT_SIZE) : Length;
+        }
+      }
+    }
+    else
+    {
+      match = LZ4_FindMatch(pLz4, pData, index, end, &offset);
+
+      if (match == 0U)
+      {
+        index++;
+      }
+      else if ((emitted + LZ4_SequenceCost(index - anchor, match)) > OutputMax)
+      {
+        done = 1U;
+      }
+      else
+      {
+        emitted += LZ4_PutSequence(&pOutput[emitted], &pData[anchor], index - anchor, offset, match);
+        index   += match;
+        anchor   = index;
+
+        if (pLz4->pSource != NULL)
+        {
+          pLz4->SourcePosition += offset - ((offset & 0x8000U) << 1U) + match;
+        }
+      }
+    }
+  }
+
+  /* The block ends at the last segment end which fits, with its pending literals */
+  if (checkpoint > checkpoint_anchor)
+  {
+    checkpoint_emitted += LZ4_PutSequence(&pOutput[checkpoint_emitted], &pData[checkpoint_anchor],
+                                          checkpoint - checkpoint_anchor, 0U, 0U);
+  }
+
+  pLz4->SourcePosition = checkpoint_source;
+  *pOutputLength       = checkpoint_emitted;
+
+  return checkpoint - Position;
+}
+
+/**
+  * @brief  This function is used to fill the hash table with the positions of the old image of a delta patch.
+  * @param  pLz4 Pointer to the match finder, with its old image and its empty table.
+  * @retval None.
+  */
+void OPENBL_HOST_Lz4IndexSource(OPENBL_HOST_Lz4TypeDef *pLz4)
+{
+  uint32_t index;
+
+  for (index = 0U; (index + LZ4_MIN_MATCH) <= pLz4->SourceLength; index++)
+  {
+    pLz4->pTable[LZ4_Hash(&pLz4->pSource[index], pLz4->TableSize)] = index;
+  }
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to hash the 4 bytes starting a match.
+  * @param  pData Pointer to the data.
+  * @param  TableSize The number of entries of the hash table, a power of 2.
+  * @retval Returns the index in the hash table.
+  */
+static uint32_t LZ4_Hash(const uint8_t *pData, uint32_t TableSize)
+{
+  uint32_t value;
+
+  value = (uint32_t)pData[0] | ((uint32_t)pData[1] << 8U) | ((uint32_t)pData[2] << 16U)
+          | ((uint32_t)pData[3] << 24U);
+
+  return (value * LZ4_HASH_MULTIPLIER) % TableSize;
+}
+
+/**
+  * @brief  This function is used to count the equal bytes at the start of two buffers.
+  * @param  pOld Pointer to the bytes copied by the match.
+  * @param  pNew Pointer to the bytes to be encoded.
+  * @param  Max The largest length.
+  * @retval Returns the number of equal bytes.
+  */
+static uint32_t LZ4_MatchLength(const uint8_t *pOld, const uint8_t *pNew, uint32_t Max)
+{
+  uint32_t length = 0U;
+
+  while ((length < Max) && (pOld[length] == pNew[length]))
+  {
+    length++;
+  }
+
+  return length;
+}
+
+/**
+  * @brief  This function is used to find the match of the bytes at a position.
+  *         Compression: the last position of the same hashed 4 bytes, if less than 64 Kbytes back.
+  *         Delta patch: the longest of the match at the old image pointer, which needs no move of it,
+  *         and of the match at the last position of the hashed 4 bytes in the old image, if close enough.
+  * @param  pLz4 Pointer to the match finder.
+  * @param  pData Pointer to the whole data.
+  * @param  Index The position in the data.
+  * @param  End The segment end, not crossed by the match.
+  * @param  pOffset Pointer to the returned offset field: distance back, or signed displacement of the pointer.
+  * @retval Returns the match length, 0 if none.
+  */
+static uint32_t LZ4_FindMatch(OPENBL_HOST_Lz4TypeDef *pLz4, const uint8_t *pData, uint32_t Index, uint32_t End,
+                              uint32_t *pOffset)
+{
+  uint32_t match = 0U;
+  uint32_t length;
+  uint32_t candidate;
+  uint32_t hash;
+
+  if ((End - Index) >= LZ4_MIN_MATCH)
+  {
+    hash      = LZ4_Hash(&pData[Index], pLz4->TableSize);
+    candidate = pLz4->pTable[hash];
+
+    if (pLz4->pSource == NULL)
+    {
+      pLz4->pTable[hash] = Index;
+
+      if ((candidate < Index) && ((Index - candidate) <= LZ4_MAX_OFFSET))
+      {
+        match    = LZ4_MatchLength(&pData[candidate], &pData[Index], End - Index);
+        *pOffset = Index - candidate;
+      }
+    }
+    else
+    {
+      if (pLz4->SourcePosition < pLz4->SourceLength)
+      {
+        length = End - Index;
+        length = ((pLz4->SourceLength - pLz4->SourcePosition) < length)
+                 ? (pLz4->SourceLength - pLz4->SourcePosition) : length;
+        match    = LZ4_MatchLength(&pLz4->pSource[pLz4->SourcePosition], &pData[Index], length);
+        *pOffset = 0U;
+      }
+
+      if ((candidate < pLz4->SourceLength)
+          && (((candidate + LZ4_MAX_DISPLACEMENT + 1U) - pLz4->SourcePosition) <= (2U * LZ4_MAX_DISPLACEMENT)))
+      {
+        length = End - Index;
+        length = ((pLz4->SourceLength - candidate) < length) ? (pLz4->SourceLength - candidate) : length;
+        length = LZ4_MatchLength(&pLz4->pSource[candidate], &pData[Index], length);
+
+        if (length > match)
+        {
+          match    = length;
+          *pOffset = (candidate - pLz4->SourcePosition) & 0xFFFFU;
+        }
+      }
+    }
+  }
+
+  return (match < LZ4_MIN_MATCH) ? 0U : match;
+}
+
+/**
+  * @brief  This function is used to compute the number of extra bytes of a length.
+  * @param  Length The length, literals or match length minus LZ4_MIN_MATCH.
+  * @retval Returns the number of bytes following the token.
+  */
+static uint32_t LZ4_LengthCost(uint32_t Length)
+{
+  return (Length < LZ4_LENGTH_MASK) ? 0U : (1U + ((Length - LZ4_LENGTH_MASK) / 255U));
+}
+
+/**
+  * @brief  This function is used to compute the number of bytes of a sequence.
+  * @param  Literals The number of literals.
+  * @param  Match The match length, 0 for the last sequence of a block.
+  * @retval Returns the number of bytes.
+  */
+static uint32_t LZ4_SequenceCost(uint32_t Literals, uint32_t Match)
+{
+  uint32_t cost = 1U + LZ4_LengthCost(Literals) + Literals;
+
+  if (Match != 0U)
+  {
+    cost += 2U + LZ4_LengthCost(Match - LZ4_MIN_MATCH);
+  }
+
+  return cost;
+}
+
+/**
+  * @brief  This function is used to store the extra bytes of a length: 255 as long as needed, then the rest.
+  * @param  pOutput Pointer to the buffer.
+  * @param  Length The length, literals or match length minus LZ4_MIN_MATCH.
+  * @retval Returns the number of bytes stored.
+  */
+static uint32_t LZ4_PutLength(uint8_t *pOutput, uint32_t Length)
+{
+  uint32_t count = 0U;
+  uint32_t value;
+
+  if (Length >= LZ4_LENGTH_MASK)
+  {
+    value = Length - LZ4_LENGTH_MASK;
+
+    while (value >= 255U)
+    {
+      pOutput[count] = 255U;
+      count++;
+      value -= 255U;
+    }
+
+    pOutput[count] = (uint8_t)value;
+    count++;
+  }
+
+  return count;
+}
+
+/**
+  * @brief  This function is used to store a sequence: token, literals, then the match offset and length.
+  * @param  pOutput Pointer to the buffer.
+  * @param  pLiterals Pointer to the literals.
+  * @param  Literals The number of literals.
+  * @param  Offset The distance of the match.
+  * @param  Match The match length, 0 for the last sequence of a block.
+  * @retval Returns the number of bytes stored.
+  */
+static uint32_t LZ4_PutSequence(uint8_t *pOutput, const uint8_t *pLiterals, uint32_t Literals, uint32_t Offset,
+                                uint32_t Match)
+{
+  uint32_t count = 1U;
+  uint32_t token;
+
+  token = ((Literals < LZ4_LENGTH_MASK) ? Literals : LZ4_LENGTH_MASK) << 4U;
+
+  count += LZ4_PutLength(&pOutput[count], Literals);
+  (void)memcpy(&pOutput[count], pLiterals, Literals);
+  count += Literals;
+
+  if (Match != 0U)
+  {
+    token |= ((Match - LZ4_MIN_MATCH) < LZ4_LENGTH_MASK) ? (Match - LZ4_MIN_MATCH) : LZ4_LENGTH_MASK;
+
+    pOutput[count]      = (uint8_t)Offset;
+    pOutput[count + 1U] = (uint8_t)(Offset >> 8U);
+    count += 2U;
+    count += LZ4_PutLength(&pOutput[count], Match - LZ4_MIN_MATCH);
+  }
+
+  pOutput[0] = (uint8_t)token;
+
+  return count;
+}
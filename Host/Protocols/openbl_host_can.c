@@ -0,0 +1,1024 @@
+/**
+  ******************************************************************************
+  * @file    openbl_host_can.c
+  * @author  MCD Application Team
+  * @brief   Host engines of the frame oriented protocols: CAN and FDCAN
+  *          The identifier of each frame is the command opcode, the device answers with the same identifier.
+  *           + CAN:   8-byte frames, the extended write is paced by the device flow control frames
+  *           + FDCAN: 64-byte frames, the extended write is acknowledged by blocks of 1 Kbyte
+  *          In group mode, the device sends no response to the write commands: the host streams them,
+  *          giving the device GroupBlockTime to program each block, then compares the device CRC-32.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "openbl_host.h"
+#include "openbl_host_engine.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define CAN_FRAME_SIZE                    8U        /* Data bytes of a classic CAN frame */
+#define CAN_FD_FRAME_SIZE                 64U       /* Data bytes of a CAN FD frame */
+#define CAN_CHUNK_SIZE                    256U      /* Bytes of one read or write command */
+#define CAN_EXT_CHUNK_SIZE                0x10000U  /* Bytes of one extended read or write command */
+#define CAN_BLOCK_SIZE                    256U      /* Bytes of a CAN block, granted by a flow control frame */
+#define CAN_FD_BLOCK_SIZE                 1024U     /* Bytes of a FDCAN block, acknowledged by the device */
+#define CAN_ERASE_PAGES_MAX               64U       /* Pages erased by one CAN erase command */
+#define CAN_FD_ERASE_PAGES_MAX            32U       /* Pages erased by one FDCAN erase command */
+
+#define CAN_FC_CONTINUE_TO_SEND           0x30U     /* Flow control status: continue to send */
+
+#define CAN_GROUP_JOIN                    0x01U     /* Group sub-command: join a group */
+#define CAN_GROUP_LEAVE                   0x02U     /* Group sub-command: leave a group */
+#define CAN_GROUP_STATUS                  0x03U     /* Group sub-command: collect the status of one node */
+
+/* Private macro -------------------------------------------------------------*/
+#define CAN_FRAME_LENGTH(HANDLE)          (((HANDLE)->Protocol == OPENBL_HOST_FDCAN) ? CAN_FD_FRAME_SIZE \
+                                                                                      : CAN_FRAME_SIZE)
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static OPENBL_HOST_StatusTypeDef CAN_ReceiveFrame(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode,
+                                                  uint8_t *pData, uint32_t *pLength, uint32_t Timeout);
+static OPENBL_HOST_StatusTypeDef CAN_ReceiveData(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode,
+                                                 uint8_t *pData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef CAN_WaitAck(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode, uint32_t Timeout);
+static OPENBL_HOST_StatusTypeDef CAN_WaitResponse(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode,
+                                                  uint32_t Timeout);
+static OPENBL_HOST_StatusTypeDef CAN_SendData(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode,
+                                              const uint8_t *pData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef CAN_SendAddress(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode,
+                                                 uint32_t Address, uint32_t Size, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef CAN_Connect(OPENBL_HOST_HandleTypeDef *pHandle);
+static OPENBL_HOST_StatusTypeDef CAN_GetVersion(OPENBL_HOST_HandleTypeDef *pHandle);
+static OPENBL_HOST_StatusTypeDef CAN_GetCommand(OPENBL_HOST_HandleTypeDef *pHandle);
+static OPENBL_HOST_StatusTypeDef CAN_GetId(OPENBL_HOST_HandleTypeDef *pHandle);
+static void CAN_Configure(OPENBL_HOST_HandleTypeDef *pHandle);
+static OPENBL_HOST_StatusTypeDef CAN_ReadMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                uint8_t *pData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef CAN_WriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                 const uint8_t *pData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef CAN_ExtendedWriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                         const uint8_t *pData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef CAN_EraseMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t FirstPage,
+                                                 uint32_t PagesNumber);
+static OPENBL_HOST_StatusTypeDef CAN_Go(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address);
+static OPENBL_HOST_StatusTypeDef CAN_GroupJoin(OPENBL_HOST_HandleTypeDef *pHandle);
+static OPENBL_HOST_StatusTypeDef CAN_GroupStatus(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t *pErrors,
+                                                 uint32_t *pCrc);
+static OPENBL_HOST_StatusTypeDef CAN_GroupLeave(OPENBL_HOST_HandleTypeDef *pHandle);
+static OPENBL_HOST_StatusTypeDef CAN_CommitMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                  uint32_t Length, uint32_t Crc);
+static OPENBL_HOST_StatusTypeDef CAN_CompressedWriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                           const uint8_t *pData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef CAN_PatchMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                 const uint8_t *pData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef CAN_WriteEncoded(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode, uint32_t Address,
+                                                  const uint8_t *pData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef CAN_GetBlockCrc(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                 uint32_t BlockSize, uint32_t BlocksNumber, uint8_t *pData);
+
+/* Exported variables --------------------------------------------------------*/
+const OPENBL_HOST_EngineTypeDef OPENBL_HOST_CanEngine =
+{
+  CAN_Connect,
+  CAN_GetVersion,
+  CAN_GetCommand,
+  CAN_GetId,
+  CAN_Configure,
+  CAN_ReadMemory,
+  CAN_WriteMemory,
+  CAN_EraseMemory,
+  CAN_Go,
+  CAN_GroupJoin,
+  CAN_GroupStatus,
+  CAN_GroupLeave,
+  CAN_CommitMemory,
+  CAN_CompressedWriteMemory,
+  CAN_PatchMemory,
+  CAN_GetBlockCrc,
+  CAN_ERASE_PAGES_MAX,
+  NULL,
+  0U
+};
+
+const OPENBL_HOST_EngineTypeDef OPENBL_HOST_FdcanEngine =
+{
+  CAN_Connect,
+  CAN_GetVersion,
+  CAN_GetCommand,
+  CAN_GetId,
+  CAN_Configure,
+  CAN_ReadMemory,
+  CAN_WriteMemory,
+  CAN_EraseMemory,
+  CAN_Go,
+  CAN_GroupJoin,
+  CAN_GroupStatus,
+  CAN_GroupLeave,
+  CAN_CommitMemory,
+  CAN_CompressedWriteMemory,
+  CAN_PatchMemory,
+  CAN_GetBlockCrc,
+  CAN_FD_ERASE_PAGES_MAX,
+  NULL,
+  0U
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to receive the next frame of a command.
+  *         The frames of other commands, sent by other nodes sharing the bus, are dropped.
+  * @param  pHandle Pointer to the handle.
+  * @param  OpCode The command opcode, identifier of the expected frame.
+  * @param  pData Pointer to the buffer where the frame data is stored, of CAN_FD_FRAME_SIZE bytes.
+  * @param  pLength Pointer to the returned number of data bytes.
+  * @param  Timeout The time to wait in ms.
+  * @retval Returns OPENBL_HOST_OK if a frame has been received else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_ReceiveFrame(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode,
+                                                  uint8_t *pData, uint32_t *pLength, uint32_t Timeout)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint32_t identifier;
+  uint32_t start;
+
+  start = OPENBL_HOST_GetTick();
+
+  do
+  {
+    *pLength = CAN_FD_FRAME_SIZE;
+    status   = OPENBL_HOST_Receive(pHandle, &identifier, pData, pLength, Timeout);
+  } while ((status == OPENBL_HOST_OK) && (identifier != OpCode) && ((OPENBL_HOST_GetTick() - start) < Timeout));
+
+  if ((status == OPENBL_HOST_OK) && ((identifier != OpCode) || (*pLength == 0U)))
+  {
+    status = OPENBL_HOST_TIMEOUT;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to receive data sent in several frames.
+  *         The padding of the last frame is dropped.
+  * @param  pHandle Pointer to the handle.
+  * @param  OpCode The command opcode.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the data has been received else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_ReceiveData(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode,
+                                                 uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  uint8_t frame[CAN_FD_FRAME_SIZE];
+  uint32_t length;
+  uint32_t counter;
+
+  while ((Length != 0U) && (status == OPENBL_HOST_OK))
+  {
+    status = CAN_ReceiveFrame(pHandle, OpCode, frame, &length, pHandle->Timeout);
+
+    if (status != OPENBL_HOST_OK)
+    {
+      length = 0U;
+    }
+    else if (length > Length)
+    {
+      length = Length;
+    }
+    else
+    {
+      /* The whole frame is data */
+    }
+
+    for (counter = 0U; (counter < length) && (status == OPENBL_HOST_OK); counter++)
+    {
+      pData[counter] = frame[counter];
+    }
+
+    pData  += length;
+    Length -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to wait for an acknowledge frame.
+  * @param  pHandle Pointer to the handle.
+  * @param  OpCode The command opcode.
+  * @param  Timeout The time to wait in ms.
+  * @retval Returns OPENBL_HOST_OK for an ACK, OPENBL_HOST_NACK for a NACK else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_WaitAck(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode, uint32_t Timeout)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t frame[CAN_FD_FRAME_SIZE];
+  uint32_t length;
+
+  status = CAN_ReceiveFrame(pHandle, OpCode, frame, &length, Timeout);
+
+  if (status != OPENBL_HOST_OK)
+  {
+    /* The error is returned */
+  }
+  else if (frame[0] == OPENBL_HOST_NACK_BYTE)
+  {
+    status = OPENBL_HOST_NACK;
+  }
+  else if (frame[0] != OPENBL_HOST_ACK)
+  {
+    status = OPENBL_HOST_ERROR;
+  }
+  else
+  {
+    /* Acknowledged */
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to wait for the response of a write or erase command,
+  *         there is none in group mode.
+  * @param  pHandle Pointer to the handle.
+  * @param  OpCode The command opcode.
+  * @param  Timeout The time to wait in ms.
+  * @retval Returns OPENBL_HOST_OK for an ACK or in group mode, OPENBL_HOST_NACK for a NACK else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_WaitResponse(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode,
+                                                  uint32_t Timeout)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+
+  if (pHandle->GroupActive == 0U)
+  {
+    status = CAN_WaitAck(pHandle, OpCode, Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to send data in full frames, the last one may be shorter.
+  * @param  pHandle Pointer to the handle.
+  * @param  OpCode The command opcode.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the data has been sent else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_SendData(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode,
+                                              const uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  uint32_t length;
+
+  while ((Length != 0U) && (status == OPENBL_HOST_OK))
+  {
+    length = (Length > CAN_FRAME_LENGTH(pHandle)) ? CAN_FRAME_LENGTH(pHandle) : Length;
+    status = OPENBL_HOST_Send(pHandle, OpCode, pData, length);
+
+    pData  += length;
+    Length -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to send the command frame holding an address and a size:
+  *         the 32-bit size of the extended commands, or the number of bytes minus one of the others.
+  * @param  pHandle Pointer to the handle.
+  * @param  OpCode The command opcode.
+  * @param  Address The address.
+  * @param  Size The size.
+  * @param  Length The number of bytes of the size, 4 or 1.
+  * @retval Returns OPENBL_HOST_OK if the frame has been sent else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_SendAddress(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode,
+                                                 uint32_t Address, uint32_t Size, uint32_t Length)
+{
+  uint8_t frame[CAN_FRAME_SIZE];
+
+  (void)OPENBL_HOST_PutWord(frame, Address);
+
+  if (Length == 4U)
+  {
+    (void)OPENBL_HOST_PutWord(&frame[4], Size);
+  }
+  else
+  {
+    frame[4] = (uint8_t)Size;
+  }
+
+  return OPENBL_HOST_Send(pHandle, OpCode, frame, 4U + Length);
+}
+
+/**
+  * @brief  This function is used to connect to the device, it detects the first command frame.
+  * @param  pHandle Pointer to the handle.
+  * @retval Returns OPENBL_HOST_OK.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_Connect(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  (void)pHandle;
+
+  return OPENBL_HOST_OK;
+}
+
+/**
+  * @brief  This function is used to get the protocol version: ACK, version, two option bytes, ACK.
+  * @param  pHandle Pointer to the handle.
+  * @retval Returns OPENBL_HOST_OK if the version has been read else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_GetVersion(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t data[3];
+
+  status = OPENBL_HOST_Send(pHandle, OPENBL_HOST_CMD_GET_VERSION, NULL, 0U);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitAck(pHandle, OPENBL_HOST_CMD_GET_VERSION, pHandle->Timeout);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_ReceiveData(pHandle, OPENBL_HOST_CMD_GET_VERSION, data, 1U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    pHandle->Version = data[0];
+
+    status = CAN_ReceiveData(pHandle, OPENBL_HOST_CMD_GET_VERSION, data, 2U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitAck(pHandle, OPENBL_HOST_CMD_GET_VERSION, pHandle->Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to get the list of the commands supported by the device,
+  *         each byte is sent in its own frame.
+  * @param  pHandle Pointer to the handle.
+  * @retval Returns OPENBL_HOST_OK if the list has been read else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_GetCommand(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t data[256];
+  uint8_t number = 0U;
+  uint32_t counter;
+
+  status = OPENBL_HOST_Send(pHandle, OPENBL_HOST_CMD_GET_COMMAND, NULL, 0U);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitAck(pHandle, OPENBL_HOST_CMD_GET_COMMAND, pHandle->Timeout);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_ReceiveData(pHandle, OPENBL_HOST_CMD_GET_COMMAND, &number, 1U);
+  }
+
+  /* The protocol version, then the commands */
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_ReceiveData(pHandle, OPENBL_HOST_CMD_GET_COMMAND, data, (uint32_t)number + 1U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    pHandle->CommandsNumber = (number > sizeof(pHandle->Commands)) ? (uint8_t)sizeof(pHandle->Commands) : number;
+
+    for (counter = 0U; counter < pHandle->CommandsNumber; counter++)
+    {
+      pHandle->Commands[counter] = data[counter + 1U];
+    }
+
+    status = CAN_WaitAck(pHandle, OPENBL_HOST_CMD_GET_COMMAND, pHandle->Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to get the device identifier: ACK, MSB and LSB in one frame, ACK.
+  * @param  pHandle Pointer to the handle.
+  * @retval Returns OPENBL_HOST_OK if the identifier has been read else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_GetId(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t data[2];
+
+  status = OPENBL_HOST_Send(pHandle, OPENBL_HOST_CMD_GET_ID, NULL, 0U);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitAck(pHandle, OPENBL_HOST_CMD_GET_ID, pHandle->Timeout);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_ReceiveData(pHandle, OPENBL_HOST_CMD_GET_ID, data, 2U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    pHandle->DeviceId = (uint16_t)(((uint16_t)data[0] << 8U) | data[1]);
+
+    status = CAN_WaitAck(pHandle, OPENBL_HOST_CMD_GET_ID, pHandle->Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to select the chunks: 64 Kbytes per extended command when the device
+  *         supports them, else 256 bytes.
+  * @param  pHandle Pointer to the handle.
+  * @retval None.
+  */
+static void CAN_Configure(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  pHandle->WriteChunk = (OPENBL_HOST_IsCommandSupported(pHandle, OPENBL_HOST_CMD_EXT_WRITE_MEMORY) != 0U)
+                        ? CAN_EXT_CHUNK_SIZE : CAN_CHUNK_SIZE;
+  pHandle->ReadChunk  = (OPENBL_HOST_IsCommandSupported(pHandle, OPENBL_HOST_CMD_EXT_READ_MEMORY) != 0U)
+                        ? CAN_EXT_CHUNK_SIZE : CAN_CHUNK_SIZE;
+}
+
+/**
+  * @brief  This function is used to read memory with the extended read command, or with the read
+  *         command for 256 bytes at most. On CAN, the extended read is granted by a single flow control
+  *         frame allowing all the frames.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the memory has been read else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_ReadMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                uint8_t *pData, uint32_t Length)
+{
+  static const uint8_t a_flow_control[3] = {CAN_FC_CONTINUE_TO_SEND, 0x00U, 0x00U};
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t opcode;
+
+  if (pHandle->ReadChunk == CAN_EXT_CHUNK_SIZE)
+  {
+    opcode = OPENBL_HOST_CMD_EXT_READ_MEMORY;
+    status = CAN_SendAddress(pHandle, opcode, Address, Length, 4U);
+  }
+  else
+  {
+    opcode = OPENBL_HOST_CMD_READ_MEMORY;
+    status = CAN_SendAddress(pHandle, opcode, Address, Length - 1U, 1U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitAck(pHandle, opcode, pHandle->Timeout);
+  }
+
+  if ((status == OPENBL_HOST_OK) && (opcode == OPENBL_HOST_CMD_EXT_READ_MEMORY)
+      && (pHandle->Protocol == OPENBL_HOST_CAN))
+  {
+    status = OPENBL_HOST_Send(pHandle, opcode, a_flow_control, 3U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_ReceiveData(pHandle, opcode, pData, Length);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitAck(pHandle, opcode, pHandle->Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to write memory with the extended write command, or with the write
+  *         command for 256 bytes at most. The CAN device acknowledges each frame of the write command.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the memory has been written else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_WriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                 const uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint32_t length;
+
+  if (pHandle->WriteChunk == CAN_EXT_CHUNK_SIZE)
+  {
+    status = CAN_ExtendedWriteMemory(pHandle, Address, pData, Length);
+  }
+  else
+  {
+    status = CAN_SendAddress(pHandle, OPENBL_HOST_CMD_WRITE_MEMORY, Address, Length - 1U, 1U);
+
+    if (status == OPENBL_HOST_OK)
+    {
+      status = CAN_WaitResponse(pHandle, OPENBL_HOST_CMD_WRITE_MEMORY, pHandle->Timeout);
+    }
+
+    while ((Length != 0U) && (status == OPENBL_HOST_OK))
+    {
+      length = (Length > CAN_FRAME_LENGTH(pHandle)) ? CAN_FRAME_LENGTH(pHandle) : Length;
+      status = OPENBL_HOST_Send(pHandle, OPENBL_HOST_CMD_WRITE_MEMORY, pData, length);
+
+      if ((status == OPENBL_HOST_OK) && (pHandle->Protocol == OPENBL_HOST_CAN))
+      {
+        status = CAN_WaitResponse(pHandle, OPENBL_HOST_CMD_WRITE_MEMORY, pHandle->Timeout);
+      }
+
+      pData  += length;
+      Length -= length;
+    }
+
+    if (status == OPENBL_HOST_OK)
+    {
+      status = CAN_WaitResponse(pHandle, OPENBL_HOST_CMD_WRITE_MEMORY, pHandle->Timeout);
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to write memory with the extended write command, by blocks.
+  *         The CAN device grants each block with a flow control frame [status, frames, separation time]
+  *         and acknowledges the command at the end, the FDCAN device acknowledges each block.
+  *         In group mode, the host waits GroupBlockTime after each block instead.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the memory has been written else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_ExtendedWriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                         const uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t frame[CAN_FD_FRAME_SIZE];
+  uint32_t block;
+  uint32_t length;
+
+  status = CAN_SendAddress(pHandle, OPENBL_HOST_CMD_EXT_WRITE_MEMORY, Address, Length, 4U);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitResponse(pHandle, OPENBL_HOST_CMD_EXT_WRITE_MEMORY, pHandle->Timeout);
+  }
+
+  while ((Length != 0U) && (status == OPENBL_HOST_OK))
+  {
+    block = (pHandle->Protocol == OPENBL_HOST_FDCAN) ? CAN_FD_BLOCK_SIZE : CAN_BLOCK_SIZE;
+
+    /* The CAN block is the number of frames granted by the device */
+    if ((pHandle->Protocol == OPENBL_HOST_CAN) && (pHandle->GroupActive == 0U))
+    {
+      status = CAN_ReceiveFrame(pHandle, OPENBL_HOST_CMD_EXT_WRITE_MEMORY, frame, &length, pHandle->Timeout);
+
+      if (status != OPENBL_HOST_OK)
+      {
+        /* The error is returned */
+      }
+      else if ((length < 2U) || (frame[0] != CAN_FC_CONTINUE_TO_SEND))
+      {
+        status = OPENBL_HOST_NACK;
+      }
+      else if (frame[1] != 0U)
+      {
+        block = (uint32_t)frame[1] * CAN_FRAME_SIZE;
+      }
+      else
+      {
+        block = Length;
+      }
+    }
+
+    length = (Length > block) ? block : Length;
+
+    if (status == OPENBL_HOST_OK)
+    {
+      status = CAN_SendData(pHandle, OPENBL_HOST_CMD_EXT_WRITE_MEMORY, pData, length);
+    }
+
+    if (status != OPENBL_HOST_OK)
+    {
+      /* The error is returned */
+    }
+    else if (pHandle->GroupActive != 0U)
+    {
+      OPENBL_HOST_Delay(pHandle->GroupBlockTime);
+    }
+    else if (pHandle->Protocol == OPENBL_HOST_FDCAN)
+    {
+      status = CAN_WaitAck(pHandle, OPENBL_HOST_CMD_EXT_WRITE_MEMORY, pHandle->Timeout);
+    }
+    else
+    {
+      /* The CAN device acknowledges the whole command */
+    }
+
+    pData  += length;
+    Length -= length;
+  }
+
+  if ((status == OPENBL_HOST_OK) && (pHandle->Protocol == OPENBL_HOST_CAN))
+  {
+    status = CAN_WaitResponse(pHandle, OPENBL_HOST_CMD_EXT_WRITE_MEMORY, pHandle->Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to erase memory.
+  *         CAN:   erase command, number of pages minus one then page numbers on one byte in 8-byte frames,
+  *                each full frame is acknowledged. 0xFF for a mass erase.
+  *         FDCAN: extended erase command, number of pages then page numbers on two bytes in one frame.
+  *                0xFFFF for a mass erase.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  FirstPage The number of the first page.
+  * @param  PagesNumber The number of pages, 0 for a mass erase.
+  * @retval Returns OPENBL_HOST_OK if the memory has been erased else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_EraseMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t FirstPage,
+                                                 uint32_t PagesNumber)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t frame[CAN_FD_FRAME_SIZE];
+  uint32_t length = 0U;
+  uint32_t counter;
+  uint8_t opcode;
+
+  opcode = (pHandle->Protocol == OPENBL_HOST_FDCAN) ? OPENBL_HOST_CMD_EXT_ERASE_MEMORY
+           : OPENBL_HOST_CMD_LEG_ERASE_MEMORY;
+
+  if (pHandle->Protocol == OPENBL_HOST_FDCAN)
+  {
+    frame[0] = (PagesNumber == 0U) ? 0xFFU : (uint8_t)(PagesNumber >> 8U);
+    frame[1] = (PagesNumber == 0U) ? 0xFFU : (uint8_t)PagesNumber;
+    length   = 2U;
+  }
+  else
+  {
+    frame[0] = (PagesNumber == 0U) ? 0xFFU : (uint8_t)(PagesNumber - 1U);
+    length   = 1U;
+  }
+
+  status = OPENBL_HOST_Send(pHandle, opcode, frame, length);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitResponse(pHandle, opcode, pHandle->Timeout);
+  }
+
+  /* The CAN device acknowledges twice a mass erase before its status */
+  if ((status == OPENBL_HOST_OK) && ((PagesNumber != 0U) || (pHandle->Protocol == OPENBL_HOST_CAN)))
+  {
+    status = CAN_WaitResponse(pHandle, opcode, (PagesNumber == 0U) ? pHandle->EraseTimeout : pHandle->Timeout);
+  }
+
+  if ((status == OPENBL_HOST_OK) && (PagesNumber != 0U))
+  {
+    length = 0U;
+
+    for (counter = 0U; counter < PagesNumber; counter++)
+    {
+      if (pHandle->Protocol == OPENBL_HOST_FDCAN)
+      {
+        frame[length] = (uint8_t)((FirstPage + counter) >> 8U);
+        length++;
+      }
+
+      frame[length] = (uint8_t)(FirstPage + counter);
+      length++;
+
+      /* Each full frame of page numbers is sent, the CAN device acknowledges it */
+      if ((length == CAN_FRAME_SIZE) && (pHandle->Protocol == OPENBL_HOST_CAN) && (status == OPENBL_HOST_OK))
+      {
+        status = OPENBL_HOST_Send(pHandle, opcode, frame, length);
+
+        if (status == OPENBL_HOST_OK)
+        {
+          status = CAN_WaitResponse(pHandle, opcode, pHandle->Timeout);
+        }
+
+        length = 0U;
+      }
+    }
+
+    if ((length != 0U) && (status == OPENBL_HOST_OK))
+    {
+      status = OPENBL_HOST_Send(pHandle, opcode, frame, length);
+    }
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitResponse(pHandle, opcode, pHandle->EraseTimeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to make the device jump to an application with the go command.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The address of the application vector table.
+  * @retval Returns OPENBL_HOST_OK if the device accepted the address else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_Go(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t frame[4];
+
+  (void)OPENBL_HOST_PutWord(frame, Address);
+
+  status = OPENBL_HOST_Send(pHandle, OPENBL_HOST_CMD_GO, frame, 4U);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitAck(pHandle, OPENBL_HOST_CMD_GO, pHandle->Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to make the device join the group, it acknowledges as it is addressed
+  *         by its node identifier.
+  * @param  pHandle Pointer to the connected handle.
+  * @retval Returns OPENBL_HOST_OK if the device joined the group else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_GroupJoin(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t frame[6];
+
+  frame[0] = CAN_GROUP_JOIN;
+  frame[1] = pHandle->GroupId;
+  (void)OPENBL_HOST_PutWord(&frame[2], pHandle->NodeId);
+
+  status = OPENBL_HOST_Send(pHandle, OPENBL_HOST_CMD_GROUP_COMMAND, frame, 6U);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitAck(pHandle, OPENBL_HOST_CMD_GROUP_COMMAND, pHandle->Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to read the group status of the device:
+  *         [status, error count, CRC-32 MSB first, 0x00, 0x00].
+  * @param  pHandle Pointer to the connected handle.
+  * @param  pErrors Pointer to the returned number of failed commands.
+  * @param  pCrc Pointer to the returned CRC-32 of the data written in the group.
+  * @retval Returns OPENBL_HOST_OK if the status has been read else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_GroupStatus(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t *pErrors,
+                                                 uint32_t *pCrc)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t frame[CAN_FD_FRAME_SIZE];
+  uint32_t length;
+
+  frame[0] = CAN_GROUP_STATUS;
+  frame[1] = pHandle->GroupId;
+  (void)OPENBL_HOST_PutWord(&frame[2], pHandle->NodeId);
+
+  status = OPENBL_HOST_Send(pHandle, OPENBL_HOST_CMD_GROUP_COMMAND, frame, 6U);
+
+  /* The last writes are programmed before the status is sent */
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_ReceiveFrame(pHandle, OPENBL_HOST_CMD_GROUP_COMMAND, frame, &length, pHandle->EraseTimeout);
+  }
+
+  if ((status == OPENBL_HOST_OK) && (length < 6U))
+  {
+    status = OPENBL_HOST_ERROR;
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    *pErrors = (frame[0] != OPENBL_HOST_ACK) ? ((frame[1] != 0U) ? frame[1] : 1U) : frame[1];
+    *pCrc    = ((uint32_t)frame[2] << 24U) | ((uint32_t)frame[3] << 16U) | ((uint32_t)frame[4] << 8U) | frame[5];
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to make the device leave the group, no response is sent.
+  * @param  pHandle Pointer to the connected handle.
+  * @retval Returns OPENBL_HOST_OK if the command has been sent else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_GroupLeave(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  uint8_t frame[2];
+
+  frame[0] = CAN_GROUP_LEAVE;
+  frame[1] = pHandle->GroupId;
+
+  return OPENBL_HOST_Send(pHandle, OPENBL_HOST_CMD_GROUP_COMMAND, frame, 2U);
+}
+
+/**
+  * @brief  This function is used to program in the Flash the image written in the RAM staging area:
+  *         the Flash address, the image length and its CRC-32, in one FDCAN command frame or in the CAN
+  *         command frame and the next frame. The parameters are acknowledged, then the last acknowledge
+  *         comes once the device has erased, programmed and checked the Flash.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The Flash address of the image.
+  * @param  Length The number of bytes of the image.
+  * @param  Crc The CRC-32 of the image.
+  * @retval Returns OPENBL_HOST_OK if the image has been programmed else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_CommitMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                  uint32_t Length, uint32_t Crc)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t frame[12];
+
+  (void)OPENBL_HOST_PutWord(frame, Address);
+  (void)OPENBL_HOST_PutWord(&frame[4], Length);
+  (void)OPENBL_HOST_PutWord(&frame[8], Crc);
+
+  status = CAN_SendData(pHandle, OPENBL_HOST_CMD_COMMIT_MEMORY, frame, 12U);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitResponse(pHandle, OPENBL_HOST_CMD_COMMIT_MEMORY, pHandle->Timeout);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitResponse(pHandle, OPENBL_HOST_CMD_COMMIT_MEMORY, pHandle->EraseTimeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to write memory with the compressed write memory command.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the compressed data.
+  * @param  Length The number of compressed bytes, at most 256.
+  * @retval Returns OPENBL_HOST_OK if the memory has been written else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_CompressedWriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                           const uint8_t *pData, uint32_t Length)
+{
+  return CAN_WriteEncoded(pHandle, OPENBL_HOST_CMD_COMPRESSED_WRITE, Address, pData, Length);
+}
+
+/**
+  * @brief  This function is used to write memory with the patch memory command.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the patch.
+  * @param  Length The number of bytes of the patch, at most 256.
+  * @retval Returns OPENBL_HOST_OK if the memory has been written else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_PatchMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                 const uint8_t *pData, uint32_t Length)
+{
+  return CAN_WriteEncoded(pHandle, OPENBL_HOST_CMD_PATCH_MEMORY, Address, pData, Length);
+}
+
+/**
+  * @brief  This function is used to send an encoded write command, compressed data or patch.
+  *         The command frame is the write memory one, then the CAN device grants all the encoded data by one
+  *         flow control frame, as a block of the extended write. The last acknowledge comes once the device
+  *         has decoded and written the data.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  OpCode The command opcode.
+  * @param  Address The start address.
+  * @param  pData Pointer to the encoded data.
+  * @param  Length The number of encoded bytes, at most 256.
+  * @retval Returns OPENBL_HOST_OK if the memory has been written else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_WriteEncoded(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode, uint32_t Address,
+                                                  const uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t frame[CAN_FD_FRAME_SIZE];
+  uint32_t length;
+
+  status = CAN_SendAddress(pHandle, OpCode, Address, Length - 1U, 1U);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitResponse(pHandle, OpCode, pHandle->Timeout);
+  }
+
+  /* In group mode and over FDCAN, the data is sent without flow control */
+  if ((status == OPENBL_HOST_OK) && (pHandle->GroupActive == 0U) && (pHandle->Protocol == OPENBL_HOST_CAN))
+  {
+    status = CAN_ReceiveFrame(pHandle, OpCode, frame, &length, pHandle->Timeout);
+
+    if ((status == OPENBL_HOST_OK) && ((length < 2U) || (frame[0] != CAN_FC_CONTINUE_TO_SEND)
+                                       || ((frame[1] != 0U) && (((uint32_t)frame[1] * CAN_FRAME_SIZE) < Length))))
+    {
+      status = OPENBL_HOST_NACK;
+    }
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_SendData(pHandle, OpCode, pData, Length);
+  }
+
+  if ((status == OPENBL_HOST_OK) && (pHandle->GroupActive != 0U))
+  {
+    OPENBL_HOST_Delay(pHandle->GroupBlockTime);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitResponse(pHandle, OpCode, pHandle->Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to read the CRC-32 of consecutive memory blocks: the address, the block size
+  *         and the number of blocks minus one, in one FDCAN command frame or in the CAN command frame and the
+  *         next frame. Once computed, the CRCs are sent between two acknowledges, in 64-byte frames (FDCAN)
+  *         or in 8-byte frames paced by the host flow control frames (CAN).
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address of the first block.
+  * @param  BlockSize The number of bytes of each block.
+  * @param  BlocksNumber The number of blocks, at most 256.
+  * @param  pData Pointer to the buffer receiving the CRCs, 4 bytes per block, each MSB first.
+  * @retval Returns OPENBL_HOST_OK if the CRCs have been read else the error.
+  */
+static OPENBL_HOST_StatusTypeDef CAN_GetBlockCrc(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                 uint32_t BlockSize, uint32_t BlocksNumber, uint8_t *pData)
+{
+  static const uint8_t a_flow_control[3] = {CAN_FC_CONTINUE_TO_SEND, 0x00U, 0x00U};
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t frame[9];
+
+  (void)OPENBL_HOST_PutWord(frame, Address);
+  (void)OPENBL_HOST_PutWord(&frame[4], BlockSize);
+  frame[8] = (uint8_t)(BlocksNumber - 1U);
+
+  status = CAN_SendData(pHandle, OPENBL_HOST_CMD_GET_BLOCK_CRC, frame, 9U);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitAck(pHandle, OPENBL_HOST_CMD_GET_BLOCK_CRC, pHandle->EraseTimeout);
+  }
+
+  if ((status == OPENBL_HOST_OK) && (pHandle->Protocol == OPENBL_HOST_CAN))
+  {
+    status = OPENBL_HOST_Send(pHandle, OPENBL_HOST_CMD_GET_BLOCK_CRC, a_flow_control, 3U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_ReceiveData(pHandle, OPENBL_HOST_CMD_GET_BLOCK_CRC, pData, BlocksNumber * 4U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = CAN_WaitAck(pHandle, OPENBL_HOST_CMD_GET_BLOCK_CRC, pHandle->Timeout);
+  }
+
+  return status;
+}
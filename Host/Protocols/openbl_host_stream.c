@@ -0,0 +1,1111 @@
+/**
+  ******************************************************************************
+  * @file    openbl_host_stream.c
+  * @author  MCD Application Team
+  * @brief   Host engines of the byte oriented protocols: USART, I2C, SPI and I3C
+  *          These protocols share the same command format: opcode and complement, address and XOR,
+  *          each phase acknowledged by the device. They differ by:
+  *           + USART: synchronization byte 0x7F. When the device buffers its reception and pipelining
+  *                    is enabled, the host sends a whole command before reading its acknowledges
+  *           + I2C:   each phase is one I2C transfer, the device sends busy bytes while it is working
+  *           + SPI:   each command starts with 0x5A, the host polls each acknowledge and acknowledges it
+  *           + I3C:   the read and write commands transfer several loops of up to 2 Kbytes
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "openbl_host.h"
+#include "openbl_host_engine.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define STREAM_USART_SYNC_BYTE            0x7FU     /* USART synchronization byte */
+#define STREAM_SPI_SYNC_BYTE              0x5AU     /* SPI start of command byte */
+#define STREAM_CHUNK_SIZE                 256U      /* Bytes of one read or write command */
+#define STREAM_I3C_LOOP_SIZE              2048U     /* Bytes of one loop of the I3C read and write commands */
+#define STREAM_I3C_CHUNK_SIZE             0x10000U  /* Bytes of one I3C read or write command */
+#define STREAM_ERASE_PAGES_MAX            128U      /* Pages erased by one erase command */
+#define STREAM_DRAIN_TIMEOUT              20U       /* Silence time ending the drain of the reception, in ms */
+#define STREAM_POLL_DELAY                 100U      /* Time between two polls of a busy I2C device, in us */
+#define STREAM_PENDING_MAX                4U        /* Acknowledges of one command: opcode, address, data */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+
+/* Commands of the I2C protocol, its command list can not be read without knowing its length */
+static const uint8_t a_STREAM_I2cCommands[] =
+{
+  OPENBL_HOST_CMD_GET_COMMAND, OPENBL_HOST_CMD_GET_VERSION, OPENBL_HOST_CMD_GET_ID, OPENBL_HOST_CMD_READ_MEMORY,
+  OPENBL_HOST_CMD_GO, OPENBL_HOST_CMD_WRITE_MEMORY, OPENBL_HOST_CMD_EXT_ERASE_MEMORY
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static OPENBL_HOST_StatusTypeDef STREAM_Receive(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t *pData,
+                                                uint32_t Length);
+static void STREAM_Drain(OPENBL_HOST_HandleTypeDef *pHandle);
+static OPENBL_HOST_StatusTypeDef STREAM_WaitAck(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Timeout);
+static OPENBL_HOST_StatusTypeDef STREAM_Acknowledge(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t *pPending,
+                                                    uint32_t Timeout);
+static OPENBL_HOST_StatusTypeDef STREAM_Flush(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Pending,
+                                              uint32_t Timeout);
+static OPENBL_HOST_StatusTypeDef STREAM_SendCommand(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode,
+                                                    uint32_t *pPending);
+static OPENBL_HOST_StatusTypeDef STREAM_SendAddress(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                    uint32_t *pPending);
+static OPENBL_HOST_StatusTypeDef STREAM_Connect(OPENBL_HOST_HandleTypeDef *pHandle);
+static OPENBL_HOST_StatusTypeDef STREAM_GetVersion(OPENBL_HOST_HandleTypeDef *pHandle);
+static OPENBL_HOST_StatusTypeDef STREAM_GetCommand(OPENBL_HOST_HandleTypeDef *pHandle);
+static OPENBL_HOST_StatusTypeDef STREAM_GetId(OPENBL_HOST_HandleTypeDef *pHandle);
+static void STREAM_Configure(OPENBL_HOST_HandleTypeDef *pHandle);
+static OPENBL_HOST_StatusTypeDef STREAM_ReadMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                   uint8_t *pData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef STREAM_Write(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode, uint32_t Address,
+                                              const uint8_t *pData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef STREAM_WriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                    const uint8_t *pData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef STREAM_CompressedWriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                              const uint8_t *pData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef STREAM_PatchMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                    const uint8_t *pData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef STREAM_I3cSendLoop(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Size,
+                                                    uint32_t Loop);
+static OPENBL_HOST_StatusTypeDef STREAM_I3cReadMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                      uint8_t *pData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef STREAM_I3cWriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                       const uint8_t *pData, uint32_t Length);
+static OPENBL_HOST_StatusTypeDef STREAM_EraseMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t FirstPage,
+                                                    uint32_t PagesNumber);
+static OPENBL_HOST_StatusTypeDef STREAM_Go(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address);
+static OPENBL_HOST_StatusTypeDef STREAM_CommitMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                     uint32_t Length, uint32_t Crc);
+static OPENBL_HOST_StatusTypeDef STREAM_GetBlockCrc(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                    uint32_t BlockSize, uint32_t BlocksNumber, uint8_t *pData);
+
+/* Exported variables --------------------------------------------------------*/
+const OPENBL_HOST_EngineTypeDef OPENBL_HOST_UsartEngine =
+{
+  STREAM_Connect,
+  STREAM_GetVersion,
+  STREAM_GetCommand,
+  STREAM_GetId,
+  STREAM_Configure,
+  STREAM_ReadMemory,
+  STREAM_WriteMemory,
+  STREAM_EraseMemory,
+  STREAM_Go,
+  NULL,
+  NULL,
+  NULL,
+  STREAM_CommitMemory,
+  STREAM_CompressedWriteMemory,
+  STREAM_PatchMemory,
+  STREAM_GetBlockCrc,
+  STREAM_ERASE_PAGES_MAX,
+  NULL,
+  0U
+};
+
+const OPENBL_HOST_EngineTypeDef OPENBL_HOST_I2cEngine =
+{
+  STREAM_Connect,
+  STREAM_GetVersion,
+  NULL,
+  STREAM_GetId,
+  STREAM_Configure,
+  STREAM_ReadMemory,
+  STREAM_WriteMemory,
+  STREAM_EraseMemory,
+  STREAM_Go,
+  NULL,
+  NULL,
+  NULL,
+  STREAM_CommitMemory,
+  STREAM_CompressedWriteMemory,
+  STREAM_PatchMemory,
+  STREAM_GetBlockCrc,
+  STREAM_ERASE_PAGES_MAX,
+  a_STREAM_I2cCommands,
+  (uint8_t)sizeof(a_STREAM_I2cCommands)
+};
+
+const OPENBL_HOST_EngineTypeDef OPENBL_HOST_SpiEngine =
+{
+  STREAM_Connect,
+  STREAM_GetVersion,
+  STREAM_GetCommand,
+  STREAM_GetId,
+  STREAM_Configure,
+  STREAM_ReadMemory,
+  STREAM_WriteMemory,
+  STREAM_EraseMemory,
+  STREAM_Go,
+  NULL,
+  NULL,
+  NULL,
+  STREAM_CommitMemory,
+  STREAM_CompressedWriteMemory,
+  STREAM_PatchMemory,
+  STREAM_GetBlockCrc,
+  STREAM_ERASE_PAGES_MAX,
+  NULL,
+  0U
+};
+
+const OPENBL_HOST_EngineTypeDef OPENBL_HOST_I3cEngine =
+{
+  STREAM_Connect,
+  STREAM_GetVersion,
+  STREAM_GetCommand,
+  STREAM_GetId,
+  STREAM_Configure,
+  STREAM_I3cReadMemory,
+  STREAM_I3cWriteMemory,
+  STREAM_EraseMemory,
+  STREAM_Go,
+  NULL,
+  NULL,
+  NULL,
+  STREAM_CommitMemory,
+  STREAM_CompressedWriteMemory,
+  STREAM_PatchMemory,
+  STREAM_GetBlockCrc,
+  STREAM_ERASE_PAGES_MAX,
+  NULL,
+  0U
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to receive an exact number of bytes.
+  * @param  pHandle Pointer to the handle.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_TIMEOUT if less bytes have been received, OPENBL_HOST_OK if all have been
+  *         received else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_Receive(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t *pData,
+                                                uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint32_t length = Length;
+
+  status = OPENBL_HOST_Receive(pHandle, NULL, pData, &length, pHandle->Timeout);
+
+  if ((status == OPENBL_HOST_OK) && (length != Length))
+  {
+    status = OPENBL_HOST_TIMEOUT;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to drop the bytes still sent by the device after an error,
+  *         a pipelined command may have been refused before all its phases were received.
+  * @param  pHandle Pointer to the handle.
+  * @retval None.
+  */
+static void STREAM_Drain(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  uint32_t length = 1U;
+  uint8_t data;
+
+  if (pHandle->Protocol == OPENBL_HOST_USART)
+  {
+    while ((OPENBL_HOST_Receive(pHandle, NULL, &data, &length, STREAM_DRAIN_TIMEOUT) == OPENBL_HOST_OK)
+           && (length == 1U))
+    {
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to wait for an acknowledge of the device.
+  *         The I2C and SPI devices send busy or dummy bytes until their answer is ready. The SPI host then
+  *         acknowledges the answer.
+  * @param  pHandle Pointer to the handle.
+  * @param  Timeout The time to wait in ms.
+  * @retval Returns OPENBL_HOST_OK for an ACK, OPENBL_HOST_NACK for a NACK else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_WaitAck(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Timeout)
+{
+  static const uint8_t ack = OPENBL_HOST_ACK;
+  OPENBL_HOST_StatusTypeDef status;
+  uint32_t start;
+  uint32_t length;
+  uint8_t polling;
+  uint8_t data = 0U;
+
+  polling = ((pHandle->Protocol == OPENBL_HOST_I2C) || (pHandle->Protocol == OPENBL_HOST_SPI)) ? 1U : 0U;
+  start   = OPENBL_HOST_GetTick();
+
+  do
+  {
+    length = 1U;
+    status = OPENBL_HOST_Receive(pHandle, NULL, &data, &length, Timeout);
+
+    if ((status == OPENBL_HOST_OK) && (length != 1U))
+    {
+      status = OPENBL_HOST_TIMEOUT;
+    }
+
+    /* A busy I2C device may not acknowledge its address */
+    if (status != OPENBL_HOST_OK)
+    {
+      OPENBL_HOST_Delay(STREAM_POLL_DELAY);
+    }
+  } while ((polling != 0U) && (data != OPENBL_HOST_ACK) && (data != OPENBL_HOST_NACK_BYTE)
+           && ((status == OPENBL_HOST_OK) || (pHandle->Protocol == OPENBL_HOST_I2C))
+           && ((OPENBL_HOST_GetTick() - start) < Timeout));
+
+  if ((status == OPENBL_HOST_OK) && (pHandle->Protocol == OPENBL_HOST_SPI)
+      && ((data == OPENBL_HOST_ACK) || (data == OPENBL_HOST_NACK_BYTE)))
+  {
+    status = OPENBL_HOST_Send(pHandle, 0U, &ack, 1U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    if (data == OPENBL_HOST_NACK_BYTE)
+    {
+      status = OPENBL_HOST_NACK;
+    }
+    else if (data == OPENBL_HOST_ACK)
+    {
+      status = OPENBL_HOST_OK;
+    }
+    else if (polling != 0U)
+    {
+      status = OPENBL_HOST_TIMEOUT;
+    }
+    else
+    {
+      status = OPENBL_HOST_ERROR;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to close a command phase: with pipelining the acknowledge is only counted
+  *         and read by STREAM_Flush, else it is waited for.
+  * @param  pHandle Pointer to the handle.
+  * @param  pPending Pointer to the number of acknowledges not read yet.
+  * @param  Timeout The time to wait in ms.
+  * @retval Returns OPENBL_HOST_OK if the phase is acknowledged or pending else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_Acknowledge(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t *pPending,
+                                                    uint32_t Timeout)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+
+  if ((pHandle->Protocol == OPENBL_HOST_USART) && (pHandle->Pipelining != 0U))
+  {
+    (*pPending)++;
+  }
+  else
+  {
+    status = STREAM_WaitAck(pHandle, Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to read the pending acknowledges of a pipelined command.
+  *         On error, the rest of the device answer is dropped.
+  * @param  pHandle Pointer to the handle.
+  * @param  Pending The number of acknowledges to be read.
+  * @param  Timeout The time to wait for the last acknowledge in ms.
+  * @retval Returns OPENBL_HOST_OK if all the phases are acknowledged else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_Flush(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Pending,
+                                              uint32_t Timeout)
+{
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+  uint8_t data[STREAM_PENDING_MAX];
+  uint32_t counter;
+
+  /* The acknowledges of the first phases are read at once, the last one may come after a long operation */
+  if (Pending > 1U)
+  {
+    status = STREAM_Receive(pHandle, data, Pending - 1U);
+
+    for (counter = 0U; (counter < (Pending - 1U)) && (status == OPENBL_HOST_OK); counter++)
+    {
+      if (data[counter] == OPENBL_HOST_NACK_BYTE)
+      {
+        status = OPENBL_HOST_NACK;
+      }
+      else if (data[counter] != OPENBL_HOST_ACK)
+      {
+        status = OPENBL_HOST_ERROR;
+      }
+      else
+      {
+        /* Acknowledged */
+      }
+    }
+  }
+
+  if ((Pending != 0U) && (status == OPENBL_HOST_OK))
+  {
+    status = STREAM_WaitAck(pHandle, Timeout);
+  }
+
+  if (status != OPENBL_HOST_OK)
+  {
+    STREAM_Drain(pHandle);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to send a command opcode followed by its complement.
+  * @param  pHandle Pointer to the handle.
+  * @param  OpCode The command opcode.
+  * @param  pPending Pointer to the number of acknowledges not read yet.
+  * @retval Returns OPENBL_HOST_OK if the command is acknowledged or pending else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_SendCommand(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode,
+                                                    uint32_t *pPending)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t command[3];
+  uint32_t length = 0U;
+
+  if (pHandle->Protocol == OPENBL_HOST_SPI)
+  {
+    command[length] = STREAM_SPI_SYNC_BYTE;
+    length++;
+  }
+
+  command[length]      = OpCode;
+  command[length + 1U] = (uint8_t)~OpCode;
+
+  status = OPENBL_HOST_Send(pHandle, 0U, command, length + 2U);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Acknowledge(pHandle, pPending, pHandle->Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to send an address MSB first followed by its XOR.
+  * @param  pHandle Pointer to the handle.
+  * @param  Address The address.
+  * @param  pPending Pointer to the number of acknowledges not read yet.
+  * @retval Returns OPENBL_HOST_OK if the address is acknowledged or pending else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_SendAddress(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                    uint32_t *pPending)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t data[5];
+
+  (void)OPENBL_HOST_PutWord(data, Address);
+  data[4] = OPENBL_HOST_Xor(data, 4U);
+
+  status = OPENBL_HOST_Send(pHandle, 0U, data, 5U);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Acknowledge(pHandle, pPending, pHandle->Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to connect to the device. The USART device detects the host with the
+  *         synchronization byte, the other devices detect the first command.
+  * @param  pHandle Pointer to the handle.
+  * @retval Returns OPENBL_HOST_OK if the device answered else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_Connect(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  static const uint8_t sync = STREAM_USART_SYNC_BYTE;
+  static const uint8_t sync_complement = (uint8_t)~STREAM_USART_SYNC_BYTE;
+  OPENBL_HOST_StatusTypeDef status = OPENBL_HOST_OK;
+
+  if (pHandle->Protocol == OPENBL_HOST_USART)
+  {
+    status = OPENBL_HOST_Send(pHandle, 0U, &sync, 1U);
+
+    if (status == OPENBL_HOST_OK)
+    {
+      status = STREAM_WaitAck(pHandle, pHandle->Timeout);
+    }
+
+    /* A device connected by a previous session takes the synchronization byte as a command opcode and waits
+       for its complement, then refuses the unknown command */
+    if (status == OPENBL_HOST_TIMEOUT)
+    {
+      status = OPENBL_HOST_Send(pHandle, 0U, &sync_complement, 1U);
+
+      if (status == OPENBL_HOST_OK)
+      {
+        status = STREAM_WaitAck(pHandle, pHandle->Timeout);
+      }
+    }
+
+    if (status == OPENBL_HOST_NACK)
+    {
+      status = OPENBL_HOST_OK;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to get the protocol version. The USART device adds two option bytes.
+  * @param  pHandle Pointer to the handle.
+  * @retval Returns OPENBL_HOST_OK if the version has been read else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_GetVersion(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint32_t pending = 0U;
+  uint8_t data[3];
+
+  status = STREAM_SendCommand(pHandle, OPENBL_HOST_CMD_GET_VERSION, &pending);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Flush(pHandle, pending, pHandle->Timeout);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Receive(pHandle, data, (pHandle->Protocol == OPENBL_HOST_USART) ? 3U : 1U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    pHandle->Version = data[0];
+
+    status = STREAM_WaitAck(pHandle, pHandle->Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to get the list of the commands supported by the device.
+  * @param  pHandle Pointer to the handle.
+  * @retval Returns OPENBL_HOST_OK if the list has been read else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_GetCommand(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint32_t pending = 0U;
+  uint8_t data[256];
+  uint8_t number = 0U;
+
+  status = STREAM_SendCommand(pHandle, OPENBL_HOST_CMD_GET_COMMAND, &pending);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Flush(pHandle, pending, pHandle->Timeout);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Receive(pHandle, &number, 1U);
+  }
+
+  /* The protocol version, then the commands */
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Receive(pHandle, data, (uint32_t)number + 1U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    pHandle->CommandsNumber = (number > sizeof(pHandle->Commands)) ? (uint8_t)sizeof(pHandle->Commands) : number;
+
+    for (pending = 0U; pending < pHandle->CommandsNumber; pending++)
+    {
+      pHandle->Commands[pending] = data[pending + 1U];
+    }
+
+    status = STREAM_WaitAck(pHandle, pHandle->Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to get the device identifier: number of bytes, MSB and LSB.
+  * @param  pHandle Pointer to the handle.
+  * @retval Returns OPENBL_HOST_OK if the identifier has been read else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_GetId(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint32_t pending = 0U;
+  uint8_t data[3];
+
+  status = STREAM_SendCommand(pHandle, OPENBL_HOST_CMD_GET_ID, &pending);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Flush(pHandle, pending, pHandle->Timeout);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Receive(pHandle, data, 3U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    pHandle->DeviceId = (uint16_t)(((uint16_t)data[1] << 8U) | data[2]);
+
+    status = STREAM_WaitAck(pHandle, pHandle->Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to select the chunks: 256 bytes per command, several 2 Kbytes loops in
+  *         one I3C command.
+  * @param  pHandle Pointer to the handle.
+  * @retval None.
+  */
+static void STREAM_Configure(OPENBL_HOST_HandleTypeDef *pHandle)
+{
+  if (pHandle->Protocol == OPENBL_HOST_I3C)
+  {
+    pHandle->WriteChunk = STREAM_I3C_CHUNK_SIZE;
+    pHandle->ReadChunk  = STREAM_I3C_CHUNK_SIZE;
+  }
+  else
+  {
+    pHandle->WriteChunk = STREAM_CHUNK_SIZE;
+    pHandle->ReadChunk  = STREAM_CHUNK_SIZE;
+  }
+}
+
+/**
+  * @brief  This function is used to read memory with the read memory command.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes, at most 256.
+  * @retval Returns OPENBL_HOST_OK if the memory has been read else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_ReadMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                   uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint32_t pending = 0U;
+  uint8_t size[2];
+
+  size[0] = (uint8_t)(Length - 1U);
+  size[1] = (uint8_t)~size[0];
+
+  status = STREAM_SendCommand(pHandle, OPENBL_HOST_CMD_READ_MEMORY, &pending);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_SendAddress(pHandle, Address, &pending);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = OPENBL_HOST_Send(pHandle, 0U, size, 2U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Acknowledge(pHandle, &pending, pHandle->Timeout);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Flush(pHandle, pending, pHandle->Timeout);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Receive(pHandle, pData, Length);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to write memory with the write memory command.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes, at most 256.
+  * @retval Returns OPENBL_HOST_OK if the memory has been written else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_WriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                    const uint8_t *pData, uint32_t Length)
+{
+  return STREAM_Write(pHandle, OPENBL_HOST_CMD_WRITE_MEMORY, Address, pData, Length);
+}
+
+/**
+  * @brief  This function is used to write memory with the compressed write memory command,
+  *         its frames are the write memory ones.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the compressed data.
+  * @param  Length The number of compressed bytes, at most 256.
+  * @retval Returns OPENBL_HOST_OK if the memory has been written else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_CompressedWriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                              const uint8_t *pData, uint32_t Length)
+{
+  return STREAM_Write(pHandle, OPENBL_HOST_CMD_COMPRESSED_WRITE, Address, pData, Length);
+}
+
+/**
+  * @brief  This function is used to write memory with the patch memory command,
+  *         its frames are the write memory ones.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the patch.
+  * @param  Length The number of bytes of the patch, at most 256.
+  * @retval Returns OPENBL_HOST_OK if the memory has been written else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_PatchMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                    const uint8_t *pData, uint32_t Length)
+{
+  return STREAM_Write(pHandle, OPENBL_HOST_CMD_PATCH_MEMORY, Address, pData, Length);
+}
+
+/**
+  * @brief  This function is used to send a write command: the opcode, the address, then the number
+  *         of bytes, the data and the XOR in one phase.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  OpCode The command opcode.
+  * @param  Address The start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes, at most 256.
+  * @retval Returns OPENBL_HOST_OK if the memory has been written else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_Write(OPENBL_HOST_HandleTypeDef *pHandle, uint8_t OpCode, uint32_t Address,
+                                              const uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint32_t pending = 0U;
+  uint8_t frame[STREAM_CHUNK_SIZE + 2U];
+  uint32_t counter;
+
+  frame[0] = (uint8_t)(Length - 1U);
+
+  for (counter = 0U; counter < Length; counter++)
+  {
+    frame[counter + 1U] = pData[counter];
+  }
+
+  frame[Length + 1U] = OPENBL_HOST_Xor(frame, Length + 1U);
+
+  status = STREAM_SendCommand(pHandle, OpCode, &pending);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_SendAddress(pHandle, Address, &pending);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = OPENBL_HOST_Send(pHandle, 0U, frame, Length + 2U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Acknowledge(pHandle, &pending, pHandle->Timeout);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Flush(pHandle, pending, pHandle->Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to send the header of an I3C loop: size shifted left with the loop flag
+  *         in bit 0, MSB first, then the XOR.
+  * @param  pHandle Pointer to the handle.
+  * @param  Size The number of bytes of this loop.
+  * @param  Loop 1 if another loop follows else 0.
+  * @retval Returns OPENBL_HOST_OK if the header has been sent else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_I3cSendLoop(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Size,
+                                                    uint32_t Loop)
+{
+  uint8_t header[3];
+
+  header[0] = (uint8_t)(((Size << 1U) | Loop) >> 8U);
+  header[1] = (uint8_t)((Size << 1U) | Loop);
+  header[2] = header[0] ^ header[1];
+
+  return OPENBL_HOST_Send(pHandle, 0U, header, 3U);
+}
+
+/**
+  * @brief  This function is used to read memory with one I3C read memory command of several loops.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the memory has been read else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_I3cReadMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                      uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint32_t pending = 0U;
+  uint32_t length;
+
+  status = STREAM_SendCommand(pHandle, OPENBL_HOST_CMD_READ_MEMORY, &pending);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_SendAddress(pHandle, Address, &pending);
+  }
+
+  while ((Length != 0U) && (status == OPENBL_HOST_OK))
+  {
+    length = (Length > STREAM_I3C_LOOP_SIZE) ? STREAM_I3C_LOOP_SIZE : Length;
+    status = STREAM_I3cSendLoop(pHandle, length, (Length > length) ? 1U : 0U);
+
+    if (status == OPENBL_HOST_OK)
+    {
+      status = STREAM_WaitAck(pHandle, pHandle->Timeout);
+    }
+
+    if (status == OPENBL_HOST_OK)
+    {
+      status = STREAM_Receive(pHandle, pData, length);
+    }
+
+    pData  += length;
+    Length -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to write memory with one I3C write memory command of several loops,
+  *         each loop carries its data and their XOR.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns OPENBL_HOST_OK if the memory has been written else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_I3cWriteMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                       const uint8_t *pData, uint32_t Length)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t frame[STREAM_I3C_LOOP_SIZE + 1U];
+  uint32_t pending = 0U;
+  uint32_t length;
+  uint32_t counter;
+
+  status = STREAM_SendCommand(pHandle, OPENBL_HOST_CMD_WRITE_MEMORY, &pending);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_SendAddress(pHandle, Address, &pending);
+  }
+
+  while ((Length != 0U) && (status == OPENBL_HOST_OK))
+  {
+    length = (Length > STREAM_I3C_LOOP_SIZE) ? STREAM_I3C_LOOP_SIZE : Length;
+    status = STREAM_I3cSendLoop(pHandle, length, (Length > length) ? 1U : 0U);
+
+    if (status == OPENBL_HOST_OK)
+    {
+      status = STREAM_WaitAck(pHandle, pHandle->Timeout);
+    }
+
+    if (status == OPENBL_HOST_OK)
+    {
+      for (counter = 0U; counter < length; counter++)
+      {
+        frame[counter] = pData[counter];
+      }
+
+      frame[length] = OPENBL_HOST_Xor(pData, length);
+
+      status = OPENBL_HOST_Send(pHandle, 0U, frame, length + 1U);
+    }
+
+    if (status == OPENBL_HOST_OK)
+    {
+      status = STREAM_WaitAck(pHandle, pHandle->Timeout);
+    }
+
+    pData  += length;
+    Length -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to erase memory with the extended erase command, or with the legacy one
+  *         when the device does not support it. The pages numbers are sent MSB first, the I2C, SPI and
+  *         I3C devices acknowledge the number of pages before receiving them.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  FirstPage The number of the first page.
+  * @param  PagesNumber The number of pages, 0 for a mass erase.
+  * @retval Returns OPENBL_HOST_OK if the memory has been erased else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_EraseMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t FirstPage,
+                                                    uint32_t PagesNumber)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint8_t frame[(STREAM_ERASE_PAGES_MAX * 2U) + 3U];
+  uint32_t pending = 0U;
+  uint32_t length  = 0U;
+  uint32_t counter;
+  uint32_t count;
+  uint8_t extended;
+
+  extended = OPENBL_HOST_IsCommandSupported(pHandle, OPENBL_HOST_CMD_EXT_ERASE_MEMORY);
+
+  /* The I3C device expects the number of pages, the other ones the number of pages minus one */
+  count = (pHandle->Protocol == OPENBL_HOST_I3C) ? PagesNumber : (PagesNumber - 1U);
+
+  if ((extended == 0U) && (OPENBL_HOST_IsCommandSupported(pHandle, OPENBL_HOST_CMD_LEG_ERASE_MEMORY) == 0U))
+  {
+    status = OPENBL_HOST_UNSUPPORTED;
+  }
+  else
+  {
+    status = STREAM_SendCommand(pHandle, (extended != 0U) ? OPENBL_HOST_CMD_EXT_ERASE_MEMORY
+                                : OPENBL_HOST_CMD_LEG_ERASE_MEMORY, &pending);
+  }
+
+  if (status != OPENBL_HOST_OK)
+  {
+    /* Nothing to send */
+  }
+  else if (extended == 0U)
+  {
+    /* Legacy erase: number of pages minus one and page numbers on one byte, 0xFF for a mass erase */
+    frame[length] = (PagesNumber == 0U) ? 0xFFU : (uint8_t)(PagesNumber - 1U);
+    length++;
+
+    for (counter = 0U; counter < PagesNumber; counter++)
+    {
+      frame[length] = (uint8_t)(FirstPage + counter);
+      length++;
+    }
+
+    frame[length] = (PagesNumber == 0U) ? 0x00U : OPENBL_HOST_Xor(frame, length);
+    length++;
+
+    status = OPENBL_HOST_Send(pHandle, 0U, frame, length);
+  }
+  else if (PagesNumber == 0U)
+  {
+    frame[0] = 0xFFU;
+    frame[1] = 0xFFU;
+    frame[2] = 0x00U;
+
+    status = OPENBL_HOST_Send(pHandle, 0U, frame, 3U);
+  }
+  else
+  {
+    frame[0] = (uint8_t)(count >> 8U);
+    frame[1] = (uint8_t)count;
+    length   = 2U;
+
+    /* The USART device receives the number of pages and the pages in one phase with a single XOR */
+    if (pHandle->Protocol != OPENBL_HOST_USART)
+    {
+      frame[2] = frame[0] ^ frame[1];
+
+      status = OPENBL_HOST_Send(pHandle, 0U, frame, 3U);
+
+      if (status == OPENBL_HOST_OK)
+      {
+        status = STREAM_Acknowledge(pHandle, &pending, pHandle->Timeout);
+      }
+
+      length = 0U;
+    }
+
+    for (counter = 0U; counter < PagesNumber; counter++)
+    {
+      frame[length]      = (uint8_t)((FirstPage + counter) >> 8U);
+      frame[length + 1U] = (uint8_t)(FirstPage + counter);
+      length += 2U;
+    }
+
+    frame[length] = OPENBL_HOST_Xor(frame, length);
+    length++;
+
+    if (status == OPENBL_HOST_OK)
+    {
+      status = OPENBL_HOST_Send(pHandle, 0U, frame, length);
+    }
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Acknowledge(pHandle, &pending, pHandle->EraseTimeout);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Flush(pHandle, pending, pHandle->EraseTimeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to make the device jump to an application with the go command.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The address of the application vector table.
+  * @retval Returns OPENBL_HOST_OK if the device accepted the address else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_Go(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint32_t pending = 0U;
+
+  status = STREAM_SendCommand(pHandle, OPENBL_HOST_CMD_GO, &pending);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_SendAddress(pHandle, Address, &pending);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Flush(pHandle, pending, pHandle->Timeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to program in the Flash the image written in the RAM staging area:
+  *         the Flash address, then the image length and its CRC-32 followed by their XOR. The last
+  *         acknowledge is sent once the device has erased, programmed and checked the Flash.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The Flash address of the image.
+  * @param  Length The number of bytes of the image.
+  * @param  Crc The CRC-32 of the image.
+  * @retval Returns OPENBL_HOST_OK if the image has been programmed else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_CommitMemory(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                     uint32_t Length, uint32_t Crc)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint32_t pending = 0U;
+  uint8_t frame[9];
+
+  (void)OPENBL_HOST_PutWord(frame, Length);
+  (void)OPENBL_HOST_PutWord(&frame[4], Crc);
+  frame[8] = OPENBL_HOST_Xor(frame, 8U);
+
+  status = STREAM_SendCommand(pHandle, OPENBL_HOST_CMD_COMMIT_MEMORY, &pending);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_SendAddress(pHandle, Address, &pending);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = OPENBL_HOST_Send(pHandle, 0U, frame, 9U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Acknowledge(pHandle, &pending, pHandle->EraseTimeout);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Flush(pHandle, pending, pHandle->EraseTimeout);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to read the CRC-32 of consecutive memory blocks: the opcode, the address,
+  *         then the block size (MSB first), the number of blocks minus one and the XOR. The CRCs are read
+  *         in one frame once the device has computed them.
+  * @param  pHandle Pointer to the connected handle.
+  * @param  Address The start address of the first block.
+  * @param  BlockSize The number of bytes of each block.
+  * @param  BlocksNumber The number of blocks, at most 256.
+  * @param  pData Pointer to the buffer receiving the CRCs, 4 bytes per block, each MSB first.
+  * @retval Returns OPENBL_HOST_OK if the CRCs have been read else the error.
+  */
+static OPENBL_HOST_StatusTypeDef STREAM_GetBlockCrc(OPENBL_HOST_HandleTypeDef *pHandle, uint32_t Address,
+                                                    uint32_t BlockSize, uint32_t BlocksNumber, uint8_t *pData)
+{
+  OPENBL_HOST_StatusTypeDef status;
+  uint32_t pending = 0U;
+  uint8_t frame[6];
+
+  (void)OPENBL_HOST_PutWord(frame, BlockSize);
+  frame[4] = (uint8_t)(BlocksNumber - 1U);
+  frame[5] = OPENBL_HOST_Xor(frame, 5U);
+
+  status = STREAM_SendCommand(pHandle, OPENBL_HOST_CMD_GET_BLOCK_CRC, &pending);
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_SendAddress(pHandle, Address, &pending);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = OPENBL_HOST_Send(pHandle, 0U, frame, 6U);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Acknowledge(pHandle, &pending, pHandle->EraseTimeout);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Flush(pHandle, pending, pHandle->EraseTimeout);
+  }
+
+  if (status == OPENBL_HOST_OK)
+  {
+    status = STREAM_Receive(pHandle, pData, BlocksNumber * 4U);
+  }
+
+  return status;
+}
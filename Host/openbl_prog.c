@@ -0,0 +1,460 @@
+/**
+  ******************************************************************************
+  * @file    openbl_prog.c
+  * @author  MCD Application Team
+  * @brief   Command line programmer built on the host library and its Linux back-ends
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "openbl_host.h"
+#include "openbl_host_engine.h"
+#include "openbl_host_backends.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char *pName;
+  OPENBL_HOST_ProtocolTypeDef Protocol;
+} PROG_ProtocolTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define PROG_NO_ADDRESS                   0xFFFFFFFFU /* No go address given */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static const PROG_ProtocolTypeDef a_Protocols[] =
+{
+  {"usart", OPENBL_HOST_USART},
+  {"i2c",   OPENBL_HOST_I2C},
+  {"spi",   OPENBL_HOST_SPI},
+  {"can",   OPENBL_HOST_CAN},
+  {"fdcan", OPENBL_HOST_FDCAN}
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static void Usage(const char *pName);
+static uint8_t *ReadFile(const char *pFile, uint32_t *pLength);
+static OPENBL_HOST_StatusTypeDef OpenBackend(OPENBL_HOST_BackendTypeDef *pBackend,
+                                             OPENBL_HOST_ProtocolTypeDef Protocol, const char *pDevice,
+                                             uint32_t Speed, uint8_t Address);
+static int Check(const char *pStep, OPENBL_HOST_StatusTypeDef Status);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Print the command line options.
+  * @param  pName The program name.
+  * @retval None.
+  */
+static void Usage(const char *pName)
+{
+  (void)fprintf(stderr,
+                "Usage: %s -P protocol -d device [options]\n"
+                "  -P name   Protocol: usart, i2c, spi, can or fdcan\n"
+                "  -d device Serial port, I2C bus, spidev device or SocketCAN interface\n"
+                "  -s speed  USART baudrate or SPI clock in Hz (default %u, %u)\n"
+                "  -a addr   7-bit I2C address of the device (default 0x%02X)\n"
+                "  -m        Mass erase\n"
+                "  -e pages  Erase pages, first:number\n"
+                "  -w file   Program the file, then verify it\n"
+                "  -A addr   Address of the file (default 0x08000000)\n"
+                "  -p        USART pipelining, for devices buffering their reception\n"
+                "  -N node   CAN/FDCAN node identifier, enables the group writes verified by CRC-32\n"
+                "  -B time   Programming time of a group block in us (default %u)\n"
+                "  -S area   RAM staging area of the device, address:size, the file is programmed by Commit Memory\n"
+                "  -z        Program the file with Compressed Write Memory when the device supports it\n"
+                "  -D old    Old image in the device, address:file, the file is written as a patch of it by Patch Memory\n"
+                "  -u pages  Update the file from page:page size, only the pages whose CRC-32 differs are programmed\n"
+                "  -t time   Response timeout in ms (default %u)\n"
+                "  -g addr   Jump to the application at this address\n",
+                pName, OPENBL_HOST_SERIAL_BAUDRATE_DEFAULT, OPENBL_HOST_SPI_SPEED_DEFAULT,
+                OPENBL_HOST_I2C_ADDRESS_DEFAULT, OPENBL_HOST_GROUP_BLOCK_TIME_DEFAULT, OPENBL_HOST_TIMEOUT_DEFAULT);
+}
+
+/**
+  * @brief  Read a whole file.
+  * @param  pFile The file name.
+  * @param  pLength Pointer to the returned file size.
+  * @retval Returns the allocated file content, NULL on error.
+  */
+static uint8_t *ReadFile(const char *pFile, uint32_t *pLength)
+{
+  uint8_t *p_data = NULL;
+  FILE *p_stream;
+  long size = -1;
+
+  p_stream = fopen(pFile, "rb");
+
+  if (p_stream != NULL)
+  {
+    if (fseek(p_stream, 0L, SEEK_END) == 0)
+    {
+      size = ftell(p_stream);
+      rewind(p_stream);
+    }
+
+    if (size > 0)
+    {
+      p_data = malloc((size_t)size);
+    }
+
+    if ((p_data != NULL) && (fread(p_data, 1U, (size_t)size, p_stream) != (size_t)size))
+    {
+      free(p_data);
+      p_data = NULL;
+    }
+
+    (void)fclose(p_stream);
+  }
+
+  *pLength = (p_data != NULL) ? (uint32_t)size : 0U;
+
+  return p_data;
+}
+
+/**
+  * @brief  Open the Linux back-end of a protocol.
+  * @param  pBackend Pointer to the back-end to be filled.
+  * @param  Protocol The protocol.
+  * @param  pDevice The device or interface name.
+  * @param  Speed The USART baudrate or the SPI clock, 0 for the default one.
+  * @param  Address The I2C address.
+  * @retval Returns OPENBL_HOST_OK if the back-end has been opened else the error.
+  */
+static OPENBL_HOST_StatusTypeDef OpenBackend(OPENBL_HOST_BackendTypeDef *pBackend,
+                                             OPENBL_HOST_ProtocolTypeDef Protocol, const char *pDevice,
+                                             uint32_t Speed, uint8_t Address)
+{
+  OPENBL_HOST_StatusTypeDef status;
+
+  switch (Protocol)
+  {
+    case OPENBL_HOST_USART:
+      status = OPENBL_HOST_SerialOpen(pBackend, pDevice, (Speed != 0U) ? Speed : OPENBL_HOST_SERIAL_BAUDRATE_DEFAULT);
+      break;
+
+    case OPENBL_HOST_I2C:
+      status = OPENBL_HOST_I2cdevOpen(pBackend, pDevice, Address);
+      break;
+
+    case OPENBL_HOST_SPI:
+      status = OPENBL_HOST_SpidevOpen(pBackend, pDevice, (Speed != 0U) ? Speed : OPENBL_HOST_SPI_SPEED_DEFAULT);
+      break;
+
+    case OPENBL_HOST_CAN:
+      status = OPENBL_HOST_SocketCanOpen(pBackend, pDevice, 0U);
+      break;
+
+    case OPENBL_HOST_FDCAN:
+      status = OPENBL_HOST_SocketCanOpen(pBackend, pDevice, 1U);
+      break;
+
+    default:
+      status = OPENBL_HOST_UNSUPPORTED;
+      break;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Print the result of a step when it failed.
+  * @param  pStep The step name.
+  * @param  Status The status of the step.
+  * @retval Returns 0 if the step succeeded else 1.
+  */
+static int Check(const char *pStep, OPENBL_HOST_StatusTypeDef Status)
+{
+  if (Status != OPENBL_HOST_OK)
+  {
+    (void)fflush(stdout);
+    (void)fprintf(stderr, "%s: %s\n", pStep, OPENBL_HOST_GetStatusName(Status));
+  }
+
+  return (Status != OPENBL_HOST_OK) ? 1 : 0;
+}
+
+/**
+  * @brief  Main program.
+  * @param  argc Number of arguments.
+  * @param  argv Arguments.
+  * @retval Returns EXIT_SUCCESS if all the steps succeeded else EXIT_FAILURE.
+  */
+int main(int argc, char *argv[])
+{
+  OPENBL_HOST_HandleTypeDef handle;
+  OPENBL_HOST_BackendTypeDef backend;
+  OPENBL_HOST_StatusTypeDef status;
+  OPENBL_HOST_ProtocolTypeDef protocol = OPENBL_HOST_USART;
+  const char *p_protocol = NULL;
+  const char *p_device = NULL;
+  const char *p_file = NULL;
+  const char *p_source_file = NULL;
+  uint8_t *p_data = NULL;
+  uint8_t *p_source = NULL;
+  uint32_t length = 0U;
+  uint32_t source_length = 0U;
+  uint32_t source_address = 0U;
+  uint32_t update_page = 0U;
+  uint32_t page_size = 0U;
+  uint32_t pages_written = 0U;
+  uint32_t speed = 0U;
+  uint32_t address = 0x08000000U;
+  uint32_t go_address = PROG_NO_ADDRESS;
+  uint32_t first_page = 0U;
+  uint32_t pages_number = 0U;
+  uint32_t node_id = OPENBL_HOST_NO_NODE_ID;
+  uint32_t block_time = OPENBL_HOST_GROUP_BLOCK_TIME_DEFAULT;
+  uint32_t staging_address = 0U;
+  uint32_t staging_size = 0U;
+  uint32_t timeout = OPENBL_HOST_TIMEOUT_DEFAULT;
+  uint32_t start;
+  uint32_t elapsed;
+  uint32_t counter;
+  char *p_end;
+  uint8_t i2c_address = OPENBL_HOST_I2C_ADDRESS_DEFAULT;
+  uint8_t mass_erase = 0U;
+  uint8_t pipelining = 0U;
+  uint8_t compression = 0U;
+  uint8_t found = 0U;
+  int failed = 0;
+  int option;
+
+  while ((option = getopt(argc, argv, "P:d:s:a:me:w:A:pN:B:S:zD:u:t:g:h")) != -1)
+  {
+    switch (option)
+    {
+      case 'P':
+        p_protocol = optarg;
+        break;
+
+      case 'd':
+        p_device = optarg;
+        break;
+
+      case 's':
+        speed = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'a':
+        i2c_address = (uint8_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'm':
+        mass_erase = 1U;
+        break;
+
+      case 'e':
+        if (sscanf(optarg, "%u:%u", &first_page, &pages_number) != 2)
+        {
+          pages_number = 0U;
+        }
+        break;
+
+      case 'w':
+        p_file = optarg;
+        break;
+
+      case 'A':
+        address = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'p':
+        pipelining = 1U;
+        break;
+
+      case 'N':
+        node_id = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'B':
+        block_time = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'S':
+        staging_address = (uint32_t)strtoul(optarg, &p_end, 0);
+        staging_size    = (*p_end == ':') ? (uint32_t)strtoul(&p_end[1], NULL, 0) : 0U;
+        break;
+
+      case 'z':
+        compression = 1U;
+        break;
+
+      case 'D':
+        source_address = (uint32_t)strtoul(optarg, &p_end, 0);
+        p_source_file  = (*p_end == ':') ? &p_end[1] : NULL;
+        break;
+
+      case 'u':
+        update_page = (uint32_t)strtoul(optarg, &p_end, 0);
+        page_size   = (*p_end == ':') ? (uint32_t)strtoul(&p_end[1], NULL, 0) : 0U;
+        break;
+
+      case 't':
+        timeout = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'g':
+        go_address = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      default:
+        Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+
+  for (counter = 0U; (counter < (sizeof(a_Protocols) / sizeof(a_Protocols[0]))) && (p_protocol != NULL); counter++)
+  {
+    if (strcmp(p_protocol, a_Protocols[counter].pName) == 0)
+    {
+      protocol = a_Protocols[counter].Protocol;
+      found    = 1U;
+    }
+  }
+
+  if ((found == 0U) || (p_device == NULL))
+  {
+    Usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (p_file != NULL)
+  {
+    p_data = ReadFile(p_file, &length);
+
+    if (p_data == NULL)
+    {
+      (void)fprintf(stderr, "Cannot read %s\n", p_file);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if ((p_data != NULL) && (p_source_file != NULL))
+  {
+    p_source = ReadFile(p_source_file, &source_length);
+
+    if (p_source == NULL)
+    {
+      (void)fprintf(stderr, "Cannot read %s\n", p_source_file);
+      free(p_data);
+      return EXIT_FAILURE;
+    }
+  }
+
+  status = OpenBackend(&backend, protocol, p_device, speed, i2c_address);
+
+  if (status != OPENBL_HOST_OK)
+  {
+    (void)fprintf(stderr, "Cannot open %s: %s\n", p_device, OPENBL_HOST_GetStatusName(status));
+    free(p_data);
+    free(p_source);
+    return EXIT_FAILURE;
+  }
+
+  OPENBL_HOST_Init(&handle, protocol, &backend);
+
+  handle.Timeout        = timeout;
+  handle.Pipelining     = pipelining;
+  handle.NodeId         = node_id;
+  handle.GroupBlockTime = block_time;
+  handle.StagingAddress = staging_address;
+  handle.StagingSize    = staging_size;
+  handle.Compression    = compression;
+
+  failed = Check("Connect", OPENBL_HOST_Connect(&handle));
+
+  if (failed == 0)
+  {
+    (void)printf("Protocol version %u.%u, device 0x%03X, %u commands\n", (unsigned int)(handle.Version >> 4U),
+                 (unsigned int)(handle.Version & 0x0FU), (unsigned int)handle.DeviceId,
+                 (unsigned int)handle.CommandsNumber);
+  }
+
+  if ((failed == 0) && (mass_erase != 0U))
+  {
+    failed = Check("Mass erase", OPENBL_HOST_MassErase(&handle));
+  }
+
+  if ((failed == 0) && (pages_number != 0U))
+  {
+    failed = Check("Erase", OPENBL_HOST_ErasePages(&handle, first_page, pages_number));
+  }
+
+  if ((failed == 0) && (p_data != NULL))
+  {
+    start = OPENBL_HOST_GetTick();
+
+    if (p_source != NULL)
+    {
+      failed = Check("Patch", OPENBL_HOST_PatchMemory(&handle, address, p_data, length, source_address, p_source,
+                                                      source_length));
+
+      if (failed == 0)
+      {
+        failed = Check("Verify", OPENBL_HOST_VerifyMemory(&handle, address, p_data, length));
+      }
+    }
+    else if (page_size != 0U)
+    {
+      failed = Check("Update", OPENBL_HOST_Update(&handle, address, p_data, length, update_page, page_size,
+                                                  &pages_written));
+
+      if (failed == 0)
+      {
+        (void)printf("Updated %u of %u pages\n", (unsigned int)pages_written,
+                     (unsigned int)((length + page_size - 1U) / page_size));
+      }
+    }
+    else
+    {
+      failed = Check("Program", OPENBL_HOST_Program(&handle, address, p_data, length));
+    }
+
+    if (failed == 0)
+    {
+      elapsed = OPENBL_HOST_GetTick() - start;
+
+      (void)printf("Programmed and verified %u bytes at 0x%08X in %u ms", (unsigned int)length,
+                   (unsigned int)address, (unsigned int)elapsed);
+
+      if (elapsed != 0U)
+      {
+        (void)printf(", %.1f KB/s", ((double)length / 1024.0) / ((double)elapsed / 1000.0));
+      }
+
+      (void)printf("\n");
+    }
+  }
+
+  if ((failed == 0) && (go_address != PROG_NO_ADDRESS))
+  {
+    failed = Check("Go", OPENBL_HOST_Go(&handle, go_address));
+  }
+
+  (void)printf("%u commands, %u round trips, %llu bytes written, %llu bytes read\n",
+               (unsigned int)handle.Statistics.Commands, (unsigned int)handle.Statistics.RoundTrips,
+               (unsigned long long)handle.Statistics.BytesWritten, (unsigned long long)handle.Statistics.BytesRead);
+
+  OPENBL_HOST_DeInit(&handle);
+  free(p_data);
+  free(p_source);
+
+  return (failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
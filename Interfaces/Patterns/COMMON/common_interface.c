@@ -18,16 +18,26 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "platform.h"
+#include "interfaces_conf.h"
 #include "flash_interface.h"
 #include "openbootloader_conf.h"
 #include "common_interface.h"
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#define COMMON_CRC32_POLYNOMIAL           0x04C11DB7U  /* CRC-32 (IEEE 802.3) polynomial, not reflected */
+#define COMMON_EXTI_LINES_NUMBER          16U          /* EXTI lines of the GPIO pins, one per pin number */
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 static Function_Pointer ResetCallback;
 
+/* Detection pins whose activity has been reported by the EXTI interrupt */
+static volatile uint32_t CommonActivityPins = 0U;
+
+/* Port of the detection pin armed on each EXTI line, NULL when the line is free */
+static GPIO_TypeDef *a_CommonExtiPorts[COMMON_EXTI_LINES_NUMBER] = {NULL};
+
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 /* Exported functions --------------------------------------------------------*/
@@ -60,6 +70,108 @@ void Common_DisableIrq(void)
   __disable_irq();
 }
 
+/**
+  * @brief  Enter sleep mode until the next interrupt.
+  * @retval None.
+  */
+void Common_WaitForInterrupt(void)
+{
+  __WFI();
+}
+
+/**
+  * @brief  Start the cycle counter used for the statistics.
+  *         The DWT cycle counter is used when the core has one, else the SysTick is used.
+  * @retval None.
+  */
+void Common_StartCycleCounter(void)
+{
+#if defined(DWT)
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0U;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif /* DWT */
+}
+
+/**
+  * @brief  Return the current value of the cycle counter.
+  *         Without DWT, the count is built from the HAL tick and the SysTick down counter,
+  *         the tick is read again when it changed meanwhile.
+  * @retval The cycle count.
+  */
+uint32_t Common_GetCycleCount(void)
+{
+#if defined(DWT)
+  return DWT->CYCCNT;
+#else
+  uint32_t tick;
+  uint32_t value;
+
+  do
+  {
+    tick  = HAL_GetTick();
+    value = SysTick->VAL;
+  } while (tick != HAL_GetTick());
+
+  return (tick * (SysTick->LOAD + 1U)) + (SysTick->LOAD - value);
+#endif /* DWT */
+}
+
+/**
+  * @brief  Return the frequency of the cycle counter.
+  * @retval The frequency in Hz.
+  */
+uint32_t Common_GetCycleFrequency(void)
+{
+  return SystemCoreClock;
+}
+
+/**
+  * @brief  Compute with the CRC unit the CRC-32 (IEEE 802.3) of a Flash or RAM region.
+  *         The input and output bits are reversed to get the reflected CRC, the words are written
+  *         with a reversal by word to keep the byte order, the unaligned bytes with a reversal by byte.
+  * @param  Crc The CRC of the previous regions, 0 for the first one.
+  * @param  Address The start address of the region.
+  * @param  Length The number of bytes of the region.
+  * @retval The updated CRC.
+  */
+uint32_t Common_ComputeCrc32(uint32_t Crc, uint32_t Address, uint32_t Length)
+{
+  uint32_t address = Address;
+  uint32_t end     = Address + Length;
+
+  __HAL_RCC_CRC_CLK_ENABLE();
+
+  /* The CRC unit holds the CRC not reflected */
+  CRC->POL  = COMMON_CRC32_POLYNOMIAL;
+  CRC->INIT = __RBIT(~Crc);
+  CRC->CR   = CRC_CR_REV_IN_0 | CRC_CR_REV_OUT | CRC_CR_RESET;
+
+  while ((address < end) && ((address & 0x3U) != 0U))
+  {
+    *(__IO uint8_t *)(&CRC->DR) = *(__IO uint8_t *)address;
+    address++;
+  }
+
+  CRC->CR = CRC_CR_REV_IN | CRC_CR_REV_OUT;
+
+  while ((end - address) >= 4U)
+  {
+    CRC->DR = *(__IO uint32_t *)address;
+    address += 4U;
+  }
+
+  CRC->CR = CRC_CR_REV_IN_0 | CRC_CR_REV_OUT;
+
+  while (address < end)
+  {
+    *(__IO uint8_t *)(&CRC->DR) = *(__IO uint8_t *)address;
+    address++;
+  }
+
+  return ~(CRC->DR);
+}
+
 /**
   * @brief  Checks whether the target Protection Status is set or not.
   * @retval Returns SET if protection is enabled else return RESET.
@@ -103,3 +215,171 @@ void Common_StartPostProcessing()
     ResetCallback = NULL;
   }
 }
+
+/**
+  * @brief  Return the identifier of this node, used to address it when several devices share the same bus.
+  *         It is the 32-bit XOR of the device unique ID words.
+  * @retval The node identifier.
+  */
+uint32_t Common_GetNodeId(void)
+{
+  return (HAL_GetUIDw0() ^ HAL_GetUIDw1() ^ HAL_GetUIDw2());
+}
+
+/**
+  * @brief  Check whether the application requested to stay in the bootloader before its last reset.
+  *         The request is the OPENBL_BOOT_REQUEST_MAGIC value in the backup register 0, it is cleared once read.
+  * @retval Returns SET if the bootloader is requested else return RESET.
+  */
+FlagStatus Common_GetBootRequest(void)
+{
+  FlagStatus status = RESET;
+
+  if (TAMP->BKP0R == OPENBL_BOOT_REQUEST_MAGIC)
+  {
+    /* The backup domain is write protected, its access needs the PWR clock */
+    __HAL_RCC_PWR_CLK_ENABLE();
+    HAL_PWR_EnableBkUpAccess();
+    TAMP->BKP0R = 0U;
+
+    status = SET;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Read a word of the Flash, used before the memories are registered.
+  * @param  Address The address of the word.
+  * @retval The word.
+  */
+uint32_t Common_ReadWord(uint32_t Address)
+{
+  return *(__IO uint32_t *)Address;
+}
+
+/**
+  * @brief  Start the application without going through the memory interfaces, nothing is initialized yet.
+  *         The stack pointer and the reset handler are read from the application vector table.
+  * @param  Address The address of the application vector table.
+  * @retval None.
+  */
+void Common_JumpToApplication(uint32_t Address)
+{
+  Function_Pointer jump_to_application;
+  uint32_t stack_pointer;
+
+  stack_pointer = *(__IO uint32_t *)Address;
+
+  /* The stack of the application must be in the RAM */
+  if ((stack_pointer > RAM_START_ADDRESS) && (stack_pointer <= RAM_END_ADDRESS))
+  {
+    jump_to_application = (Function_Pointer)(*(__IO uint32_t *)(Address + 4U));
+
+    /* Initialize user application's stack pointer */
+    Common_SetMsp(stack_pointer);
+
+    jump_to_application();
+  }
+}
+
+/**
+  * @brief  Arm the activity detection on the pin of an interface which is not initialized (lazy init).
+  *         The pin is configured as an EXTI falling edge input and its EXTI interrupt is enabled, so that
+  *         the activity wakes up the core sleeping in Common_WaitForInterrupt.
+  *         An EXTI line selects one port, so a line already armed for the pin of another port is left to it:
+  *         the pin is not armed and Common_ActivityDetected reports activity at once, the interface is then
+  *         initialized as without lazy init.
+  * @param  pPort The GPIO port of the pin, its clock must be enabled.
+  * @param  Pin The GPIO pin.
+  * @param  IRQn The EXTI interrupt of the pin.
+  * @retval None.
+  */
+void Common_ArmActivityDetection(GPIO_TypeDef *pPort, uint32_t Pin, IRQn_Type IRQn)
+{
+  GPIO_InitTypeDef GPIO_InitStruct;
+  uint32_t line = POSITION_VAL(Pin);
+
+  if ((a_CommonExtiPorts[line] == NULL) || (a_CommonExtiPorts[line] == pPort))
+  {
+    a_CommonExtiPorts[line] = pPort;
+
+    Common_DisableIrq();
+    CommonActivityPins &= ~Pin;
+    Common_EnableIrq();
+
+    GPIO_InitStruct.Pin   = Pin;
+    GPIO_InitStruct.Mode  = GPIO_MODE_IT_FALLING;
+    GPIO_InitStruct.Pull  = GPIO_PULLUP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+    HAL_GPIO_Init(pPort, &GPIO_InitStruct);
+
+    OPENBL_EXTI_CLEAR_FLAG(Pin);
+
+    NVIC_SetPriority(IRQn, 5U);
+    NVIC_EnableIRQ(IRQn);
+  }
+}
+
+/**
+  * @brief  Release the activity detection pin and its EXTI interrupt.
+  * @param  pPort The GPIO port of the pin.
+  * @param  Pin The GPIO pin.
+  * @param  IRQn The EXTI interrupt of the pin.
+  * @retval None.
+  */
+void Common_DisarmActivityDetection(GPIO_TypeDef *pPort, uint32_t Pin, IRQn_Type IRQn)
+{
+  uint32_t line = POSITION_VAL(Pin);
+
+  /* The line of a pin which has not been armed belongs to another interface */
+  if (a_CommonExtiPorts[line] == pPort)
+  {
+    NVIC_DisableIRQ(IRQn);
+    HAL_GPIO_DeInit(pPort, Pin);
+    OPENBL_EXTI_CLEAR_FLAG(Pin);
+
+    Common_DisableIrq();
+    CommonActivityPins &= ~Pin;
+    Common_EnableIrq();
+
+    a_CommonExtiPorts[line] = NULL;
+  }
+}
+
+/**
+  * @brief  Check if there was any activity on a detection pin since it was armed.
+  *         The activity is either still pending in the EXTI or reported by Common_ActivityCallback. It is
+  *         reported at once for a pin which could not be armed, its EXTI line being used by another port.
+  *         The pin is released when activity is detected, it is then configured by the interface initialization.
+  * @param  pPort The GPIO port of the pin.
+  * @param  Pin The GPIO pin.
+  * @param  IRQn The EXTI interrupt of the pin.
+  * @retval Returns 1 if activity is detected else 0.
+  */
+uint8_t Common_ActivityDetected(GPIO_TypeDef *pPort, uint32_t Pin, IRQn_Type IRQn)
+{
+  uint8_t activity = 0U;
+
+  if ((a_CommonExtiPorts[POSITION_VAL(Pin)] != pPort)
+      || ((CommonActivityPins & Pin) != 0U) || (OPENBL_EXTI_GET_FLAG(Pin) != 0U))
+  {
+    Common_DisarmActivityDetection(pPort, Pin, IRQn);
+
+    activity = 1U;
+  }
+
+  return activity;
+}
+
+/**
+  * @brief  Report the activity on a detection pin.
+  *         It must be called by the EXTI falling edge callback (HAL_GPIO_EXTI_Falling_Callback), as the EXTI
+  *         interrupt handler clears the pending flag.
+  * @param  Pin The GPIO pin.
+  * @retval None.
+  */
+void Common_ActivityCallback(uint32_t Pin)
+{
+  CommonActivityPins |= Pin;
+}
@@ -23,8 +23,17 @@
 #include "openbl_fdcan_cmd.h"
 #include "fdcan_interface.h"
 #include "iwdg_interface.h"
+#include "common_interface.h"
 
 /* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint32_t Identifier;
+  uint32_t Timestamp;
+  uint32_t Length;
+  uint8_t Data[64];
+} OPENBL_FDCAN_FrameTypeDef;
+
 /* Private define ------------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
@@ -33,13 +42,25 @@ static FDCAN_FilterTypeDef sFilterConfig;
 static FDCAN_TxHeaderTypeDef TxHeader;
 static FDCAN_RxHeaderTypeDef RxHeader;
 static uint8_t FdcanDetected = 0U;
+static uint8_t FdcanDetectionArmed = 0U;
+
+/* Software receive queue filled from the RX FIFO 0 interrupt */
+static OPENBL_FDCAN_FrameTypeDef a_FdcanRxQueue[FDCAN_RX_QUEUE_SIZE];
+static __IO uint32_t FdcanRxQueueHead = 0U;
+static __IO uint32_t FdcanRxQueueTail = 0U;
+
+/* Number of data bytes for each FDCAN DLC code */
+static const uint8_t a_FdcanDlcToBytes[16] = {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
 
 /* Exported variables --------------------------------------------------------*/
-uint8_t TxData[FDCAN_RAM_BUFFER_SIZE];
-uint8_t RxData[FDCAN_RAM_BUFFER_SIZE];
+uint8_t *TxData;
+uint8_t *RxData;
 
 /* Private function prototypes -----------------------------------------------*/
 static void OPENBL_FDCAN_Init(void);
+static void OPENBL_FDCAN_DrainRxFifo(void);
+static OPENBL_FDCAN_FrameTypeDef *OPENBL_FDCAN_WaitFrame(void);
+static void OPENBL_FDCAN_ReleaseFrame(void);
 
 /* Private functions ---------------------------------------------------------*/
 /**
@@ -105,10 +126,83 @@ static void OPENBL_FDCAN_Init(void)
   TxHeader.TxEventFifoControl  = FDCAN_NO_TX_EVENTS;
   TxHeader.MessageMarker       = 0;
 
+  /* Timestamp the received frames with the internal counter */
+  HAL_FDCAN_ConfigTimestampCounter(&hfdcan, FDCAN_TIMESTAMP_PRESC_1);
+  HAL_FDCAN_EnableTimestampCounter(&hfdcan, FDCAN_TIMESTAMP_INTERNAL);
+
+  /* Drain the RX FIFO 0 into the software queue on each new message */
+  FdcanRxQueueHead = 0U;
+  FdcanRxQueueTail = 0U;
+  HAL_FDCAN_ActivateNotification(&hfdcan, FDCAN_IT_RX_FIFO0_NEW_MESSAGE, 0U);
+
+  NVIC_SetPriority(FDCANx_IT0_IRQ, 5U);
+  NVIC_EnableIRQ(FDCANx_IT0_IRQ);
+
   /* Start the FDCAN module */
   HAL_FDCAN_Start(&hfdcan);
 }
 
+/**
+  * @brief  This function is used to move the messages of the RX FIFO 0 to the software receive queue.
+  *         Messages are left in the hardware FIFO when the software queue is full.
+  * @retval None.
+  */
+static void OPENBL_FDCAN_DrainRxFifo(void)
+{
+  OPENBL_FDCAN_FrameTypeDef *p_frame;
+  uint32_t next_head;
+
+  while (HAL_FDCAN_GetRxFifoFillLevel(&hfdcan, FDCAN_RX_FIFO0) > 0U)
+  {
+    next_head = (FdcanRxQueueHead + 1U) % FDCAN_RX_QUEUE_SIZE;
+
+    if (next_head == FdcanRxQueueTail)
+    {
+      break;
+    }
+
+    p_frame = &a_FdcanRxQueue[FdcanRxQueueHead];
+
+    if (HAL_FDCAN_GetRxMessage(&hfdcan, FDCAN_RX_FIFO0, &RxHeader, p_frame->Data) == HAL_OK)
+    {
+      p_frame->Identifier = RxHeader.Identifier;
+      p_frame->Timestamp  = RxHeader.RxTimestamp;
+      p_frame->Length     = a_FdcanDlcToBytes[RxHeader.DataLength & 0xFU];
+
+      FdcanRxQueueHead = next_head;
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to wait for the oldest frame of the software receive queue.
+  *         The frame stays in the queue until OPENBL_FDCAN_ReleaseFrame is called.
+  * @retval Returns a pointer to the oldest received frame.
+  */
+static OPENBL_FDCAN_FrameTypeDef *OPENBL_FDCAN_WaitFrame(void)
+{
+  while (FdcanRxQueueTail == FdcanRxQueueHead)
+  {
+    /* Recover the messages left in the hardware FIFO while the software queue was full */
+    NVIC_DisableIRQ(FDCANx_IT0_IRQ);
+    OPENBL_FDCAN_DrainRxFifo();
+    NVIC_EnableIRQ(FDCANx_IT0_IRQ);
+
+    OPENBL_IWDG_Refresh();
+  }
+
+  return &a_FdcanRxQueue[FdcanRxQueueTail];
+}
+
+/**
+  * @brief  This function is used to remove the oldest frame from the software receive queue.
+  * @retval None.
+  */
+static void OPENBL_FDCAN_ReleaseFrame(void)
+{
+  FdcanRxQueueTail = (FdcanRxQueueTail + 1U) % FDCAN_RX_QUEUE_SIZE;
+}
+
 /* Exported functions --------------------------------------------------------*/
 
 /**
@@ -121,6 +215,11 @@ void OPENBL_FDCAN_Configuration(void)
   /* Enable used GPIOx clocks */
   FDCANx_GPIO_CLK_ENABLE();
 
+  /* The frame buffers are taken from the arena shared by all the interfaces,
+     FDCAN is the only interface using it before the detection */
+  TxData = OPENBL_GetBuffer(2U * FDCAN_RAM_BUFFER_SIZE);
+  RxData = &TxData[FDCAN_RAM_BUFFER_SIZE];
+
   OPENBL_FDCAN_Init();
 }
 
@@ -130,9 +229,19 @@ void OPENBL_FDCAN_Configuration(void)
   */
 void OPENBL_FDCAN_DeInit(void)
 {
+  /* Release the activity detection pin if the FDCAN has never been initialized */
+  if (FdcanDetectionArmed != 0U)
+  {
+    FdcanDetectionArmed = 0U;
+
+    Common_DisarmActivityDetection(FDCANx_RX_GPIO_PORT, FDCANx_RX_PIN, FDCANx_RX_EXTI_IRQ);
+  }
+
   /* Only de-initialize the FDCAN if it is not the current detected interface */
   if (FdcanDetected == 0U)
   {
+    NVIC_DisableIRQ(FDCANx_IT0_IRQ);
+
     FDCANx_FORCE_RESET();
     FDCANx_RELEASE_RESET();
     HAL_GPIO_DeInit(FDCANx_TX_GPIO_PORT, FDCANx_TX_PIN);
@@ -148,8 +257,8 @@ void OPENBL_FDCAN_DeInit(void)
   */
 uint8_t OPENBL_FDCAN_ProtocolDetection(void)
 {
-  /* check if FIFO 0 receive at least one message */
-  if (HAL_FDCAN_GetRxFifoFillLevel(&hfdcan, FDCAN_RX_FIFO0) > 0)
+  /* check if at least one message has been received */
+  if (OPENBL_FDCAN_GetRxQueueLevel() > 0U)
   {
     FdcanDetected = 1;
   }
@@ -162,32 +271,63 @@ uint8_t OPENBL_FDCAN_ProtocolDetection(void)
 }
 
 /**
-  * @brief  This function is used to get the command opcode from the host.
-  * @retval Returns the command.
+  * @brief  This function is used to arm the FDCAN activity detection without initializing the FDCAN.
+  *         The RX pin is configured as an EXTI falling edge input, so that the FDCAN is only initialized
+  *         once a frame is sent on the bus.
+  * @retval None.
   */
-uint8_t OPENBL_FDCAN_GetCommandOpcode(void)
+void OPENBL_FDCAN_ArmDetection(void)
 {
-  uint8_t command_opc      = 0x0;
-  HAL_StatusTypeDef status = HAL_OK;
+  FDCANx_GPIO_CLK_ENABLE();
 
-  /* check if FIFO 0 receive at least one message */
-  while (HAL_FDCAN_GetRxFifoFillLevel(&hfdcan, FDCAN_RX_FIFO0) < 1)
-  {}
+  Common_ArmActivityDetection(FDCANx_RX_GPIO_PORT, FDCANx_RX_PIN, FDCANx_RX_EXTI_IRQ);
 
-  /* Retrieve Rx messages from RX FIFO0 */
-  status = HAL_FDCAN_GetRxMessage(&hfdcan, FDCAN_RX_FIFO0, &RxHeader, RxData);
+  FdcanDetectionArmed = 1U;
+}
 
-  /* Check for errors */
-  if (status == HAL_ERROR)
+/**
+  * @brief  This function is used to check if there was any activity on the FDCAN RX pin since the detection was armed.
+  *         The RX pin is released when activity is detected, it is then configured by the FDCAN initialization.
+  * @retval Returns 1 if activity is detected else 0.
+  */
+uint8_t OPENBL_FDCAN_ActivityDetected(void)
+{
+  uint8_t activity;
+
+  activity = Common_ActivityDetected(FDCANx_RX_GPIO_PORT, FDCANx_RX_PIN, FDCANx_RX_EXTI_IRQ);
+
+  if (activity != 0U)
   {
-    command_opc = ERROR_COMMAND;
+    FdcanDetectionArmed = 0U;
   }
-  else
+
+  return activity;
+}
+
+/**
+  * @brief  This function is used to get the command opcode from the host.
+  * @retval Returns the command.
+  */
+uint8_t OPENBL_FDCAN_GetCommandOpcode(void)
+{
+  OPENBL_FDCAN_FrameTypeDef *p_frame;
+  uint32_t index;
+  uint8_t command_opc;
+
+  /* Wait for the command frame */
+  p_frame = OPENBL_FDCAN_WaitFrame();
+
+  /* The command parameters are read by the command module from RxData */
+  for (index = 0U; index < p_frame->Length; index++)
   {
-    command_opc         = RxHeader.Identifier;
-    TxHeader.Identifier = RxHeader.Identifier;
+    RxData[index] = p_frame->Data[index];
   }
 
+  command_opc         = (uint8_t)p_frame->Identifier;
+  TxHeader.Identifier = p_frame->Identifier;
+
+  OPENBL_FDCAN_ReleaseFrame();
+
   return command_opc;
 }
 
@@ -199,14 +339,9 @@ uint8_t OPENBL_FDCAN_ReadByte(void)
 {
   uint8_t byte;
 
-  /* check if FIFO 0 receive at least one message */
-  while (HAL_FDCAN_GetRxFifoFillLevel(&hfdcan, FDCAN_RX_FIFO0) < 1)
-  {
-    OPENBL_IWDG_Refresh();
-  }
+  byte = OPENBL_FDCAN_WaitFrame()->Data[0];
 
-  /* Retrieve Rx messages from RX FIFO0 */
-  HAL_FDCAN_GetRxMessage(&hfdcan, FDCAN_RX_FIFO0, &RxHeader, &byte);
+  OPENBL_FDCAN_ReleaseFrame();
 
   return byte;
 }
@@ -217,14 +352,56 @@ uint8_t OPENBL_FDCAN_ReadByte(void)
   */
 void OPENBL_FDCAN_ReadBytes(uint8_t *Buffer, uint32_t BufferSize)
 {
-  /* check if FIFO 0 receive at least one message */
-  while (HAL_FDCAN_GetRxFifoFillLevel(&hfdcan, FDCAN_RX_FIFO0) < 1)
+  OPENBL_FDCAN_FrameTypeDef *p_frame;
+  uint32_t index;
+
+  p_frame = OPENBL_FDCAN_WaitFrame();
+
+  /* Copy the whole frame as done by HAL_FDCAN_GetRxMessage */
+  for (index = 0U; index < p_frame->Length; index++)
   {
-    OPENBL_IWDG_Refresh();
+    Buffer[index] = p_frame->Data[index];
+  }
+
+  OPENBL_FDCAN_ReleaseFrame();
+}
+
+/**
+  * @brief  This function is used to read frames from the FDCAN receive queue until a buffer is filled.
+  *         The padding bytes of the last frame are dropped.
+  * @param  Buffer The buffer that stores the received data.
+  * @param  BufferSize The number of bytes to be read.
+  * @retval Returns the number of bytes stored in the buffer.
+  */
+uint32_t OPENBL_FDCAN_ReadFrames(uint8_t *Buffer, uint32_t BufferSize)
+{
+  OPENBL_FDCAN_FrameTypeDef *p_frame;
+  uint32_t received = 0U;
+  uint32_t index;
+
+  while (received < BufferSize)
+  {
+    p_frame = OPENBL_FDCAN_WaitFrame();
+
+    for (index = 0U; (index < p_frame->Length) && (received < BufferSize); index++)
+    {
+      Buffer[received] = p_frame->Data[index];
+      received++;
+    }
+
+    OPENBL_FDCAN_ReleaseFrame();
   }
 
-  /* Retrieve Rx messages from RX FIFO0 */
-  HAL_FDCAN_GetRxMessage(&hfdcan, FDCAN_RX_FIFO0, &RxHeader, Buffer);
+  return received;
+}
+
+/**
+  * @brief  This function is used to get the number of frames waiting in the FDCAN receive queue.
+  * @retval Returns the number of queued frames.
+  */
+uint32_t OPENBL_FDCAN_GetRxQueueLevel(void)
+{
+  return ((FdcanRxQueueHead + FDCAN_RX_QUEUE_SIZE) - FdcanRxQueueTail) % FDCAN_RX_QUEUE_SIZE;
 }
 
 /**
@@ -306,3 +483,26 @@ void OPENBL_FDCAN_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *Frame)
       break;
   }
 }
+
+/**
+  * @brief  Handle FDCAN interrupt request.
+  * @retval None.
+  */
+void OPENBL_FDCAN_IRQHandler(void)
+{
+  HAL_FDCAN_IRQHandler(&hfdcan);
+}
+
+/**
+  * @brief  Rx FIFO 0 callback, drains the hardware FIFO into the software receive queue.
+  * @param  pFdcan Pointer to the FDCAN handle.
+  * @param  RxFifo0ITs Indicates which Rx FIFO 0 interrupts are signaled.
+  * @retval None.
+  */
+void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *pFdcan, uint32_t RxFifo0ITs)
+{
+  if ((RxFifo0ITs & FDCAN_IT_RX_FIFO0_NEW_MESSAGE) != 0U)
+  {
+    OPENBL_FDCAN_DrainRxFifo();
+  }
+}
@@ -66,8 +66,10 @@ OPENBL_MemoryTypeDef FLASH_Descriptor =
   OPENBL_FLASH_SetReadOutProtectionLevel,
   OPENBL_FLASH_SetWriteProtection,
   OPENBL_FLASH_JumpToAddress,
-  NULL,
-  OPENBL_FLASH_Erase
+  OPENBL_FLASH_MassErase,
+  OPENBL_FLASH_Erase,
+  FLASH_PAGE_SIZE,
+  FLASH_BANK_SIZE
 };
 
 /* Exported functions --------------------------------------------------------*/
@@ -293,7 +295,7 @@ ErrorStatus OPENBL_FLASH_MassErase(uint8_t *p_Data, uint32_t DataLength)
 
     if (bank_option == FLASH_MASS_ERASE)
     {
-      erase_init_struct.Banks = 0U;
+      erase_init_struct.Banks = FLASH_BANK_BOTH;
     }
     else if (bank_option == FLASH_BANK1_ERASE)
     {
@@ -364,12 +366,14 @@ ErrorStatus OPENBL_FLASH_Erase(uint8_t *p_Data, uint32_t DataLength)
   {
     erase_init_struct.Page = ((uint32_t)(*(uint16_t *)(p_Data)));
 
-    if (erase_init_struct.Page <= 127)
+    if (erase_init_struct.Page < (FLASH_BANK_SIZE / FLASH_PAGE_SIZE))
     {
       erase_init_struct.Banks = FLASH_BANK_1;
     }
-    else if (erase_init_struct.Page <= 255)
+    else if (erase_init_struct.Page < (2U * (FLASH_BANK_SIZE / FLASH_PAGE_SIZE)))
     {
+      /* The page number is relative to the bank */
+      erase_init_struct.Page -= (FLASH_BANK_SIZE / FLASH_PAGE_SIZE);
       erase_init_struct.Banks = FLASH_BANK_2;
     }
     else
@@ -747,18 +751,36 @@ __attribute__((section(".ramfunc"))) static HAL_StatusTypeDef OPENBL_FLASH_Exten
     /* Access to SECCR or NSCR registers depends on operation type */
     reg_cr = IS_FLASH_SECURE_OPERATION() ? &(FLASH->SECCR) : &(FLASH_NS->NSCR);
 
-    if (((pEraseInit->Banks) & FLASH_BANK_1) != 0U)
+    if (pEraseInit->TypeErase == FLASH_TYPEERASE_MASSERASE)
     {
-      CLEAR_BIT((*reg_cr), FLASH_NSCR_BKER);
+      /* Select the banks to erase then proceed to the bank or mass erase */
+      if (((pEraseInit->Banks) & FLASH_BANK_1) != 0U)
+      {
+        SET_BIT((*reg_cr), FLASH_NSCR_MER1);
+      }
+
+      if (((pEraseInit->Banks) & FLASH_BANK_2) != 0U)
+      {
+        SET_BIT((*reg_cr), FLASH_NSCR_MER2);
+      }
+
+      SET_BIT((*reg_cr), FLASH_NSCR_STRT);
     }
     else
     {
-      SET_BIT((*reg_cr), FLASH_NSCR_BKER);
-    }
+      if (((pEraseInit->Banks) & FLASH_BANK_1) != 0U)
+      {
+        CLEAR_BIT((*reg_cr), FLASH_NSCR_BKER);
+      }
+      else
+      {
+        SET_BIT((*reg_cr), FLASH_NSCR_BKER);
+      }
 
-    /* Proceed to erase the page */
-    MODIFY_REG((*reg_cr), (FLASH_NSCR_PNB | FLASH_NSCR_PER | FLASH_NSCR_STRT),
-               (((pEraseInit->Page) << FLASH_NSCR_PNB_Pos) | FLASH_NSCR_PER | FLASH_NSCR_STRT));
+      /* Proceed to erase the page */
+      MODIFY_REG((*reg_cr), (FLASH_NSCR_PNB | FLASH_NSCR_PER | FLASH_NSCR_STRT),
+                 (((pEraseInit->Page) << FLASH_NSCR_PNB_Pos) | FLASH_NSCR_PER | FLASH_NSCR_STRT));
+    }
 
     if (Flash_BusyState == FLASH_BUSY_STATE_ENABLED)
     {
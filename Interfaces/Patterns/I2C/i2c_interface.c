@@ -23,6 +23,7 @@
 #include "openbl_i2c_cmd.h"
 #include "i2c_interface.h"
 #include "iwdg_interface.h"
+#include "common_interface.h"
 #include "flash_interface.h"
 
 /* Private typedef -----------------------------------------------------------*/
@@ -30,6 +31,7 @@
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 static uint8_t I2cDetected = 0;
+static uint8_t I2cDetectionArmed = 0U;
 
 /* Exported variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
@@ -97,6 +99,14 @@ void OPENBL_I2C_Configuration(void)
   */
 void OPENBL_I2C_DeInit(void)
 {
+  /* Release the activity detection pin if the I2C has never been initialized */
+  if (I2cDetectionArmed != 0U)
+  {
+    I2cDetectionArmed = 0U;
+
+    Common_DisarmActivityDetection(I2Cx_SCL_PIN_PORT, I2Cx_SCL_PIN, I2Cx_SCL_EXTI_IRQ);
+  }
+
   /* Only de-initialize the I2C if it is not the current detected interface */
   if (I2cDetected == 0U)
   {
@@ -125,6 +135,40 @@ uint8_t OPENBL_I2C_ProtocolDetection(void)
   return I2cDetected;
 }
 
+/**
+  * @brief  This function is used to arm the I2C activity detection without initializing the I2C.
+  *         The SCL pin is configured as an EXTI falling edge input, so that the I2C is only initialized
+  *         once the host starts a transfer.
+  * @retval None.
+  */
+void OPENBL_I2C_ArmDetection(void)
+{
+  I2Cx_GPIO_CLK_ENABLE();
+
+  Common_ArmActivityDetection(I2Cx_SCL_PIN_PORT, I2Cx_SCL_PIN, I2Cx_SCL_EXTI_IRQ);
+
+  I2cDetectionArmed = 1U;
+}
+
+/**
+  * @brief  This function is used to check if there was any activity on the I2C SCL pin since the detection was armed.
+  *         The SCL pin is released when activity is detected, it is then configured by the I2C initialization.
+  * @retval Returns 1 if activity is detected else 0.
+  */
+uint8_t OPENBL_I2C_ActivityDetected(void)
+{
+  uint8_t activity;
+
+  activity = Common_ActivityDetected(I2Cx_SCL_PIN_PORT, I2Cx_SCL_PIN, I2Cx_SCL_EXTI_IRQ);
+
+  if (activity != 0U)
+  {
+    I2cDetectionArmed = 0U;
+  }
+
+  return activity;
+}
+
 /**
   * @brief  This function is used to get the command opcode from the host.
   * @retval Returns the command.
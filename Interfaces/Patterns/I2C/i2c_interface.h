@@ -36,6 +36,8 @@ extern "C" {
 void OPENBL_I2C_Configuration(void);
 void OPENBL_I2C_DeInit(void);
 uint8_t OPENBL_I2C_ProtocolDetection(void);
+void OPENBL_I2C_ArmDetection(void);
+uint8_t OPENBL_I2C_ActivityDetected(void);
 
 uint8_t OPENBL_I2C_GetCommandOpcode(void);
 uint8_t OPENBL_I2C_ReadByte(void);
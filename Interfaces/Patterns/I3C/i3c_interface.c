@@ -25,6 +25,7 @@
 
 #include "i3c_interface.h"
 #include "iwdg_interface.h"
+#include "common_interface.h"
 #include "interfaces_conf.h"
 #include "flash_interface.h"
 
@@ -33,14 +34,19 @@
 #define AVAL_TIMING                     0xFFU
 #define FREE_TIMING                     0x3FU
 #define OPENBL_I3C_SYNC_BYTE            0x5AU
+#define OPENBL_I3C_DMA_MIN_SIZE         16U    /* Shorter transfers are polled, DMA setup is not worth it */
 
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 __IO uint32_t I3cDetected = 0U;
+static uint8_t I3cDetectionArmed = 0U;
 
 /* Exported variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 static void OPENBL_I3C_Init(void);
+static void OPENBL_I3C_DmaInit(void);
+static void OPENBL_I3C_StartDma(uint32_t Channel, uint32_t MemoryAddress, uint32_t Size);
+static void OPENBL_I3C_WaitFrameComplete(void);
 
 /* Private functions ---------------------------------------------------------*/
 
@@ -66,6 +72,12 @@ static void OPENBL_I3C_Init(void)
   /* Configure the Device IBI Payload */
   LL_I3C_SetDeviceIBIPayload(I3Cx, LL_I3C_IBI_ADDITIONAL_DATA);
 
+  /* Advertise the maximum private read/write lengths so that the controller moves a whole
+     bootloader buffer in one SDR transfer. The target is SDR only: the HDR capable bit of
+     the BCR stays cleared, so controllers fall back to SDR for the data phases */
+  LL_I3C_SetMaxReadLength(I3Cx, OPENBL_I3C_MAX_READ_LENGTH);
+  LL_I3C_SetMaxWriteLength(I3Cx, OPENBL_I3C_MAX_WRITE_LENGTH);
+
   /* Enable I3C peripheral */
   LL_I3C_Enable(I3Cx);
 
@@ -74,6 +86,86 @@ static void OPENBL_I3C_Init(void)
 
   NVIC_SetPriority(I3Cx_EV_IRQ, 5U); /* Set priority for I3Cx_EV_IRQ */
   NVIC_EnableIRQ(I3Cx_EV_IRQ);       /* Enable I3Cx_EV_IRQ */
+
+  OPENBL_I3C_DmaInit();
+}
+
+/**
+  * @brief  This function is used to configure the DMA channels used for the I3C data phases.
+  *         Only the memory address and the length are set for each transfer.
+  * @retval None.
+  */
+static void OPENBL_I3C_DmaInit(void)
+{
+  I3Cx_DMA_CLK_ENABLE();
+
+  /* TX channel: memory to I3C transmit data register */
+  LL_DMA_SetPeriphRequest(I3Cx_DMA, I3Cx_DMA_TX_CHANNEL, I3Cx_DMA_TX_REQUEST);
+  LL_DMA_SetDataTransferDirection(I3Cx_DMA, I3Cx_DMA_TX_CHANNEL, LL_DMA_DIRECTION_MEMORY_TO_PERIPH);
+  LL_DMA_SetSrcIncMode(I3Cx_DMA, I3Cx_DMA_TX_CHANNEL, LL_DMA_SRC_INCREMENT);
+  LL_DMA_SetDestIncMode(I3Cx_DMA, I3Cx_DMA_TX_CHANNEL, LL_DMA_DEST_FIXED);
+  LL_DMA_SetSrcDataWidth(I3Cx_DMA, I3Cx_DMA_TX_CHANNEL, LL_DMA_SRC_DATAWIDTH_BYTE);
+  LL_DMA_SetDestDataWidth(I3Cx_DMA, I3Cx_DMA_TX_CHANNEL, LL_DMA_DEST_DATAWIDTH_BYTE);
+  LL_DMA_SetDestAddress(I3Cx_DMA, I3Cx_DMA_TX_CHANNEL,
+                        LL_I3C_DMA_GetRegAddr(I3Cx, LL_I3C_DMA_REG_DATA_TRANSMIT_BYTE));
+
+  /* RX channel: I3C receive data register to memory */
+  LL_DMA_SetPeriphRequest(I3Cx_DMA, I3Cx_DMA_RX_CHANNEL, I3Cx_DMA_RX_REQUEST);
+  LL_DMA_SetDataTransferDirection(I3Cx_DMA, I3Cx_DMA_RX_CHANNEL, LL_DMA_DIRECTION_PERIPH_TO_MEMORY);
+  LL_DMA_SetSrcIncMode(I3Cx_DMA, I3Cx_DMA_RX_CHANNEL, LL_DMA_SRC_FIXED);
+  LL_DMA_SetDestIncMode(I3Cx_DMA, I3Cx_DMA_RX_CHANNEL, LL_DMA_DEST_INCREMENT);
+  LL_DMA_SetSrcDataWidth(I3Cx_DMA, I3Cx_DMA_RX_CHANNEL, LL_DMA_SRC_DATAWIDTH_BYTE);
+  LL_DMA_SetDestDataWidth(I3Cx_DMA, I3Cx_DMA_RX_CHANNEL, LL_DMA_DEST_DATAWIDTH_BYTE);
+  LL_DMA_SetSrcAddress(I3Cx_DMA, I3Cx_DMA_RX_CHANNEL,
+                       LL_I3C_DMA_GetRegAddr(I3Cx, LL_I3C_DMA_REG_DATA_RECEIVE_BYTE));
+}
+
+/**
+  * @brief  This function is used to start a DMA transfer between the I3C data registers and a buffer.
+  * @param  Channel The DMA channel, I3Cx_DMA_TX_CHANNEL or I3Cx_DMA_RX_CHANNEL.
+  * @param  MemoryAddress The address of the buffer.
+  * @param  Size The number of bytes to be transferred.
+  * @retval None.
+  */
+static void OPENBL_I3C_StartDma(uint32_t Channel, uint32_t MemoryAddress, uint32_t Size)
+{
+  if (Channel == I3Cx_DMA_TX_CHANNEL)
+  {
+    LL_DMA_SetSrcAddress(I3Cx_DMA, Channel, MemoryAddress);
+  }
+  else
+  {
+    LL_DMA_SetDestAddress(I3Cx_DMA, Channel, MemoryAddress);
+  }
+
+  LL_DMA_SetBlkDataLength(I3Cx_DMA, Channel, Size);
+  LL_DMA_ClearFlag_TC(I3Cx_DMA, Channel);
+  LL_DMA_EnableChannel(I3Cx_DMA, Channel);
+}
+
+/**
+  * @brief  This function is used to wait the end of the current I3C frame then clear the Frame Complete flag.
+  *         The system is reset if the frame does not complete.
+  * @retval None.
+  */
+static void OPENBL_I3C_WaitFrameComplete(void)
+{
+  uint32_t timeout = OPENBL_I3C_TIMEOUT;
+
+  while (LL_I3C_IsActiveFlag_FC(I3Cx) == 0U)
+  {
+    OPENBL_IWDG_Refresh();
+
+    if (timeout == 0U)
+    {
+      NVIC_SystemReset();
+    }
+
+    timeout--;
+  }
+
+  /* Clear the Frame Complete flag */
+  LL_I3C_ClearFlag_FC(I3Cx);
 }
 
 /* Exported functions --------------------------------------------------------*/
@@ -125,6 +217,14 @@ void OPENBL_I3C_Configuration(void)
   */
 void OPENBL_I3C_DeInit(void)
 {
+  /* Release the activity detection pin if the I3C has never been initialized */
+  if (I3cDetectionArmed != 0U)
+  {
+    I3cDetectionArmed = 0U;
+
+    Common_DisarmActivityDetection(I3Cx_SCL_PORT, I3Cx_SCL_PIN, I3Cx_SCL_EXTI_IRQ);
+  }
+
   /* Only de-initialize the I3C if it is not the current detected interface */
   if (I3cDetected == 0U)
   {
@@ -165,6 +265,40 @@ uint8_t OPENBL_I3C_ProtocolDetection(void)
   return I3cDetected;
 }
 
+/**
+  * @brief  This function is used to arm the I3C activity detection without initializing the I3C.
+  *         The SCL pin is configured as an EXTI falling edge input, so that the I3C is only initialized
+  *         once the controller starts a transfer.
+  * @retval None.
+  */
+void OPENBL_I3C_ArmDetection(void)
+{
+  I3Cx_GPIO_CLK_SCL_ENABLE();
+
+  Common_ArmActivityDetection(I3Cx_SCL_PORT, I3Cx_SCL_PIN, I3Cx_SCL_EXTI_IRQ);
+
+  I3cDetectionArmed = 1U;
+}
+
+/**
+  * @brief  This function is used to check if there was any activity on the I3C SCL pin since the detection was armed.
+  *         The SCL pin is released when activity is detected, it is then configured by the I3C initialization.
+  * @retval Returns 1 if activity is detected else 0.
+  */
+uint8_t OPENBL_I3C_ActivityDetected(void)
+{
+  uint8_t activity;
+
+  activity = Common_ActivityDetected(I3Cx_SCL_PORT, I3Cx_SCL_PIN, I3Cx_SCL_EXTI_IRQ);
+
+  if (activity != 0U)
+  {
+    I3cDetectionArmed = 0U;
+  }
+
+  return activity;
+}
+
 /**
   * @brief  This function is used to get the command opcode from the host.
   * @retval Returns the command opcode value.
@@ -302,6 +436,21 @@ void OPENBL_I3C_SendAcknowledgeByte(uint8_t Acknowledge)
   LL_I3C_ClearFlag_FC(I3Cx);
 }
 
+/**
+  * @brief  This function is used to notify the controller that a long operation is still in progress.
+  *         An IBI with the BUSY_BYTE payload is sent when OPENBL_I3C_PROGRESS_IBI is enabled, the completion
+  *         of the operation is then signaled by the ACK/NACK IBI. Between these IBIs the controller is free
+  *         to use the bus for other targets.
+  * @retval None.
+  */
+void OPENBL_I3C_SendProgress(void)
+{
+  if (OPENBL_I3C_PROGRESS_IBI == 1U)
+  {
+    OPENBL_I3C_SendAcknowledgeByte(BUSY_BYTE);
+  }
+}
+
 /**
   * @brief  This function is used to send a buffer using I3C.
   * @param  pBuffer The buffer that contains the data to be sent.
@@ -316,44 +465,43 @@ void OPENBL_I3C_SendBytes(uint8_t *pBuffer, uint32_t BufferSize)
   /* Configure the preload data to emit into TX FIFO in target mode */
   LL_I3C_ConfigTxPreload(I3Cx, (uint16_t)BufferSize);
 
-  for (count = 0U; count < BufferSize; ++count)
+  if (BufferSize >= OPENBL_I3C_DMA_MIN_SIZE)
   {
-    while (LL_I3C_IsActiveFlag_TXFNF(I3Cx) != 1U)
-    {
-      OPENBL_IWDG_Refresh();
+    /* The DMA feeds the TX FIFO, the frame completes once all the data has been read by the controller */
+    LL_I3C_EnableDMAReq_TX(I3Cx);
+    OPENBL_I3C_StartDma(I3Cx_DMA_TX_CHANNEL, (uint32_t)pBuffer, BufferSize);
 
-      if (timeout == 0U)
-      {
-        NVIC_SystemReset();
-      }
-      else
-      {
-        --timeout;
-      }
-    }
-
-    /* Send one Byte of data */
-    LL_I3C_TransmitData8(I3Cx, pBuffer[count]);
+    OPENBL_I3C_WaitFrameComplete();
 
-    /* Reset timeout value */
-    timeout = OPENBL_I3C_TIMEOUT;
+    LL_I3C_DisableDMAReq_TX(I3Cx);
   }
-
-  /* Wait the end of frame */
-  while (LL_I3C_IsActiveFlag_FC(I3Cx) == 0U)
+  else
   {
-    OPENBL_IWDG_Refresh();
-
-    if (timeout == 0U)
+    for (count = 0U; count < BufferSize; ++count)
     {
-      NVIC_SystemReset();
+      while (LL_I3C_IsActiveFlag_TXFNF(I3Cx) != 1U)
+      {
+        OPENBL_IWDG_Refresh();
+
+        if (timeout == 0U)
+        {
+          NVIC_SystemReset();
+        }
+        else
+        {
+          --timeout;
+        }
+      }
+
+      /* Send one Byte of data */
+      LL_I3C_TransmitData8(I3Cx, pBuffer[count]);
+
+      /* Reset timeout value */
+      timeout = OPENBL_I3C_TIMEOUT;
     }
 
-    timeout--;
+    OPENBL_I3C_WaitFrameComplete();
   }
-
-  /* Clear the Frame Complete flag */
-  LL_I3C_ClearFlag_FC(I3Cx);
 }
 
 /**
@@ -367,13 +515,18 @@ void OPENBL_I3C_ReadBytes(uint8_t *pBuffer, uint32_t BufferSize)
   uint32_t count;
   uint32_t timeout;
 
-  /* Loop until we receive the intended number of bytes */
-  for (count = 0U; count < BufferSize; count++)
+  if (BufferSize >= OPENBL_I3C_DMA_MIN_SIZE)
   {
+    /* The DMA drains the RX FIFO into the buffer until the end of the frame */
+    OPENBL_I3C_StartDma(I3Cx_DMA_RX_CHANNEL, (uint32_t)pBuffer, BufferSize);
+    LL_I3C_EnableDMAReq_RX(I3Cx);
+
+    OPENBL_I3C_WaitFrameComplete();
+
+    /* Wait that the last bytes of the frame have been moved to the buffer */
     timeout = OPENBL_I3C_TIMEOUT;
 
-    /* Wait till Rx flag detection or timeout */
-    while (LL_I3C_IsActiveFlag_RXFNE(I3Cx) != 1U)
+    while (LL_DMA_IsActiveFlag_TC(I3Cx_DMA, I3Cx_DMA_RX_CHANNEL) == 0U)
     {
       OPENBL_IWDG_Refresh();
 
@@ -385,30 +538,34 @@ void OPENBL_I3C_ReadBytes(uint8_t *pBuffer, uint32_t BufferSize)
       timeout--;
     }
 
-    /* Reset the timeout value */
-    timeout = OPENBL_I3C_TIMEOUT;
-
-    /* Rx flag detected */
-    pBuffer[count] = LL_I3C_ReceiveData8(I3Cx);
+    LL_I3C_DisableDMAReq_RX(I3Cx);
   }
-
-  /* Wait the end of frame */
-  while (LL_I3C_IsActiveFlag_FC(I3Cx) == 0U)
+  else
   {
-    OPENBL_IWDG_Refresh();
-
-    if (timeout == 0U)
-    {
-      NVIC_SystemReset();
-    }
-    else
+    /* Loop until we receive the intended number of bytes */
+    for (count = 0U; count < BufferSize; count++)
     {
-      timeout--;
+      timeout = OPENBL_I3C_TIMEOUT;
+
+      /* Wait till Rx flag detection or timeout */
+      while (LL_I3C_IsActiveFlag_RXFNE(I3Cx) != 1U)
+      {
+        OPENBL_IWDG_Refresh();
+
+        if (timeout == 0U)
+        {
+          NVIC_SystemReset();
+        }
+
+        timeout--;
+      }
+
+      /* Rx flag detected */
+      pBuffer[count] = LL_I3C_ReceiveData8(I3Cx);
     }
-  }
 
-  /* Clear the Frame Complete flag */
-  LL_I3C_ClearFlag_FC(I3Cx);
+    OPENBL_I3C_WaitFrameComplete();
+  }
 }
 
 /**
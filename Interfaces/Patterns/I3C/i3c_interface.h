@@ -37,10 +37,13 @@ void OPENBL_I3C_Configuration(void);
 void OPENBL_I3C_DeInit(void);
 
 uint8_t OPENBL_I3C_ProtocolDetection(void);
+void OPENBL_I3C_ArmDetection(void);
+uint8_t OPENBL_I3C_ActivityDetected(void);
 uint8_t OPENBL_I3C_GetCommandOpcode(void);
 uint8_t OPENBL_I3C_ReadByte(void);
 void OPENBL_I3C_SendByte(uint8_t Byte);
 void OPENBL_I3C_SendAcknowledgeByte(uint8_t Acknowledge);
+void OPENBL_I3C_SendProgress(void);
 void OPENBL_I3C_SendBytes(uint8_t *pBuffer, uint32_t BufferSize);
 void OPENBL_I3C_ReadBytes(uint8_t *pBuffer, uint32_t BufferSize);
 
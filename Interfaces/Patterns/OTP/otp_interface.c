@@ -43,7 +43,9 @@ OPENBL_MemoryTypeDef OTP_Descriptor =
   NULL,
   NULL,
   NULL,
-  NULL
+  NULL,
+  0U,
+  0U
 };
 
 /* Exported functions --------------------------------------------------------*/
@@ -42,7 +42,9 @@ OPENBL_MemoryTypeDef RAM_Descriptor =
   NULL,
   OPENBL_RAM_JumpToAddress,
   NULL,
-  NULL
+  NULL,
+  0U,
+  0U
 };
 
 /* Exported functions --------------------------------------------------------*/
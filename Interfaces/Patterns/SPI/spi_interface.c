@@ -23,6 +23,7 @@
 #include "openbl_spi_cmd.h"
 #include "spi_interface.h"
 #include "iwdg_interface.h"
+#include "common_interface.h"
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
@@ -34,6 +35,7 @@
 /* Private variables ---------------------------------------------------------*/
 static __IO uint8_t SpiRxNotEmpty = 0U;
 static uint8_t SpiDetected = 0U;
+static uint8_t SpiDetectionArmed = 0U;
 
 /* Exported variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
@@ -106,7 +108,7 @@ void OPENBL_SPI_Configuration(void)
      +-----+----------+
      | SCK |   PE13   |
      +-----+----------+
-     | NSS |   PA4    |
+     | NSS |   PA15   |
      +-----+----------+ */
 
   GPIO_InitStruct.Mode      = GPIO_MODE_AF_PP;
@@ -139,6 +141,14 @@ void OPENBL_SPI_Configuration(void)
   */
 void OPENBL_SPI_DeInit(void)
 {
+  /* Release the activity detection pin if the SPI has never been initialized */
+  if (SpiDetectionArmed != 0U)
+  {
+    SpiDetectionArmed = 0U;
+
+    Common_DisarmActivityDetection(SPIx_NSS_PIN_PORT, SPIx_NSS_PIN, SPIx_NSS_EXTI_IRQ);
+  }
+
   /* Only de-initialize the SPI if it is not the current detected interface */
   if (SpiDetected == 0U)
   {
@@ -184,6 +194,40 @@ uint8_t OPENBL_SPI_ProtocolDetection(void)
   return SpiDetected;
 }
 
+/**
+  * @brief  This function is used to arm the SPI activity detection without initializing the SPI.
+  *         The NSS pin is configured as an EXTI falling edge input, so that the SPI is only initialized
+  *         once the host selects the device.
+  * @retval None.
+  */
+void OPENBL_SPI_ArmDetection(void)
+{
+  SPIx_GPIO_CLK_ENABLE();
+
+  Common_ArmActivityDetection(SPIx_NSS_PIN_PORT, SPIx_NSS_PIN, SPIx_NSS_EXTI_IRQ);
+
+  SpiDetectionArmed = 1U;
+}
+
+/**
+  * @brief  This function is used to check if there was any activity on the SPI NSS pin since the detection was armed.
+  *         The NSS pin is released when activity is detected, it is then configured by the SPI initialization.
+  * @retval Returns 1 if activity is detected else 0.
+  */
+uint8_t OPENBL_SPI_ActivityDetected(void)
+{
+  uint8_t activity;
+
+  activity = Common_ActivityDetected(SPIx_NSS_PIN_PORT, SPIx_NSS_PIN, SPIx_NSS_EXTI_IRQ);
+
+  if (activity != 0U)
+  {
+    SpiDetectionArmed = 0U;
+  }
+
+  return activity;
+}
+
 /**
   * @brief  This function is used to get the command opcode from the host.
   * @retval Returns the command.
@@ -41,7 +41,9 @@ OPENBL_MemoryTypeDef ICP1_Descriptor =
   NULL,
   NULL,
   NULL,
-  NULL
+  NULL,
+  0U,
+  0U
 };
 
 OPENBL_MemoryTypeDef ICP2_Descriptor =
@@ -56,7 +58,9 @@ OPENBL_MemoryTypeDef ICP2_Descriptor =
   NULL,
   NULL,
   NULL,
-  NULL
+  NULL,
+  0U,
+  0U
 };
 
 /**
@@ -23,6 +23,7 @@
 #include "openbl_usart_cmd.h"
 #include "usart_interface.h"
 #include "iwdg_interface.h"
+#include "common_interface.h"
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
@@ -31,6 +32,7 @@
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 static uint8_t UsartDetected = 0U;
+static uint8_t UsartDetectionArmed = 0U;
 
 /* Exported variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
@@ -108,6 +110,14 @@ void OPENBL_USART_Configuration(void)
   */
 void OPENBL_USART_DeInit(void)
 {
+  /* Release the activity detection pin if the USART has never been initialized */
+  if (UsartDetectionArmed != 0U)
+  {
+    UsartDetectionArmed = 0U;
+
+    Common_DisarmActivityDetection(USARTx_RX_GPIO_PORT, USARTx_RX_PIN, USARTx_RX_EXTI_IRQ);
+  }
+
   /* Only de-initialize the USART if it is not the current detected interface */
   if (UsartDetected == 0U)
   {
@@ -142,6 +152,40 @@ uint8_t OPENBL_USART_ProtocolDetection(void)
   return UsartDetected;
 }
 
+/**
+  * @brief  This function is used to arm the USART activity detection without initializing the USART.
+  *         The RX pin is configured as an EXTI falling edge input, so that the USART is only initialized
+  *         once the host sends the synchronization byte.
+  * @retval None.
+  */
+void OPENBL_USART_ArmDetection(void)
+{
+  USARTx_GPIO_CLK_ENABLE();
+
+  Common_ArmActivityDetection(USARTx_RX_GPIO_PORT, USARTx_RX_PIN, USARTx_RX_EXTI_IRQ);
+
+  UsartDetectionArmed = 1U;
+}
+
+/**
+  * @brief  This function is used to check if there was any activity on the USART RX pin since the detection was armed.
+  *         The RX pin is released when activity is detected, it is then configured by the USART initialization.
+  * @retval Returns 1 if activity is detected else 0.
+  */
+uint8_t OPENBL_USART_ActivityDetected(void)
+{
+  uint8_t activity;
+
+  activity = Common_ActivityDetected(USARTx_RX_GPIO_PORT, USARTx_RX_PIN, USARTx_RX_EXTI_IRQ);
+
+  if (activity != 0U)
+  {
+    UsartDetectionArmed = 0U;
+  }
+
+  return activity;
+}
+
 /**
   * @brief  This function is used to get the command opcode from the host.
   * @retval Returns the command.
@@ -190,6 +234,38 @@ void OPENBL_USART_SendByte(uint8_t Byte)
   }
 }
 
+/**
+  * @brief  This function is used to read bytes from USART pipe.
+  * @param  pBuffer Pointer to the buffer where the read bytes are stored.
+  * @param  BufferSize The number of bytes to be read.
+  * @retval None.
+  */
+void OPENBL_USART_ReadBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+  uint32_t counter;
+
+  for (counter = 0U; counter < BufferSize; counter++)
+  {
+    pBuffer[counter] = OPENBL_USART_ReadByte();
+  }
+}
+
+/**
+  * @brief  This function is used to send bytes through USART pipe.
+  * @param  pBuffer Pointer to the buffer to be sent.
+  * @param  BufferSize The number of bytes to be sent.
+  * @retval None.
+  */
+void OPENBL_USART_SendBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+  uint32_t counter;
+
+  for (counter = 0U; counter < BufferSize; counter++)
+  {
+    OPENBL_USART_SendByte(pBuffer[counter]);
+  }
+}
+
 /**
   * @brief  This function is used to process and execute the special commands.
   *         The user must define the special commands routine here.
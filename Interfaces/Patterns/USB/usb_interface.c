@@ -22,6 +22,7 @@
 #include "app_usbx_device.h"
 #include "app_azure_rtos.h"
 #include "openbl_core.h"
+#include "openbl_usb_cmd.h"
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
@@ -122,8 +123,32 @@ uint32_t OPENBL_USB_GetPage(uint32_t Address)
   else
   {
     /* Bank 2 */
-    page = ((Address - (FLASH_BASE + FLASH_BANK_SIZE)) / FLASH_PAGE_SIZE) + 128U;
+    page = ((Address - (FLASH_BASE + FLASH_BANK_SIZE)) / FLASH_PAGE_SIZE) + (FLASH_BANK_SIZE / FLASH_PAGE_SIZE);
   }
 
   return page;
 }
+
+/**
+  * @brief  This function is used to answer a DFU GETSTATUS request.
+  *         It must be called by the GetStatus callback of the DFU media: one queued block is programmed
+  *         and the time needed by the remaining ones is returned, to be reported as bwPollTimeout.
+  * @retval The poll timeout in milliseconds, 0 when no block is queued.
+  */
+uint32_t OPENBL_USB_DfuGetStatus(void)
+{
+  (void)OPENBL_USB_ProcessPendingWrite();
+
+  return OPENBL_USB_GetPollTimeout();
+}
+
+/**
+  * @brief  This function is used to program the queued blocks when the download ends.
+  *         It must be called by the DFU media on the manifestation (leave request) and by the USB device
+  *         change function on a reset or a detach, otherwise the queued blocks are lost.
+  * @retval None.
+  */
+void OPENBL_USB_DfuEndDownload(void)
+{
+  OPENBL_USB_FlushWrites();
+}
@@ -0,0 +1,275 @@
+/**
+  ******************************************************************************
+  * @file    usb_bulk_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains USB bulk vendor interface HW configuration
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbl_core.h"
+#include "openbl_usb_bulk_cmd.h"
+#include "usb_bulk_interface.h"
+#include "usb_stream_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint8_t UsbBulkDetected = 0U;
+
+/* Byte stream on the bulk vendor interface endpoints */
+static uint8_t UsbBulkRxBuffer[USB_BULK_RX_BUFFER_SIZE];
+static uint8_t UsbBulkRxPacket[USB_BULK_PACKET_SIZE];
+
+static OPENBL_USB_STREAM_HandleTypeDef UsbBulkStream =
+{
+  USB_BULK_OUT_EP,
+  USB_BULK_IN_EP,
+  USB_BULK_PACKET_SIZE,
+  UsbBulkRxBuffer,
+  USB_BULK_RX_BUFFER_SIZE,
+  UsbBulkRxPacket,
+  0U,
+  0U,
+  1U,
+  0U,
+  0U
+};
+
+/* Transmission buffer, the single bytes are gathered and sent in one transfer */
+static uint8_t UsbBulkTxBuffer[USB_BULK_PACKET_SIZE];
+static uint32_t UsbBulkTxCount = 0U;
+
+/* Exported variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to configure the USB bulk vendor interface.
+  *         The USB device and the vendor interface descriptors are set up by the USB device stack
+  *         (see OPENBL_USB_Configuration), the bulk endpoints are opened by OPENBL_USB_BULK_Activate
+  *         once the host configures the device.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_Configuration(void)
+{
+  OPENBL_USB_STREAM_Init(&UsbBulkStream);
+  UsbBulkTxCount = 0U;
+}
+
+/**
+  * @brief  This function is used to De-initialize the USB bulk vendor interface.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_DeInit(void)
+{
+  /* Only de-initialize the USB bulk interface if it is not the current detected interface */
+  if (UsbBulkDetected == 0U)
+  {
+    OPENBL_USB_STREAM_Deactivate(&UsbBulkStream);
+  }
+}
+
+/**
+  * @brief  This function is used to open the bulk endpoints and prime the reception.
+  *         It must be called by the class activate callback of the USB device stack, when the host selects
+  *         the configuration (SET_CONFIGURATION) and again after each bus reset.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_Activate(void)
+{
+  OPENBL_USB_STREAM_Activate(&UsbBulkStream);
+}
+
+/**
+  * @brief  This function is used to close the bulk endpoints.
+  *         It must be called by the class deactivate callback of the USB device stack and on a bus reset.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_Deactivate(void)
+{
+  OPENBL_USB_STREAM_Deactivate(&UsbBulkStream);
+}
+
+/**
+  * @brief  This function is used to detect if there is any activity on USB bulk vendor interface.
+  * @retval Returns 1 if interface is detected else 0.
+  */
+uint8_t OPENBL_USB_BULK_ProtocolDetection(void)
+{
+  /* Check if the host sent the synchronization byte, the bytes received before it are flushed */
+  if (OPENBL_USB_STREAM_ProtocolDetection(&UsbBulkStream) != 0U)
+  {
+    /* Acknowledge the host */
+    OPENBL_USB_BULK_SendByte(ACK_BYTE);
+
+    UsbBulkDetected = 1U;
+  }
+  else
+  {
+    UsbBulkDetected = 0U;
+  }
+
+  return UsbBulkDetected;
+}
+
+/**
+  * @brief  This function is used to get the command opcode from the host.
+  * @retval Returns the command.
+  */
+uint8_t OPENBL_USB_BULK_GetCommandOpcode(void)
+{
+  uint8_t command_opc = 0x0;
+
+  /* Get the command opcode */
+  command_opc = OPENBL_USB_BULK_ReadByte();
+
+  /* Check the data integrity */
+  if ((command_opc ^ OPENBL_USB_BULK_ReadByte()) != 0xFF)
+  {
+    command_opc = ERROR_COMMAND;
+  }
+
+  return command_opc;
+}
+
+/**
+  * @brief  This function is used to read one byte from USB bulk pipe.
+  *         The pending bytes to send are flushed first, as the host waits for them before sending more data.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_USB_BULK_ReadByte(void)
+{
+  OPENBL_USB_BULK_Flush();
+
+  return OPENBL_USB_STREAM_ReadByte(&UsbBulkStream);
+}
+
+/**
+  * @brief  This function is used to read bytes from USB bulk pipe.
+  * @param  pBuffer Pointer to the buffer where the read bytes are stored.
+  * @param  BufferSize The number of bytes to be read.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_ReadBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+  uint32_t counter;
+
+  for (counter = 0U; counter < BufferSize; counter++)
+  {
+    pBuffer[counter] = OPENBL_USB_BULK_ReadByte();
+  }
+}
+
+/**
+  * @brief  This function is used to send one byte through USB bulk pipe.
+  *         The byte is buffered and sent with the next bytes in one transfer.
+  * @param  Byte The byte to be sent.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_SendByte(uint8_t Byte)
+{
+  UsbBulkTxBuffer[UsbBulkTxCount] = Byte;
+  UsbBulkTxCount++;
+
+  if (UsbBulkTxCount == USB_BULK_PACKET_SIZE)
+  {
+    OPENBL_USB_BULK_Flush();
+  }
+}
+
+/**
+  * @brief  This function is used to send a buffer through USB bulk pipe in one transfer.
+  * @param  pBuffer Pointer to the buffer to be sent.
+  * @param  BufferSize The number of bytes to be sent.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_SendBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+  OPENBL_USB_BULK_Flush();
+
+  if (BufferSize != 0U)
+  {
+    OPENBL_USB_STREAM_Transmit(&UsbBulkStream, pBuffer, BufferSize);
+  }
+}
+
+/**
+  * @brief  This function is used to send the buffered bytes through USB bulk pipe.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_Flush(void)
+{
+  if (UsbBulkTxCount != 0U)
+  {
+    OPENBL_USB_STREAM_Transmit(&UsbBulkStream, UsbBulkTxBuffer, UsbBulkTxCount);
+
+    UsbBulkTxCount = 0U;
+  }
+}
+
+/**
+  * @brief  This function is called by the USB device stack when a packet is received on the bulk OUT endpoint.
+  *         The packet is stored in the ring buffer, the reception is paused (the host is NAKed)
+  *         while the ring buffer cannot hold another packet.
+  * @param  Length The number of received bytes.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_RxCpltCallback(uint32_t Length)
+{
+  OPENBL_USB_STREAM_RxCpltCallback(&UsbBulkStream, Length);
+}
+
+/**
+  * @brief  This function is called by the USB device stack when a transfer on the bulk IN endpoint is complete.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_TxCpltCallback(void)
+{
+  OPENBL_USB_STREAM_TxCpltCallback(&UsbBulkStream);
+}
+
+/**
+  * @brief  This function is used to process and execute the special commands.
+  *         The user must define the special commands routine here.
+  * @param  SpecialCmd Pointer to the OPENBL_SpecialCmdTypeDef structure.
+  * @retval Returns NACK status in case of error else returns ACK status.
+  */
+void OPENBL_USB_BULK_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *SpecialCmd)
+{
+  switch (SpecialCmd->OpCode)
+  {
+    /* Unknown command opcode */
+    default:
+      if (SpecialCmd->CmdType == OPENBL_SPECIAL_CMD)
+      {
+        /* Send NULL data size */
+        OPENBL_USB_BULK_SendByte(0x00U);
+        OPENBL_USB_BULK_SendByte(0x00U);
+
+        /* Send NULL status size */
+        OPENBL_USB_BULK_SendByte(0x00U);
+        OPENBL_USB_BULK_SendByte(0x00U);
+      }
+      else if (SpecialCmd->CmdType == OPENBL_EXTENDED_SPECIAL_CMD)
+      {
+        /* Send NULL status size */
+        OPENBL_USB_BULK_SendByte(0x00U);
+        OPENBL_USB_BULK_SendByte(0x00U);
+      }
+      break;
+  }
+}
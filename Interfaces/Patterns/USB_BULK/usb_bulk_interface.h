@@ -0,0 +1,56 @@
+/**
+  ******************************************************************************
+  * @file    usb_bulk_interface.h
+  * @author  MCD Application Team
+  * @brief   Header for usb_bulk_interface.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef USB_BULK_INTERFACE_H
+#define USB_BULK_INTERFACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "openbl_core.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void OPENBL_USB_BULK_Configuration(void);
+void OPENBL_USB_BULK_DeInit(void);
+uint8_t OPENBL_USB_BULK_ProtocolDetection(void);
+void OPENBL_USB_BULK_Activate(void);
+void OPENBL_USB_BULK_Deactivate(void);
+
+uint8_t OPENBL_USB_BULK_GetCommandOpcode(void);
+uint8_t OPENBL_USB_BULK_ReadByte(void);
+void OPENBL_USB_BULK_ReadBytes(uint8_t *pBuffer, uint32_t BufferSize);
+void OPENBL_USB_BULK_SendByte(uint8_t Byte);
+void OPENBL_USB_BULK_SendBytes(uint8_t *pBuffer, uint32_t BufferSize);
+void OPENBL_USB_BULK_Flush(void);
+void OPENBL_USB_BULK_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *SpecialCmd);
+
+void OPENBL_USB_BULK_RxCpltCallback(uint32_t Length);
+void OPENBL_USB_BULK_TxCpltCallback(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* USB_BULK_INTERFACE_H */
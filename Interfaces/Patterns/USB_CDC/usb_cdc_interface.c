@@ -0,0 +1,262 @@
+/**
+  ******************************************************************************
+  * @file    usb_cdc_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains USB CDC-ACM interface HW configuration
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbl_core.h"
+#include "openbl_usart_cmd.h"
+#include "usb_cdc_interface.h"
+#include "usb_stream_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint8_t UsbCdcDetected = 0U;
+
+/* Byte stream on the CDC data interface endpoints */
+static uint8_t UsbCdcRxBuffer[USB_CDC_RX_BUFFER_SIZE];
+static uint8_t UsbCdcRxPacket[USB_CDC_PACKET_SIZE];
+
+static OPENBL_USB_STREAM_HandleTypeDef UsbCdcStream =
+{
+  USB_CDC_OUT_EP,
+  USB_CDC_IN_EP,
+  USB_CDC_PACKET_SIZE,
+  UsbCdcRxBuffer,
+  USB_CDC_RX_BUFFER_SIZE,
+  UsbCdcRxPacket,
+  0U,
+  0U,
+  1U,
+  0U,
+  0U
+};
+
+static uint8_t UsbCdcTxByte;
+
+/* Serial transport used by the USART commands once the CDC interface is detected */
+static const OPENBL_USART_TransportTypeDef UsbCdcTransport =
+{
+  OPENBL_USB_CDC_ReadBytes,
+  OPENBL_USB_CDC_SendBytes,
+  OPENBL_USB_CDC_SendByte,
+  NULL,
+  OPENBL_USB_CDC_SpecialCommandProcess,
+  NULL
+};
+
+/* Exported variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to configure the USB CDC-ACM interface.
+  *         The USB device, the CDC-ACM descriptors and class requests (line coding...) are handled by
+  *         the USB device stack (see OPENBL_USB_Configuration), the data endpoints are opened by
+  *         OPENBL_USB_CDC_Activate once the host configures the device.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_Configuration(void)
+{
+  OPENBL_USB_STREAM_Init(&UsbCdcStream);
+}
+
+/**
+  * @brief  This function is used to De-initialize the USB CDC-ACM interface.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_DeInit(void)
+{
+  /* Only de-initialize the USB CDC interface if it is not the current detected interface */
+  if (UsbCdcDetected == 0U)
+  {
+    OPENBL_USB_STREAM_Deactivate(&UsbCdcStream);
+  }
+}
+
+/**
+  * @brief  This function is used to open the CDC data endpoints and prime the reception.
+  *         It must be called by the class activate callback of the USB device stack, when the host selects
+  *         the configuration (SET_CONFIGURATION) and again after each bus reset.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_Activate(void)
+{
+  OPENBL_USB_STREAM_Activate(&UsbCdcStream);
+}
+
+/**
+  * @brief  This function is used to close the CDC data endpoints.
+  *         It must be called by the class deactivate callback of the USB device stack and on a bus reset.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_Deactivate(void)
+{
+  OPENBL_USB_STREAM_Deactivate(&UsbCdcStream);
+}
+
+/**
+  * @brief  This function is used to detect if there is any activity on USB CDC-ACM interface.
+  * @retval Returns 1 if interface is detected else 0.
+  */
+uint8_t OPENBL_USB_CDC_ProtocolDetection(void)
+{
+  /* Check if the host sent the synchronization byte, the bytes received before it are flushed */
+  if (OPENBL_USB_STREAM_ProtocolDetection(&UsbCdcStream) != 0U)
+  {
+    /* The USART commands are executed over the CDC interface */
+    OPENBL_USART_SetTransport(&UsbCdcTransport);
+
+    /* Acknowledge the host */
+    OPENBL_USB_CDC_SendByte(ACK_BYTE);
+
+    UsbCdcDetected = 1U;
+  }
+  else
+  {
+    UsbCdcDetected = 0U;
+  }
+
+  return UsbCdcDetected;
+}
+
+/**
+  * @brief  This function is used to get the command opcode from the host.
+  * @retval Returns the command.
+  */
+uint8_t OPENBL_USB_CDC_GetCommandOpcode(void)
+{
+  uint8_t command_opc = 0x0;
+
+  /* Get the command opcode */
+  command_opc = OPENBL_USB_CDC_ReadByte();
+
+  /* Check the data integrity */
+  if ((command_opc ^ OPENBL_USB_CDC_ReadByte()) != 0xFF)
+  {
+    command_opc = ERROR_COMMAND;
+  }
+
+  return command_opc;
+}
+
+/**
+  * @brief  This function is used to read one byte from USB CDC pipe.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_USB_CDC_ReadByte(void)
+{
+  return OPENBL_USB_STREAM_ReadByte(&UsbCdcStream);
+}
+
+/**
+  * @brief  This function is used to read bytes from USB CDC pipe.
+  * @param  pBuffer Pointer to the buffer where the read bytes are stored.
+  * @param  BufferSize The number of bytes to be read.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_ReadBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+  uint32_t counter;
+
+  for (counter = 0U; counter < BufferSize; counter++)
+  {
+    pBuffer[counter] = OPENBL_USB_CDC_ReadByte();
+  }
+}
+
+/**
+  * @brief  This function is used to send one byte through USB CDC pipe.
+  * @param  Byte The byte to be sent.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_SendByte(uint8_t Byte)
+{
+  UsbCdcTxByte = Byte;
+
+  OPENBL_USB_STREAM_Transmit(&UsbCdcStream, &UsbCdcTxByte, 1U);
+}
+
+/**
+  * @brief  This function is used to send a buffer through USB CDC pipe in one transfer.
+  * @param  pBuffer Pointer to the buffer to be sent.
+  * @param  BufferSize The number of bytes to be sent.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_SendBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+  if (BufferSize != 0U)
+  {
+    OPENBL_USB_STREAM_Transmit(&UsbCdcStream, pBuffer, BufferSize);
+  }
+}
+
+/**
+  * @brief  This function is called by the USB device stack when a packet is received on the CDC data OUT endpoint.
+  *         The packet is stored in the ring buffer, the reception is paused (the host is NAKed)
+  *         while the ring buffer cannot hold another packet.
+  * @param  Length The number of received bytes.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_RxCpltCallback(uint32_t Length)
+{
+  OPENBL_USB_STREAM_RxCpltCallback(&UsbCdcStream, Length);
+}
+
+/**
+  * @brief  This function is called by the USB device stack when a transfer on the CDC data IN endpoint is complete.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_TxCpltCallback(void)
+{
+  OPENBL_USB_STREAM_TxCpltCallback(&UsbCdcStream);
+}
+
+/**
+  * @brief  This function is used to process and execute the special commands.
+  *         The user must define the special commands routine here.
+  * @param  SpecialCmd Pointer to the OPENBL_SpecialCmdTypeDef structure.
+  * @retval Returns NACK status in case of error else returns ACK status.
+  */
+void OPENBL_USB_CDC_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *SpecialCmd)
+{
+  switch (SpecialCmd->OpCode)
+  {
+    /* Unknown command opcode */
+    default:
+      if (SpecialCmd->CmdType == OPENBL_SPECIAL_CMD)
+      {
+        /* Send NULL data size */
+        OPENBL_USB_CDC_SendByte(0x00U);
+        OPENBL_USB_CDC_SendByte(0x00U);
+
+        /* Send NULL status size */
+        OPENBL_USB_CDC_SendByte(0x00U);
+        OPENBL_USB_CDC_SendByte(0x00U);
+      }
+      else if (SpecialCmd->CmdType == OPENBL_EXTENDED_SPECIAL_CMD)
+      {
+        /* Send NULL status size */
+        OPENBL_USB_CDC_SendByte(0x00U);
+        OPENBL_USB_CDC_SendByte(0x00U);
+      }
+      break;
+  }
+}
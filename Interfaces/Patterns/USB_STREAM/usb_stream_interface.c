@@ -0,0 +1,228 @@
+/**
+  ******************************************************************************
+  * @file    usb_stream_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains the byte stream shared by the USB bulk and CDC-ACM interfaces
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "usb_stream_interface.h"
+#include "iwdg_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define USB_STREAM_SYNC_BYTE              0x7FU   /* Synchronization byte sent by the host to select the interface */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* External variables --------------------------------------------------------*/
+extern PCD_HandleTypeDef hpcd_USB_OTG_FS;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t OPENBL_USB_STREAM_RxFreeSpace(const OPENBL_USB_STREAM_HandleTypeDef *pStream);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to get the free space of the reception ring buffer.
+  * @param  pStream Pointer to the byte stream handle.
+  * @retval Returns the number of bytes that can be received.
+  */
+static uint32_t OPENBL_USB_STREAM_RxFreeSpace(const OPENBL_USB_STREAM_HandleTypeDef *pStream)
+{
+  return (pStream->RxBufferSize - 1U) - ((pStream->RxHead + pStream->RxBufferSize - pStream->RxTail)
+                                         % pStream->RxBufferSize);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to initialize the byte stream state.
+  *         The endpoints are only opened once the host configures the device, see OPENBL_USB_STREAM_Activate.
+  * @param  pStream Pointer to the byte stream handle.
+  * @retval None.
+  */
+void OPENBL_USB_STREAM_Init(OPENBL_USB_STREAM_HandleTypeDef *pStream)
+{
+  pStream->RxHead   = 0U;
+  pStream->RxTail   = 0U;
+  pStream->RxPaused = 1U;
+  pStream->TxBusy   = 0U;
+  pStream->Active   = 0U;
+}
+
+/**
+  * @brief  This function is used to open the endpoints and prime the reception of the first packet.
+  *         It is called when the host selects the configuration (SET_CONFIGURATION), including the one
+  *         following each bus reset, the bytes received before are dropped.
+  * @param  pStream Pointer to the byte stream handle.
+  * @retval None.
+  */
+void OPENBL_USB_STREAM_Activate(OPENBL_USB_STREAM_HandleTypeDef *pStream)
+{
+  pStream->RxHead   = 0U;
+  pStream->RxTail   = 0U;
+  pStream->RxPaused = 0U;
+  pStream->TxBusy   = 0U;
+
+  (void)HAL_PCD_EP_Open(&hpcd_USB_OTG_FS, pStream->OutEp, (uint16_t)pStream->PacketSize, EP_TYPE_BULK);
+  (void)HAL_PCD_EP_Open(&hpcd_USB_OTG_FS, pStream->InEp, (uint16_t)pStream->PacketSize, EP_TYPE_BULK);
+
+  pStream->Active = 1U;
+
+  /* Start the reception of the first packet */
+  (void)HAL_PCD_EP_Receive(&hpcd_USB_OTG_FS, pStream->OutEp, pStream->pRxPacket, pStream->PacketSize);
+}
+
+/**
+  * @brief  This function is used to close the endpoints.
+  *         It is called when the configuration is left and on a bus reset, a pending transmission is
+  *         released so that the caller does not wait for a transfer that never completes.
+  * @param  pStream Pointer to the byte stream handle.
+  * @retval None.
+  */
+void OPENBL_USB_STREAM_Deactivate(OPENBL_USB_STREAM_HandleTypeDef *pStream)
+{
+  pStream->Active   = 0U;
+  pStream->RxPaused = 1U;
+  pStream->TxBusy   = 0U;
+
+  (void)HAL_PCD_EP_Close(&hpcd_USB_OTG_FS, pStream->OutEp);
+  (void)HAL_PCD_EP_Close(&hpcd_USB_OTG_FS, pStream->InEp);
+}
+
+/**
+  * @brief  This function is used to detect if the host sent the synchronization byte.
+  *         As on the USART, the bytes received before the synchronization byte are discarded.
+  * @param  pStream Pointer to the byte stream handle.
+  * @retval Returns 1 if the synchronization byte has been received (and flushed) else 0.
+  */
+uint8_t OPENBL_USB_STREAM_ProtocolDetection(OPENBL_USB_STREAM_HandleTypeDef *pStream)
+{
+  uint8_t detected = 0U;
+
+  while ((detected == 0U) && (pStream->RxHead != pStream->RxTail))
+  {
+    if (OPENBL_USB_STREAM_ReadByte(pStream) == USB_STREAM_SYNC_BYTE)
+    {
+      detected = 1U;
+    }
+  }
+
+  return detected;
+}
+
+/**
+  * @brief  This function is used to read one byte from the reception ring buffer.
+  *         The reception is restarted once the ring buffer can hold a full packet again.
+  * @param  pStream Pointer to the byte stream handle.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_USB_STREAM_ReadByte(OPENBL_USB_STREAM_HandleTypeDef *pStream)
+{
+  uint8_t byte;
+
+  while (pStream->RxHead == pStream->RxTail)
+  {
+    OPENBL_IWDG_Refresh();
+  }
+
+  byte            = pStream->pRxBuffer[pStream->RxTail];
+  pStream->RxTail = (pStream->RxTail + 1U) % pStream->RxBufferSize;
+
+  if ((pStream->RxPaused != 0U) && (pStream->Active != 0U)
+      && (OPENBL_USB_STREAM_RxFreeSpace(pStream) >= pStream->PacketSize))
+  {
+    pStream->RxPaused = 0U;
+
+    (void)HAL_PCD_EP_Receive(&hpcd_USB_OTG_FS, pStream->OutEp, pStream->pRxPacket, pStream->PacketSize);
+  }
+
+  return byte;
+}
+
+/**
+  * @brief  This function is used to send a buffer on the IN endpoint and wait for its completion.
+  *         A zero length packet terminates the transfers that are a multiple of the packet size.
+  * @param  pStream Pointer to the byte stream handle.
+  * @param  pBuffer Pointer to the buffer to be sent.
+  * @param  BufferSize The number of bytes to be sent.
+  * @retval None.
+  */
+void OPENBL_USB_STREAM_Transmit(OPENBL_USB_STREAM_HandleTypeDef *pStream, uint8_t *pBuffer, uint32_t BufferSize)
+{
+  if (pStream->Active != 0U)
+  {
+    pStream->TxBusy = 1U;
+
+    (void)HAL_PCD_EP_Transmit(&hpcd_USB_OTG_FS, pStream->InEp, pBuffer, BufferSize);
+
+    while (pStream->TxBusy != 0U)
+    {
+      OPENBL_IWDG_Refresh();
+    }
+
+    if (((BufferSize % pStream->PacketSize) == 0U) && (pStream->Active != 0U))
+    {
+      pStream->TxBusy = 1U;
+
+      (void)HAL_PCD_EP_Transmit(&hpcd_USB_OTG_FS, pStream->InEp, NULL, 0U);
+
+      while (pStream->TxBusy != 0U)
+      {
+        OPENBL_IWDG_Refresh();
+      }
+    }
+  }
+}
+
+/**
+  * @brief  This function is called by the USB device stack when a packet is received on the OUT endpoint.
+  *         The packet is stored in the ring buffer, the reception is paused (the host is NAKed)
+  *         while the ring buffer cannot hold another packet.
+  * @param  pStream Pointer to the byte stream handle.
+  * @param  Length The number of received bytes.
+  * @retval None.
+  */
+void OPENBL_USB_STREAM_RxCpltCallback(OPENBL_USB_STREAM_HandleTypeDef *pStream, uint32_t Length)
+{
+  uint32_t counter;
+
+  for (counter = 0U; counter < Length; counter++)
+  {
+    pStream->pRxBuffer[pStream->RxHead] = pStream->pRxPacket[counter];
+    pStream->RxHead                     = (pStream->RxHead + 1U) % pStream->RxBufferSize;
+  }
+
+  if (OPENBL_USB_STREAM_RxFreeSpace(pStream) >= pStream->PacketSize)
+  {
+    (void)HAL_PCD_EP_Receive(&hpcd_USB_OTG_FS, pStream->OutEp, pStream->pRxPacket, pStream->PacketSize);
+  }
+  else
+  {
+    pStream->RxPaused = 1U;
+  }
+}
+
+/**
+  * @brief  This function is called by the USB device stack when a transfer on the IN endpoint is complete.
+  * @param  pStream Pointer to the byte stream handle.
+  * @retval None.
+  */
+void OPENBL_USB_STREAM_TxCpltCallback(OPENBL_USB_STREAM_HandleTypeDef *pStream)
+{
+  pStream->TxBusy = 0U;
+}
@@ -57,6 +57,52 @@ void Common_DisableIrq(void)
 {
 }
 
+/**
+  * @brief  Enter sleep mode until the next interrupt.
+  * @retval None.
+  */
+void Common_WaitForInterrupt(void)
+{
+}
+
+/**
+  * @brief  Start the cycle counter used for the statistics.
+  * @retval None.
+  */
+void Common_StartCycleCounter(void)
+{
+}
+
+/**
+  * @brief  Return the current value of the cycle counter.
+  * @retval The cycle count.
+  */
+uint32_t Common_GetCycleCount(void)
+{
+  return 0U;
+}
+
+/**
+  * @brief  Return the frequency of the cycle counter.
+  * @retval The frequency in Hz.
+  */
+uint32_t Common_GetCycleFrequency(void)
+{
+  return 0U;
+}
+
+/**
+  * @brief  Compute with the CRC unit the CRC-32 (IEEE 802.3) of a Flash or RAM region.
+  * @param  Crc The CRC of the previous regions, 0 for the first one.
+  * @param  Address The start address of the region.
+  * @param  Length The number of bytes of the region.
+  * @retval The updated CRC.
+  */
+uint32_t Common_ComputeCrc32(uint32_t Crc, uint32_t Address, uint32_t Length)
+{
+  return 0U;
+}
+
 /**
   * @brief  Checks whether the target Protection Status is set or not.
   * @retval Returns SET if protection is enabled else return RESET.
@@ -84,3 +130,83 @@ void Common_SetPostProcessingCallback(Function_Pointer Callback)
 void Common_StartPostProcessing()
 {
 }
+
+/**
+  * @brief  Return the identifier of this node, used to address it when several devices share the same bus.
+  * @retval The node identifier.
+  */
+uint32_t Common_GetNodeId(void)
+{
+  return 0U;
+}
+
+/**
+  * @brief  Check whether the application requested to stay in the bootloader before its last reset.
+  * @retval Returns SET if the bootloader is requested else return RESET.
+  */
+FlagStatus Common_GetBootRequest(void)
+{
+  return RESET;
+}
+
+/**
+  * @brief  Read a word of the Flash, used before the memories are registered.
+  * @param  Address The address of the word.
+  * @retval The word.
+  */
+uint32_t Common_ReadWord(uint32_t Address)
+{
+  return 0U;
+}
+
+/**
+  * @brief  Start the application without going through the memory interfaces, nothing is initialized yet.
+  * @param  Address The address of the application vector table.
+  * @retval None.
+  */
+void Common_JumpToApplication(uint32_t Address)
+{
+}
+
+/**
+  * @brief  Arm the activity detection on the pin of an interface which is not initialized (lazy init).
+  * @param  pPort The GPIO port of the pin, its clock must be enabled.
+  * @param  Pin The GPIO pin.
+  * @param  IRQn The EXTI interrupt of the pin.
+  * @retval None.
+  */
+void Common_ArmActivityDetection(GPIO_TypeDef *pPort, uint32_t Pin, IRQn_Type IRQn)
+{
+}
+
+/**
+  * @brief  Release the activity detection pin and its EXTI interrupt.
+  * @param  pPort The GPIO port of the pin.
+  * @param  Pin The GPIO pin.
+  * @param  IRQn The EXTI interrupt of the pin.
+  * @retval None.
+  */
+void Common_DisarmActivityDetection(GPIO_TypeDef *pPort, uint32_t Pin, IRQn_Type IRQn)
+{
+}
+
+/**
+  * @brief  Check if there was any activity on a detection pin since it was armed.
+  * @param  pPort The GPIO port of the pin.
+  * @param  Pin The GPIO pin.
+  * @param  IRQn The EXTI interrupt of the pin.
+  * @retval Returns 1 if activity is detected else 0.
+  */
+uint8_t Common_ActivityDetected(GPIO_TypeDef *pPort, uint32_t Pin, IRQn_Type IRQn)
+{
+  return 0U;
+}
+
+/**
+  * @brief  Report the activity on a detection pin.
+  * @param  Pin The GPIO pin.
+  * @retval None.
+  */
+void Common_ActivityCallback(uint32_t Pin)
+{
+}
@@ -37,6 +37,19 @@ void Common_DisableIrq(void);
 FlagStatus Common_GetProtectionStatus(void);
 void Common_SetPostProcessingCallback(Function_Pointer Callback);
 void Common_StartPostProcessing(void);
+uint32_t Common_GetNodeId(void);
+FlagStatus Common_GetBootRequest(void);
+uint32_t Common_ReadWord(uint32_t Address);
+void Common_JumpToApplication(uint32_t Address);
+void Common_WaitForInterrupt(void);
+void Common_StartCycleCounter(void);
+uint32_t Common_GetCycleCount(void);
+uint32_t Common_GetCycleFrequency(void);
+uint32_t Common_ComputeCrc32(uint32_t Crc, uint32_t Address, uint32_t Length);
+void Common_ArmActivityDetection(GPIO_TypeDef *pPort, uint32_t Pin, IRQn_Type IRQn);
+void Common_DisarmActivityDetection(GPIO_TypeDef *pPort, uint32_t Pin, IRQn_Type IRQn);
+uint8_t Common_ActivityDetected(GPIO_TypeDef *pPort, uint32_t Pin, IRQn_Type IRQn);
+void Common_ActivityCallback(uint32_t Pin);
 
 #ifdef __cplusplus
 }
@@ -35,8 +35,8 @@ static FDCAN_RxHeaderTypeDef RxHeader;
 static uint8_t FdcanDetected = 0U;
 
 /* Exported variables --------------------------------------------------------*/
-uint8_t TxData[FDCAN_RAM_BUFFER_SIZE];
-uint8_t RxData[FDCAN_RAM_BUFFER_SIZE];
+uint8_t *TxData;
+uint8_t *RxData;
 
 /* Private function prototypes -----------------------------------------------*/
 static void OPENBL_FDCAN_Init(void);
@@ -58,6 +58,8 @@ static void OPENBL_FDCAN_Init(void)
   */
 void OPENBL_FDCAN_Configuration(void)
 {
+  TxData = OPENBL_GetBuffer(2U * FDCAN_RAM_BUFFER_SIZE);
+  RxData = &TxData[FDCAN_RAM_BUFFER_SIZE];
 }
 
 /**
@@ -77,6 +79,23 @@ uint8_t OPENBL_FDCAN_ProtocolDetection(void)
   return FdcanDetected;
 }
 
+/**
+  * @brief  This function is used to arm the FDCAN activity detection without initializing the FDCAN.
+  * @retval None.
+  */
+void OPENBL_FDCAN_ArmDetection(void)
+{
+}
+
+/**
+  * @brief  This function is used to check if there was any activity on the FDCAN RX pin since the detection was armed.
+  * @retval Returns 1 if activity is detected else 0.
+  */
+uint8_t OPENBL_FDCAN_ActivityDetected(void)
+{
+  return 0U;
+}
+
 /**
   * @brief  This function is used to get the command opcode from the host.
   * @retval Returns the command.
@@ -126,6 +145,26 @@ void OPENBL_FDCAN_SendBytes(uint8_t *Buffer, uint32_t BufferSize)
 {
 }
 
+/**
+  * @brief  This function is used to read frames from the FDCAN receive queue until a buffer is filled.
+  * @param  Buffer The buffer that stores the received data.
+  * @param  BufferSize The number of bytes to be read.
+  * @retval Returns the number of bytes stored in the buffer.
+  */
+uint32_t OPENBL_FDCAN_ReadFrames(uint8_t *Buffer, uint32_t BufferSize)
+{
+  return 0U;
+}
+
+/**
+  * @brief  This function is used to get the number of frames waiting in the FDCAN receive queue.
+  * @retval Returns the number of queued frames.
+  */
+uint32_t OPENBL_FDCAN_GetRxQueueLevel(void)
+{
+  return 0U;
+}
+
 /**
   * @brief  This function is used to process and execute the special commands.
   *         The user must define the special commands routine here.
@@ -134,3 +173,11 @@ void OPENBL_FDCAN_SendBytes(uint8_t *Buffer, uint32_t BufferSize)
 void OPENBL_FDCAN_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *Frame)
 {
 }
+
+/**
+  * @brief  Handle FDCAN interrupt request.
+  * @retval None.
+  */
+void OPENBL_FDCAN_IRQHandler(void)
+{
+}
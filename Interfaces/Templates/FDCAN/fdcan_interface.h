@@ -35,14 +35,20 @@ extern "C" {
 void OPENBL_FDCAN_Configuration(void);
 void OPENBL_FDCAN_DeInit(void);
 uint8_t OPENBL_FDCAN_ProtocolDetection(void);
+void OPENBL_FDCAN_ArmDetection(void);
+uint8_t OPENBL_FDCAN_ActivityDetected(void);
 
 uint8_t OPENBL_FDCAN_GetCommandOpcode(void);
 uint8_t OPENBL_FDCAN_ReadByte(void);
 void OPENBL_FDCAN_ReadBytes(uint8_t *Buffer, uint32_t BufferSize);
 void OPENBL_FDCAN_SendByte(uint8_t Byte);
 void OPENBL_FDCAN_SendBytes(uint8_t *Buffer, uint32_t BufferSize);
+uint32_t OPENBL_FDCAN_ReadFrames(uint8_t *Buffer, uint32_t BufferSize);
+uint32_t OPENBL_FDCAN_GetRxQueueLevel(void);
 void OPENBL_FDCAN_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *Frame);
 
+void OPENBL_FDCAN_IRQHandler(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -66,8 +66,10 @@ OPENBL_MemoryTypeDef FLASH_Descriptor =
   OPENBL_FLASH_SetReadOutProtectionLevel,
   OPENBL_FLASH_SetWriteProtection,
   OPENBL_FLASH_JumpToAddress,
-  NULL,
-  OPENBL_FLASH_Erase
+  OPENBL_FLASH_MassErase,
+  OPENBL_FLASH_Erase,
+  FLASH_PAGE_SIZE,
+  FLASH_BANK_SIZE
 };
 
 /* Exported functions --------------------------------------------------------*/
@@ -72,6 +72,23 @@ uint8_t OPENBL_I2C_ProtocolDetection(void)
   return I2cDetected;
 }
 
+/**
+  * @brief  This function is used to arm the I2C activity detection without initializing the I2C.
+  * @retval None.
+  */
+void OPENBL_I2C_ArmDetection(void)
+{
+}
+
+/**
+  * @brief  This function is used to check if there was any activity on the I2C SCL pin since the detection was armed.
+  * @retval Returns 1 if activity is detected else 0.
+  */
+uint8_t OPENBL_I2C_ActivityDetected(void)
+{
+  return 0U;
+}
+
 /**
   * @brief  This function is used to get the command opcode from the host.
   * @retval Returns the command.
@@ -79,6 +79,23 @@ uint8_t OPENBL_I3C_ProtocolDetection(void)
   return I3cDetected;
 }
 
+/**
+  * @brief  This function is used to arm the I3C activity detection without initializing the I3C.
+  * @retval None.
+  */
+void OPENBL_I3C_ArmDetection(void)
+{
+}
+
+/**
+  * @brief  This function is used to check if there was any activity on the I3C SCL pin since the detection was armed.
+  * @retval Returns 1 if activity is detected else 0.
+  */
+uint8_t OPENBL_I3C_ActivityDetected(void)
+{
+  return 0U;
+}
+
 /**
   * @brief  This function is used to get the command opcode from the host.
   * @retval Returns the command opcode value.
@@ -114,6 +131,14 @@ void OPENBL_I3C_SendAcknowledgeByte(uint8_t Acknowledge)
 {
 }
 
+/**
+  * @brief  This function is used to notify the controller that a long operation is still in progress.
+  * @retval None.
+  */
+void OPENBL_I3C_SendProgress(void)
+{
+}
+
 /**
   * @brief  This function is used to send a buffer using I3C.
   * @param  pBuffer The buffer that contains the data to be sent.
@@ -41,7 +41,9 @@ OPENBL_MemoryTypeDef OB_Descriptor =
   NULL,
   NULL,
   NULL,
-  NULL
+  NULL,
+  0U,
+  0U
 };
 
 /* Exported functions --------------------------------------------------------*/
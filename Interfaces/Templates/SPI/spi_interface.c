@@ -81,6 +81,23 @@ uint8_t OPENBL_SPI_ProtocolDetection(void)
   return SpiDetected;
 }
 
+/**
+  * @brief  This function is used to arm the SPI activity detection without initializing the SPI.
+  * @retval None.
+  */
+void OPENBL_SPI_ArmDetection(void)
+{
+}
+
+/**
+  * @brief  This function is used to check if there was any activity on the SPI NSS pin since the detection was armed.
+  * @retval Returns 1 if activity is detected else 0.
+  */
+uint8_t OPENBL_SPI_ActivityDetected(void)
+{
+  return 0U;
+}
+
 /**
   * @brief  This function is used to get the command opcode from the host.
   * @retval Returns the command.
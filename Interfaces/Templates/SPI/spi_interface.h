@@ -35,6 +35,8 @@ extern "C" {
 void OPENBL_SPI_Configuration(void);
 void OPENBL_SPI_DeInit(void);
 uint8_t OPENBL_SPI_ProtocolDetection(void);
+void OPENBL_SPI_ArmDetection(void);
+uint8_t OPENBL_SPI_ActivityDetected(void);
 uint8_t OPENBL_SPI_GetCommandOpcode(void);
 void OPENBL_SPI_SendAcknowledgeByte(uint8_t Byte);
 void OPENBL_SPI_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *SpecialCmd);
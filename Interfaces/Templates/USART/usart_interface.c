@@ -71,6 +71,23 @@ uint8_t OPENBL_USART_ProtocolDetection(void)
   return UsartDetected;
 }
 
+/**
+  * @brief  This function is used to arm the USART activity detection without initializing the USART.
+  * @retval None.
+  */
+void OPENBL_USART_ArmDetection(void)
+{
+}
+
+/**
+  * @brief  This function is used to check if there was any activity on the USART RX pin since the detection was armed.
+  * @retval Returns 1 if activity is detected else 0.
+  */
+uint8_t OPENBL_USART_ActivityDetected(void)
+{
+  return 0U;
+}
+
 /**
   * @brief  This function is used to get the command opcode from the host.
   * @retval Returns the command.
@@ -100,6 +117,26 @@ void OPENBL_USART_SendByte(uint8_t Byte)
 {
 }
 
+/**
+  * @brief  This function is used to read bytes from USART pipe.
+  * @param  pBuffer Pointer to the buffer where the read bytes are stored.
+  * @param  BufferSize The number of bytes to be read.
+  * @retval None.
+  */
+void OPENBL_USART_ReadBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+}
+
+/**
+  * @brief  This function is used to send bytes through USART pipe.
+  * @param  pBuffer Pointer to the buffer to be sent.
+  * @param  BufferSize The number of bytes to be sent.
+  * @retval None.
+  */
+void OPENBL_USART_SendBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+}
+
 /**
   * @brief  This function is used to process and execute the special commands.
   *         The user must define the special commands routine here.
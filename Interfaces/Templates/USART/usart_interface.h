@@ -35,10 +35,14 @@ extern "C" {
 void OPENBL_USART_Configuration(void);
 void OPENBL_USART_DeInit(void);
 uint8_t OPENBL_USART_ProtocolDetection(void);
+void OPENBL_USART_ArmDetection(void);
+uint8_t OPENBL_USART_ActivityDetected(void);
 
 uint8_t OPENBL_USART_GetCommandOpcode(void);
 uint8_t OPENBL_USART_ReadByte(void);
 void OPENBL_USART_SendByte(uint8_t Byte);
+void OPENBL_USART_ReadBytes(uint8_t *pBuffer, uint32_t BufferSize);
+void OPENBL_USART_SendBytes(uint8_t *pBuffer, uint32_t BufferSize);
 void OPENBL_USART_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *SpecialCmd);
 
 #ifdef __cplusplus
@@ -35,6 +35,8 @@ void OPENBL_USB_Configuration(void);
 void OPENBL_USB_DeInit(void);
 uint8_t OPENBL_USB_ProtocolDetection(void);
 uint32_t OPENBL_USB_GetPage(uint32_t Address);
+uint32_t OPENBL_USB_DfuGetStatus(void);
+void OPENBL_USB_DfuEndDownload(void);
 
 #ifdef __cplusplus
 }
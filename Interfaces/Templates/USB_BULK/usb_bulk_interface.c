@@ -0,0 +1,160 @@
+/**
+  ******************************************************************************
+  * @file    usb_bulk_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains USB bulk vendor interface HW configuration
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbl_core.h"
+#include "openbl_usb_bulk_cmd.h"
+#include "usb_bulk_interface.h"
+#include "iwdg_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint8_t UsbBulkDetected = 0U;
+
+/* Exported variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to configure the USB bulk vendor interface.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_Configuration(void)
+{
+}
+
+/**
+  * @brief  This function is used to De-initialize the USB bulk vendor interface.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_DeInit(void)
+{
+}
+
+/**
+  * @brief  This function is used to open the bulk endpoints and prime the reception.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_Activate(void)
+{
+}
+
+/**
+  * @brief  This function is used to close the bulk endpoints.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_Deactivate(void)
+{
+}
+
+/**
+  * @brief  This function is used to detect if there is any activity on USB bulk vendor interface.
+  * @retval Returns 1 if interface is detected else 0.
+  */
+uint8_t OPENBL_USB_BULK_ProtocolDetection(void)
+{
+  return UsbBulkDetected;
+}
+
+/**
+  * @brief  This function is used to get the command opcode from the host.
+  * @retval Returns the command.
+  */
+uint8_t OPENBL_USB_BULK_GetCommandOpcode(void)
+{
+  uint8_t command_opc = 0x0;
+
+  return command_opc;
+}
+
+/**
+  * @brief  This function is used to read one byte from USB bulk pipe.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_USB_BULK_ReadByte(void)
+{
+  return 0U;
+}
+
+/**
+  * @brief  This function is used to read bytes from USB bulk pipe.
+  * @param  pBuffer Pointer to the buffer where the read bytes are stored.
+  * @param  BufferSize The number of bytes to be read.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_ReadBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+}
+
+/**
+  * @brief  This function is used to send one byte through USB bulk pipe.
+  * @param  Byte The byte to be sent.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_SendByte(uint8_t Byte)
+{
+}
+
+/**
+  * @brief  This function is used to send a buffer through USB bulk pipe in one transfer.
+  * @param  pBuffer Pointer to the buffer to be sent.
+  * @param  BufferSize The number of bytes to be sent.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_SendBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+}
+
+/**
+  * @brief  This function is used to send the buffered bytes through USB bulk pipe.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_Flush(void)
+{
+}
+
+/**
+  * @brief  This function is called by the USB device stack when a packet is received on the bulk OUT endpoint.
+  * @param  Length The number of received bytes.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_RxCpltCallback(uint32_t Length)
+{
+}
+
+/**
+  * @brief  This function is called by the USB device stack when a transfer on the bulk IN endpoint is complete.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_TxCpltCallback(void)
+{
+}
+
+/**
+  * @brief  This function is used to process and execute the special commands.
+  *         The user must define the special commands routine here.
+  * @param  SpecialCmd Pointer to the OPENBL_SpecialCmdTypeDef structure.
+  * @retval Returns NACK status in case of error else returns ACK status.
+  */
+void OPENBL_USB_BULK_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *SpecialCmd)
+{
+}
@@ -0,0 +1,152 @@
+/**
+  ******************************************************************************
+  * @file    usb_cdc_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains USB CDC-ACM interface HW configuration
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbl_core.h"
+#include "openbl_usart_cmd.h"
+#include "usb_cdc_interface.h"
+#include "iwdg_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint8_t UsbCdcDetected = 0U;
+
+/* Exported variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to configure the USB CDC-ACM interface.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_Configuration(void)
+{
+}
+
+/**
+  * @brief  This function is used to De-initialize the USB CDC-ACM interface.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_DeInit(void)
+{
+}
+
+/**
+  * @brief  This function is used to open the CDC data endpoints and prime the reception.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_Activate(void)
+{
+}
+
+/**
+  * @brief  This function is used to close the CDC data endpoints.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_Deactivate(void)
+{
+}
+
+/**
+  * @brief  This function is used to detect if there is any activity on USB CDC-ACM interface.
+  * @retval Returns 1 if interface is detected else 0.
+  */
+uint8_t OPENBL_USB_CDC_ProtocolDetection(void)
+{
+  return UsbCdcDetected;
+}
+
+/**
+  * @brief  This function is used to get the command opcode from the host.
+  * @retval Returns the command.
+  */
+uint8_t OPENBL_USB_CDC_GetCommandOpcode(void)
+{
+  uint8_t command_opc = 0x0;
+
+  return command_opc;
+}
+
+/**
+  * @brief  This function is used to read one byte from USB CDC pipe.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_USB_CDC_ReadByte(void)
+{
+  return 0U;
+}
+
+/**
+  * @brief  This function is used to read bytes from USB CDC pipe.
+  * @param  pBuffer Pointer to the buffer where the read bytes are stored.
+  * @param  BufferSize The number of bytes to be read.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_ReadBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+}
+
+/**
+  * @brief  This function is used to send one byte through USB CDC pipe.
+  * @param  Byte The byte to be sent.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_SendByte(uint8_t Byte)
+{
+}
+
+/**
+  * @brief  This function is used to send a buffer through USB CDC pipe in one transfer.
+  * @param  pBuffer Pointer to the buffer to be sent.
+  * @param  BufferSize The number of bytes to be sent.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_SendBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+}
+
+/**
+  * @brief  This function is called by the USB device stack when a packet is received on the CDC data OUT endpoint.
+  * @param  Length The number of received bytes.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_RxCpltCallback(uint32_t Length)
+{
+}
+
+/**
+  * @brief  This function is called by the USB device stack when a transfer on the CDC data IN endpoint is complete.
+  * @retval None.
+  */
+void OPENBL_USB_CDC_TxCpltCallback(void)
+{
+}
+
+/**
+  * @brief  This function is used to process and execute the special commands.
+  *         The user must define the special commands routine here.
+  * @param  SpecialCmd Pointer to the OPENBL_SpecialCmdTypeDef structure.
+  * @retval Returns NACK status in case of error else returns ACK status.
+  */
+void OPENBL_USB_CDC_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *SpecialCmd)
+{
+}
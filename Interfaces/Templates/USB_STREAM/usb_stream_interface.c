@@ -0,0 +1,106 @@
+/**
+  ******************************************************************************
+  * @file    usb_stream_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains the byte stream shared by the USB bulk and CDC-ACM interfaces
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "usb_stream_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to initialize the byte stream state.
+  * @param  pStream Pointer to the byte stream handle.
+  * @retval None.
+  */
+void OPENBL_USB_STREAM_Init(OPENBL_USB_STREAM_HandleTypeDef *pStream)
+{
+}
+
+/**
+  * @brief  This function is used to open the endpoints and prime the reception of the first packet.
+  * @param  pStream Pointer to the byte stream handle.
+  * @retval None.
+  */
+void OPENBL_USB_STREAM_Activate(OPENBL_USB_STREAM_HandleTypeDef *pStream)
+{
+}
+
+/**
+  * @brief  This function is used to close the endpoints.
+  * @param  pStream Pointer to the byte stream handle.
+  * @retval None.
+  */
+void OPENBL_USB_STREAM_Deactivate(OPENBL_USB_STREAM_HandleTypeDef *pStream)
+{
+}
+
+/**
+  * @brief  This function is used to detect if the host sent the synchronization byte.
+  * @param  pStream Pointer to the byte stream handle.
+  * @retval Returns 1 if the synchronization byte has been received (and flushed) else 0.
+  */
+uint8_t OPENBL_USB_STREAM_ProtocolDetection(OPENBL_USB_STREAM_HandleTypeDef *pStream)
+{
+  return 0U;
+}
+
+/**
+  * @brief  This function is used to read one byte from the reception ring buffer.
+  * @param  pStream Pointer to the byte stream handle.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_USB_STREAM_ReadByte(OPENBL_USB_STREAM_HandleTypeDef *pStream)
+{
+  return 0U;
+}
+
+/**
+  * @brief  This function is used to send a buffer on the IN endpoint and wait for its completion.
+  * @param  pStream Pointer to the byte stream handle.
+  * @param  pBuffer Pointer to the buffer to be sent.
+  * @param  BufferSize The number of bytes to be sent.
+  * @retval None.
+  */
+void OPENBL_USB_STREAM_Transmit(OPENBL_USB_STREAM_HandleTypeDef *pStream, uint8_t *pBuffer, uint32_t BufferSize)
+{
+}
+
+/**
+  * @brief  This function is called by the USB device stack when a packet is received on the OUT endpoint.
+  * @param  pStream Pointer to the byte stream handle.
+  * @param  Length The number of received bytes.
+  * @retval None.
+  */
+void OPENBL_USB_STREAM_RxCpltCallback(OPENBL_USB_STREAM_HandleTypeDef *pStream, uint32_t Length)
+{
+}
+
+/**
+  * @brief  This function is called by the USB device stack when a transfer on the IN endpoint is complete.
+  * @param  pStream Pointer to the byte stream handle.
+  * @retval None.
+  */
+void OPENBL_USB_STREAM_TxCpltCallback(OPENBL_USB_STREAM_HandleTypeDef *pStream)
+{
+}
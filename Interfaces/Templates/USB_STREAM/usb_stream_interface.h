@@ -0,0 +1,63 @@
+/**
+  ******************************************************************************
+  * @file    usb_stream_interface.h
+  * @author  MCD Application Team
+  * @brief   Header for usb_stream_interface.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef USB_STREAM_INTERFACE_H
+#define USB_STREAM_INTERFACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/* Byte stream carried by a pair of bulk endpoints (USB bulk vendor and CDC-ACM data interfaces) */
+typedef struct
+{
+  uint8_t OutEp;                   /* Bulk OUT endpoint address */
+  uint8_t InEp;                    /* Bulk IN endpoint address */
+  uint32_t PacketSize;             /* Bulk max packet size */
+  uint8_t *pRxBuffer;              /* Reception ring buffer, filled by the OUT endpoint completion callback */
+  uint32_t RxBufferSize;           /* Size of the reception ring buffer */
+  uint8_t *pRxPacket;              /* Reception packet buffer, of PacketSize bytes */
+  volatile uint32_t RxHead;
+  volatile uint32_t RxTail;
+  volatile uint8_t RxPaused;       /* The OUT endpoint is not primed, the host is NAKed */
+  volatile uint8_t TxBusy;
+  volatile uint8_t Active;         /* The endpoints are opened, the device is configured by the host */
+} OPENBL_USB_STREAM_HandleTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void OPENBL_USB_STREAM_Init(OPENBL_USB_STREAM_HandleTypeDef *pStream);
+void OPENBL_USB_STREAM_Activate(OPENBL_USB_STREAM_HandleTypeDef *pStream);
+void OPENBL_USB_STREAM_Deactivate(OPENBL_USB_STREAM_HandleTypeDef *pStream);
+uint8_t OPENBL_USB_STREAM_ProtocolDetection(OPENBL_USB_STREAM_HandleTypeDef *pStream);
+uint8_t OPENBL_USB_STREAM_ReadByte(OPENBL_USB_STREAM_HandleTypeDef *pStream);
+void OPENBL_USB_STREAM_Transmit(OPENBL_USB_STREAM_HandleTypeDef *pStream, uint8_t *pBuffer, uint32_t BufferSize);
+void OPENBL_USB_STREAM_RxCpltCallback(OPENBL_USB_STREAM_HandleTypeDef *pStream, uint32_t Length);
+void OPENBL_USB_STREAM_TxCpltCallback(OPENBL_USB_STREAM_HandleTypeDef *pStream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* USB_STREAM_INTERFACE_H */
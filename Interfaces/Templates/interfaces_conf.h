@@ -31,6 +31,15 @@ extern "C" {
 
 #define MEMORIES_SUPPORTED                7U
 
+/*------------------- Definitions for the activity detection -----------------*/
+/* Pending flag of a pin armed as an EXTI falling edge input (lazy init). The STM32U5 EXTI has separate
+   rising and falling pending registers, the families with a single one use __HAL_GPIO_EXTI_GET_IT and
+   __HAL_GPIO_EXTI_CLEAR_IT. An EXTI line serves one pin number of one port, so the detection pins are on
+   distinct lines: USART RX 9, I2C SCL 4, FDCAN RX 0, SPI NSS 15 and I3C SCL 11. A pin sharing the line of
+   a pin already armed is not armed and its interface is initialized at once, see Common_ArmActivityDetection */
+#define OPENBL_EXTI_GET_FLAG(__PIN__)     __HAL_GPIO_EXTI_GET_FALLING_IT(__PIN__)
+#define OPENBL_EXTI_CLEAR_FLAG(__PIN__)   __HAL_GPIO_EXTI_CLEAR_FALLING_IT(__PIN__)
+
 /*-------------------------- Definitions for USART ---------------------------*/
 #define USARTx                            USART3
 #define USARTx_CLK_ENABLE()               __HAL_RCC_USART3_CLK_ENABLE()
@@ -42,6 +51,7 @@ extern "C" {
 #define USARTx_TX_GPIO_PORT               GPIOD
 #define USARTx_RX_PIN                     GPIO_PIN_9
 #define USARTx_RX_GPIO_PORT               GPIOD
+#define USARTx_RX_EXTI_IRQ                EXTI9_IRQn
 #define USARTx_ALTERNATE                  GPIO_AF7_USART3
 
 /*-------------------------- Definitions for I2C -----------------------------*/
@@ -53,6 +63,7 @@ extern "C" {
 
 #define I2Cx_SCL_PIN                      GPIO_PIN_4
 #define I2Cx_SCL_PIN_PORT                 GPIOH
+#define I2Cx_SCL_EXTI_IRQ                 EXTI4_IRQn
 #define I2Cx_SDA_PIN                      GPIO_PIN_5
 #define I2Cx_SDA_PIN_PORT                 GPIOH
 #define I2Cx_ALTERNATE                    GPIO_AF4_I2C2
@@ -64,18 +75,22 @@ extern "C" {
 #define FDCANx                            FDCAN1
 #define FDCANx_CLK_ENABLE()               __HAL_RCC_FDCAN1_CLK_ENABLE()
 #define FDCANx_CLK_DISABLE()              __HAL_RCC_FDCAN1_CLK_DISABLE()
-#define FDCANx_GPIO_CLK_ENABLE()          __HAL_RCC_GPIOB_CLK_ENABLE()
+#define FDCANx_GPIO_CLK_ENABLE()          __HAL_RCC_GPIOD_CLK_ENABLE()
+#define FDCANx_IT0_IRQ                    FDCAN1_IT0_IRQn
 
-#define FDCANx_TX_PIN                     GPIO_PIN_8
-#define FDCANx_TX_GPIO_PORT               GPIOB
+#define FDCANx_TX_PIN                     GPIO_PIN_1
+#define FDCANx_TX_GPIO_PORT               GPIOD
 #define FDCANx_TX_AF                      GPIO_AF9_FDCAN1
-#define FDCANx_RX_PIN                     GPIO_PIN_9
-#define FDCANx_RX_GPIO_PORT               GPIOB
+#define FDCANx_RX_PIN                     GPIO_PIN_0
+#define FDCANx_RX_GPIO_PORT               GPIOD
+#define FDCANx_RX_EXTI_IRQ                EXTI0_IRQn
 #define FDCANx_RX_AF                      GPIO_AF9_FDCAN1
 
 #define FDCANx_FORCE_RESET()              __HAL_RCC_FDCAN1_FORCE_RESET()
 #define FDCANx_RELEASE_RESET()            __HAL_RCC_FDCAN1_RELEASE_RESET()
 
+#define FDCAN_RX_QUEUE_SIZE               32U  /* Number of frames stored in the FDCAN software receive queue */
+
 /*--------------------------- Definitions for SPI ----------------------------*/
 #define SPIx                              SPI1
 #define SPIx_CLK_ENABLE()                 __HAL_RCC_SPI1_CLK_ENABLE()
@@ -90,8 +105,9 @@ extern "C" {
 #define SPIx_MISO_PIN_PORT                GPIOE
 #define SPIx_SCK_PIN                      GPIO_PIN_13
 #define SPIx_SCK_PIN_PORT                 GPIOE
-#define SPIx_NSS_PIN                      GPIO_PIN_4
+#define SPIx_NSS_PIN                      GPIO_PIN_15
 #define SPIx_NSS_PIN_PORT                 GPIOA
+#define SPIx_NSS_EXTI_IRQ                 EXTI15_IRQn
 #define SPIx_ALTERNATE                    GPIO_AF5_SPI1
 
 /*-------------------------- Definitions for I3C -----------------------------*/
@@ -102,13 +118,35 @@ extern "C" {
 #define I3Cx_GPIO_CLK_SDA_ENABLE()        __HAL_RCC_GPIOH_CLK_ENABLE()
 #define I3Cx_DEINIT()                     LL_I3C_DeInit(I3Cx)
 #define I3Cx_EV_IRQ                       I3C1_EV_IRQn
+#define I3Cx_DMA                          GPDMA1
+#define I3Cx_DMA_CLK_ENABLE()             __HAL_RCC_GPDMA1_CLK_ENABLE()
+#define I3Cx_DMA_TX_CHANNEL               LL_DMA_CHANNEL_0
+#define I3Cx_DMA_RX_CHANNEL               LL_DMA_CHANNEL_1
+#define I3Cx_DMA_TX_REQUEST               LL_GPDMA1_REQUEST_I3C1_TX
+#define I3Cx_DMA_RX_REQUEST               LL_GPDMA1_REQUEST_I3C1_RX
 
 #define I3Cx_SCL_PIN                      LL_GPIO_PIN_11
 #define I3Cx_SCL_PORT                     GPIOH
+#define I3Cx_SCL_EXTI_IRQ                 EXTI11_IRQn
 #define I3Cx_SDA_PIN                      LL_GPIO_PIN_12
 #define I3Cx_SDA_PORT                     GPIOH
 #define I3Cx_ALTERNATE                    LL_GPIO_AF_5
 #define OPENBL_I3C_TIMEOUT                0xFFFFF000U
+#define OPENBL_I3C_MAX_READ_LENGTH        2048U   /* Max private read length advertised to the controller (GETMRL) */
+#define OPENBL_I3C_MAX_WRITE_LENGTH       2049U   /* Max private write length advertised to the controller (GETMWL) */
+#define OPENBL_I3C_PROGRESS_IBI           0U      /* 1: send BUSY_BYTE IBIs during long operations, 0: only ACK/NACK IBIs */
+
+/*------------------------ Definitions for USB bulk --------------------------*/
+#define USB_BULK_OUT_EP                   0x01U   /* Vendor interface bulk OUT endpoint */
+#define USB_BULK_IN_EP                    0x81U   /* Vendor interface bulk IN endpoint */
+#define USB_BULK_PACKET_SIZE              64U     /* Bulk max packet size: 64 bytes on full-speed, 512 on high-speed */
+#define USB_BULK_RX_BUFFER_SIZE           8320U   /* Reception ring buffer, holds two extended write blocks */
+
+/*------------------------- Definitions for USB CDC --------------------------*/
+#define USB_CDC_OUT_EP                    0x02U   /* CDC-ACM data interface bulk OUT endpoint */
+#define USB_CDC_IN_EP                     0x82U   /* CDC-ACM data interface bulk IN endpoint */
+#define USB_CDC_PACKET_SIZE               64U     /* Bulk max packet size: 64 bytes on full-speed, 512 on high-speed */
+#define USB_CDC_RX_BUFFER_SIZE            1024U   /* Reception ring buffer, holds a full write memory frame */
 
 #ifdef __cplusplus
 }
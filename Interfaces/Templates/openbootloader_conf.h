@@ -61,7 +61,11 @@ extern "C" {
 #define EB_START_ADDRESS                  0x40022400U                     /* Engi bytes start address */
 #define EB_END_ADDRESS                    (EB_START_ADDRESS + EB_SIZE)    /* Engi bytes end address */
 
-#define OPENBL_RAM_SIZE                   0x11800U  /* RAM used by the Open Bootloader 71680 Bytes */
+#define OPENBL_RAM_SIZE                   0xF800U   /* RAM used by the Open Bootloader 63488 Bytes */
+
+#define OPENBL_BUFFER_ARENA_SIZE          4096U     /* Command buffer shared by the interfaces (>= 4096 for USB bulk) */
+
+#define FLASH_PROGRAM_TIME_PER_KB         10U                  /* Typical time in ms to program 1 kByte of Flash */
 
 #define OPENBL_DEFAULT_MEM                FLASH_START_ADDRESS  /* Used for Erase and Write protect CMDs */
 
@@ -83,6 +87,41 @@ extern "C" {
 
 #define INTERFACES_SUPPORTED              6U
 
+/* ------------------------------ Lazy init --------------------------------- */
+#define OPENBL_LAZY_INIT                  0U                   /* 1: initialize an interface only once activity is seen on its pins */
+
+/* ------------------------------ Fast boot --------------------------------- */
+#define OPENBL_FAST_BOOT                  0U                   /* 1: jump to a valid application before initializing the interfaces */
+#define OPENBL_APP_ADDRESS                FLASH_START_ADDRESS  /* Address of the application vector table */
+#define OPENBL_APP_CRC_CHECK              0U                   /* 1: also check the application CRC-32 stored in its marker */
+#define OPENBL_APP_MARKER_ADDRESS         (FLASH_END_ADDRESS - 16U) /* Application marker [magic, size, CRC-32, reserved] */
+#define OPENBL_APP_MARKER_MAGIC           0x41424C4FU          /* Application marker magic number "OLBA" */
+#define OPENBL_BOOT_REQUEST_MAGIC         0x424F4F54U          /* Written in backup register 0 by the application to request the bootloader */
+
+/* ------------------------------ Statistics -------------------------------- */
+#define OPENBL_PERF_ENABLE                0U                   /* 1: record the command latencies, read by the Get Statistics command */
+#define OPENBL_PERF_CMD_SLOTS             16U                  /* Number of commands with their own statistics */
+#define OPENBL_PERF_HIST_BUCKETS          8U                   /* Number of latency histogram buckets */
+#define OPENBL_PERF_HIST_FIRST_LIMIT      1024U                /* Cycles limit of the first bucket, x4 for each next one */
+
+/* ------------------------------ RAM staging ------------------------------- */
+#define OPENBL_STAGING_ENABLE             0U                   /* 1: Commit Memory command programming the Flash from an image staged in RAM */
+#define OPENBL_STAGING_ADDRESS            (RAM_START_ADDRESS + OPENBL_RAM_SIZE) /* Image written by the host before its commit */
+#define OPENBL_STAGING_SIZE               (RAM_END_ADDRESS - OPENBL_STAGING_ADDRESS) /* Largest image committed at once */
+
+/* ---------------------------- Compressed write ---------------------------- */
+#define OPENBL_COMPRESSED_WRITE_ENABLE    0U                   /* 1: Compressed Write Memory command, LZ4 block format */
+
+/* ------------------------------ Delta patch ------------------------------- */
+#define OPENBL_PATCH_ENABLE               0U                   /* 1: Patch Memory command, new image built from the old one */
+
+/* ---------------------------------- CRC ----------------------------------- */
+#define OPENBL_BLOCK_CRC_ENABLE           0U                   /* 1: Get Block CRC command, CRC-32 of each block of a memory range */
+#define OPENBL_HW_CRC_ENABLE              0U                   /* 1: CRC-32 of the Flash and RAM computed by the CRC unit */
+
+/* -------------------------------- USB DFU --------------------------------- */
+#define OPENBL_USB_DEFERRED_WRITE         0U                   /* 1: DFU blocks programmed from the GETSTATUS requests, behind the reception */
+
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
 
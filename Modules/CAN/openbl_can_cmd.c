@@ -3,6 +3,9 @@
   * @file    openbl_can_cmd.c
   * @author  MCD Application Team
   * @brief   Contains CAN protocol commands
+  *          The memory commands are run by the command engine, the CAN transport
+  *          reads their parameters from the command frame and moves the data in
+  *          8-byte frames, acknowledged one by one or paced by flow control frames.
   ******************************************************************************
   * @attention
   *
@@ -20,27 +23,73 @@
 #include "openbl_mem.h"
 #include "openbl_core.h"
 #include "openbl_can_cmd.h"
+#include "openbl_engine.h"
 #include "openbootloader_conf.h"
 #include "can_interface.h"
 #include "interfaces_conf.h"
 #include "common_interface.h"
 
 /* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint32_t ParamIndex;  /* Next parameter byte of the command frame */
+  uint32_t Frames;      /* Frames left in the current flow control block */
+  uint8_t Mode;         /* Acknowledge or flow control of the data frames: CAN_TRANSFER_xxx */
+  uint8_t FlowStatus;   /* Flow status of the host, CAN_FC_CONTINUE_TO_SEND unless it aborted the transfer */
+  uint8_t Separation;   /* Separation time in milliseconds between two frames sent to the host */
+} OPENBL_CAN_TransferTypeDef;
+
 /* Private define ------------------------------------------------------------*/
-#define OPENBL_CAN_COMMANDS_NB_MAX        12U  /* Number of supported commands */
+#define OPENBL_CAN_COMMANDS_NB_MAX        20U  /* Number of supported commands */
 #define OPENBL_CAN_SPEED_MAX              4U  /* Max speed is 4 (1 Mbps) */
 
+#define CAN_FRAME_DATA_SIZE               8U                                  /* Data bytes of a classic CAN frame */
+#define CAN_BLOCK_FRAMES                  (CAN_RAM_BUFFER_SIZE / CAN_FRAME_DATA_SIZE) /* Frames per block */
+#define CAN_FC_FRAME_LENGTH               3U      /* Length of a flow control frame */
+#define CAN_FC_CONTINUE_TO_SEND           0x30U   /* Flow control status: continue to send */
+#define CAN_FC_ALL_FRAMES                 0xFFFFFFFFU /* Block size 0: all the remaining frames in one block */
+#define CAN_FC_SEPARATION_MAX             0x7FU   /* Greatest separation time in milliseconds */
+
+#define CAN_TRANSFER_NONE                 0U      /* Data frames neither acknowledged nor paced */
+#define CAN_TRANSFER_ACK_ALL              1U      /* Each received data frame is acknowledged */
+#define CAN_TRANSFER_ACK_FULL             2U      /* Each received full data frame is acknowledged */
+#define CAN_TRANSFER_FLOW_CONTROL         3U      /* Data frames paced by flow control frames */
+
 /* Private macro -------------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void OPENBL_CAN_StartCommand(uint8_t Mode);
+static void OPENBL_CAN_ReadFrame(uint8_t *pBuffer, uint32_t Length);
+static void OPENBL_CAN_SendFrame(uint8_t *pBuffer, uint32_t Length);
+static void OPENBL_CAN_SendAck(uint8_t Ack);
+static void OPENBL_CAN_ReadParameters(uint8_t *pBuffer, uint32_t Length);
+static uint8_t OPENBL_CAN_ConstructCommandsTable(OPENBL_CommandsTypeDef *pCanCmd);
+
 /* Private variables ---------------------------------------------------------*/
-/* Private macro -------------------------------------------------------------*/
-/* Private variables ---------------------------------------------------------*/
-static uint8_t tCanTxData[CAN_RAM_BUFFER_SIZE];
+/* Block transport of the CAN interface, the parameters are carried in the command frame */
+static const OPENBL_ENGINE_TransportTypeDef CanTransport =
+{
+  OPENBL_CAN_ReadFrame,
+  OPENBL_CAN_SendFrame,
+  OPENBL_CAN_SendAck,
+  NULL,
+  NULL,
+  OPENBL_CAN_ReadParameters
+};
+
 static uint8_t a_OPENBL_CAN_CommandsList[OPENBL_CAN_COMMANDS_NB_MAX] = {0};
-static uint8_t CanCommandsNumber = 0U;
+static OPENBL_CAN_TransferTypeDef CanTransfer = {0U};
 
-/* Private function prototypes -----------------------------------------------*/
-static uint8_t OPENBL_CAN_GetAddress(uint32_t *Address);
-static uint8_t OPENBL_CAN_ConstructCommandsTable(OPENBL_CommandsTypeDef *pCanCmd);
+/* The CAN commands are run by the command engine */
+static OPENBL_ENGINE_HandleTypeDef CanHandle =
+{
+  &CanTransport,
+  NULL,
+  OPENBL_ENGINE_BUFFER_SIZE,
+  a_OPENBL_CAN_CommandsList,
+  0U,
+  OPENBL_CAN_VERSION,
+  OPENBL_ENGINE_FRAMING_COMMAND_FRAME | OPENBL_ENGINE_FRAMING_FLOW_CONTROL
+};
 
 /* Exported variables --------------------------------------------------------*/
 /* Exported functions---------------------------------------------------------*/
@@ -72,9 +121,20 @@ OPENBL_CommandsTypeDef *OPENBL_CAN_GetCommandsList(void)
     NULL,
     OPENBL_CAN_Speed,
     NULL,
-    NULL
+    NULL,
+    OPENBL_CAN_ExtendedReadMemory,
+    OPENBL_CAN_ExtendedWriteMemory,
+    OPENBL_CAN_GroupCommand,
+    OPENBL_CAN_GetStatistics,
+    OPENBL_CAN_CommitMemory,
+    OPENBL_CAN_CompressedWriteMemory,
+    OPENBL_CAN_PatchMemory,
+    OPENBL_CAN_GetBlockCrc
   };
 
+  /* The command buffer is taken from the arena shared by all the interfaces */
+  CanHandle.pBuffer = OPENBL_GetBuffer(OPENBL_ENGINE_BUFFER_SIZE);
+
   OPENBL_CAN_SetCommandsList(&OPENBL_CAN_Commands);
 
   return (&OPENBL_CAN_Commands);
@@ -87,7 +147,7 @@ OPENBL_CommandsTypeDef *OPENBL_CAN_GetCommandsList(void)
 void OPENBL_CAN_SetCommandsList(OPENBL_CommandsTypeDef *pCanCmd)
 {
   /* Get the list of commands supported & their numbers */
-  CanCommandsNumber = OPENBL_CAN_ConstructCommandsTable(pCanCmd);
+  CanHandle.CommandsNumber = OPENBL_CAN_ConstructCommandsTable(pCanCmd);
 }
 
 /**
@@ -102,13 +162,13 @@ void OPENBL_CAN_GetCommand(void)
   OPENBL_CAN_SendByte(ACK_BYTE);
 
   /* Send the number of commands supported by CAN protocol */
-  OPENBL_CAN_SendByte(CanCommandsNumber);
+  OPENBL_CAN_SendByte(CanHandle.CommandsNumber);
 
   /* Send CAN protocol version */
   OPENBL_CAN_SendByte(OPENBL_CAN_VERSION);
 
   /* Send the list of supported commands */
-  for (counter = 0U; counter < CanCommandsNumber; counter++)
+  for (counter = 0U; counter < CanHandle.CommandsNumber; counter++)
   {
     OPENBL_CAN_SendByte(a_OPENBL_CAN_CommandsList[counter]);
   }
@@ -130,9 +190,9 @@ void OPENBL_CAN_GetVersion(void)
   OPENBL_CAN_SendByte(OPENBL_CAN_VERSION);
 
   /* Send dummy bytes */
-  tCanTxData[0] = 0x00;
-  tCanTxData[1] = 0x00;
-  OPENBL_CAN_SendBytes(tCanTxData, CAN_DLC_BYTES_2);
+  CanHandle.pBuffer[0] = 0x00;
+  CanHandle.pBuffer[1] = 0x00;
+  OPENBL_CAN_SendBytes(CanHandle.pBuffer, CAN_DLC_BYTES_2);
 
   /* Send last Acknowledge synchronization byte */
   OPENBL_CAN_SendByte(ACK_BYTE);
@@ -148,9 +208,9 @@ void OPENBL_CAN_GetID(void)
   OPENBL_CAN_SendByte(ACK_BYTE);
 
   /* Send the device ID starting by the MSB byte then the LSB byte */
-  tCanTxData[0] = DEVICE_ID_MSB;
-  tCanTxData[1] = DEVICE_ID_LSB;
-  OPENBL_CAN_SendBytes(tCanTxData, CAN_DLC_BYTES_2);
+  CanHandle.pBuffer[0] = DEVICE_ID_MSB;
+  CanHandle.pBuffer[1] = DEVICE_ID_LSB;
+  OPENBL_CAN_SendBytes(CanHandle.pBuffer, CAN_DLC_BYTES_2);
 
   /* Send last Acknowledge synchronization byte */
   OPENBL_CAN_SendByte(ACK_BYTE);
@@ -206,399 +266,350 @@ void OPENBL_CAN_Speed(void)
   */
 void OPENBL_CAN_ReadMemory(void)
 {
-  uint32_t address;
-  uint32_t memory_index;
-  uint16_t number_of_bytes;
-  uint16_t count;
-  uint16_t single;
-  uint8_t counter;
-  uint8_t data_length;
-  uint8_t data_byte;
-
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_CAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    if (OPENBL_CAN_GetAddress(&address) == NACK_BYTE)
-    {
-      OPENBL_CAN_SendByte(NACK_BYTE);
-    }
-    else
-    {
-      OPENBL_CAN_SendByte(ACK_BYTE);
-
-      /* Get the number of bytes to be read from memory (Max: data + 1 = 256) */
-      number_of_bytes = (uint16_t)((uint16_t)tCanRxData[4] + 1U);
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_NONE);
 
-      count  = number_of_bytes / 8U;
-      single = (number_of_bytes % 8U);
-
-      /* Get the memory index to know from which memory we will read */
-      memory_index = OPENBL_MEM_GetMemoryIndex(address);
-
-      while (count != 0U)
-      {
-        data_length = 0;
+  OPENBL_ENGINE_ReadMemory(&CanHandle);
+}
 
-        for (counter = 8U ; counter > 0U; counter--)
-        {
-          tCanTxData[data_length] = OPENBL_MEM_Read(address, memory_index);
+/**
+  * @brief  This function is used to write in to device memory.
+  *         Each data frame is acknowledged.
+  * @retval None.
+  */
+void OPENBL_CAN_WriteMemory(void)
+{
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_ACK_ALL);
 
-          data_length++;
-          address++;
-        }
+  OPENBL_ENGINE_WriteMemory(&CanHandle);
+}
 
-        OPENBL_CAN_SendBytes(tCanTxData, CAN_DLC_BYTES_8);
+/**
+  * @brief  This function is used to jump to the user application.
+  * @retval None.
+  */
+void OPENBL_CAN_Go(void)
+{
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_NONE);
 
-        count--;
-      }
+  OPENBL_ENGINE_Go(&CanHandle);
+}
 
-      if (single != 0U)
-      {
-        for (counter = (uint8_t)single ; counter > 0U; counter--)
-        {
-          data_byte = OPENBL_MEM_Read(address, memory_index);
-          address++;
-          OPENBL_CAN_SendByte(data_byte);
-        }
-      }
+/**
+  * @brief  This function is used to enable readout protection.
+  * @retval None.
+  */
+void OPENBL_CAN_ReadoutProtect(void)
+{
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_NONE);
 
-      /* Send last Acknowledge synchronization byte */
-      OPENBL_CAN_SendByte(ACK_BYTE);
-    }
-  }
+  OPENBL_ENGINE_ReadoutProtect(&CanHandle);
 }
 
 /**
-  * @brief  This function is used to write in to device memory.
+  * @brief  This function is used to disable readout protection.
   * @retval None.
   */
-void OPENBL_CAN_WriteMemory(void)
+void OPENBL_CAN_ReadoutUnprotect(void)
 {
-  uint32_t address;
-  uint32_t code_size;
-  uint32_t count;
-  uint32_t single;
-  uint8_t data_length;
-
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_CAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    if (OPENBL_CAN_GetAddress(&address) == NACK_BYTE)
-    {
-      OPENBL_CAN_SendByte(NACK_BYTE);
-    }
-    else
-    {
-      OPENBL_CAN_SendByte(ACK_BYTE);
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_NONE);
 
-      /* Get the number of bytes to be written to memory (Max: data + 1 = 256) */
-      code_size = (uint32_t)tCanRxData[4] + 1U;
+  OPENBL_ENGINE_ReadoutUnprotect(&CanHandle);
+}
 
-      count  = code_size / 8U;
-      single = code_size % 8U;
+/**
+  * @brief  This function is used to erase a memory.
+  *         Only the full frames of the list of pages are acknowledged.
+  * @retval None.
+  */
+void OPENBL_CAN_LegacyEraseMemory(void)
+{
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_ACK_FULL);
 
-      data_length = 0;
+  OPENBL_ENGINE_LegacyEraseMemory(&CanHandle);
+}
 
-      if (count != 0U)
-      {
-        while (data_length != count)
-        {
-          OPENBL_CAN_ReadBytes(&tCanRxData[data_length * 8U], CAN_DLC_BYTES_8);
-          OPENBL_CAN_SendByte(ACK_BYTE);
+/**
+  * @brief  This function is used to enable write protect.
+  *         Each frame of the list of sectors is acknowledged.
+  * @retval None.
+  */
+void OPENBL_CAN_WriteProtect(void)
+{
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_ACK_ALL);
 
-          data_length++;
-        }
-      }
+  OPENBL_ENGINE_WriteProtect(&CanHandle);
+}
 
-      if (single != 0U)
-      {
-        OPENBL_CAN_ReadBytes(&tCanRxData[(code_size - single)], CAN_DLC_BYTES_8);
-        OPENBL_CAN_SendByte(ACK_BYTE);
-      }
+/**
+  * @brief  This function is used to disable write protect.
+  * @retval None.
+  */
+void OPENBL_CAN_WriteUnprotect(void)
+{
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_NONE);
 
-      /* Write data to memory */
-      OPENBL_MEM_Write(address, (uint8_t *)tCanRxData, code_size);
+  OPENBL_ENGINE_WriteUnprotect(&CanHandle);
+}
 
-      /* Send last Acknowledge synchronization byte */
-      OPENBL_CAN_SendByte(ACK_BYTE);
+/**
+  * @brief  This function is used to read memory from the device using a 32-bit length.
+  *         The data is sent in full 8-byte frames, by blocks requested by the host flow control frames.
+  * @retval None.
+  */
+void OPENBL_CAN_ExtendedReadMemory(void)
+{
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_FLOW_CONTROL);
 
-      /* Start post processing task if needed */
-      Common_StartPostProcessing();
-    }
-  }
+  OPENBL_ENGINE_ExtendedReadMemory(&CanHandle);
 }
 
 /**
-  * @brief  This function is used to jump to the user application.
+  * @brief  This function is used to write in to device memory using a 32-bit length.
+  *         The host sends full 8-byte frames, by blocks granted by the device flow control frames.
   * @retval None.
   */
-void OPENBL_CAN_Go(void)
+void OPENBL_CAN_ExtendedWriteMemory(void)
 {
-  uint32_t address;
-  uint32_t mem_area;
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_FLOW_CONTROL);
 
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_CAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    if (OPENBL_CAN_GetAddress(&address) == NACK_BYTE)
-    {
-      OPENBL_CAN_SendByte(NACK_BYTE);
-    }
-    else
-    {
-      /* Check if received address is valid or not */
-      mem_area = OPENBL_MEM_GetAddressArea(address);
+  OPENBL_ENGINE_ExtendedWriteMemory(&CanHandle);
+}
 
-      if ((mem_area != FLASH_AREA) && (mem_area != RAM_AREA))
-      {
-        OPENBL_CAN_SendByte(NACK_BYTE);
-      }
-      else
-      {
-        /* If the jump address is valid then send ACK */
-        OPENBL_CAN_SendByte(ACK_BYTE);
+/**
+  * @brief  This function is used to write in to device memory data compressed in the LZ4 block format,
+  *         see OPENBL_MEM_WriteCompressed. The encoded frames are granted by a single flow control frame.
+  * @retval None.
+  */
+void OPENBL_CAN_CompressedWriteMemory(void)
+{
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_FLOW_CONTROL);
 
-        OPENBL_MEM_JumpToAddress(address);
-      }
-    }
-  }
+  OPENBL_ENGINE_CompressedWriteMemory(&CanHandle);
 }
 
 /**
-  * @brief  This function is used to enable readout protection.
+  * @brief  This function is used to write in to device memory a new image built by a delta patch
+  *         from the old one, see OPENBL_MEM_WritePatch. The encoded frames are granted by a single
+  *         flow control frame.
   * @retval None.
   */
-void OPENBL_CAN_ReadoutProtect(void)
+void OPENBL_CAN_PatchMemory(void)
 {
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_CAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_CAN_SendByte(ACK_BYTE);
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_FLOW_CONTROL);
 
-    /* Enable the read protection */
-    OPENBL_MEM_SetReadOutProtection(OPENBL_DEFAULT_MEM, ENABLE);
+  OPENBL_ENGINE_PatchMemory(&CanHandle);
+}
 
-    /* Send last Acknowledge synchronization byte */
-    OPENBL_CAN_SendByte(ACK_BYTE);
+/**
+  * @brief  This function is used to send the CRC-32 of consecutive memory blocks, see OPENBL_MEM_GetBlockCrc.
+  *         The command frame holds the address and the block size, the next frame the number of blocks minus
+  *         one. The CRCs are sent in 8-byte frames, by blocks requested by the host flow control frames.
+  * @retval None.
+  */
+void OPENBL_CAN_GetBlockCrc(void)
+{
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_FLOW_CONTROL);
 
-    /* Start post processing task if needed */
-    Common_StartPostProcessing();
-  }
+  OPENBL_ENGINE_GetBlockCrc(&CanHandle);
 }
 
 /**
-  * @brief  This function is used to disable readout protection.
+  * @brief  This function is used to manage the group programming of several nodes sharing the same bus,
+  *         see OPENBL_ENGINE_GroupCommand.
   * @retval None.
   */
-void OPENBL_CAN_ReadoutUnprotect(void)
+void OPENBL_CAN_GroupCommand(void)
 {
-  OPENBL_CAN_SendByte(ACK_BYTE);
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_NONE);
 
-  OPENBL_CAN_SendByte(ACK_BYTE);
+  OPENBL_ENGINE_GroupCommand(&CanHandle);
+}
 
-  /* Disable the read protection */
-  OPENBL_MEM_SetReadOutProtection(OPENBL_DEFAULT_MEM, DISABLE);
+/**
+  * @brief  This function is used to send the statistics recorded by the Open Bootloader, see
+  *         OPENBL_ENGINE_GetStatistics. The report is sent in 8-byte frames, by blocks requested
+  *         by the host flow control frames.
+  * @retval None.
+  */
+void OPENBL_CAN_GetStatistics(void)
+{
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_FLOW_CONTROL);
 
-  /* Start post processing task if needed */
-  Common_StartPostProcessing();
+  OPENBL_ENGINE_GetStatistics(&CanHandle);
 }
 
 /**
-  * @brief  This function is used to erase a memory.
+  * @brief  This function is used to program in the Flash an image staged in RAM, see OPENBL_MEM_Commit.
+  *         The command frame holds the Flash address and the image length, the next frame its CRC-32.
   * @retval None.
   */
-void OPENBL_CAN_LegacyEraseMemory(void)
+void OPENBL_CAN_CommitMemory(void)
 {
-  ErrorStatus error_value;
-  uint8_t a_erase_buffer[CAN_RAM_BUFFER_SIZE * 2];
-  uint8_t nsectors;
-  uint8_t count;
-  uint8_t single;
-  uint8_t status = ACK_BYTE;
-  uint8_t data_length;
-  uint8_t index;
-
-  /* Check if the memory is protected or not */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_CAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_CAN_SendByte(ACK_BYTE);
+  OPENBL_CAN_StartCommand(CAN_TRANSFER_NONE);
 
-    /* Read number of pages to be erased */
-    nsectors = (uint8_t)tCanRxData[0] + 1U;
-
-    a_erase_buffer[0] = nsectors;
-    a_erase_buffer[1] = 0x00;
+  OPENBL_ENGINE_CommitMemory(&CanHandle);
+}
 
-    /* All commands in range 0xFF are reserved for special erase features */
-    if (((nsectors - 1U) == 0xFFU))
-    {
-      error_value = OPENBL_MEM_MassErase(OPENBL_DEFAULT_MEM, tCanRxData, CAN_RAM_BUFFER_SIZE);
+/* Private functions ---------------------------------------------------------*/
 
-      if (error_value == SUCCESS)
-      {
-        status = ACK_BYTE;
-        OPENBL_CAN_SendByte(ACK_BYTE);
-      }
-      else
-      {
-        status = NACK_BYTE;
-      }
-    }
-    else
-    {
-      OPENBL_CAN_SendByte(ACK_BYTE);
+/**
+  * @brief  This function is used to prepare the transport for a new command.
+  * @param  Mode The acknowledge or flow control of the data frames, CAN_TRANSFER_xxx.
+  * @retval None.
+  */
+static void OPENBL_CAN_StartCommand(uint8_t Mode)
+{
+  CanTransfer.ParamIndex = 0U;
+  CanTransfer.Frames     = 0U;
+  CanTransfer.Mode       = Mode;
+  CanTransfer.FlowStatus = CAN_FC_CONTINUE_TO_SEND;
+  CanTransfer.Separation = 0U;
+}
 
-      count       = nsectors / 8U;
-      single      = nsectors % 8U;
-      data_length = 0;
+/**
+  * @brief  This function is used to receive data from the host in 8-byte frames, the last one may be shorter.
+  *         In flow control mode, a flow control frame granting CAN_BLOCK_FRAMES frames is sent before each
+  *         block, except in group mode where the host paces the blocks by itself.
+  * @param  pBuffer Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes to be received.
+  * @retval None.
+  */
+static void OPENBL_CAN_ReadFrame(uint8_t *pBuffer, uint32_t Length)
+{
+  uint32_t offset = 0U;
+  uint32_t frame_length;
+  uint32_t counter;
+  uint8_t frame[CAN_FRAME_DATA_SIZE];
+  uint8_t flow_control[CAN_FC_FRAME_LENGTH];
 
-      if (count != 0U)
+  while (offset < Length)
+  {
+    if ((CanTransfer.Mode == CAN_TRANSFER_FLOW_CONTROL) && (CanTransfer.Frames == 0U))
+    {
+      if (OPENBL_ENGINE_GetGroupId() == 0U)
       {
-        while (data_length != count)
-        {
-          OPENBL_CAN_ReadBytes(&tCanRxData[(data_length * 8U) + 1U], CAN_DLC_BYTES_8);
-          OPENBL_CAN_SendByte(ACK_BYTE);
+        flow_control[0] = CAN_FC_CONTINUE_TO_SEND;
+        flow_control[1] = (uint8_t)CAN_BLOCK_FRAMES;
+        flow_control[2] = 0x00U; /* No minimum separation time between frames */
 
-          data_length++;
-        }
+        OPENBL_CAN_SendBytes(flow_control, CAN_FC_FRAME_LENGTH);
       }
 
-      if (single != 0U)
-      {
-        OPENBL_CAN_ReadBytes(&tCanRxData[(nsectors - single) + 1U], CAN_DLC_BYTES_8);
-      }
-
-      index = 2;
+      CanTransfer.Frames = CAN_BLOCK_FRAMES;
+    }
 
-      while (index <= ((nsectors * 2U) + 1U))
-      {
-        a_erase_buffer[index]      = tCanRxData[index / 2U];
-        a_erase_buffer[index + 1U] = 0x00;
-        index                      += 2U;
-      }
+    OPENBL_CAN_ReadBytes(frame, CAN_DLC_BYTES_8);
 
-      /* Receive the list of pages to be erased (each page number is on one byte) */
-      error_value = OPENBL_MEM_Erase(OPENBL_DEFAULT_MEM, a_erase_buffer, CAN_RAM_BUFFER_SIZE * 2U);
+    frame_length = ((Length - offset) > CAN_FRAME_DATA_SIZE) ? CAN_FRAME_DATA_SIZE : (Length - offset);
 
-      /* Errors from memory erase are not managed, always return ACK */
-      if (error_value == SUCCESS)
-      {
-        status = ACK_BYTE;
-      }
+    for (counter = 0U; counter < frame_length; counter++)
+    {
+      pBuffer[offset + counter] = frame[counter];
     }
 
-    /* Send status byte (ACK/NACK) */
-    OPENBL_CAN_SendByte(status);
+    offset += frame_length;
+
+    if (CanTransfer.Mode == CAN_TRANSFER_FLOW_CONTROL)
+    {
+      CanTransfer.Frames--;
+    }
+    else if ((CanTransfer.Mode == CAN_TRANSFER_ACK_ALL)
+             || ((CanTransfer.Mode == CAN_TRANSFER_ACK_FULL) && (frame_length == CAN_FRAME_DATA_SIZE)))
+    {
+      OPENBL_ENGINE_SendStatus(&CanHandle, ACK_BYTE);
+    }
+    else
+    {
+      /* The data frames of this command are not acknowledged */
+    }
   }
 }
 
 /**
-  * @brief  This function is used to enable write protect.
+  * @brief  This function is used to send data to the host in 8-byte frames, the last one may be shorter.
+  *         In flow control mode, the host sends a flow control frame [status, block size, separation time]
+  *         before each block, a block size of 0 means that all the remaining frames can be sent without waiting.
+  *         Once the host aborted the transfer, nothing more is sent.
+  * @param  pBuffer Pointer to the data.
+  * @param  Length The number of bytes to be sent.
   * @retval None.
   */
-void OPENBL_CAN_WriteProtect(void)
+static void OPENBL_CAN_SendFrame(uint8_t *pBuffer, uint32_t Length)
 {
-  ErrorStatus error_value;
-  uint8_t length;
-  uint8_t count;
-  uint8_t single;
-  uint8_t data_length;
-
-  /* Check if the memory is protected or not */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_CAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_CAN_SendByte(ACK_BYTE);
+  uint32_t offset = 0U;
+  uint32_t frame_length;
+  uint8_t flow_control[CAN_FRAME_DATA_SIZE] = {0U};
 
-    length = tCanRxData[0] + 1U;
-    count  = length / 8U;
-    single = length % 8U;
+  while ((offset < Length) && (CanTransfer.FlowStatus == CAN_FC_CONTINUE_TO_SEND))
+  {
+    /* Wait for the host flow control frame before each block */
+    if ((CanTransfer.Mode == CAN_TRANSFER_FLOW_CONTROL) && (CanTransfer.Frames == 0U))
+    {
+      OPENBL_CAN_ReadBytes(flow_control, CAN_DLC_BYTES_8);
 
-    data_length = 0;
+      CanTransfer.FlowStatus = flow_control[0];
+      CanTransfer.Frames     = (flow_control[1] == 0U) ? CAN_FC_ALL_FRAMES : (uint32_t)flow_control[1];
+      CanTransfer.Separation = flow_control[2];
+    }
 
-    if (count != 0U)
+    if (CanTransfer.FlowStatus == CAN_FC_CONTINUE_TO_SEND)
     {
-      while (data_length != count)
+      /* Separation time in milliseconds between two consecutive frames */
+      if ((CanTransfer.Separation != 0U) && (CanTransfer.Separation <= CAN_FC_SEPARATION_MAX))
       {
-        OPENBL_CAN_ReadBytes(&tCanRxData[(data_length * 8U) + 1U], CAN_DLC_BYTES_8);
-        OPENBL_CAN_SendByte(ACK_BYTE);
-
-        data_length++;
+        HAL_Delay((uint32_t)CanTransfer.Separation);
       }
-    }
 
-    if (single != 0U)
-    {
-      OPENBL_CAN_ReadBytes(&tCanRxData[1U + (length - single)], CAN_DLC_BYTES_8);
-      OPENBL_CAN_SendByte(ACK_BYTE);
-    }
+      frame_length = ((Length - offset) > CAN_FRAME_DATA_SIZE) ? CAN_FRAME_DATA_SIZE : (Length - offset);
 
-    /* Enable the write protection */
-    error_value = OPENBL_MEM_SetWriteProtection(ENABLE, OPENBL_DEFAULT_MEM, (uint8_t *) &tCanRxData[1], length);
+      /* The DLC of a classic CAN frame is its number of bytes */
+      OPENBL_CAN_SendBytes(&pBuffer[offset], frame_length);
 
-    OPENBL_CAN_SendByte(ACK_BYTE);
+      offset += frame_length;
 
-    if (error_value == SUCCESS)
-    {
-      Common_StartPostProcessing();
+      if (CanTransfer.Mode == CAN_TRANSFER_FLOW_CONTROL)
+      {
+        CanTransfer.Frames--;
+      }
     }
   }
 }
 
 /**
-  * @brief  This function is used to disable write protect.
+  * @brief  This function is used to send an acknowledge, a NACK once the host aborted the transfer.
+  * @param  Ack The acknowledge byte, ACK_BYTE or NACK_BYTE.
   * @retval None.
   */
-void OPENBL_CAN_WriteUnprotect(void)
+static void OPENBL_CAN_SendAck(uint8_t Ack)
 {
-  ErrorStatus error_value;
-
-  /* Check if the memory is not protected */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_CAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_CAN_SendByte(ACK_BYTE);
-
-    /* Disable write protection */
-    error_value = OPENBL_MEM_SetWriteProtection(DISABLE, OPENBL_DEFAULT_MEM, NULL, 0);
+  OPENBL_CAN_SendByte((CanTransfer.FlowStatus == CAN_FC_CONTINUE_TO_SEND) ? Ack : NACK_BYTE);
+}
 
-    OPENBL_CAN_SendByte(ACK_BYTE);
+/**
+  * @brief  This function is used to read the parameters of the command frame in order.
+  *         The parameters beyond the 8 bytes of the command frame are sent in the next frames.
+  * @param  pBuffer Pointer to the parameters.
+  * @param  Length The number of bytes.
+  * @retval None.
+  */
+static void OPENBL_CAN_ReadParameters(uint8_t *pBuffer, uint32_t Length)
+{
+  uint32_t counter;
 
-    if (error_value == SUCCESS)
+  for (counter = 0U; counter < Length; counter++)
+  {
+    if (CanTransfer.ParamIndex == CAN_FRAME_DATA_SIZE)
     {
-      Common_StartPostProcessing();
+      OPENBL_CAN_ReadBytes(tCanRxData, CAN_DLC_BYTES_8);
+
+      CanTransfer.ParamIndex = 0U;
     }
+
+    pBuffer[counter] = tCanRxData[CanTransfer.ParamIndex];
+    CanTransfer.ParamIndex++;
   }
 }
 
-/* Private functions ---------------------------------------------------------*/
-
 /**
   * @brief  This function is used to construct the command List table.
   * @return Returns the number of supported commands.
@@ -679,31 +690,54 @@ static uint8_t OPENBL_CAN_ConstructCommandsTable(OPENBL_CommandsTypeDef *pCanCmd
     i++;
   }
 
-  return (i);
-}
+  if (pCanCmd->ExtendedReadMemory != NULL)
+  {
+    a_OPENBL_CAN_CommandsList[i] = CMD_EXT_READ_MEMORY;
+    i++;
+  }
 
-/**
-  * @brief  This function is used to get a valid address.
-  * @retval Returns NACK status in case of error else returns ACK status.
-  */
-static uint8_t OPENBL_CAN_GetAddress(uint32_t *Address)
-{
-  uint8_t status;
+  if (pCanCmd->ExtendedWriteMemory != NULL)
+  {
+    a_OPENBL_CAN_CommandsList[i] = CMD_EXT_WRITE_MEMORY;
+    i++;
+  }
 
-  *Address = (((((uint32_t)tCanRxData[0]) << 24) |
-               (((uint32_t)tCanRxData[1]) << 16) |
-               (((uint32_t)tCanRxData[2]) << 8)  |
-               (((uint32_t)tCanRxData[3]))));
+  if (pCanCmd->GroupCommand != NULL)
+  {
+    a_OPENBL_CAN_CommandsList[i] = CMD_GROUP_COMMAND;
+    i++;
+  }
 
-  /* Check if received address is valid or not */
-  if (OPENBL_MEM_GetAddressArea(*Address) == AREA_ERROR)
+  if (pCanCmd->GetStatistics != NULL)
   {
-    status = NACK_BYTE;
+    a_OPENBL_CAN_CommandsList[i] = CMD_GET_STATISTICS;
+    i++;
   }
-  else
+
+  if ((pCanCmd->CommitMemory != NULL) && (OPENBL_STAGING_ENABLE == 1U))
+  {
+    a_OPENBL_CAN_CommandsList[i] = CMD_COMMIT_MEMORY;
+    i++;
+  }
+
+  if ((pCanCmd->CompressedWriteMemory != NULL) && (OPENBL_COMPRESSED_WRITE_ENABLE == 1U))
+  {
+    a_OPENBL_CAN_CommandsList[i] = CMD_COMPRESSED_WRITE_MEMORY;
+    i++;
+  }
+
+  if ((pCanCmd->PatchMemory != NULL) && (OPENBL_PATCH_ENABLE == 1U))
+  {
+    a_OPENBL_CAN_CommandsList[i] = CMD_PATCH_MEMORY;
+    i++;
+  }
+
+  if ((pCanCmd->GetBlockCrc != NULL) && (OPENBL_BLOCK_CRC_ENABLE == 1U))
   {
-    status = ACK_BYTE;
+    a_OPENBL_CAN_CommandsList[i] = CMD_GET_BLOCK_CRC;
+    i++;
   }
 
-  return status;
+  return (i);
 }
+
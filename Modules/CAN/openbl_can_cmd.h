@@ -51,6 +51,14 @@ void OPENBL_CAN_ReadoutUnprotect(void);
 void OPENBL_CAN_LegacyEraseMemory(void);
 void OPENBL_CAN_WriteProtect(void);
 void OPENBL_CAN_WriteUnprotect(void);
+void OPENBL_CAN_ExtendedReadMemory(void);
+void OPENBL_CAN_ExtendedWriteMemory(void);
+void OPENBL_CAN_GroupCommand(void);
+void OPENBL_CAN_GetStatistics(void);
+void OPENBL_CAN_CommitMemory(void);
+void OPENBL_CAN_CompressedWriteMemory(void);
+void OPENBL_CAN_PatchMemory(void);
+void OPENBL_CAN_GetBlockCrc(void);
 
 #ifdef __cplusplus
 }
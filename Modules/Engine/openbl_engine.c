@@ -0,0 +1,1765 @@
+/**
+  ******************************************************************************
+  * @file    openbl_engine.c
+  * @author  MCD Application Team
+  * @brief   Contains the commands shared by the Open Bootloader protocols
+  *          The commands are run over the block transport of the interface: each
+  *          phase of the protocol (address, length, data and checksum...) is read
+  *          as one frame and acknowledged, so the framing of each bus is kept in
+  *          its own module while the command logic is implemented once.
+  *          The USB CDC interface runs the USART commands through their transport.
+  *          The CAN and FDCAN protocols carry the parameters in the command frame,
+  *          without checksum nor acknowledge between the phases: their transport
+  *          reads them with ReadParameters (OPENBL_ENGINE_FRAMING_COMMAND_FRAME)
+  *          and the command is acknowledged once they are checked.
+  *          The I3C protocol keeps its own read, write, erase and write protect
+  *          commands, transferred in loops with progress notifications, and runs
+  *          the other ones here as each of their phases is one private transfer.
+  *          While a node is in a group, the responses of the write and erase
+  *          commands are latched instead of being sent, see OPENBL_ENGINE_SendStatus.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "openbl_mem.h"
+#include "openbl_engine.h"
+#include "openbl_perf.h"
+
+#include "openbootloader_conf.h"
+#include "app_openbootloader.h"
+#include "common_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint8_t GroupId;     /* Group joined by this node, 0 when not in group mode */
+  uint8_t Status;      /* Latched status of the group operations: ACK_BYTE or NACK_BYTE */
+  uint8_t ErrorCount;  /* Number of failed group operations */
+  uint32_t Crc;        /* CRC-32 of the data written in group mode, as read back from memory */
+} OPENBL_ENGINE_GroupTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define ENGINE_ERASE_SPECIAL_MASK         0xFFF0U   /* Numbers of pages 0xFFFZ are the special erase features */
+#define ENGINE_DECODED_OFFSET             260U      /* Decoded data placed after the 256 bytes, checksum included */
+
+#define ENGINE_GROUP_JOIN                 0x01U     /* Group sub-command: join a group */
+#define ENGINE_GROUP_LEAVE                0x02U     /* Group sub-command: leave a group */
+#define ENGINE_GROUP_STATUS               0x03U     /* Group sub-command: collect the status of one node */
+#define ENGINE_GROUP_STATUS_SIZE          6U        /* Status, error count and CRC-32 */
+#define ENGINE_GROUP_FRAME_SIZE           8U        /* Status frame of the command frame protocols, zero padded */
+#define ENGINE_GROUP_ALL_NODES            0xFFFFFFFFU /* Node identifier addressing all the nodes */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static OPENBL_ENGINE_GroupTypeDef EngineGroup = {0U};
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t OPENBL_ENGINE_Xor(const uint8_t *pData, uint32_t Length, uint8_t Xor);
+static void OPENBL_ENGINE_SetBusy(const OPENBL_ENGINE_HandleTypeDef *pHandle, FunctionalState State);
+static void OPENBL_ENGINE_SendResponse(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint32_t Length);
+static void OPENBL_ENGINE_SendStreamAck(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t Ack);
+static void OPENBL_ENGINE_SendFrameAck(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t Ack);
+static void OPENBL_ENGINE_ReadParameters(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t *pData,
+                                         uint32_t Length);
+static uint8_t OPENBL_ENGINE_GetParameters(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t *pData,
+                                           uint32_t Length);
+static uint8_t OPENBL_ENGINE_GetData(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t *pData, uint32_t Length,
+                                     uint8_t Xor);
+static uint8_t OPENBL_ENGINE_ReadChecksum(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t Xor);
+static uint8_t OPENBL_ENGINE_GetExtendedSize(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint32_t Address,
+                                             uint32_t *pSize);
+static uint8_t OPENBL_ENGINE_ErasePages(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint32_t NumberOfPages,
+                                        uint8_t Xor);
+static uint8_t OPENBL_ENGINE_GetSpecialCmdOpCode(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint16_t *pOpCode,
+                                                 OPENBL_SpecialCmdTypeTypeDef CmdType);
+static uint8_t OPENBL_ENGINE_GetSpecialCmdBuffer(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t *pData,
+                                                 uint16_t *pSize, uint16_t SizeMax);
+static void OPENBL_ENGINE_WriteEncoded(const OPENBL_ENGINE_HandleTypeDef *pHandle,
+                                       ErrorStatus (*Decode)(uint32_t Address, uint8_t *pData, uint32_t Length,
+                                                             uint8_t *pBuffer, uint32_t BufferSize,
+                                                             uint32_t *pSize),
+                                       uint32_t Enable);
+static void OPENBL_ENGINE_GroupFrameCommand(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+static void OPENBL_ENGINE_GroupStreamCommand(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+
+/* Exported functions---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to get the list of the available commands.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_GetCommand(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  uint32_t counter;
+
+  /* Number of commands, protocol version then the list of supported commands */
+  pHandle->pBuffer[0] = pHandle->CommandsNumber;
+  pHandle->pBuffer[1] = pHandle->Version;
+
+  for (counter = 0U; counter < pHandle->CommandsNumber; counter++)
+  {
+    pHandle->pBuffer[counter + 2U] = pHandle->pCommandsList[counter];
+  }
+
+  OPENBL_ENGINE_SendResponse(pHandle, (uint32_t)pHandle->CommandsNumber + 2U);
+}
+
+/**
+  * @brief  This function is used to get the protocol version.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_GetVersion(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  uint32_t length = 1U;
+
+  pHandle->pBuffer[0] = pHandle->Version;
+
+  /* The USART protocol follows the version with the two option bytes */
+  if ((pHandle->Framing & OPENBL_ENGINE_FRAMING_VERSION_OPTIONS) != 0U)
+  {
+    pHandle->pBuffer[1] = 0x00U;
+    pHandle->pBuffer[2] = 0x00U;
+    length              = 3U;
+  }
+
+  OPENBL_ENGINE_SendResponse(pHandle, length);
+}
+
+/**
+  * @brief  This function is used to get the device ID.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_GetID(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  /* Number of bytes - 1, then the device ID starting by the MSB byte */
+  pHandle->pBuffer[0] = 0x01U;
+  pHandle->pBuffer[1] = DEVICE_ID_MSB;
+  pHandle->pBuffer[2] = DEVICE_ID_LSB;
+
+  OPENBL_ENGINE_SendResponse(pHandle, 3U);
+}
+
+/**
+  * @brief  This function is used to read memory from the device.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_ReadMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  uint32_t address;
+  uint32_t counter;
+  uint32_t length;
+  uint32_t memory_index;
+  uint8_t status = ACK_BYTE;
+  uint8_t data[2];
+
+  /* Check memory protection then send adequate response */
+  if (Common_GetProtectionStatus() != RESET)
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    OPENBL_ENGINE_SendStreamAck(pHandle, ACK_BYTE);
+
+    /* Get the memory address */
+    if (OPENBL_ENGINE_GetAddress(pHandle, &address) == NACK_BYTE)
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+    }
+    else
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+      /* Get the number of bytes to be read, followed by its complement out of the command frame */
+      if ((pHandle->Framing & OPENBL_ENGINE_FRAMING_COMMAND_FRAME) != 0U)
+      {
+        pHandle->pTransport->ReadParameters(data, 1U);
+      }
+      else
+      {
+        pHandle->pTransport->ReadFrame(data, 2U);
+
+        status = ((data[0] ^ data[1]) != 0xFFU) ? NACK_BYTE : ACK_BYTE;
+      }
+
+      OPENBL_ENGINE_SendStreamAck(pHandle, status);
+
+      if (status == ACK_BYTE)
+      {
+        /* Get the memory index to know from which memory we will read */
+        memory_index = OPENBL_MEM_GetMemoryIndex(address);
+        length       = (uint32_t)data[0] + 1U;
+
+        /* Read the data (data + 1) from the memory and send them to the host in one frame */
+        for (counter = 0U; counter < length; counter++)
+        {
+          pHandle->pBuffer[counter] = OPENBL_MEM_Read(address, memory_index);
+          address++;
+        }
+
+        pHandle->pTransport->SendFrame(pHandle->pBuffer, length);
+
+        OPENBL_ENGINE_SendFrameAck(pHandle, ACK_BYTE);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to write in to device memory.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_WriteMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  uint32_t address;
+  uint32_t codesize;
+  uint8_t data;
+
+  /* Check memory protection then send adequate response */
+  if (Common_GetProtectionStatus() != RESET)
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    OPENBL_ENGINE_SendStreamAck(pHandle, ACK_BYTE);
+
+    /* Get the memory address */
+    if (OPENBL_ENGINE_GetAddress(pHandle, &address) == NACK_BYTE)
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+    }
+    else
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+      /* Read the number of bytes to be written: Max number of data = data + 1 = 256 */
+      OPENBL_ENGINE_ReadParameters(pHandle, &data, 1U);
+
+      codesize = (uint32_t)data + 1U;
+
+      /* Receive the data and the checksum in the RAM buffer, send NACK if the checksum is incorrect */
+      if (OPENBL_ENGINE_GetData(pHandle, pHandle->pBuffer, codesize, data) == NACK_BYTE)
+      {
+        OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+      }
+      else
+      {
+        /* Write data to memory */
+        OPENBL_ENGINE_SetBusy(pHandle, ENABLE);
+        OPENBL_MEM_Write(address, pHandle->pBuffer, codesize);
+        OPENBL_ENGINE_SetBusy(pHandle, DISABLE);
+
+        OPENBL_ENGINE_TrackWrite(address, codesize);
+
+        /* Send last Acknowledge synchronization byte */
+        OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+        /* Start post processing task if needed */
+        Common_StartPostProcessing();
+      }
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to jump to the user application.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_Go(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  uint32_t address;
+
+  /* Check memory protection then send adequate response */
+  if (Common_GetProtectionStatus() != RESET)
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    /* The CAN protocol only acknowledges the command once the address is checked */
+    if (((pHandle->Framing & OPENBL_ENGINE_FRAMING_COMMAND_FRAME) == 0U)
+        || ((pHandle->Framing & OPENBL_ENGINE_FRAMING_GO_ACK) != 0U))
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+    }
+
+    /* Get memory address */
+    if (OPENBL_ENGINE_GetAddress(pHandle, &address) == NACK_BYTE)
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+    }
+    else if (OPENBL_MEM_CheckJumpAddress(address) == 0U)
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+    }
+    else
+    {
+      /* If the jump address is valid then send ACK */
+      OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+      OPENBL_MEM_JumpToAddress(address);
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to enable readout protection.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_ReadoutProtect(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  /* Check memory protection then send adequate response */
+  if (Common_GetProtectionStatus() != RESET)
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+    /* Enable the read protection */
+    OPENBL_ENGINE_SetBusy(pHandle, ENABLE);
+    OPENBL_MEM_SetReadOutProtection(OPENBL_DEFAULT_MEM, ENABLE);
+    OPENBL_ENGINE_SetBusy(pHandle, DISABLE);
+
+    OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+    /* Start post processing task if needed */
+    Common_StartPostProcessing();
+  }
+}
+
+/**
+  * @brief  This function is used to disable readout protection.
+  * @note   Once the option bytes modification start bit is set in FLASH CR register,
+  *         all the RAM is erased, this causes the erase of the Open Bootloader RAM.
+  *         This is why the last ACK is sent before the call of OPENBL_MEM_SetReadOutProtection.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_ReadoutUnprotect(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+  OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+  /* Disable the read protection */
+  OPENBL_ENGINE_SetBusy(pHandle, ENABLE);
+  OPENBL_MEM_SetReadOutProtection(OPENBL_DEFAULT_MEM, DISABLE);
+  OPENBL_ENGINE_SetBusy(pHandle, DISABLE);
+
+  /* Start post processing task if needed */
+  Common_StartPostProcessing();
+}
+
+/**
+  * @brief  This function is used to erase a memory.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_EraseMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  ErrorStatus error_value;
+  uint32_t pages_count;
+  uint16_t number_of_pages;
+  uint8_t status = ACK_BYTE;
+  uint8_t data[2];
+  uint8_t xor;
+
+  /* Check if the memory is not protected */
+  if (Common_GetProtectionStatus() != RESET)
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+    /* Read number of pages to be erased */
+    OPENBL_ENGINE_ReadParameters(pHandle, data, 2U);
+
+    number_of_pages = ((uint16_t)data[0] << 8) | (uint16_t)data[1];
+    xor             = data[0] ^ data[1];
+
+    /* The FDCAN protocol sends the number of pages itself instead of the number minus one */
+    pages_count = (uint32_t)number_of_pages;
+
+    if ((pHandle->Framing & OPENBL_ENGINE_FRAMING_ITEMS_COUNT) == 0U)
+    {
+      pages_count++;
+    }
+
+    /* All commands in range 0xFFFZ are reserved for special erase features */
+    if ((number_of_pages & ENGINE_ERASE_SPECIAL_MASK) == ENGINE_ERASE_SPECIAL_MASK)
+    {
+      if (OPENBL_ENGINE_ReadChecksum(pHandle, xor) != xor)
+      {
+        status = NACK_BYTE;
+      }
+      else if ((number_of_pages == 0xFFFFU) || (number_of_pages == 0xFFFEU) || (number_of_pages == 0xFFFDU))
+      {
+        pHandle->pBuffer[0] = data[1];
+        pHandle->pBuffer[1] = data[0];
+
+        OPENBL_ENGINE_SetBusy(pHandle, ENABLE);
+        error_value = OPENBL_MEM_MassErase(OPENBL_DEFAULT_MEM, pHandle->pBuffer, pHandle->BufferSize);
+        OPENBL_ENGINE_SetBusy(pHandle, DISABLE);
+
+        status = (error_value == SUCCESS) ? ACK_BYTE : NACK_BYTE;
+      }
+      else
+      {
+        /* This sub-command is not supported */
+        status = NACK_BYTE;
+      }
+    }
+    else if ((pHandle->Framing & (OPENBL_ENGINE_FRAMING_SPLIT_LENGTH | OPENBL_ENGINE_FRAMING_COMMAND_FRAME)) != 0U)
+    {
+      /* The number of pages is acknowledged before the list of pages, with its own checksum on I2C and SPI */
+      if (OPENBL_ENGINE_ReadChecksum(pHandle, xor) != xor)
+      {
+        status = NACK_BYTE;
+      }
+      else
+      {
+        OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+        status = OPENBL_ENGINE_ErasePages(pHandle, pages_count, 0U);
+      }
+    }
+    else
+    {
+      /* The list of pages follows the number of pages, one checksum covers both */
+      status = OPENBL_ENGINE_ErasePages(pHandle, pages_count, xor);
+    }
+
+    OPENBL_ENGINE_SendStatus(pHandle, status);
+  }
+}
+
+/**
+  * @brief  This function is used to erase a memory with the legacy erase command of the CAN protocol.
+  *         The command frame holds the number of pages minus one, 0xFF requests a mass erase.
+  *         Otherwise the pages follow, one byte each, and only the full frames are acknowledged.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_LegacyEraseMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  ErrorStatus error_value;
+  uint32_t number_of_pages;
+  uint32_t counter;
+  uint8_t status = ACK_BYTE;
+  uint8_t data;
+
+  /* Check if the memory is not protected */
+  if (Common_GetProtectionStatus() != RESET)
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+    /* Read number of pages to be erased minus one */
+    OPENBL_ENGINE_ReadParameters(pHandle, &data, 1U);
+
+    if (data == 0xFFU)
+    {
+      /* Mass erase option 0xFFFF, LSB first */
+      pHandle->pBuffer[0] = 0xFFU;
+      pHandle->pBuffer[1] = 0xFFU;
+
+      OPENBL_ENGINE_SetBusy(pHandle, ENABLE);
+      error_value = OPENBL_MEM_MassErase(OPENBL_DEFAULT_MEM, pHandle->pBuffer, pHandle->BufferSize);
+      OPENBL_ENGINE_SetBusy(pHandle, DISABLE);
+
+      /* A successful mass erase is acknowledged twice */
+      if (error_value == SUCCESS)
+      {
+        OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+      }
+      else
+      {
+        status = NACK_BYTE;
+      }
+    }
+    else
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+      number_of_pages = (uint32_t)data + 1U;
+
+      /* Receive the list of pages to be erased (each page number is on one byte) */
+      pHandle->pTransport->ReadFrame(&pHandle->pBuffer[2], number_of_pages);
+
+      /* Store each page on two bytes LSB first after their number, as expected by OPENBL_MEM_Erase */
+      for (counter = number_of_pages; counter != 0U; counter--)
+      {
+        pHandle->pBuffer[2U * counter]        = pHandle->pBuffer[counter + 1U];
+        pHandle->pBuffer[(2U * counter) + 1U] = 0x00U;
+      }
+
+      pHandle->pBuffer[0] = (uint8_t)(number_of_pages & 0x00FFU);
+      pHandle->pBuffer[1] = (uint8_t)((number_of_pages & 0xFF00U) >> 8);
+
+      OPENBL_ENGINE_SetBusy(pHandle, ENABLE);
+
+      /* Errors from memory erase are not managed, always return ACK */
+      (void)OPENBL_MEM_Erase(OPENBL_DEFAULT_MEM, pHandle->pBuffer, pHandle->BufferSize);
+
+      OPENBL_ENGINE_SetBusy(pHandle, DISABLE);
+    }
+
+    /* Send status byte (ACK/NACK) */
+    OPENBL_ENGINE_SendStatus(pHandle, status);
+  }
+}
+
+/**
+  * @brief  This function is used to enable write protect.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_WriteProtect(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  ErrorStatus error_value = ERROR;
+  uint32_t length;
+  uint8_t status = ACK_BYTE;
+  uint8_t checksum;
+  uint8_t data;
+  uint8_t xor;
+
+  /* Check if the memory is not protected */
+  if (Common_GetProtectionStatus() != RESET)
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+    /* Get the data length */
+    OPENBL_ENGINE_ReadParameters(pHandle, &data, 1U);
+
+    length = (uint32_t)data;
+    xor    = data;
+
+    /* The FDCAN protocol sends the number of sectors itself instead of the number minus one */
+    if ((pHandle->Framing & OPENBL_ENGINE_FRAMING_ITEMS_COUNT) == 0U)
+    {
+      length++;
+    }
+
+    /* The length has its own checksum and is acknowledged before the list of sectors */
+    if ((pHandle->Framing & OPENBL_ENGINE_FRAMING_SPLIT_LENGTH) != 0U)
+    {
+      pHandle->pTransport->ReadFrame(&checksum, 1U);
+
+      if ((checksum ^ data) != 0xFFU)
+      {
+        status = NACK_BYTE;
+      }
+      else
+      {
+        OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+        xor = 0U;
+      }
+    }
+
+    if (status == ACK_BYTE)
+    {
+      /* Receive the list of sectors and the checksum in the RAM buffer, the FDCAN command frame holds it */
+      if ((pHandle->Framing & OPENBL_ENGINE_FRAMING_ITEMS_COUNT) != 0U)
+      {
+        pHandle->pTransport->ReadParameters(pHandle->pBuffer, length);
+      }
+      else
+      {
+        status = OPENBL_ENGINE_GetData(pHandle, pHandle->pBuffer, length, xor);
+      }
+
+      if (status == ACK_BYTE)
+      {
+        /* Enable the write protection */
+        OPENBL_ENGINE_SetBusy(pHandle, ENABLE);
+        error_value = OPENBL_MEM_SetWriteProtection(ENABLE, OPENBL_DEFAULT_MEM, pHandle->pBuffer, length);
+        OPENBL_ENGINE_SetBusy(pHandle, DISABLE);
+      }
+    }
+
+    OPENBL_ENGINE_SendStatus(pHandle, status);
+
+    if (error_value == SUCCESS)
+    {
+      /* Start post processing task if needed */
+      Common_StartPostProcessing();
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to disable write protect.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_WriteUnprotect(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  ErrorStatus error_value;
+
+  /* Check if the memory is not protected */
+  if (Common_GetProtectionStatus() != RESET)
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+    /* Disable write protection */
+    OPENBL_ENGINE_SetBusy(pHandle, ENABLE);
+    error_value = OPENBL_MEM_SetWriteProtection(DISABLE, OPENBL_DEFAULT_MEM, NULL, 0U);
+    OPENBL_ENGINE_SetBusy(pHandle, DISABLE);
+
+    OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+    if (error_value == SUCCESS)
+    {
+      /* Start post processing task if needed */
+      Common_StartPostProcessing();
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to execute special command commands.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_SpecialCommand(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  OPENBL_SpecialCmdTypeDef *special_cmd;
+  uint16_t op_code;
+
+  /* Point to the RAM buffer to gain size and reliability */
+  special_cmd = (OPENBL_SpecialCmdTypeDef *)(void *)pHandle->pBuffer;
+
+  /* Send special command code acknowledgment */
+  OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+  /* Get the command operation code */
+  if (OPENBL_ENGINE_GetSpecialCmdOpCode(pHandle, &op_code, OPENBL_SPECIAL_CMD) == NACK_BYTE)
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    /* Send Operation code acknowledgment */
+    OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+    /* Initialize the special command frame */
+    special_cmd->CmdType = OPENBL_SPECIAL_CMD;
+    special_cmd->OpCode  = op_code;
+
+    if (OPENBL_ENGINE_GetSpecialCmdBuffer(pHandle, special_cmd->Buffer1, &special_cmd->SizeBuffer1,
+                                          SPECIAL_CMD_SIZE_BUFFER1) == NACK_BYTE)
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+    }
+    else
+    {
+      /* Send received size acknowledgment */
+      OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+      /* Process the special command */
+      pHandle->pTransport->SpecialCommandProcess(special_cmd);
+
+      /* NOTE: In case of any operation inside "SpecialCommandProcess" function that prevents the code
+       * from returning to here (reset operation...), to be compatible with the OpenBL protocol,
+       * the user must ensure sending the last ACK in the application side.
+       */
+
+      /* Send last acknowledgment */
+      OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to execute extended special command commands.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_ExtendedSpecialCommand(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  OPENBL_SpecialCmdTypeDef *special_cmd;
+  uint16_t op_code;
+
+  /* Point to the RAM buffer to gain size and reliability */
+  special_cmd = (OPENBL_SpecialCmdTypeDef *)(void *)pHandle->pBuffer;
+
+  /* Send extended special command code acknowledgment */
+  OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+  /* Get the command operation code */
+  if (OPENBL_ENGINE_GetSpecialCmdOpCode(pHandle, &op_code, OPENBL_EXTENDED_SPECIAL_CMD) == NACK_BYTE)
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    /* Send Operation code acknowledgment */
+    OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+    /* Initialize the special command frame */
+    special_cmd->CmdType = OPENBL_EXTENDED_SPECIAL_CMD;
+    special_cmd->OpCode  = op_code;
+
+    if (OPENBL_ENGINE_GetSpecialCmdBuffer(pHandle, special_cmd->Buffer1, &special_cmd->SizeBuffer1,
+                                          SPECIAL_CMD_SIZE_BUFFER1) == NACK_BYTE)
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+    }
+    else
+    {
+      /* Send receive size acknowledgment */
+      OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+      if (OPENBL_ENGINE_GetSpecialCmdBuffer(pHandle, special_cmd->Buffer2, &special_cmd->SizeBuffer2,
+                                            SPECIAL_CMD_SIZE_BUFFER2) == NACK_BYTE)
+      {
+        OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+      }
+      else
+      {
+        /* Send receive write size acknowledgment */
+        OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+        /* Process the special command */
+        pHandle->pTransport->SpecialCommandProcess(special_cmd);
+
+        /* NOTE: In case of any operation inside "SpecialCommandProcess" function that prevents the code
+         * from returning to here (reset operation...), to be compatible with the OpenBL protocol,
+         * the user must ensure sending the last ACK in the application side.
+         */
+
+        /* Send last acknowledgment */
+        OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to read memory from the device using a 32-bit length.
+  *         The address and the length (MSB first) are followed by their checksum out of the command frame.
+  *         The data is sent by blocks of OPENBL_ENGINE_EXT_BLOCK_SIZE bytes without intermediate acknowledge,
+  *         the transport paces the frames of each block.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_ExtendedReadMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  uint32_t address;
+  uint32_t size;
+  uint32_t length;
+  uint32_t counter;
+  uint32_t memory_index;
+
+  /* Check memory protection then send adequate response */
+  if (Common_GetProtectionStatus() != RESET)
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    OPENBL_ENGINE_SendStreamAck(pHandle, ACK_BYTE);
+
+    if ((OPENBL_ENGINE_GetAddress(pHandle, &address) == NACK_BYTE)
+        || (OPENBL_ENGINE_GetExtendedSize(pHandle, address, &size) == NACK_BYTE))
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+    }
+    else
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+      /* Get the memory index to know from which memory we will read */
+      memory_index = OPENBL_MEM_GetMemoryIndex(address);
+
+      while (size != 0U)
+      {
+        length = (size > OPENBL_ENGINE_EXT_BLOCK_SIZE) ? OPENBL_ENGINE_EXT_BLOCK_SIZE : size;
+
+        for (counter = 0U; counter < length; counter++)
+        {
+          pHandle->pBuffer[counter] = OPENBL_MEM_Read(address, memory_index);
+          address++;
+        }
+
+        pHandle->pTransport->SendFrame(pHandle->pBuffer, length);
+
+        size -= length;
+      }
+
+      /* Send last Acknowledge synchronization byte, the transport turns it to NACK if the host aborted */
+      OPENBL_ENGINE_SendFrameAck(pHandle, ACK_BYTE);
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to write in to device memory using a 32-bit length.
+  *         The address and the length (MSB first) are followed by their checksum out of the command frame.
+  *         The data is received by blocks of OPENBL_ENGINE_EXT_BLOCK_SIZE bytes, each block is written then
+  *         acknowledged, the last acknowledge ending the command. With OPENBL_ENGINE_FRAMING_FLOW_CONTROL,
+  *         the transport paces the blocks and the command is acknowledged once at the end.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_ExtendedWriteMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  uint32_t address;
+  uint32_t size;
+  uint32_t length;
+
+  /* Check memory protection then send adequate response */
+  if (Common_GetProtectionStatus() != RESET)
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    OPENBL_ENGINE_SendStreamAck(pHandle, ACK_BYTE);
+
+    if ((OPENBL_ENGINE_GetAddress(pHandle, &address) == NACK_BYTE)
+        || (OPENBL_ENGINE_GetExtendedSize(pHandle, address, &size) == NACK_BYTE))
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+    }
+    else
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+      while (size != 0U)
+      {
+        length = (size > OPENBL_ENGINE_EXT_BLOCK_SIZE) ? OPENBL_ENGINE_EXT_BLOCK_SIZE : size;
+
+        /* Receive the block, the last frame of the transfer may be shorter than the others */
+        pHandle->pTransport->ReadFrame(pHandle->pBuffer, length);
+
+        /* Write the block to memory */
+        OPENBL_ENGINE_SetBusy(pHandle, ENABLE);
+        OPENBL_MEM_Write(address, pHandle->pBuffer, length);
+        OPENBL_ENGINE_SetBusy(pHandle, DISABLE);
+
+        OPENBL_ENGINE_TrackWrite(address, length);
+
+        address += length;
+        size    -= length;
+
+        if ((pHandle->Framing & OPENBL_ENGINE_FRAMING_FLOW_CONTROL) == 0U)
+        {
+          OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+        }
+      }
+
+      if ((pHandle->Framing & OPENBL_ENGINE_FRAMING_FLOW_CONTROL) != 0U)
+      {
+        /* Send last Acknowledge synchronization byte */
+        OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+      }
+
+      /* Start post processing task if needed */
+      Common_StartPostProcessing();
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to manage the group programming of several nodes sharing the same bus.
+  *         While in a group, the write and erase commands are executed without any response, their errors
+  *         are latched and reported by the status sub-command. The CRC-32 covers all the data written in
+  *         the group, read back from memory, in the order it was written.
+  *         In the command frame (CAN, FDCAN), the sub-command addresses the nodes by their ID:
+  *         - Join   [0x01, group, node ID (4 bytes)]: the addressed node (or all nodes for node ID 0xFFFFFFFF)
+  *           joins the group. Only an individually addressed node acknowledges it.
+  *         - Leave  [0x02, group]: the members of the group leave it, no response is sent.
+  *         - Status [0x03, group, node ID (4 bytes)]: the addressed member sends its status frame
+  *           [status, error count, CRC-32 (4 bytes MSB first), 0x00, 0x00].
+  *         Otherwise (I3C), the controller sends [sub-command, group, checksum] to each target individually,
+  *         each sub-command is acknowledged and the status is sent after the acknowledge without padding.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_GroupCommand(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  if ((pHandle->Framing & OPENBL_ENGINE_FRAMING_COMMAND_FRAME) != 0U)
+  {
+    OPENBL_ENGINE_GroupFrameCommand(pHandle);
+  }
+  else
+  {
+    OPENBL_ENGINE_GroupStreamCommand(pHandle);
+  }
+}
+
+/**
+  * @brief  This function is used to send the statistics recorded by the Open Bootloader.
+  *         The report length is sent MSB first then the report, see OPENBL_PERF_GetStatistics.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_GetStatistics(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  uint32_t length;
+
+  /* The report is placed after its length */
+  length = OPENBL_PERF_GetStatistics(&pHandle->pBuffer[2], pHandle->BufferSize - 2U);
+
+  if ((OPENBL_PERF_ENABLE == 0U) || (length == 0U))
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    pHandle->pBuffer[0] = (uint8_t)(length >> 8U);
+    pHandle->pBuffer[1] = (uint8_t)length;
+
+    OPENBL_ENGINE_SendResponse(pHandle, length + 2U);
+  }
+}
+
+/**
+  * @brief  This function is used to program in the Flash an image staged in RAM, see OPENBL_MEM_Commit.
+  *         The host sends the Flash address, then the image length and its CRC-32 (MSB first) followed by
+  *         their checksum. The last acknowledge is sent once the image is programmed and checked.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_CommitMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  ErrorStatus error_value;
+  uint32_t address;
+  uint32_t length;
+  uint32_t crc;
+  uint8_t data[9];
+
+  /* Check memory protection then send adequate response */
+  if ((Common_GetProtectionStatus() != RESET) || (OPENBL_STAGING_ENABLE == 0U))
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    OPENBL_ENGINE_SendStreamAck(pHandle, ACK_BYTE);
+
+    /* Get the Flash address */
+    if (OPENBL_ENGINE_GetAddress(pHandle, &address) == NACK_BYTE)
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+    }
+    else
+    {
+      OPENBL_ENGINE_SendStreamAck(pHandle, ACK_BYTE);
+
+      /* Read the image length and CRC-32 then their checksum */
+      if (OPENBL_ENGINE_GetParameters(pHandle, data, 8U) == NACK_BYTE)
+      {
+        OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+      }
+      else
+      {
+        OPENBL_ENGINE_SendFrameAck(pHandle, ACK_BYTE);
+
+        length = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+        crc    = ((uint32_t)data[4] << 24) | ((uint32_t)data[5] << 16) | ((uint32_t)data[6] << 8) | (uint32_t)data[7];
+
+        OPENBL_ENGINE_SetBusy(pHandle, ENABLE);
+        error_value = OPENBL_MEM_Commit(address, length, crc, pHandle->pBuffer, pHandle->BufferSize);
+        OPENBL_ENGINE_SetBusy(pHandle, DISABLE);
+
+        if (error_value == SUCCESS)
+        {
+          OPENBL_ENGINE_TrackWrite(address, length);
+
+          OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+          /* Start post processing task if needed */
+          Common_StartPostProcessing();
+        }
+        else
+        {
+          OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+        }
+      }
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to write in to device memory data compressed in the LZ4 block format,
+  *         see OPENBL_MEM_WriteCompressed.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_CompressedWriteMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  OPENBL_ENGINE_WriteEncoded(pHandle, OPENBL_MEM_WriteCompressed, OPENBL_COMPRESSED_WRITE_ENABLE);
+}
+
+/**
+  * @brief  This function is used to write in to device memory a new image built by a delta patch
+  *         from the old one, see OPENBL_MEM_WritePatch.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_PatchMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  OPENBL_ENGINE_WriteEncoded(pHandle, OPENBL_MEM_WritePatch, OPENBL_PATCH_ENABLE);
+}
+
+/**
+  * @brief  This function is used to send the CRC-32 of consecutive memory blocks, see OPENBL_MEM_GetBlockCrc.
+  *         The host sends the start address, then the block size (MSB first) and the number of blocks minus one
+  *         followed by their checksum. Once computed, the CRCs are sent in one frame, 4 bytes per block.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+void OPENBL_ENGINE_GetBlockCrc(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  ErrorStatus error_value;
+  uint32_t address;
+  uint32_t block_size;
+  uint32_t blocks_number;
+  uint8_t data[6];
+
+  /* Check memory protection then send adequate response */
+  if ((Common_GetProtectionStatus() != RESET) || (OPENBL_BLOCK_CRC_ENABLE == 0U))
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    OPENBL_ENGINE_SendStreamAck(pHandle, ACK_BYTE);
+
+    /* Get the memory address */
+    if (OPENBL_ENGINE_GetAddress(pHandle, &address) == NACK_BYTE)
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+    }
+    else
+    {
+      OPENBL_ENGINE_SendStreamAck(pHandle, ACK_BYTE);
+
+      /* Read the block size and the number of blocks minus one then their checksum */
+      if (OPENBL_ENGINE_GetParameters(pHandle, data, 5U) == NACK_BYTE)
+      {
+        OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+      }
+      else
+      {
+        block_size    = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8)
+                        | (uint32_t)data[3];
+        blocks_number = (uint32_t)data[4] + 1U;
+
+        OPENBL_ENGINE_SetBusy(pHandle, ENABLE);
+        error_value = OPENBL_MEM_GetBlockCrc(address, block_size, blocks_number, pHandle->pBuffer);
+        OPENBL_ENGINE_SetBusy(pHandle, DISABLE);
+
+        if (error_value == SUCCESS)
+        {
+          OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+          pHandle->pTransport->SendFrame(pHandle->pBuffer, blocks_number * 4U);
+
+          OPENBL_ENGINE_SendFrameAck(pHandle, ACK_BYTE);
+        }
+        else
+        {
+          OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+        }
+      }
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to get a valid address, sent MSB first followed by its checksum
+  *         out of the command frame. It is also used by the interface specific commands.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @param  pAddress Pointer to the address to be returned.
+  * @retval Returns NACK status in case of error else returns ACK status.
+  */
+uint8_t OPENBL_ENGINE_GetAddress(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint32_t *pAddress)
+{
+  uint8_t data[5];
+  uint8_t status;
+
+  /* Address MSB first then its checksum, check the integrity of received data */
+  status = OPENBL_ENGINE_GetParameters(pHandle, data, 4U);
+
+  if (status == ACK_BYTE)
+  {
+    *pAddress = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+
+    /* Check if received address is valid or not */
+    if (OPENBL_MEM_GetAddressArea(*pAddress) == AREA_ERROR)
+    {
+      status = NACK_BYTE;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to check if an operation code is in the list of the special commands.
+  *         It is shared by all the protocols supporting the special commands.
+  * @param  OpCode The operation code.
+  * @param  CmdType Type of the command, special command or extended special command.
+  * @retval Returns NACK status if the operation code is unknown else returns ACK status.
+  */
+uint8_t OPENBL_ENGINE_CheckSpecialCmdOpCode(uint16_t OpCode, OPENBL_SpecialCmdTypeTypeDef CmdType)
+{
+  uint8_t status = NACK_BYTE;
+  uint8_t index;
+
+  if (CmdType == OPENBL_SPECIAL_CMD)
+  {
+    for (index = 0U; index < SPECIAL_CMD_MAX_NUMBER; index++)
+    {
+      if (SpecialCmdList[index] == OpCode)
+      {
+        status = ACK_BYTE;
+      }
+    }
+  }
+  else if (CmdType == OPENBL_EXTENDED_SPECIAL_CMD)
+  {
+    for (index = 0U; index < EXTENDED_SPECIAL_CMD_MAX_NUMBER; index++)
+    {
+      if (ExtendedSpecialCmdList[index] == OpCode)
+      {
+        status = ACK_BYTE;
+      }
+    }
+  }
+  else
+  {
+    /* Unknown command type */
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to send the status of a command step.
+  *         While the node is in a group, no status is sent and a NACK is latched in the group status.
+  *         It is also used by the interface specific commands.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @param  Status The status byte, ACK_BYTE or NACK_BYTE.
+  * @retval None.
+  */
+void OPENBL_ENGINE_SendStatus(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t Status)
+{
+  if (EngineGroup.GroupId == 0U)
+  {
+    pHandle->pTransport->SendAck(Status);
+  }
+  else if (Status == NACK_BYTE)
+  {
+    EngineGroup.Status = NACK_BYTE;
+
+    if (EngineGroup.ErrorCount < 0xFFU)
+    {
+      EngineGroup.ErrorCount++;
+    }
+  }
+  else
+  {
+    /* Acknowledges are not sent in group mode */
+  }
+}
+
+/**
+  * @brief  This function is used to add the data written in group mode to the group CRC.
+  * @param  Address The address where the data has been written.
+  * @param  Size The number of bytes written.
+  * @retval None.
+  */
+void OPENBL_ENGINE_TrackWrite(uint32_t Address, uint32_t Size)
+{
+  if (EngineGroup.GroupId != 0U)
+  {
+    EngineGroup.Crc = OPENBL_MEM_ComputeCrc32(EngineGroup.Crc, Address, Size);
+  }
+}
+
+/**
+  * @brief  This function is used to get the group joined by this node.
+  * @retval Returns the group identifier, 0 when the node is not in group mode.
+  */
+uint8_t OPENBL_ENGINE_GetGroupId(void)
+{
+  return EngineGroup.GroupId;
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to compute the XOR checksum of a buffer.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @param  Xor The initial value of the checksum.
+  * @retval Returns the checksum.
+  */
+static uint8_t OPENBL_ENGINE_Xor(const uint8_t *pData, uint32_t Length, uint8_t Xor)
+{
+  uint32_t counter;
+  uint8_t xor = Xor;
+
+  for (counter = 0U; counter < Length; counter++)
+  {
+    xor ^= pData[counter];
+  }
+
+  return xor;
+}
+
+/**
+  * @brief  This function is used to enter or leave the busy state of the interface, when it has one.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @param  State ENABLE before a memory operation, DISABLE after it.
+  * @retval None.
+  */
+static void OPENBL_ENGINE_SetBusy(const OPENBL_ENGINE_HandleTypeDef *pHandle, FunctionalState State)
+{
+  if (pHandle->pTransport->SendBusy != NULL)
+  {
+    pHandle->pTransport->SendBusy(State);
+  }
+}
+
+/**
+  * @brief  This function is used to send the response of a Get command: ACK, the data frame then ACK.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @param  Length The number of bytes of the response, placed at the beginning of the buffer.
+  * @retval None.
+  */
+static void OPENBL_ENGINE_SendResponse(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint32_t Length)
+{
+  /* Send Acknowledge byte to notify the host that the command is recognized */
+  pHandle->pTransport->SendAck(ACK_BYTE);
+
+  pHandle->pTransport->SendFrame(pHandle->pBuffer, Length);
+
+  /* Send last Acknowledge synchronization byte */
+  pHandle->pTransport->SendAck(ACK_BYTE);
+}
+
+/**
+  * @brief  This function is used to send the intermediate status of a command received in several frames.
+  *         The command frame protocols check all the parameters at once, without intermediate status.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @param  Ack The status byte, ACK_BYTE or NACK_BYTE.
+  * @retval None.
+  */
+static void OPENBL_ENGINE_SendStreamAck(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t Ack)
+{
+  if ((pHandle->Framing & OPENBL_ENGINE_FRAMING_COMMAND_FRAME) == 0U)
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, Ack);
+  }
+}
+
+/**
+  * @brief  This function is used to send the status ending the data sent by a command frame protocol.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @param  Ack The status byte, ACK_BYTE or NACK_BYTE.
+  * @retval None.
+  */
+static void OPENBL_ENGINE_SendFrameAck(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t Ack)
+{
+  if ((pHandle->Framing & OPENBL_ENGINE_FRAMING_COMMAND_FRAME) != 0U)
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, Ack);
+  }
+}
+
+/**
+  * @brief  This function is used to read parameters, from the command frame when the protocol carries them
+  *         in it else from the current host frame.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @param  pData Pointer to the parameters.
+  * @param  Length The number of bytes.
+  * @retval None.
+  */
+static void OPENBL_ENGINE_ReadParameters(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t *pData,
+                                         uint32_t Length)
+{
+  if ((pHandle->Framing & OPENBL_ENGINE_FRAMING_COMMAND_FRAME) != 0U)
+  {
+    pHandle->pTransport->ReadParameters(pData, Length);
+  }
+  else
+  {
+    pHandle->pTransport->ReadFrame(pData, Length);
+  }
+}
+
+/**
+  * @brief  This function is used to get parameters followed by their checksum.
+  *         The command frame protocols have no checksum, the parameters are read from the command frame.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @param  pData Pointer to the parameters, one more byte is needed for the checksum.
+  * @param  Length The number of bytes of the parameters.
+  * @retval Returns NACK status if the checksum is incorrect else returns ACK status.
+  */
+static uint8_t OPENBL_ENGINE_GetParameters(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t *pData,
+                                           uint32_t Length)
+{
+  uint8_t status = ACK_BYTE;
+
+  if ((pHandle->Framing & OPENBL_ENGINE_FRAMING_COMMAND_FRAME) != 0U)
+  {
+    pHandle->pTransport->ReadParameters(pData, Length);
+  }
+  else
+  {
+    pHandle->pTransport->ReadFrame(pData, Length + 1U);
+
+    if (pData[Length] != OPENBL_ENGINE_Xor(pData, Length, 0U))
+    {
+      status = NACK_BYTE;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to get data followed by its checksum in one frame.
+  *         The command frame protocols have no checksum, only the data is received.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @param  pData Pointer to the data, one more byte is needed for the checksum.
+  * @param  Length The number of bytes of the data.
+  * @param  Xor The checksum of the bytes already received and covered by the checksum of the data.
+  * @retval Returns NACK status if the checksum is incorrect else returns ACK status.
+  */
+static uint8_t OPENBL_ENGINE_GetData(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t *pData, uint32_t Length,
+                                     uint8_t Xor)
+{
+  uint8_t status = ACK_BYTE;
+
+  if ((pHandle->Framing & OPENBL_ENGINE_FRAMING_COMMAND_FRAME) != 0U)
+  {
+    pHandle->pTransport->ReadFrame(pData, Length);
+  }
+  else
+  {
+    pHandle->pTransport->ReadFrame(pData, Length + 1U);
+
+    if (pData[Length] != OPENBL_ENGINE_Xor(pData, Length, Xor))
+    {
+      status = NACK_BYTE;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to read the checksum of the bytes already received.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @param  Xor The expected checksum, returned as is by the command frame protocols which have no checksum.
+  * @retval Returns the received checksum.
+  */
+static uint8_t OPENBL_ENGINE_ReadChecksum(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t Xor)
+{
+  uint8_t checksum = Xor;
+
+  if ((pHandle->Framing & OPENBL_ENGINE_FRAMING_COMMAND_FRAME) == 0U)
+  {
+    pHandle->pTransport->ReadFrame(&checksum, 1U);
+  }
+
+  return checksum;
+}
+
+/**
+  * @brief  This function is used to get the 32-bit length of an extended read/write command, MSB first.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @param  Address The start address of the memory region.
+  * @param  pSize Pointer to the returned number of bytes.
+  * @retval Returns NACK status in case of error else returns ACK status.
+  */
+static uint8_t OPENBL_ENGINE_GetExtendedSize(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint32_t Address,
+                                             uint32_t *pSize)
+{
+  uint8_t data[5];
+  uint8_t status;
+
+  status = OPENBL_ENGINE_GetParameters(pHandle, data, 4U);
+
+  if (status == ACK_BYTE)
+  {
+    *pSize = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+
+    /* The whole region must be valid and must not wrap around the address space */
+    if ((*pSize == 0U)
+        || ((Address + *pSize - 1U) < Address)
+        || (OPENBL_MEM_GetAddressArea(Address + *pSize - 1U) == AREA_ERROR))
+    {
+      status = NACK_BYTE;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to receive the list of pages to be erased then to erase them.
+  *         The pages are stored LSB first after their number, as expected by OPENBL_MEM_Erase.
+  *         A list longer than the buffer is received then rejected.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @param  NumberOfPages The number of pages of the list.
+  * @param  Xor The checksum of the bytes already received and covered by the checksum of the list.
+  * @retval Returns ACK status if the list is valid else returns NACK status.
+  */
+static uint8_t OPENBL_ENGINE_ErasePages(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint32_t NumberOfPages,
+                                        uint8_t Xor)
+{
+  uint32_t remaining;
+  uint32_t length;
+  uint32_t length_max;
+  uint32_t counter;
+  uint8_t status = ACK_BYTE;
+  uint8_t xor = Xor;
+  uint8_t data;
+
+  length_max = (pHandle->BufferSize - 2U) & ~1U;
+  remaining  = NumberOfPages * 2U;
+
+  pHandle->pBuffer[0] = (uint8_t)(NumberOfPages & 0x00FFU);
+  pHandle->pBuffer[1] = (uint8_t)((NumberOfPages & 0xFF00U) >> 8);
+
+  /* Get the pages to be erased, each page MSB first */
+  while (remaining != 0U)
+  {
+    length = (remaining < length_max) ? remaining : length_max;
+
+    pHandle->pTransport->ReadFrame(&pHandle->pBuffer[2], length);
+
+    xor        = OPENBL_ENGINE_Xor(&pHandle->pBuffer[2], length, xor);
+    remaining -= length;
+  }
+
+  if ((OPENBL_ENGINE_ReadChecksum(pHandle, xor) != xor) || ((NumberOfPages * 2U) > length_max))
+  {
+    status = NACK_BYTE;
+  }
+  else
+  {
+    /* Store each page LSB first */
+    for (counter = 2U; counter < ((NumberOfPages * 2U) + 2U); counter += 2U)
+    {
+      data                          = pHandle->pBuffer[counter];
+      pHandle->pBuffer[counter]     = pHandle->pBuffer[counter + 1U];
+      pHandle->pBuffer[counter + 1U] = data;
+    }
+
+    OPENBL_ENGINE_SetBusy(pHandle, ENABLE);
+
+    /* Errors from memory erase are not managed, always return ACK */
+    (void)OPENBL_MEM_Erase(OPENBL_DEFAULT_MEM, pHandle->pBuffer, pHandle->BufferSize);
+
+    OPENBL_ENGINE_SetBusy(pHandle, DISABLE);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to get the operation code of a special command.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @param  pOpCode Pointer to the operation code to be returned.
+  * @param  CmdType Type of the command, special command or extended special command.
+  * @retval Returns NACK status in case of error else returns ACK status.
+  */
+static uint8_t OPENBL_ENGINE_GetSpecialCmdOpCode(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint16_t *pOpCode,
+                                                 OPENBL_SpecialCmdTypeTypeDef CmdType)
+{
+  uint8_t data[3];
+  uint8_t status;
+
+  /* Get the command OpCode (2 bytes, MSB first) and its checksum */
+  status = OPENBL_ENGINE_GetParameters(pHandle, data, 2U);
+
+  if (status == ACK_BYTE)
+  {
+    *pOpCode = ((uint16_t)data[0] << 8) | (uint16_t)data[1];
+
+    status = OPENBL_ENGINE_CheckSpecialCmdOpCode(*pOpCode, CmdType);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to get a buffer of a special command: its size MSB first, the data
+  *         then the checksum of the size and the data.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @param  pData Pointer to the buffer where the data is stored, followed by one byte for the checksum.
+  * @param  pSize Pointer to the size to be returned.
+  * @param  SizeMax The size of the buffer.
+  * @retval Returns NACK status in case of error else returns ACK status.
+  */
+static uint8_t OPENBL_ENGINE_GetSpecialCmdBuffer(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t *pData,
+                                                 uint16_t *pSize, uint16_t SizeMax)
+{
+  uint8_t status;
+  uint8_t size[2];
+
+  pHandle->pTransport->ReadFrame(size, 2U);
+
+  *pSize = ((uint16_t)size[0] << 8) | (uint16_t)size[1];
+
+  if (*pSize > SizeMax)
+  {
+    status = NACK_BYTE;
+  }
+  else
+  {
+    status = OPENBL_ENGINE_GetData(pHandle, pData, (uint32_t)*pSize, size[0] ^ size[1]);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to write in to device memory encoded data, compressed or delta patch.
+  *         The frames are the Write Memory ones, the up to 256 bytes received are decoded in the rest
+  *         of the buffer.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @param  Decode The memory function decoding and writing the data.
+  * @param  Enable The configuration flag of the command.
+  * @retval None.
+  */
+static void OPENBL_ENGINE_WriteEncoded(const OPENBL_ENGINE_HandleTypeDef *pHandle,
+                                       ErrorStatus (*Decode)(uint32_t Address, uint8_t *pData, uint32_t Length,
+                                                             uint8_t *pBuffer, uint32_t BufferSize,
+                                                             uint32_t *pSize),
+                                       uint32_t Enable)
+{
+  ErrorStatus error_value;
+  uint32_t address;
+  uint32_t codesize;
+  uint32_t size;
+  uint8_t data;
+
+  /* Check memory protection then send adequate response */
+  if ((Common_GetProtectionStatus() != RESET) || (Enable == 0U))
+  {
+    OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+  }
+  else
+  {
+    OPENBL_ENGINE_SendStreamAck(pHandle, ACK_BYTE);
+
+    /* Get the memory address */
+    if (OPENBL_ENGINE_GetAddress(pHandle, &address) == NACK_BYTE)
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+    }
+    else
+    {
+      OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+      /* Read the number of encoded bytes: Max number of data = data + 1 = 256 */
+      OPENBL_ENGINE_ReadParameters(pHandle, &data, 1U);
+
+      codesize = (uint32_t)data + 1U;
+
+      /* Receive the encoded data and the checksum in the RAM buffer, send NACK if the checksum is incorrect */
+      if (OPENBL_ENGINE_GetData(pHandle, pHandle->pBuffer, codesize, data) == NACK_BYTE)
+      {
+        OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+      }
+      else
+      {
+        OPENBL_ENGINE_SetBusy(pHandle, ENABLE);
+        error_value = Decode(address, pHandle->pBuffer, codesize, &pHandle->pBuffer[ENGINE_DECODED_OFFSET],
+                             pHandle->BufferSize - ENGINE_DECODED_OFFSET, &size);
+        OPENBL_ENGINE_SetBusy(pHandle, DISABLE);
+
+        if (error_value == SUCCESS)
+        {
+          OPENBL_ENGINE_TrackWrite(address, size);
+
+          OPENBL_ENGINE_SendStatus(pHandle, ACK_BYTE);
+
+          /* Start post processing task if needed */
+          Common_StartPostProcessing();
+        }
+        else
+        {
+          OPENBL_ENGINE_SendStatus(pHandle, NACK_BYTE);
+        }
+      }
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to manage the group sub-commands carried in the command frame.
+  *         Several nodes share the bus, so only the addressed node responds and unknown sub-commands are ignored.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+static void OPENBL_ENGINE_GroupFrameCommand(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  uint32_t node_id;
+  uint8_t addressed;
+  uint8_t data[6];
+
+  /* Sub-command, group then node identifier MSB first */
+  pHandle->pTransport->ReadParameters(data, 6U);
+
+  node_id   = ((uint32_t)data[2] << 24) | ((uint32_t)data[3] << 16) | ((uint32_t)data[4] << 8) | (uint32_t)data[5];
+  addressed = (node_id == Common_GetNodeId()) ? 1U : 0U;
+
+  switch (data[0])
+  {
+    case ENGINE_GROUP_JOIN:
+      if ((data[1] != 0U) && ((addressed != 0U) || (node_id == ENGINE_GROUP_ALL_NODES)))
+      {
+        EngineGroup.GroupId    = data[1];
+        EngineGroup.Status     = ACK_BYTE;
+        EngineGroup.ErrorCount = 0U;
+        EngineGroup.Crc        = 0U;
+
+        if (addressed != 0U)
+        {
+          pHandle->pTransport->SendAck(ACK_BYTE);
+        }
+      }
+      break;
+
+    case ENGINE_GROUP_LEAVE:
+      if ((EngineGroup.GroupId != 0U) && (data[1] == EngineGroup.GroupId))
+      {
+        EngineGroup.GroupId = 0U;
+      }
+      break;
+
+    case ENGINE_GROUP_STATUS:
+      if ((EngineGroup.GroupId != 0U) && (data[1] == EngineGroup.GroupId) && (addressed != 0U))
+      {
+        pHandle->pBuffer[0] = EngineGroup.Status;
+        pHandle->pBuffer[1] = EngineGroup.ErrorCount;
+        pHandle->pBuffer[2] = (uint8_t)(EngineGroup.Crc >> 24);
+        pHandle->pBuffer[3] = (uint8_t)(EngineGroup.Crc >> 16);
+        pHandle->pBuffer[4] = (uint8_t)(EngineGroup.Crc >> 8);
+        pHandle->pBuffer[5] = (uint8_t)(EngineGroup.Crc);
+        pHandle->pBuffer[6] = 0x00U;
+        pHandle->pBuffer[7] = 0x00U;
+
+        pHandle->pTransport->SendFrame(pHandle->pBuffer, ENGINE_GROUP_FRAME_SIZE);
+      }
+      break;
+
+    default:
+      /* Unknown sub-commands are ignored, several nodes may share the bus */
+      break;
+  }
+}
+
+/**
+  * @brief  This function is used to manage the group sub-commands sent to one target, followed by their checksum.
+  *         The responses are sent even in group mode, the group commands are the only way to collect the status.
+  * @param  pHandle Pointer to the engine handle of the interface.
+  * @retval None.
+  */
+static void OPENBL_ENGINE_GroupStreamCommand(const OPENBL_ENGINE_HandleTypeDef *pHandle)
+{
+  uint8_t data[3];
+
+  /* Send group command code acknowledgment */
+  pHandle->pTransport->SendAck(ACK_BYTE);
+
+  /* Sub-command and group then their checksum */
+  if (OPENBL_ENGINE_GetParameters(pHandle, data, 2U) == NACK_BYTE)
+  {
+    pHandle->pTransport->SendAck(NACK_BYTE);
+  }
+  else
+  {
+    switch (data[0])
+    {
+      case ENGINE_GROUP_JOIN:
+        if (data[1] == 0U)
+        {
+          pHandle->pTransport->SendAck(NACK_BYTE);
+        }
+        else
+        {
+          EngineGroup.GroupId    = data[1];
+          EngineGroup.Status     = ACK_BYTE;
+          EngineGroup.ErrorCount = 0U;
+          EngineGroup.Crc        = 0U;
+
+          pHandle->pTransport->SendAck(ACK_BYTE);
+        }
+        break;
+
+      case ENGINE_GROUP_LEAVE:
+        EngineGroup.GroupId = 0U;
+
+        pHandle->pTransport->SendAck(ACK_BYTE);
+        break;
+
+      case ENGINE_GROUP_STATUS:
+        if ((EngineGroup.GroupId == 0U) || (data[1] != EngineGroup.GroupId))
+        {
+          pHandle->pTransport->SendAck(NACK_BYTE);
+        }
+        else
+        {
+          pHandle->pTransport->SendAck(ACK_BYTE);
+
+          pHandle->pBuffer[0] = EngineGroup.Status;
+          pHandle->pBuffer[1] = EngineGroup.ErrorCount;
+          pHandle->pBuffer[2] = (uint8_t)(EngineGroup.Crc >> 24);
+          pHandle->pBuffer[3] = (uint8_t)(EngineGroup.Crc >> 16);
+          pHandle->pBuffer[4] = (uint8_t)(EngineGroup.Crc >> 8);
+          pHandle->pBuffer[5] = (uint8_t)(EngineGroup.Crc);
+
+          pHandle->pTransport->SendFrame(pHandle->pBuffer, ENGINE_GROUP_STATUS_SIZE);
+        }
+        break;
+
+      default:
+        pHandle->pTransport->SendAck(NACK_BYTE);
+        break;
+    }
+  }
+}
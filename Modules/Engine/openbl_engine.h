@@ -0,0 +1,99 @@
+/**
+  ******************************************************************************
+  * @file    openbl_engine.h
+  * @author  MCD Application Team
+  * @brief   Header for openbl_engine.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OPENBL_ENGINE_H
+#define OPENBL_ENGINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "openbl_core.h"
+
+/* Exported types ------------------------------------------------------------*/
+
+/* Block transport of the command engine, one phase of the protocol is one frame */
+typedef struct
+{
+  void (*ReadFrame)(uint8_t *pBuffer, uint32_t Length);   /* Receive bytes of the current host frame */
+  void (*SendFrame)(uint8_t *pBuffer, uint32_t Length);   /* Send a data frame to the host */
+  void (*SendAck)(uint8_t Ack);                           /* Send ACK_BYTE or NACK_BYTE, ends the host frame */
+  void (*SendBusy)(FunctionalState State);                /* Optional, busy state during the memory operations */
+  void (*SpecialCommandProcess)(OPENBL_SpecialCmdTypeDef *SpecialCmd);
+  void (*ReadParameters)(uint8_t *pBuffer, uint32_t Length); /* Parameters of the command frame (CAN, FDCAN) */
+} OPENBL_ENGINE_TransportTypeDef;
+
+typedef struct
+{
+  const OPENBL_ENGINE_TransportTypeDef *pTransport;
+  uint8_t *pBuffer;                 /* Command buffer, at least OPENBL_ENGINE_BUFFER_SIZE bytes */
+  uint32_t BufferSize;
+  const uint8_t *pCommandsList;     /* Opcodes sent by Get Command */
+  uint8_t CommandsNumber;
+  uint8_t Version;                  /* Protocol version */
+  uint8_t Framing;                  /* OPENBL_ENGINE_FRAMING_xxx flags */
+} OPENBL_ENGINE_HandleTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+#define OPENBL_ENGINE_BUFFER_SIZE             1164U     /* Size of a special command, the largest command */
+#define OPENBL_ENGINE_EXT_BLOCK_SIZE          1024U     /* Bytes of the extended read/write commands moved at once */
+
+#define OPENBL_ENGINE_FRAMING_SPLIT_LENGTH    0x01U     /* Erase and write protect lengths acknowledged apart (I2C, SPI) */
+#define OPENBL_ENGINE_FRAMING_VERSION_OPTIONS 0x02U     /* Get Version followed by the two option bytes (USART) */
+#define OPENBL_ENGINE_FRAMING_COMMAND_FRAME   0x04U     /* Parameters in the command frame, no checksum (CAN, FDCAN) */
+#define OPENBL_ENGINE_FRAMING_ITEMS_COUNT     0x08U     /* Exact page and sector counts, not minus one (FDCAN) */
+#define OPENBL_ENGINE_FRAMING_GO_ACK          0x10U     /* Go acknowledged before its address is checked (FDCAN) */
+#define OPENBL_ENGINE_FRAMING_FLOW_CONTROL    0x20U     /* Extended write blocks paced by the transport (CAN) */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void OPENBL_ENGINE_GetCommand(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_GetVersion(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_GetID(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_ReadMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_WriteMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_Go(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_ReadoutProtect(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_ReadoutUnprotect(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_EraseMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_LegacyEraseMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_WriteProtect(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_WriteUnprotect(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_SpecialCommand(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_ExtendedSpecialCommand(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_ExtendedReadMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_ExtendedWriteMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_GroupCommand(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_GetStatistics(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_CommitMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_CompressedWriteMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_PatchMemory(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+void OPENBL_ENGINE_GetBlockCrc(const OPENBL_ENGINE_HandleTypeDef *pHandle);
+uint8_t OPENBL_ENGINE_GetAddress(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint32_t *pAddress);
+uint8_t OPENBL_ENGINE_CheckSpecialCmdOpCode(uint16_t OpCode, OPENBL_SpecialCmdTypeTypeDef CmdType);
+void OPENBL_ENGINE_SendStatus(const OPENBL_ENGINE_HandleTypeDef *pHandle, uint8_t Status);
+void OPENBL_ENGINE_TrackWrite(uint32_t Address, uint32_t Size);
+uint8_t OPENBL_ENGINE_GetGroupId(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* OPENBL_ENGINE_H */
@@ -3,6 +3,9 @@
   * @file    openbl_fdcan_cmd.c
   * @author  MCD Application Team
   * @brief   Contains FDCAN protocol commands
+  *          The memory commands are run by the command engine, the FDCAN
+  *          transport reads their parameters from the command frame and moves
+  *          the data in 64-byte frames.
   ******************************************************************************
   * @attention
   *
@@ -20,6 +23,7 @@
 #include "openbl_mem.h"
 #include "openbl_core.h"
 #include "openbl_fdcan_cmd.h"
+#include "openbl_engine.h"
 
 #include "openbootloader_conf.h"
 #include "app_openbootloader.h"
@@ -28,19 +32,42 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
-#define OPENBL_FDCAN_COMMANDS_NB_MAX      13U       /* The maximum number of supported commands */
+#define OPENBL_FDCAN_COMMANDS_NB_MAX      21U       /* The maximum number of supported commands */
+#define FDCAN_FRAME_DATA_SIZE             64U       /* Data bytes of a FDCAN frame */
 
 /* Private macro -------------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void OPENBL_FDCAN_ReadFrame(uint8_t *pBuffer, uint32_t Length);
+static void OPENBL_FDCAN_SendFrame(uint8_t *pBuffer, uint32_t Length);
+static void OPENBL_FDCAN_ReadParameters(uint8_t *pBuffer, uint32_t Length);
+static uint8_t OPENBL_FDCAN_ConstructCommandsTable(OPENBL_CommandsTypeDef *pFdcanCmd);
+
 /* Private variables ---------------------------------------------------------*/
-/* Private macro -------------------------------------------------------------*/
-/* Private variables ---------------------------------------------------------*/
+/* Block transport of the FDCAN interface, the parameters are carried in the command frame */
+static const OPENBL_ENGINE_TransportTypeDef FdcanTransport =
+{
+  OPENBL_FDCAN_ReadFrame,
+  OPENBL_FDCAN_SendFrame,
+  OPENBL_FDCAN_SendByte,
+  NULL,
+  OPENBL_FDCAN_SpecialCommandProcess,
+  OPENBL_FDCAN_ReadParameters
+};
+
 static uint8_t a_OPENBL_FDCAN_CommandsList[OPENBL_FDCAN_COMMANDS_NB_MAX] = {0U};
-static uint8_t FdcanCommandsNumber = 0U;
+static uint32_t FdcanParamIndex = 0U;
 
-/* Private function prototypes -----------------------------------------------*/
-static uint8_t OPENBL_FDCAN_GetAddress(uint32_t *Address);
-static uint8_t OPENBL_FDCAN_GetSpecialCmdOpCode(uint16_t *OpCode, OPENBL_SpecialCmdTypeTypeDef CmdType);
-static uint8_t OPENBL_FDCAN_ConstructCommandsTable(OPENBL_CommandsTypeDef *pFdcanCmd);
+/* The FDCAN commands are run by the command engine, the command buffer is the transmission buffer */
+static OPENBL_ENGINE_HandleTypeDef FdcanHandle =
+{
+  &FdcanTransport,
+  NULL,
+  FDCAN_RAM_BUFFER_SIZE,
+  a_OPENBL_FDCAN_CommandsList,
+  0U,
+  OPENBL_FDCAN_VERSION,
+  OPENBL_ENGINE_FRAMING_COMMAND_FRAME | OPENBL_ENGINE_FRAMING_ITEMS_COUNT | OPENBL_ENGINE_FRAMING_GO_ACK
+};
 
 /* Exported variables --------------------------------------------------------*/
 /* Exported functions---------------------------------------------------------*/
@@ -71,9 +98,20 @@ OPENBL_CommandsTypeDef *OPENBL_FDCAN_GetCommandsList(void)
     NULL,
     NULL,
     OPENBL_FDCAN_SpecialCommand,
-    OPENBL_FDCAN_ExtendedSpecialCommand
+    OPENBL_FDCAN_ExtendedSpecialCommand,
+    OPENBL_FDCAN_ExtendedReadMemory,
+    OPENBL_FDCAN_ExtendedWriteMemory,
+    OPENBL_FDCAN_GroupCommand,
+    OPENBL_FDCAN_GetStatistics,
+    OPENBL_FDCAN_CommitMemory,
+    OPENBL_FDCAN_CompressedWriteMemory,
+    OPENBL_FDCAN_PatchMemory,
+    OPENBL_FDCAN_GetBlockCrc
   };
 
+  /* The transmission buffer starts the block taken by the interface from the arena */
+  FdcanHandle.pBuffer = OPENBL_GetBuffer(2U * FDCAN_RAM_BUFFER_SIZE);
+
   OPENBL_FDCAN_SetCommandsList(&OPENBL_FDCAN_Commands);
 
   return (&OPENBL_FDCAN_Commands);
@@ -86,7 +124,7 @@ OPENBL_CommandsTypeDef *OPENBL_FDCAN_GetCommandsList(void)
 void OPENBL_FDCAN_SetCommandsList(OPENBL_CommandsTypeDef *pFdcanCmd)
 {
   /* Get the list of commands supported & their numbers */
-  FdcanCommandsNumber = OPENBL_FDCAN_ConstructCommandsTable(pFdcanCmd);
+  FdcanHandle.CommandsNumber = OPENBL_FDCAN_ConstructCommandsTable(pFdcanCmd);
 }
 
 /**
@@ -101,13 +139,13 @@ void OPENBL_FDCAN_GetCommand(void)
   OPENBL_FDCAN_SendByte(ACK_BYTE);
 
   /* Send the number of commands supported by FDCAN protocol */
-  OPENBL_FDCAN_SendByte(FdcanCommandsNumber);
+  OPENBL_FDCAN_SendByte(FdcanHandle.CommandsNumber);
 
   /* Send FDCAN protocol version */
   OPENBL_FDCAN_SendByte(OPENBL_FDCAN_VERSION);
 
   /* Send the list of supported commands */
-  for (counter = 0U; counter < FdcanCommandsNumber; counter++)
+  for (counter = 0U; counter < FdcanHandle.CommandsNumber; counter++)
   {
     OPENBL_FDCAN_SendByte(a_OPENBL_FDCAN_CommandsList[counter]);
   }
@@ -161,81 +199,9 @@ void OPENBL_FDCAN_GetID(void)
   */
 void OPENBL_FDCAN_ReadMemory(void)
 {
-  uint32_t address;
-  uint32_t counter;
-  uint32_t number_of_bytes;
-  uint32_t count;
-  uint32_t single;
-  uint32_t memory_index;
-  uint8_t  data_length;
-
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_FDCAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    if (OPENBL_FDCAN_GetAddress(&address) == NACK_BYTE)
-    {
-      OPENBL_FDCAN_SendByte(NACK_BYTE);
-    }
-    else
-    {
-      OPENBL_FDCAN_SendByte(ACK_BYTE);
-
-      /* Get the number of bytes to be read from memory (Max: data + 1 = 256) */
-      number_of_bytes = (uint32_t)RxData[4] + 1U;
-
-      count  = number_of_bytes / 64U;
-      single = (uint32_t)(number_of_bytes % 64U);
-
-      /* Get the memory index to know from which memory we will read */
-      memory_index = OPENBL_MEM_GetMemoryIndex(address);
-
-      while (count != 0U)
-      {
-        data_length = 0U;
-
-        for (counter = 64U ; counter > 0U; counter--)
-        {
-          TxData[data_length] = OPENBL_MEM_Read(address, memory_index);
-
-          data_length++;
-          address++;
-        }
-
-        OPENBL_FDCAN_SendBytes(TxData, FDCAN_DLC_BYTES_64);
-
-        count--;
-      }
-
-      if (single != 0U)
-      {
-        data_length = 0U;
+  FdcanParamIndex = 0U;
 
-        for (counter = single ; counter > 0U; counter--)
-        {
-          TxData[data_length] = OPENBL_MEM_Read(address, memory_index);
-
-          data_length++;
-          address++;
-        }
-
-        /* Fill the rest of the buffer with 0xFF */
-        for (counter = (64U - single) ; counter > 0U; counter--)
-        {
-          TxData[data_length] = 0xFFU;
-
-          data_length++;
-        }
-
-        OPENBL_FDCAN_SendBytes(TxData, FDCAN_DLC_BYTES_64);
-      }
-
-      OPENBL_FDCAN_SendByte(ACK_BYTE);
-    }
-  }
+  OPENBL_ENGINE_ReadMemory(&FdcanHandle);
 }
 
 /**
@@ -244,60 +210,9 @@ void OPENBL_FDCAN_ReadMemory(void)
   */
 void OPENBL_FDCAN_WriteMemory(void)
 {
-  uint32_t address;
-  uint32_t CodeSize;
-  uint32_t count;
-  uint32_t single;
-  uint8_t data_length;
-
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_FDCAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    if (OPENBL_FDCAN_GetAddress(&address) == NACK_BYTE)
-    {
-      OPENBL_FDCAN_SendByte(NACK_BYTE);
-    }
-    else
-    {
-      OPENBL_FDCAN_SendByte(ACK_BYTE);
-
-      /* Get the number of bytes to be written to memory (Max: data + 1 = 256) */
-      CodeSize = (uint32_t)RxData[4] + 1U;
+  FdcanParamIndex = 0U;
 
-      count = CodeSize / 64U;
-      single = (uint32_t)(CodeSize % 64U);
-
-      data_length = 0U;
-
-      if (count != 0U)
-      {
-        while (data_length != count)
-        {
-          OPENBL_FDCAN_ReadBytes(&RxData[data_length * 64U], 64U);
-
-          data_length++;
-        }
-      }
-
-      if (single != 0U)
-      {
-        OPENBL_FDCAN_ReadBytes(&RxData[(CodeSize - single)], 64U);
-      }
-
-      /* Write data to memory */
-      OPENBL_MEM_Write(address, (uint8_t *)RxData, CodeSize);
-
-      /* Send last Acknowledge synchronization byte */
-      OPENBL_FDCAN_SendByte(ACK_BYTE);
-
-      /* Start post processing task if needed */
-      Common_StartPostProcessing();
-    }
-  }
+  OPENBL_ENGINE_WriteMemory(&FdcanHandle);
 }
 
 /**
@@ -306,41 +221,9 @@ void OPENBL_FDCAN_WriteMemory(void)
   */
 void OPENBL_FDCAN_Go(void)
 {
-  uint32_t address;
-  uint8_t status;
-
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_FDCAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_FDCAN_SendByte(ACK_BYTE);
+  FdcanParamIndex = 0U;
 
-    /* Get memory address */
-    if (OPENBL_FDCAN_GetAddress(&address) == NACK_BYTE)
-    {
-      OPENBL_FDCAN_SendByte(NACK_BYTE);
-    }
-    else
-    {
-      /* Check if received address is valid or not */
-      status = OPENBL_MEM_CheckJumpAddress(address);
-
-      if (status == 0U)
-      {
-        OPENBL_FDCAN_SendByte(NACK_BYTE);
-      }
-      else
-      {
-        /* If the jump address is valid then send ACK */
-        OPENBL_FDCAN_SendByte(ACK_BYTE);
-
-        OPENBL_MEM_JumpToAddress(address);
-      }
-    }
-  }
+  OPENBL_ENGINE_Go(&FdcanHandle);
 }
 
 /**
@@ -349,23 +232,9 @@ void OPENBL_FDCAN_Go(void)
   */
 void OPENBL_FDCAN_ReadoutProtect(void)
 {
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_FDCAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_FDCAN_SendByte(ACK_BYTE);
-
-    /* Enable the read protection */
-    OPENBL_MEM_SetReadOutProtection(OPENBL_DEFAULT_MEM, ENABLE);
+  FdcanParamIndex = 0U;
 
-    OPENBL_FDCAN_SendByte(ACK_BYTE);
-
-    /* Start post processing task if needed */
-    Common_StartPostProcessing();
-  }
+  OPENBL_ENGINE_ReadoutProtect(&FdcanHandle);
 }
 
 /**
@@ -374,18 +243,9 @@ void OPENBL_FDCAN_ReadoutProtect(void)
   */
 void OPENBL_FDCAN_ReadoutUnprotect(void)
 {
-  OPENBL_FDCAN_SendByte(ACK_BYTE);
-
-  /* Once the option bytes modification start bit is set in FLASH CR register,
-     all the RAM is erased, this causes the erase of the Open Bootloader RAM.
-     This is why the last ACK is sent before the call of OPENBL_MEM_SetReadOutProtection */
-  OPENBL_FDCAN_SendByte(ACK_BYTE);
+  FdcanParamIndex = 0U;
 
-  /* Disable the read protection */
-  OPENBL_MEM_SetReadOutProtection(OPENBL_DEFAULT_MEM, DISABLE);
-
-  /* Start post processing task if needed */
-  Common_StartPostProcessing();
+  OPENBL_ENGINE_ReadoutUnprotect(&FdcanHandle);
 }
 
 /**
@@ -394,90 +254,9 @@ void OPENBL_FDCAN_ReadoutUnprotect(void)
   */
 void OPENBL_FDCAN_EraseMemory(void)
 {
-  uint16_t data;
-  uint16_t counter;
-  uint16_t i;
-  uint8_t tempdata;
-  uint8_t status = ACK_BYTE;
-  ErrorStatus error_value;
-
-  /* Check if the memory is protected or not */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_FDCAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_FDCAN_SendByte(ACK_BYTE);
-
-    /* Read number of pages to be erased:
-     * RxData[0] contains the MSB byte
-     * RxData[1] contains the LSB byte
-     */
-    data = (uint16_t)RxData[0] << 8;
-    data = data | RxData[1];
-
-    /* Rewrite the data in right order in the RxData buffer
-     * RxData[0] = LSB
-     * RxData[1] = MSB
-     */
-    RxData[0] = (uint8_t)(data & 0x00FFU);
-    RxData[1] = (uint8_t)((data & 0xFF00U) >> 8);
-
-    /* All commands in range 0xFFFZ are reserved for special erase features */
-    if ((data & 0xFFF0U) == 0xFFF0U)
-    {
-      if ((data == 0xFFFFU) || (data == 0xFFFEU) || (data == 0xFFFDU))
-      {
-        error_value = OPENBL_MEM_MassErase(OPENBL_DEFAULT_MEM, RxData, FDCAN_RAM_BUFFER_SIZE);
-
-        if (error_value == SUCCESS)
-        {
-          status = ACK_BYTE;
-        }
-        else
-        {
-          status = NACK_BYTE;
-        }
-      }
-      else
-      {
-        /* This sub-command is not supported */
-        status = NACK_BYTE;
-      }
-    }
-    else
-    {
-      OPENBL_FDCAN_SendByte(ACK_BYTE);
-
-      /* Receive the list of pages to be erased (each page num is on two bytes)
-       * The order of data received is LSB first
-       */
-      OPENBL_FDCAN_ReadBytes(&RxData[2], 64U);
-
-      i = 2;
-
-      for (counter = data; counter != (uint16_t)0; counter--)
-      {
-        /* Receive the MSB byte */
-        tempdata = RxData[i];
-        i++;
-        RxData[i - (uint16_t)1] = RxData[i];
-        RxData[i] = tempdata;
-        i++;
-      }
-
-      error_value = OPENBL_MEM_Erase(OPENBL_DEFAULT_MEM, RxData, FDCAN_RAM_BUFFER_SIZE);
-
-      /* Errors from memory erase are not managed, always return ACK */
-      if (error_value == SUCCESS)
-      {
-        status = ACK_BYTE;
-      }
-    }
+  FdcanParamIndex = 0U;
 
-    OPENBL_FDCAN_SendByte(status);
-  }
+  OPENBL_ENGINE_EraseMemory(&FdcanHandle);
 }
 
 /**
@@ -486,30 +265,9 @@ void OPENBL_FDCAN_EraseMemory(void)
   */
 void OPENBL_FDCAN_WriteProtect(void)
 {
-  uint32_t length;
-  ErrorStatus error_value;
-
-  /* Check if the memory is protected or not */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_FDCAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_FDCAN_SendByte(ACK_BYTE);
+  FdcanParamIndex = 0U;
 
-    length = RxData[0];
-
-    /* Enable the write protection */
-    error_value = OPENBL_MEM_SetWriteProtection(ENABLE, OPENBL_DEFAULT_MEM, (uint8_t *) &RxData[1], length);
-
-    OPENBL_FDCAN_SendByte(ACK_BYTE);
-
-    if (error_value == SUCCESS)
-    {
-      Common_StartPostProcessing();
-    }
-  }
+  OPENBL_ENGINE_WriteProtect(&FdcanHandle);
 }
 
 /**
@@ -518,276 +276,188 @@ void OPENBL_FDCAN_WriteProtect(void)
   */
 void OPENBL_FDCAN_WriteUnprotect(void)
 {
-  ErrorStatus error_value;
+  FdcanParamIndex = 0U;
 
-  /* Check if the memory is not protected */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_FDCAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_FDCAN_SendByte(ACK_BYTE);
-
-    /* Disable write protection */
-    error_value = OPENBL_MEM_SetWriteProtection(DISABLE, OPENBL_DEFAULT_MEM, NULL, 0U);
+  OPENBL_ENGINE_WriteUnprotect(&FdcanHandle);
+}
 
-    OPENBL_FDCAN_SendByte(ACK_BYTE);
+/**
+  * @brief  This function is used to execute special command commands.
+  * @retval None.
+  */
+void OPENBL_FDCAN_SpecialCommand(void)
+{
+  FdcanParamIndex = 0U;
 
-    if (error_value == SUCCESS)
-    {
-      Common_StartPostProcessing();
-    }
-  }
+  OPENBL_ENGINE_SpecialCommand(&FdcanHandle);
 }
 
 /**
-  * @brief  This function is used to get a valid address.
-  * @retval Returns NACK status in case of error else returns ACK status.
+  * @brief  This function is used to execute extended special command commands.
+  * @retval None.
   */
-uint8_t OPENBL_FDCAN_GetAddress(uint32_t *Address)
+void OPENBL_FDCAN_ExtendedSpecialCommand(void)
 {
-  uint8_t status;
+  FdcanParamIndex = 0U;
 
-  *Address = (((((uint32_t) RxData[0]) << 24)  |
-               (((uint32_t) RxData[1]) << 16)  |
-               (((uint32_t) RxData[2]) << 8)   |
-               (((uint32_t) RxData[3]))));
+  OPENBL_ENGINE_ExtendedSpecialCommand(&FdcanHandle);
+}
 
-  /* Check if received address is valid or not */
-  if (OPENBL_MEM_GetAddressArea(*Address) == AREA_ERROR)
-  {
-    status = NACK_BYTE;
-  }
-  else
-  {
-    status = ACK_BYTE;
-  }
+/**
+  * @brief  This function is used to read memory from the device using a 32-bit length.
+  * @retval None.
+  */
+void OPENBL_FDCAN_ExtendedReadMemory(void)
+{
+  FdcanParamIndex = 0U;
 
-  return status;
+  OPENBL_ENGINE_ExtendedReadMemory(&FdcanHandle);
 }
 
 /**
-  * @brief  This function is used to execute special command commands.
+  * @brief  This function is used to write in to device memory using a 32-bit length.
+  *         Each block of OPENBL_ENGINE_EXT_BLOCK_SIZE bytes is acknowledged once written.
   * @retval None.
   */
-void OPENBL_FDCAN_SpecialCommand(void)
+void OPENBL_FDCAN_ExtendedWriteMemory(void)
 {
-  OPENBL_SpecialCmdTypeDef *special_cmd;
-  uint16_t op_code;
-  uint8_t index;
-  uint8_t data;
-
-  /* Point to the RAM USART buffer to gain size and reliability */
-  special_cmd = (OPENBL_SpecialCmdTypeDef *)(uint32_t) TxData;
+  FdcanParamIndex = 0U;
 
-  /* Send special command code acknowledgment */
-  OPENBL_FDCAN_SendByte(ACK_BYTE);
+  OPENBL_ENGINE_ExtendedWriteMemory(&FdcanHandle);
+}
 
-  /* Get the command operation code */
-  if (OPENBL_FDCAN_GetSpecialCmdOpCode(&op_code, OPENBL_SPECIAL_CMD) == NACK_BYTE)
-  {
-    OPENBL_FDCAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    /* Send Operation code acknowledgment */
-    OPENBL_FDCAN_SendByte(ACK_BYTE);
+/**
+  * @brief  This function is used to manage the group programming of several nodes sharing the same bus,
+  *         see OPENBL_ENGINE_GroupCommand.
+  * @retval None.
+  */
+void OPENBL_FDCAN_GroupCommand(void)
+{
+  FdcanParamIndex = 0U;
 
-    /* Initialize the special command frame */
-    special_cmd->CmdType = OPENBL_SPECIAL_CMD;
-    special_cmd->OpCode  = op_code;
+  OPENBL_ENGINE_GroupCommand(&FdcanHandle);
+}
 
-    /* Get the number of bytes to be received */
-    OPENBL_FDCAN_ReadBytes(RxData, 2U);
+/**
+  * @brief  This function is used to send the statistics recorded by the Open Bootloader.
+  * @retval None.
+  */
+void OPENBL_FDCAN_GetStatistics(void)
+{
+  FdcanParamIndex = 0U;
 
-    /* Read the MSB of the size byte */
-    data                     = (*(uint8_t *)(RxData));
-    special_cmd->SizeBuffer1 = ((uint16_t)data) << 8;
+  OPENBL_ENGINE_GetStatistics(&FdcanHandle);
+}
 
-    /* Read the LSB of the size byte */
-    data                      = (*(uint8_t *)(RxData + 1));
-    special_cmd->SizeBuffer1 |= (uint16_t)data;
+/**
+  * @brief  This function is used to program in the Flash an image staged in RAM, see OPENBL_MEM_Commit.
+  * @retval None.
+  */
+void OPENBL_FDCAN_CommitMemory(void)
+{
+  FdcanParamIndex = 0U;
 
-    if (special_cmd->SizeBuffer1 > SPECIAL_CMD_SIZE_BUFFER1)
-    {
-      OPENBL_FDCAN_SendByte(NACK_BYTE);
-    }
-    else
-    {
-      if (special_cmd->SizeBuffer1 != 0U)
-      {
-        if (special_cmd->SizeBuffer1 > 64U)
-        {
-          OPENBL_FDCAN_ReadBytes(RxData, 64U);
-          OPENBL_FDCAN_ReadBytes(&RxData[64U], ((uint32_t)special_cmd->SizeBuffer1) - 64U);
-        }
-        else
-        {
-          OPENBL_FDCAN_ReadBytes(RxData, ((uint32_t) special_cmd->SizeBuffer1));
-        }
-
-        /* Read received bytes */
-        for (index = 0U; index < special_cmd->SizeBuffer1; index++)
-        {
-          special_cmd->Buffer1[index] = RxData[index];
-        }
-      }
-
-      /* Send received size acknowledgment */
-      OPENBL_FDCAN_SendByte(ACK_BYTE);
-
-      /* Process the special command */
-      OPENBL_FDCAN_SpecialCommandProcess(special_cmd);
-
-      /* NOTE: In case of any operation inside "SpecialCommandProcess" function that prevents the code
-       * from returning to here (reset operation...), to be compatible with the OpenBL protocol,
-       * the user must ensure sending the last ACK in the application side.
-       */
-
-      /* Send last acknowledgment */
-      OPENBL_FDCAN_SendByte(ACK_BYTE);
-    }
-  }
+  OPENBL_ENGINE_CommitMemory(&FdcanHandle);
 }
 
 /**
-  * @brief  This function is used to execute extended special command commands.
+  * @brief  This function is used to write in to device memory data compressed in the LZ4 block format,
+  *         see OPENBL_MEM_WriteCompressed. The frames are the Write Memory ones.
   * @retval None.
   */
-void OPENBL_FDCAN_ExtendedSpecialCommand(void)
+void OPENBL_FDCAN_CompressedWriteMemory(void)
 {
-  OPENBL_SpecialCmdTypeDef *special_cmd;
-  uint16_t op_code;
-  uint16_t index;
-  uint16_t count;
-  uint16_t single;
-  uint8_t data;
-  uint8_t data_length;
+  FdcanParamIndex = 0U;
 
+  OPENBL_ENGINE_CompressedWriteMemory(&FdcanHandle);
+}
 
-  /* Point to the RAM USART buffer to gain size and reliability */
-  special_cmd = (OPENBL_SpecialCmdTypeDef *)(uint32_t) TxData;
+/**
+  * @brief  This function is used to write in to device memory a new image built by a delta patch
+  *         from the old one, see OPENBL_MEM_WritePatch. The frames are the Write Memory ones.
+  * @retval None.
+  */
+void OPENBL_FDCAN_PatchMemory(void)
+{
+  FdcanParamIndex = 0U;
 
-  /* Send extended special command code acknowledgment */
-  OPENBL_FDCAN_SendByte(ACK_BYTE);
+  OPENBL_ENGINE_PatchMemory(&FdcanHandle);
+}
 
-  /* Get the command operation code */
-  if (OPENBL_FDCAN_GetSpecialCmdOpCode(&op_code, OPENBL_EXTENDED_SPECIAL_CMD) == NACK_BYTE)
-  {
-    OPENBL_FDCAN_SendByte(NACK_BYTE);
-  }
-  else
-  {
-    /* Send Operation code acknowledgment */
-    OPENBL_FDCAN_SendByte(ACK_BYTE);
+/**
+  * @brief  This function is used to send the CRC-32 of consecutive memory blocks, see OPENBL_MEM_GetBlockCrc.
+  * @retval None.
+  */
+void OPENBL_FDCAN_GetBlockCrc(void)
+{
+  FdcanParamIndex = 0U;
 
-    /* Initialize the special command frame */
-    special_cmd->CmdType = OPENBL_EXTENDED_SPECIAL_CMD;
-    special_cmd->OpCode  = op_code;
+  OPENBL_ENGINE_GetBlockCrc(&FdcanHandle);
+}
 
-    /* Initialize the data length variable */
-    data_length = 0U;
+/* Private functions ---------------------------------------------------------*/
 
-    /* Get the number of bytes to be received */
-    OPENBL_FDCAN_ReadBytes(RxData, 2U);
+/**
+  * @brief  This function is used to receive data from the host in 64-byte frames, the padding bytes
+  *         of the last frame are dropped.
+  * @param  pBuffer Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes to be received.
+  * @retval None.
+  */
+static void OPENBL_FDCAN_ReadFrame(uint8_t *pBuffer, uint32_t Length)
+{
+  (void)OPENBL_FDCAN_ReadFrames(pBuffer, Length);
+}
 
-    /* Read the MSB of the size byte */
-    data                    = (*(uint8_t *)(RxData));
-    special_cmd->SizeBuffer1 = ((uint16_t)data) << 8;
+/**
+  * @brief  This function is used to send data to the host in 64-byte frames, the rest of the last one
+  *         is filled with 0xFF.
+  * @param  pBuffer Pointer to the data.
+  * @param  Length The number of bytes to be sent.
+  * @retval None.
+  */
+static void OPENBL_FDCAN_SendFrame(uint8_t *pBuffer, uint32_t Length)
+{
+  uint32_t offset;
+  uint32_t frame_length;
+  uint32_t counter;
+  uint8_t frame[FDCAN_FRAME_DATA_SIZE];
 
-    /* Read the LSB of the size byte */
-    data                     = (*(uint8_t *)(RxData + 1));
-    special_cmd->SizeBuffer1 |= (uint16_t)data;
+  for (offset = 0U; offset < Length; offset += frame_length)
+  {
+    frame_length = ((Length - offset) > FDCAN_FRAME_DATA_SIZE) ? FDCAN_FRAME_DATA_SIZE : (Length - offset);
 
-    if (special_cmd->SizeBuffer1 > SPECIAL_CMD_SIZE_BUFFER1)
+    for (counter = 0U; counter < frame_length; counter++)
     {
-      OPENBL_FDCAN_SendByte(NACK_BYTE);
+      frame[counter] = pBuffer[offset + counter];
     }
-    else
+
+    /* Fill the rest of the last frame with 0xFF */
+    for (counter = frame_length; counter < FDCAN_FRAME_DATA_SIZE; counter++)
     {
-      if (special_cmd->SizeBuffer1 != 0U)
-      {
-        if (special_cmd->SizeBuffer1 > 64U)
-        {
-          OPENBL_FDCAN_ReadBytes(RxData, 64U);
-          OPENBL_FDCAN_ReadBytes(&RxData[64U], ((uint32_t)special_cmd->SizeBuffer1) - 64U);
-        }
-        else
-        {
-          OPENBL_FDCAN_ReadBytes(RxData, ((uint32_t) special_cmd->SizeBuffer1));
-        }
-
-        /* Read received bytes */
-        for (index = 0U; index < special_cmd->SizeBuffer1; index++)
-        {
-          special_cmd->Buffer1[index] = RxData[index];
-        }
-      }
-
-      /* Send receive size acknowledgment */
-      OPENBL_FDCAN_SendByte(ACK_BYTE);
-
-      /* Get the number of bytes to be received */
-      OPENBL_FDCAN_ReadBytes(RxData, 2U);
-
-      /* Read the MSB of the size byte */
-      data                    = (*(uint8_t *)(RxData));
-      special_cmd->SizeBuffer2 = ((uint16_t)data) << 8;
-
-      /* Read the LSB of the size byte */
-      data                     = (*(uint8_t *)(RxData + 1));
-      special_cmd->SizeBuffer2 |= (uint16_t)data;
-
-      if (special_cmd->SizeBuffer2 > SPECIAL_CMD_SIZE_BUFFER2)
-      {
-        OPENBL_FDCAN_SendByte(NACK_BYTE);
-      }
-      else
-      {
-        if (special_cmd->SizeBuffer2 != 0U)
-        {
-          count  = special_cmd->SizeBuffer2 / 64U;
-          single = special_cmd->SizeBuffer2 % 64U;
-
-          while (count != 0U)
-          {
-            OPENBL_FDCAN_ReadBytes(&RxData[data_length * 64U], 64U);
-            count--;
-            data_length++;
-          }
-
-          if (single != 0U)
-          {
-            OPENBL_FDCAN_ReadBytes(&RxData[data_length * 64U], single);
-          }
-
-          /* Read received bytes */
-          for (index = 0U; index < special_cmd->SizeBuffer2; index++)
-          {
-            special_cmd->Buffer2[index] = RxData[index];
-          }
-        }
-
-        /* Send receive write size acknowledgment */
-        OPENBL_FDCAN_SendByte(ACK_BYTE);
-
-        /* Process the special command */
-        OPENBL_FDCAN_SpecialCommandProcess(special_cmd);
-
-        /* NOTE: In case of any operation inside "SpecialCommandProcess" function that prevents the code
-         * from returning to here (reset operation...), to be compatible with the OpenBL protocol,
-         * the user must ensure sending the last ACK in the application side.
-         */
-
-        /* Send last acknowledgment */
-        OPENBL_FDCAN_SendByte(ACK_BYTE);
-      }
+      frame[counter] = 0xFFU;
     }
+
+    OPENBL_FDCAN_SendBytes(frame, FDCAN_DLC_BYTES_64);
   }
 }
 
-/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  This function is used to read the parameters of the command frame in order.
+  * @param  pBuffer Pointer to the parameters.
+  * @param  Length The number of bytes.
+  * @retval None.
+  */
+static void OPENBL_FDCAN_ReadParameters(uint8_t *pBuffer, uint32_t Length)
+{
+  uint32_t counter;
+
+  for (counter = 0U; counter < Length; counter++)
+  {
+    pBuffer[counter] = RxData[FdcanParamIndex];
+    FdcanParamIndex++;
+  }
+}
 
 /**
   * @brief  This function is used to construct the command List table.
@@ -875,53 +545,54 @@ static uint8_t OPENBL_FDCAN_ConstructCommandsTable(OPENBL_CommandsTypeDef *pFdca
     i++;
   }
 
-  return (i);
-}
+  if (pFdcanCmd->ExtendedReadMemory != NULL)
+  {
+    a_OPENBL_FDCAN_CommandsList[i] = CMD_EXT_READ_MEMORY;
+    i++;
+  }
 
-/**
-  * @brief  This function is used to get the operation code.
-  * @param  OpCode Pointer to the operation code to be returned.
-  * @param  CmdType Type of the command, Special command or extended special command.
-  * @retval Returns NACK status in case of error else returns ACK status.
-  */
-static uint8_t OPENBL_FDCAN_GetSpecialCmdOpCode(uint16_t *OpCode, OPENBL_SpecialCmdTypeTypeDef CmdType)
-{
-  uint8_t op_code[2];
-  uint8_t status;
-  uint8_t index;
+  if (pFdcanCmd->ExtendedWriteMemory != NULL)
+  {
+    a_OPENBL_FDCAN_CommandsList[i] = CMD_EXT_WRITE_MEMORY;
+    i++;
+  }
 
-  /* Initialize the status variable */
-  status = NACK_BYTE;
+  if (pFdcanCmd->GroupCommand != NULL)
+  {
+    a_OPENBL_FDCAN_CommandsList[i] = CMD_GROUP_COMMAND;
+    i++;
+  }
 
-  /* Get the command OpCode (2 bytes) */
-  op_code[0] = RxData[0]; /* Read the MSB byte */
-  op_code[1] = RxData[1]; /* Read the LSB byte */
+  if (pFdcanCmd->GetStatistics != NULL)
+  {
+    a_OPENBL_FDCAN_CommandsList[i] = CMD_GET_STATISTICS;
+    i++;
+  }
+
+  if ((pFdcanCmd->CommitMemory != NULL) && (OPENBL_STAGING_ENABLE == 1U))
+  {
+    a_OPENBL_FDCAN_CommandsList[i] = CMD_COMMIT_MEMORY;
+    i++;
+  }
 
-  /* Get the operation code */
-  *OpCode = ((uint16_t)op_code[0] << 8) | (uint16_t)op_code[1];
+  if ((pFdcanCmd->CompressedWriteMemory != NULL) && (OPENBL_COMPRESSED_WRITE_ENABLE == 1U))
+  {
+    a_OPENBL_FDCAN_CommandsList[i] = CMD_COMPRESSED_WRITE_MEMORY;
+    i++;
+  }
 
-  if (CmdType == OPENBL_SPECIAL_CMD)
+  if ((pFdcanCmd->PatchMemory != NULL) && (OPENBL_PATCH_ENABLE == 1U))
   {
-    for (index = 0U; index < SPECIAL_CMD_MAX_NUMBER; index++)
-    {
-      if (SpecialCmdList[index] == *OpCode)
-      {
-        status = ACK_BYTE;
-        break;
-      }
-    }
+    a_OPENBL_FDCAN_CommandsList[i] = CMD_PATCH_MEMORY;
+    i++;
   }
-  else
+
+  if ((pFdcanCmd->GetBlockCrc != NULL) && (OPENBL_BLOCK_CRC_ENABLE == 1U))
   {
-    for (index = 0U; index < EXTENDED_SPECIAL_CMD_MAX_NUMBER; index++)
-    {
-      if (ExtendedSpecialCmdList[index] == *OpCode)
-      {
-        status = ACK_BYTE;
-        break;
-      }
-    }
+    a_OPENBL_FDCAN_CommandsList[i] = CMD_GET_BLOCK_CRC;
+    i++;
   }
 
-  return status;
+  return (i);
 }
+
@@ -32,8 +32,8 @@ extern "C" {
 
 /* Exported macro ------------------------------------------------------------*/
 /* Exported variables --------------------------------------------------------*/
-extern uint8_t TxData[FDCAN_RAM_BUFFER_SIZE];
-extern uint8_t RxData[FDCAN_RAM_BUFFER_SIZE];
+extern uint8_t *TxData;
+extern uint8_t *RxData;
 
 /* Exported functions ------------------------------------------------------- */
 OPENBL_CommandsTypeDef *OPENBL_FDCAN_GetCommandsList(void);
@@ -51,6 +51,14 @@ void OPENBL_FDCAN_WriteProtect(void);
 void OPENBL_FDCAN_WriteUnprotect(void);
 void OPENBL_FDCAN_SpecialCommand(void);
 void OPENBL_FDCAN_ExtendedSpecialCommand(void);
+void OPENBL_FDCAN_ExtendedReadMemory(void);
+void OPENBL_FDCAN_ExtendedWriteMemory(void);
+void OPENBL_FDCAN_GroupCommand(void);
+void OPENBL_FDCAN_GetStatistics(void);
+void OPENBL_FDCAN_CommitMemory(void);
+void OPENBL_FDCAN_CompressedWriteMemory(void);
+void OPENBL_FDCAN_PatchMemory(void);
+void OPENBL_FDCAN_GetBlockCrc(void);
 
 #ifdef __cplusplus
 }
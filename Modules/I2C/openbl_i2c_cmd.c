@@ -19,6 +19,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "openbl_mem.h"
 #include "openbl_i2c_cmd.h"
+#include "openbl_engine.h"
 
 #include "openbootloader_conf.h"
 #include "app_openbootloader.h"
@@ -27,23 +28,71 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
-#define OPENBL_I2C_COMMANDS_NB_MAX        19U       /* Number of supported commands */
+#define OPENBL_I2C_COMMANDS_NB_MAX        24U       /* Number of supported commands */
 
-#define I2C_RAM_BUFFER_SIZE               1164U     /* Size of I2C buffer used to store received data from the host */
+#define I2C_RAM_BUFFER_SIZE               OPENBL_ENGINE_BUFFER_SIZE  /* Size of I2C buffer used to store received data from the host */
 
 /* Private macro -------------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void OPENBL_I2C_CloseFrame(void);
+static void OPENBL_I2C_ReadFrame(uint8_t *pBuffer, uint32_t Length);
+static void OPENBL_I2C_SendFrame(uint8_t *pBuffer, uint32_t Length);
+static void OPENBL_I2C_SendAck(uint8_t Ack);
+static void OPENBL_I2C_SendStretchBusy(FunctionalState State);
+static void OPENBL_I2C_SendNonStretchBusy(FunctionalState State);
+static void OPENBL_I2C_ProcessSpecialCommand(OPENBL_SpecialCmdTypeDef *SpecialCmd);
+static uint8_t OPENBL_I2C_ConstructCommandsTable(OPENBL_CommandsTypeDef *pI2cCmd);
+
 /* Private variables ---------------------------------------------------------*/
-/* Private macro -------------------------------------------------------------*/
-/* Private variables ---------------------------------------------------------*/
-/* Buffer used to store received data from the host */
-static uint8_t I2C_RAM_Buf[I2C_RAM_BUFFER_SIZE];
+/* Block transports of the I2C interface: the clock is stretched during the memory operations,
+   or busy bytes are answered to the host in the non stretch commands */
+static const OPENBL_ENGINE_TransportTypeDef I2cTransport =
+{
+  OPENBL_I2C_ReadFrame,
+  OPENBL_I2C_SendFrame,
+  OPENBL_I2C_SendAck,
+  OPENBL_I2C_SendStretchBusy,
+  OPENBL_I2C_ProcessSpecialCommand,
+  NULL
+};
+
+static const OPENBL_ENGINE_TransportTypeDef I2cNsTransport =
+{
+  OPENBL_I2C_ReadFrame,
+  OPENBL_I2C_SendFrame,
+  OPENBL_I2C_SendAck,
+  OPENBL_I2C_SendNonStretchBusy,
+  OPENBL_I2C_ProcessSpecialCommand,
+  NULL
+};
+
 static uint8_t a_OPENBL_I2C_CommandsList[OPENBL_I2C_COMMANDS_NB_MAX] = {0U};
-static uint8_t I2cCommandsNumber = 0U;
 
-/* Private function prototypes -----------------------------------------------*/
-static uint8_t OPENBL_I2C_GetAddress(uint32_t *pAddress);
-static uint8_t OPENBL_I2C_GetSpecialCmdOpCode(uint16_t *OpCode, OPENBL_SpecialCmdTypeTypeDef CmdType);
-static uint8_t OPENBL_I2C_ConstructCommandsTable(OPENBL_CommandsTypeDef *pI2cCmd);
+/* The I2C commands are run by the command engine, the two handles share the same buffer */
+static OPENBL_ENGINE_HandleTypeDef I2cHandle =
+{
+  &I2cTransport,
+  NULL,
+  I2C_RAM_BUFFER_SIZE,
+  a_OPENBL_I2C_CommandsList,
+  0U,
+  OPENBL_I2C_VERSION,
+  OPENBL_ENGINE_FRAMING_SPLIT_LENGTH
+};
+
+static OPENBL_ENGINE_HandleTypeDef I2cNsHandle =
+{
+  &I2cNsTransport,
+  NULL,
+  I2C_RAM_BUFFER_SIZE,
+  a_OPENBL_I2C_CommandsList,
+  0U,
+  OPENBL_I2C_VERSION,
+  OPENBL_ENGINE_FRAMING_SPLIT_LENGTH
+};
+
+/* Set while a frame written by the host is being received, until its STOP condition is handled */
+static uint8_t I2cFrameOpen = 0U;
 
 /* Exported variables --------------------------------------------------------*/
 /* Exported functions---------------------------------------------------------*/
@@ -75,9 +124,21 @@ OPENBL_CommandsTypeDef *OPENBL_I2C_GetCommandsList(void)
     OPENBL_I2C_NonStretchReadoutUnprotect,
     NULL,
     OPENBL_I2C_SpecialCommand,
-    OPENBL_I2C_ExtendedSpecialCommand
+    OPENBL_I2C_ExtendedSpecialCommand,
+    NULL,
+    NULL,
+    NULL,
+    OPENBL_I2C_GetStatistics,
+    OPENBL_I2C_CommitMemory,
+    OPENBL_I2C_CompressedWriteMemory,
+    OPENBL_I2C_PatchMemory,
+    OPENBL_I2C_GetBlockCrc
   };
 
+  /* The command buffer is taken from the arena shared by all the interfaces */
+  I2cHandle.pBuffer   = OPENBL_GetBuffer(I2C_RAM_BUFFER_SIZE);
+  I2cNsHandle.pBuffer = I2cHandle.pBuffer;
+
   OPENBL_I2C_SetCommandsList(&OPENBL_I2C_Commands);
 
   return (&OPENBL_I2C_Commands);
@@ -90,42 +151,17 @@ OPENBL_CommandsTypeDef *OPENBL_I2C_GetCommandsList(void)
 void OPENBL_I2C_SetCommandsList(OPENBL_CommandsTypeDef *pI2cCmd)
 {
   /* Get the list of commands supported & their numbers */
-  I2cCommandsNumber = OPENBL_I2C_ConstructCommandsTable(pI2cCmd);
+  I2cHandle.CommandsNumber   = OPENBL_I2C_ConstructCommandsTable(pI2cCmd);
+  I2cNsHandle.CommandsNumber = I2cHandle.CommandsNumber;
 }
 
 /**
-  * @brief  This function is used to get the list of the available I2C commands
+  * @brief  This function is used to get the list of the available I2C commands.
   * @retval None.
   */
 void OPENBL_I2C_GetCommand(void)
 {
-  uint32_t counter;
-
-  OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-  /* Wait for address to match */
-  OPENBL_I2C_WaitAddress();
-
-  /* Send the number of commands supported by the I2C protocol */
-  OPENBL_I2C_SendByte(I2cCommandsNumber);
-
-  /* Send I2C protocol version */
-  OPENBL_I2C_SendByte(OPENBL_I2C_VERSION);
-
-  /* Send the list of supported commands */
-  for (counter = 0U; counter < I2cCommandsNumber; counter++)
-  {
-    OPENBL_I2C_SendByte(a_OPENBL_I2C_CommandsList[counter]);
-  }
-
-  /* Wait until NACK is detected */
-  OPENBL_I2C_WaitNack();
-
-  /* Wait until STOP is detected */
-  OPENBL_I2C_WaitStop();
-
-  /* Send last Acknowledge synchronization byte */
-  OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
+  OPENBL_ENGINE_GetCommand(&I2cHandle);
 }
 
 /**
@@ -134,23 +170,7 @@ void OPENBL_I2C_GetCommand(void)
   */
 void OPENBL_I2C_GetVersion(void)
 {
-  /* Send Acknowledge byte to notify the host that the command is recognized */
-  OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-  /* Wait for address to match */
-  OPENBL_I2C_WaitAddress();
-
-  /* Send I2C protocol version */
-  OPENBL_I2C_SendByte(OPENBL_I2C_VERSION);
-
-  /* Wait until NACK is detected */
-  OPENBL_I2C_WaitNack();
-
-  /* Wait until STOP is detected */
-  OPENBL_I2C_WaitStop();
-
-  /* Send last Acknowledge synchronization byte */
-  OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
+  OPENBL_ENGINE_GetVersion(&I2cHandle);
 }
 
 /**
@@ -159,26 +179,7 @@ void OPENBL_I2C_GetVersion(void)
   */
 void OPENBL_I2C_GetID(void)
 {
-  /* Send Acknowledge byte to notify the host that the command is recognized */
-  OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-  /* Wait for address to match */
-  OPENBL_I2C_WaitAddress();
-
-  OPENBL_I2C_SendByte(0x01U);
-
-  /* Send the device ID starting by the MSB byte then the LSB byte */
-  OPENBL_I2C_SendByte(DEVICE_ID_MSB);
-  OPENBL_I2C_SendByte(DEVICE_ID_LSB);
-
-  /* Wait until NACK is detected */
-  OPENBL_I2C_WaitNack();
-
-  /* Wait until STOP is detected */
-  OPENBL_I2C_WaitStop();
-
-  /* Send last Acknowledge synchronization byte */
-  OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
+  OPENBL_ENGINE_GetID(&I2cHandle);
 }
 
 /**
@@ -187,67 +188,7 @@ void OPENBL_I2C_GetID(void)
   */
 void OPENBL_I2C_ReadMemory(void)
 {
-  uint32_t address;
-  uint32_t counter;
-  uint32_t memory_index;
-  uint8_t data;
-  uint8_t xor;
-
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Get the memory address */
-    if (OPENBL_I2C_GetAddress(&address) == NACK_BYTE)
-    {
-      OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-      /* Wait for address to match */
-      OPENBL_I2C_WaitAddress();
-
-      /* Get the number of bytes to be received */
-      data = OPENBL_I2C_ReadByte();
-      xor  = ~data;
-
-      /* Check data integrity */
-      if (OPENBL_I2C_ReadByte() != xor)
-      {
-        OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-        /* Get the memory index to know from which memory we will read */
-        memory_index = OPENBL_MEM_GetMemoryIndex(address);
-
-        /* Wait for address to match */
-        OPENBL_I2C_WaitAddress();
-
-        /* Read the data (data + 1) from the memory and send them to the host */
-        for (counter = ((uint32_t)data + 1U); counter != 0U; counter--)
-        {
-          OPENBL_I2C_SendByte(OPENBL_MEM_Read(address, memory_index));
-          address++;
-        }
-
-        /* Wait until NACK is detected */
-        OPENBL_I2C_WaitNack();
-
-        /* Wait until STOP is detected */
-        OPENBL_I2C_WaitStop();
-      }
-    }
-  }
+  OPENBL_ENGINE_ReadMemory(&I2cHandle);
 }
 
 /**
@@ -256,74 +197,7 @@ void OPENBL_I2C_ReadMemory(void)
   */
 void OPENBL_I2C_WriteMemory(void)
 {
-  uint32_t address;
-  uint32_t xor;
-  uint32_t counter;
-  uint32_t codesize;
-  uint8_t *p_ramaddress;
-  uint8_t data;
-
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Get the memory address */
-    if (OPENBL_I2C_GetAddress(&address) == NACK_BYTE)
-    {
-      OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-      /* Read number of bytes to be written and data */
-      p_ramaddress = (uint8_t *)I2C_RAM_Buf;
-
-      OPENBL_I2C_WaitAddress();
-
-      /* Read the number of bytes to be written: Max number of data = data + 1 = 256 */
-      data = OPENBL_I2C_ReadByte();
-
-      /* Number of data to be written = data + 1 */
-      codesize = (uint32_t)data + 1U;
-
-      /* Checksum Initialization */
-      xor = data;
-
-      /* I2C receive data and send to RAM Buffer */
-      for (counter = codesize; counter != 0U ; counter--)
-      {
-        data    = OPENBL_I2C_ReadByte();
-        xor ^= data;
-
-        *(__IO uint8_t *)(p_ramaddress) = data;
-
-        p_ramaddress++;
-      }
-
-      /* Send NACk if Checksum is incorrect */
-      if (OPENBL_I2C_ReadByte() != xor)
-      {
-        OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        /* Write data to memory */
-        OPENBL_MEM_Write(address, (uint8_t *)I2C_RAM_Buf, codesize);
-
-        /* Send last Acknowledge synchronization byte */
-        OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-        /* Start post processing task if needed */
-        Common_StartPostProcessing();
-      }
-    }
-  }
+  OPENBL_ENGINE_WriteMemory(&I2cHandle);
 }
 
 /**
@@ -332,41 +206,7 @@ void OPENBL_I2C_WriteMemory(void)
   */
 void OPENBL_I2C_Go(void)
 {
-  uint32_t address;
-  uint8_t status;
-
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Get memory address */
-    if (OPENBL_I2C_GetAddress(&address) == NACK_BYTE)
-    {
-      OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      /* Check if received address is valid or not */
-      status = OPENBL_MEM_CheckJumpAddress(address);
-
-      if (status == 0U)
-      {
-        OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        /* If the jump address is valid then send ACK */
-        OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-        OPENBL_MEM_JumpToAddress(address);
-      }
-    }
-  }
+  OPENBL_ENGINE_Go(&I2cHandle);
 }
 
 /**
@@ -375,43 +215,16 @@ void OPENBL_I2C_Go(void)
   */
 void OPENBL_I2C_ReadoutProtect(void)
 {
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Enable the read protection */
-    OPENBL_MEM_SetReadOutProtection(OPENBL_DEFAULT_MEM, ENABLE);
-
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Start post processing task if needed */
-    Common_StartPostProcessing();
-  }
+  OPENBL_ENGINE_ReadoutProtect(&I2cHandle);
 }
 
 /**
   * @brief  This function is used to disable readout protection.
-  * @note   Going from RDP level 1 to RDP level 0 erase all the flash,
-  *         so the send of second acknowledge after Disabling the read protection
-  *         is not possible what make the communication with the host get lost
   * @retval None.
   */
 void OPENBL_I2C_ReadoutUnprotect(void)
 {
-  OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-  OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-  /* Disable the read protection */
-  OPENBL_MEM_SetReadOutProtection(OPENBL_DEFAULT_MEM, DISABLE);
-
-  /* Start post processing task if needed */
-  Common_StartPostProcessing();
+  OPENBL_ENGINE_ReadoutUnprotect(&I2cHandle);
 }
 
 /**
@@ -420,150 +233,7 @@ void OPENBL_I2C_ReadoutUnprotect(void)
   */
 void OPENBL_I2C_EraseMemory(void)
 {
-  uint32_t xor;
-  uint32_t counter;
-  uint32_t numpage;
-  uint16_t data;
-  ErrorStatus error_value;
-  uint8_t status = ACK_BYTE;
-  uint8_t *p_ramaddress;
-
-  p_ramaddress = (uint8_t *) I2C_RAM_Buf;
-
-  /* Check if the memory is not protected */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Wait for address to match */
-    OPENBL_I2C_WaitAddress();
-
-    /* Read number of pages to be erased */
-    data = OPENBL_I2C_ReadByte();
-    data = (uint16_t)(data << 8) | OPENBL_I2C_ReadByte();
-
-    /* Checksum initialization */
-    xor  = ((uint32_t)data & 0xFF00U) >> 8;
-    xor ^= (uint32_t)data & 0x00FFU;
-
-    /* All commands in range 0xFFFZ are reserved for special erase features */
-    if ((data & 0xFFF0U) == 0xFFF0U)
-    {
-      /* Check data integrity */
-      if (OPENBL_I2C_ReadByte() != (uint8_t) xor)
-      {
-        OPENBL_I2C_WaitStop();
-
-        status = NACK_BYTE;
-      }
-      else
-      {
-        OPENBL_I2C_WaitStop();
-
-        if ((data == 0xFFFFU) || (data == 0xFFFEU) || (data == 0xFFFDU))
-        {
-          p_ramaddress[0] = (uint8_t)(data & 0x00FFU);
-          p_ramaddress[1] = (uint8_t)((data & 0xFF00U) >> 8);
-
-          error_value = OPENBL_MEM_MassErase(OPENBL_DEFAULT_MEM, (uint8_t *) I2C_RAM_Buf, I2C_RAM_BUFFER_SIZE);
-
-          if (error_value == SUCCESS)
-          {
-            status = ACK_BYTE;
-          }
-          else
-          {
-            status = NACK_BYTE;
-          }
-        }
-        else
-        {
-          /* This sub-command is not supported */
-          status = NACK_BYTE;
-        }
-      }
-    }
-    else
-    {
-      /* Check data integrity */
-      if (OPENBL_I2C_ReadByte() != (uint8_t) xor)
-      {
-        OPENBL_I2C_WaitStop();
-
-        status = NACK_BYTE;
-      }
-      else
-      {
-        OPENBL_I2C_WaitStop();
-
-        OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-        p_ramaddress = (uint8_t *) I2C_RAM_Buf;
-
-        /* Number of pages to be erased (data + 1) */
-        numpage = (uint32_t)data + 1U;
-
-        *p_ramaddress = (uint8_t)(numpage & 0x00FFU);
-        p_ramaddress++;
-
-        *p_ramaddress = (uint8_t)((numpage & 0xFF00U) >> 8);
-        p_ramaddress++;
-
-        OPENBL_I2C_WaitAddress();
-
-        xor = 0;
-
-        /* Get the pages to be erased */
-        for (counter = numpage; counter != 0U ; counter--)
-        {
-          /* Receive the MSB byte */
-          data  = OPENBL_I2C_ReadByte();
-          xor  ^= data;
-          data  = (uint16_t)((data & 0x00FFU) << 8);
-
-          /* Receive the LSB byte */
-          data |= (uint8_t)(OPENBL_I2C_ReadByte() & 0x00FFU);
-          xor  ^= ((uint32_t)data & 0x00FFU);
-
-          /* Only store data that fit in the buffer length */
-          if (counter < (I2C_RAM_BUFFER_SIZE / 2U))
-          {
-            *p_ramaddress = (uint8_t)(data & 0x00FFU);
-            p_ramaddress++;
-
-            *p_ramaddress = (uint8_t)((data & 0xFF00U) >> 8);
-            p_ramaddress++;
-          }
-        }
-
-        /* Check data integrity */
-        if (OPENBL_I2C_ReadByte() != (uint8_t) xor)
-        {
-          OPENBL_I2C_WaitStop();
-
-          status = NACK_BYTE;
-        }
-        else
-        {
-          OPENBL_I2C_WaitStop();
-
-          error_value = OPENBL_MEM_Erase(OPENBL_DEFAULT_MEM, (uint8_t *) I2C_RAM_Buf, I2C_RAM_BUFFER_SIZE);
-
-          /* Errors from memory erase are not managed, always return ACK */
-          if (error_value == SUCCESS)
-          {
-            status = ACK_BYTE;
-          }
-        }
-      }
-    }
-
-    OPENBL_I2C_SendAcknowledgeByte(status);
-  }
+  OPENBL_ENGINE_EraseMemory(&I2cHandle);
 }
 
 /**
@@ -572,82 +242,7 @@ void OPENBL_I2C_EraseMemory(void)
   */
 void OPENBL_I2C_WriteProtect(void)
 {
-  uint16_t counter;
-  uint16_t length;
-  uint8_t data;
-  uint8_t xor;
-  ErrorStatus error_value;
-  uint8_t *p_ramaddress;
-
-  /* Check if the memory is not protected */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Wait for address to match */
-    OPENBL_I2C_WaitAddress();
-
-    /* Get the data length */
-    data = OPENBL_I2C_ReadByte();
-    xor  = ~data;
-
-    /* Send NACk if Checksum is incorrect */
-    if (OPENBL_I2C_ReadByte() != xor)
-    {
-      OPENBL_I2C_WaitStop();
-      OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      OPENBL_I2C_WaitStop();
-      OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-      p_ramaddress = (uint8_t *) I2C_RAM_Buf;
-      length       = (uint16_t) data + 1U;
-
-      /* Checksum Initialization */
-      xor = 0U;
-
-      /* Wait for address to match */
-      OPENBL_I2C_WaitAddress();
-
-      /* Receive data and write to RAM Buffer */
-      for (counter = (length); counter != 0U ; counter--)
-      {
-        data  = OPENBL_I2C_ReadByte();
-        xor  ^= data;
-
-        *(__IO uint8_t *)(p_ramaddress) = (uint8_t) data;
-
-        p_ramaddress++;
-      }
-
-      /* Check data integrity and send NACK if Checksum is incorrect */
-      if (OPENBL_I2C_ReadByte() != (uint8_t) xor)
-      {
-        OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        p_ramaddress = (uint8_t *) I2C_RAM_Buf;
-
-        /* Enable the write protection */
-        error_value = OPENBL_MEM_SetWriteProtection(ENABLE, OPENBL_DEFAULT_MEM, p_ramaddress, length);
-
-        OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-        if (error_value == SUCCESS)
-        {
-          /* Start post processing task if needed */
-          Common_StartPostProcessing();
-        }
-      }
-    }
-  }
+  OPENBL_ENGINE_WriteProtect(&I2cHandle);
 }
 
 /**
@@ -656,28 +251,7 @@ void OPENBL_I2C_WriteProtect(void)
   */
 void OPENBL_I2C_WriteUnprotect(void)
 {
-  ErrorStatus error_value;
-
-  /* Check if the memory is not protected */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Disable write protection */
-    error_value = OPENBL_MEM_SetWriteProtection(DISABLE, OPENBL_DEFAULT_MEM, NULL, 0U);
-
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    if (error_value == SUCCESS)
-    {
-      /* Start post processing task if needed */
-      Common_StartPostProcessing();
-    }
-  }
+  OPENBL_ENGINE_WriteUnprotect(&I2cHandle);
 }
 
 /**
@@ -688,80 +262,7 @@ void OPENBL_I2C_WriteUnprotect(void)
   */
 void OPENBL_I2C_NonStretchWriteMemory(void)
 {
-  uint32_t address;
-  uint32_t xor;
-  uint32_t counter;
-  uint32_t codesize;
-  uint8_t *p_ramaddress;
-  uint8_t data;
-
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Get the memory address */
-    if (OPENBL_I2C_GetAddress(&address) == NACK_BYTE)
-    {
-      OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-      /* Read number of bytes to be written and data */
-      p_ramaddress = (uint8_t *)I2C_RAM_Buf;
-
-      OPENBL_I2C_WaitAddress();
-
-      /* Read the number of bytes to be written: Max number of data = data + 1 = 256 */
-      data = OPENBL_I2C_ReadByte();
-
-      /* Number of data to be written = data + 1 */
-      codesize = (uint32_t)data + 1U;
-
-      /* Checksum Initialization */
-      xor = data;
-
-      /* I2C receive data and send to RAM Buffer */
-      for (counter = codesize; counter != 0U ; counter--)
-      {
-        data  = OPENBL_I2C_ReadByte();
-        xor  ^= data;
-
-        *(__IO uint8_t *)(p_ramaddress) = data;
-
-        p_ramaddress++;
-      }
-
-      /* Send NACk if Checksum is incorrect */
-      if (OPENBL_I2C_ReadByte() != xor)
-      {
-        OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        /* Send Busy Byte */
-        OPENBL_Enable_BusyState_Sending();
-
-        /* Write data to memory */
-        OPENBL_MEM_Write(address, (uint8_t *)I2C_RAM_Buf, codesize);
-
-        /* Send Busy Byte */
-        OPENBL_Disable_BusyState_Sending();
-
-        /* Send last Acknowledge synchronization byte */
-        OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-        /* Start post processing task if needed */
-        Common_StartPostProcessing();
-      }
-    }
-  }
+  OPENBL_ENGINE_WriteMemory(&I2cNsHandle);
 }
 
 /**
@@ -772,157 +273,7 @@ void OPENBL_I2C_NonStretchWriteMemory(void)
   */
 void OPENBL_I2C_NonStretchEraseMemory(void)
 {
-  uint32_t xor;
-  uint32_t counter;
-  uint32_t numpage;
-  uint16_t data;
-  ErrorStatus error_value;
-  uint8_t status = ACK_BYTE;
-  uint8_t *p_ramaddress;
-
-  p_ramaddress = (uint8_t *) I2C_RAM_Buf;
-
-  /* Check if the memory is not protected */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Wait for address to match */
-    OPENBL_I2C_WaitAddress();
-
-    /* Read number of pages to be erased */
-    data = OPENBL_I2C_ReadByte();
-    data = (uint16_t)(data << 8) | OPENBL_I2C_ReadByte();
-
-    /* Checksum initialization */
-    xor  = ((uint32_t)data & 0xFF00U) >> 8;
-    xor ^= (uint32_t)data & 0x00FFU;
-
-    /* All commands in range 0xFFFZ are reserved for special erase features */
-    if ((data & 0xFFF0U) == 0xFFF0U)
-    {
-      /* Check data integrity */
-      if (OPENBL_I2C_ReadByte() != (uint8_t) xor)
-      {
-        OPENBL_I2C_WaitStop();
-        status = NACK_BYTE;
-      }
-      else
-      {
-        OPENBL_I2C_WaitStop();
-
-        /* Send Busy Byte */
-        OPENBL_Enable_BusyState_Sending();
-
-        if ((data == 0xFFFFU) || (data == 0xFFFEU) || (data == 0xFFFDU))
-        {
-          p_ramaddress[0] = (uint8_t)(data & 0x00FFU);
-          p_ramaddress[1] = (uint8_t)((data & 0xFF00U) >> 8);
-
-          error_value = OPENBL_MEM_MassErase(OPENBL_DEFAULT_MEM, (uint8_t *) I2C_RAM_Buf, I2C_RAM_BUFFER_SIZE);
-
-          if (error_value == SUCCESS)
-          {
-            status = ACK_BYTE;
-          }
-          else
-          {
-            status = NACK_BYTE;
-          }
-        }
-        else
-        {
-          /* This sub-command is not supported */
-          status = NACK_BYTE;
-        }
-      }
-    }
-    else
-    {
-      /* Check data integrity */
-      if (OPENBL_I2C_ReadByte() != (uint8_t) xor)
-      {
-        OPENBL_I2C_WaitStop();
-        status = NACK_BYTE;
-      }
-      else
-      {
-        OPENBL_I2C_WaitStop();
-        OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-        p_ramaddress = (uint8_t *) I2C_RAM_Buf;
-
-        /* Number of pages to be erased (data + 1) */
-        numpage = (uint32_t)data + 1U;
-
-        *p_ramaddress = (uint8_t)(numpage & 0x00FFU);
-        p_ramaddress++;
-
-        *p_ramaddress = (uint8_t)((numpage & 0xFF00U) >> 8);
-        p_ramaddress++;
-
-        /* Wait for address to match */
-        OPENBL_I2C_WaitAddress();
-
-        /* Checksum Initialization */
-        xor = 0U;
-
-        /* Get the pages to be erased */
-        for (counter = numpage; counter != 0U ; counter--)
-        {
-          /* Receive the MSB byte */
-          data  = OPENBL_I2C_ReadByte();
-          xor  ^= data;
-          data  = (uint16_t)((data & 0x00FFU) << 8);
-
-          /* Receive the LSB byte */
-          data |= (uint8_t)(OPENBL_I2C_ReadByte() & 0x00FFU);
-          xor  ^= ((uint32_t)data & 0x00FFU);
-
-          /* Only store data that fit in the buffer length */
-          if (counter < (I2C_RAM_BUFFER_SIZE / 2U))
-          {
-            *p_ramaddress = (uint8_t)(data & 0x00FFU);
-            p_ramaddress++;
-
-            *p_ramaddress = (uint8_t)((data & 0xFF00U) >> 8);
-            p_ramaddress++;
-          }
-        }
-
-        /* Check data integrity */
-        if (OPENBL_I2C_ReadByte() != (uint8_t) xor)
-        {
-          OPENBL_I2C_WaitStop();
-          status = NACK_BYTE;
-        }
-        else
-        {
-          OPENBL_I2C_WaitStop();
-
-          /* Send Busy Byte */
-          OPENBL_Enable_BusyState_Sending();
-
-          error_value = OPENBL_MEM_Erase(OPENBL_DEFAULT_MEM, (uint8_t *) I2C_RAM_Buf, I2C_RAM_BUFFER_SIZE);
-
-          /* Disable Busy Byte */
-          OPENBL_Disable_BusyState_Sending();
-
-          /* Errors from memory erase are not managed, always return ACK */
-          if (error_value == SUCCESS)
-          {
-            status = ACK_BYTE;
-          }
-        }
-      }
-    }
-
-    OPENBL_I2C_SendAcknowledgeByte(status);
-  }
+  OPENBL_ENGINE_EraseMemory(&I2cNsHandle);
 }
 
 /**
@@ -933,90 +284,7 @@ void OPENBL_I2C_NonStretchEraseMemory(void)
   */
 void OPENBL_I2C_NonStretchWriteProtect(void)
 {
-  uint16_t counter;
-  uint16_t length;
-  uint8_t data;
-  uint8_t xor;
-  ErrorStatus error_value;
-  uint8_t *p_ramaddress;
-
-  /* Check if the memory is not protected */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Wait for address to match */
-    OPENBL_I2C_WaitAddress();
-
-    /* Get the data length */
-    data = OPENBL_I2C_ReadByte();
-    xor  = ~data;
-
-    /* Send NACk if Checksum is incorrect */
-    if (OPENBL_I2C_ReadByte() != xor)
-    {
-      OPENBL_I2C_WaitStop();
-      OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      OPENBL_I2C_WaitStop();
-      OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-      p_ramaddress = (uint8_t *) I2C_RAM_Buf;
-      length       = (uint16_t) data + 1U;
-
-      /* Checksum Initialization */
-      xor = 0U;
-
-      /* Wait for address to match */
-      OPENBL_I2C_WaitAddress();
-
-      /* Receive data and write to RAM Buffer */
-      for (counter = (length); counter != 0U ; counter--)
-      {
-        data  = OPENBL_I2C_ReadByte();
-        xor  ^= data;
-
-        *(__IO uint8_t *)(p_ramaddress) = (uint8_t) data;
-
-        p_ramaddress++;
-      }
-
-      /* Check data integrity and send NACK if Checksum is incorrect */
-      if (OPENBL_I2C_ReadByte() != (uint8_t) xor)
-      {
-        OPENBL_I2C_WaitStop();
-        OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        OPENBL_I2C_WaitStop();
-        p_ramaddress = (uint8_t *) I2C_RAM_Buf;
-
-        /* Send Busy Byte */
-        OPENBL_Enable_BusyState_Sending();
-
-        /* Enable the write protection */
-        error_value = OPENBL_MEM_SetWriteProtection(ENABLE, OPENBL_DEFAULT_MEM, p_ramaddress, length);
-
-        /* Disable Busy Byte */
-        OPENBL_Disable_BusyState_Sending();
-
-        if (error_value == SUCCESS)
-        {
-          OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-          /* Start post processing task if needed */
-          Common_StartPostProcessing();
-        }
-      }
-    }
-  }
+  OPENBL_ENGINE_WriteProtect(&I2cNsHandle);
 }
 
 /**
@@ -1027,34 +295,7 @@ void OPENBL_I2C_NonStretchWriteProtect(void)
   */
 void OPENBL_I2C_NonStretchWriteUnprotect(void)
 {
-  ErrorStatus error_value;
-
-  /* Check if the memory is not protected */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Send Busy Byte */
-    OPENBL_Enable_BusyState_Sending();
-
-    /* Disable write protection */
-    error_value = OPENBL_MEM_SetWriteProtection(DISABLE, OPENBL_DEFAULT_MEM, NULL, 0U);
-
-    /* Disable Busy Byte */
-    OPENBL_Disable_BusyState_Sending();
-
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    if (error_value == SUCCESS)
-    {
-      /* Start post processing task if needed */
-      Common_StartPostProcessing();
-    }
-  }
+  OPENBL_ENGINE_WriteUnprotect(&I2cNsHandle);
 }
 
 /**
@@ -1065,356 +306,220 @@ void OPENBL_I2C_NonStretchWriteUnprotect(void)
   */
 void OPENBL_I2C_NonStretchReadoutProtect(void)
 {
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Send Busy Byte */
-    OPENBL_Enable_BusyState_Sending();
-
-    /* Enable the read protection */
-    OPENBL_MEM_SetReadOutProtection(OPENBL_DEFAULT_MEM, ENABLE);
-
-    /* Disable Busy Byte */
-    OPENBL_Disable_BusyState_Sending();
-
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Start post processing task if needed */
-    Common_StartPostProcessing();
-  }
+  OPENBL_ENGINE_ReadoutProtect(&I2cNsHandle);
 }
 
 /**
   * @brief  This function is used to disable readout protection in non stretch mode.
   * @note   In this mode, when disabling the readout protection the device
-  *         send busy bytes to the host.
-  *         going from RDP level 1 to RDP level 0 erase all the flash,
-  *         so the send of second acknowledge after Disabling the read protection
-  *         is not possible what make the communication with the host get lost
+  *         send busy bytes to the host
   * @retval None.
   */
 void OPENBL_I2C_NonStretchReadoutUnprotect(void)
 {
-  OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-  OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
+  OPENBL_ENGINE_ReadoutUnprotect(&I2cNsHandle);
+}
 
-  /* Send Busy Byte */
-  OPENBL_Enable_BusyState_Sending();
+/**
+  * @brief  This function is used to execute special command commands.
+  * @retval None.
+  */
+void OPENBL_I2C_SpecialCommand(void)
+{
+  OPENBL_ENGINE_SpecialCommand(&I2cHandle);
+}
 
-  /* Disable the read protection */
-  OPENBL_MEM_SetReadOutProtection(OPENBL_DEFAULT_MEM, DISABLE);
+/**
+  * @brief  This function is used to execute extended special command commands.
+  * @retval None.
+  */
+void OPENBL_I2C_ExtendedSpecialCommand(void)
+{
+  OPENBL_ENGINE_ExtendedSpecialCommand(&I2cHandle);
+}
 
-  /* Disable Busy Byte */
-  OPENBL_Disable_BusyState_Sending();
+/**
+  * @brief  This function is used to send the statistics recorded by the Open Bootloader.
+  * @retval None.
+  */
+void OPENBL_I2C_GetStatistics(void)
+{
+  OPENBL_ENGINE_GetStatistics(&I2cHandle);
+}
 
-  /* Start post processing task if needed */
-  Common_StartPostProcessing();
+/**
+  * @brief  This function is used to program in the Flash an image staged in RAM.
+  * @retval None.
+  */
+void OPENBL_I2C_CommitMemory(void)
+{
+  OPENBL_ENGINE_CommitMemory(&I2cHandle);
 }
 
 /**
-  * @brief  This function is used to get a valid address.
-  * @retval Returns NACK status in case of error else returns ACK status.
+  * @brief  This function is used to write in to device memory data compressed in the LZ4 block format.
+  * @retval None.
   */
-uint8_t OPENBL_I2C_GetAddress(uint32_t *pAddress)
+void OPENBL_I2C_CompressedWriteMemory(void)
 {
-  uint8_t data[4] = {0U, 0U, 0U, 0U};
-  uint8_t status;
-  uint8_t xor;
+  OPENBL_ENGINE_CompressedWriteMemory(&I2cHandle);
+}
 
-  /* Wait for address to match */
-  OPENBL_I2C_WaitAddress();
+/**
+  * @brief  This function is used to write in to device memory a new image built by a delta patch.
+  * @retval None.
+  */
+void OPENBL_I2C_PatchMemory(void)
+{
+  OPENBL_ENGINE_PatchMemory(&I2cHandle);
+}
 
-  data[3] = OPENBL_I2C_ReadByte();
-  data[2] = OPENBL_I2C_ReadByte();
-  data[1] = OPENBL_I2C_ReadByte();
-  data[0] = OPENBL_I2C_ReadByte();
+/**
+  * @brief  This function is used to send the CRC-32 of consecutive memory blocks.
+  * @retval None.
+  */
+void OPENBL_I2C_GetBlockCrc(void)
+{
+  OPENBL_ENGINE_GetBlockCrc(&I2cHandle);
+}
 
-  xor = data[3] ^ data[2] ^ data[1] ^ data[0];
+/* Private functions ---------------------------------------------------------*/
 
-  /* Check the integrity of received data */
-  if (OPENBL_I2C_ReadByte() != xor)
-  {
-    status = NACK_BYTE;
-  }
-  else
+/**
+  * @brief  This function is used to wait for the STOP condition of the frame written by the host, if any.
+  * @retval None.
+  */
+static void OPENBL_I2C_CloseFrame(void)
+{
+  if (I2cFrameOpen != 0U)
   {
     /* Wait until STOP is detected */
     OPENBL_I2C_WaitStop();
 
-    *pAddress = ((uint32_t)data[3] << 24) | ((uint32_t)data[2] << 16) | ((uint32_t)data[1] << 8) | (uint32_t)data[0];
-
-    /* Check if received address is valid or not */
-    if (OPENBL_MEM_GetAddressArea(*pAddress) == AREA_ERROR)
-    {
-      status = NACK_BYTE;
-    }
-    else
-    {
-      status = ACK_BYTE;
-    }
+    I2cFrameOpen = 0U;
   }
-
-  return status;
 }
 
 /**
-  * @brief  This function is used to execute special command commands.
+  * @brief  This function is used to receive bytes of the current host frame.
+  *         The address is matched once per frame, a frame can be read in several parts.
+  * @param  pBuffer Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes.
   * @retval None.
   */
-void OPENBL_I2C_SpecialCommand(void)
+static void OPENBL_I2C_ReadFrame(uint8_t *pBuffer, uint32_t Length)
 {
-  OPENBL_SpecialCmdTypeDef *special_cmd;
-  uint16_t op_code;
-  uint8_t xor;
-  uint8_t index;
-  uint8_t data;
+  uint32_t counter;
 
-  /* Point to the RAM I2C buffer to gain size and reliability */
-  special_cmd = (OPENBL_SpecialCmdTypeDef *)(uint32_t) I2C_RAM_Buf;
+  if (I2cFrameOpen == 0U)
+  {
+    /* Wait for address to match */
+    OPENBL_I2C_WaitAddress();
 
-  /* Send Operation code acknowledgment */
-  OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
+    I2cFrameOpen = 1U;
+  }
+
+  for (counter = 0U; counter < Length; counter++)
+  {
+    pBuffer[counter] = OPENBL_I2C_ReadByte();
+  }
+}
+
+/**
+  * @brief  This function is used to send a data frame read by the host.
+  * @param  pBuffer Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval None.
+  */
+static void OPENBL_I2C_SendFrame(uint8_t *pBuffer, uint32_t Length)
+{
+  uint32_t counter;
+
+  OPENBL_I2C_CloseFrame();
 
   /* Wait for address to match */
   OPENBL_I2C_WaitAddress();
 
-  /* Get the command operation code */
-  if (OPENBL_I2C_GetSpecialCmdOpCode(&op_code, OPENBL_SPECIAL_CMD) == NACK_BYTE)
+  for (counter = 0U; counter < Length; counter++)
   {
-    OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
+    OPENBL_I2C_SendByte(pBuffer[counter]);
   }
-  else
-  {
-    /* Send Operation code acknowledgment */
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
 
-    /* Wait for address to match */
-    OPENBL_I2C_WaitAddress();
+  /* Wait until NACK is detected */
+  OPENBL_I2C_WaitNack();
 
-    /* Initialize the special command frame */
-    special_cmd->CmdType = OPENBL_SPECIAL_CMD;
-    special_cmd->OpCode  = op_code;
-
-    /* Initialize the xor variable */
-    xor = 0U;
-
-    /* Get the number of bytes to be received */
-    /* Read the MSB of the size byte */
-    data                     = OPENBL_I2C_ReadByte();
-    special_cmd->SizeBuffer1 = ((uint16_t)data) << 8;
-    xor                     ^= data;
-
-    /* Read the LSB of the size byte */
-    data                      = OPENBL_I2C_ReadByte();
-    special_cmd->SizeBuffer1 |= (uint16_t)data;
-    xor                      ^= data;
-
-    if (special_cmd->SizeBuffer1 > SPECIAL_CMD_SIZE_BUFFER1)
-    {
-      OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      if (special_cmd->SizeBuffer1 != 0U)
-      {
-        /* Read received bytes */
-        for (index = 0U; index < special_cmd->SizeBuffer1; index++)
-        {
-          data                        = OPENBL_I2C_ReadByte();
-          special_cmd->Buffer1[index] = data;
-          xor                        ^= data;
-        }
-      }
-
-      /* Check data integrity */
-      if (OPENBL_I2C_ReadByte() != xor)
-      {
-        OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        /* Send received size acknowledgment */
-        OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-        /* Wait for address to match */
-        OPENBL_I2C_WaitAddress();
-
-        /* Process the special command */
-        OPENBL_I2C_SpecialCommandProcess(special_cmd);
-
-        /* NOTE: In case of any operation inside "SpecialCommandProcess" function that prevents the code
-         * from returning to here (reset operation...), to be compatible with the OpenBL protocol,
-         * the user must ensure sending the last ACK in the application side.
-         */
-
-        /* Send acknowledgment */
-        OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-        /* Wait until NACK is detected */
-        OPENBL_I2C_WaitNack();
-
-        /* Wait until STOP is detected */
-        OPENBL_I2C_WaitStop();
-      }
-    }
-  }
+  /* Wait until STOP is detected */
+  OPENBL_I2C_WaitStop();
 }
 
 /**
-  * @brief  This function is used to execute extended special command commands.
+  * @brief  This function is used to send an acknowledge byte once the host frame is ended.
+  * @param  Ack ACK_BYTE or NACK_BYTE.
   * @retval None.
   */
-void OPENBL_I2C_ExtendedSpecialCommand(void)
+static void OPENBL_I2C_SendAck(uint8_t Ack)
 {
-  OPENBL_SpecialCmdTypeDef *special_cmd;
-  uint16_t op_code;
-  uint16_t index;
-  uint8_t xor;
-  uint8_t data;
-
-  /* Point to the RAM I2C buffer to gain size and reliability */
-  special_cmd = (OPENBL_SpecialCmdTypeDef *)(uint32_t) I2C_RAM_Buf;
+  OPENBL_I2C_CloseFrame();
 
-  /* Send Operation code acknowledgment */
-  OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
+  OPENBL_I2C_SendAcknowledgeByte(Ack);
+}
 
-  /* Wait for address to match */
-  OPENBL_I2C_WaitAddress();
+/**
+  * @brief  This function is used around the memory operations of the stretch commands.
+  *         The host frame is ended before the operation, the clock is then stretched until the acknowledge.
+  * @param  State ENABLE before the memory operation, DISABLE after it.
+  * @retval None.
+  */
+static void OPENBL_I2C_SendStretchBusy(FunctionalState State)
+{
+  if (State == ENABLE)
+  {
+    OPENBL_I2C_CloseFrame();
+  }
+}
 
-  /* Get the command operation code */
-  if (OPENBL_I2C_GetSpecialCmdOpCode(&op_code, OPENBL_EXTENDED_SPECIAL_CMD) == NACK_BYTE)
+/**
+  * @brief  This function is used to answer busy bytes to the host during the memory operations
+  *         of the non stretch commands.
+  * @param  State ENABLE to start sending busy bytes, DISABLE to stop.
+  * @retval None.
+  */
+static void OPENBL_I2C_SendNonStretchBusy(FunctionalState State)
+{
+  if (State == ENABLE)
   {
-    OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
+    OPENBL_I2C_CloseFrame();
+
+    /* Send Busy Byte */
+    OPENBL_Enable_BusyState_Sending();
   }
   else
   {
-    /* Send Operation code acknowledgment */
-    OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Wait for address to match */
-    OPENBL_I2C_WaitAddress();
-
-    /* Initialize the special command frame */
-    special_cmd->CmdType = OPENBL_EXTENDED_SPECIAL_CMD;
-    special_cmd->OpCode  = op_code;
-
-    /* Initialize the xor variable */
-    xor = 0U;
-
-    /* Get the number of bytes to be received */
-    /* Read the MSB of the size byte */
-    data                     = OPENBL_I2C_ReadByte();
-    special_cmd->SizeBuffer1 = ((uint16_t)data) << 8;
-    xor                     ^= data;
-
-    /* Read the LSB of the size byte */
-    data                      = OPENBL_I2C_ReadByte();
-    special_cmd->SizeBuffer1 |= (uint16_t)data;
-    xor                      ^= data;
-
-    if (special_cmd->SizeBuffer1 > SPECIAL_CMD_SIZE_BUFFER1)
-    {
-      OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      if (special_cmd->SizeBuffer1 != 0U)
-      {
-        /* Read received bytes */
-        for (index = 0U; index < special_cmd->SizeBuffer1; index++)
-        {
-          data                        = OPENBL_I2C_ReadByte();
-          special_cmd->Buffer1[index] = data;
-          xor                        ^= data;
-        }
-      }
-
-      /* Check data integrity */
-      if (OPENBL_I2C_ReadByte() != xor)
-      {
-        OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        /* Send receive size acknowledgment */
-        OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-        /* Wait for address to match */
-        OPENBL_I2C_WaitAddress();
-
-        /* Get the number of bytes to be written */
-        /* Read the MSB of the size byte */
-        xor                      = 0U;
-        data                     = OPENBL_I2C_ReadByte();
-        special_cmd->SizeBuffer2 = ((uint16_t)data) << 8;
-        xor                     ^= data;
-
-        /* Read the LSB of the size byte */
-        data                      = OPENBL_I2C_ReadByte();
-        special_cmd->SizeBuffer2 |= (uint16_t)data;
-        xor                      ^= data;
-
-        if (special_cmd->SizeBuffer2 > SPECIAL_CMD_SIZE_BUFFER2)
-        {
-          OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-        }
-        else
-        {
-          if (special_cmd->SizeBuffer2 != 0U)
-          {
-            /* Read received bytes */
-            for (index = 0U; index < special_cmd->SizeBuffer2; index++)
-            {
-              data                        = OPENBL_I2C_ReadByte();
-              special_cmd->Buffer2[index] = data;
-              xor                        ^= data;
-            }
-          }
-
-          /* Check data integrity */
-          if (OPENBL_I2C_ReadByte() != xor)
-          {
-            OPENBL_I2C_SendAcknowledgeByte(NACK_BYTE);
-          }
-          else
-          {
-            /* Send receive write size acknowledgment */
-            OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-            /* Wait for address to match */
-            OPENBL_I2C_WaitAddress();
-
-            /* Process the special command */
-            OPENBL_I2C_SpecialCommandProcess(special_cmd);
-
-            /* NOTE: In case of any operation inside "SpecialCommandProcess" function that prevents the code
-             * from returning to here (reset operation...), to be compatible with the OpenBL protocol,
-             * the user must ensure sending the last ACK in the application side.
-             */
-
-            /* Send acknowledgment */
-            OPENBL_I2C_SendAcknowledgeByte(ACK_BYTE);
-
-            /* Wait until NACK is detected */
-            OPENBL_I2C_WaitNack();
-
-            /* Wait until STOP is detected */
-            OPENBL_I2C_WaitStop();
-          }
-        }
-      }
-    }
+    /* Disable Busy Byte */
+    OPENBL_Disable_BusyState_Sending();
   }
 }
 
-/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  This function is used to process a special command, its answer is read by the host.
+  * @param  SpecialCmd Pointer to the OPENBL_SpecialCmdTypeDef structure.
+  * @retval None.
+  */
+static void OPENBL_I2C_ProcessSpecialCommand(OPENBL_SpecialCmdTypeDef *SpecialCmd)
+{
+  OPENBL_I2C_CloseFrame();
+
+  /* Wait for address to match */
+  OPENBL_I2C_WaitAddress();
+
+  OPENBL_I2C_SpecialCommandProcess(SpecialCmd);
+
+  /* Wait until NACK is detected */
+  OPENBL_I2C_WaitNack();
+
+  /* Wait until STOP is detected */
+  OPENBL_I2C_WaitStop();
+}
 
 /**
   * @brief  This function is used to construct the command List table.
@@ -1538,69 +643,35 @@ static uint8_t OPENBL_I2C_ConstructCommandsTable(OPENBL_CommandsTypeDef *pI2cCmd
     i++;
   }
 
-  return (i);
-}
-
-/**
-  * @brief  This function is used to get the operation code.
-  * @param  OpCode Pointer to the operation code to be returned.
-  * @param  CmdType Type of the command, Special write or extended special command.
-  * @retval Returns NACK status in case of error else returns ACK status.
-  */
-uint8_t OPENBL_I2C_GetSpecialCmdOpCode(uint16_t *OpCode, OPENBL_SpecialCmdTypeTypeDef CmdType)
-{
-  uint8_t op_code[2];
-  uint8_t xor;
-  uint8_t status;
-  uint8_t index;
-
-  /* Initialize the status variable */
-  status = NACK_BYTE;
+  if (pI2cCmd->GetStatistics != NULL)
+  {
+    a_OPENBL_I2C_CommandsList[i] = CMD_GET_STATISTICS;
+    i++;
+  }
 
-  /* Get the command OpCode (2 bytes) */
-  op_code[0] = OPENBL_I2C_ReadByte(); /* Read the MSB byte */
-  op_code[1] = OPENBL_I2C_ReadByte(); /* Read the LSB byte */
+  if ((pI2cCmd->CommitMemory != NULL) && (OPENBL_STAGING_ENABLE == 1U))
+  {
+    a_OPENBL_I2C_CommandsList[i] = CMD_COMMIT_MEMORY;
+    i++;
+  }
 
-  /* Get the checksum */
-  xor  = op_code[0];
-  xor ^= op_code[1];
+  if ((pI2cCmd->CompressedWriteMemory != NULL) && (OPENBL_COMPRESSED_WRITE_ENABLE == 1U))
+  {
+    a_OPENBL_I2C_CommandsList[i] = CMD_COMPRESSED_WRITE_MEMORY;
+    i++;
+  }
 
-  if (OPENBL_I2C_ReadByte() != xor)
+  if ((pI2cCmd->PatchMemory != NULL) && (OPENBL_PATCH_ENABLE == 1U))
   {
-    status = NACK_BYTE;
+    a_OPENBL_I2C_CommandsList[i] = CMD_PATCH_MEMORY;
+    i++;
   }
-  else
+
+  if ((pI2cCmd->GetBlockCrc != NULL) && (OPENBL_BLOCK_CRC_ENABLE == 1U))
   {
-    /* Get the operation code */
-    *OpCode = ((uint16_t)op_code[0] << 8) | (uint16_t)op_code[1];
-
-    if (CmdType == OPENBL_SPECIAL_CMD)
-    {
-      for (index = 0U; index < SPECIAL_CMD_MAX_NUMBER; index++)
-      {
-        if (SpecialCmdList[index] == *OpCode)
-        {
-          status = ACK_BYTE;
-          break;
-        }
-      }
-    }
-    else if (CmdType == OPENBL_EXTENDED_SPECIAL_CMD)
-    {
-      for (index = 0U; index < EXTENDED_SPECIAL_CMD_MAX_NUMBER; index++)
-      {
-        if (ExtendedSpecialCmdList[index] == *OpCode)
-        {
-          status = ACK_BYTE;
-          break;
-        }
-      }
-    }
-    else
-    {
-      status = NACK_BYTE;
-    }
+    a_OPENBL_I2C_CommandsList[i] = CMD_GET_BLOCK_CRC;
+    i++;
   }
 
-  return status;
+  return (i);
 }
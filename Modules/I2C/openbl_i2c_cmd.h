@@ -55,6 +55,11 @@ void OPENBL_I2C_NonStretchReadoutProtect(void);
 void OPENBL_I2C_NonStretchReadoutUnprotect(void);
 void OPENBL_I2C_SpecialCommand(void);
 void OPENBL_I2C_ExtendedSpecialCommand(void);
+void OPENBL_I2C_GetStatistics(void);
+void OPENBL_I2C_CommitMemory(void);
+void OPENBL_I2C_CompressedWriteMemory(void);
+void OPENBL_I2C_PatchMemory(void);
+void OPENBL_I2C_GetBlockCrc(void);
 
 #ifdef __cplusplus
 }
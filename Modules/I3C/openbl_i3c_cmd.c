@@ -19,6 +19,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "openbl_mem.h"
 #include "openbl_i3c_cmd.h"
+#include "openbl_engine.h"
 
 #include "openbootloader_conf.h"
 #include "app_openbootloader.h"
@@ -27,21 +28,40 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
-#define OPENBL_I3C_COMMANDS_NB_MAX        13U       /* The maximum number of supported commands */
+#define OPENBL_I3C_COMMANDS_NB_MAX        19U       /* The maximum number of supported commands */
 
 #define I3C_RAM_BUFFER_SIZE               2049U     /* Size of I3C buffer used to store received data from the host */
 
 /* Private macro -------------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t OPENBL_I3C_ConstructCommandsTable(OPENBL_CommandsTypeDef *pI3cCmd);
+static ErrorStatus OPENBL_I3C_ErasePages(uint8_t *pPages, uint32_t NumberOfPages);
+
 /* Private variables ---------------------------------------------------------*/
-/* Buffer used to store received data from the host */
-static uint8_t I3C_RAM_Buffer[I3C_RAM_BUFFER_SIZE];
-static uint8_t I3cCommandsNumber                                     = 0U;
+/* Block transport of the I3C interface, each phase of the protocol is one private write or read */
+static const OPENBL_ENGINE_TransportTypeDef I3cTransport =
+{
+  OPENBL_I3C_ReadBytes,
+  OPENBL_I3C_SendBytes,
+  OPENBL_I3C_SendAcknowledgeByte,
+  NULL,
+  OPENBL_I3C_SpecialCommandProcess,
+  NULL
+};
+
 static uint8_t a_OPENBL_I3C_CommandsList[OPENBL_I3C_COMMANDS_NB_MAX] = {0U};
 
-/* Private function prototypes -----------------------------------------------*/
-static uint8_t OPENBL_I3C_ConstructCommandsTable(OPENBL_CommandsTypeDef *pI3cCmd);
-static uint8_t OPENBL_I3C_GetAddress(uint32_t *pAddress);
-static uint8_t OPENBL_I3C_GetSpecialCmdOpCode(uint16_t *pOpCode, OPENBL_SpecialCmdTypeTypeDef CmdType);
+/* The I3C commands sharing the frames of the other protocols are run by the command engine */
+static OPENBL_ENGINE_HandleTypeDef I3cHandle =
+{
+  &I3cTransport,
+  NULL,
+  I3C_RAM_BUFFER_SIZE,
+  a_OPENBL_I3C_CommandsList,
+  0U,
+  OPENBL_I3C_VERSION,
+  0U
+};
 
 /* Exported variables --------------------------------------------------------*/
 /* Exported functions---------------------------------------------------------*/
@@ -73,9 +93,20 @@ OPENBL_CommandsTypeDef *OPENBL_I3C_GetCommandsList(void)
     NULL,
     NULL,
     OPENBL_I3C_SpecialCommand,
-    OPENBL_I3C_ExtendedSpecialCommand
+    OPENBL_I3C_ExtendedSpecialCommand,
+    NULL,
+    NULL,
+    OPENBL_I3C_GroupCommand,
+    OPENBL_I3C_GetStatistics,
+    OPENBL_I3C_CommitMemory,
+    OPENBL_I3C_CompressedWriteMemory,
+    OPENBL_I3C_PatchMemory,
+    OPENBL_I3C_GetBlockCrc
   };
 
+  /* The command buffer is taken from the arena shared by all the interfaces */
+  I3cHandle.pBuffer = OPENBL_GetBuffer(I3C_RAM_BUFFER_SIZE);
+
   OPENBL_I3C_SetCommandsList(&OPENBL_I3C_Commands);
 
   return (&OPENBL_I3C_Commands);
@@ -89,7 +120,7 @@ OPENBL_CommandsTypeDef *OPENBL_I3C_GetCommandsList(void)
 void OPENBL_I3C_SetCommandsList(OPENBL_CommandsTypeDef *pI3cCmd)
 {
   /* Get the list of commands supported & their numbers */
-  I3cCommandsNumber = OPENBL_I3C_ConstructCommandsTable(pI3cCmd);
+  I3cHandle.CommandsNumber = OPENBL_I3C_ConstructCommandsTable(pI3cCmd);
 }
 
 /**
@@ -102,12 +133,12 @@ void OPENBL_I3C_GetCommand(void)
   OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
 
   /* Send the number of commands supported by the I3C protocol */
-  OPENBL_I3C_SendByte(I3cCommandsNumber);
+  OPENBL_I3C_SendByte(I3cHandle.CommandsNumber);
 
   OPENBL_I3C_SendByte(OPENBL_I3C_VERSION);
 
   /* Send the list of supported commands */
-  OPENBL_I3C_SendBytes(a_OPENBL_I3C_CommandsList, I3cCommandsNumber);
+  OPENBL_I3C_SendBytes(a_OPENBL_I3C_CommandsList, I3cHandle.CommandsNumber);
 
   /* Send last Acknowledge synchronization byte */
   OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
@@ -119,13 +150,7 @@ void OPENBL_I3C_GetCommand(void)
   */
 void OPENBL_I3C_GetVersion(void)
 {
-  /* Send Acknowledge byte to notify the host that the command is recognized */
-  OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
-
-  OPENBL_I3C_SendByte(OPENBL_I3C_VERSION);
-
-  /* Send last Acknowledge synchronization byte */
-  OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
+  OPENBL_ENGINE_GetVersion(&I3cHandle);
 }
 
 /**
@@ -173,7 +198,7 @@ void OPENBL_I3C_ReadMemory(void)
     OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
 
     /* Get the memory address */
-    if (OPENBL_I3C_GetAddress(&address) == NACK_BYTE)
+    if (OPENBL_ENGINE_GetAddress(&I3cHandle, &address) == NACK_BYTE)
     {
       OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
     }
@@ -219,13 +244,13 @@ void OPENBL_I3C_ReadMemory(void)
           /* Read the data from the memory and send them to the host */
           for (index = 0U; index < size; index++)
           {
-            I3C_RAM_Buffer[index] = OPENBL_MEM_Read(address, memory_index);
+            I3cHandle.pBuffer[index] = OPENBL_MEM_Read(address, memory_index);
             address++;
           }
 
           OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
 
-          OPENBL_I3C_SendBytes(I3C_RAM_Buffer, size);
+          OPENBL_I3C_SendBytes(I3cHandle.pBuffer, size);
         }
       }
     }
@@ -248,20 +273,20 @@ void OPENBL_I3C_WriteMemory(void)
   /* Check memory protection then send adequate response */
   if (Common_GetProtectionStatus() != RESET)
   {
-    OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
+    OPENBL_ENGINE_SendStatus(&I3cHandle, NACK_BYTE);
   }
   else
   {
-    OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
+    OPENBL_ENGINE_SendStatus(&I3cHandle, ACK_BYTE);
 
     /* Get the memory address */
-    if (OPENBL_I3C_GetAddress(&address) == NACK_BYTE)
+    if (OPENBL_ENGINE_GetAddress(&I3cHandle, &address) == NACK_BYTE)
     {
-      OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
+      OPENBL_ENGINE_SendStatus(&I3cHandle, NACK_BYTE);
     }
     else
     {
-      OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
+      OPENBL_ENGINE_SendStatus(&I3cHandle, ACK_BYTE);
 
       while (loop != 0U)
       {
@@ -288,17 +313,17 @@ void OPENBL_I3C_WriteMemory(void)
             || (size > (I3C_RAM_BUFFER_SIZE - 1U))                           /* Size must not exceeds buffer size */
             || (size == 0U))                                                 /* Size must be different from 0 */
         {
-          OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
+          OPENBL_ENGINE_SendStatus(&I3cHandle, NACK_BYTE);
 
           /* End the loop */
           loop = 0U;
         }
         else
         {
-          OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
+          OPENBL_ENGINE_SendStatus(&I3cHandle, ACK_BYTE);
 
           /* Get the data and the xor byte (they are sent in the same I3C frame) */
-          OPENBL_I3C_ReadBytes(I3C_RAM_Buffer, size + 1U);
+          OPENBL_I3C_ReadBytes(I3cHandle.pBuffer, size + 1U);
 
           /* Initialize the XOR value */
           xor = 0U;
@@ -306,25 +331,27 @@ void OPENBL_I3C_WriteMemory(void)
           /* Compute the XOR for the received data */
           for (index = 0U; index < size; index ++)
           {
-            xor ^= I3C_RAM_Buffer[index];
+            xor ^= I3cHandle.pBuffer[index];
           }
 
           /* Check the data integrity.
              The last byte in the buffer is the received XOR value */
-          if (xor != I3C_RAM_Buffer[size])
+          if (xor != I3cHandle.pBuffer[size])
           {
-            OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
+            OPENBL_ENGINE_SendStatus(&I3cHandle, NACK_BYTE);
           }
           else
           {
             /* Write data to memory */
-            OPENBL_MEM_Write(address, I3C_RAM_Buffer, size);
+            OPENBL_MEM_Write(address, I3cHandle.pBuffer, size);
+
+            OPENBL_ENGINE_TrackWrite(address, size);
 
             /* Compute the new address value */
             address = address + size;
 
             /* Send last Acknowledge synchronization byte */
-            OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
+            OPENBL_ENGINE_SendStatus(&I3cHandle, ACK_BYTE);
 
             /* Start post processing task if needed */
             Common_StartPostProcessing();
@@ -341,41 +368,7 @@ void OPENBL_I3C_WriteMemory(void)
   */
 void OPENBL_I3C_Go(void)
 {
-  uint32_t address;
-  uint8_t status;
-
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Get memory address */
-    if (OPENBL_I3C_GetAddress(&address) == NACK_BYTE)
-    {
-      OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      /* Check if received address is valid or not */
-      status = OPENBL_MEM_CheckJumpAddress(address);
-
-      if (status == 0U)
-      {
-        OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        /* If the jump address is valid then send ACK */
-        OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
-
-        OPENBL_MEM_JumpToAddress(address);
-      }
-    }
-  }
+  OPENBL_ENGINE_Go(&I3cHandle);
 }
 
 /**
@@ -395,11 +388,11 @@ void OPENBL_I3C_EraseMemory(void)
   /* Check if the memory is not protected */
   if (Common_GetProtectionStatus() != RESET)
   {
-    OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
+    OPENBL_ENGINE_SendStatus(&I3cHandle, NACK_BYTE);
   }
   else
   {
-    OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
+    OPENBL_ENGINE_SendStatus(&I3cHandle, ACK_BYTE);
 
     /* Read number of pages to be erased (2 bytes) */
     data = OPENBL_I3C_ReadByte();
@@ -415,7 +408,7 @@ void OPENBL_I3C_EraseMemory(void)
       /* Check data integrity */
       if ((uint8_t) xor != OPENBL_I3C_ReadByte())
       {
-        OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
+        OPENBL_ENGINE_SendStatus(&I3cHandle, NACK_BYTE);
       }
       else
       {
@@ -425,24 +418,24 @@ void OPENBL_I3C_EraseMemory(void)
          */
         if ((data == 0xFFFFU) || (data == 0xFFFEU) || (data == 0xFFFDU))
         {
-          I3C_RAM_Buffer[0] = (uint8_t)(data & 0x00FFU);
-          I3C_RAM_Buffer[1] = (uint8_t)((data & 0xFF00U) >> 8U);
+          I3cHandle.pBuffer[0] = (uint8_t)(data & 0x00FFU);
+          I3cHandle.pBuffer[1] = (uint8_t)((data & 0xFF00U) >> 8U);
 
-          status = OPENBL_MEM_MassErase(OPENBL_DEFAULT_MEM, I3C_RAM_Buffer, I3C_RAM_BUFFER_SIZE);
+          status = OPENBL_MEM_MassErase(OPENBL_DEFAULT_MEM, I3cHandle.pBuffer, I3C_RAM_BUFFER_SIZE);
 
           if (status == SUCCESS)
           {
-            OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
+            OPENBL_ENGINE_SendStatus(&I3cHandle, ACK_BYTE);
           }
           else
           {
-            OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
+            OPENBL_ENGINE_SendStatus(&I3cHandle, NACK_BYTE);
           }
         }
         else
         {
           /* This sub-command is not supported */
-          OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
+          OPENBL_ENGINE_SendStatus(&I3cHandle, NACK_BYTE);
         }
       }
     }
@@ -451,7 +444,7 @@ void OPENBL_I3C_EraseMemory(void)
       /* Check data integrity */
       if (OPENBL_I3C_ReadByte() != (uint8_t) xor)
       {
-        OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
+        OPENBL_ENGINE_SendStatus(&I3cHandle, NACK_BYTE);
       }
       else
       {
@@ -462,16 +455,16 @@ void OPENBL_I3C_EraseMemory(void)
            It must not exceeds the half buffer size as each page is coded on two bytes */
         if ((numpage != 0U) && (numpage < (I3C_RAM_BUFFER_SIZE / 2U)))
         {
-          OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
+          OPENBL_ENGINE_SendStatus(&I3cHandle, ACK_BYTE);
 
           /* Compute the number of bytes: number of pages * 2 (each page is coded in two bytes) + 1 byte for XOR */
           number_of_bytes = (2U * numpage) + 1U;
 
-          I3C_RAM_Buffer[0] = (uint8_t)(numpage & 0x00FFU);
-          I3C_RAM_Buffer[1] = (uint8_t)((numpage & 0xFF00U) >> 8U);
+          I3cHandle.pBuffer[0] = (uint8_t)(numpage & 0x00FFU);
+          I3cHandle.pBuffer[1] = (uint8_t)((numpage & 0xFF00U) >> 8U);
 
           /* Get the pages to be erased and their XOR */
-          OPENBL_I3C_ReadBytes(&I3C_RAM_Buffer[2], number_of_bytes);
+          OPENBL_I3C_ReadBytes(&I3cHandle.pBuffer[2], number_of_bytes);
 
           /* Initialize the XOR value */
           xor = 0U;
@@ -479,43 +472,43 @@ void OPENBL_I3C_EraseMemory(void)
           /* Compute the xor for the received data */
           for (index = 2U; index <= number_of_bytes ; index++)
           {
-            xor ^= I3C_RAM_Buffer[index];
+            xor ^= I3cHandle.pBuffer[index];
           }
 
           /* Check data integrity:
-             The pages bytes are stored starting from the 2nd index of the I3C_RAM_Buffer.
+             The pages bytes are stored starting from the 2nd index of the I3cHandle.pBuffer.
              The xor byte index is at "number_of_bytes + 1" */
-          if ((uint8_t) xor != I3C_RAM_Buffer[number_of_bytes + 1U])
+          if ((uint8_t) xor != I3cHandle.pBuffer[number_of_bytes + 1U])
           {
-            OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
+            OPENBL_ENGINE_SendStatus(&I3cHandle, NACK_BYTE);
           }
           else
           {
             /* Invert bytes as they were received MSB first */
             for (index = 2U; index <= number_of_bytes; index += 2U)
             {
-              temp_data                  = I3C_RAM_Buffer[index];
-              I3C_RAM_Buffer[index]      = I3C_RAM_Buffer[index + 1U];
-              I3C_RAM_Buffer[index + 1U] = temp_data;
+              temp_data                  = I3cHandle.pBuffer[index];
+              I3cHandle.pBuffer[index]      = I3cHandle.pBuffer[index + 1U];
+              I3cHandle.pBuffer[index + 1U] = temp_data;
             }
 
-            status = OPENBL_MEM_Erase(OPENBL_DEFAULT_MEM, I3C_RAM_Buffer, I3C_RAM_BUFFER_SIZE);
+            status = OPENBL_I3C_ErasePages(&I3cHandle.pBuffer[2], numpage);
 
             /* Errors from memory erase are not managed, always return ACK */
             if (status == SUCCESS)
             {
-              OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
+              OPENBL_ENGINE_SendStatus(&I3cHandle, ACK_BYTE);
             }
             else
             {
-              OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
+              OPENBL_ENGINE_SendStatus(&I3cHandle, NACK_BYTE);
             }
           }
         }
         else
         {
           /* The number of pages to be erased is not valid */
-          OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
+          OPENBL_ENGINE_SendStatus(&I3cHandle, NACK_BYTE);
         }
       }
     }
@@ -574,7 +567,7 @@ void OPENBL_I3C_WriteProtect(void)
       else
       {
         /* Receive data and the XOR byte */
-        OPENBL_I3C_ReadBytes(I3C_RAM_Buffer, number_of_bytes + 1U);
+        OPENBL_I3C_ReadBytes(I3cHandle.pBuffer, number_of_bytes + 1U);
 
         /* Initialize the XOR value */
         xor = 0U;
@@ -582,18 +575,18 @@ void OPENBL_I3C_WriteProtect(void)
         /* Compute the XOR value for the received data */
         for (index = 0U; index < number_of_bytes ; index++)
         {
-          xor ^= I3C_RAM_Buffer[index];
+          xor ^= I3cHandle.pBuffer[index];
         }
 
         /* Check data integrity and send NACK if the XOR is incorrect */
-        if (I3C_RAM_Buffer[number_of_bytes] != (uint8_t) xor)
+        if (I3cHandle.pBuffer[number_of_bytes] != (uint8_t) xor)
         {
           OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
         }
         else
         {
           /* Enable write protection */
-          status = OPENBL_MEM_SetWriteProtection(ENABLE, OPENBL_DEFAULT_MEM, I3C_RAM_Buffer, numpage);
+          status = OPENBL_MEM_SetWriteProtection(ENABLE, OPENBL_DEFAULT_MEM, I3cHandle.pBuffer, numpage);
 
           OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
 
@@ -614,28 +607,7 @@ void OPENBL_I3C_WriteProtect(void)
   */
 void OPENBL_I3C_WriteUnprotect(void)
 {
-  ErrorStatus status;
-
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Disable write protection */
-    status = OPENBL_MEM_SetWriteProtection(DISABLE, OPENBL_DEFAULT_MEM, NULL, 0U);
-
-    OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
-
-    if (status == SUCCESS)
-    {
-      /* Start post processing task if needed */
-      Common_StartPostProcessing();
-    }
-  }
+  OPENBL_ENGINE_WriteUnprotect(&I3cHandle);
 }
 
 /**
@@ -644,90 +616,7 @@ void OPENBL_I3C_WriteUnprotect(void)
   */
 void OPENBL_I3C_SpecialCommand(void)
 {
-  uint32_t number_of_bytes;
-  OPENBL_SpecialCmdTypeDef *p_special_cmd;
-  uint16_t op_code;
-  uint8_t xor;
-  uint8_t index;
-  uint8_t temp_buffer[2];
-
-  /* Send acknowledgment */
-  OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
-
-  /* Get the special command operation code */
-  if (OPENBL_I3C_GetSpecialCmdOpCode(&op_code, OPENBL_SPECIAL_CMD) == NACK_BYTE)
-  {
-    OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    /* Send Operation code acknowledgment */
-    OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Get the number of bytes to be received */
-    OPENBL_I3C_ReadBytes(temp_buffer, 2U);
-
-    /* Initialize the special command pointer */
-    p_special_cmd = (OPENBL_SpecialCmdTypeDef *)(uint32_t) I3C_RAM_Buffer;
-
-    /* Initialize the special command structure */
-    p_special_cmd->CmdType = OPENBL_SPECIAL_CMD;
-    p_special_cmd->OpCode  = op_code;
-
-    /* Initialize the XOR value */
-    xor = 0U;
-
-    p_special_cmd->SizeBuffer1  = ((uint16_t)temp_buffer[0]) << 8U;
-    xor                        ^= temp_buffer[0];
-
-    p_special_cmd->SizeBuffer1 |= (uint16_t)temp_buffer[1];
-    xor                        ^= temp_buffer[1];
-
-    /* Check that the received buffer size doesn't exceeds the max buffer size */
-    if ((p_special_cmd->SizeBuffer1) > SPECIAL_CMD_SIZE_BUFFER1)
-    {
-      OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      number_of_bytes = (uint32_t)p_special_cmd->SizeBuffer1;
-
-      /* The buffer can be empty, so only receive data if number of bytes is different of 0 */
-      if (number_of_bytes != 0U)
-      {
-        /* Get received bytes and their XOR byte */
-        OPENBL_I3C_ReadBytes(p_special_cmd->Buffer1, number_of_bytes + 1U);
-
-        /* Compute the XOR for the received bytes */
-        for (index = 0U; index < number_of_bytes; index++)
-        {
-          xor ^= p_special_cmd->Buffer1[index];
-        }
-      }
-
-      /* Check data integrity */
-      if (xor != p_special_cmd->Buffer1[number_of_bytes])
-      {
-        OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        /* Send received size acknowledgment */
-        OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
-
-        /* Process the special command */
-        OPENBL_I3C_SpecialCommandProcess(p_special_cmd);
-
-        /* NOTE: In case of any operation inside "SpecialCommandProcess" function that prevents the code
-         * from returning to here (reset operation...), to be compatible with the OpenBL protocol,
-         * the user must ensure sending the last ACK in the application side.
-         */
-
-        /* Send last acknowledgment */
-        OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
-      }
-    }
-  }
+  OPENBL_ENGINE_SpecialCommand(&I3cHandle);
 }
 
 /**
@@ -736,138 +625,66 @@ void OPENBL_I3C_SpecialCommand(void)
   */
 void OPENBL_I3C_ExtendedSpecialCommand(void)
 {
-  uint32_t number_of_bytes;
-  OPENBL_SpecialCmdTypeDef *p_special_cmd;
-  uint16_t op_code;
-  uint16_t index;
-  uint8_t temp_buffer[2];
-  uint8_t xor;
-
-  /* Send Operation code acknowledgment */
-  OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
-
-  /* Get the command operation code */
-  if (OPENBL_I3C_GetSpecialCmdOpCode(&op_code, OPENBL_EXTENDED_SPECIAL_CMD) == NACK_BYTE)
-  {
-    OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    /* Send Operation code acknowledgment */
-    OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Get the number of bytes to be received */
-    OPENBL_I3C_ReadBytes(temp_buffer, 2U);
-
-    /* Initialize the special command pointer */
-    p_special_cmd = (OPENBL_SpecialCmdTypeDef *)(uint32_t) I3C_RAM_Buffer;
-
-    /* Initialize the special command structure */
-    p_special_cmd->CmdType = OPENBL_EXTENDED_SPECIAL_CMD;
-    p_special_cmd->OpCode  = op_code;
-
-    /* Initialize the XOR value */
-    xor = 0U;
-
-    p_special_cmd->SizeBuffer1  = ((uint16_t)temp_buffer[0]) << 8U;
-    xor                        ^= temp_buffer[0];
-
-    p_special_cmd->SizeBuffer1 |= (uint16_t)temp_buffer[1];
-    xor                        ^= temp_buffer[1];
-
-    /* Check that the received buffer size doesn't exceeds the max buffer size */
-    if ((p_special_cmd->SizeBuffer1) > SPECIAL_CMD_SIZE_BUFFER1)
-    {
-      OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      number_of_bytes = (uint32_t)p_special_cmd->SizeBuffer1;
-
-      /* The buffer can be empty, so only receive data if the buffer size is different of 0 */
-      if (number_of_bytes != 0U)
-      {
-        /* Get received bytes and their XOR */
-        OPENBL_I3C_ReadBytes(p_special_cmd->Buffer1, number_of_bytes + 1U);
-
-        /* Compute the XOR for the received bytes */
-        for (index = 0U; index < number_of_bytes; index++)
-        {
-          xor ^= p_special_cmd->Buffer1[index];
-        }
-      }
-
-      /* Check data integrity */
-      if (xor != p_special_cmd->Buffer1[number_of_bytes])
-      {
-        OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        /* Send receive size acknowledgment */
-        OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
-
-        /* Get size of buffer 2 */
-        OPENBL_I3C_ReadBytes(temp_buffer, 2U);
-
-        /* Initialize the XOR value */
-        xor = 0U;
-
-        /* Read the MSB of the size byte */
-        p_special_cmd->SizeBuffer2 = ((uint16_t)temp_buffer[0]) << 8U;
-        xor                       ^= temp_buffer[0];
-
-        /* Read the LSB of the size byte */
-        p_special_cmd->SizeBuffer2 |= (uint16_t)temp_buffer[1];
-        xor                        ^= temp_buffer[1];
-
-        /* Check that the received buffer size doesn't exceeds the max buffer size */
-        if ((p_special_cmd->SizeBuffer2) > SPECIAL_CMD_SIZE_BUFFER2)
-        {
-          OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
-        }
-        else
-        {
-          number_of_bytes = (uint32_t)(p_special_cmd->SizeBuffer2);
+  OPENBL_ENGINE_ExtendedSpecialCommand(&I3cHandle);
+}
 
-          /* The buffer can be empty, so only receive data if the buffer size is different of 0 */
-          if (number_of_bytes != 0U)
-          {
-            /* Get received bytes and their XOR */
-            OPENBL_I3C_ReadBytes(p_special_cmd->Buffer2, number_of_bytes + 1U);
+/**
+  * @brief  This function is used to manage the group programming of several targets sharing the same bus,
+  *         see OPENBL_ENGINE_GroupCommand. The controller gives the members the same dynamic address
+  *         (SETNEWDA) to broadcast the write and erase commands once, then gives them back unique addresses
+  *         (RSTDAA then ENTDAA) before reading their status.
+  * @retval None.
+  */
+void OPENBL_I3C_GroupCommand(void)
+{
+  OPENBL_ENGINE_GroupCommand(&I3cHandle);
+}
 
-            /* Compute the XOR for the received bytes */
-            for (index = 0U; index < number_of_bytes; index++)
-            {
-              xor ^= p_special_cmd->Buffer2[index];
-            }
-          }
+/**
+  * @brief  This function is used to send the statistics recorded by the Open Bootloader.
+  * @retval None.
+  */
+void OPENBL_I3C_GetStatistics(void)
+{
+  OPENBL_ENGINE_GetStatistics(&I3cHandle);
+}
 
-          /* Check data integrity */
-          if (xor != p_special_cmd->Buffer2[number_of_bytes])
-          {
-            OPENBL_I3C_SendAcknowledgeByte(NACK_BYTE);
-          }
-          else
-          {
-            /* Send receive write size acknowledgment */
-            OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
+/**
+  * @brief  This function is used to program in the Flash an image staged in RAM, see OPENBL_MEM_Commit.
+  * @retval None.
+  */
+void OPENBL_I3C_CommitMemory(void)
+{
+  OPENBL_ENGINE_CommitMemory(&I3cHandle);
+}
 
-            /* Process the special command */
-            OPENBL_I3C_SpecialCommandProcess(p_special_cmd);
+/**
+  * @brief  This function is used to write in to device memory data compressed in the LZ4 block format,
+  *         see OPENBL_MEM_WriteCompressed.
+  * @retval None.
+  */
+void OPENBL_I3C_CompressedWriteMemory(void)
+{
+  OPENBL_ENGINE_CompressedWriteMemory(&I3cHandle);
+}
 
-            /* NOTE: In case of any operation inside "SpecialCommandProcess" function that prevents the code
-             * from returning to here (reset operation...), to be compatible with the OpenBL protocol,
-             * the user must ensure sending the last ACK in the application side.
-             */
+/**
+  * @brief  This function is used to write in to device memory a new image built by a delta patch
+  *         from the old one, see OPENBL_MEM_WritePatch.
+  * @retval None.
+  */
+void OPENBL_I3C_PatchMemory(void)
+{
+  OPENBL_ENGINE_PatchMemory(&I3cHandle);
+}
 
-            /* Send last acknowledgment */
-            OPENBL_I3C_SendAcknowledgeByte(ACK_BYTE);
-          }
-        }
-      }
-    }
-  }
+/**
+  * @brief  This function is used to send the CRC-32 of consecutive memory blocks, see OPENBL_MEM_GetBlockCrc.
+  * @retval None.
+  */
+void OPENBL_I3C_GetBlockCrc(void)
+{
+  OPENBL_ENGINE_GetBlockCrc(&I3cHandle);
 }
 
 /* Private functions ---------------------------------------------------------*/
@@ -959,111 +776,77 @@ static uint8_t OPENBL_I3C_ConstructCommandsTable(OPENBL_CommandsTypeDef *pI3cCmd
     index++;
   }
 
-  return (index);
-}
-
-/**
-  * @brief  This function is used to get a valid address.
-  * @param  pAddress pointer to the address.
-  * @retval Returns NACK status in case of error else returns ACK status.
-  */
-static uint8_t OPENBL_I3C_GetAddress(uint32_t *pAddress)
-{
-  uint8_t data[5] = {0U};
-  uint8_t status;
-  uint8_t xor;
+  if (pI3cCmd->GroupCommand != NULL)
+  {
+    a_OPENBL_I3C_CommandsList[index] = CMD_GROUP_COMMAND;
+    index++;
+  }
 
-  /* Get the address (4 bytes) and its XOR value (1 byte) */
-  OPENBL_I3C_ReadBytes(data, 5U);
+  if (pI3cCmd->GetStatistics != NULL)
+  {
+    a_OPENBL_I3C_CommandsList[index] = CMD_GET_STATISTICS;
+    index++;
+  }
 
-  xor = data[0] ^ data[1] ^ data[2] ^ data[3];
+  if ((pI3cCmd->CommitMemory != NULL) && (OPENBL_STAGING_ENABLE == 1U))
+  {
+    a_OPENBL_I3C_CommandsList[index] = CMD_COMMIT_MEMORY;
+    index++;
+  }
 
-  /* Check the integrity of received data */
-  if (xor != data[4])
+  if ((pI3cCmd->CompressedWriteMemory != NULL) && (OPENBL_COMPRESSED_WRITE_ENABLE == 1U))
   {
-    status = NACK_BYTE;
+    a_OPENBL_I3C_CommandsList[index] = CMD_COMPRESSED_WRITE_MEMORY;
+    index++;
   }
-  else
+
+  if ((pI3cCmd->PatchMemory != NULL) && (OPENBL_PATCH_ENABLE == 1U))
   {
-    *pAddress = ((uint32_t)data[0] << 24U)
-                | ((uint32_t)data[1] << 16U)
-                | ((uint32_t)data[2] << 8U)
-                | (uint32_t)data[3];
+    a_OPENBL_I3C_CommandsList[index] = CMD_PATCH_MEMORY;
+    index++;
+  }
 
-    /* Check if received address is valid or not */
-    if (OPENBL_MEM_GetAddressArea(*pAddress) == AREA_ERROR)
-    {
-      status = NACK_BYTE;
-    }
-    else
-    {
-      status = ACK_BYTE;
-    }
+  if ((pI3cCmd->GetBlockCrc != NULL) && (OPENBL_BLOCK_CRC_ENABLE == 1U))
+  {
+    a_OPENBL_I3C_CommandsList[index] = CMD_GET_BLOCK_CRC;
+    index++;
   }
 
-  return status;
+  return (index);
 }
 
 /**
-  * @brief  This function is used to get the operation code.
-  * @param  pOpCode Pointer to the operation code to be returned.
-  * @param  CmdType Type of the command, special command or extended special command.
-  * @retval Returns NACK status in case of error else returns ACK status.
+  * @brief  This function is used to erase a list of pages one page at a time.
+  *         A progress notification is sent to the controller after each page but the last one,
+  *         the caller signals the completion with the ACK/NACK IBI.
+  * @param  pPages The list of pages to be erased, each page number is coded on two bytes LSB first.
+  * @param  NumberOfPages The number of pages in the list.
+  * @retval Returns ERROR if the erase of at least one page failed else returns SUCCESS.
   */
-static uint8_t OPENBL_I3C_GetSpecialCmdOpCode(uint16_t *pOpCode, OPENBL_SpecialCmdTypeTypeDef CmdType)
+static ErrorStatus OPENBL_I3C_ErasePages(uint8_t *pPages, uint32_t NumberOfPages)
 {
-  uint8_t data[3];
-  uint8_t xor;
-  uint8_t status;
-  uint8_t index;
-
-  /* Initialize the status variable */
-  status = NACK_BYTE;
-
-  /* Get the command OpCode and its XOR */
-  OPENBL_I3C_ReadBytes(data, 3U);
+  uint32_t index;
+  uint8_t page[4];
+  ErrorStatus status = SUCCESS;
 
-  /* Get the XOR byte */
-  xor  = data[0];
-  xor ^= data[1];
+  /* Erase buffer of a single page: number of pages then page number, both LSB first */
+  page[0] = 0x01U;
+  page[1] = 0x00U;
 
-  /* Check the integrity of received data */
-  if (xor != data[2])
-  {
-    status = NACK_BYTE;
-  }
-  else
+  for (index = 0U; index < NumberOfPages; index++)
   {
-    /* Get the operation code */
-    *pOpCode = ((uint16_t)data[0] << 8U) | (uint16_t)data[1];
+    page[2] = pPages[2U * index];
+    page[3] = pPages[(2U * index) + 1U];
 
-    if (CmdType == OPENBL_SPECIAL_CMD)
-    {
-      /* Check if the operation code exists in special command list */
-      for (index = 0U; index < SPECIAL_CMD_MAX_NUMBER; index++)
-      {
-        if (SpecialCmdList[index] == *pOpCode)
-        {
-          status = ACK_BYTE;
-          break;
-        }
-      }
-    }
-    else if (CmdType == OPENBL_EXTENDED_SPECIAL_CMD)
+    if (OPENBL_MEM_Erase(OPENBL_DEFAULT_MEM, page, sizeof(page)) != SUCCESS)
     {
-      /* Check if the operation code exists in extended special command list */
-      for (index = 0U; index < EXTENDED_SPECIAL_CMD_MAX_NUMBER; index++)
-      {
-        if (ExtendedSpecialCmdList[index] == *pOpCode)
-        {
-          status = ACK_BYTE;
-          break;
-        }
-      }
+      status = ERROR;
     }
-    else
+
+    /* No progress is signaled in group mode, all the targets share the same address */
+    if (((index + 1U) < NumberOfPages) && (OPENBL_ENGINE_GetGroupId() == 0U))
     {
-      status = NACK_BYTE;
+      OPENBL_I3C_SendProgress();
     }
   }
 
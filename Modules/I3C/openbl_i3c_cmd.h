@@ -47,6 +47,12 @@ void OPENBL_I3C_WriteProtect(void);
 void OPENBL_I3C_WriteUnprotect(void);
 void OPENBL_I3C_SpecialCommand(void);
 void OPENBL_I3C_ExtendedSpecialCommand(void);
+void OPENBL_I3C_GroupCommand(void);
+void OPENBL_I3C_GetStatistics(void);
+void OPENBL_I3C_CommitMemory(void);
+void OPENBL_I3C_CompressedWriteMemory(void);
+void OPENBL_I3C_PatchMemory(void);
+void OPENBL_I3C_GetBlockCrc(void);
 
 #ifdef __cplusplus
 }
@@ -19,17 +19,46 @@
 /* Includes ------------------------------------------------------------------*/
 #include "openbl_mem.h"
 #include "openbl_core.h"
+#include "openbl_perf.h"
 
 #include "interfaces_conf.h"
+#include "common_interface.h"
 
 /* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint8_t *pBuffer;                 /* Decompressed data not written yet */
+  uint32_t BufferSize;              /* Number of bytes written to memory at once */
+  uint32_t Address;                 /* Address of the first byte of the buffer */
+  uint32_t Count;                   /* Number of bytes in the buffer */
+} OPENBL_MEM_OutputTypeDef;
+
 /* Private define ------------------------------------------------------------*/
+#define OPENBL_MEM_COMMIT_BLOCK_SIZE      1024U        /* Bytes copied from the staging area per Flash write */
+#define OPENBL_MEM_OUTPUT_BLOCK_SIZE      256U         /* Decompressed bytes are written by multiples of this size */
+#define OPENBL_MEM_LZ4_MIN_MATCH          4U           /* Length of a match of token 0 */
+#define OPENBL_MEM_LZ4_LENGTH_MASK        0x0FU        /* Length field of the token, 15 when extra bytes follow */
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 static uint32_t NumberOfMemories = 0U;
 static OPENBL_MemoryTypeDef a_MemoriesTable[MEMORIES_SUPPORTED];
 
+/* Reflected CRC-32 (IEEE 802.3) of each half byte */
+static const uint32_t a_MemCrc32Table[16] =
+{
+  0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU, 0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+  0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU, 0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
 /* Private function prototypes -----------------------------------------------*/
+static ErrorStatus OPENBL_MEM_Decode(uint32_t Address, uint8_t *pData, uint32_t Length, uint8_t *pBuffer,
+                                     uint32_t BufferSize, uint32_t *pSource, uint32_t *pSize);
+static ErrorStatus OPENBL_MEM_GetLz4Length(uint8_t *pData, uint32_t Length, uint32_t *pIndex, uint32_t *pValue);
+static ErrorStatus OPENBL_MEM_OutputByte(OPENBL_MEM_OutputTypeDef *pOutput, uint8_t Data);
+static ErrorStatus OPENBL_MEM_OutputFlush(OPENBL_MEM_OutputTypeDef *pOutput);
+static uint32_t OPENBL_MEM_UpdateCrc32(uint32_t Crc, uint8_t Data);
+static uint32_t OPENBL_MEM_GetApplicationCrc32(uint32_t Address, uint32_t Length);
+
 /* Exported variables --------------------------------------------------------*/
 /* Exported functions --------------------------------------------------------*/
 
@@ -55,6 +84,8 @@ ErrorStatus OPENBL_MEM_RegisterMemory(OPENBL_MemoryTypeDef *Memory)
     a_MemoriesTable[NumberOfMemories].JumpToAddress     = Memory->JumpToAddress;
     a_MemoriesTable[NumberOfMemories].MassErase         = Memory->MassErase;
     a_MemoriesTable[NumberOfMemories].Erase             = Memory->Erase;
+    a_MemoriesTable[NumberOfMemories].PageSize          = Memory->PageSize;
+    a_MemoriesTable[NumberOfMemories].BankSize          = Memory->BankSize;
 
     NumberOfMemories++;
   }
@@ -129,6 +160,11 @@ uint8_t OPENBL_MEM_Read(uint32_t Address, uint32_t MemoryIndex)
     if (a_MemoriesTable[MemoryIndex].Read != NULL)
     {
       value = a_MemoriesTable[MemoryIndex].Read(Address);
+
+      if (OPENBL_PERF_ENABLE == 1U)
+      {
+        OPENBL_PERF_AddBytesRead(1U);
+      }
     }
     else
     {
@@ -161,7 +197,18 @@ void OPENBL_MEM_Write(uint32_t Address, uint8_t *Data, uint32_t DataLength)
   {
     if (a_MemoriesTable[index].Write != NULL)
     {
+      if (OPENBL_PERF_ENABLE == 1U)
+      {
+        OPENBL_PERF_MemoryStart();
+      }
+
       a_MemoriesTable[index].Write(Address, Data, DataLength);
+
+      if (OPENBL_PERF_ENABLE == 1U)
+      {
+        OPENBL_PERF_MemoryEnd();
+        OPENBL_PERF_AddBytesWritten(DataLength);
+      }
     }
   }
 }
@@ -276,7 +323,17 @@ ErrorStatus OPENBL_MEM_MassErase(uint32_t Address, uint8_t *p_Data, uint32_t Dat
   {
     if (a_MemoriesTable[memory_index].MassErase != NULL)
     {
+      if (OPENBL_PERF_ENABLE == 1U)
+      {
+        OPENBL_PERF_MemoryStart();
+      }
+
       status = a_MemoriesTable[memory_index].MassErase(p_Data, DataLength);
+
+      if (OPENBL_PERF_ENABLE == 1U)
+      {
+        OPENBL_PERF_MemoryEnd();
+      }
     }
     else
     {
@@ -312,7 +369,17 @@ ErrorStatus OPENBL_MEM_Erase(uint32_t Address, uint8_t *p_Data, uint32_t DataLen
   {
     if (a_MemoriesTable[memory_index].Erase != NULL)
     {
+      if (OPENBL_PERF_ENABLE == 1U)
+      {
+        OPENBL_PERF_MemoryStart();
+      }
+
       status = a_MemoriesTable[memory_index].Erase(p_Data, DataLength);
+
+      if (OPENBL_PERF_ENABLE == 1U)
+      {
+        OPENBL_PERF_MemoryEnd();
+      }
     }
     else
     {
@@ -351,3 +418,620 @@ uint8_t OPENBL_MEM_CheckJumpAddress(uint32_t Address)
 
   return status;
 }
+
+/**
+  * @brief  This function returns the page, in the erase numbering of its memory, that contains the given address.
+  * @param  Address The address to be checked.
+  * @retval The page number, 0 if the address is not valid or the memory has no page geometry.
+  */
+uint32_t OPENBL_MEM_GetPage(uint32_t Address)
+{
+  uint32_t memory_index;
+  uint32_t page = 0U;
+
+  /* Get the memory index to know from which memory interface we will used */
+  memory_index = OPENBL_MEM_GetMemoryIndex(Address);
+
+  if ((memory_index < NumberOfMemories) && (a_MemoriesTable[memory_index].PageSize != 0U))
+  {
+    page = (Address - a_MemoriesTable[memory_index].StartAddress) / a_MemoriesTable[memory_index].PageSize;
+  }
+
+  return page;
+}
+
+/**
+  * @brief  This function returns the erase page size of the memory that contains the given address.
+  * @param  Address The address to be checked.
+  * @retval The page size in bytes, 0 if the address is not valid or the memory cannot be erased by page.
+  */
+uint32_t OPENBL_MEM_GetPageSize(uint32_t Address)
+{
+  uint32_t memory_index;
+  uint32_t page_size = 0U;
+
+  /* Get the memory index to know from which memory interface we will used */
+  memory_index = OPENBL_MEM_GetMemoryIndex(Address);
+
+  if (memory_index < NumberOfMemories)
+  {
+    page_size = a_MemoriesTable[memory_index].PageSize;
+  }
+
+  return page_size;
+}
+
+/**
+  * @brief  This function returns the bank size of the memory that contains the given address.
+  * @param  Address The address to be checked.
+  * @retval The bank size in bytes, 0 if the address is not valid or the memory cannot be erased by bank.
+  */
+uint32_t OPENBL_MEM_GetBankSize(uint32_t Address)
+{
+  uint32_t memory_index;
+  uint32_t bank_size = 0U;
+
+  /* Get the memory index to know from which memory interface we will used */
+  memory_index = OPENBL_MEM_GetMemoryIndex(Address);
+
+  if (memory_index < NumberOfMemories)
+  {
+    bank_size = a_MemoriesTable[memory_index].BankSize;
+  }
+
+  return bank_size;
+}
+
+/**
+  * @brief  Compute the CRC-32 (IEEE 802.3) of a memory region, as read back from the memory.
+  *         The CRC of consecutive regions can be chained by passing the CRC of the previous ones.
+  *         When OPENBL_HW_CRC_ENABLE is set, the Flash and RAM regions are read directly by the CRC unit,
+  *         see Common_ComputeCrc32.
+  * @param  Crc The CRC of the previous regions, 0 for the first one.
+  * @param  Address The start address of the memory region.
+  * @param  Length The number of bytes of the region.
+  * @retval The updated CRC.
+  */
+uint32_t OPENBL_MEM_ComputeCrc32(uint32_t Crc, uint32_t Address, uint32_t Length)
+{
+  uint32_t memory_index;
+  uint32_t counter;
+  uint32_t area;
+  uint32_t crc;
+
+  area = OPENBL_MEM_GetAddressArea(Address);
+
+  if ((OPENBL_HW_CRC_ENABLE == 1U) && ((area == FLASH_AREA) || (area == RAM_AREA)))
+  {
+    crc = Common_ComputeCrc32(Crc, Address, Length);
+
+    if (OPENBL_PERF_ENABLE == 1U)
+    {
+      OPENBL_PERF_AddBytesRead(Length);
+    }
+  }
+  else
+  {
+    crc = ~Crc;
+
+    /* Get the memory index to know from which memory we will read */
+    memory_index = OPENBL_MEM_GetMemoryIndex(Address);
+
+    for (counter = 0U; counter < Length; counter++)
+    {
+      crc = OPENBL_MEM_UpdateCrc32(crc, OPENBL_MEM_Read(Address + counter, memory_index));
+    }
+
+    crc = ~crc;
+  }
+
+  return crc;
+}
+
+/**
+  * @brief  Compute the CRC-32 of consecutive blocks of a memory, see the Get Block CRC command.
+  *         The host compares them with the blocks of its new image to only write the blocks which differ.
+  * @param  Address The start address of the first block.
+  * @param  BlockSize The number of bytes of each block.
+  * @param  BlocksNumber The number of blocks.
+  * @param  pBuffer Pointer to the buffer receiving the CRCs, 4 bytes per block, each MSB first.
+  * @retval An ErrorStatus enumeration value:
+  *          - SUCCESS: The CRCs are computed
+  *          - ERROR:   One parameter is invalid or the blocks are not all in the same memory
+  */
+ErrorStatus OPENBL_MEM_GetBlockCrc(uint32_t Address, uint32_t BlockSize, uint32_t BlocksNumber, uint8_t *pBuffer)
+{
+  ErrorStatus status = ERROR;
+  uint32_t memory_index;
+  uint32_t address;
+  uint32_t counter;
+  uint32_t crc;
+
+  memory_index = OPENBL_MEM_GetMemoryIndex(Address);
+
+  /* All the blocks must be read from the memory of the first one */
+  if ((BlockSize != 0U) && (BlocksNumber != 0U) && (memory_index < NumberOfMemories)
+      && (BlockSize <= ((a_MemoriesTable[memory_index].EndAddress - Address) / BlocksNumber)))
+  {
+    address = Address;
+
+    for (counter = 0U; counter < BlocksNumber; counter++)
+    {
+      crc     = OPENBL_MEM_ComputeCrc32(0U, address, BlockSize);
+      address += BlockSize;
+
+      pBuffer[(counter * 4U)]      = (uint8_t)(crc >> 24U);
+      pBuffer[(counter * 4U) + 1U] = (uint8_t)(crc >> 16U);
+      pBuffer[(counter * 4U) + 2U] = (uint8_t)(crc >> 8U);
+      pBuffer[(counter * 4U) + 3U] = (uint8_t)crc;
+    }
+
+    status = SUCCESS;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Check that a valid application is present at the given address.
+  *         The vector table must hold an initial stack pointer inside the RAM and a Thumb reset handler
+  *         inside the Flash. When OPENBL_APP_CRC_CHECK is enabled, the application must also match
+  *         the CRC-32 stored in its marker [magic, size, CRC-32, reserved] at OPENBL_APP_MARKER_ADDRESS.
+  *         It is called by the fast boot before the memories are registered, the Flash is read through
+  *         Common_ReadWord.
+  * @param  Address The address of the application vector table.
+  * @retval SUCCESS if the application is valid else ERROR.
+  */
+ErrorStatus OPENBL_MEM_CheckApplication(uint32_t Address)
+{
+  ErrorStatus status = ERROR;
+  uint32_t stack_pointer;
+  uint32_t reset_handler;
+  uint32_t size;
+
+  if ((Address >= FLASH_START_ADDRESS) && (Address < FLASH_END_ADDRESS))
+  {
+    stack_pointer = Common_ReadWord(Address);
+    reset_handler = Common_ReadWord(Address + 4U);
+
+    if ((stack_pointer > RAM_START_ADDRESS) && (stack_pointer <= RAM_END_ADDRESS)
+        && ((stack_pointer & 0x3U) == 0U)
+        && ((reset_handler & 0x1U) != 0U)
+        && ((reset_handler & ~0x1U) > Address) && (reset_handler < FLASH_END_ADDRESS))
+    {
+      status = SUCCESS;
+    }
+  }
+
+  if ((status == SUCCESS) && (OPENBL_APP_CRC_CHECK == 1U))
+  {
+    size = Common_ReadWord(OPENBL_APP_MARKER_ADDRESS + 4U);
+
+    if ((Common_ReadWord(OPENBL_APP_MARKER_ADDRESS) != OPENBL_APP_MARKER_MAGIC)
+        || (size == 0U) || (size > (FLASH_END_ADDRESS - Address))
+        || (OPENBL_MEM_GetApplicationCrc32(Address, size) != Common_ReadWord(OPENBL_APP_MARKER_ADDRESS + 8U)))
+    {
+      status = ERROR;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Program in the Flash an image staged in RAM at OPENBL_STAGING_ADDRESS, see the Commit Memory command.
+  *         The staged image is checked against its CRC-32 before the pages it covers are erased,
+  *         it is then programmed by blocks of 1 Kbyte and the CRC-32 is checked again on the Flash.
+  * @param  Address The Flash address where the image is programmed.
+  * @param  Length The number of bytes of the image.
+  * @param  Crc The CRC-32 of the image.
+  * @param  pBuffer Pointer to a work buffer, holding the list of pages then each programmed block.
+  * @param  BufferSize Size of the work buffer, at least OPENBL_MEM_COMMIT_BLOCK_SIZE bytes.
+  * @retval An ErrorStatus enumeration value:
+  *          - SUCCESS: The image is programmed and its CRC-32 is checked
+  *          - ERROR:   One parameter is invalid, the staged image is corrupted or the programming failed
+  */
+ErrorStatus OPENBL_MEM_Commit(uint32_t Address, uint32_t Length, uint32_t Crc, uint8_t *pBuffer, uint32_t BufferSize)
+{
+  ErrorStatus status = SUCCESS;
+  uint32_t staging_index;
+  uint32_t page;
+  uint32_t last_page;
+  uint32_t pages_number;
+  uint32_t pages_max;
+  uint32_t offset;
+  uint32_t block_size;
+  uint32_t counter;
+
+  if ((OPENBL_STAGING_ENABLE == 0U) || (BufferSize < OPENBL_MEM_COMMIT_BLOCK_SIZE)
+      || (Length == 0U) || (Length > OPENBL_STAGING_SIZE)
+      || (OPENBL_MEM_GetAddressArea(Address) != FLASH_AREA)
+      || (OPENBL_MEM_GetAddressArea(Address + Length - 1U) != FLASH_AREA)
+      || (OPENBL_MEM_GetPageSize(Address) == 0U))
+  {
+    status = ERROR;
+  }
+  else if (OPENBL_MEM_ComputeCrc32(0U, OPENBL_STAGING_ADDRESS, Length) != Crc)
+  {
+    /* The image was corrupted during its upload, the Flash is left untouched */
+    status = ERROR;
+  }
+  else
+  {
+    /* Erase the pages covering the image, as many at once as the work buffer can list */
+    page      = OPENBL_MEM_GetPage(Address);
+    last_page = OPENBL_MEM_GetPage(Address + Length - 1U);
+    pages_max = (BufferSize - 2U) / 2U;
+
+    while ((status == SUCCESS) && (page <= last_page))
+    {
+      pages_number = last_page - page + 1U;
+
+      if (pages_number > pages_max)
+      {
+        pages_number = pages_max;
+      }
+
+      pBuffer[0] = (uint8_t)pages_number;
+      pBuffer[1] = (uint8_t)(pages_number >> 8U);
+
+      for (counter = 0U; counter < pages_number; counter++)
+      {
+        pBuffer[2U + (2U * counter)] = (uint8_t)(page + counter);
+        pBuffer[3U + (2U * counter)] = (uint8_t)((page + counter) >> 8U);
+      }
+
+      status = OPENBL_MEM_Erase(Address, pBuffer, 2U + (2U * pages_number));
+      page  += pages_number;
+    }
+
+    /* Copy the staged image in the Flash */
+    staging_index = OPENBL_MEM_GetMemoryIndex(OPENBL_STAGING_ADDRESS);
+    offset        = 0U;
+
+    while ((status == SUCCESS) && (offset < Length))
+    {
+      block_size = Length - offset;
+
+      if (block_size > OPENBL_MEM_COMMIT_BLOCK_SIZE)
+      {
+        block_size = OPENBL_MEM_COMMIT_BLOCK_SIZE;
+      }
+
+      for (counter = 0U; counter < block_size; counter++)
+      {
+        pBuffer[counter] = OPENBL_MEM_Read(OPENBL_STAGING_ADDRESS + offset + counter, staging_index);
+      }
+
+      OPENBL_MEM_Write(Address + offset, pBuffer, block_size);
+      offset += block_size;
+    }
+
+    /* Check the programmed image */
+    if ((status == SUCCESS) && (OPENBL_MEM_ComputeCrc32(0U, Address, Length) != Crc))
+    {
+      status = ERROR;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Decompress data in the LZ4 block format and write it to memory, see the Compressed Write Memory command.
+  *         Each sequence is [token, literals length, literals, offset LSB first, match length], the data ends
+  *         after the literals or the match of its last sequence. A match is copied from up to 64 Kbytes before,
+  *         the bytes already written to memory, before Address included, are read back from it.
+  *         So the RAM used does not depend on the window: the output is written to memory by blocks of the
+  *         buffer size, rounded down to a multiple of 256 bytes.
+  * @param  Address The address where the decompressed data is written.
+  * @param  pData Pointer to the compressed data.
+  * @param  Length The number of bytes of compressed data.
+  * @param  pBuffer Pointer to the output buffer.
+  * @param  BufferSize Size of the output buffer, at least OPENBL_MEM_OUTPUT_BLOCK_SIZE bytes.
+  * @param  pSize Pointer to the returned number of decompressed bytes.
+  * @retval An ErrorStatus enumeration value:
+  *          - SUCCESS: The data is decompressed and written
+  *          - ERROR:   The compressed data is corrupted or the output goes out of the valid memories
+  */
+ErrorStatus OPENBL_MEM_WriteCompressed(uint32_t Address, uint8_t *pData, uint32_t Length, uint8_t *pBuffer,
+                                       uint32_t BufferSize, uint32_t *pSize)
+{
+  return OPENBL_MEM_Decode(Address, pData, Length, pBuffer, BufferSize, NULL, pSize);
+}
+
+/**
+  * @brief  Apply a delta patch and write the result to memory, see the Patch Memory command.
+  *         The patch starts with the address of the old image (4 bytes, MSB first), followed by LZ4 sequences
+  *         whose matches are copied from the old image instead of the data written before: the offset is
+  *         a signed displacement of the old image pointer, which then moves to the end of the copied bytes.
+  *         The old image is read from memory and must not overlap the written data.
+  * @param  Address The address where the new data is written.
+  * @param  pData Pointer to the patch.
+  * @param  Length The number of bytes of the patch.
+  * @param  pBuffer Pointer to the output buffer.
+  * @param  BufferSize Size of the output buffer, at least OPENBL_MEM_OUTPUT_BLOCK_SIZE bytes.
+  * @param  pSize Pointer to the returned number of bytes written.
+  * @retval An ErrorStatus enumeration value:
+  *          - SUCCESS: The patch is applied
+  *          - ERROR:   The patch is corrupted or reads or writes out of the valid memories
+  */
+ErrorStatus OPENBL_MEM_WritePatch(uint32_t Address, uint8_t *pData, uint32_t Length, uint8_t *pBuffer,
+                                  uint32_t BufferSize, uint32_t *pSize)
+{
+  ErrorStatus status = ERROR;
+  uint32_t source;
+
+  *pSize = 0U;
+
+  if (Length > 4U)
+  {
+    source = ((uint32_t)pData[0] << 24) | ((uint32_t)pData[1] << 16) | ((uint32_t)pData[2] << 8) | (uint32_t)pData[3];
+    status = OPENBL_MEM_Decode(Address, &pData[4], Length - 4U, pBuffer, BufferSize, &source, pSize);
+  }
+
+  return status;
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Decode LZ4 sequences and write the result to memory, see OPENBL_MEM_WriteCompressed
+  *         and OPENBL_MEM_WritePatch.
+  * @param  Address The address where the decoded data is written.
+  * @param  pData Pointer to the sequences.
+  * @param  Length The number of bytes of the sequences.
+  * @param  pBuffer Pointer to the output buffer.
+  * @param  BufferSize Size of the output buffer.
+  * @param  pSource Pointer to the old image pointer of a patch, updated, NULL to copy the matches
+  *         from the data written before.
+  * @param  pSize Pointer to the returned number of decoded bytes.
+  * @retval ERROR if the data is corrupted or out of the valid memories else SUCCESS.
+  */
+static ErrorStatus OPENBL_MEM_Decode(uint32_t Address, uint8_t *pData, uint32_t Length, uint8_t *pBuffer,
+                                     uint32_t BufferSize, uint32_t *pSource, uint32_t *pSize)
+{
+  OPENBL_MEM_OutputTypeDef output;
+  ErrorStatus status = SUCCESS;
+  uint32_t index = 0U;
+  uint32_t literals;
+  uint32_t match;
+  uint32_t offset;
+  uint32_t source;
+  uint32_t memory_index;
+  uint32_t counter;
+  uint8_t token;
+
+  output.pBuffer    = pBuffer;
+  output.BufferSize = (BufferSize / OPENBL_MEM_OUTPUT_BLOCK_SIZE) * OPENBL_MEM_OUTPUT_BLOCK_SIZE;
+  output.Address    = Address;
+  output.Count      = 0U;
+
+  if (output.BufferSize == 0U)
+  {
+    status = ERROR;
+  }
+
+  while ((status == SUCCESS) && (index < Length))
+  {
+    token = pData[index];
+    index++;
+
+    /* Literals copied from the sequences */
+    literals = (uint32_t)token >> 4U;
+    status   = OPENBL_MEM_GetLz4Length(pData, Length, &index, &literals);
+
+    if ((status == SUCCESS) && (literals > (Length - index)))
+    {
+      status = ERROR;
+    }
+
+    for (counter = 0U; (counter < literals) && (status == SUCCESS); counter++)
+    {
+      status = OPENBL_MEM_OutputByte(&output, pData[index]);
+      index++;
+    }
+
+    /* Match copied from the decoded data or from the old image, the last sequence may have none */
+    if ((status == SUCCESS) && (index < Length))
+    {
+      if ((Length - index) < 2U)
+      {
+        status = ERROR;
+      }
+      else
+      {
+        offset = (uint32_t)pData[index] | ((uint32_t)pData[index + 1U] << 8U);
+        index += 2U;
+
+        match  = (uint32_t)token & OPENBL_MEM_LZ4_LENGTH_MASK;
+        status = OPENBL_MEM_GetLz4Length(pData, Length, &index, &match);
+        match += OPENBL_MEM_LZ4_MIN_MATCH;
+
+        if (pSource == NULL)
+        {
+          source = output.Address + output.Count - offset;
+
+          if ((offset == 0U) || (offset > (output.Address + output.Count)))
+          {
+            status = ERROR;
+          }
+        }
+        else
+        {
+          /* Signed 16-bit displacement of the old image pointer */
+          source   = *pSource + offset - ((offset & 0x8000U) << 1U);
+          *pSource = source + match;
+
+          /* The old image must not be overwritten while read */
+          if ((*pSource < source)
+              || ((source < (output.Address + output.Count + match)) && (*pSource > Address)))
+          {
+            status = ERROR;
+          }
+        }
+
+        if ((OPENBL_MEM_GetAddressArea(source) == AREA_ERROR)
+            || (OPENBL_MEM_GetAddressArea(source + match - 1U) == AREA_ERROR))
+        {
+          status = ERROR;
+        }
+
+        memory_index = OPENBL_MEM_GetMemoryIndex(source);
+
+        for (counter = 0U; (counter < match) && (status == SUCCESS); counter++)
+        {
+          if ((pSource == NULL) && (source >= output.Address))
+          {
+            status = OPENBL_MEM_OutputByte(&output, output.pBuffer[source - output.Address]);
+          }
+          else
+          {
+            status = OPENBL_MEM_OutputByte(&output, OPENBL_MEM_Read(source, memory_index));
+          }
+
+          source++;
+        }
+      }
+    }
+  }
+
+  if (status == SUCCESS)
+  {
+    status = OPENBL_MEM_OutputFlush(&output);
+  }
+
+  *pSize = output.Address - Address;
+
+  return status;
+}
+
+/**
+  * @brief  Read the extra bytes of a LZ4 length, they follow a length field of 15 and are added to it
+  *         until a byte different from 255.
+  * @param  pData Pointer to the compressed data.
+  * @param  Length The number of bytes of compressed data.
+  * @param  pIndex Pointer to the index of the next byte to be read, updated.
+  * @param  pValue Pointer to the length field of the token, updated with the whole length.
+  * @retval ERROR if the compressed data ends in the length else SUCCESS.
+  */
+static ErrorStatus OPENBL_MEM_GetLz4Length(uint8_t *pData, uint32_t Length, uint32_t *pIndex, uint32_t *pValue)
+{
+  ErrorStatus status = SUCCESS;
+  uint8_t data = 0xFFU;
+
+  if (*pValue == OPENBL_MEM_LZ4_LENGTH_MASK)
+  {
+    while ((data == 0xFFU) && (status == SUCCESS))
+    {
+      if (*pIndex >= Length)
+      {
+        status = ERROR;
+      }
+      else
+      {
+        data     = pData[*pIndex];
+        *pValue += (uint32_t)data;
+        (*pIndex)++;
+      }
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Add a decompressed byte to the output buffer, the buffer is written to memory once full.
+  * @param  pOutput Pointer to the output.
+  * @param  Data The decompressed byte.
+  * @retval ERROR if the buffer could not be written else SUCCESS.
+  */
+static ErrorStatus OPENBL_MEM_OutputByte(OPENBL_MEM_OutputTypeDef *pOutput, uint8_t Data)
+{
+  ErrorStatus status = SUCCESS;
+
+  pOutput->pBuffer[pOutput->Count] = Data;
+  pOutput->Count++;
+
+  if (pOutput->Count == pOutput->BufferSize)
+  {
+    status = OPENBL_MEM_OutputFlush(pOutput);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Write the output buffer to memory.
+  * @param  pOutput Pointer to the output.
+  * @retval ERROR if the buffer goes out of the valid memories else SUCCESS.
+  */
+static ErrorStatus OPENBL_MEM_OutputFlush(OPENBL_MEM_OutputTypeDef *pOutput)
+{
+  ErrorStatus status = SUCCESS;
+
+  if (pOutput->Count != 0U)
+  {
+    if ((OPENBL_MEM_GetAddressArea(pOutput->Address) == AREA_ERROR)
+        || (OPENBL_MEM_GetAddressArea(pOutput->Address + pOutput->Count - 1U) == AREA_ERROR))
+    {
+      status = ERROR;
+    }
+    else
+    {
+      OPENBL_MEM_Write(pOutput->Address, pOutput->pBuffer, pOutput->Count);
+
+      pOutput->Address += pOutput->Count;
+      pOutput->Count    = 0U;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Update a reflected CRC-32 (IEEE 802.3) with one byte, half a byte at a time.
+  * @param  Crc The current CRC, not inverted.
+  * @param  Data The byte to add.
+  * @retval The updated CRC.
+  */
+static uint32_t OPENBL_MEM_UpdateCrc32(uint32_t Crc, uint8_t Data)
+{
+  uint32_t crc = Crc ^ (uint32_t)Data;
+
+  crc = (crc >> 4U) ^ a_MemCrc32Table[crc & 0x0FU];
+  crc = (crc >> 4U) ^ a_MemCrc32Table[crc & 0x0FU];
+
+  return crc;
+}
+
+/**
+  * @brief  Compute the CRC-32 of the application, read directly from the Flash.
+  *         The CRC unit is used when OPENBL_HW_CRC_ENABLE is set.
+  * @param  Address The address of the application vector table.
+  * @param  Length The number of bytes of the application.
+  * @retval The CRC of the application.
+  */
+static uint32_t OPENBL_MEM_GetApplicationCrc32(uint32_t Address, uint32_t Length)
+{
+  uint32_t counter;
+  uint32_t crc;
+
+  if (OPENBL_HW_CRC_ENABLE == 1U)
+  {
+    crc = Common_ComputeCrc32(0U, Address, Length);
+  }
+  else
+  {
+    crc = 0xFFFFFFFFU;
+
+    for (counter = 0U; counter < Length; counter++)
+    {
+      crc = OPENBL_MEM_UpdateCrc32(crc, *(__IO uint8_t *)(uintptr_t)(Address + counter));
+    }
+
+    crc = ~crc;
+  }
+
+  return crc;
+}
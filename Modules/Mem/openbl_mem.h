@@ -41,6 +41,8 @@ typedef struct
   void (*JumpToAddress)(uint32_t Address);
   ErrorStatus(*MassErase)(uint8_t *p_Data, uint32_t DataLength);
   ErrorStatus(*Erase)(uint8_t *p_Data, uint32_t DataLength);
+  uint32_t PageSize;
+  uint32_t BankSize;
 } OPENBL_MemoryTypeDef;
 
 /* Exported constants --------------------------------------------------------*/
@@ -54,11 +56,22 @@ uint8_t OPENBL_MEM_Read(uint32_t Address, uint32_t MemoryIndex);
 uint32_t OPENBL_MEM_GetAddressArea(uint32_t Address);
 uint32_t OPENBL_MEM_GetMemoryIndex(uint32_t Address);
 uint8_t OPENBL_MEM_CheckJumpAddress(uint32_t Address);
+uint32_t OPENBL_MEM_GetPage(uint32_t Address);
+uint32_t OPENBL_MEM_GetPageSize(uint32_t Address);
+uint32_t OPENBL_MEM_GetBankSize(uint32_t Address);
+uint32_t OPENBL_MEM_ComputeCrc32(uint32_t Crc, uint32_t Address, uint32_t Length);
 
 ErrorStatus OPENBL_MEM_Erase(uint32_t Address, uint8_t *p_Data, uint32_t DataLength);
 ErrorStatus OPENBL_MEM_MassErase(uint32_t Address, uint8_t *p_Data, uint32_t DataLength);
 ErrorStatus OPENBL_MEM_RegisterMemory(OPENBL_MemoryTypeDef *Memory);
 ErrorStatus OPENBL_MEM_SetWriteProtection(FunctionalState State, uint32_t Address, uint8_t *Buffer, uint32_t Length);
+ErrorStatus OPENBL_MEM_CheckApplication(uint32_t Address);
+ErrorStatus OPENBL_MEM_Commit(uint32_t Address, uint32_t Length, uint32_t Crc, uint8_t *pBuffer, uint32_t BufferSize);
+ErrorStatus OPENBL_MEM_WriteCompressed(uint32_t Address, uint8_t *pData, uint32_t Length, uint8_t *pBuffer,
+                                       uint32_t BufferSize, uint32_t *pSize);
+ErrorStatus OPENBL_MEM_WritePatch(uint32_t Address, uint8_t *pData, uint32_t Length, uint8_t *pBuffer,
+                                  uint32_t BufferSize, uint32_t *pSize);
+ErrorStatus OPENBL_MEM_GetBlockCrc(uint32_t Address, uint32_t BlockSize, uint32_t BlocksNumber, uint8_t *pBuffer);
 
 #ifdef __cplusplus
 }
@@ -19,6 +19,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "openbl_mem.h"
 #include "openbl_spi_cmd.h"
+#include "openbl_engine.h"
 
 #include "openbootloader_conf.h"
 #include "app_openbootloader.h"
@@ -27,22 +28,41 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
-#define OPENBL_SPI_COMMANDS_NB_MAX        13U  /* Number of supported commands */
-#define SPI_RAM_BUFFER_SIZE               1164U  /* Size of SPI buffer used to store received data from the host */
+#define OPENBL_SPI_COMMANDS_NB_MAX        18U  /* Number of supported commands */
+#define SPI_RAM_BUFFER_SIZE               OPENBL_ENGINE_BUFFER_SIZE  /* Size of SPI buffer used to store received data from the host */
 
 /* Private macro -------------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void OPENBL_SPI_ReadFrame(uint8_t *pBuffer, uint32_t Length);
+static void OPENBL_SPI_SendFrame(uint8_t *pBuffer, uint32_t Length);
+static void OPENBL_SPI_SendBusy(FunctionalState State);
+static uint8_t OPENBL_SPI_ConstructCommandsTable(OPENBL_CommandsTypeDef *pSpiCmd);
+
 /* Private variables ---------------------------------------------------------*/
-/* Private macro -------------------------------------------------------------*/
-/* Private variables ---------------------------------------------------------*/
-/* Buffer used to store received data from the host */
-static uint8_t SPI_RAM_Buf[SPI_RAM_BUFFER_SIZE];
+/* Block transport of the SPI interface, each acknowledge is synchronized with the host */
+static const OPENBL_ENGINE_TransportTypeDef SpiTransport =
+{
+  OPENBL_SPI_ReadFrame,
+  OPENBL_SPI_SendFrame,
+  OPENBL_SPI_SendAcknowledgeByte,
+  OPENBL_SPI_SendBusy,
+  OPENBL_SPI_SpecialCommandProcess,
+  NULL
+};
+
 static uint8_t a_OPENBL_SPI_CommandsList[OPENBL_SPI_COMMANDS_NB_MAX] = {0U};
-static uint8_t SpiCommandsNumber = 0U;
 
-/* Private function prototypes -----------------------------------------------*/
-static uint8_t OPENBL_SPI_GetAddress(uint32_t *Address);
-static uint8_t OPENBL_SPI_GetSpecialCmdOpCode(uint16_t *OpCode, OPENBL_SpecialCmdTypeTypeDef CmdType);
-static uint8_t OPENBL_SPI_ConstructCommandsTable(OPENBL_CommandsTypeDef *pSpiCmd);
+/* The SPI commands are run by the command engine */
+static OPENBL_ENGINE_HandleTypeDef SpiHandle =
+{
+  &SpiTransport,
+  NULL,
+  SPI_RAM_BUFFER_SIZE,
+  a_OPENBL_SPI_CommandsList,
+  0U,
+  OPENBL_SPI_VERSION,
+  OPENBL_ENGINE_FRAMING_SPLIT_LENGTH
+};
 
 /* Exported variables --------------------------------------------------------*/
 /* Exported functions---------------------------------------------------------*/
@@ -74,9 +94,20 @@ OPENBL_CommandsTypeDef *OPENBL_SPI_GetCommandsList(void)
     NULL,
     NULL,
     OPENBL_SPI_SpecialCommand,
-    OPENBL_SPI_ExtendedSpecialCommand
+    OPENBL_SPI_ExtendedSpecialCommand,
+    NULL,
+    NULL,
+    NULL,
+    OPENBL_SPI_GetStatistics,
+    OPENBL_SPI_CommitMemory,
+    OPENBL_SPI_CompressedWriteMemory,
+    OPENBL_SPI_PatchMemory,
+    OPENBL_SPI_GetBlockCrc
   };
 
+  /* The command buffer is taken from the arena shared by all the interfaces */
+  SpiHandle.pBuffer = OPENBL_GetBuffer(SPI_RAM_BUFFER_SIZE);
+
   OPENBL_SPI_SetCommandsList(&OPENBL_SPI_Commands);
 
   return (&OPENBL_SPI_Commands);
@@ -89,33 +120,16 @@ OPENBL_CommandsTypeDef *OPENBL_SPI_GetCommandsList(void)
 void OPENBL_SPI_SetCommandsList(OPENBL_CommandsTypeDef *pSpiCmd)
 {
   /* Get the list of commands supported & their numbers */
-  SpiCommandsNumber = OPENBL_SPI_ConstructCommandsTable(pSpiCmd);
+  SpiHandle.CommandsNumber = OPENBL_SPI_ConstructCommandsTable(pSpiCmd);
 }
 
 /**
-  * @brief  This function is used to get the list of the available SPI commands
+  * @brief  This function is used to get the list of the available SPI commands.
   * @retval None.
   */
 void OPENBL_SPI_GetCommand(void)
 {
-  uint32_t counter;
-
-  OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-  /* Send the number of commands supported by the SPI protocol */
-  OPENBL_SPI_SendByte(SpiCommandsNumber);
-
-  /* Send SPI protocol version */
-  OPENBL_SPI_SendByte(OPENBL_SPI_VERSION);
-
-  /* Send the list of supported commands */
-  for (counter = 0U; counter < SpiCommandsNumber; counter++)
-  {
-    OPENBL_SPI_SendByte(a_OPENBL_SPI_CommandsList[counter]);
-  }
-
-  /* Send last Acknowledge synchronization byte */
-  OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
+  OPENBL_ENGINE_GetCommand(&SpiHandle);
 }
 
 /**
@@ -124,14 +138,7 @@ void OPENBL_SPI_GetCommand(void)
   */
 void OPENBL_SPI_GetVersion(void)
 {
-  /* Send Acknowledge byte to notify the host that the command is recognized */
-  OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-  /* Send SPI protocol version */
-  OPENBL_SPI_SendByte(OPENBL_SPI_VERSION);
-
-  /* Send last Acknowledge synchronization byte */
-  OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
+  OPENBL_ENGINE_GetVersion(&SpiHandle);
 }
 
 /**
@@ -140,17 +147,7 @@ void OPENBL_SPI_GetVersion(void)
   */
 void OPENBL_SPI_GetID(void)
 {
-  /* Send Acknowledge byte to notify the host that the command is recognized */
-  OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-  OPENBL_SPI_SendByte(0x01U);
-
-  /* Send the device ID starting by the MSB byte then the LSB byte */
-  OPENBL_SPI_SendByte(DEVICE_ID_MSB);
-  OPENBL_SPI_SendByte(DEVICE_ID_LSB);
-
-  /* Send last Acknowledge synchronization byte */
-  OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
+  OPENBL_ENGINE_GetID(&SpiHandle);
 }
 
 /**
@@ -159,55 +156,7 @@ void OPENBL_SPI_GetID(void)
   */
 void OPENBL_SPI_ReadMemory(void)
 {
-  uint32_t address;
-  uint32_t counter;
-  uint32_t memory_index;
-  uint8_t data;
-  uint8_t xor;
-
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Get the memory address */
-    if (OPENBL_SPI_GetAddress(&address) == NACK_BYTE)
-    {
-      OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-      /* Get the number of bytes to be received */
-      data = OPENBL_SPI_ReadByte();
-      xor  = ~data;
-
-      /* Check data integrity */
-      if (OPENBL_SPI_ReadByte() != xor)
-      {
-        OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-        /* Get the memory index to know from which memory we will read */
-        memory_index = OPENBL_MEM_GetMemoryIndex(address);
-
-        /* Read the data (data + 1) from the memory and send them to the host */
-        for (counter = ((uint32_t)data + 1U); counter != 0U; counter--)
-        {
-          OPENBL_SPI_SendByte(OPENBL_MEM_Read(address, memory_index));
-          address++;
-        }
-      }
-    }
-  }
+  OPENBL_ENGINE_ReadMemory(&SpiHandle);
 }
 
 /**
@@ -216,72 +165,7 @@ void OPENBL_SPI_ReadMemory(void)
   */
 void OPENBL_SPI_WriteMemory(void)
 {
-  uint32_t address;
-  uint32_t xor;
-  uint32_t counter;
-  uint32_t codesize;
-  uint8_t *ramaddress;
-  uint8_t data;
-
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Get the memory address */
-    if (OPENBL_SPI_GetAddress(&address) == NACK_BYTE)
-    {
-      OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-      /* Read number of bytes to be written and data */
-      ramaddress = (uint8_t *)SPI_RAM_Buf;
-
-      /* Read the number of bytes to be written: Max number of data = data + 1 = 256 */
-      data = OPENBL_SPI_ReadByte();
-
-      /* Number of data to be written = data + 1 */
-      codesize = (uint32_t)data + 1U;
-
-      /* Checksum Initialization */
-      xor = data;
-
-      /* SPI receive data and send to RAM Buffer */
-      for (counter = codesize; counter != 0U ; counter--)
-      {
-        data  = OPENBL_SPI_ReadByte();
-        xor  ^= data;
-
-        *(__IO uint8_t *)(ramaddress) = data;
-
-        ramaddress++;
-      }
-
-      /* Send NACk if Checksum is incorrect */
-      if (OPENBL_SPI_ReadByte() != xor)
-      {
-        OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        /* Write data to memory */
-        OPENBL_MEM_Write(address, (uint8_t *)SPI_RAM_Buf, codesize);
-
-        /* Send last Acknowledge synchronization byte */
-        OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-        /* Launch Option Bytes reload */
-        Common_StartPostProcessing();
-      }
-    }
-  }
+  OPENBL_ENGINE_WriteMemory(&SpiHandle);
 }
 
 /**
@@ -290,41 +174,7 @@ void OPENBL_SPI_WriteMemory(void)
   */
 void OPENBL_SPI_Go(void)
 {
-  uint32_t address;
-  uint8_t status;
-
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Get memory address */
-    if (OPENBL_SPI_GetAddress(&address) == NACK_BYTE)
-    {
-      OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      /* Check if received address is valid or not */
-      status = OPENBL_MEM_CheckJumpAddress(address);
-
-      if (status == 0U)
-      {
-        OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        /* If the jump address is valid then send ACK */
-        OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-        OPENBL_MEM_JumpToAddress(address);
-      }
-    }
-  }
+  OPENBL_ENGINE_Go(&SpiHandle);
 }
 
 /**
@@ -333,43 +183,16 @@ void OPENBL_SPI_Go(void)
   */
 void OPENBL_SPI_ReadoutProtect(void)
 {
-  /* Check memory protection then send adequate response */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Enable the read protection */
-    OPENBL_MEM_SetReadOutProtection(OPENBL_DEFAULT_MEM, ENABLE);
-
-    OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Launch Option Bytes reload */
-    Common_StartPostProcessing();
-  }
+  OPENBL_ENGINE_ReadoutProtect(&SpiHandle);
 }
 
 /**
   * @brief  This function is used to disable readout protection.
-  * @note   Going from RDP level 1 to RDP level 0 erases all the flash,
-  *         so the send of the second acknowledge after disabling the read protection
-  *         is not possible, this is why the two ACKs are sent successively
   * @retval None.
   */
 void OPENBL_SPI_ReadoutUnprotect(void)
 {
-  OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-  OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-  /* Disable the read protection */
-  OPENBL_MEM_SetReadOutProtection(OPENBL_DEFAULT_MEM, DISABLE);
-
-  /* Launch Option Bytes reload and reset system */
-  Common_StartPostProcessing();
+  OPENBL_ENGINE_ReadoutUnprotect(&SpiHandle);
 }
 
 /**
@@ -378,146 +201,7 @@ void OPENBL_SPI_ReadoutUnprotect(void)
   */
 void OPENBL_SPI_EraseMemory(void)
 {
-  uint32_t xor;
-  uint32_t counter;
-  uint32_t numpage;
-  uint16_t data;
-  ErrorStatus error_value;
-  uint8_t status = ACK_BYTE;
-  uint8_t *ramaddress;
-
-  ramaddress = (uint8_t *) SPI_RAM_Buf;
-
-  /* Check if the memory is not protected */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Read number of pages to be erased */
-    data = OPENBL_SPI_ReadByte();
-    data = (uint16_t)(data << 8) | OPENBL_SPI_ReadByte();
-
-    /* Checksum initialization */
-    xor  = ((uint32_t)data & 0xFF00U) >> 8;
-    xor ^= (uint32_t)data & 0x00FFU;
-
-    /* All commands in range 0xFFFZ are reserved for special erase features */
-    if ((data & 0xFFF0U) == 0xFFF0U)
-    {
-      /* Check data integrity */
-      if (OPENBL_SPI_ReadByte() != (uint8_t) xor)
-      {
-        status = NACK_BYTE;
-      }
-      else
-      {
-        if ((data == 0xFFFFU) || (data == 0xFFFEU) || (data == 0xFFFDU))
-        {
-          ramaddress[0] = (uint8_t)(data & 0x00FFU);
-          ramaddress[1] = (uint8_t)((data & 0xFF00U) >> 8);
-
-          /* Enable busy state */
-          OPENBL_SPI_EnableBusyState();
-
-          error_value = OPENBL_MEM_MassErase(OPENBL_DEFAULT_MEM, (uint8_t *) SPI_RAM_Buf, SPI_RAM_BUFFER_SIZE);
-
-          /* Disable busy state */
-          OPENBL_SPI_DisableBusyState();
-
-          if (error_value == SUCCESS)
-          {
-            status = ACK_BYTE;
-          }
-          else
-          {
-            status = NACK_BYTE;
-          }
-        }
-        else
-        {
-          /* This sub-command is not supported */
-          status = NACK_BYTE;
-        }
-      }
-    }
-    else
-    {
-      /* Check data integrity */
-      if (OPENBL_SPI_ReadByte() != (uint8_t) xor)
-      {
-        status = NACK_BYTE;
-      }
-      else
-      {
-        OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-        ramaddress = (uint8_t *) SPI_RAM_Buf;
-
-        /* Number of pages to be erased (data + 1) */
-        numpage = (uint32_t)data + 1U;
-
-        *ramaddress = (uint8_t)(numpage & 0x00FFU);
-        ramaddress++;
-
-        *ramaddress = (uint8_t)((numpage & 0xFF00U) >> 8);
-        ramaddress++;
-
-        /* Checksum Initialization */
-        xor = 0U;
-
-        /* Get the pages to be erased */
-        for (counter = numpage; counter != 0U ; counter--)
-        {
-          /* Receive the MSB byte */
-          data  = OPENBL_SPI_ReadByte();
-          xor  ^= data;
-          data  = (uint16_t)((data & 0x00FFU) << 8);
-
-          /* Receive the LSB byte */
-          data |= (uint8_t)(OPENBL_SPI_ReadByte() & 0x00FFU);
-          xor  ^= ((uint32_t)data & 0x00FFU);
-
-          /* Only store data that fit in the buffer length */
-          if (counter < (SPI_RAM_BUFFER_SIZE / 2U))
-          {
-            *ramaddress = (uint8_t)(data & 0x00FFU);
-            ramaddress++;
-
-            *ramaddress = (uint8_t)((data & 0xFF00U) >> 8);
-            ramaddress++;
-          }
-        }
-
-        /* Check data integrity */
-        if (OPENBL_SPI_ReadByte() != (uint8_t) xor)
-        {
-          status = NACK_BYTE;
-        }
-        else
-        {
-          /* Enable busy state */
-          OPENBL_SPI_EnableBusyState();
-
-          error_value = OPENBL_MEM_Erase(OPENBL_DEFAULT_MEM, (uint8_t *) SPI_RAM_Buf, SPI_RAM_BUFFER_SIZE);
-
-          /* Disable busy state */
-          OPENBL_SPI_DisableBusyState();
-
-          /* Errors from memory erase are not managed, always return ACK */
-          if (error_value == SUCCESS)
-          {
-            status = ACK_BYTE;
-          }
-        }
-      }
-    }
-
-    OPENBL_SPI_SendAcknowledgeByte(status);
-  }
+  OPENBL_ENGINE_EraseMemory(&SpiHandle);
 }
 
 /**
@@ -526,73 +210,7 @@ void OPENBL_SPI_EraseMemory(void)
   */
 void OPENBL_SPI_WriteProtect(void)
 {
-  uint8_t counter;
-  uint8_t length;
-  uint8_t data;
-  uint8_t xor;
-  ErrorStatus error_value;
-  uint8_t *ramaddress;
-
-  /* Check if the memory is not protected */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Get the data length */
-    data = OPENBL_SPI_ReadByte();
-    xor  = ~data;
-
-    /* Send NACk if Checksum is incorrect */
-    if (OPENBL_SPI_ReadByte() != xor)
-    {
-      OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-      ramaddress = (uint8_t *) SPI_RAM_Buf;
-      length     = data + 1U;
-
-      /* Checksum Initialization */
-      xor = 0U;
-
-      /* Receive data and write to RAM Buffer */
-      for (counter = (length); counter != 0U ; counter--)
-      {
-        data  = OPENBL_SPI_ReadByte();
-        xor  ^= data;
-
-        *(__IO uint8_t *)(ramaddress) = (uint8_t) data;
-
-        ramaddress++;
-      }
-
-      /* Check data integrity and send NACK if Checksum is incorrect */
-      if (OPENBL_SPI_ReadByte() != (uint8_t) xor)
-      {
-        OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        ramaddress = (uint8_t *) SPI_RAM_Buf;
-
-        /* Enable the write protection */
-        error_value = OPENBL_MEM_SetWriteProtection(ENABLE, OPENBL_DEFAULT_MEM, ramaddress, length);
-
-        OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-        if (error_value == SUCCESS)
-        {
-          Common_StartPostProcessing();
-        }
-      }
-    }
-  }
+  OPENBL_ENGINE_WriteProtect(&SpiHandle);
 }
 
 /**
@@ -601,290 +219,123 @@ void OPENBL_SPI_WriteProtect(void)
   */
 void OPENBL_SPI_WriteUnprotect(void)
 {
-  ErrorStatus error_value;
-
-  /* Check if the memory is not protected */
-  if (Common_GetProtectionStatus() != RESET)
-  {
-    OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-  }
-  else
-  {
-    OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Disable write protection */
-    error_value = OPENBL_MEM_SetWriteProtection(DISABLE, OPENBL_DEFAULT_MEM, NULL, 0U);
-
-    OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-    if (error_value == SUCCESS)
-    {
-      Common_StartPostProcessing();
-    }
-  }
+  OPENBL_ENGINE_WriteUnprotect(&SpiHandle);
 }
 
 /**
-  * @brief  This function is used to get a valid address.
-  * @retval Returns NACK status in case of error else returns ACK status.
+  * @brief  This function is used to execute special command commands.
+  * @retval None.
   */
-uint8_t OPENBL_SPI_GetAddress(uint32_t *Address)
+void OPENBL_SPI_SpecialCommand(void)
 {
-  uint8_t data[4] = {0U, 0U, 0U, 0U};
-  uint8_t status;
-  uint8_t xor;
-
-  data[3] = OPENBL_SPI_ReadByte();
-  data[2] = OPENBL_SPI_ReadByte();
-  data[1] = OPENBL_SPI_ReadByte();
-  data[0] = OPENBL_SPI_ReadByte();
+  OPENBL_ENGINE_SpecialCommand(&SpiHandle);
+}
 
-  xor = data[3] ^ data[2] ^ data[1] ^ data[0];
+/**
+  * @brief  This function is used to execute extended special command commands.
+  * @retval None.
+  */
+void OPENBL_SPI_ExtendedSpecialCommand(void)
+{
+  OPENBL_ENGINE_ExtendedSpecialCommand(&SpiHandle);
+}
 
-  /* Check the integrity of received data */
-  if (OPENBL_SPI_ReadByte() != xor)
-  {
-    status = NACK_BYTE;
-  }
-  else
-  {
+/**
+  * @brief  This function is used to send the statistics recorded by the Open Bootloader.
+  * @retval None.
+  */
+void OPENBL_SPI_GetStatistics(void)
+{
+  OPENBL_ENGINE_GetStatistics(&SpiHandle);
+}
 
-    *Address = ((uint32_t)data[3] << 24) | ((uint32_t)data[2] << 16) | ((uint32_t)data[1] << 8) | (uint32_t)data[0];
+/**
+  * @brief  This function is used to program in the Flash an image staged in RAM.
+  * @retval None.
+  */
+void OPENBL_SPI_CommitMemory(void)
+{
+  OPENBL_ENGINE_CommitMemory(&SpiHandle);
+}
 
-    /* Check if received address is valid or not */
-    if (OPENBL_MEM_GetAddressArea(*Address) == AREA_ERROR)
-    {
-      status = NACK_BYTE;
-    }
-    else
-    {
-      status = ACK_BYTE;
-    }
-  }
+/**
+  * @brief  This function is used to write in to device memory data compressed in the LZ4 block format.
+  * @retval None.
+  */
+void OPENBL_SPI_CompressedWriteMemory(void)
+{
+  OPENBL_ENGINE_CompressedWriteMemory(&SpiHandle);
+}
 
-  return status;
+/**
+  * @brief  This function is used to write in to device memory a new image built by a delta patch.
+  * @retval None.
+  */
+void OPENBL_SPI_PatchMemory(void)
+{
+  OPENBL_ENGINE_PatchMemory(&SpiHandle);
 }
 
 /**
-  * @brief  This function is used to execute special read commands.
+  * @brief  This function is used to send the CRC-32 of consecutive memory blocks.
   * @retval None.
   */
-void OPENBL_SPI_SpecialCommand(void)
+void OPENBL_SPI_GetBlockCrc(void)
 {
-  OPENBL_SpecialCmdTypeDef *special_cmd;
-  uint16_t op_code;
-  uint8_t index;
-  uint8_t data;
-  uint8_t xor;
+  OPENBL_ENGINE_GetBlockCrc(&SpiHandle);
+}
 
-  /* Point to the RAM SPI buffer to gain size and reliability */
-  special_cmd = (OPENBL_SpecialCmdTypeDef *)(uint32_t) SPI_RAM_Buf;
+/* Private functions ---------------------------------------------------------*/
 
-  /* Send special read code acknowledgment */
-  OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
+/**
+  * @brief  This function is used to receive bytes of the current host frame.
+  * @param  pBuffer Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes.
+  * @retval None.
+  */
+static void OPENBL_SPI_ReadFrame(uint8_t *pBuffer, uint32_t Length)
+{
+  uint32_t counter;
 
-  /* Get the command operation code */
-  if (OPENBL_SPI_GetSpecialCmdOpCode(&op_code, OPENBL_SPECIAL_CMD) == NACK_BYTE)
+  for (counter = 0U; counter < Length; counter++)
   {
-    OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
+    pBuffer[counter] = OPENBL_SPI_ReadByte();
   }
-  else
-  {
-    /* Send Operation code acknowledgment */
-    OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Initialize the special command frame */
-    special_cmd->CmdType = OPENBL_SPECIAL_CMD;
-    special_cmd->OpCode  = op_code;
-
-    /* Initialize the xor variable */
-    xor = 0U;
-
-    /* Get the number of bytes to be received */
-    /* Read the MSB of the size byte */
-    data                     = OPENBL_SPI_ReadByte();
-    special_cmd->SizeBuffer1 = ((uint16_t)data) << 8;
-    xor                     ^= data;
-
-    /* Read the LSB of the size byte */
-    data                      = OPENBL_SPI_ReadByte();
-    special_cmd->SizeBuffer1 |= (uint16_t)data;
-    xor                      ^= data;
-
-    if (special_cmd->SizeBuffer1 > SPECIAL_CMD_SIZE_BUFFER1)
-    {
-      OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      if (special_cmd->SizeBuffer1 != 0U)
-      {
-        /* Read received bytes */
-        for (index = 0U; index < special_cmd->SizeBuffer1; index++)
-        {
-          data                        = OPENBL_SPI_ReadByte();
-          special_cmd->Buffer1[index] = data;
-          xor                        ^= data;
-        }
-      }
-
-      /* Check data integrity */
-      if (OPENBL_SPI_ReadByte() != xor)
-      {
-        OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        /* Send received size acknowledgment */
-        OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-        /* Process the special command */
-        OPENBL_SPI_SpecialCommandProcess(special_cmd);
+}
 
-        /* NOTE: In case of any operation inside "SpecialCommandProcess" function that prevents the code
-         * from returning to here (reset operation...), to be compatible with the OpenBL protocol,
-         * the user must ensure sending the last ACK in the application side.
-         */
+/**
+  * @brief  This function is used to send a data frame to the host.
+  * @param  pBuffer Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval None.
+  */
+static void OPENBL_SPI_SendFrame(uint8_t *pBuffer, uint32_t Length)
+{
+  uint32_t counter;
 
-        /* Send last acknowledgment */
-        OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-      }
-    }
+  for (counter = 0U; counter < Length; counter++)
+  {
+    OPENBL_SPI_SendByte(pBuffer[counter]);
   }
 }
 
 /**
-  * @brief  This function is used to execute special write commands.
+  * @brief  This function is used to answer busy bytes to the host during the memory operations.
+  * @param  State ENABLE to enter the busy state, DISABLE to leave it.
   * @retval None.
   */
-void OPENBL_SPI_ExtendedSpecialCommand(void)
+static void OPENBL_SPI_SendBusy(FunctionalState State)
 {
-  OPENBL_SpecialCmdTypeDef *special_cmd;
-  uint16_t op_code;
-  uint16_t index;
-  uint8_t xor;
-  uint8_t data;
-
-
-  /* Point to the RAM SPI buffer to gain size and reliability */
-  special_cmd = (OPENBL_SpecialCmdTypeDef *)(uint32_t) SPI_RAM_Buf;
-
-  /* Send special write code acknowledgment */
-  OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-  /* Get the command operation code */
-  if (OPENBL_SPI_GetSpecialCmdOpCode(&op_code, OPENBL_EXTENDED_SPECIAL_CMD) == NACK_BYTE)
+  if (State == ENABLE)
   {
-    OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
+    OPENBL_SPI_EnableBusyState();
   }
   else
   {
-    /* Send Operation code acknowledgment */
-    OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-    /* Initialize the special command frame */
-    special_cmd->CmdType = OPENBL_EXTENDED_SPECIAL_CMD;
-    special_cmd->OpCode  = op_code;
-
-    /* Initialize the xor variable */
-    xor = 0U;
-
-    /* Get the number of bytes to be received */
-    /* Read the MSB of the size byte */
-    data                     = OPENBL_SPI_ReadByte();
-    special_cmd->SizeBuffer1 = ((uint16_t)data) << 8;
-    xor                     ^= data;
-
-    /* Read the LSB of the size byte */
-    data                      = OPENBL_SPI_ReadByte();
-    special_cmd->SizeBuffer1 |= (uint16_t)data;
-    xor                      ^= data;
-
-    if (special_cmd->SizeBuffer1 > SPECIAL_CMD_SIZE_BUFFER1)
-    {
-      OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-    }
-    else
-    {
-      if (special_cmd->SizeBuffer1 != 0U)
-      {
-        /* Read received bytes */
-        for (index = 0U; index < special_cmd->SizeBuffer1; index++)
-        {
-          data                        = OPENBL_SPI_ReadByte();
-          special_cmd->Buffer1[index] = data;
-          xor                        ^= data;
-        }
-      }
-
-      /* Check data integrity */
-      if (OPENBL_SPI_ReadByte() != xor)
-      {
-        OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-      }
-      else
-      {
-        /* Send receive size acknowledgment */
-        OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-        /* Get the number of bytes to be written */
-        /* Read the MSB of the size byte */
-        xor                      = 0U;
-        data                     = OPENBL_SPI_ReadByte();
-        special_cmd->SizeBuffer2 = ((uint16_t)data) << 8;
-        xor                     ^= data;
-
-        /* Read the LSB of the size byte */
-        data                      = OPENBL_SPI_ReadByte();
-        special_cmd->SizeBuffer2 |= (uint16_t)data;
-        xor                      ^= data;
-
-        if (special_cmd->SizeBuffer2 > SPECIAL_CMD_SIZE_BUFFER2)
-        {
-          OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-        }
-        else
-        {
-          if (special_cmd->SizeBuffer2 != 0U)
-          {
-            /* Read received bytes */
-            for (index = 0U; index < special_cmd->SizeBuffer2; index++)
-            {
-              data                        = OPENBL_SPI_ReadByte();
-              special_cmd->Buffer2[index] = data;
-              xor                        ^= data;
-            }
-          }
-
-          /* Check data integrity */
-          if (OPENBL_SPI_ReadByte() != xor)
-          {
-            OPENBL_SPI_SendAcknowledgeByte(NACK_BYTE);
-          }
-          else
-          {
-            /* Send receive write size acknowledgment */
-            OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-
-            /* Process the special command */
-            OPENBL_SPI_SpecialCommandProcess(special_cmd);
-
-            /* NOTE: In case of any operation inside "SpecialCommandProcess" function that prevents the code
-             * from returning to here (reset operation...), to be compatible with the OpenBL protocol,
-             * the user must ensure sending the last ACK in the application side.
-             */
-
-            /* Send last acknowledgment */
-            OPENBL_SPI_SendAcknowledgeByte(ACK_BYTE);
-          }
-        }
-      }
-    }
+    OPENBL_SPI_DisableBusyState();
   }
 }
 
-/* Private functions ---------------------------------------------------------*/
-
 /**
   * @brief  This function is used to construct the command list table.
   * @return Returns the number of supported commands.
@@ -971,69 +422,35 @@ static uint8_t OPENBL_SPI_ConstructCommandsTable(OPENBL_CommandsTypeDef *pSpiCmd
     i++;
   }
 
-  return (i);
-}
-
-/**
-  * @brief  This function is used to get the operation code.
-  * @param  OpCode Pointer to the operation code to be returned.
-  * @param  CmdType Type of the command, Special read or special write.
-  * @retval Returns NACK status in case of error else returns ACK status.
-  */
-static uint8_t OPENBL_SPI_GetSpecialCmdOpCode(uint16_t *OpCode, OPENBL_SpecialCmdTypeTypeDef CmdType)
-{
-  uint8_t op_code[2];
-  uint8_t xor;
-  uint8_t status;
-  uint8_t index;
-
-  /* Initialize the status variable */
-  status = NACK_BYTE;
-
-  /* Get the command OpCode (2 bytes) */
-  op_code[0] = OPENBL_SPI_ReadByte(); /* Read the MSB byte */
-  op_code[1] = OPENBL_SPI_ReadByte(); /* Read the LSB byte */
+  if (pSpiCmd->GetStatistics != NULL)
+  {
+    a_OPENBL_SPI_CommandsList[i] = CMD_GET_STATISTICS;
+    i++;
+  }
 
-  /* Get the checksum */
-  xor  = op_code[0];
-  xor ^= op_code[1];
+  if ((pSpiCmd->CommitMemory != NULL) && (OPENBL_STAGING_ENABLE == 1U))
+  {
+    a_OPENBL_SPI_CommandsList[i] = CMD_COMMIT_MEMORY;
+    i++;
+  }
 
-  if (OPENBL_SPI_ReadByte() != xor)
+  if ((pSpiCmd->CompressedWriteMemory != NULL) && (OPENBL_COMPRESSED_WRITE_ENABLE == 1U))
   {
-    status = NACK_BYTE;
+    a_OPENBL_SPI_CommandsList[i] = CMD_COMPRESSED_WRITE_MEMORY;
+    i++;
   }
-  else
+
+  if ((pSpiCmd->PatchMemory != NULL) && (OPENBL_PATCH_ENABLE == 1U))
   {
-    /* Get the operation code */
-    *OpCode = ((uint16_t)op_code[0] << 8) | (uint16_t)op_code[1];
+    a_OPENBL_SPI_CommandsList[i] = CMD_PATCH_MEMORY;
+    i++;
+  }
 
-    if (CmdType == OPENBL_SPECIAL_CMD)
-    {
-      for (index = 0U; index < SPECIAL_CMD_MAX_NUMBER; index++)
-      {
-        if (SpecialCmdList[index] == *OpCode)
-        {
-          status = ACK_BYTE;
-          break;
-        }
-      }
-    }
-    else if (CmdType == OPENBL_EXTENDED_SPECIAL_CMD)
-    {
-      for (index = 0U; index < EXTENDED_SPECIAL_CMD_MAX_NUMBER; index++)
-      {
-        if (ExtendedSpecialCmdList[index] == *OpCode)
-        {
-          status = ACK_BYTE;
-          break;
-        }
-      }
-    }
-    else
-    {
-      status = NACK_BYTE;
-    }
+  if ((pSpiCmd->GetBlockCrc != NULL) && (OPENBL_BLOCK_CRC_ENABLE == 1U))
+  {
+    a_OPENBL_SPI_CommandsList[i] = CMD_GET_BLOCK_CRC;
+    i++;
   }
 
-  return status;
+  return (i);
 }
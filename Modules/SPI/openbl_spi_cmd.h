@@ -49,6 +49,11 @@ void OPENBL_SPI_WriteProtect(void);
 void OPENBL_SPI_WriteUnprotect(void);
 void OPENBL_SPI_SpecialCommand(void);
 void OPENBL_SPI_ExtendedSpecialCommand(void);
+void OPENBL_SPI_GetStatistics(void);
+void OPENBL_SPI_CommitMemory(void);
+void OPENBL_SPI_CompressedWriteMemory(void);
+void OPENBL_SPI_PatchMemory(void);
+void OPENBL_SPI_GetBlockCrc(void);
 
 #ifdef __cplusplus
 }
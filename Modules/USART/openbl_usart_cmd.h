@@ -26,8 +26,12 @@ extern "C" {
 
 /* Includes ------------------------------------------------------------------*/
 #include "openbl_core.h"
+#include "openbl_engine.h"
 
 /* Exported types ------------------------------------------------------------*/
+/* Serial transport of the USART commands, see OPENBL_USART_SetTransport */
+typedef OPENBL_ENGINE_TransportTypeDef OPENBL_USART_TransportTypeDef;
+
 /* Exported constants --------------------------------------------------------*/
 #define OPENBL_USART_VERSION                 0x31U               /* Open Bootloader USART protocol V3.1 */
 
@@ -36,6 +40,7 @@ extern "C" {
 /* Exported functions ------------------------------------------------------- */
 OPENBL_CommandsTypeDef *OPENBL_USART_GetCommandsList(void);
 void OPENBL_USART_SetCommandsList(OPENBL_CommandsTypeDef *pUsartCmd);
+void OPENBL_USART_SetTransport(const OPENBL_USART_TransportTypeDef *pTransport);
 void OPENBL_USART_GetCommand(void);
 void OPENBL_USART_GetVersion(void);
 void OPENBL_USART_GetID(void);
@@ -49,6 +54,11 @@ void OPENBL_USART_WriteProtect(void);
 void OPENBL_USART_WriteUnprotect(void);
 void OPENBL_USART_SpecialCommand(void);
 void OPENBL_USART_ExtendedSpecialCommand(void);
+void OPENBL_USART_GetStatistics(void);
+void OPENBL_USART_CommitMemory(void);
+void OPENBL_USART_CompressedWriteMemory(void);
+void OPENBL_USART_PatchMemory(void);
+void OPENBL_USART_GetBlockCrc(void);
 
 #ifdef __cplusplus
 }
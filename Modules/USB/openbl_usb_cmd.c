@@ -24,14 +24,37 @@
 #include "common_interface.h"
 
 /* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint32_t Address;                        /* Destination address of the block */
+  uint32_t Length;                         /* Number of bytes of the block, 0 when the buffer is free */
+  uint8_t Data[OPENBL_USB_BLOCK_SIZE];     /* Block data */
+} OPENBL_USB_BlockTypeDef;
+
 /* Private define ------------------------------------------------------------*/
-#define USB_RAM_BUFFER_SIZE             20U  /* Size of USB buffer used to store received data from the host */
+#define USB_ERASE_BATCH_PAGES           32U  /* Maximum number of pages erased by one memory erase request */
+#define USB_RAM_BUFFER_SIZE             (2U + (2U * USB_ERASE_BATCH_PAGES)) /* Size of the erase request buffer */
+#define USB_BLOCKS_NUMBER               2U   /* Number of download buffers */
 
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
-/* Private macro -------------------------------------------------------------*/
-/* Private variables ---------------------------------------------------------*/
+/* Download buffers: one block is received while the previous one is programmed.
+   The queue is shared by the DFU thread and the USB stack callbacks, a block is claimed
+   (UsbBlockBusy) while it is programmed so that only one of them programs it */
+static OPENBL_USB_BlockTypeDef a_UsbBlocks[USB_BLOCKS_NUMBER];
+static volatile uint32_t UsbBlockToProgram = 0U;
+static volatile uint32_t UsbBlocksPending  = 0U;
+static volatile uint8_t UsbBlockBusy       = 0U;
+
+/* Erase-ahead: pages are erased as the download reaches them */
+static FunctionalState UsbEraseAhead = DISABLE;
+static uint32_t UsbErasedStart       = 0U;
+static uint32_t UsbErasedEnd         = 0U;
+
 /* Private function prototypes -----------------------------------------------*/
+static uint8_t OPENBL_USB_ProgramBlock(void);
+static ErrorStatus OPENBL_USB_ErasePages(uint32_t Address, uint32_t Length);
+static void OPENBL_USB_EraseAheadOf(uint32_t Address, uint32_t Length);
 
 /* Exported functions---------------------------------------------------------*/
 /**
@@ -41,33 +64,24 @@
   */
 uint16_t OPENBL_USB_EraseMemory(uint32_t Address)
 {
-  ErrorStatus error_value;
-  uint8_t status;
-  uint32_t numpage;
-  uint32_t page;
-  uint8_t usb_ram_buffer[USB_RAM_BUFFER_SIZE];
-  uint8_t *ramaddress;
-
-  ramaddress = (uint8_t *) usb_ram_buffer;
-  numpage = 1;
-
-  *ramaddress = (uint8_t)(numpage & 0x00FFU);
-  ramaddress++;
-
-  *ramaddress = (uint8_t)((numpage & 0xFF00U) >> 8);
-  ramaddress++;
-
-  page = OPENBL_USB_GetPage(Address);
-
-  *ramaddress = (uint8_t)(page & 0x00FFU);
-  ramaddress++;
+  return OPENBL_USB_EraseRange(Address, 1U);
+}
 
-  *ramaddress = (uint8_t)((page & 0xFF00U) >> 8);
-  ramaddress++;
+/**
+  * @brief  Erase all the pages that overlap a memory range.
+  *         The pages are erased by batches, whole banks are erased with a bank erase when supported.
+  * @param  Address: Start address of the range.
+  * @param  Length: Length of the range in bytes.
+  * @retval 0 if operation is successful, MAL_FAIL else.
+  */
+uint16_t OPENBL_USB_EraseRange(uint32_t Address, uint32_t Length)
+{
+  uint16_t status;
 
-  error_value = OPENBL_MEM_Erase(OPENBL_DEFAULT_MEM, (uint8_t *) usb_ram_buffer, USB_RAM_BUFFER_SIZE);
+  /* The queued blocks must be programmed before the erase */
+  OPENBL_USB_FlushWrites();
 
-  if (error_value != SUCCESS)
+  if (OPENBL_USB_ErasePages(Address, Length) != SUCCESS)
   {
     status = 1U;
   }
@@ -79,8 +93,28 @@ uint16_t OPENBL_USB_EraseMemory(uint32_t Address)
   return status;
 }
 
+/**
+  * @brief  Enable or disable the erase-ahead mode.
+  *         When enabled, the pages are erased just before the first block that targets them is programmed,
+  *         the host does not send any erase request. The download addresses must be increasing.
+  * @param  State: ENABLE or DISABLE.
+  * @retval None.
+  */
+void OPENBL_USB_SetEraseAhead(FunctionalState State)
+{
+  OPENBL_USB_FlushWrites();
+
+  UsbEraseAhead  = State;
+  UsbErasedStart = 0U;
+  UsbErasedEnd   = 0U;
+}
+
 /**
   * @brief  Memory write routine.
+  *         When OPENBL_USB_DEFERRED_WRITE is set, the block is queued and the function returns at once,
+  *         so that the next block can be received while this one is programmed by
+  *         OPENBL_USB_ProcessPendingWrite(). When both download buffers are in use, the oldest block
+  *         is programmed first.
   * @param  pSrc: Pointer to the source buffer. Address to be written to.
   * @param  pDest: Pointer to the destination buffer.
   * @param  Length: Number of data to be written (in bytes).
@@ -88,15 +122,94 @@ uint16_t OPENBL_USB_EraseMemory(uint32_t Address)
   */
 void OPENBL_USB_WriteMemory(uint8_t *pSrc, uint8_t *pDest, uint32_t Length)
 {
+  OPENBL_USB_BlockTypeDef *p_block;
   uint32_t address;
+  uint32_t index;
 
   address = (uint32_t)pDest[0] | ((uint32_t)pDest[1] << 8) |
             ((uint32_t)pDest[2] << 16) | ((uint32_t)pDest[3] << 24);
 
-  OPENBL_MEM_Write(address, pSrc, Length);
+  if ((OPENBL_USB_DEFERRED_WRITE == 0U) || (Length > OPENBL_USB_BLOCK_SIZE))
+  {
+    /* Program the block in place after the queued ones, if any */
+    OPENBL_USB_FlushWrites();
 
-  /* Start post processing task if needed */
-  Common_StartPostProcessing();
+    OPENBL_USB_EraseAheadOf(address, Length);
+    OPENBL_MEM_Write(address, pSrc, Length);
+
+    /* Start post processing task if needed */
+    Common_StartPostProcessing();
+  }
+  else
+  {
+    /* No free download buffer, program the oldest block */
+    while (UsbBlocksPending == USB_BLOCKS_NUMBER)
+    {
+      (void)OPENBL_USB_ProgramBlock();
+    }
+
+    /* The free buffer is only seen by the USB stack callbacks once the block is queued */
+    Common_DisableIrq();
+    p_block = &a_UsbBlocks[(UsbBlockToProgram + UsbBlocksPending) % USB_BLOCKS_NUMBER];
+    Common_EnableIrq();
+
+    for (index = 0U; index < Length; index++)
+    {
+      p_block->Data[index] = pSrc[index];
+    }
+
+    p_block->Address = address;
+    p_block->Length  = Length;
+
+    Common_DisableIrq();
+    UsbBlocksPending++;
+    Common_EnableIrq();
+  }
+}
+
+/**
+  * @brief  Program the oldest queued block, if any.
+  *         It is called from the DFU GETSTATUS request, see OPENBL_USB_DfuGetStatus().
+  * @retval Returns 1 if a block has been programmed else 0.
+  */
+uint8_t OPENBL_USB_ProcessPendingWrite(void)
+{
+  return OPENBL_USB_ProgramBlock();
+}
+
+/**
+  * @brief  Program all the queued blocks.
+  *         A block being programmed by the interrupted context is left to it.
+  * @retval None.
+  */
+void OPENBL_USB_FlushWrites(void)
+{
+  while (OPENBL_USB_ProgramBlock() != 0U)
+  {
+  }
+}
+
+/**
+  * @brief  Get the time needed to program the queued blocks.
+  *         It is meant to be reported as bwPollTimeout in the DFU GETSTATUS response.
+  * @retval The estimated time in milliseconds, 0 if there is no pending block.
+  */
+uint32_t OPENBL_USB_GetPollTimeout(void)
+{
+  uint32_t length = 0U;
+  uint32_t counter;
+
+  Common_DisableIrq();
+
+  for (counter = 0U; counter < UsbBlocksPending; counter++)
+  {
+    length += a_UsbBlocks[(UsbBlockToProgram + counter) % USB_BLOCKS_NUMBER].Length;
+  }
+
+  Common_EnableIrq();
+
+  /* Round up to the next millisecond */
+  return ((length * FLASH_PROGRAM_TIME_PER_KB) + 1023U) / 1024U;
 }
 
 /**
@@ -115,6 +228,9 @@ uint8_t *OPENBL_USB_ReadMemory(uint8_t *pSrc, uint8_t *pDest, uint32_t Length)
   address = (uint32_t)pSrc[0] | ((uint32_t)pSrc[1] << 8) |
             ((uint32_t)pSrc[2] << 16) | ((uint32_t)pSrc[3] << 24);
 
+  /* The data being read may still be in a download buffer */
+  OPENBL_USB_FlushWrites();
+
   memory_index = OPENBL_MEM_GetMemoryIndex(address);
 
   for (i = 0; i < Length; i++)
@@ -136,6 +252,8 @@ void OPENBL_USB_Jump(uint32_t Address)
 {
   uint8_t status;
 
+  OPENBL_USB_FlushWrites();
+
   /* Check if received address is valid or not */
   status = OPENBL_MEM_CheckJumpAddress(Address);
 
@@ -155,6 +273,8 @@ void OPENBL_USB_WriteProtect(uint8_t *pBuffer, uint32_t Length)
 {
   ErrorStatus error_value;
 
+  OPENBL_USB_FlushWrites();
+
   error_value = OPENBL_MEM_SetWriteProtection(ENABLE, OPENBL_DEFAULT_MEM, pBuffer, Length);
 
   if (error_value == SUCCESS)
@@ -172,6 +292,8 @@ void OPENBL_USB_WriteUnprotect(void)
 {
   ErrorStatus error_value;
 
+  OPENBL_USB_FlushWrites();
+
   error_value = OPENBL_MEM_SetWriteProtection(DISABLE, OPENBL_DEFAULT_MEM, NULL, 0U);
 
   if (error_value == SUCCESS)
@@ -187,6 +309,8 @@ void OPENBL_USB_WriteUnprotect(void)
   */
 void OPENBL_USB_ReadProtect(void)
 {
+  OPENBL_USB_FlushWrites();
+
   /* Enable the read protection */
   OPENBL_MEM_SetReadOutProtection(OPENBL_DEFAULT_MEM, ENABLE);
 
@@ -200,9 +324,180 @@ void OPENBL_USB_ReadProtect(void)
   */
 void OPENBL_USB_ReadUnprotect(void)
 {
+  OPENBL_USB_FlushWrites();
+
   /* Disable the read protection */
   OPENBL_MEM_SetReadOutProtection(OPENBL_DEFAULT_MEM, DISABLE);
 
   /* Start post processing task if needed */
   Common_StartPostProcessing();
 }
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Claim the oldest queued block, program it then release its download buffer.
+  *         The interrupts are only disabled while the queue is updated, not during the programming.
+  * @retval Returns 1 if a block has been programmed, 0 if there is no block or if it is claimed
+  *         by another context.
+  */
+static uint8_t OPENBL_USB_ProgramBlock(void)
+{
+  OPENBL_USB_BlockTypeDef *p_block = NULL;
+  uint8_t status = 0U;
+
+  Common_DisableIrq();
+
+  if ((UsbBlocksPending != 0U) && (UsbBlockBusy == 0U))
+  {
+    UsbBlockBusy = 1U;
+    p_block      = &a_UsbBlocks[UsbBlockToProgram];
+  }
+
+  Common_EnableIrq();
+
+  if (p_block != NULL)
+  {
+    OPENBL_USB_EraseAheadOf(p_block->Address, p_block->Length);
+    OPENBL_MEM_Write(p_block->Address, p_block->Data, p_block->Length);
+
+    Common_DisableIrq();
+
+    p_block->Length   = 0U;
+    UsbBlockToProgram = (UsbBlockToProgram + 1U) % USB_BLOCKS_NUMBER;
+    UsbBlocksPending--;
+    UsbBlockBusy      = 0U;
+
+    Common_EnableIrq();
+
+    /* Start post processing task if needed */
+    Common_StartPostProcessing();
+
+    status = 1U;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Erase all the pages that overlap a memory range, using the geometry of the memory layer.
+  *         Banks fully covered by the range are erased with a bank erase, falling back to page erase
+  *         if the memory does not support it. The remaining pages are erased by batches.
+  * @param  Address: Start address of the range.
+  * @param  Length: Length of the range in bytes.
+  * @retval SUCCESS if all the pages have been erased else ERROR.
+  */
+static ErrorStatus OPENBL_USB_ErasePages(uint32_t Address, uint32_t Length)
+{
+  ErrorStatus status = SUCCESS;
+  uint32_t page_size;
+  uint32_t pages_per_bank = 0U;
+  uint32_t page;
+  uint32_t last_page;
+  uint32_t count;
+  uint16_t bank_option;
+  uint8_t bank_erased;
+  uint8_t usb_ram_buffer[USB_RAM_BUFFER_SIZE];
+
+  page_size = OPENBL_MEM_GetPageSize(Address);
+
+  if ((page_size == 0U) || (Length == 0U)
+      || (OPENBL_MEM_GetAddressArea(Address + Length - 1U) == AREA_ERROR))
+  {
+    status = ERROR;
+  }
+  else
+  {
+    if (OPENBL_MEM_GetBankSize(Address) != 0U)
+    {
+      pages_per_bank = OPENBL_MEM_GetBankSize(Address) / page_size;
+    }
+
+    page      = OPENBL_MEM_GetPage(Address);
+    last_page = OPENBL_MEM_GetPage(Address + Length - 1U);
+
+    while (page <= last_page)
+    {
+      bank_erased = 0U;
+
+      /* Use a bank erase when the range covers a whole bank (only two banks can be selected) */
+      if ((pages_per_bank != 0U) && ((page % pages_per_bank) == 0U)
+          && ((last_page - page + 1U) >= pages_per_bank) && ((page / pages_per_bank) < 2U))
+      {
+        bank_option       = ((page / pages_per_bank) == 0U) ? FLASH_BANK1_ERASE : FLASH_BANK2_ERASE;
+        usb_ram_buffer[0] = (uint8_t)(bank_option & 0x00FFU);
+        usb_ram_buffer[1] = (uint8_t)((bank_option & 0xFF00U) >> 8);
+
+        if (OPENBL_MEM_MassErase(Address, usb_ram_buffer, 2U) == SUCCESS)
+        {
+          page += pages_per_bank;
+          bank_erased = 1U;
+        }
+      }
+
+      if (bank_erased == 0U)
+      {
+        /* Erase a batch of pages, without crossing a bank boundary so that banks stay eligible to bank erase */
+        count = 0U;
+
+        do
+        {
+          usb_ram_buffer[2U + (2U * count)] = (uint8_t)(page & 0x00FFU);
+          usb_ram_buffer[3U + (2U * count)] = (uint8_t)((page & 0xFF00U) >> 8);
+
+          count++;
+          page++;
+        } while ((page <= last_page) && (count < USB_ERASE_BATCH_PAGES)
+                 && ((pages_per_bank == 0U) || ((page % pages_per_bank) != 0U)));
+
+        usb_ram_buffer[0] = (uint8_t)(count & 0x00FFU);
+        usb_ram_buffer[1] = (uint8_t)((count & 0xFF00U) >> 8);
+
+        if (OPENBL_MEM_Erase(Address, usb_ram_buffer, 2U + (2U * count)) != SUCCESS)
+        {
+          status = ERROR;
+        }
+      }
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  In erase-ahead mode, erase the pages of a block that have not been erased yet.
+  *         The erased window grows with the download, a block outside of it starts a new window.
+  * @param  Address: Address of the block.
+  * @param  Length: Length of the block in bytes.
+  * @retval None.
+  */
+static void OPENBL_USB_EraseAheadOf(uint32_t Address, uint32_t Length)
+{
+  uint32_t page_size;
+  uint32_t end;
+
+  page_size = OPENBL_MEM_GetPageSize(Address);
+
+  if ((UsbEraseAhead == ENABLE) && (page_size != 0U) && (Length != 0U))
+  {
+    /* Flash pages are aligned on their size */
+    end = (((Address + Length) + page_size - 1U) / page_size) * page_size;
+
+    if ((Address >= UsbErasedStart) && (Address <= UsbErasedEnd) && (UsbErasedEnd != 0U))
+    {
+      /* Contiguous block: only erase the pages beyond the erased window */
+      if (end > UsbErasedEnd)
+      {
+        (void)OPENBL_USB_ErasePages(UsbErasedEnd, end - UsbErasedEnd);
+        UsbErasedEnd = end;
+      }
+    }
+    else
+    {
+      UsbErasedStart = (Address / page_size) * page_size;
+      UsbErasedEnd   = end;
+
+      (void)OPENBL_USB_ErasePages(UsbErasedStart, UsbErasedEnd - UsbErasedStart);
+    }
+  }
+}
@@ -26,8 +26,16 @@ extern "C" {
 /* Includes ------------------------------------------------------------------*/
 #include "openbl_core.h"
 
+/* Exported constants --------------------------------------------------------*/
+#define OPENBL_USB_BLOCK_SIZE             1024U  /* Size of a DFU download block, the DFU transfer size */
+
 uint16_t OPENBL_USB_EraseMemory(uint32_t Add);
+uint16_t OPENBL_USB_EraseRange(uint32_t Address, uint32_t Length);
+void OPENBL_USB_SetEraseAhead(FunctionalState State);
 void OPENBL_USB_WriteMemory(uint8_t *pSrc, uint8_t *pDest, uint32_t Length);
+uint8_t OPENBL_USB_ProcessPendingWrite(void);
+void OPENBL_USB_FlushWrites(void);
+uint32_t OPENBL_USB_GetPollTimeout(void);
 uint8_t *OPENBL_USB_ReadMemory(uint8_t *pSrc, uint8_t *pDest, uint32_t Length);
 void OPENBL_USB_Jump(uint32_t Address);
 void OPENBL_USB_WriteProtect(uint8_t *pBuffer, uint32_t Length);
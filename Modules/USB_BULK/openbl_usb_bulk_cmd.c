@@ -0,0 +1,620 @@
+/**
+  ******************************************************************************
+  * @file    openbl_usb_bulk_cmd.c
+  * @author  MCD Application Team
+  * @brief   Contains USB bulk vendor protocol commands
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "openbl_mem.h"
+#include "openbl_usb_bulk_cmd.h"
+#include "openbl_engine.h"
+
+#include "openbootloader_conf.h"
+#include "app_openbootloader.h"
+#include "usb_bulk_interface.h"
+#include "common_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define OPENBL_USB_BULK_COMMANDS_NB_MAX   20U       /* The maximum number of supported commands */
+
+#define USB_BULK_RAM_BUFFER_SIZE          4096U     /* Size of USB bulk buffer used to store received data from the host */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void OPENBL_USB_BULK_SendAck(uint8_t Ack);
+static uint8_t OPENBL_USB_BULK_GetExtendedSize(uint32_t Address, uint32_t *Size);
+static uint8_t OPENBL_USB_BULK_ConstructCommandsTable(OPENBL_CommandsTypeDef *pUsbBulkCmd);
+
+/* Private variables ---------------------------------------------------------*/
+/* Block transport of the USB bulk interface, the frames are moved in bulk transfers */
+static const OPENBL_ENGINE_TransportTypeDef UsbBulkTransport =
+{
+  OPENBL_USB_BULK_ReadBytes,
+  OPENBL_USB_BULK_SendBytes,
+  OPENBL_USB_BULK_SendAck,
+  NULL,
+  OPENBL_USB_BULK_SpecialCommandProcess,
+  NULL
+};
+
+static uint8_t a_OPENBL_USB_BULK_CommandsList[OPENBL_USB_BULK_COMMANDS_NB_MAX] = {0U};
+
+/* The USB bulk commands are run by the command engine, with the USART protocol framing */
+static OPENBL_ENGINE_HandleTypeDef UsbBulkHandle =
+{
+  &UsbBulkTransport,
+  NULL,
+  USB_BULK_RAM_BUFFER_SIZE,
+  a_OPENBL_USB_BULK_CommandsList,
+  0U,
+  OPENBL_USB_BULK_VERSION,
+  OPENBL_ENGINE_FRAMING_VERSION_OPTIONS
+};
+
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to get a pointer to the structure that contains the available USB bulk commands.
+  * @return Returns a pointer to the OPENBL_USB_BULK_Commands struct.
+  */
+OPENBL_CommandsTypeDef *OPENBL_USB_BULK_GetCommandsList(void)
+{
+  static OPENBL_CommandsTypeDef OPENBL_USB_BULK_Commands =
+  {
+    OPENBL_USB_BULK_GetCommand,
+    OPENBL_USB_BULK_GetVersion,
+    OPENBL_USB_BULK_GetID,
+    OPENBL_USB_BULK_ReadMemory,
+    OPENBL_USB_BULK_WriteMemory,
+    OPENBL_USB_BULK_Go,
+    OPENBL_USB_BULK_ReadoutProtect,
+    OPENBL_USB_BULK_ReadoutUnprotect,
+    OPENBL_USB_BULK_EraseMemory,
+    OPENBL_USB_BULK_WriteProtect,
+    OPENBL_USB_BULK_WriteUnprotect,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    OPENBL_USB_BULK_SpecialCommand,
+    OPENBL_USB_BULK_ExtendedSpecialCommand,
+    OPENBL_USB_BULK_ExtendedReadMemory,
+    OPENBL_USB_BULK_ExtendedWriteMemory,
+    NULL,
+    OPENBL_USB_BULK_GetStatistics,
+    OPENBL_USB_BULK_CommitMemory,
+    OPENBL_USB_BULK_CompressedWriteMemory,
+    OPENBL_USB_BULK_PatchMemory,
+    OPENBL_USB_BULK_GetBlockCrc
+  };
+
+  /* The command buffer is taken from the arena shared by all the interfaces */
+  UsbBulkHandle.pBuffer = OPENBL_GetBuffer(USB_BULK_RAM_BUFFER_SIZE);
+
+  OPENBL_USB_BULK_SetCommandsList(&OPENBL_USB_BULK_Commands);
+
+  return (&OPENBL_USB_BULK_Commands);
+}
+
+/**
+  * @brief  This function is used to set the list of USB bulk supported commands.
+  * @return None.
+  */
+void OPENBL_USB_BULK_SetCommandsList(OPENBL_CommandsTypeDef *pUsbBulkCmd)
+{
+  UsbBulkHandle.CommandsNumber = OPENBL_USB_BULK_ConstructCommandsTable(pUsbBulkCmd);
+}
+
+/**
+  * @brief  This function is used to get the list of the available USB bulk commands.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_GetCommand(void)
+{
+  OPENBL_ENGINE_GetCommand(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to get the USB bulk protocol version.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_GetVersion(void)
+{
+  OPENBL_ENGINE_GetVersion(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to get the device ID.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_GetID(void)
+{
+  OPENBL_ENGINE_GetID(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to read memory from the device.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_ReadMemory(void)
+{
+  OPENBL_ENGINE_ReadMemory(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to write in to device memory.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_WriteMemory(void)
+{
+  OPENBL_ENGINE_WriteMemory(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to jump to the user application.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_Go(void)
+{
+  OPENBL_ENGINE_Go(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to enable readout protection.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_ReadoutProtect(void)
+{
+  OPENBL_ENGINE_ReadoutProtect(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to disable readout protection.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_ReadoutUnprotect(void)
+{
+  OPENBL_ENGINE_ReadoutUnprotect(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to erase a memory.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_EraseMemory(void)
+{
+  OPENBL_ENGINE_EraseMemory(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to enable write protect.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_WriteProtect(void)
+{
+  OPENBL_ENGINE_WriteProtect(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to disable write protect.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_WriteUnprotect(void)
+{
+  OPENBL_ENGINE_WriteUnprotect(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to execute special command commands.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_SpecialCommand(void)
+{
+  OPENBL_ENGINE_SpecialCommand(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to execute extended special command commands.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_ExtendedSpecialCommand(void)
+{
+  OPENBL_ENGINE_ExtendedSpecialCommand(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to read memory from the device using a 32-bit length.
+  *         The host sends the address then the size (4 bytes MSB first + XOR checksum),
+  *         the data is sent back in bulk transfers of up to USB_BULK_RAM_BUFFER_SIZE bytes.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_ExtendedReadMemory(void)
+{
+  uint32_t address;
+  uint32_t number_of_bytes;
+  uint32_t memory_index;
+  uint32_t frame_length;
+  uint32_t counter;
+
+  /* Check memory protection then send adequate response */
+  if (Common_GetProtectionStatus() != RESET)
+  {
+    OPENBL_USB_BULK_SendAck(NACK_BYTE);
+  }
+  else
+  {
+    OPENBL_USB_BULK_SendAck(ACK_BYTE);
+
+    /* Get the memory address */
+    if (OPENBL_ENGINE_GetAddress(&UsbBulkHandle, &address) == NACK_BYTE)
+    {
+      OPENBL_USB_BULK_SendAck(NACK_BYTE);
+    }
+    else
+    {
+      OPENBL_USB_BULK_SendAck(ACK_BYTE);
+
+      /* Get the number of bytes to be read */
+      if (OPENBL_USB_BULK_GetExtendedSize(address, &number_of_bytes) == NACK_BYTE)
+      {
+        OPENBL_USB_BULK_SendAck(NACK_BYTE);
+      }
+      else
+      {
+        OPENBL_USB_BULK_SendAck(ACK_BYTE);
+
+        /* Get the memory index to know from which memory we will read */
+        memory_index = OPENBL_MEM_GetMemoryIndex(address);
+
+        while (number_of_bytes != 0U)
+        {
+          frame_length = (number_of_bytes > USB_BULK_RAM_BUFFER_SIZE) ? USB_BULK_RAM_BUFFER_SIZE : number_of_bytes;
+
+          for (counter = 0U; counter < frame_length; counter++)
+          {
+            UsbBulkHandle.pBuffer[counter] = OPENBL_MEM_Read(address, memory_index);
+            address++;
+          }
+
+          OPENBL_USB_BULK_SendBytes(UsbBulkHandle.pBuffer, frame_length);
+
+          number_of_bytes -= frame_length;
+        }
+      }
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to write in to device memory using a 32-bit length.
+  *         The host sends the address then the size (4 bytes MSB first + XOR checksum), then the data
+  *         in blocks of USB_BULK_RAM_BUFFER_SIZE bytes (the last one may be shorter), each followed by
+  *         its XOR checksum. Each block is acknowledged once written. As the reception ring buffer holds
+  *         two blocks, the host can stream the next block without waiting for the acknowledgment,
+  *         the reception then overlaps the programming of the previous block.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_ExtendedWriteMemory(void)
+{
+  uint32_t address;
+  uint32_t code_size;
+  uint32_t block_size;
+  uint32_t counter;
+  uint8_t xor;
+  uint8_t status = ACK_BYTE;
+
+  /* Check memory protection then send adequate response */
+  if (Common_GetProtectionStatus() != RESET)
+  {
+    OPENBL_USB_BULK_SendAck(NACK_BYTE);
+  }
+  else
+  {
+    OPENBL_USB_BULK_SendAck(ACK_BYTE);
+
+    /* Get the memory address */
+    if (OPENBL_ENGINE_GetAddress(&UsbBulkHandle, &address) == NACK_BYTE)
+    {
+      OPENBL_USB_BULK_SendAck(NACK_BYTE);
+    }
+    else
+    {
+      OPENBL_USB_BULK_SendAck(ACK_BYTE);
+
+      /* Get the number of bytes to be written */
+      if (OPENBL_USB_BULK_GetExtendedSize(address, &code_size) == NACK_BYTE)
+      {
+        OPENBL_USB_BULK_SendAck(NACK_BYTE);
+      }
+      else
+      {
+        OPENBL_USB_BULK_SendAck(ACK_BYTE);
+
+        while ((code_size != 0U) && (status == ACK_BYTE))
+        {
+          block_size = (code_size > USB_BULK_RAM_BUFFER_SIZE) ? USB_BULK_RAM_BUFFER_SIZE : code_size;
+
+          /* Receive the block in the RAM Buffer then compute the checksum */
+          OPENBL_USB_BULK_ReadBytes(UsbBulkHandle.pBuffer, block_size);
+
+          xor = 0U;
+
+          for (counter = 0U; counter < block_size; counter++)
+          {
+            xor ^= UsbBulkHandle.pBuffer[counter];
+          }
+
+          /* The transfer is aborted on a checksum error */
+          if (OPENBL_USB_BULK_ReadByte() != xor)
+          {
+            status = NACK_BYTE;
+          }
+          else
+          {
+            /* Write the block to memory */
+            OPENBL_MEM_Write(address, UsbBulkHandle.pBuffer, block_size);
+
+            address   += block_size;
+            code_size -= block_size;
+          }
+
+          /* Acknowledge the block, the last one is the synchronization byte of the command */
+          OPENBL_USB_BULK_SendAck(status);
+        }
+
+        if (status == ACK_BYTE)
+        {
+          /* Start post processing task if needed */
+          Common_StartPostProcessing();
+        }
+      }
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to send the statistics recorded by the Open Bootloader.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_GetStatistics(void)
+{
+  OPENBL_ENGINE_GetStatistics(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to program in the Flash an image staged in RAM.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_CommitMemory(void)
+{
+  OPENBL_ENGINE_CommitMemory(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to write in to device memory data compressed in the LZ4 block format.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_CompressedWriteMemory(void)
+{
+  OPENBL_ENGINE_CompressedWriteMemory(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to write in to device memory a new image built by a delta patch.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_PatchMemory(void)
+{
+  OPENBL_ENGINE_PatchMemory(&UsbBulkHandle);
+}
+
+/**
+  * @brief  This function is used to send the CRC-32 of consecutive memory blocks.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_GetBlockCrc(void)
+{
+  OPENBL_ENGINE_GetBlockCrc(&UsbBulkHandle);
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to send an acknowledge byte.
+  *         The buffered bytes are sent at once, as the host waits for the acknowledge and as the device
+  *         may jump to the application or reload the option bytes right after it.
+  * @param  Ack ACK_BYTE or NACK_BYTE.
+  * @retval None.
+  */
+static void OPENBL_USB_BULK_SendAck(uint8_t Ack)
+{
+  OPENBL_USB_BULK_SendByte(Ack);
+  OPENBL_USB_BULK_Flush();
+}
+
+/**
+  * @brief  This function is used to get the size of an extended memory operation.
+  *         The size is received on 4 bytes MSB first followed by their XOR checksum.
+  * @param  Address The start address of the operation.
+  * @param  Size Pointer to the size to be returned.
+  * @retval Returns NACK status in case of error else returns ACK status.
+  */
+static uint8_t OPENBL_USB_BULK_GetExtendedSize(uint32_t Address, uint32_t *Size)
+{
+  uint8_t data[5];
+  uint8_t status;
+
+  OPENBL_USB_BULK_ReadBytes(data, 5U);
+
+  /* Check the integrity of received data */
+  if (data[4] != (data[0] ^ data[1] ^ data[2] ^ data[3]))
+  {
+    status = NACK_BYTE;
+  }
+  else
+  {
+    *Size = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+
+    /* The whole region must be valid and must not wrap around the address space */
+    if ((*Size == 0U)
+        || ((Address + *Size - 1U) < Address)
+        || (OPENBL_MEM_GetAddressArea(Address + *Size - 1U) == AREA_ERROR))
+    {
+      status = NACK_BYTE;
+    }
+    else
+    {
+      status = ACK_BYTE;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to construct the command list table.
+  * @return Returns the number of supported commands.
+  */
+static uint8_t OPENBL_USB_BULK_ConstructCommandsTable(OPENBL_CommandsTypeDef *pUsbBulkCmd)
+{
+  uint8_t i = 0U;
+
+  if (pUsbBulkCmd->GetCommand != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_GET_COMMAND;
+    i++;
+  }
+
+  if (pUsbBulkCmd->GetVersion != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_GET_VERSION;
+    i++;
+  }
+
+  if (pUsbBulkCmd->GetID != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_GET_ID;
+    i++;
+  }
+
+  if (pUsbBulkCmd->ReadMemory != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_READ_MEMORY;
+    i++;
+  }
+
+  if (pUsbBulkCmd->Go != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_GO;
+    i++;
+  }
+
+  if (pUsbBulkCmd->WriteMemory != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_WRITE_MEMORY;
+    i++;
+  }
+
+  if (pUsbBulkCmd->EraseMemory != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_EXT_ERASE_MEMORY;
+    i++;
+  }
+
+  if (pUsbBulkCmd->WriteProtect != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_WRITE_PROTECT;
+    i++;
+  }
+
+  if (pUsbBulkCmd->WriteUnprotect != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_WRITE_UNPROTECT;
+    i++;
+  }
+
+  if (pUsbBulkCmd->ReadoutProtect != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_READ_PROTECT;
+    i++;
+  }
+
+  if (pUsbBulkCmd->ReadoutUnprotect != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_READ_UNPROTECT;
+    i++;
+  }
+
+  if (pUsbBulkCmd->SpecialCommand != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_SPECIAL_COMMAND;
+    i++;
+  }
+
+  if (pUsbBulkCmd->ExtendedSpecialCommand != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_EXTENDED_SPECIAL_COMMAND;
+    i++;
+  }
+
+  if (pUsbBulkCmd->ExtendedReadMemory != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_EXT_READ_MEMORY;
+    i++;
+  }
+
+  if (pUsbBulkCmd->ExtendedWriteMemory != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_EXT_WRITE_MEMORY;
+    i++;
+  }
+
+  if (pUsbBulkCmd->GetStatistics != NULL)
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_GET_STATISTICS;
+    i++;
+  }
+
+  if ((pUsbBulkCmd->CommitMemory != NULL) && (OPENBL_STAGING_ENABLE == 1U))
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_COMMIT_MEMORY;
+    i++;
+  }
+
+  if ((pUsbBulkCmd->CompressedWriteMemory != NULL) && (OPENBL_COMPRESSED_WRITE_ENABLE == 1U))
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_COMPRESSED_WRITE_MEMORY;
+    i++;
+  }
+
+  if ((pUsbBulkCmd->PatchMemory != NULL) && (OPENBL_PATCH_ENABLE == 1U))
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_PATCH_MEMORY;
+    i++;
+  }
+
+  if ((pUsbBulkCmd->GetBlockCrc != NULL) && (OPENBL_BLOCK_CRC_ENABLE == 1U))
+  {
+    a_OPENBL_USB_BULK_CommandsList[i] = CMD_GET_BLOCK_CRC;
+    i++;
+  }
+
+  return (i);
+}
@@ -0,0 +1,65 @@
+/**
+  ******************************************************************************
+  * @file    openbl_usb_bulk_cmd.h
+  * @author  MCD Application Team
+  * @brief   Header for openbl_usb_bulk_cmd.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OPENBL_USB_BULK_CMD_H
+#define OPENBL_USB_BULK_CMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "openbl_core.h"
+#include "openbl_engine.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+#define OPENBL_USB_BULK_VERSION              0x10U               /* Open Bootloader USB bulk protocol V1.0 */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+OPENBL_CommandsTypeDef *OPENBL_USB_BULK_GetCommandsList(void);
+void OPENBL_USB_BULK_SetCommandsList(OPENBL_CommandsTypeDef *pUsbBulkCmd);
+void OPENBL_USB_BULK_GetCommand(void);
+void OPENBL_USB_BULK_GetVersion(void);
+void OPENBL_USB_BULK_GetID(void);
+void OPENBL_USB_BULK_ReadMemory(void);
+void OPENBL_USB_BULK_WriteMemory(void);
+void OPENBL_USB_BULK_Go(void);
+void OPENBL_USB_BULK_ReadoutProtect(void);
+void OPENBL_USB_BULK_ReadoutUnprotect(void);
+void OPENBL_USB_BULK_EraseMemory(void);
+void OPENBL_USB_BULK_WriteProtect(void);
+void OPENBL_USB_BULK_WriteUnprotect(void);
+void OPENBL_USB_BULK_SpecialCommand(void);
+void OPENBL_USB_BULK_ExtendedSpecialCommand(void);
+void OPENBL_USB_BULK_ExtendedReadMemory(void);
+void OPENBL_USB_BULK_ExtendedWriteMemory(void);
+void OPENBL_USB_BULK_GetStatistics(void);
+void OPENBL_USB_BULK_CommitMemory(void);
+void OPENBL_USB_BULK_CompressedWriteMemory(void);
+void OPENBL_USB_BULK_PatchMemory(void);
+void OPENBL_USB_BULK_GetBlockCrc(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* OPENBL_USB_BULK_CMD_H */
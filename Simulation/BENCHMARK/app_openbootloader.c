@@ -0,0 +1,227 @@
+/**
+  ******************************************************************************
+  * @file    app_openbootloader.c
+  * @author  MCD Application Team
+  * @brief   Open Bootloader application of the benchmark, all the interfaces run over simulated links
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "openbl_core.h"
+#include "openbl_mem.h"
+#include "openbl_usart_cmd.h"
+#include "openbl_i2c_cmd.h"
+#include "openbl_spi_cmd.h"
+#include "openbl_can_cmd.h"
+#include "openbl_fdcan_cmd.h"
+#include "openbl_i3c_cmd.h"
+#include "openbl_usb_bulk_cmd.h"
+#include "app_openbootloader.h"
+#include "usart_interface.h"
+#include "i2c_interface.h"
+#include "spi_interface.h"
+#include "can_interface.h"
+#include "fdcan_interface.h"
+#include "i3c_interface.h"
+#include "usb_bulk_interface.h"
+#include "flash_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static OPENBL_HandleTypeDef USART_Handle;
+static OPENBL_HandleTypeDef I2C_Handle;
+static OPENBL_HandleTypeDef SPI_Handle;
+static OPENBL_HandleTypeDef CAN_Handle;
+static OPENBL_HandleTypeDef FDCAN_Handle;
+static OPENBL_HandleTypeDef I3C_Handle;
+static OPENBL_HandleTypeDef USB_BULK_Handle;
+
+static OPENBL_OpsTypeDef USART_Ops =
+{
+  OPENBL_USART_Configuration,
+  OPENBL_USART_DeInit,
+  OPENBL_USART_ProtocolDetection,
+  OPENBL_USART_GetCommandOpcode,
+  OPENBL_USART_SendByte,
+  NULL,
+  NULL
+};
+
+static OPENBL_OpsTypeDef I2C_Ops =
+{
+  OPENBL_I2C_Configuration,
+  OPENBL_I2C_DeInit,
+  OPENBL_I2C_ProtocolDetection,
+  OPENBL_I2C_GetCommandOpcode,
+  OPENBL_I2C_SendAcknowledgeByte,
+  NULL,
+  NULL
+};
+
+static OPENBL_OpsTypeDef SPI_Ops =
+{
+  OPENBL_SPI_Configuration,
+  OPENBL_SPI_DeInit,
+  OPENBL_SPI_ProtocolDetection,
+  OPENBL_SPI_GetCommandOpcode,
+  OPENBL_SPI_SendAcknowledgeByte,
+  NULL,
+  NULL
+};
+
+static OPENBL_OpsTypeDef CAN_Ops =
+{
+  OPENBL_CAN_Configuration,
+  OPENBL_CAN_DeInit,
+  OPENBL_CAN_ProtocolDetection,
+  OPENBL_CAN_GetCommandOpcode,
+  OPENBL_CAN_SendByte,
+  NULL,
+  NULL
+};
+
+static OPENBL_OpsTypeDef FDCAN_Ops =
+{
+  OPENBL_FDCAN_Configuration,
+  OPENBL_FDCAN_DeInit,
+  OPENBL_FDCAN_ProtocolDetection,
+  OPENBL_FDCAN_GetCommandOpcode,
+  OPENBL_FDCAN_SendByte,
+  NULL,
+  NULL
+};
+
+static OPENBL_OpsTypeDef I3C_Ops =
+{
+  OPENBL_I3C_Configuration,
+  OPENBL_I3C_DeInit,
+  OPENBL_I3C_ProtocolDetection,
+  OPENBL_I3C_GetCommandOpcode,
+  OPENBL_I3C_SendAcknowledgeByte,
+  NULL,
+  NULL
+};
+
+static OPENBL_OpsTypeDef USB_BULK_Ops =
+{
+  OPENBL_USB_BULK_Configuration,
+  OPENBL_USB_BULK_DeInit,
+  OPENBL_USB_BULK_ProtocolDetection,
+  OPENBL_USB_BULK_GetCommandOpcode,
+  OPENBL_USB_BULK_SendByte,
+  NULL,
+  NULL
+};
+
+/* Exported variables --------------------------------------------------------*/
+extern OPENBL_MemoryTypeDef FLASH_Descriptor;
+extern OPENBL_MemoryTypeDef RAM_Descriptor;
+extern OPENBL_MemoryTypeDef OB_Descriptor;
+
+uint16_t SpecialCmdList[SPECIAL_CMD_MAX_NUMBER] =
+{
+  SPECIAL_CMD_DEFAULT
+};
+
+uint16_t ExtendedSpecialCmdList[EXTENDED_SPECIAL_CMD_MAX_NUMBER] =
+{
+  EXTENDED_SPECIAL_CMD_DEFAULT
+};
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Initialize open Bootloader.
+  * @retval None.
+  */
+void OpenBootloader_Init(void)
+{
+  /* Register USART interfaces */
+  USART_Handle.p_Ops = &USART_Ops;
+  USART_Handle.p_Cmd = OPENBL_USART_GetCommandsList();
+
+  (void)OPENBL_RegisterInterface(&USART_Handle);
+
+  /* Register I2C interfaces */
+  I2C_Handle.p_Ops = &I2C_Ops;
+  I2C_Handle.p_Cmd = OPENBL_I2C_GetCommandsList();
+
+  (void)OPENBL_RegisterInterface(&I2C_Handle);
+
+  /* Register SPI interfaces */
+  SPI_Handle.p_Ops = &SPI_Ops;
+  SPI_Handle.p_Cmd = OPENBL_SPI_GetCommandsList();
+
+  (void)OPENBL_RegisterInterface(&SPI_Handle);
+
+  /* Register CAN interfaces */
+  CAN_Handle.p_Ops = &CAN_Ops;
+  CAN_Handle.p_Cmd = OPENBL_CAN_GetCommandsList();
+
+  (void)OPENBL_RegisterInterface(&CAN_Handle);
+
+  /* Register FDCAN interfaces */
+  FDCAN_Handle.p_Ops = &FDCAN_Ops;
+  FDCAN_Handle.p_Cmd = OPENBL_FDCAN_GetCommandsList();
+
+  (void)OPENBL_RegisterInterface(&FDCAN_Handle);
+
+  /* Register I3C interfaces */
+  I3C_Handle.p_Ops = &I3C_Ops;
+  I3C_Handle.p_Cmd = OPENBL_I3C_GetCommandsList();
+
+  (void)OPENBL_RegisterInterface(&I3C_Handle);
+
+  /* Register USB bulk interfaces */
+  USB_BULK_Handle.p_Ops = &USB_BULK_Ops;
+  USB_BULK_Handle.p_Cmd = OPENBL_USB_BULK_GetCommandsList();
+
+  (void)OPENBL_RegisterInterface(&USB_BULK_Handle);
+
+  /* Initialize interfaces */
+  OPENBL_Init();
+
+  /* Register memories */
+  (void)OPENBL_MEM_RegisterMemory(&FLASH_Descriptor);
+  (void)OPENBL_MEM_RegisterMemory(&RAM_Descriptor);
+  (void)OPENBL_MEM_RegisterMemory(&OB_Descriptor);
+}
+
+/**
+  * @brief  DeInitialize open Bootloader.
+  * @retval None.
+  */
+void OpenBootloader_DeInit(void)
+{
+  OPENBL_InterfacesDeInit();
+
+  OPENBL_FLASH_Close();
+}
+
+/**
+  * @brief  This function is used to execute one command on the interface used by the host.
+  *         The benchmark switches between the interfaces, so the detection is done for each command.
+  * @retval None.
+  */
+void OpenBootloader_ProtocolDetection(void)
+{
+  if (OPENBL_InterfaceDetection() == 1U)
+  {
+    OPENBL_CommandProcess();
+  }
+}
@@ -0,0 +1,361 @@
+/**
+  ******************************************************************************
+  * @file    bench.c
+  * @author  MCD Application Team
+  * @brief   Main program of the protocol throughput benchmark
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbootloader_conf.h"
+#include "common_interface.h"
+#include "app_openbootloader.h"
+#include "flash_interface.h"
+#include "bench_link.h"
+#include "bench_host.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  uint32_t Commands;
+  uint64_t Bytes;
+  uint32_t RoundTrips;
+  uint64_t LinkTime;
+  uint64_t Time;
+  uint64_t CpuTime;
+} BENCH_SnapshotTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define BENCH_FLASH_FILE                  "/tmp/openbl_bench_XXXXXX"  /* Template of the temporary Flash file */
+#define BENCH_VERSION_LOOPS               100U      /* Get Version commands measuring the command latency */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint8_t ShowCpuTime = 1U;
+static uint32_t PageSize = SIM_FLASH_PAGE_SIZE;
+
+/* Private function prototypes -----------------------------------------------*/
+static void Usage(const char *pName);
+static void BENCH_Snapshot(const BENCH_TransportTypeDef *pTransport, BENCH_SnapshotTypeDef *pSnapshot);
+static void BENCH_Report(const BENCH_TransportTypeDef *pTransport, const char *pJob, uint64_t Length,
+                         const BENCH_SnapshotTypeDef *pStart);
+static void BENCH_FillImage(uint8_t *pImage, uint32_t Length);
+static ErrorStatus BENCH_Transport(const BENCH_TransportTypeDef *pTransport, const uint8_t *pImage, uint8_t *pReadBack);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Print the command line options.
+  * @param  pName The program name.
+  * @retval None.
+  */
+static void Usage(const char *pName)
+{
+  (void)fprintf(stderr,
+                "Usage: %s [options]\n"
+                "  -p size   Flash page size in bytes (default %u)\n"
+                "  -e time   Page erase time in us (default %u)\n"
+                "  -w time   Programming time of %u bytes in us (default %u)\n"
+                "  -n        Do not report the host CPU time, the report is then reproducible\n",
+                pName, SIM_FLASH_PAGE_SIZE, SIM_FLASH_ERASE_TIME, SIM_FLASH_PROGRAM_UNIT, SIM_FLASH_PROGRAM_TIME);
+}
+
+/**
+  * @brief  Take a snapshot of the counters of a transport.
+  * @param  pTransport Pointer to the transport.
+  * @param  pSnapshot Pointer to the snapshot.
+  * @retval None.
+  */
+static void BENCH_Snapshot(const BENCH_TransportTypeDef *pTransport, BENCH_SnapshotTypeDef *pSnapshot)
+{
+  pSnapshot->Commands   = BENCH_Counters.Commands;
+  pSnapshot->Bytes      = pTransport->pLink->BytesToDevice + pTransport->pLink->BytesToHost;
+  pSnapshot->RoundTrips = pTransport->pLink->RoundTrips;
+  pSnapshot->LinkTime   = pTransport->pLink->LinkTime;
+  pSnapshot->Time       = Common_GetVirtualTime();
+  pSnapshot->CpuTime    = BENCH_Counters.CpuTime;
+}
+
+/**
+  * @brief  Print one line of the report, the counters are the difference with the start snapshot.
+  *         The modeled time is the link time plus the time spent by the device in the Flash operations.
+  * @param  pTransport Pointer to the transport.
+  * @param  pJob The job name.
+  * @param  Length The number of transferred image bytes, 0 if the throughput is not relevant.
+  * @param  pStart Pointer to the snapshot taken at the start of the job.
+  * @retval None.
+  */
+static void BENCH_Report(const BENCH_TransportTypeDef *pTransport, const char *pJob, uint64_t Length,
+                         const BENCH_SnapshotTypeDef *pStart)
+{
+  BENCH_SnapshotTypeDef end;
+  uint64_t link_time;
+  uint64_t time;
+  uint32_t commands;
+
+  BENCH_Snapshot(pTransport, &end);
+
+  commands  = end.Commands - pStart->Commands;
+  link_time = end.LinkTime - pStart->LinkTime;
+  time      = end.Time - pStart->Time;
+
+  (void)printf("%-6s %-16s %7u %10llu %7u %10.1f %10.1f %10.1f",
+               pTransport->pName, pJob, (unsigned int)commands,
+               (unsigned long long)(end.Bytes - pStart->Bytes),
+               (unsigned int)(end.RoundTrips - pStart->RoundTrips),
+               (double)link_time / 1e6, (double)(time - link_time) / 1e6, (double)time / 1e6);
+
+  if ((Length != 0U) && (time != 0U))
+  {
+    (void)printf(" %8.1f", ((double)Length / 1024.0) / ((double)time / 1e9));
+  }
+  else
+  {
+    (void)printf(" %8s", "-");
+  }
+
+  (void)printf(" %9.1f", (commands != 0U) ? (((double)time / 1e3) / (double)commands) : 0.0);
+
+  if (ShowCpuTime == 1U)
+  {
+    (void)printf(" %9.2f", (double)(end.CpuTime - pStart->CpuTime) / 1e6);
+  }
+
+  (void)printf("\n");
+}
+
+/**
+  * @brief  Fill the image with a reproducible pseudo random pattern.
+  * @param  pImage Pointer to the image.
+  * @param  Length The number of bytes, a multiple of 4.
+  * @retval None.
+  */
+static void BENCH_FillImage(uint8_t *pImage, uint32_t Length)
+{
+  uint32_t state = 0x2545F491U;
+  uint32_t counter;
+
+  for (counter = 0U; counter < Length; counter += 4U)
+  {
+    state ^= state << 13U;
+    state ^= state >> 17U;
+    state ^= state << 5U;
+
+    (void)memcpy(&pImage[counter], &state, 4U);
+  }
+}
+
+/**
+  * @brief  Run the jobs of a transport: connection, command latency, erase, write and read back of the whole Flash.
+  * @param  pTransport Pointer to the transport.
+  * @param  pImage Pointer to the image written in the Flash.
+  * @param  pReadBack Pointer to the buffer where the Flash is read back.
+  * @retval Returns ERROR on a protocol or verification error else SUCCESS.
+  */
+static ErrorStatus BENCH_Transport(const BENCH_TransportTypeDef *pTransport, const uint8_t *pImage, uint8_t *pReadBack)
+{
+  BENCH_SnapshotTypeDef start;
+  ErrorStatus status;
+  uint32_t counter;
+
+  BENCH_SelectTransport(pTransport);
+
+  status = pTransport->Connect(pTransport);
+
+  if (status == SUCCESS)
+  {
+    BENCH_Snapshot(pTransport, &start);
+
+    for (counter = 0U; (counter < BENCH_VERSION_LOOPS) && (status == SUCCESS); counter++)
+    {
+      status = pTransport->GetVersion(pTransport);
+    }
+
+    BENCH_Report(pTransport, "get version", 0U, &start);
+  }
+
+  if (status == SUCCESS)
+  {
+    BENCH_Snapshot(pTransport, &start);
+
+    status = pTransport->Erase(pTransport, FLASH_MEM_SIZE / PageSize);
+
+    BENCH_Report(pTransport, "erase", 0U, &start);
+  }
+
+  if (status == SUCCESS)
+  {
+    BENCH_Snapshot(pTransport, &start);
+
+    status = pTransport->Write(pTransport, FLASH_START_ADDRESS, pImage, FLASH_MEM_SIZE);
+
+    BENCH_Report(pTransport, pTransport->pWriteMethod, FLASH_MEM_SIZE, &start);
+  }
+
+  if (status == SUCCESS)
+  {
+    BENCH_Snapshot(pTransport, &start);
+
+    (void)memset(pReadBack, 0, FLASH_MEM_SIZE);
+    status = pTransport->Read(pTransport, FLASH_START_ADDRESS, pReadBack, FLASH_MEM_SIZE);
+
+    BENCH_Report(pTransport, pTransport->pReadMethod, FLASH_MEM_SIZE, &start);
+  }
+
+  if (status != SUCCESS)
+  {
+    (void)fprintf(stderr, "%s: protocol error\n", pTransport->pName);
+  }
+  else if (memcmp(pImage, pReadBack, FLASH_MEM_SIZE) != 0)
+  {
+    (void)fprintf(stderr, "%s: the Flash read back differs from the written image\n", pTransport->pName);
+    status = ERROR;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  return status;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Main program.
+  * @param  argc The number of arguments.
+  * @param  argv The arguments.
+  * @retval Returns EXIT_FAILURE on a configuration, protocol or verification error else EXIT_SUCCESS.
+  */
+int main(int argc, char *argv[])
+{
+  char file[] = BENCH_FLASH_FILE;
+  uint32_t erase_time = SIM_FLASH_ERASE_TIME;
+  uint32_t program_time = SIM_FLASH_PROGRAM_TIME;
+  uint32_t counter;
+  uint8_t *p_image;
+  uint8_t *p_read_back;
+  int result = EXIT_SUCCESS;
+  int option;
+  int fd;
+
+  while ((option = getopt(argc, argv, "p:e:w:nh")) != -1)
+  {
+    switch (option)
+    {
+      case 'p':
+        PageSize = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'e':
+        erase_time = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'w':
+        program_time = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'n':
+        ShowCpuTime = 0U;
+        break;
+
+      default:
+        Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+
+  /* The Flash file is only used by this run */
+  fd = mkstemp(file);
+
+  if (fd < 0)
+  {
+    (void)fprintf(stderr, "Cannot create %s\n", file);
+    return EXIT_FAILURE;
+  }
+
+  (void)close(fd);
+
+  if (OPENBL_FLASH_Open(file, PageSize) != SUCCESS)
+  {
+    (void)fprintf(stderr, "Cannot open %s with %u-byte pages\n", file, (unsigned int)PageSize);
+    (void)unlink(file);
+    return EXIT_FAILURE;
+  }
+
+  (void)unlink(file);
+
+  OPENBL_FLASH_SetTiming(erase_time, program_time);
+
+  p_image     = malloc(FLASH_MEM_SIZE);
+  p_read_back = malloc(FLASH_MEM_SIZE);
+
+  if ((p_image == NULL) || (p_read_back == NULL))
+  {
+    (void)fprintf(stderr, "Cannot allocate the image\n");
+    return EXIT_FAILURE;
+  }
+
+  BENCH_FillImage(p_image, FLASH_MEM_SIZE);
+
+  /* The delays of the device advance the virtual clock, the links account their transfer time on it */
+  Common_SetVirtualTime(ENABLE);
+
+  for (counter = 0U; counter < BENCH_TRANSPORTS_NB; counter++)
+  {
+    BENCH_LinkInit(BENCH_Transports[counter].pLink, &BENCH_Transports[counter].Timing);
+  }
+
+  /* Initialize the Open Bootloader */
+  OpenBootloader_Init();
+
+  (void)printf("Flash %u KB, %u-byte pages, erase %u us per page, program %u us per %u bytes\n\n",
+               (unsigned int)(FLASH_MEM_SIZE / 1024U), (unsigned int)PageSize, (unsigned int)erase_time,
+               (unsigned int)program_time, SIM_FLASH_PROGRAM_UNIT);
+  (void)printf("%-6s %-16s %7s %10s %7s %10s %10s %10s %8s %9s",
+               "link", "job", "cmds", "bytes", "trips", "link ms", "flash ms", "model ms", "KB/s", "us/cmd");
+
+  if (ShowCpuTime == 1U)
+  {
+    (void)printf(" %9s", "cpu ms");
+  }
+
+  (void)printf("\n");
+
+  for (counter = 0U; counter < BENCH_TRANSPORTS_NB; counter++)
+  {
+    if (BENCH_Transport(&BENCH_Transports[counter], p_image, p_read_back) != SUCCESS)
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+
+  OpenBootloader_DeInit();
+
+  for (counter = 0U; counter < BENCH_TRANSPORTS_NB; counter++)
+  {
+    BENCH_LinkFree(BENCH_Transports[counter].pLink);
+  }
+
+  free(p_image);
+  free(p_read_back);
+
+  return result;
+}
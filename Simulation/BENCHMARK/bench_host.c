@@ -0,0 +1,1208 @@
+/**
+  ******************************************************************************
+  * @file    bench_host.c
+  * @author  MCD Application Team
+  * @brief   Host side of the benchmark: protocol drivers of the benchmarked transports
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include <time.h>
+
+#include "platform.h"
+#include "openbl_core.h"
+#include "app_openbootloader.h"
+#include "bench_link.h"
+#include "bench_host.h"
+#include "usart_interface.h"
+#include "i2c_interface.h"
+#include "spi_interface.h"
+#include "can_interface.h"
+#include "fdcan_interface.h"
+#include "i3c_interface.h"
+#include "usb_bulk_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define BENCH_SYNC_BYTE                   0x7FU     /* USART and USB bulk synchronization byte */
+#define BENCH_SPI_SYNC_BYTE               0x5AU     /* SPI synchronization byte sent before each command */
+#define BENCH_SPI_DUMMY_BYTE              0x00U     /* Dummy byte sent by the device before an acknowledge */
+#define BENCH_CAN_FC_CONTINUE_TO_SEND     0x30U     /* CAN flow control status: continue to send */
+#define BENCH_CAN_BLOCK_SIZE              256U      /* Bytes granted by each device CAN flow control frame */
+#define BENCH_CAN_ERASE_PAGES             64U       /* Pages erased per CAN legacy erase command */
+#define BENCH_FDCAN_FRAME_SIZE            64U       /* Data bytes of a CAN FD frame */
+#define BENCH_FDCAN_BLOCK_SIZE            1024U     /* Bytes acknowledged by the device in the FDCAN extended write */
+#define BENCH_USB_BLOCK_SIZE              4096U     /* Bytes acknowledged by the device in the USB bulk extended write */
+#define BENCH_RESPONSE_SIZE_MAX           16U       /* Longest fixed response checked by the host */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static const uint8_t a_BenchAcks[BENCH_RESPONSE_SIZE_MAX] =
+{
+  ACK_BYTE, ACK_BYTE, ACK_BYTE, ACK_BYTE, ACK_BYTE, ACK_BYTE, ACK_BYTE, ACK_BYTE,
+  ACK_BYTE, ACK_BYTE, ACK_BYTE, ACK_BYTE, ACK_BYTE, ACK_BYTE, ACK_BYTE, ACK_BYTE
+};
+
+/* Exported variables --------------------------------------------------------*/
+BENCH_CountersTypeDef BENCH_Counters;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint64_t BENCH_CpuTime(void);
+static void BENCH_Detect(void);
+static ErrorStatus BENCH_Execute(const BENCH_TransportTypeDef *pTransport, Function_Pointer pFunction);
+static ErrorStatus BENCH_ExpectAcks(BENCH_LinkTypeDef *pLink, uint32_t Number);
+static uint8_t BENCH_Xor(const uint8_t *pData, uint32_t Length);
+static uint32_t BENCH_PutWord(uint8_t *pBuffer, uint32_t Value);
+static void BENCH_SendCommand(BENCH_LinkTypeDef *pLink, uint8_t OpCode);
+static void BENCH_SendWord(BENCH_LinkTypeDef *pLink, uint32_t Value);
+static uint32_t BENCH_Chunk(uint32_t Chunk, uint32_t Length);
+
+static ErrorStatus BENCH_SyncConnect(const BENCH_TransportTypeDef *pTransport);
+static ErrorStatus BENCH_BusConnect(const BENCH_TransportTypeDef *pTransport);
+static ErrorStatus BENCH_UsartGetVersion(const BENCH_TransportTypeDef *pTransport);
+static ErrorStatus BENCH_UsartErase(const BENCH_TransportTypeDef *pTransport, uint32_t PagesNumber);
+static ErrorStatus BENCH_UsartWrite(const BENCH_TransportTypeDef *pTransport, uint32_t Address, const uint8_t *pData,
+                                    uint32_t Length);
+static ErrorStatus BENCH_UsartRead(const BENCH_TransportTypeDef *pTransport, uint32_t Address, uint8_t *pData,
+                                   uint32_t Length);
+static ErrorStatus BENCH_I2cGetVersion(const BENCH_TransportTypeDef *pTransport);
+static ErrorStatus BENCH_SpiGetVersion(const BENCH_TransportTypeDef *pTransport);
+static ErrorStatus BENCH_SpiErase(const BENCH_TransportTypeDef *pTransport, uint32_t PagesNumber);
+static ErrorStatus BENCH_SpiWrite(const BENCH_TransportTypeDef *pTransport, uint32_t Address, const uint8_t *pData,
+                                  uint32_t Length);
+static ErrorStatus BENCH_SpiRead(const BENCH_TransportTypeDef *pTransport, uint32_t Address, uint8_t *pData,
+                                 uint32_t Length);
+static ErrorStatus BENCH_CanGetVersion(const BENCH_TransportTypeDef *pTransport);
+static ErrorStatus BENCH_CanErase(const BENCH_TransportTypeDef *pTransport, uint32_t PagesNumber);
+static ErrorStatus BENCH_CanWrite(const BENCH_TransportTypeDef *pTransport, uint32_t Address, const uint8_t *pData,
+                                  uint32_t Length);
+static ErrorStatus BENCH_CanRead(const BENCH_TransportTypeDef *pTransport, uint32_t Address, uint8_t *pData,
+                                 uint32_t Length);
+static ErrorStatus BENCH_FdcanErase(const BENCH_TransportTypeDef *pTransport, uint32_t PagesNumber);
+static ErrorStatus BENCH_FdcanWrite(const BENCH_TransportTypeDef *pTransport, uint32_t Address, const uint8_t *pData,
+                                    uint32_t Length);
+static ErrorStatus BENCH_FdcanRead(const BENCH_TransportTypeDef *pTransport, uint32_t Address, uint8_t *pData,
+                                   uint32_t Length);
+static ErrorStatus BENCH_I3cErase(const BENCH_TransportTypeDef *pTransport, uint32_t PagesNumber);
+static ErrorStatus BENCH_I3cWrite(const BENCH_TransportTypeDef *pTransport, uint32_t Address, const uint8_t *pData,
+                                  uint32_t Length);
+static ErrorStatus BENCH_I3cRead(const BENCH_TransportTypeDef *pTransport, uint32_t Address, uint8_t *pData,
+                                 uint32_t Length);
+static ErrorStatus BENCH_UsbWrite(const BENCH_TransportTypeDef *pTransport, uint32_t Address, const uint8_t *pData,
+                                  uint32_t Length);
+static ErrorStatus BENCH_UsbRead(const BENCH_TransportTypeDef *pTransport, uint32_t Address, uint8_t *pData,
+                                 uint32_t Length);
+
+/* Transports, the timings are in ns:
+   - USART: 115200 bauds, 11 bits per byte
+   - I2C: 400 kHz, 9 clocks per byte, start, address and stop of each transfer
+   - SPI: 8 MHz
+   - CAN: 1 Mbps, 47 bits of frame overhead with the average bit stuffing
+   - FDCAN: 1 Mbps arbitration phase and 8 Mbps data phase
+   - I3C: 12.5 MHz SDR, 9 clocks per byte, start, address and stop of each transfer
+   - USB: full speed bulk packets, the host polls the device every 1 ms frame */
+const BENCH_TransportTypeDef BENCH_Transports[BENCH_TRANSPORTS_NB] =
+{
+  {
+    "USART", &USART_Link, {95486U, 0U, 0U, 100000U}, "write 256 B", "read 256 B", 256U, 256U, NULL,
+    BENCH_SyncConnect, BENCH_UsartGetVersion, BENCH_UsartErase, BENCH_UsartWrite, BENCH_UsartRead
+  },
+  {
+    "I2C", &I2C_Link, {22500U, 27500U, 0U, 100000U}, "write 256 B", "read 256 B", 256U, 256U, NULL,
+    BENCH_BusConnect, BENCH_I2cGetVersion, BENCH_UsartErase, BENCH_UsartWrite, BENCH_UsartRead
+  },
+  {
+    "SPI", &SPI_Link, {1000U, 0U, 0U, 100000U}, "write 256 B", "read 256 B", 256U, 256U, NULL,
+    BENCH_BusConnect, BENCH_SpiGetVersion, BENCH_SpiErase, BENCH_SpiWrite, BENCH_SpiRead
+  },
+  {
+    "CAN", &CAN_Link, {8000U, 47000U, 8U, 100000U}, "ext write", "ext read", 0U, 0U, NULL,
+    BENCH_BusConnect, BENCH_CanGetVersion, BENCH_CanErase, BENCH_CanWrite, BENCH_CanRead
+  },
+  {
+    "FDCAN", &FDCAN_Link, {1000U, 32500U, 64U, 100000U}, "ext write", "ext read", 0U, 0U, NULL,
+    BENCH_BusConnect, BENCH_CanGetVersion, BENCH_FdcanErase, BENCH_FdcanWrite, BENCH_FdcanRead
+  },
+  {
+    "I3C", &I3C_Link, {720U, 2400U, 0U, 100000U}, "loop write 2 KB", "loop read 2 KB", 2048U, 2048U, NULL,
+    BENCH_BusConnect, BENCH_I2cGetVersion, BENCH_I3cErase, BENCH_I3cWrite, BENCH_I3cRead
+  },
+  {
+    "USB", &USB_BULK_Link, {700U, 5000U, 64U, 1000000U}, "ext write", "ext read", 0U, 0U, OPENBL_USB_BULK_Flush,
+    BENCH_SyncConnect, BENCH_UsartGetVersion, BENCH_UsartErase, BENCH_UsbWrite, BENCH_UsbRead
+  }
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to get the CPU time of the calling thread.
+  * @retval Returns the time in ns.
+  */
+static uint64_t BENCH_CpuTime(void)
+{
+  struct timespec time;
+
+  (void)clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+
+  return ((uint64_t)time.tv_sec * 1000000000U) + (uint64_t)time.tv_nsec;
+}
+
+/**
+  * @brief  This function is used to run the interface detection on the device.
+  * @retval None.
+  */
+static void BENCH_Detect(void)
+{
+  (void)OPENBL_InterfaceDetection();
+}
+
+/**
+  * @brief  This function is used to run device code once the host data is queued.
+  * @param  pTransport Pointer to the transport.
+  * @param  pFunction The device function.
+  * @retval Returns ERROR if the device waited for data the host did not send else SUCCESS.
+  */
+static ErrorStatus BENCH_Execute(const BENCH_TransportTypeDef *pTransport, Function_Pointer pFunction)
+{
+  ErrorStatus status;
+  uint64_t start;
+
+  start  = BENCH_CpuTime();
+  status = BENCH_Run(pFunction);
+
+  if (pTransport->Flush != NULL)
+  {
+    pTransport->Flush();
+  }
+
+  BENCH_Counters.CpuTime += BENCH_CpuTime() - start;
+
+  if (pFunction == OpenBootloader_ProtocolDetection)
+  {
+    BENCH_Counters.Commands++;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to check that the device sent acknowledges.
+  * @param  pLink Pointer to the link.
+  * @param  Number The number of acknowledges.
+  * @retval Returns ERROR if the device sent other bytes else SUCCESS.
+  */
+static ErrorStatus BENCH_ExpectAcks(BENCH_LinkTypeDef *pLink, uint32_t Number)
+{
+  ErrorStatus status = SUCCESS;
+  uint32_t length;
+
+  while ((Number != 0U) && (status == SUCCESS))
+  {
+    length  = (Number > BENCH_RESPONSE_SIZE_MAX) ? BENCH_RESPONSE_SIZE_MAX : Number;
+    status  = BENCH_HostExpect(pLink, a_BenchAcks, length);
+    Number -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to compute the XOR of a buffer.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns the XOR value.
+  */
+static uint8_t BENCH_Xor(const uint8_t *pData, uint32_t Length)
+{
+  uint32_t counter;
+  uint8_t xor = 0U;
+
+  for (counter = 0U; counter < Length; counter++)
+  {
+    xor ^= pData[counter];
+  }
+
+  return xor;
+}
+
+/**
+  * @brief  This function is used to store a word MSB first.
+  * @param  pBuffer Pointer to the destination buffer.
+  * @param  Value The word to be stored.
+  * @retval Returns the number of stored bytes.
+  */
+static uint32_t BENCH_PutWord(uint8_t *pBuffer, uint32_t Value)
+{
+  pBuffer[0] = (uint8_t)(Value >> 24U);
+  pBuffer[1] = (uint8_t)(Value >> 16U);
+  pBuffer[2] = (uint8_t)(Value >> 8U);
+  pBuffer[3] = (uint8_t)Value;
+
+  return 4U;
+}
+
+/**
+  * @brief  This function is used to send a command opcode followed by its complement.
+  * @param  pLink Pointer to the link.
+  * @param  OpCode The command opcode.
+  * @retval None.
+  */
+static void BENCH_SendCommand(BENCH_LinkTypeDef *pLink, uint8_t OpCode)
+{
+  uint8_t command[2];
+
+  command[0] = OpCode;
+  command[1] = (uint8_t)~OpCode;
+
+  BENCH_HostSend(pLink, command, 2U);
+}
+
+/**
+  * @brief  This function is used to send a word MSB first followed by its XOR.
+  * @param  pLink Pointer to the link.
+  * @param  Value The word, an address or a size.
+  * @retval None.
+  */
+static void BENCH_SendWord(BENCH_LinkTypeDef *pLink, uint32_t Value)
+{
+  uint8_t data[5];
+
+  (void)BENCH_PutWord(data, Value);
+  data[4] = BENCH_Xor(data, 4U);
+
+  BENCH_HostSend(pLink, data, 5U);
+}
+
+/**
+  * @brief  This function is used to get the number of bytes of the next transfer.
+  * @param  Chunk The bytes per transfer, 0 for no limit.
+  * @param  Length The remaining bytes.
+  * @retval Returns the number of bytes.
+  */
+static uint32_t BENCH_Chunk(uint32_t Chunk, uint32_t Length)
+{
+  return ((Chunk != 0U) && (Length > Chunk)) ? Chunk : Length;
+}
+
+/**
+  * @brief  This function is used to connect to a device waiting for the synchronization byte (USART and USB bulk).
+  * @param  pTransport Pointer to the transport.
+  * @retval Returns ERROR if the device did not acknowledge else SUCCESS.
+  */
+static ErrorStatus BENCH_SyncConnect(const BENCH_TransportTypeDef *pTransport)
+{
+  uint8_t sync = BENCH_SYNC_BYTE;
+
+  BENCH_HostSend(pTransport->pLink, &sync, 1U);
+
+  if (BENCH_Execute(pTransport, BENCH_Detect) != SUCCESS)
+  {
+    return ERROR;
+  }
+
+  return BENCH_ExpectAcks(pTransport->pLink, 1U);
+}
+
+/**
+  * @brief  This function is used to connect to a device detecting the host activity on its bus.
+  * @param  pTransport Pointer to the transport.
+  * @retval Returns SUCCESS.
+  */
+static ErrorStatus BENCH_BusConnect(const BENCH_TransportTypeDef *pTransport)
+{
+  return BENCH_Execute(pTransport, BENCH_Detect);
+}
+
+/**
+  * @brief  This function is used to get the protocol version, the device sends ACK, version, 2 option bytes, ACK.
+  * @param  pTransport Pointer to the transport.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_UsartGetVersion(const BENCH_TransportTypeDef *pTransport)
+{
+  uint8_t response[5];
+
+  BENCH_SendCommand(pTransport->pLink, CMD_GET_VERSION);
+
+  if ((BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+      || (BENCH_HostReceive(pTransport->pLink, response, 5U) != SUCCESS)
+      || (response[0] != ACK_BYTE) || (response[4] != ACK_BYTE))
+  {
+    return ERROR;
+  }
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  This function is used to mass erase the Flash with the extended erase command.
+  * @param  pTransport Pointer to the transport.
+  * @param  PagesNumber The number of Flash pages, not used.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_UsartErase(const BENCH_TransportTypeDef *pTransport, uint32_t PagesNumber)
+{
+  static const uint8_t a_mass_erase[3] = {0xFFU, 0xFFU, 0x00U};
+
+  (void)PagesNumber;
+
+  BENCH_SendCommand(pTransport->pLink, CMD_EXT_ERASE_MEMORY);
+  BENCH_HostSend(pTransport->pLink, a_mass_erase, 3U);
+
+  if (BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+  {
+    return ERROR;
+  }
+
+  return BENCH_ExpectAcks(pTransport->pLink, 2U);
+}
+
+/**
+  * @brief  This function is used to write memory with the write memory command (USART and I2C).
+  * @param  pTransport Pointer to the transport.
+  * @param  Address The start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_UsartWrite(const BENCH_TransportTypeDef *pTransport, uint32_t Address, const uint8_t *pData,
+                                    uint32_t Length)
+{
+  ErrorStatus status = SUCCESS;
+  uint32_t length;
+  uint8_t data;
+
+  while ((Length != 0U) && (status == SUCCESS))
+  {
+    length = BENCH_Chunk(pTransport->WriteChunk, Length);
+    data   = (uint8_t)(length - 1U);
+
+    BENCH_SendCommand(pTransport->pLink, CMD_WRITE_MEMORY);
+    BENCH_SendWord(pTransport->pLink, Address);
+    BENCH_HostSend(pTransport->pLink, &data, 1U);
+    BENCH_HostSend(pTransport->pLink, pData, length);
+
+    data ^= BENCH_Xor(pData, length);
+    BENCH_HostSend(pTransport->pLink, &data, 1U);
+
+    if (BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+    {
+      status = ERROR;
+    }
+    else
+    {
+      status = BENCH_ExpectAcks(pTransport->pLink, 3U);
+    }
+
+    Address += length;
+    pData   += length;
+    Length  -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to read memory with the read memory command (USART and I2C).
+  * @param  pTransport Pointer to the transport.
+  * @param  Address The start address.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_UsartRead(const BENCH_TransportTypeDef *pTransport, uint32_t Address, uint8_t *pData,
+                                   uint32_t Length)
+{
+  ErrorStatus status = SUCCESS;
+  uint32_t length;
+  uint8_t size[2];
+
+  while ((Length != 0U) && (status == SUCCESS))
+  {
+    length  = BENCH_Chunk(pTransport->ReadChunk, Length);
+    size[0] = (uint8_t)(length - 1U);
+    size[1] = (uint8_t)~size[0];
+
+    BENCH_SendCommand(pTransport->pLink, CMD_READ_MEMORY);
+    BENCH_SendWord(pTransport->pLink, Address);
+    BENCH_HostSend(pTransport->pLink, size, 2U);
+
+    if ((BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+        || (BENCH_ExpectAcks(pTransport->pLink, 3U) != SUCCESS))
+    {
+      status = ERROR;
+    }
+    else
+    {
+      status = BENCH_HostReceive(pTransport->pLink, pData, length);
+    }
+
+    Address += length;
+    pData   += length;
+    Length  -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to get the protocol version, the device sends ACK, version, ACK.
+  * @param  pTransport Pointer to the transport.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_I2cGetVersion(const BENCH_TransportTypeDef *pTransport)
+{
+  uint8_t response[3];
+
+  BENCH_SendCommand(pTransport->pLink, CMD_GET_VERSION);
+
+  if ((BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+      || (BENCH_HostReceive(pTransport->pLink, response, 3U) != SUCCESS)
+      || (response[0] != ACK_BYTE) || (response[2] != ACK_BYTE))
+  {
+    return ERROR;
+  }
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  This function is used to send the SPI synchronization byte and a command.
+  * @param  pLink Pointer to the link.
+  * @param  OpCode The command opcode.
+  * @retval None.
+  */
+static void BENCH_SpiSendCommand(BENCH_LinkTypeDef *pLink, uint8_t OpCode)
+{
+  uint8_t sync = BENCH_SPI_SYNC_BYTE;
+
+  BENCH_HostSend(pLink, &sync, 1U);
+  BENCH_SendCommand(pLink, OpCode);
+}
+
+/**
+  * @brief  This function is used to send the acknowledge synchronization byte of the SPI protocol.
+  * @param  pLink Pointer to the link.
+  * @retval None.
+  */
+static void BENCH_SpiSendAck(BENCH_LinkTypeDef *pLink)
+{
+  uint8_t ack = ACK_BYTE;
+
+  BENCH_HostSend(pLink, &ack, 1U);
+}
+
+/**
+  * @brief  This function is used to check the SPI acknowledges, each one is preceded by a dummy byte.
+  * @param  pLink Pointer to the link.
+  * @param  Number The number of acknowledges.
+  * @retval Returns ERROR if the device sent other bytes else SUCCESS.
+  */
+static ErrorStatus BENCH_SpiExpectAcks(BENCH_LinkTypeDef *pLink, uint32_t Number)
+{
+  static const uint8_t a_ack[2] = {BENCH_SPI_DUMMY_BYTE, ACK_BYTE};
+  ErrorStatus status = SUCCESS;
+
+  while ((Number != 0U) && (status == SUCCESS))
+  {
+    status = BENCH_HostExpect(pLink, a_ack, 2U);
+    Number--;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to get the SPI protocol version.
+  * @param  pTransport Pointer to the transport.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_SpiGetVersion(const BENCH_TransportTypeDef *pTransport)
+{
+  uint8_t version;
+
+  BENCH_SpiSendCommand(pTransport->pLink, CMD_GET_VERSION);
+  BENCH_SpiSendAck(pTransport->pLink);
+  BENCH_SpiSendAck(pTransport->pLink);
+
+  if ((BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+      || (BENCH_SpiExpectAcks(pTransport->pLink, 1U) != SUCCESS)
+      || (BENCH_HostReceive(pTransport->pLink, &version, 1U) != SUCCESS))
+  {
+    return ERROR;
+  }
+
+  return BENCH_SpiExpectAcks(pTransport->pLink, 1U);
+}
+
+/**
+  * @brief  This function is used to mass erase the Flash with the SPI extended erase command.
+  * @param  pTransport Pointer to the transport.
+  * @param  PagesNumber The number of Flash pages, not used.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_SpiErase(const BENCH_TransportTypeDef *pTransport, uint32_t PagesNumber)
+{
+  static const uint8_t a_mass_erase[3] = {0xFFU, 0xFFU, 0x00U};
+
+  (void)PagesNumber;
+
+  BENCH_SpiSendCommand(pTransport->pLink, CMD_EXT_ERASE_MEMORY);
+  BENCH_SpiSendAck(pTransport->pLink);
+  BENCH_HostSend(pTransport->pLink, a_mass_erase, 3U);
+  BENCH_SpiSendAck(pTransport->pLink);
+
+  if (BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+  {
+    return ERROR;
+  }
+
+  return BENCH_SpiExpectAcks(pTransport->pLink, 2U);
+}
+
+/**
+  * @brief  This function is used to write memory with the SPI write memory command.
+  * @param  pTransport Pointer to the transport.
+  * @param  Address The start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_SpiWrite(const BENCH_TransportTypeDef *pTransport, uint32_t Address, const uint8_t *pData,
+                                  uint32_t Length)
+{
+  ErrorStatus status = SUCCESS;
+  uint32_t length;
+  uint8_t data;
+
+  while ((Length != 0U) && (status == SUCCESS))
+  {
+    length = BENCH_Chunk(pTransport->WriteChunk, Length);
+    data   = (uint8_t)(length - 1U);
+
+    BENCH_SpiSendCommand(pTransport->pLink, CMD_WRITE_MEMORY);
+    BENCH_SpiSendAck(pTransport->pLink);
+    BENCH_SendWord(pTransport->pLink, Address);
+    BENCH_SpiSendAck(pTransport->pLink);
+    BENCH_HostSend(pTransport->pLink, &data, 1U);
+    BENCH_HostSend(pTransport->pLink, pData, length);
+
+    data ^= BENCH_Xor(pData, length);
+    BENCH_HostSend(pTransport->pLink, &data, 1U);
+    BENCH_SpiSendAck(pTransport->pLink);
+
+    if (BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+    {
+      status = ERROR;
+    }
+    else
+    {
+      status = BENCH_SpiExpectAcks(pTransport->pLink, 3U);
+    }
+
+    Address += length;
+    pData   += length;
+    Length  -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to read memory with the SPI read memory command.
+  * @param  pTransport Pointer to the transport.
+  * @param  Address The start address.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_SpiRead(const BENCH_TransportTypeDef *pTransport, uint32_t Address, uint8_t *pData,
+                                 uint32_t Length)
+{
+  ErrorStatus status = SUCCESS;
+  uint32_t length;
+  uint8_t size[2];
+
+  while ((Length != 0U) && (status == SUCCESS))
+  {
+    length  = BENCH_Chunk(pTransport->ReadChunk, Length);
+    size[0] = (uint8_t)(length - 1U);
+    size[1] = (uint8_t)~size[0];
+
+    BENCH_SpiSendCommand(pTransport->pLink, CMD_READ_MEMORY);
+    BENCH_SpiSendAck(pTransport->pLink);
+    BENCH_SendWord(pTransport->pLink, Address);
+    BENCH_SpiSendAck(pTransport->pLink);
+    BENCH_HostSend(pTransport->pLink, size, 2U);
+    BENCH_SpiSendAck(pTransport->pLink);
+
+    if ((BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+        || (BENCH_SpiExpectAcks(pTransport->pLink, 3U) != SUCCESS))
+    {
+      status = ERROR;
+    }
+    else
+    {
+      status = BENCH_HostReceive(pTransport->pLink, pData, length);
+    }
+
+    Address += length;
+    pData   += length;
+    Length  -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to get the protocol version on CAN and FDCAN,
+  *         the device sends ACK, version, 2 option bytes and ACK frames.
+  * @param  pTransport Pointer to the transport.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_CanGetVersion(const BENCH_TransportTypeDef *pTransport)
+{
+  uint8_t response[5];
+
+  BENCH_HostSendFrame(pTransport->pLink, CMD_GET_VERSION, NULL, 0U);
+
+  if ((BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+      || (BENCH_HostReceive(pTransport->pLink, response, 5U) != SUCCESS)
+      || (response[0] != ACK_BYTE) || (response[4] != ACK_BYTE))
+  {
+    return ERROR;
+  }
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  This function is used to erase the Flash with the CAN legacy erase command.
+  *         The page numbers are sent on one byte, BENCH_CAN_ERASE_PAGES pages are erased per command.
+  * @param  pTransport Pointer to the transport.
+  * @param  PagesNumber The number of Flash pages.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_CanErase(const BENCH_TransportTypeDef *pTransport, uint32_t PagesNumber)
+{
+  ErrorStatus status = SUCCESS;
+  uint32_t page = 0U;
+  uint32_t pages;
+  uint32_t counter;
+  uint8_t frame[8];
+
+  if (PagesNumber > 256U)
+  {
+    status = ERROR;
+  }
+
+  while ((page < PagesNumber) && (status == SUCCESS))
+  {
+    pages    = BENCH_Chunk(BENCH_CAN_ERASE_PAGES, PagesNumber - page);
+    frame[0] = (uint8_t)(pages - 1U);
+
+    BENCH_HostSendFrame(pTransport->pLink, CMD_LEG_ERASE_MEMORY, frame, 1U);
+
+    for (counter = 0U; counter < pages; counter++)
+    {
+      frame[counter % 8U] = (uint8_t)(page + counter);
+
+      if (((counter % 8U) == 7U) || (counter == (pages - 1U)))
+      {
+        BENCH_HostSendFrame(pTransport->pLink, CMD_LEG_ERASE_MEMORY, frame, (counter % 8U) + 1U);
+      }
+    }
+
+    /* ACK, ACK, one ACK per full frame of page numbers, then the status */
+    if (BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+    {
+      status = ERROR;
+    }
+    else
+    {
+      status = BENCH_ExpectAcks(pTransport->pLink, 3U + (pages / 8U));
+    }
+
+    page += pages;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to write memory with the CAN extended write command.
+  *         The device grants each block with a flow control frame.
+  * @param  pTransport Pointer to the transport.
+  * @param  Address The start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_CanWrite(const BENCH_TransportTypeDef *pTransport, uint32_t Address, const uint8_t *pData,
+                                  uint32_t Length)
+{
+  static const uint8_t a_flow_control[3] = {BENCH_CAN_FC_CONTINUE_TO_SEND, BENCH_CAN_BLOCK_SIZE / 8U, 0x00U};
+  ErrorStatus status = SUCCESS;
+  uint32_t length;
+  uint32_t offset;
+  uint32_t block;
+  uint8_t frame[8];
+
+  while ((Length != 0U) && (status == SUCCESS))
+  {
+    length = BENCH_Chunk(pTransport->WriteChunk, Length);
+
+    (void)BENCH_PutWord(frame, Address);
+    (void)BENCH_PutWord(&frame[4], length);
+    BENCH_HostSendFrame(pTransport->pLink, CMD_EXT_WRITE_MEMORY, frame, 8U);
+
+    for (offset = 0U; offset < length; offset += 8U)
+    {
+      BENCH_HostSendFrame(pTransport->pLink, CMD_EXT_WRITE_MEMORY, &pData[offset], BENCH_Chunk(8U, length - offset));
+    }
+
+    if ((BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+        || (BENCH_ExpectAcks(pTransport->pLink, 1U) != SUCCESS))
+    {
+      status = ERROR;
+    }
+
+    for (block = 0U; (block < length) && (status == SUCCESS); block += BENCH_CAN_BLOCK_SIZE)
+    {
+      status = BENCH_HostExpect(pTransport->pLink, a_flow_control, 3U);
+    }
+
+    if (status == SUCCESS)
+    {
+      status = BENCH_ExpectAcks(pTransport->pLink, 1U);
+    }
+
+    Address += length;
+    pData   += length;
+    Length  -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to read memory with the CAN extended read command.
+  *         The host flow control frame allows the device to send all the frames.
+  * @param  pTransport Pointer to the transport.
+  * @param  Address The start address.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_CanRead(const BENCH_TransportTypeDef *pTransport, uint32_t Address, uint8_t *pData,
+                                 uint32_t Length)
+{
+  static const uint8_t a_flow_control[3] = {BENCH_CAN_FC_CONTINUE_TO_SEND, 0x00U, 0x00U};
+  ErrorStatus status = SUCCESS;
+  uint32_t length;
+  uint8_t frame[8];
+
+  while ((Length != 0U) && (status == SUCCESS))
+  {
+    length = BENCH_Chunk(pTransport->ReadChunk, Length);
+
+    (void)BENCH_PutWord(frame, Address);
+    (void)BENCH_PutWord(&frame[4], length);
+    BENCH_HostSendFrame(pTransport->pLink, CMD_EXT_READ_MEMORY, frame, 8U);
+    BENCH_HostSendFrame(pTransport->pLink, CMD_EXT_READ_MEMORY, a_flow_control, 3U);
+
+    if ((BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+        || (BENCH_ExpectAcks(pTransport->pLink, 1U) != SUCCESS)
+        || (BENCH_HostReceive(pTransport->pLink, pData, length) != SUCCESS))
+    {
+      status = ERROR;
+    }
+    else
+    {
+      status = BENCH_ExpectAcks(pTransport->pLink, 1U);
+    }
+
+    Address += length;
+    pData   += length;
+    Length  -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to mass erase the Flash with the FDCAN erase command.
+  * @param  pTransport Pointer to the transport.
+  * @param  PagesNumber The number of Flash pages, not used.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_FdcanErase(const BENCH_TransportTypeDef *pTransport, uint32_t PagesNumber)
+{
+  static const uint8_t a_mass_erase[2] = {0xFFU, 0xFFU};
+
+  (void)PagesNumber;
+
+  BENCH_HostSendFrame(pTransport->pLink, CMD_EXT_ERASE_MEMORY, a_mass_erase, 2U);
+
+  if (BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+  {
+    return ERROR;
+  }
+
+  return BENCH_ExpectAcks(pTransport->pLink, 2U);
+}
+
+/**
+  * @brief  This function is used to write memory with the FDCAN extended write command.
+  *         The device acknowledges each block of BENCH_FDCAN_BLOCK_SIZE bytes.
+  * @param  pTransport Pointer to the transport.
+  * @param  Address The start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_FdcanWrite(const BENCH_TransportTypeDef *pTransport, uint32_t Address, const uint8_t *pData,
+                                    uint32_t Length)
+{
+  ErrorStatus status = SUCCESS;
+  uint32_t length;
+  uint32_t offset;
+  uint32_t block;
+  uint32_t frame_length;
+  uint8_t frame[8];
+
+  while ((Length != 0U) && (status == SUCCESS))
+  {
+    length = BENCH_Chunk(pTransport->WriteChunk, Length);
+
+    (void)BENCH_PutWord(frame, Address);
+    (void)BENCH_PutWord(&frame[4], length);
+    BENCH_HostSendFrame(pTransport->pLink, CMD_EXT_WRITE_MEMORY, frame, 8U);
+
+    /* The frames do not cross the blocks, the padding of the last frame of a block would be dropped */
+    for (block = 0U; block < length; block += BENCH_FDCAN_BLOCK_SIZE)
+    {
+      for (offset = block; offset < (block + BENCH_Chunk(BENCH_FDCAN_BLOCK_SIZE, length - block));
+           offset += frame_length)
+      {
+        frame_length = BENCH_Chunk(BENCH_FDCAN_FRAME_SIZE, (block + BENCH_Chunk(BENCH_FDCAN_BLOCK_SIZE, length - block))
+                                   - offset);
+
+        BENCH_HostSendFrame(pTransport->pLink, CMD_EXT_WRITE_MEMORY, &pData[offset], frame_length);
+      }
+    }
+
+    /* ACK, then one ACK per block */
+    if (BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+    {
+      status = ERROR;
+    }
+    else
+    {
+      status = BENCH_ExpectAcks(pTransport->pLink, 1U + ((length + BENCH_FDCAN_BLOCK_SIZE - 1U) / BENCH_FDCAN_BLOCK_SIZE));
+    }
+
+    Address += length;
+    pData   += length;
+    Length  -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to read memory with the FDCAN extended read command.
+  *         The device sends 64-byte frames, the last one is padded.
+  * @param  pTransport Pointer to the transport.
+  * @param  Address The start address.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_FdcanRead(const BENCH_TransportTypeDef *pTransport, uint32_t Address, uint8_t *pData,
+                                   uint32_t Length)
+{
+  ErrorStatus status = SUCCESS;
+  uint32_t length;
+  uint32_t padding;
+  uint8_t frame[8];
+
+  while ((Length != 0U) && (status == SUCCESS))
+  {
+    length  = BENCH_Chunk(pTransport->ReadChunk, Length);
+    padding = (BENCH_FDCAN_FRAME_SIZE - (length % BENCH_FDCAN_FRAME_SIZE)) % BENCH_FDCAN_FRAME_SIZE;
+
+    (void)BENCH_PutWord(frame, Address);
+    (void)BENCH_PutWord(&frame[4], length);
+    BENCH_HostSendFrame(pTransport->pLink, CMD_EXT_READ_MEMORY, frame, 8U);
+
+    if ((BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+        || (BENCH_ExpectAcks(pTransport->pLink, 1U) != SUCCESS)
+        || (BENCH_HostReceive(pTransport->pLink, pData, length) != SUCCESS)
+        || (BENCH_HostReceive(pTransport->pLink, NULL, padding) != SUCCESS))
+    {
+      status = ERROR;
+    }
+    else
+    {
+      status = BENCH_ExpectAcks(pTransport->pLink, 1U);
+    }
+
+    Address += length;
+    pData   += length;
+    Length  -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to mass erase the Flash with the I3C extended erase command.
+  * @param  pTransport Pointer to the transport.
+  * @param  PagesNumber The number of Flash pages, not used.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_I3cErase(const BENCH_TransportTypeDef *pTransport, uint32_t PagesNumber)
+{
+  return BENCH_UsartErase(pTransport, PagesNumber);
+}
+
+/**
+  * @brief  This function is used to send the I3C loop header: size shifted left, loop flag in bit 0, XOR.
+  * @param  pLink Pointer to the link.
+  * @param  Size The number of bytes of this loop.
+  * @param  Loop 1 if another loop follows else 0.
+  * @retval None.
+  */
+static void BENCH_I3cSendLoop(BENCH_LinkTypeDef *pLink, uint32_t Size, uint32_t Loop)
+{
+  uint8_t header[3];
+
+  header[0] = (uint8_t)(((Size << 1U) | Loop) >> 8U);
+  header[1] = (uint8_t)((Size << 1U) | Loop);
+  header[2] = header[0] ^ header[1];
+
+  BENCH_HostSend(pLink, header, 3U);
+}
+
+/**
+  * @brief  This function is used to write memory with one looped I3C write memory command.
+  * @param  pTransport Pointer to the transport.
+  * @param  Address The start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_I3cWrite(const BENCH_TransportTypeDef *pTransport, uint32_t Address, const uint8_t *pData,
+                                  uint32_t Length)
+{
+  uint32_t loops = 0U;
+  uint32_t length;
+  uint8_t xor;
+
+  BENCH_SendCommand(pTransport->pLink, CMD_WRITE_MEMORY);
+  BENCH_SendWord(pTransport->pLink, Address);
+
+  while (Length != 0U)
+  {
+    length = BENCH_Chunk(pTransport->WriteChunk, Length);
+    xor    = BENCH_Xor(pData, length);
+
+    BENCH_I3cSendLoop(pTransport->pLink, length, (Length > length) ? 1U : 0U);
+    BENCH_HostSend(pTransport->pLink, pData, length);
+    BENCH_HostSend(pTransport->pLink, &xor, 1U);
+
+    loops++;
+    pData  += length;
+    Length -= length;
+  }
+
+  /* ACK, address ACK, then two ACKs per loop */
+  if (BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+  {
+    return ERROR;
+  }
+
+  return BENCH_ExpectAcks(pTransport->pLink, 2U + (2U * loops));
+}
+
+/**
+  * @brief  This function is used to read memory with one looped I3C read memory command.
+  * @param  pTransport Pointer to the transport.
+  * @param  Address The start address.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_I3cRead(const BENCH_TransportTypeDef *pTransport, uint32_t Address, uint8_t *pData,
+                                 uint32_t Length)
+{
+  ErrorStatus status;
+  uint32_t remaining = Length;
+  uint32_t length;
+
+  BENCH_SendCommand(pTransport->pLink, CMD_READ_MEMORY);
+  BENCH_SendWord(pTransport->pLink, Address);
+
+  while (remaining != 0U)
+  {
+    length = BENCH_Chunk(pTransport->ReadChunk, remaining);
+
+    BENCH_I3cSendLoop(pTransport->pLink, length, (remaining > length) ? 1U : 0U);
+
+    remaining -= length;
+  }
+
+  status = BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection);
+
+  if (status == SUCCESS)
+  {
+    status = BENCH_ExpectAcks(pTransport->pLink, 2U);
+  }
+
+  /* Each loop is acknowledged before its data */
+  while ((Length != 0U) && (status == SUCCESS))
+  {
+    length = BENCH_Chunk(pTransport->ReadChunk, Length);
+
+    if (BENCH_ExpectAcks(pTransport->pLink, 1U) != SUCCESS)
+    {
+      status = ERROR;
+    }
+    else
+    {
+      status = BENCH_HostReceive(pTransport->pLink, pData, length);
+    }
+
+    pData  += length;
+    Length -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to write memory with the USB bulk extended write command.
+  *         The device acknowledges each block of BENCH_USB_BLOCK_SIZE bytes.
+  * @param  pTransport Pointer to the transport.
+  * @param  Address The start address.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_UsbWrite(const BENCH_TransportTypeDef *pTransport, uint32_t Address, const uint8_t *pData,
+                                  uint32_t Length)
+{
+  ErrorStatus status = SUCCESS;
+  uint32_t length;
+  uint32_t offset;
+  uint32_t block;
+  uint8_t xor;
+
+  while ((Length != 0U) && (status == SUCCESS))
+  {
+    length = BENCH_Chunk(pTransport->WriteChunk, Length);
+
+    BENCH_SendCommand(pTransport->pLink, CMD_EXT_WRITE_MEMORY);
+    BENCH_SendWord(pTransport->pLink, Address);
+    BENCH_SendWord(pTransport->pLink, length);
+
+    for (offset = 0U; offset < length; offset += block)
+    {
+      block = BENCH_Chunk(BENCH_USB_BLOCK_SIZE, length - offset);
+      xor   = BENCH_Xor(&pData[offset], block);
+
+      BENCH_HostSend(pTransport->pLink, &pData[offset], block);
+      BENCH_HostSend(pTransport->pLink, &xor, 1U);
+    }
+
+    /* ACK, address ACK, size ACK, then one ACK per block */
+    if (BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+    {
+      status = ERROR;
+    }
+    else
+    {
+      status = BENCH_ExpectAcks(pTransport->pLink, 3U + ((length + BENCH_USB_BLOCK_SIZE - 1U) / BENCH_USB_BLOCK_SIZE));
+    }
+
+    Address += length;
+    pData   += length;
+    Length  -= length;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to read memory with the USB bulk extended read command.
+  * @param  pTransport Pointer to the transport.
+  * @param  Address The start address.
+  * @param  pData Pointer to the buffer where the data is stored.
+  * @param  Length The number of bytes.
+  * @retval Returns ERROR on a protocol error else SUCCESS.
+  */
+static ErrorStatus BENCH_UsbRead(const BENCH_TransportTypeDef *pTransport, uint32_t Address, uint8_t *pData,
+                                 uint32_t Length)
+{
+  ErrorStatus status = SUCCESS;
+  uint32_t length;
+
+  while ((Length != 0U) && (status == SUCCESS))
+  {
+    length = BENCH_Chunk(pTransport->ReadChunk, Length);
+
+    BENCH_SendCommand(pTransport->pLink, CMD_EXT_READ_MEMORY);
+    BENCH_SendWord(pTransport->pLink, Address);
+    BENCH_SendWord(pTransport->pLink, length);
+
+    if ((BENCH_Execute(pTransport, OpenBootloader_ProtocolDetection) != SUCCESS)
+        || (BENCH_ExpectAcks(pTransport->pLink, 3U) != SUCCESS))
+    {
+      status = ERROR;
+    }
+    else
+    {
+      status = BENCH_HostReceive(pTransport->pLink, pData, length);
+    }
+
+    Address += length;
+    pData   += length;
+    Length  -= length;
+  }
+
+  return status;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to select the transport used by the host, the other links are idle.
+  * @param  pTransport Pointer to the transport.
+  * @retval None.
+  */
+void BENCH_SelectTransport(const BENCH_TransportTypeDef *pTransport)
+{
+  uint32_t counter;
+
+  for (counter = 0U; counter < BENCH_TRANSPORTS_NB; counter++)
+  {
+    BENCH_Transports[counter].pLink->Active = 0U;
+  }
+
+  BENCH_LinkReset(pTransport->pLink);
+
+  pTransport->pLink->Active = 1U;
+}
@@ -0,0 +1,74 @@
+/**
+  ******************************************************************************
+  * @file    bench_host.h
+  * @author  MCD Application Team
+  * @brief   Header for bench_host.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef BENCH_HOST_H
+#define BENCH_HOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "bench_link.h"
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct BENCH_TransportStruct BENCH_TransportTypeDef;
+
+struct BENCH_TransportStruct
+{
+  const char *pName;                /* Transport name */
+  BENCH_LinkTypeDef *pLink;         /* Link between the host and the device interface */
+  BENCH_TimingTypeDef Timing;       /* Link timings */
+  const char *pWriteMethod;         /* Write command used by the host */
+  const char *pReadMethod;          /* Read command used by the host */
+  uint32_t WriteChunk;              /* Bytes written per command or per loop, 0 for the whole image */
+  uint32_t ReadChunk;               /* Bytes read per command or per loop, 0 for the whole image */
+  Function_Pointer Flush;           /* Device function sending the buffered bytes after a command, NULL if none */
+  ErrorStatus (*Connect)(const BENCH_TransportTypeDef *pTransport);
+  ErrorStatus (*GetVersion)(const BENCH_TransportTypeDef *pTransport);
+  ErrorStatus (*Erase)(const BENCH_TransportTypeDef *pTransport, uint32_t PagesNumber);
+  ErrorStatus (*Write)(const BENCH_TransportTypeDef *pTransport, uint32_t Address, const uint8_t *pData,
+                       uint32_t Length);
+  ErrorStatus (*Read)(const BENCH_TransportTypeDef *pTransport, uint32_t Address, uint8_t *pData,
+                      uint32_t Length);
+};
+
+typedef struct
+{
+  uint32_t Commands;                /* Number of commands executed by the device */
+  uint64_t CpuTime;                 /* Host CPU time spent in the device code in ns */
+} BENCH_CountersTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+#define BENCH_TRANSPORTS_NB               7U        /* Number of benchmarked transports */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+extern const BENCH_TransportTypeDef BENCH_Transports[BENCH_TRANSPORTS_NB];
+extern BENCH_CountersTypeDef BENCH_Counters;
+
+/* Exported functions ------------------------------------------------------- */
+void BENCH_SelectTransport(const BENCH_TransportTypeDef *pTransport);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_HOST_H */
@@ -0,0 +1,424 @@
+/**
+  ******************************************************************************
+  * @file    bench_link.c
+  * @author  MCD Application Team
+  * @brief   Simulated links between the benchmark host and the Open Bootloader interfaces
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "platform.h"
+#include "common_interface.h"
+#include "bench_link.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define BENCH_QUEUE_MIN_SIZE              4096U     /* Initial size of a queue */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static jmp_buf BenchRunContext;                     /* Context restored when the device code is aborted */
+static uint8_t BenchRunning = 0U;
+
+/* Private function prototypes -----------------------------------------------*/
+static void BENCH_QueuePush(BENCH_QueueTypeDef *pQueue, const void *pData, uint32_t Length);
+static uint32_t BENCH_QueuePop(BENCH_QueueTypeDef *pQueue, void *pData, uint32_t Length);
+static void BENCH_LinkAddTime(BENCH_LinkTypeDef *pLink, uint64_t Time);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to append data to a queue, the queue grows as needed.
+  * @param  pQueue Pointer to the queue.
+  * @param  pData Pointer to the data.
+  * @param  Length The number of bytes.
+  * @retval None.
+  */
+static void BENCH_QueuePush(BENCH_QueueTypeDef *pQueue, const void *pData, uint32_t Length)
+{
+  uint32_t size;
+
+  /* An empty queue restarts from its beginning */
+  if (pQueue->Head == pQueue->Tail)
+  {
+    pQueue->Head = 0U;
+    pQueue->Tail = 0U;
+  }
+
+  if ((pQueue->Size - pQueue->Head) < Length)
+  {
+    size = (pQueue->Size != 0U) ? pQueue->Size : BENCH_QUEUE_MIN_SIZE;
+
+    while ((size - pQueue->Head) < Length)
+    {
+      size *= 2U;
+    }
+
+    pQueue->pData = realloc(pQueue->pData, size);
+
+    if (pQueue->pData == NULL)
+    {
+      perror("Benchmark queue");
+      exit(EXIT_FAILURE);
+    }
+
+    pQueue->Size = size;
+  }
+
+  if (Length != 0U)
+  {
+    (void)memcpy(&pQueue->pData[pQueue->Head], pData, Length);
+    pQueue->Head += Length;
+  }
+}
+
+/**
+  * @brief  This function is used to take data from a queue.
+  * @param  pQueue Pointer to the queue.
+  * @param  pData Pointer to the buffer where the data is stored, NULL to drop it.
+  * @param  Length The number of bytes.
+  * @retval Returns the number of bytes taken, less than Length if the queue is short of data.
+  */
+static uint32_t BENCH_QueuePop(BENCH_QueueTypeDef *pQueue, void *pData, uint32_t Length)
+{
+  uint32_t length;
+
+  length = pQueue->Head - pQueue->Tail;
+
+  if (length > Length)
+  {
+    length = Length;
+  }
+
+  if ((pData != NULL) && (length != 0U))
+  {
+    (void)memcpy(pData, &pQueue->pData[pQueue->Tail], length);
+  }
+
+  pQueue->Tail += length;
+
+  return length;
+}
+
+/**
+  * @brief  This function is used to account the time spent on a link.
+  * @param  pLink Pointer to the link.
+  * @param  Time The time in ns.
+  * @retval None.
+  */
+static void BENCH_LinkAddTime(BENCH_LinkTypeDef *pLink, uint64_t Time)
+{
+  pLink->LinkTime += Time;
+
+  Common_AddVirtualTime(Time);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to initialize a link.
+  * @param  pLink Pointer to the link.
+  * @param  pTiming Pointer to the link timings.
+  * @retval None.
+  */
+void BENCH_LinkInit(BENCH_LinkTypeDef *pLink, const BENCH_TimingTypeDef *pTiming)
+{
+  (void)memset(pLink, 0, sizeof(*pLink));
+
+  pLink->Timing = *pTiming;
+}
+
+/**
+  * @brief  This function is used to drop the pending data of a link and to clear its counters.
+  * @param  pLink Pointer to the link.
+  * @retval None.
+  */
+void BENCH_LinkReset(BENCH_LinkTypeDef *pLink)
+{
+  pLink->HostData.Head   = 0U;
+  pLink->HostData.Tail   = 0U;
+  pLink->HostFrames.Head = 0U;
+  pLink->HostFrames.Tail = 0U;
+  pLink->DeviceData.Head = 0U;
+  pLink->DeviceData.Tail = 0U;
+
+  pLink->Receiving     = 0U;
+  pLink->LinkTime      = 0U;
+  pLink->RoundTrips    = 0U;
+  pLink->Frames        = 0U;
+  pLink->BytesToDevice = 0U;
+  pLink->BytesToHost   = 0U;
+}
+
+/**
+  * @brief  This function is used to release the memory of a link.
+  * @param  pLink Pointer to the link.
+  * @retval None.
+  */
+void BENCH_LinkFree(BENCH_LinkTypeDef *pLink)
+{
+  free(pLink->HostData.pData);
+  free(pLink->HostFrames.pData);
+  free(pLink->DeviceData.pData);
+
+  (void)memset(&pLink->HostData, 0, sizeof(pLink->HostData));
+  (void)memset(&pLink->HostFrames, 0, sizeof(pLink->HostFrames));
+  (void)memset(&pLink->DeviceData, 0, sizeof(pLink->DeviceData));
+}
+
+/**
+  * @brief  This function is used by the device to read bytes sent by the host.
+  *         The device code is aborted if the host did not send enough data.
+  * @param  pLink Pointer to the link.
+  * @param  pBuffer Pointer to the buffer where the bytes are stored.
+  * @param  Length The number of bytes.
+  * @retval None.
+  */
+void BENCH_LinkRead(BENCH_LinkTypeDef *pLink, uint8_t *pBuffer, uint32_t Length)
+{
+  if (BENCH_QueuePop(&pLink->HostData, pBuffer, Length) != Length)
+  {
+    BENCH_Abort();
+  }
+
+  pLink->Receiving      = 1U;
+  pLink->BytesToDevice += Length;
+
+  BENCH_LinkAddTime(pLink, (uint64_t)Length * pLink->Timing.ByteTime);
+}
+
+/**
+  * @brief  This function is used by the device to read a frame sent by the host.
+  *         The device code is aborted if the host did not send any frame.
+  * @param  pLink Pointer to the link.
+  * @param  pIdentifier Pointer to the returned frame identifier, NULL if not needed.
+  * @param  pBuffer Pointer to the buffer where the frame data is stored.
+  * @param  Size The size of the buffer, the data exceeding it is dropped.
+  * @retval Returns the frame length.
+  */
+uint32_t BENCH_LinkReadFrame(BENCH_LinkTypeDef *pLink, uint32_t *pIdentifier, uint8_t *pBuffer, uint32_t Size)
+{
+  BENCH_FrameTypeDef frame;
+  uint32_t length;
+
+  if (BENCH_QueuePop(&pLink->HostFrames, &frame, sizeof(frame)) != sizeof(frame))
+  {
+    BENCH_Abort();
+  }
+
+  length = (frame.Length < Size) ? frame.Length : Size;
+
+  (void)BENCH_QueuePop(&pLink->HostData, pBuffer, length);
+  (void)BENCH_QueuePop(&pLink->HostData, NULL, frame.Length - length);
+
+  if (pIdentifier != NULL)
+  {
+    *pIdentifier = frame.Identifier;
+  }
+
+  pLink->Receiving      = 1U;
+  pLink->BytesToDevice += frame.Length;
+  pLink->Frames++;
+
+  BENCH_LinkAddTime(pLink, pLink->Timing.FrameTime + ((uint64_t)frame.Length * pLink->Timing.ByteTime));
+
+  return frame.Length;
+}
+
+/**
+  * @brief  This function is used by the device to send bytes to the host.
+  *         A response following a reception costs a host turnaround.
+  * @param  pLink Pointer to the link.
+  * @param  pBuffer Pointer to the bytes.
+  * @param  Length The number of bytes, split in frames on a framed link.
+  * @retval None.
+  */
+void BENCH_LinkWrite(BENCH_LinkTypeDef *pLink, const uint8_t *pBuffer, uint32_t Length)
+{
+  uint32_t frames = 0U;
+
+  if (pLink->Receiving == 1U)
+  {
+    pLink->Receiving = 0U;
+    pLink->RoundTrips++;
+
+    BENCH_LinkAddTime(pLink, pLink->Timing.TurnaroundTime);
+  }
+
+  if (pLink->Timing.FrameSize != 0U)
+  {
+    frames = (Length + pLink->Timing.FrameSize - 1U) / pLink->Timing.FrameSize;
+  }
+
+  BENCH_QueuePush(&pLink->DeviceData, pBuffer, Length);
+
+  pLink->BytesToHost += Length;
+  pLink->Frames      += frames;
+
+  BENCH_LinkAddTime(pLink, ((uint64_t)frames * pLink->Timing.FrameTime) + ((uint64_t)Length * pLink->Timing.ByteTime));
+}
+
+/**
+  * @brief  This function is used by the device to account a bus transaction not carried by a frame,
+  *         e.g. the start and address phases of an I2C transfer.
+  * @param  pLink Pointer to the link.
+  * @retval None.
+  */
+void BENCH_LinkTransaction(BENCH_LinkTypeDef *pLink)
+{
+  pLink->Frames++;
+
+  BENCH_LinkAddTime(pLink, pLink->Timing.FrameTime);
+}
+
+/**
+  * @brief  This function is used by the device to get the number of bytes sent by the host and not read yet.
+  * @param  pLink Pointer to the link.
+  * @retval Returns the number of bytes.
+  */
+uint32_t BENCH_LinkPending(const BENCH_LinkTypeDef *pLink)
+{
+  return pLink->HostData.Head - pLink->HostData.Tail;
+}
+
+/**
+  * @brief  This function is used by the device to get the next byte sent by the host without reading it.
+  * @param  pLink Pointer to the link.
+  * @retval Returns the byte, 0 if there is none.
+  */
+uint8_t BENCH_LinkPeek(const BENCH_LinkTypeDef *pLink)
+{
+  return (BENCH_LinkPending(pLink) != 0U) ? pLink->HostData.pData[pLink->HostData.Tail] : 0U;
+}
+
+/**
+  * @brief  This function is used by the host to send bytes to the device.
+  * @param  pLink Pointer to the link.
+  * @param  pBuffer Pointer to the bytes.
+  * @param  Length The number of bytes.
+  * @retval None.
+  */
+void BENCH_HostSend(BENCH_LinkTypeDef *pLink, const uint8_t *pBuffer, uint32_t Length)
+{
+  BENCH_QueuePush(&pLink->HostData, pBuffer, Length);
+}
+
+/**
+  * @brief  This function is used by the host to send a frame to the device.
+  * @param  pLink Pointer to the link.
+  * @param  Identifier The frame identifier.
+  * @param  pBuffer Pointer to the frame data.
+  * @param  Length The number of data bytes.
+  * @retval None.
+  */
+void BENCH_HostSendFrame(BENCH_LinkTypeDef *pLink, uint32_t Identifier, const uint8_t *pBuffer, uint32_t Length)
+{
+  BENCH_FrameTypeDef frame;
+
+  frame.Identifier = Identifier;
+  frame.Length     = Length;
+
+  BENCH_QueuePush(&pLink->HostFrames, &frame, sizeof(frame));
+  BENCH_QueuePush(&pLink->HostData, pBuffer, Length);
+}
+
+/**
+  * @brief  This function is used by the host to receive bytes sent by the device.
+  * @param  pLink Pointer to the link.
+  * @param  pBuffer Pointer to the buffer where the bytes are stored, NULL to drop them.
+  * @param  Length The number of bytes.
+  * @retval Returns ERROR if the device sent less bytes else SUCCESS.
+  */
+ErrorStatus BENCH_HostReceive(BENCH_LinkTypeDef *pLink, uint8_t *pBuffer, uint32_t Length)
+{
+  return (BENCH_QueuePop(&pLink->DeviceData, pBuffer, Length) == Length) ? SUCCESS : ERROR;
+}
+
+/**
+  * @brief  This function is used by the host to check the bytes sent by the device.
+  * @param  pLink Pointer to the link.
+  * @param  pExpected Pointer to the expected bytes.
+  * @param  Length The number of bytes.
+  * @retval Returns ERROR if the device sent other bytes else SUCCESS.
+  */
+ErrorStatus BENCH_HostExpect(BENCH_LinkTypeDef *pLink, const uint8_t *pExpected, uint32_t Length)
+{
+  ErrorStatus status = ERROR;
+  uint32_t length;
+
+  length = pLink->DeviceData.Head - pLink->DeviceData.Tail;
+
+  if ((length >= Length) && (memcmp(&pLink->DeviceData.pData[pLink->DeviceData.Tail], pExpected, Length) == 0))
+  {
+    pLink->DeviceData.Tail += Length;
+
+    status = SUCCESS;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used by the host to get the number of bytes sent by the device and not read yet.
+  * @param  pLink Pointer to the link.
+  * @retval Returns the number of bytes.
+  */
+uint32_t BENCH_HostPending(const BENCH_LinkTypeDef *pLink)
+{
+  return pLink->DeviceData.Head - pLink->DeviceData.Tail;
+}
+
+/**
+  * @brief  This function is used to run device code, it returns once the code is done or aborted.
+  * @param  pFunction The device function.
+  * @retval Returns ERROR if the device code has been aborted else SUCCESS.
+  */
+ErrorStatus BENCH_Run(Function_Pointer pFunction)
+{
+  ErrorStatus status = SUCCESS;
+
+  if (setjmp(BenchRunContext) == 0)
+  {
+    BenchRunning = 1U;
+
+    pFunction();
+  }
+  else
+  {
+    status = ERROR;
+  }
+
+  BenchRunning = 0U;
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to abort the device code when it waits for data the host will never send.
+  * @retval None.
+  */
+void BENCH_Abort(void)
+{
+  if (BenchRunning == 0U)
+  {
+    (void)fprintf(stderr, "Benchmark: the device waits for data out of a command\n");
+    exit(EXIT_FAILURE);
+  }
+
+  longjmp(BenchRunContext, 1);
+}
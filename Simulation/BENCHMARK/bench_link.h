@@ -0,0 +1,99 @@
+/**
+  ******************************************************************************
+  * @file    bench_link.h
+  * @author  MCD Application Team
+  * @brief   Header for bench_link.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef BENCH_LINK_H
+#define BENCH_LINK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "common_interface.h"
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t ByteTime;                /* Time to transfer one data byte in ns */
+  uint32_t FrameTime;               /* Overhead of one frame or bus transaction in ns */
+  uint32_t FrameSize;               /* Maximum data bytes of a frame, 0 if the data is not framed */
+  uint32_t TurnaroundTime;          /* Time taken by the host to react to a response in ns */
+} BENCH_TimingTypeDef;
+
+typedef struct
+{
+  uint8_t *pData;                   /* Bytes, or frame descriptors for a frame queue */
+  uint32_t Size;                    /* Allocated size in bytes */
+  uint32_t Head;                    /* Write index */
+  uint32_t Tail;                    /* Read index */
+} BENCH_QueueTypeDef;
+
+typedef struct
+{
+  uint32_t Identifier;              /* Frame identifier, the command opcode on CAN buses */
+  uint32_t Length;                  /* Number of data bytes */
+} BENCH_FrameTypeDef;
+
+typedef struct
+{
+  BENCH_TimingTypeDef Timing;
+  BENCH_QueueTypeDef HostData;      /* Bytes sent by the host, not yet read by the device */
+  BENCH_QueueTypeDef HostFrames;    /* Frames sent by the host, for the framed interfaces */
+  BENCH_QueueTypeDef DeviceData;    /* Bytes sent by the device, not yet read by the host */
+  uint8_t Active;                   /* 1 when the host talks on this link */
+  uint8_t Receiving;                /* 1 when the last device operation was a reception */
+  uint64_t LinkTime;                /* Time spent on the link in ns */
+  uint32_t RoundTrips;              /* Number of times the host waited for a response */
+  uint32_t Frames;                  /* Number of frames or bus transactions */
+  uint64_t BytesToDevice;           /* Bytes read by the device */
+  uint64_t BytesToHost;             /* Bytes sent by the device */
+} BENCH_LinkTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void BENCH_LinkInit(BENCH_LinkTypeDef *pLink, const BENCH_TimingTypeDef *pTiming);
+void BENCH_LinkReset(BENCH_LinkTypeDef *pLink);
+void BENCH_LinkFree(BENCH_LinkTypeDef *pLink);
+
+/* Device side */
+void BENCH_LinkRead(BENCH_LinkTypeDef *pLink, uint8_t *pBuffer, uint32_t Length);
+uint32_t BENCH_LinkReadFrame(BENCH_LinkTypeDef *pLink, uint32_t *pIdentifier, uint8_t *pBuffer, uint32_t Size);
+void BENCH_LinkWrite(BENCH_LinkTypeDef *pLink, const uint8_t *pBuffer, uint32_t Length);
+void BENCH_LinkTransaction(BENCH_LinkTypeDef *pLink);
+uint32_t BENCH_LinkPending(const BENCH_LinkTypeDef *pLink);
+uint8_t BENCH_LinkPeek(const BENCH_LinkTypeDef *pLink);
+
+/* Host side */
+void BENCH_HostSend(BENCH_LinkTypeDef *pLink, const uint8_t *pBuffer, uint32_t Length);
+void BENCH_HostSendFrame(BENCH_LinkTypeDef *pLink, uint32_t Identifier, const uint8_t *pBuffer, uint32_t Length);
+ErrorStatus BENCH_HostReceive(BENCH_LinkTypeDef *pLink, uint8_t *pBuffer, uint32_t Length);
+ErrorStatus BENCH_HostExpect(BENCH_LinkTypeDef *pLink, const uint8_t *pExpected, uint32_t Length);
+uint32_t BENCH_HostPending(const BENCH_LinkTypeDef *pLink);
+
+/* Execution of the device code */
+ErrorStatus BENCH_Run(Function_Pointer pFunction);
+void BENCH_Abort(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_LINK_H */
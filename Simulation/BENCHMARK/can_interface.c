@@ -0,0 +1,142 @@
+/**
+  ******************************************************************************
+  * @file    can_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains the CAN interface of the benchmark, running over a simulated link
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbl_core.h"
+#include "openbl_can_cmd.h"
+#include "common_interface.h"
+#include "can_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define CAN_FRAME_SIZE                    8U        /* Data bytes of a classic CAN frame */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+BENCH_LinkTypeDef CAN_Link;
+uint8_t tCanRxData[CAN_RAM_BUFFER_SIZE];
+
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to configure the CAN, the link is set up by the benchmark.
+  * @retval None.
+  */
+void OPENBL_CAN_Configuration(void)
+{
+}
+
+/**
+  * @brief  This function is used to De-initialize the CAN.
+  * @retval None.
+  */
+void OPENBL_CAN_DeInit(void)
+{
+}
+
+/**
+  * @brief  This function is used to detect if there is any activity on CAN protocol.
+  * @retval Returns 1 if interface is detected else 0.
+  */
+uint8_t OPENBL_CAN_ProtocolDetection(void)
+{
+  return CAN_Link.Active;
+}
+
+/**
+  * @brief  This function is used to get the command opcode from the host.
+  *         The opcode is the frame identifier, the frame data is stored in tCanRxData.
+  * @retval Returns the command.
+  */
+uint8_t OPENBL_CAN_GetCommandOpcode(void)
+{
+  uint32_t identifier;
+
+  (void)BENCH_LinkReadFrame(&CAN_Link, &identifier, tCanRxData, CAN_FRAME_SIZE);
+
+  return (uint8_t)identifier;
+}
+
+/**
+  * @brief  This function is used to read one byte from CAN pipe.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_CAN_ReadByte(void)
+{
+  uint8_t byte = 0U;
+
+  (void)BENCH_LinkReadFrame(&CAN_Link, NULL, &byte, 1U);
+
+  return byte;
+}
+
+/**
+  * @brief  This function is used to read one frame from CAN pipe.
+  * @param  Buffer The buffer that stores the received data.
+  * @param  BufferSize The size of the buffer.
+  * @retval None.
+  */
+void OPENBL_CAN_ReadBytes(uint8_t *Buffer, uint32_t BufferSize)
+{
+  (void)BENCH_LinkReadFrame(&CAN_Link, NULL, Buffer, BufferSize);
+}
+
+/**
+  * @brief  This function is used to send one byte through CAN pipe.
+  * @param  Byte The byte to be sent.
+  * @retval None.
+  */
+void OPENBL_CAN_SendByte(uint8_t Byte)
+{
+  BENCH_LinkWrite(&CAN_Link, &Byte, 1U);
+}
+
+/**
+  * @brief  This function is used to send one frame through CAN pipe.
+  * @param  Buffer The data of the frame.
+  * @param  BufferSize The number of bytes of the frame.
+  * @retval None.
+  */
+void OPENBL_CAN_SendBytes(uint8_t *Buffer, uint32_t BufferSize)
+{
+  BENCH_LinkWrite(&CAN_Link, Buffer, BufferSize);
+}
+
+/**
+  * @brief  This function is used to change the CAN speed, the simulated link keeps its timing.
+  * @param  Prescaler The speed index sent by the host.
+  * @retval None.
+  */
+void OPENBL_CAN_ChangePrescaler(uint32_t Prescaler)
+{
+  (void)Prescaler;
+}
+
+/**
+  * @brief  This function is used to wait the given number of milliseconds.
+  * @param  Delay The delay in ms.
+  * @retval None.
+  */
+void HAL_Delay(uint32_t Delay)
+{
+  Common_Delay(Delay * 1000U);
+}
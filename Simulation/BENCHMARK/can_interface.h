@@ -0,0 +1,58 @@
+/**
+  ******************************************************************************
+  * @file    can_interface.h
+  * @author  MCD Application Team
+  * @brief   Header for can_interface.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef CAN_INTERFACE_H
+#define CAN_INTERFACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "openbl_core.h"
+#include "bench_link.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+#define CAN_DLC_BYTES_2                   2U        /* The simulated frames carry their length in bytes */
+#define CAN_DLC_BYTES_8                   8U
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+extern BENCH_LinkTypeDef CAN_Link;
+
+/* Exported functions ------------------------------------------------------- */
+void OPENBL_CAN_Configuration(void);
+void OPENBL_CAN_DeInit(void);
+uint8_t OPENBL_CAN_ProtocolDetection(void);
+
+uint8_t OPENBL_CAN_GetCommandOpcode(void);
+uint8_t OPENBL_CAN_ReadByte(void);
+void OPENBL_CAN_ReadBytes(uint8_t *Buffer, uint32_t BufferSize);
+void OPENBL_CAN_SendByte(uint8_t Byte);
+void OPENBL_CAN_SendBytes(uint8_t *Buffer, uint32_t BufferSize);
+void OPENBL_CAN_ChangePrescaler(uint32_t Prescaler);
+void HAL_Delay(uint32_t Delay);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CAN_INTERFACE_H */
@@ -0,0 +1,169 @@
+/**
+  ******************************************************************************
+  * @file    fdcan_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains the FDCAN interface of the benchmark, running over a simulated link
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbl_core.h"
+#include "openbl_fdcan_cmd.h"
+#include "fdcan_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define FDCAN_FRAME_SIZE                  64U       /* Data bytes of a CAN FD frame */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+BENCH_LinkTypeDef FDCAN_Link;
+
+uint8_t *TxData;
+uint8_t *RxData;
+
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to configure the FDCAN, the link is set up by the benchmark.
+  * @retval None.
+  */
+void OPENBL_FDCAN_Configuration(void)
+{
+  /* The frame buffers are taken from the arena shared by all the interfaces */
+  TxData = OPENBL_GetBuffer(2U * FDCAN_RAM_BUFFER_SIZE);
+  RxData = &TxData[FDCAN_RAM_BUFFER_SIZE];
+}
+
+/**
+  * @brief  This function is used to De-initialize the FDCAN.
+  * @retval None.
+  */
+void OPENBL_FDCAN_DeInit(void)
+{
+}
+
+/**
+  * @brief  This function is used to detect if there is any activity on FDCAN protocol.
+  * @retval Returns 1 if interface is detected else 0.
+  */
+uint8_t OPENBL_FDCAN_ProtocolDetection(void)
+{
+  return FDCAN_Link.Active;
+}
+
+/**
+  * @brief  This function is used to get the command opcode from the host.
+  *         The opcode is the frame identifier, the frame data is stored in RxData.
+  * @retval Returns the command.
+  */
+uint8_t OPENBL_FDCAN_GetCommandOpcode(void)
+{
+  uint32_t identifier;
+
+  (void)BENCH_LinkReadFrame(&FDCAN_Link, &identifier, RxData, FDCAN_FRAME_SIZE);
+
+  return (uint8_t)identifier;
+}
+
+/**
+  * @brief  This function is used to read one byte from FDCAN pipe.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_FDCAN_ReadByte(void)
+{
+  uint8_t byte = 0U;
+
+  (void)BENCH_LinkReadFrame(&FDCAN_Link, NULL, &byte, 1U);
+
+  return byte;
+}
+
+/**
+  * @brief  This function is used to read one frame from FDCAN pipe.
+  * @param  Buffer The buffer that stores the received data.
+  * @param  BufferSize The size of the buffer.
+  * @retval None.
+  */
+void OPENBL_FDCAN_ReadBytes(uint8_t *Buffer, uint32_t BufferSize)
+{
+  (void)BENCH_LinkReadFrame(&FDCAN_Link, NULL, Buffer, BufferSize);
+}
+
+/**
+  * @brief  This function is used to read frames from FDCAN pipe until a buffer is filled.
+  *         The padding bytes of the last frame are dropped.
+  * @param  Buffer The buffer that stores the received data.
+  * @param  BufferSize The number of bytes to be read.
+  * @retval Returns the number of bytes stored in the buffer.
+  */
+uint32_t OPENBL_FDCAN_ReadFrames(uint8_t *Buffer, uint32_t BufferSize)
+{
+  uint32_t received = 0U;
+  uint32_t length;
+
+  while (received < BufferSize)
+  {
+    length = BENCH_LinkReadFrame(&FDCAN_Link, NULL, &Buffer[received], BufferSize - received);
+
+    received += (length < (BufferSize - received)) ? length : (BufferSize - received);
+  }
+
+  return received;
+}
+
+/**
+  * @brief  This function is used to send one byte through FDCAN pipe.
+  * @param  Byte The byte to be sent.
+  * @retval None.
+  */
+void OPENBL_FDCAN_SendByte(uint8_t Byte)
+{
+  BENCH_LinkWrite(&FDCAN_Link, &Byte, 1U);
+}
+
+/**
+  * @brief  This function is used to send one frame through FDCAN pipe.
+  * @param  Buffer The data of the frame.
+  * @param  BufferSize The number of bytes of the frame.
+  * @retval None.
+  */
+void OPENBL_FDCAN_SendBytes(uint8_t *Buffer, uint32_t BufferSize)
+{
+  BENCH_LinkWrite(&FDCAN_Link, Buffer, BufferSize);
+}
+
+/**
+  * @brief  This function is used to process and execute the special commands.
+  *         No special command is supported by the benchmark.
+  * @param  Frame Pointer to the OPENBL_SpecialCmdTypeDef structure.
+  * @retval None.
+  */
+void OPENBL_FDCAN_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *Frame)
+{
+  TxData[0] = 0x00U;
+  TxData[1] = 0x00U;
+
+  if (Frame->CmdType == OPENBL_SPECIAL_CMD)
+  {
+    /* Send NULL data size */
+    OPENBL_FDCAN_SendBytes(TxData, FDCAN_DLC_BYTES_2);
+  }
+
+  /* Send NULL status size */
+  OPENBL_FDCAN_SendBytes(TxData, FDCAN_DLC_BYTES_2);
+}
@@ -0,0 +1,187 @@
+/**
+  ******************************************************************************
+  * @file    i2c_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains the I2C interface of the benchmark, running over a simulated link
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbl_core.h"
+#include "openbl_i2c_cmd.h"
+#include "i2c_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+BENCH_LinkTypeDef I2C_Link;
+
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to configure the I2C, the link is set up by the benchmark.
+  * @retval None.
+  */
+void OPENBL_I2C_Configuration(void)
+{
+}
+
+/**
+  * @brief  This function is used to De-initialize the I2C.
+  * @retval None.
+  */
+void OPENBL_I2C_DeInit(void)
+{
+}
+
+/**
+  * @brief  This function is used to detect if there is any activity on I2C protocol.
+  * @retval Returns 1 if interface is detected else 0.
+  */
+uint8_t OPENBL_I2C_ProtocolDetection(void)
+{
+  return I2C_Link.Active;
+}
+
+/**
+  * @brief  This function is used to get the command opcode from the host.
+  * @retval Returns the command.
+  */
+uint8_t OPENBL_I2C_GetCommandOpcode(void)
+{
+  uint8_t command_opc = 0x0U;
+
+  OPENBL_I2C_WaitAddress();
+
+  /* Get the command opcode */
+  command_opc = OPENBL_I2C_ReadByte();
+
+  /* Check the data integrity */
+  if ((command_opc ^ OPENBL_I2C_ReadByte()) != 0xFFU)
+  {
+    command_opc = ERROR_COMMAND;
+  }
+
+  OPENBL_I2C_WaitStop();
+
+  return command_opc;
+}
+
+/**
+  * @brief  This function is used to read one byte from I2C pipe.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_I2C_ReadByte(void)
+{
+  uint8_t byte;
+
+  BENCH_LinkRead(&I2C_Link, &byte, 1U);
+
+  return byte;
+}
+
+/**
+  * @brief  This function is used to send one byte through I2C pipe.
+  * @param  Byte The byte to be sent.
+  * @retval None.
+  */
+void OPENBL_I2C_SendByte(uint8_t Byte)
+{
+  BENCH_LinkWrite(&I2C_Link, &Byte, 1U);
+}
+
+/**
+  * @brief  This function is used to wait until the address is matched, it accounts the start and address phases.
+  * @retval None.
+  */
+void OPENBL_I2C_WaitAddress(void)
+{
+  BENCH_LinkTransaction(&I2C_Link);
+}
+
+/**
+  * @brief  This function is used to wait until NACK is detected.
+  * @retval None.
+  */
+void OPENBL_I2C_WaitNack(void)
+{
+}
+
+/**
+  * @brief  This function is used to wait until STOP is detected.
+  * @retval None.
+  */
+void OPENBL_I2C_WaitStop(void)
+{
+}
+
+/**
+  * @brief  This function is used to send Acknowledgement.
+  * @param  Byte The acknowledge byte.
+  * @retval None.
+  */
+void OPENBL_I2C_SendAcknowledgeByte(uint8_t Byte)
+{
+  /* Wait until address is matched */
+  OPENBL_I2C_WaitAddress();
+
+  /* Send ACK or NACK byte */
+  OPENBL_I2C_SendByte(Byte);
+
+  /* Wait until NACK is detected */
+  OPENBL_I2C_WaitNack();
+
+  /* Wait until STOP byte is detected*/
+  OPENBL_I2C_WaitStop();
+}
+
+/**
+  * @brief  This function is used to process and execute the special commands.
+  *         No special command is supported by the benchmark.
+  * @param  SpecialCmd Pointer to the OPENBL_SpecialCmdTypeDef structure.
+  * @retval None.
+  */
+void OPENBL_I2C_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *SpecialCmd)
+{
+  if (SpecialCmd->CmdType == OPENBL_SPECIAL_CMD)
+  {
+    /* Send NULL data size */
+    OPENBL_I2C_SendByte(0x00U);
+    OPENBL_I2C_SendByte(0x00U);
+  }
+
+  /* Send NULL status size */
+  OPENBL_I2C_SendByte(0x00U);
+  OPENBL_I2C_SendByte(0x00U);
+}
+
+/**
+  * @brief  This function is used to enable the busy state sending, nothing is sent by the benchmark.
+  * @retval None.
+  */
+void OPENBL_Enable_BusyState_Sending(void)
+{
+}
+
+/**
+  * @brief  This function is used to disable the busy state sending.
+  * @retval None.
+  */
+void OPENBL_Disable_BusyState_Sending(void)
+{
+}
@@ -0,0 +1,159 @@
+/**
+  ******************************************************************************
+  * @file    i3c_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains the I3C interface of the benchmark, running over a simulated link
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbl_core.h"
+#include "openbl_i3c_cmd.h"
+#include "i3c_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+BENCH_LinkTypeDef I3C_Link;
+
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to configure the I3C, the link is set up by the benchmark.
+  * @retval None.
+  */
+void OPENBL_I3C_Configuration(void)
+{
+}
+
+/**
+  * @brief  This function is used to De-initialize the I3C.
+  * @retval None.
+  */
+void OPENBL_I3C_DeInit(void)
+{
+}
+
+/**
+  * @brief  This function is used to detect if there is any activity on I3C protocol.
+  * @retval Returns 1 if interface is detected else 0.
+  */
+uint8_t OPENBL_I3C_ProtocolDetection(void)
+{
+  return I3C_Link.Active;
+}
+
+/**
+  * @brief  This function is used to get the command opcode from the host, sent in one private write.
+  * @retval Returns the command.
+  */
+uint8_t OPENBL_I3C_GetCommandOpcode(void)
+{
+  uint8_t buffer[2];
+
+  OPENBL_I3C_ReadBytes(buffer, 2U);
+
+  /* Check data integrity using XOR value */
+  return ((buffer[0] ^ buffer[1]) != 0xFFU) ? ERROR_COMMAND : buffer[0];
+}
+
+/**
+  * @brief  This function is used to read one byte of the current private write.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_I3C_ReadByte(void)
+{
+  uint8_t byte;
+
+  BENCH_LinkRead(&I3C_Link, &byte, 1U);
+
+  return byte;
+}
+
+/**
+  * @brief  This function is used to send one byte in a private read.
+  * @param  Byte The byte to be sent.
+  * @retval None.
+  */
+void OPENBL_I3C_SendByte(uint8_t Byte)
+{
+  OPENBL_I3C_SendBytes(&Byte, 1U);
+}
+
+/**
+  * @brief  This function is used to send an acknowledge in an in-band interrupt.
+  * @param  Acknowledge The acknowledge byte.
+  * @retval None.
+  */
+void OPENBL_I3C_SendAcknowledgeByte(uint8_t Acknowledge)
+{
+  OPENBL_I3C_SendBytes(&Acknowledge, 1U);
+}
+
+/**
+  * @brief  This function is used to notify the host that a long operation is in progress.
+  *         The progress in-band interrupts are not used by the benchmark.
+  * @retval None.
+  */
+void OPENBL_I3C_SendProgress(void)
+{
+}
+
+/**
+  * @brief  This function is used to send bytes in one private read.
+  * @param  pBuffer Pointer to the buffer to be sent.
+  * @param  BufferSize The number of bytes to be sent.
+  * @retval None.
+  */
+void OPENBL_I3C_SendBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+  BENCH_LinkWrite(&I3C_Link, pBuffer, BufferSize);
+  BENCH_LinkTransaction(&I3C_Link);
+}
+
+/**
+  * @brief  This function is used to read bytes sent in one private write.
+  * @param  pBuffer Pointer to the buffer where the read bytes are stored.
+  * @param  BufferSize The number of bytes to be read.
+  * @retval None.
+  */
+void OPENBL_I3C_ReadBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+  BENCH_LinkTransaction(&I3C_Link);
+  BENCH_LinkRead(&I3C_Link, pBuffer, BufferSize);
+}
+
+/**
+  * @brief  This function is used to process and execute the special commands.
+  *         No special command is supported by the benchmark.
+  * @param  SpecialCmd Pointer to the OPENBL_SpecialCmdTypeDef structure.
+  * @retval None.
+  */
+void OPENBL_I3C_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *SpecialCmd)
+{
+  uint8_t status[2] = {0x00U, 0x00U};
+
+  if (SpecialCmd->CmdType == OPENBL_SPECIAL_CMD)
+  {
+    /* Send NULL data size */
+    OPENBL_I3C_SendBytes(status, 2U);
+  }
+
+  /* Send NULL status size */
+  OPENBL_I3C_SendBytes(status, 2U);
+}
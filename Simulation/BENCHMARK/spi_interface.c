@@ -0,0 +1,163 @@
+/**
+  ******************************************************************************
+  * @file    spi_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains the SPI interface of the benchmark, running over a simulated link
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbl_core.h"
+#include "openbl_spi_cmd.h"
+#include "spi_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+BENCH_LinkTypeDef SPI_Link;
+
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to configure the SPI, the link is set up by the benchmark.
+  * @retval None.
+  */
+void OPENBL_SPI_Configuration(void)
+{
+}
+
+/**
+  * @brief  This function is used to De-initialize the SPI.
+  * @retval None.
+  */
+void OPENBL_SPI_DeInit(void)
+{
+}
+
+/**
+  * @brief  This function is used to detect if there is any activity on SPI protocol.
+  * @retval Returns 1 if interface is detected else 0.
+  */
+uint8_t OPENBL_SPI_ProtocolDetection(void)
+{
+  return SPI_Link.Active;
+}
+
+/**
+  * @brief  This function is used to get the command opcode from the host.
+  * @retval Returns the command.
+  */
+uint8_t OPENBL_SPI_GetCommandOpcode(void)
+{
+  uint8_t command_opc;
+
+  /* Check if there is any activity on SPI */
+  while (OPENBL_SPI_ReadByte() != SPI_SYNC_BYTE)
+  {}
+
+  /* Get the command opcode */
+  command_opc = OPENBL_SPI_ReadByte();
+
+  /* Check the data integrity */
+  if ((command_opc ^ OPENBL_SPI_ReadByte()) != 0xFFU)
+  {
+    command_opc = ERROR_COMMAND;
+  }
+
+  return command_opc;
+}
+
+/**
+  * @brief  This function is used to read one byte from SPI pipe.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_SPI_ReadByte(void)
+{
+  uint8_t byte;
+
+  BENCH_LinkRead(&SPI_Link, &byte, 1U);
+
+  return byte;
+}
+
+/**
+  * @brief  This function is used to send one byte through SPI pipe.
+  * @param  Byte The byte to be sent.
+  * @retval None.
+  */
+void OPENBL_SPI_SendByte(uint8_t Byte)
+{
+  BENCH_LinkWrite(&SPI_Link, &Byte, 1U);
+}
+
+/**
+  * @brief  This function is used to send Acknowledgement.
+  * @param  Byte The acknowledge byte.
+  * @retval None.
+  */
+void OPENBL_SPI_SendAcknowledgeByte(uint8_t Byte)
+{
+  /* Check the AN4286 for the acknowledge procedure */
+  if (Byte == ACK_BYTE)
+  {
+    /* Send dummy byte */
+    OPENBL_SPI_SendByte(SPI_DUMMY_BYTE);
+  }
+
+  OPENBL_SPI_SendByte(Byte);
+
+  /* Wait for the host to send ACK synchronization byte */
+  while (OPENBL_SPI_ReadByte() != ACK_BYTE)
+  {}
+}
+
+/**
+  * @brief  This function is used to process and execute the special commands.
+  *         No special command is supported by the benchmark.
+  * @param  SpecialCmd Pointer to the OPENBL_SpecialCmdTypeDef structure.
+  * @retval None.
+  */
+void OPENBL_SPI_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *SpecialCmd)
+{
+  if (SpecialCmd->CmdType == OPENBL_SPECIAL_CMD)
+  {
+    /* Send NULL data size */
+    OPENBL_SPI_SendByte(0x00U);
+    OPENBL_SPI_SendByte(0x00U);
+  }
+
+  /* Send NULL status size */
+  OPENBL_SPI_SendByte(0x00U);
+  OPENBL_SPI_SendByte(0x00U);
+}
+
+/**
+  * @brief  This function is used to enable the busy state, nothing is sent by the benchmark.
+  * @retval None.
+  */
+void OPENBL_SPI_EnableBusyState(void)
+{
+}
+
+/**
+  * @brief  This function is used to disable the busy state.
+  * @retval None.
+  */
+void OPENBL_SPI_DisableBusyState(void)
+{
+}
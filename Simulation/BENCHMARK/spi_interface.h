@@ -0,0 +1,58 @@
+/**
+  ******************************************************************************
+  * @file    spi_interface.h
+  * @author  MCD Application Team
+  * @brief   Header for spi_interface.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SPI_INTERFACE_H
+#define SPI_INTERFACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "openbl_core.h"
+#include "bench_link.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+#define SPI_SYNC_BYTE                     0x5AU     /* Synchronization byte sent by the host before each command */
+#define SPI_DUMMY_BYTE                    0x00U     /* Dummy byte sent before an acknowledge */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+extern BENCH_LinkTypeDef SPI_Link;
+
+/* Exported functions ------------------------------------------------------- */
+void OPENBL_SPI_Configuration(void);
+void OPENBL_SPI_DeInit(void);
+uint8_t OPENBL_SPI_ProtocolDetection(void);
+
+uint8_t OPENBL_SPI_GetCommandOpcode(void);
+uint8_t OPENBL_SPI_ReadByte(void);
+void OPENBL_SPI_SendByte(uint8_t Byte);
+void OPENBL_SPI_SendAcknowledgeByte(uint8_t Byte);
+void OPENBL_SPI_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *SpecialCmd);
+void OPENBL_SPI_EnableBusyState(void);
+void OPENBL_SPI_DisableBusyState(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPI_INTERFACE_H */
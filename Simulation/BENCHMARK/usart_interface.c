@@ -0,0 +1,167 @@
+/**
+  ******************************************************************************
+  * @file    usart_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains the USART interface of the benchmark, running over a simulated link
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbl_core.h"
+#include "openbl_usart_cmd.h"
+#include "usart_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define USART_SYNC_BYTE                   0x7FU     /* Synchronization byte sent by the host */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint8_t UsartDetected = 0U;
+
+/* Exported variables --------------------------------------------------------*/
+BENCH_LinkTypeDef USART_Link;
+
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to configure the USART, the link is set up by the benchmark.
+  * @retval None.
+  */
+void OPENBL_USART_Configuration(void)
+{
+}
+
+/**
+  * @brief  This function is used to De-initialize the USART.
+  * @retval None.
+  */
+void OPENBL_USART_DeInit(void)
+{
+}
+
+/**
+  * @brief  This function is used to detect if there is any activity on USART protocol.
+  *         The host synchronization byte is acknowledged once, when the host starts using the link.
+  * @retval Returns 1 if interface is detected else 0.
+  */
+uint8_t OPENBL_USART_ProtocolDetection(void)
+{
+  if (USART_Link.Active == 0U)
+  {
+    UsartDetected = 0U;
+  }
+  else if ((UsartDetected == 0U) && (BENCH_LinkPeek(&USART_Link) == USART_SYNC_BYTE))
+  {
+    (void)OPENBL_USART_ReadByte();
+
+    /* Acknowledge the host */
+    OPENBL_USART_SendByte(ACK_BYTE);
+
+    UsartDetected = 1U;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  return UsartDetected;
+}
+
+/**
+  * @brief  This function is used to get the command opcode from the host.
+  * @retval Returns the command.
+  */
+uint8_t OPENBL_USART_GetCommandOpcode(void)
+{
+  uint8_t command_opc = 0x0;
+
+  /* Get the command opcode */
+  command_opc = OPENBL_USART_ReadByte();
+
+  /* Check the data integrity */
+  if ((command_opc ^ OPENBL_USART_ReadByte()) != 0xFF)
+  {
+    command_opc = ERROR_COMMAND;
+  }
+
+  return command_opc;
+}
+
+/**
+  * @brief  This function is used to read one byte from USART pipe.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_USART_ReadByte(void)
+{
+  uint8_t byte;
+
+  BENCH_LinkRead(&USART_Link, &byte, 1U);
+
+  return byte;
+}
+
+/**
+  * @brief  This function is used to send one byte through USART pipe.
+  * @param  Byte The byte to be sent.
+  * @retval None.
+  */
+void OPENBL_USART_SendByte(uint8_t Byte)
+{
+  BENCH_LinkWrite(&USART_Link, &Byte, 1U);
+}
+
+/**
+  * @brief  This function is used to read bytes from USART pipe.
+  * @param  pBuffer Pointer to the buffer where the read bytes are stored.
+  * @param  BufferSize The number of bytes to be read.
+  * @retval None.
+  */
+void OPENBL_USART_ReadBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+  BENCH_LinkRead(&USART_Link, pBuffer, BufferSize);
+}
+
+/**
+  * @brief  This function is used to send bytes through USART pipe.
+  * @param  pBuffer Pointer to the buffer to be sent.
+  * @param  BufferSize The number of bytes to be sent.
+  * @retval None.
+  */
+void OPENBL_USART_SendBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+  BENCH_LinkWrite(&USART_Link, pBuffer, BufferSize);
+}
+
+/**
+  * @brief  This function is used to process and execute the special commands.
+  *         No special command is supported by the benchmark.
+  * @param  SpecialCmd Pointer to the OPENBL_SpecialCmdTypeDef structure.
+  * @retval None.
+  */
+void OPENBL_USART_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *SpecialCmd)
+{
+  if (SpecialCmd->CmdType == OPENBL_SPECIAL_CMD)
+  {
+    /* Send NULL data size */
+    OPENBL_USART_SendByte(0x00U);
+    OPENBL_USART_SendByte(0x00U);
+  }
+
+  /* Send NULL status size */
+  OPENBL_USART_SendByte(0x00U);
+  OPENBL_USART_SendByte(0x00U);
+}
@@ -0,0 +1,233 @@
+/**
+  ******************************************************************************
+  * @file    usb_bulk_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains the USB bulk vendor interface of the benchmark, running over a simulated link
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbl_core.h"
+#include "openbl_usb_bulk_cmd.h"
+#include "usb_bulk_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define USB_BULK_SYNC_BYTE                0x7FU     /* Synchronization byte sent by the host */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint8_t UsbBulkDetected = 0U;
+
+/* Transmission buffer, the single bytes are gathered and sent in one transfer */
+static uint8_t UsbBulkTxBuffer[USB_BULK_PACKET_SIZE];
+static uint32_t UsbBulkTxCount = 0U;
+
+/* Bytes read from the current OUT packet, a new packet is started every USB_BULK_PACKET_SIZE bytes */
+static uint32_t UsbBulkRxCount = 0U;
+
+/* Exported variables --------------------------------------------------------*/
+BENCH_LinkTypeDef USB_BULK_Link;
+
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to configure the USB bulk vendor interface, the link is set up by the benchmark.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_Configuration(void)
+{
+  UsbBulkTxCount = 0U;
+  UsbBulkRxCount = 0U;
+}
+
+/**
+  * @brief  This function is used to De-initialize the USB bulk vendor interface.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_DeInit(void)
+{
+}
+
+/**
+  * @brief  This function is used to detect if there is any activity on USB bulk vendor interface.
+  *         The host synchronization byte is acknowledged once, when the host starts using the link.
+  * @retval Returns 1 if interface is detected else 0.
+  */
+uint8_t OPENBL_USB_BULK_ProtocolDetection(void)
+{
+  if (USB_BULK_Link.Active == 0U)
+  {
+    UsbBulkDetected = 0U;
+  }
+  else if ((UsbBulkDetected == 0U) && (BENCH_LinkPeek(&USB_BULK_Link) == USB_BULK_SYNC_BYTE))
+  {
+    /* Read byte in order to flush the 0x7F synchronization byte */
+    (void)OPENBL_USB_BULK_ReadByte();
+
+    /* Acknowledge the host */
+    OPENBL_USB_BULK_SendByte(ACK_BYTE);
+    OPENBL_USB_BULK_Flush();
+
+    UsbBulkDetected = 1U;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  return UsbBulkDetected;
+}
+
+/**
+  * @brief  This function is used to get the command opcode from the host.
+  * @retval Returns the command.
+  */
+uint8_t OPENBL_USB_BULK_GetCommandOpcode(void)
+{
+  uint8_t command_opc = 0x0;
+
+  /* Get the command opcode */
+  command_opc = OPENBL_USB_BULK_ReadByte();
+
+  /* Check the data integrity */
+  if ((command_opc ^ OPENBL_USB_BULK_ReadByte()) != 0xFF)
+  {
+    command_opc = ERROR_COMMAND;
+  }
+
+  return command_opc;
+}
+
+/**
+  * @brief  This function is used to read one byte from USB bulk pipe.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_USB_BULK_ReadByte(void)
+{
+  uint8_t byte;
+
+  OPENBL_USB_BULK_ReadBytes(&byte, 1U);
+
+  return byte;
+}
+
+/**
+  * @brief  This function is used to read bytes from USB bulk pipe.
+  *         The pending bytes to send are flushed first, as the host waits for them before sending more data.
+  * @param  pBuffer Pointer to the buffer where the read bytes are stored.
+  * @param  BufferSize The number of bytes to be read.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_ReadBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+  uint32_t counter = 0U;
+  uint32_t length;
+
+  OPENBL_USB_BULK_Flush();
+
+  while (counter < BufferSize)
+  {
+    /* Account the OUT packet overhead when a new packet is started */
+    if (UsbBulkRxCount == 0U)
+    {
+      BENCH_LinkTransaction(&USB_BULK_Link);
+    }
+
+    length = USB_BULK_PACKET_SIZE - UsbBulkRxCount;
+
+    if (length > (BufferSize - counter))
+    {
+      length = BufferSize - counter;
+    }
+
+    BENCH_LinkRead(&USB_BULK_Link, &pBuffer[counter], length);
+
+    counter        += length;
+    UsbBulkRxCount = (UsbBulkRxCount + length) % USB_BULK_PACKET_SIZE;
+  }
+}
+
+/**
+  * @brief  This function is used to send one byte through USB bulk pipe.
+  *         The byte is buffered and sent with the next bytes in one transfer.
+  * @param  Byte The byte to be sent.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_SendByte(uint8_t Byte)
+{
+  UsbBulkTxBuffer[UsbBulkTxCount] = Byte;
+  UsbBulkTxCount++;
+
+  if (UsbBulkTxCount == USB_BULK_PACKET_SIZE)
+  {
+    OPENBL_USB_BULK_Flush();
+  }
+}
+
+/**
+  * @brief  This function is used to send a buffer through USB bulk pipe in one transfer.
+  * @param  pBuffer Pointer to the buffer to be sent.
+  * @param  BufferSize The number of bytes to be sent.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_SendBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+  OPENBL_USB_BULK_Flush();
+
+  if (BufferSize != 0U)
+  {
+    BENCH_LinkWrite(&USB_BULK_Link, pBuffer, BufferSize);
+
+    UsbBulkRxCount = 0U;
+  }
+}
+
+/**
+  * @brief  This function is used to send the buffered bytes through USB bulk pipe.
+  *         The host answers with a new transfer, the next OUT packet is a new one.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_Flush(void)
+{
+  if (UsbBulkTxCount != 0U)
+  {
+    BENCH_LinkWrite(&USB_BULK_Link, UsbBulkTxBuffer, UsbBulkTxCount);
+
+    UsbBulkTxCount = 0U;
+    UsbBulkRxCount = 0U;
+  }
+}
+
+/**
+  * @brief  This function is used to process and execute the special commands.
+  *         No special command is supported by the benchmark.
+  * @param  SpecialCmd Pointer to the OPENBL_SpecialCmdTypeDef structure.
+  * @retval None.
+  */
+void OPENBL_USB_BULK_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *SpecialCmd)
+{
+  if (SpecialCmd->CmdType == OPENBL_SPECIAL_CMD)
+  {
+    /* Send NULL data size */
+    OPENBL_USB_BULK_SendByte(0x00U);
+    OPENBL_USB_BULK_SendByte(0x00U);
+  }
+
+  /* Send NULL status size */
+  OPENBL_USB_BULK_SendByte(0x00U);
+  OPENBL_USB_BULK_SendByte(0x00U);
+}
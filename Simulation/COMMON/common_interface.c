@@ -0,0 +1,339 @@
+/**
+  ******************************************************************************
+  * @file    common_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains common functions used by the simulated interfaces
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "flash_interface.h"
+#include "ram_interface.h"
+#include "openbootloader_conf.h"
+#include "common_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define SIM_NODE_ID                       0x53494D30U  /* Node identifier of the simulated device "SIM0" */
+#define SIM_IDLE_TIME                     100U         /* Time slept in us when waiting for an interrupt */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static Function_Pointer ResetCallback;
+static uint8_t SimVirtualTime = 0U;                /* 1: the delays advance a virtual clock instead of waiting */
+static uint64_t SimVirtualClock = 0U;              /* Virtual clock in ns */
+static uint32_t SimNodeId = SIM_NODE_ID;
+static FlagStatus SimBootRequest = SET;            /* RESET: the fast boot starts the application */
+
+/* Reflected CRC-32 (IEEE 802.3) of each half byte */
+static const uint32_t a_SimCrc32Table[16] =
+{
+  0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU, 0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+  0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU, 0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Assigns the given value to the Main Stack Pointer (MSP).
+  *         Nothing to do on the host.
+  * @param  TopOfMainStack  Main Stack Pointer value to set.
+  * @retval None.
+  */
+void Common_SetMsp(uint32_t TopOfMainStack)
+{
+  (void)TopOfMainStack;
+}
+
+/**
+  * @brief  Enable IRQ Interrupts.
+  *         Nothing to do on the host.
+  * @retval None.
+  */
+void Common_EnableIrq(void)
+{
+}
+
+/**
+  * @brief  Disable IRQ Interrupts.
+  *         Nothing to do on the host.
+  * @retval None.
+  */
+void Common_DisableIrq(void)
+{
+}
+
+/**
+  * @brief  Enter sleep mode until the next interrupt.
+  *         The host process sleeps for a short time instead.
+  * @retval None.
+  */
+void Common_WaitForInterrupt(void)
+{
+  if (SimVirtualTime == 0U)
+  {
+    (void)usleep(SIM_IDLE_TIME);
+  }
+}
+
+/**
+  * @brief  Start the cycle counter used for the statistics.
+  *         The host monotonic clock is always running.
+  * @retval None.
+  */
+void Common_StartCycleCounter(void)
+{
+}
+
+/**
+  * @brief  Return the current value of the cycle counter.
+  * @retval The cycle count, in SIM_CYCLE_FREQUENCY cycles.
+  */
+uint32_t Common_GetCycleCount(void)
+{
+  struct timespec now;
+  uint64_t time;
+
+  if (SimVirtualTime == 1U)
+  {
+    time = SimVirtualClock;
+  }
+  else
+  {
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    time = ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+  }
+
+  return (uint32_t)(time / (1000000000U / SIM_CYCLE_FREQUENCY));
+}
+
+/**
+  * @brief  Return the frequency of the cycle counter.
+  * @retval The frequency in Hz.
+  */
+uint32_t Common_GetCycleFrequency(void)
+{
+  return SIM_CYCLE_FREQUENCY;
+}
+
+/**
+  * @brief  Compute the CRC-32 (IEEE 802.3) of a Flash or RAM region, as the CRC unit does.
+  *         The simulated memories are read directly, by half bytes through a table.
+  * @param  Crc The CRC of the previous regions, 0 for the first one.
+  * @param  Address The start address of the region.
+  * @param  Length The number of bytes of the region.
+  * @retval The updated CRC.
+  */
+uint32_t Common_ComputeCrc32(uint32_t Crc, uint32_t Address, uint32_t Length)
+{
+  uint32_t counter;
+  uint32_t crc = ~Crc;
+  uint8_t data;
+
+  for (counter = 0U; counter < Length; counter++)
+  {
+    if ((Address + counter) < FLASH_END_ADDRESS)
+    {
+      data = OPENBL_FLASH_Read(Address + counter);
+    }
+    else
+    {
+      data = OPENBL_RAM_Read(Address + counter);
+    }
+
+    crc ^= (uint32_t)data;
+    crc = (crc >> 4U) ^ a_SimCrc32Table[crc & 0x0FU];
+    crc = (crc >> 4U) ^ a_SimCrc32Table[crc & 0x0FU];
+  }
+
+  return ~crc;
+}
+
+/**
+  * @brief  Wait for the given time, used to emulate the Flash and link timings.
+  *         With the virtual time, the virtual clock is advanced instead.
+  * @param  Delay The time to wait in us.
+  * @retval None.
+  */
+void Common_Delay(uint32_t Delay)
+{
+  struct timespec delay;
+
+  if (SimVirtualTime == 1U)
+  {
+    SimVirtualClock += (uint64_t)Delay * 1000U;
+  }
+  else if (Delay != 0U)
+  {
+    delay.tv_sec  = (time_t)(Delay / 1000000U);
+    delay.tv_nsec = (long)(Delay % 1000000U) * 1000L;
+
+    while (nanosleep(&delay, &delay) != 0)
+    {
+    }
+  }
+}
+
+/**
+  * @brief  Select the virtual time: the delays no longer wait, they advance a virtual clock
+  *         which is also used by the cycle counter. This makes the timings reproducible.
+  * @param  State ENABLE to use the virtual time, DISABLE to use the host clock.
+  * @retval None.
+  */
+void Common_SetVirtualTime(FunctionalState State)
+{
+  SimVirtualTime = (State == ENABLE) ? 1U : 0U;
+}
+
+/**
+  * @brief  Advance the virtual clock, used by the simulated links.
+  * @param  Time The time in ns.
+  * @retval None.
+  */
+void Common_AddVirtualTime(uint64_t Time)
+{
+  SimVirtualClock += Time;
+}
+
+/**
+  * @brief  Return the virtual clock.
+  * @retval The virtual time in ns.
+  */
+uint64_t Common_GetVirtualTime(void)
+{
+  return SimVirtualClock;
+}
+
+/**
+  * @brief  Checks whether the target Protection Status is set or not.
+  * @retval Returns SET if protection is enabled else return RESET.
+  */
+FlagStatus Common_GetProtectionStatus(void)
+{
+  FlagStatus status;
+
+  if (OPENBL_FLASH_GetReadOutProtectionLevel() != RDP_LEVEL_0)
+  {
+    status = SET;
+  }
+  else
+  {
+    status = RESET;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Register a callback function to be called at the end of commands processing.
+  * @retval None.
+  */
+void Common_SetPostProcessingCallback(Function_Pointer Callback)
+{
+  ResetCallback = Callback;
+}
+
+/**
+  * @brief  Start post processing task.
+  * @retval None.
+  */
+void Common_StartPostProcessing(void)
+{
+  if (ResetCallback != NULL)
+  {
+    ResetCallback();
+
+    /* In case there is no system reset, we must reset the callback */
+    ResetCallback = NULL;
+  }
+}
+
+/**
+  * @brief  Set the identifier of this node, several simulations sharing a SocketCAN bus need distinct ones.
+  * @param  NodeId The node identifier.
+  * @retval None.
+  */
+void Common_SetNodeId(uint32_t NodeId)
+{
+  SimNodeId = NodeId;
+}
+
+/**
+  * @brief  Return the identifier of this node, used to address it when several devices share the same bus.
+  * @retval The node identifier.
+  */
+uint32_t Common_GetNodeId(void)
+{
+  return SimNodeId;
+}
+
+/**
+  * @brief  Set the boot request seen by the fast boot, the bootloader is requested by default.
+  * @param  State SET to stay in the bootloader, RESET to start a valid application.
+  * @retval None.
+  */
+void Common_SetBootRequest(FlagStatus State)
+{
+  SimBootRequest = State;
+}
+
+/**
+  * @brief  Check whether the application requested the bootloader.
+  * @retval Returns the state selected by Common_SetBootRequest.
+  */
+FlagStatus Common_GetBootRequest(void)
+{
+  return SimBootRequest;
+}
+
+/**
+  * @brief  Read a word of the simulated Flash, used before the memories are registered.
+  * @param  Address The address of the word.
+  * @retval The word.
+  */
+uint32_t Common_ReadWord(uint32_t Address)
+{
+  uint32_t counter;
+  uint32_t data = 0U;
+
+  for (counter = 0U; counter < 4U; counter++)
+  {
+    data |= (uint32_t)OPENBL_FLASH_Read(Address + counter) << (counter * 8U);
+  }
+
+  return data;
+}
+
+/**
+  * @brief  Start the application without going through the memory interfaces.
+  *         The application cannot run on the host, the jump is reported and the process exits.
+  * @param  Address The address of the application vector table.
+  * @retval None.
+  */
+void Common_JumpToApplication(uint32_t Address)
+{
+  (void)printf("Jump to application 0x%08X, stack pointer 0x%08X\n", (unsigned int)Address,
+               (unsigned int)Common_ReadWord(Address));
+
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,62 @@
+/**
+  ******************************************************************************
+  * @file    common_interface.h
+  * @author  MCD Application Team
+  * @brief   Header for common_interface.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef COMMON_INTERFACE_H
+#define COMMON_INTERFACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+
+/* Exported types ------------------------------------------------------------*/
+typedef void (*Function_Pointer)(void);
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void Common_SetMsp(uint32_t TopOfMainStack);
+void Common_EnableIrq(void);
+void Common_DisableIrq(void);
+FlagStatus Common_GetProtectionStatus(void);
+void Common_SetPostProcessingCallback(Function_Pointer Callback);
+void Common_StartPostProcessing(void);
+void Common_SetNodeId(uint32_t NodeId);
+uint32_t Common_GetNodeId(void);
+void Common_SetBootRequest(FlagStatus State);
+FlagStatus Common_GetBootRequest(void);
+uint32_t Common_ReadWord(uint32_t Address);
+void Common_JumpToApplication(uint32_t Address);
+void Common_WaitForInterrupt(void);
+void Common_StartCycleCounter(void);
+uint32_t Common_GetCycleCount(void);
+uint32_t Common_GetCycleFrequency(void);
+uint32_t Common_ComputeCrc32(uint32_t Crc, uint32_t Address, uint32_t Length);
+void Common_Delay(uint32_t Delay);
+void Common_SetVirtualTime(FunctionalState State);
+void Common_AddVirtualTime(uint64_t Time);
+uint64_t Common_GetVirtualTime(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COMMON_INTERFACE_H */
@@ -0,0 +1,347 @@
+/**
+  ******************************************************************************
+  * @file    flash_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains the simulated Flash memory, backed by a memory mapped file
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbl_mem.h"
+#include "openbl_core.h"
+#include "common_interface.h"
+#include "flash_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define FLASH_ERASED_VALUE                0xFFU     /* Value of an erased Flash byte */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint8_t *p_FlashMemory = NULL;                        /* Host mapping of the Flash file */
+static uint32_t FlashEraseTime   = SIM_FLASH_ERASE_TIME;     /* Page erase time in us */
+static uint32_t FlashProgramTime = SIM_FLASH_PROGRAM_TIME;   /* Programming unit time in us */
+static uint32_t FlashRdpLevel    = RDP_LEVEL_0;
+
+/* Private function prototypes -----------------------------------------------*/
+static void OPENBL_FLASH_ErasePages(uint32_t Page, uint32_t PagesNumber);
+
+/* Exported variables --------------------------------------------------------*/
+OPENBL_MemoryTypeDef FLASH_Descriptor =
+{
+  FLASH_START_ADDRESS,
+  FLASH_END_ADDRESS,
+  FLASH_MEM_SIZE,
+  FLASH_AREA,
+  OPENBL_FLASH_Read,
+  OPENBL_FLASH_Write,
+  OPENBL_FLASH_SetReadOutProtectionLevel,
+  OPENBL_FLASH_SetWriteProtection,
+  OPENBL_FLASH_JumpToAddress,
+  OPENBL_FLASH_MassErase,
+  OPENBL_FLASH_Erase,
+  SIM_FLASH_PAGE_SIZE,
+  FLASH_BANK_SIZE
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to erase Flash pages, taking the configured erase time per page.
+  * @param  Page The first page to be erased.
+  * @param  PagesNumber The number of pages to be erased.
+  * @retval None.
+  */
+static void OPENBL_FLASH_ErasePages(uint32_t Page, uint32_t PagesNumber)
+{
+  (void)memset(&p_FlashMemory[Page * FLASH_Descriptor.PageSize], FLASH_ERASED_VALUE,
+               PagesNumber * FLASH_Descriptor.PageSize);
+
+  Common_Delay(FlashEraseTime * PagesNumber);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to map the file backing the Flash, it is created erased if needed.
+  * @param  pFileName The name of the file.
+  * @param  PageSize The Flash page size, it must divide the bank size.
+  * @retval Returns SUCCESS if the Flash is available else ERROR.
+  */
+ErrorStatus OPENBL_FLASH_Open(const char *pFileName, uint32_t PageSize)
+{
+  ErrorStatus status = ERROR;
+  struct stat file_stat;
+  void *p_map;
+  int fd;
+
+  if ((PageSize != 0U) && ((FLASH_BANK_SIZE % PageSize) == 0U))
+  {
+    FLASH_Descriptor.PageSize = PageSize;
+
+    fd = open(pFileName, O_RDWR | O_CREAT, 0644);
+
+    if ((fd >= 0) && (fstat(fd, &file_stat) == 0))
+    {
+      if ((file_stat.st_size == (off_t)FLASH_MEM_SIZE) || (ftruncate(fd, (off_t)FLASH_MEM_SIZE) == 0))
+      {
+        p_map = mmap(NULL, FLASH_MEM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+        if (p_map != MAP_FAILED)
+        {
+          p_FlashMemory = (uint8_t *)p_map;
+
+          /* A new file is filled with zeros, erase it */
+          if (file_stat.st_size != (off_t)FLASH_MEM_SIZE)
+          {
+            (void)memset(p_FlashMemory, FLASH_ERASED_VALUE, FLASH_MEM_SIZE);
+          }
+
+          status = SUCCESS;
+        }
+      }
+    }
+
+    if (fd >= 0)
+    {
+      (void)close(fd);
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to flush the Flash content to its file and unmap it.
+  * @retval None.
+  */
+void OPENBL_FLASH_Close(void)
+{
+  if (p_FlashMemory != NULL)
+  {
+    (void)msync(p_FlashMemory, FLASH_MEM_SIZE, MS_SYNC);
+    (void)munmap(p_FlashMemory, FLASH_MEM_SIZE);
+
+    p_FlashMemory = NULL;
+  }
+}
+
+/**
+  * @brief  This function is used to set the emulated Flash timings, 0 to run at host speed.
+  * @param  EraseTime The page erase time in us.
+  * @param  ProgramTime The time to program SIM_FLASH_PROGRAM_UNIT bytes in us.
+  * @retval None.
+  */
+void OPENBL_FLASH_SetTiming(uint32_t EraseTime, uint32_t ProgramTime)
+{
+  FlashEraseTime   = EraseTime;
+  FlashProgramTime = ProgramTime;
+}
+
+/**
+  * @brief  This function is used to read data from a given address.
+  * @param  Address The address to be read.
+  * @retval Returns the read value.
+  */
+uint8_t OPENBL_FLASH_Read(uint32_t Address)
+{
+  return p_FlashMemory[Address - FLASH_START_ADDRESS];
+}
+
+/**
+  * @brief  This function is used to write data in Flash memory.
+  *         As on the real Flash, programming can only clear bits.
+  * @param  Address The address where that data will be written.
+  * @param  Data The data to be written.
+  * @param  DataLength The length of the data to be written.
+  * @retval None.
+  */
+void OPENBL_FLASH_Write(uint32_t Address, uint8_t *Data, uint32_t DataLength)
+{
+  uint32_t offset;
+  uint32_t counter;
+
+  offset = Address - FLASH_START_ADDRESS;
+
+  if ((offset < FLASH_MEM_SIZE) && (DataLength <= (FLASH_MEM_SIZE - offset)))
+  {
+    for (counter = 0U; counter < DataLength; counter++)
+    {
+      p_FlashMemory[offset + counter] &= Data[counter];
+    }
+
+    Common_Delay(FlashProgramTime * ((DataLength + SIM_FLASH_PROGRAM_UNIT - 1U) / SIM_FLASH_PROGRAM_UNIT));
+  }
+}
+
+/**
+  * @brief  This function is used to jump to a given address.
+  *         The application cannot run on the host, the simulation exits.
+  * @param  Address The address where the function will jump.
+  * @retval None.
+  */
+void OPENBL_FLASH_JumpToAddress(uint32_t Address)
+{
+  /* De-initialize all the resources used by the Open Bootloader */
+  OPENBL_DeInit();
+
+  (void)printf("Jump to 0x%08X\n", (unsigned int)Address);
+
+  exit(EXIT_SUCCESS);
+}
+
+/**
+  * @brief  Return the Flash read protection level.
+  * @retval The return value can be one of the following values:
+  *         @arg RDP_LEVEL_0: Read protection level 0
+  *         @arg RDP_LEVEL_1: Read protection level 1
+  *         @arg RDP_LEVEL_2: Read protection level 2
+  */
+uint32_t OPENBL_FLASH_GetReadOutProtectionLevel(void)
+{
+  return FlashRdpLevel;
+}
+
+/**
+  * @brief  Set the Flash read protection level.
+  *         As on the real device, going back to level 0 erases the Flash.
+  * @param  Level Flash read protection level.
+  * @retval None.
+  */
+void OPENBL_FLASH_SetReadOutProtectionLevel(uint32_t Level)
+{
+  if ((Level == RDP_LEVEL_0) && (FlashRdpLevel != RDP_LEVEL_0))
+  {
+    OPENBL_FLASH_ErasePages(0U, FLASH_MEM_SIZE / FLASH_Descriptor.PageSize);
+  }
+
+  if (FlashRdpLevel != RDP_LEVEL_2)
+  {
+    FlashRdpLevel = Level;
+  }
+}
+
+/**
+  * @brief  This function is used to enable or disable write protection of the specified Flash pages.
+  *         The write protection is not simulated.
+  * @param  State Can be one of the following values: ENABLE or DISABLE.
+  * @param  ListOfPages Contains the list of pages to be protected.
+  * @param  Length The length of the list of pages to be protected.
+  * @retval Returns SUCCESS.
+  */
+ErrorStatus OPENBL_FLASH_SetWriteProtection(FunctionalState State, uint8_t *ListOfPages, uint32_t Length)
+{
+  (void)State;
+  (void)ListOfPages;
+  (void)Length;
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  This function is used to start the full Flash or a bank erase.
+  * @param  p_Data Pointer to the erase option: FLASH_MASS_ERASE, FLASH_BANK1_ERASE or FLASH_BANK2_ERASE.
+  * @param  DataLength Size of the Data buffer.
+  * @retval An ErrorStatus enumeration value:
+  *          - SUCCESS: Mass erase operation done
+  *          - ERROR:   Mass erase operation failed or the value of one parameter is not OK
+  */
+ErrorStatus OPENBL_FLASH_MassErase(uint8_t *p_Data, uint32_t DataLength)
+{
+  uint16_t bank_option;
+  uint32_t bank_pages;
+  ErrorStatus status = SUCCESS;
+
+  if (DataLength >= 2U)
+  {
+    (void)memcpy(&bank_option, p_Data, sizeof(bank_option));
+
+    bank_pages = FLASH_BANK_SIZE / FLASH_Descriptor.PageSize;
+
+    if (bank_option == FLASH_MASS_ERASE)
+    {
+      OPENBL_FLASH_ErasePages(0U, 2U * bank_pages);
+    }
+    else if (bank_option == FLASH_BANK1_ERASE)
+    {
+      OPENBL_FLASH_ErasePages(0U, bank_pages);
+    }
+    else if (bank_option == FLASH_BANK2_ERASE)
+    {
+      OPENBL_FLASH_ErasePages(bank_pages, bank_pages);
+    }
+    else
+    {
+      status = ERROR;
+    }
+  }
+  else
+  {
+    status = ERROR;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  This function is used to erase the specified Flash pages.
+  * @param  p_Data Pointer to the buffer that contains the number of pages then the pages to be erased,
+  *         on 16 bits each.
+  * @param  DataLength Size of the Data buffer.
+  * @retval An ErrorStatus enumeration value:
+  *          - SUCCESS: Erase operation done
+  *          - ERROR:   Erase operation failed or the value of one parameter is not OK
+  */
+ErrorStatus OPENBL_FLASH_Erase(uint8_t *p_Data, uint32_t DataLength)
+{
+  uint32_t counter;
+  uint32_t pages_number;
+  uint16_t value;
+  ErrorStatus status = SUCCESS;
+
+  if (DataLength >= 2U)
+  {
+    (void)memcpy(&value, p_Data, sizeof(value));
+    pages_number = (uint32_t)value;
+
+    for (counter = 0U; (counter < pages_number) && (counter < ((DataLength / 2U) - 1U)); counter++)
+    {
+      (void)memcpy(&value, &p_Data[2U + (2U * counter)], sizeof(value));
+
+      if ((uint32_t)value < (FLASH_MEM_SIZE / FLASH_Descriptor.PageSize))
+      {
+        OPENBL_FLASH_ErasePages((uint32_t)value, 1U);
+      }
+      else
+      {
+        status = ERROR;
+      }
+    }
+  }
+  else
+  {
+    status = ERROR;
+  }
+
+  return status;
+}
@@ -0,0 +1,50 @@
+/**
+  ******************************************************************************
+  * @file    flash_interface.h
+  * @author  MCD Application Team
+  * @brief   Header for flash_interface.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef FLASH_INTERFACE_H
+#define FLASH_INTERFACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "common_interface.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+ErrorStatus OPENBL_FLASH_Open(const char *pFileName, uint32_t PageSize);
+void OPENBL_FLASH_Close(void);
+void OPENBL_FLASH_SetTiming(uint32_t EraseTime, uint32_t ProgramTime);
+void OPENBL_FLASH_JumpToAddress(uint32_t Address);
+uint8_t OPENBL_FLASH_Read(uint32_t Address);
+void OPENBL_FLASH_SetReadOutProtectionLevel(uint32_t Level);
+void OPENBL_FLASH_Write(uint32_t Address, uint8_t *Data, uint32_t DataLength);
+ErrorStatus OPENBL_FLASH_MassErase(uint8_t *p_Data, uint32_t DataLength);
+ErrorStatus OPENBL_FLASH_Erase(uint8_t *p_Data, uint32_t DataLength);
+ErrorStatus OPENBL_FLASH_SetWriteProtection(FunctionalState State, uint8_t *ListOfPages, uint32_t Length);
+uint32_t OPENBL_FLASH_GetReadOutProtectionLevel(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FLASH_INTERFACE_H */
@@ -0,0 +1,90 @@
+/**
+  ******************************************************************************
+  * @file    optionbytes_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains the simulated Option Bytes
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+#include "platform.h"
+#include "openbl_mem.h"
+#include "openbl_core.h"
+#include "optionbytes_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint8_t a_OptionBytes[OB_SIZE];
+
+/* Private function prototypes -----------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+OPENBL_MemoryTypeDef OB_Descriptor =
+{
+  OB_START_ADDRESS,
+  OB_END_ADDRESS,
+  OB_SIZE,
+  OB_AREA,
+  OPENBL_OB_Read,
+  OPENBL_OB_Write,
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+  NULL,
+  0U,
+  0U
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Launch the option byte loading.
+  *         The simulated option bytes take effect immediately.
+  * @retval None.
+  */
+void OPENBL_OB_Launch(void)
+{
+}
+
+/**
+  * @brief  This function is used to read data from a given address.
+  * @param  Address The address to be read.
+  * @retval Returns the read value.
+  */
+uint8_t OPENBL_OB_Read(uint32_t Address)
+{
+  return a_OptionBytes[Address - OB_START_ADDRESS];
+}
+
+/**
+  * @brief  This function is used to write data in Option bytes.
+  * @param  Address The address where that data will be written.
+  * @param  Data The data to be written.
+  * @param  DataLength The length of the data to be written.
+  * @retval None.
+  */
+void OPENBL_OB_Write(uint32_t Address, uint8_t *Data, uint32_t DataLength)
+{
+  uint32_t offset;
+
+  offset = Address - OB_START_ADDRESS;
+
+  if ((offset < OB_SIZE) && (DataLength <= (OB_SIZE - offset)))
+  {
+    (void)memcpy(&a_OptionBytes[offset], Data, DataLength);
+  }
+}
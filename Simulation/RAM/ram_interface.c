@@ -0,0 +1,99 @@
+/**
+  ******************************************************************************
+  * @file    ram_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains the simulated RAM memory
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "platform.h"
+#include "openbl_mem.h"
+#include "openbl_core.h"
+#include "ram_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint8_t a_RamMemory[RAM_SIZE];
+
+/* Private function prototypes -----------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+OPENBL_MemoryTypeDef RAM_Descriptor =
+{
+  RAM_START_ADDRESS + OPENBL_RAM_SIZE, /* OPENBL_RAM_SIZE is added to protect OpenBootloader RAM area */
+  RAM_END_ADDRESS,
+  RAM_SIZE,
+  RAM_AREA,
+  OPENBL_RAM_Read,
+  OPENBL_RAM_Write,
+  NULL,
+  NULL,
+  OPENBL_RAM_JumpToAddress,
+  NULL,
+  NULL,
+  0U,
+  0U
+};
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to read data from a given address.
+  * @param  Address The address to be read.
+  * @retval Returns the read value.
+  */
+uint8_t OPENBL_RAM_Read(uint32_t Address)
+{
+  return a_RamMemory[Address - RAM_START_ADDRESS];
+}
+
+/**
+  * @brief  This function is used to write data in RAM memory.
+  * @param  Address The address where that data will be written.
+  * @param  pData The data to be written.
+  * @param  DataLength The length of the data to be written.
+  * @retval None.
+  */
+void OPENBL_RAM_Write(uint32_t Address, uint8_t *pData, uint32_t DataLength)
+{
+  uint32_t offset;
+
+  offset = Address - RAM_START_ADDRESS;
+
+  if ((offset < RAM_SIZE) && (DataLength <= (RAM_SIZE - offset)))
+  {
+    (void)memcpy(&a_RamMemory[offset], pData, DataLength);
+  }
+}
+
+/**
+  * @brief  This function is used to jump to a given address.
+  *         The application cannot run on the host, the simulation exits.
+  * @param  Address The address where the function will jump.
+  * @retval None.
+  */
+void OPENBL_RAM_JumpToAddress(uint32_t Address)
+{
+  /* De-initialize all the resources used by the Open Bootloader */
+  OPENBL_DeInit();
+
+  (void)printf("Jump to 0x%08X\n", (unsigned int)Address);
+
+  exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,189 @@
+/**
+  ******************************************************************************
+  * @file    can_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains the CAN interface of the host simulation, running over a Linux SocketCAN interface
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbl_core.h"
+#include "openbl_can_cmd.h"
+#include "common_interface.h"
+#include "socketcan_link.h"
+#include "can_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint8_t CanDetected = 0U;
+
+static SOCKETCAN_LinkTypeDef CanLink =
+{
+  .pName   = NULL,
+  .Socket  = -1,
+  .FdMode  = 0U,
+  .BitRate = SIM_CAN_BITRATE
+};
+
+/* Bit rates selected by the speed command, indexed by its parameter */
+static const uint32_t a_CanBitRates[] = {0U, 125000U, 250000U, 500000U, 1000000U};
+
+/* Exported variables --------------------------------------------------------*/
+uint8_t tCanRxData[CAN_RAM_BUFFER_SIZE];
+
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to select the SocketCAN interface and its bit rate.
+  *         It must be called before the CAN configuration.
+  * @param  pLinkName Name of the network interface, vcan0 for instance, NULL to leave the CAN unused.
+  * @param  BitRate The bit rate of the bus, used for the bus load statistics.
+  * @retval None.
+  */
+void OPENBL_CAN_SetLink(const char *pLinkName, uint32_t BitRate)
+{
+  CanLink.pName   = pLinkName;
+  CanLink.BitRate = BitRate;
+}
+
+/**
+  * @brief  This function is used to print the frame counts, the bus load and the throughput of the CAN.
+  * @retval None.
+  */
+void OPENBL_CAN_PrintStatistics(void)
+{
+  SOCKETCAN_Report(&CanLink);
+}
+
+/**
+  * @brief  This function is used to configure CAN pins and then initialize the used CAN instance.
+  *         A raw socket is bound to the selected network interface.
+  * @retval None.
+  */
+void OPENBL_CAN_Configuration(void)
+{
+  SOCKETCAN_Open(&CanLink);
+}
+
+/**
+  * @brief  This function is used to De-initialize the CAN pins and instance.
+  * @retval None.
+  */
+void OPENBL_CAN_DeInit(void)
+{
+  /* Only de-initialize the CAN if it is not the current detected interface */
+  if (CanDetected == 0U)
+  {
+    SOCKETCAN_Close(&CanLink);
+  }
+}
+
+/**
+  * @brief  This function is used to detect if there is any activity on CAN protocol.
+  *         The received frame is left in the socket, it holds the first command.
+  * @retval Returns 1 if interface is detected else 0.
+  */
+uint8_t OPENBL_CAN_ProtocolDetection(void)
+{
+  CanDetected = SOCKETCAN_Pending(&CanLink);
+
+  return CanDetected;
+}
+
+/**
+  * @brief  This function is used to get the command opcode from the host.
+  *         The opcode is the frame identifier, the frame data is stored in tCanRxData.
+  * @retval Returns the command.
+  */
+uint8_t OPENBL_CAN_GetCommandOpcode(void)
+{
+  uint32_t identifier;
+
+  (void)SOCKETCAN_Read(&CanLink, &identifier, tCanRxData, SOCKETCAN_FRAME_SIZE);
+
+  return (uint8_t)identifier;
+}
+
+/**
+  * @brief  This function is used to read one byte from CAN pipe.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_CAN_ReadByte(void)
+{
+  uint8_t byte = 0U;
+
+  (void)SOCKETCAN_Read(&CanLink, NULL, &byte, 1U);
+
+  return byte;
+}
+
+/**
+  * @brief  This function is used to read one frame from CAN pipe.
+  * @param  Buffer The buffer that stores the received data.
+  * @param  BufferSize The size of the buffer.
+  * @retval None.
+  */
+void OPENBL_CAN_ReadBytes(uint8_t *Buffer, uint32_t BufferSize)
+{
+  (void)SOCKETCAN_Read(&CanLink, NULL, Buffer, BufferSize);
+}
+
+/**
+  * @brief  This function is used to send one byte through CAN pipe.
+  * @param  Byte The byte to be sent.
+  * @retval None.
+  */
+void OPENBL_CAN_SendByte(uint8_t Byte)
+{
+  SOCKETCAN_Write(&CanLink, &Byte, 1U);
+}
+
+/**
+  * @brief  This function is used to send one frame through CAN pipe.
+  * @param  Buffer The data of the frame.
+  * @param  BufferSize The number of bytes of the frame.
+  * @retval None.
+  */
+void OPENBL_CAN_SendBytes(uint8_t *Buffer, uint32_t BufferSize)
+{
+  SOCKETCAN_Write(&CanLink, Buffer, BufferSize);
+}
+
+/**
+  * @brief  This function is used to change the CAN speed.
+  *         The bit rate of a SocketCAN interface is set by the system, only the statistics follow the change.
+  * @param  Prescaler The speed index sent by the host.
+  * @retval None.
+  */
+void OPENBL_CAN_ChangePrescaler(uint32_t Prescaler)
+{
+  if ((Prescaler != 0U) && (Prescaler < (sizeof(a_CanBitRates) / sizeof(a_CanBitRates[0]))))
+  {
+    CanLink.BitRate = a_CanBitRates[Prescaler];
+  }
+}
+
+/**
+  * @brief  This function is used to wait the given number of milliseconds.
+  * @param  Delay The delay in ms.
+  * @retval None.
+  */
+void HAL_Delay(uint32_t Delay)
+{
+  Common_Delay(Delay * 1000U);
+}
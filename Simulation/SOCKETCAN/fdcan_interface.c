@@ -0,0 +1,215 @@
+/**
+  ******************************************************************************
+  * @file    fdcan_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains the FDCAN interface of the host simulation, running over a Linux SocketCAN interface
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbl_core.h"
+#include "openbl_fdcan_cmd.h"
+#include "socketcan_link.h"
+#include "fdcan_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint8_t FdcanDetected = 0U;
+
+static SOCKETCAN_LinkTypeDef FdcanLink =
+{
+  .pName       = NULL,
+  .Socket      = -1,
+  .FdMode      = 1U,
+  .BitRate     = SIM_CAN_BITRATE,
+  .DataBitRate = SIM_FDCAN_DATA_BITRATE
+};
+
+/* Exported variables --------------------------------------------------------*/
+uint8_t *TxData;
+uint8_t *RxData;
+
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to select the SocketCAN interface and its bit rates.
+  *         It must be called before the FDCAN configuration.
+  * @param  pLinkName Name of the network interface, vcan0 for instance, NULL to leave the FDCAN unused.
+  * @param  BitRate The nominal bit rate, used for the bus load statistics.
+  * @param  DataBitRate The data phase bit rate, used for the bus load statistics.
+  * @retval None.
+  */
+void OPENBL_FDCAN_SetLink(const char *pLinkName, uint32_t BitRate, uint32_t DataBitRate)
+{
+  FdcanLink.pName       = pLinkName;
+  FdcanLink.BitRate     = BitRate;
+  FdcanLink.DataBitRate = DataBitRate;
+}
+
+/**
+  * @brief  This function is used to print the frame counts, the bus load and the throughput of the FDCAN.
+  * @retval None.
+  */
+void OPENBL_FDCAN_PrintStatistics(void)
+{
+  SOCKETCAN_Report(&FdcanLink);
+}
+
+/**
+  * @brief  This function is used to configure FDCAN pins and then initialize the used FDCAN instance.
+  *         A raw socket exchanging CAN FD frames is bound to the selected network interface.
+  * @retval None.
+  */
+void OPENBL_FDCAN_Configuration(void)
+{
+  /* The frame buffers are taken from the arena shared by all the interfaces */
+  if (TxData == NULL)
+  {
+    TxData = OPENBL_GetBuffer(2U * FDCAN_RAM_BUFFER_SIZE);
+    RxData = &TxData[FDCAN_RAM_BUFFER_SIZE];
+  }
+
+  SOCKETCAN_Open(&FdcanLink);
+}
+
+/**
+  * @brief  This function is used to De-initialize the FDCAN pins and instance.
+  * @retval None.
+  */
+void OPENBL_FDCAN_DeInit(void)
+{
+  /* Only de-initialize the FDCAN if it is not the current detected interface */
+  if (FdcanDetected == 0U)
+  {
+    SOCKETCAN_Close(&FdcanLink);
+  }
+}
+
+/**
+  * @brief  This function is used to detect if there is any activity on FDCAN protocol.
+  *         The received frame is left in the socket, it holds the first command.
+  * @retval Returns 1 if interface is detected else 0.
+  */
+uint8_t OPENBL_FDCAN_ProtocolDetection(void)
+{
+  FdcanDetected = SOCKETCAN_Pending(&FdcanLink);
+
+  return FdcanDetected;
+}
+
+/**
+  * @brief  This function is used to get the command opcode from the host.
+  *         The opcode is the frame identifier, the frame data is stored in RxData.
+  * @retval Returns the command.
+  */
+uint8_t OPENBL_FDCAN_GetCommandOpcode(void)
+{
+  uint32_t identifier;
+
+  (void)SOCKETCAN_Read(&FdcanLink, &identifier, RxData, SOCKETCAN_FD_FRAME_SIZE);
+
+  return (uint8_t)identifier;
+}
+
+/**
+  * @brief  This function is used to read one byte from FDCAN pipe.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_FDCAN_ReadByte(void)
+{
+  uint8_t byte = 0U;
+
+  (void)SOCKETCAN_Read(&FdcanLink, NULL, &byte, 1U);
+
+  return byte;
+}
+
+/**
+  * @brief  This function is used to read one frame from FDCAN pipe.
+  * @param  Buffer The buffer that stores the received data.
+  * @param  BufferSize The size of the buffer.
+  * @retval None.
+  */
+void OPENBL_FDCAN_ReadBytes(uint8_t *Buffer, uint32_t BufferSize)
+{
+  (void)SOCKETCAN_Read(&FdcanLink, NULL, Buffer, BufferSize);
+}
+
+/**
+  * @brief  This function is used to read frames from FDCAN pipe until a buffer is filled.
+  *         The padding bytes of the last frame are dropped.
+  * @param  Buffer The buffer that stores the received data.
+  * @param  BufferSize The number of bytes to be read.
+  * @retval Returns the number of bytes stored in the buffer.
+  */
+uint32_t OPENBL_FDCAN_ReadFrames(uint8_t *Buffer, uint32_t BufferSize)
+{
+  uint32_t received = 0U;
+  uint32_t length;
+
+  while (received < BufferSize)
+  {
+    length = SOCKETCAN_Read(&FdcanLink, NULL, &Buffer[received], BufferSize - received);
+
+    received += (length < (BufferSize - received)) ? length : (BufferSize - received);
+  }
+
+  return received;
+}
+
+/**
+  * @brief  This function is used to send one byte through FDCAN pipe.
+  * @param  Byte The byte to be sent.
+  * @retval None.
+  */
+void OPENBL_FDCAN_SendByte(uint8_t Byte)
+{
+  SOCKETCAN_Write(&FdcanLink, &Byte, 1U);
+}
+
+/**
+  * @brief  This function is used to send one frame through FDCAN pipe.
+  * @param  Buffer The data of the frame.
+  * @param  BufferSize The number of bytes of the frame.
+  * @retval None.
+  */
+void OPENBL_FDCAN_SendBytes(uint8_t *Buffer, uint32_t BufferSize)
+{
+  SOCKETCAN_Write(&FdcanLink, Buffer, BufferSize);
+}
+
+/**
+  * @brief  This function is used to process and execute the special commands.
+  *         The user must define the special commands routine here.
+  * @param  Frame Pointer to the OPENBL_SpecialCmdTypeDef structure.
+  * @retval None.
+  */
+void OPENBL_FDCAN_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *Frame)
+{
+  TxData[0] = 0x00U;
+  TxData[1] = 0x00U;
+
+  if (Frame->CmdType == OPENBL_SPECIAL_CMD)
+  {
+    /* Send NULL data size */
+    OPENBL_FDCAN_SendBytes(TxData, FDCAN_DLC_BYTES_2);
+  }
+
+  /* Send NULL status size */
+  OPENBL_FDCAN_SendBytes(TxData, FDCAN_DLC_BYTES_2);
+}
@@ -0,0 +1,347 @@
+/**
+  ******************************************************************************
+  * @file    socketcan_link.c
+  * @author  MCD Application Team
+  * @brief   Linux SocketCAN link shared by the simulated CAN and FDCAN interfaces
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <errno.h>
+#include <net/if.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+
+#include "platform.h"
+#include "socketcan_link.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define SOCKETCAN_FRAME_BITS              47U       /* Bits of a classic frame besides its data, standard identifier */
+#define SOCKETCAN_FD_ARBITRATION_BITS     30U       /* Bits of a CAN FD frame sent at the nominal bit rate */
+#define SOCKETCAN_FD_DATA_BITS            26U       /* Bits of a CAN FD data phase besides its data, 17-bit CRC */
+#define SOCKETCAN_FD_CRC21_BITS           4U        /* Additional bits of the 21-bit CRC used above 16 data bytes */
+#define SOCKETCAN_PADDING_BYTE            0x00U     /* Value of the bytes padding a CAN FD frame */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint64_t SOCKETCAN_GetTime(void);
+static uint32_t SOCKETCAN_FdLength(uint32_t Length);
+static void SOCKETCAN_Account(SOCKETCAN_LinkTypeDef *pLink, uint32_t Length);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to get the monotonic time.
+  * @retval Returns the time in ns.
+  */
+static uint64_t SOCKETCAN_GetTime(void)
+{
+  struct timespec time;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &time);
+
+  return ((uint64_t)time.tv_sec * 1000000000U) + (uint64_t)time.tv_nsec;
+}
+
+/**
+  * @brief  This function is used to get the smallest CAN FD frame length holding the given data.
+  * @param  Length The number of data bytes, up to SOCKETCAN_FD_FRAME_SIZE.
+  * @retval Returns the frame length: 0 to 8, 12, 16, 20, 24, 32, 48 or 64.
+  */
+static uint32_t SOCKETCAN_FdLength(uint32_t Length)
+{
+  uint32_t length;
+
+  if (Length <= 8U)
+  {
+    length = Length;
+  }
+  else if (Length <= 24U)
+  {
+    length = (Length + 3U) & ~3U;
+  }
+  else if (Length <= 32U)
+  {
+    length = 32U;
+  }
+  else if (Length <= 48U)
+  {
+    length = 48U;
+  }
+  else
+  {
+    length = SOCKETCAN_FD_FRAME_SIZE;
+  }
+
+  return length;
+}
+
+/**
+  * @brief  This function is used to account the bus time and the timestamps of one frame.
+  * @param  pLink Pointer to the link.
+  * @param  Length The number of data bytes of the frame.
+  * @retval None.
+  */
+static void SOCKETCAN_Account(SOCKETCAN_LinkTypeDef *pLink, uint32_t Length)
+{
+  uint64_t bits;
+
+  if (pLink->FdMode == 0U)
+  {
+    bits = SOCKETCAN_FRAME_BITS + (8U * (uint64_t)Length);
+
+    pLink->BusTime += (bits * 1000000000U) / pLink->BitRate;
+  }
+  else
+  {
+    bits = SOCKETCAN_FD_DATA_BITS + (8U * (uint64_t)Length) + ((Length > 16U) ? SOCKETCAN_FD_CRC21_BITS : 0U);
+
+    pLink->BusTime += ((uint64_t)SOCKETCAN_FD_ARBITRATION_BITS * 1000000000U) / pLink->BitRate;
+    pLink->BusTime += (bits * 1000000000U) / pLink->DataBitRate;
+  }
+
+  pLink->LastFrameTime = SOCKETCAN_GetTime();
+
+  if (pLink->FirstFrameTime == 0U)
+  {
+    pLink->FirstFrameTime = pLink->LastFrameTime;
+  }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to open the raw CAN socket of a link.
+  *         Only the standard data frames are received, the CAN FD links also drop the classic frames
+  *         so that a CAN and a FDCAN interface can share the same network interface.
+  * @param  pLink Pointer to the link, its name and its mode are set by the caller.
+  * @retval None.
+  */
+void SOCKETCAN_Open(SOCKETCAN_LinkTypeDef *pLink)
+{
+  struct sockaddr_can address;
+  struct can_filter filter;
+  int enable = 1;
+
+  /* The link stays open when the interface is configured again, after a speed change for instance */
+  if ((pLink->pName != NULL) && (pLink->Socket < 0))
+  {
+    (void)memset(&address, 0, sizeof(address));
+
+    address.can_family  = AF_CAN;
+    address.can_ifindex = (int)if_nametoindex(pLink->pName);
+
+    filter.can_id   = 0U;
+    filter.can_mask = CAN_EFF_FLAG | CAN_RTR_FLAG;
+
+    pLink->Socket = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+
+    if ((pLink->Socket < 0) || (address.can_ifindex == 0)
+        || (setsockopt(pLink->Socket, SOL_CAN_RAW, CAN_RAW_FILTER, &filter, sizeof(filter)) != 0)
+        || ((pLink->FdMode == 1U)
+            && (setsockopt(pLink->Socket, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable)) != 0))
+        || (bind(pLink->Socket, (struct sockaddr *)&address, sizeof(address)) != 0))
+    {
+      (void)fprintf(stderr, "%s on %s: %s\n", (pLink->FdMode == 1U) ? "FDCAN" : "CAN", pLink->pName,
+                    (address.can_ifindex == 0) ? "no such interface" : strerror(errno));
+      exit(EXIT_FAILURE);
+    }
+
+    (void)printf("%s on %s\n", (pLink->FdMode == 1U) ? "FDCAN" : "CAN", pLink->pName);
+    (void)fflush(stdout);
+  }
+}
+
+/**
+  * @brief  This function is used to close the socket of a link.
+  * @param  pLink Pointer to the link.
+  * @retval None.
+  */
+void SOCKETCAN_Close(SOCKETCAN_LinkTypeDef *pLink)
+{
+  if (pLink->Socket >= 0)
+  {
+    (void)close(pLink->Socket);
+    pLink->Socket = -1;
+  }
+}
+
+/**
+  * @brief  This function is used to check, without waiting, whether a frame was received.
+  * @param  pLink Pointer to the link.
+  * @retval Returns 1 if a frame can be read else 0.
+  */
+uint8_t SOCKETCAN_Pending(SOCKETCAN_LinkTypeDef *pLink)
+{
+  struct canfd_frame frame;
+  ssize_t length = -1;
+
+  if (pLink->Socket >= 0)
+  {
+    length = recv(pLink->Socket, &frame, sizeof(frame), MSG_PEEK | MSG_DONTWAIT);
+
+    /* Drop the classic frames received by a CAN FD link */
+    while ((pLink->FdMode == 1U) && (length == (ssize_t)CAN_MTU))
+    {
+      (void)recv(pLink->Socket, &frame, sizeof(frame), MSG_DONTWAIT);
+
+      length = recv(pLink->Socket, &frame, sizeof(frame), MSG_PEEK | MSG_DONTWAIT);
+    }
+  }
+
+  return (length > 0) ? 1U : 0U;
+}
+
+/**
+  * @brief  This function is used to read one frame, waiting for it.
+  * @param  pLink Pointer to the link.
+  * @param  pIdentifier Pointer where the frame identifier is stored, NULL if not needed.
+  * @param  pBuffer Pointer to the buffer where the frame data is stored.
+  * @param  Size The size of the buffer, the data exceeding it is dropped.
+  * @retval Returns the number of data bytes of the frame.
+  */
+uint32_t SOCKETCAN_Read(SOCKETCAN_LinkTypeDef *pLink, uint32_t *pIdentifier, uint8_t *pBuffer, uint32_t Size)
+{
+  struct canfd_frame frame;
+  ssize_t length = 0;
+
+  while (length != (ssize_t)((pLink->FdMode == 1U) ? CANFD_MTU : CAN_MTU))
+  {
+    length = read(pLink->Socket, &frame, sizeof(frame));
+
+    if ((length < 0) && (errno != EINTR))
+    {
+      perror("CAN read");
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  pLink->Identifier = frame.can_id & CAN_SFF_MASK;
+  pLink->FramesReceived++;
+  pLink->BytesReceived += frame.len;
+
+  SOCKETCAN_Account(pLink, frame.len);
+
+  if (pIdentifier != NULL)
+  {
+    *pIdentifier = pLink->Identifier;
+  }
+
+  (void)memcpy(pBuffer, frame.data, (frame.len < Size) ? frame.len : Size);
+
+  return frame.len;
+}
+
+/**
+  * @brief  This function is used to send one frame, its identifier is the one of the last received frame.
+  *         The CAN FD frames are padded to the next valid length and use the bit rate switching.
+  * @param  pLink Pointer to the link.
+  * @param  pBuffer Pointer to the frame data.
+  * @param  Length The number of data bytes, up to the frame size of the link.
+  * @retval None.
+  */
+void SOCKETCAN_Write(SOCKETCAN_LinkTypeDef *pLink, const uint8_t *pBuffer, uint32_t Length)
+{
+  struct canfd_frame frame;
+  struct pollfd poll_fd;
+  size_t size;
+  ssize_t length = -1;
+
+  (void)memset(&frame, SOCKETCAN_PADDING_BYTE, sizeof(frame));
+
+  frame.can_id = pLink->Identifier;
+
+  if (pLink->FdMode == 0U)
+  {
+    frame.len = (uint8_t)((Length < SOCKETCAN_FRAME_SIZE) ? Length : SOCKETCAN_FRAME_SIZE);
+    size      = CAN_MTU;
+  }
+  else
+  {
+    frame.len   = (uint8_t)SOCKETCAN_FdLength(Length);
+    frame.flags = CANFD_BRS;
+    size        = CANFD_MTU;
+  }
+
+  (void)memcpy(frame.data, pBuffer, (Length < frame.len) ? Length : frame.len);
+
+  while (length != (ssize_t)size)
+  {
+    length = write(pLink->Socket, &frame, size);
+
+    /* The transmit queue of a real controller may be full, wait until it can take the frame */
+    if ((length < 0) && (errno == ENOBUFS))
+    {
+      poll_fd.fd     = pLink->Socket;
+      poll_fd.events = POLLOUT;
+
+      (void)poll(&poll_fd, 1U, 1);
+    }
+    else if ((length < 0) && (errno != EINTR) && (errno != EAGAIN))
+    {
+      perror("CAN write");
+      exit(EXIT_FAILURE);
+    }
+    else
+    {
+      /* Sent, or interrupted and retried */
+    }
+  }
+
+  pLink->FramesSent++;
+  pLink->BytesSent += frame.len;
+
+  SOCKETCAN_Account(pLink, frame.len);
+}
+
+/**
+  * @brief  This function is used to print the frame counts, the bus load and the throughput of a link.
+  *         The bus load is the bus time of the frames over the time between the first and the last frame.
+  * @param  pLink Pointer to the link.
+  * @retval None.
+  */
+void SOCKETCAN_Report(const SOCKETCAN_LinkTypeDef *pLink)
+{
+  double elapsed;
+
+  if ((pLink->FramesReceived + pLink->FramesSent) != 0U)
+  {
+    elapsed = (double)(pLink->LastFrameTime - pLink->FirstFrameTime) / 1e9;
+
+    (void)printf("%s on %s: %u frames received (%llu bytes), %u frames sent (%llu bytes), bus time %.1f ms",
+                 (pLink->FdMode == 1U) ? "FDCAN" : "CAN", pLink->pName,
+                 (unsigned int)pLink->FramesReceived, (unsigned long long)pLink->BytesReceived,
+                 (unsigned int)pLink->FramesSent, (unsigned long long)pLink->BytesSent,
+                 (double)pLink->BusTime / 1e6);
+
+    if (elapsed > 0.0)
+    {
+      (void)printf(" in %.3f s, bus load %.1f %%, %.1f KB/s", elapsed,
+                   ((double)pLink->BusTime / 1e7) / elapsed,
+                   ((double)(pLink->BytesReceived + pLink->BytesSent) / 1024.0) / elapsed);
+    }
+
+    (void)printf("\n");
+    (void)fflush(stdout);
+  }
+}
@@ -0,0 +1,65 @@
+/**
+  ******************************************************************************
+  * @file    socketcan_link.h
+  * @author  MCD Application Team
+  * @brief   Header for socketcan_link.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SOCKETCAN_LINK_H
+#define SOCKETCAN_LINK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  const char *pName;                /* Network interface name, NULL when the link is not used */
+  int Socket;                       /* Raw CAN socket, -1 when closed */
+  uint8_t FdMode;                   /* 1 to exchange CAN FD frames with bit rate switching, 0 for classic frames */
+  uint32_t BitRate;                 /* Nominal bit rate, used for the bus time statistics */
+  uint32_t DataBitRate;             /* CAN FD data phase bit rate, used for the bus time statistics */
+  uint32_t Identifier;              /* Identifier of the last received frame, used for the responses */
+  uint32_t FramesReceived;
+  uint32_t FramesSent;
+  uint64_t BytesReceived;           /* Data bytes of the received frames */
+  uint64_t BytesSent;               /* Data bytes of the sent frames, padding included */
+  uint64_t BusTime;                 /* Time the frames took on the bus in ns, without stuff bits */
+  uint64_t FirstFrameTime;          /* Monotonic time of the first frame in ns */
+  uint64_t LastFrameTime;           /* Monotonic time of the last frame in ns */
+} SOCKETCAN_LinkTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+#define SOCKETCAN_FRAME_SIZE              8U        /* Data bytes of a classic CAN frame */
+#define SOCKETCAN_FD_FRAME_SIZE           64U       /* Data bytes of a CAN FD frame */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void SOCKETCAN_Open(SOCKETCAN_LinkTypeDef *pLink);
+void SOCKETCAN_Close(SOCKETCAN_LinkTypeDef *pLink);
+uint8_t SOCKETCAN_Pending(SOCKETCAN_LinkTypeDef *pLink);
+uint32_t SOCKETCAN_Read(SOCKETCAN_LinkTypeDef *pLink, uint32_t *pIdentifier, uint8_t *pBuffer, uint32_t Size);
+void SOCKETCAN_Write(SOCKETCAN_LinkTypeDef *pLink, const uint8_t *pBuffer, uint32_t Length);
+void SOCKETCAN_Report(const SOCKETCAN_LinkTypeDef *pLink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SOCKETCAN_LINK_H */
@@ -0,0 +1,319 @@
+/**
+  ******************************************************************************
+  * @file    usart_interface.c
+  * @author  MCD Application Team
+  * @brief   Contains the simulated USART interface, running over a pseudo-terminal
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "openbl_core.h"
+#include "openbl_usart_cmd.h"
+#include "common_interface.h"
+#include "usart_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define USART_SYNC_BYTE                   0x7FU     /* Synchronization byte sent by the host */
+#define USART_DETECTION_TIMEOUT           10        /* Time in ms waiting for the host in each detection */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint8_t UsartDetected = 0U;
+static int UsartMaster = -1;                        /* Pseudo-terminal side used by the bootloader */
+static int UsartSlave  = -1;                        /* Host side, kept open so that the link survives host reconnections */
+static const char *p_UsartLinkName = NULL;          /* Optional symbolic link to the host side */
+static uint32_t UsartBaudRate = SIM_USART_BAUDRATE;
+
+/* Exported variables --------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void OPENBL_USART_LinkDelay(uint32_t Length);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to wait the time taken by the given number of bytes on the emulated link.
+  * @param  Length The number of bytes.
+  * @retval None.
+  */
+static void OPENBL_USART_LinkDelay(uint32_t Length)
+{
+  if (UsartBaudRate != 0U)
+  {
+    Common_Delay((uint32_t)(((uint64_t)Length * SIM_USART_BITS_PER_BYTE * 1000000U) / UsartBaudRate));
+  }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to select the host side link name and the emulated baudrate.
+  *         It must be called before the USART configuration.
+  * @param  pLinkName Name of the symbolic link created to the pseudo-terminal, NULL for none.
+  * @param  BaudRate The emulated baudrate, 0 for no link delay.
+  * @retval None.
+  */
+void OPENBL_USART_SetLink(const char *pLinkName, uint32_t BaudRate)
+{
+  p_UsartLinkName = pLinkName;
+  UsartBaudRate   = BaudRate;
+}
+
+/**
+  * @brief  This function is used to configure USART pins and then initialize the used USART instance.
+  *         A pseudo-terminal is opened in raw mode, the host tools connect to its slave side.
+  * @retval None.
+  */
+void OPENBL_USART_Configuration(void)
+{
+  struct termios settings;
+  const char *p_name;
+
+  UsartMaster = posix_openpt(O_RDWR | O_NOCTTY);
+
+  if ((UsartMaster < 0) || (grantpt(UsartMaster) != 0) || (unlockpt(UsartMaster) != 0))
+  {
+    perror("USART pseudo-terminal");
+    exit(EXIT_FAILURE);
+  }
+
+  p_name     = ptsname(UsartMaster);
+  UsartSlave = open(p_name, O_RDWR | O_NOCTTY);
+
+  if ((UsartSlave >= 0) && (tcgetattr(UsartSlave, &settings) == 0))
+  {
+    cfmakeraw(&settings);
+    (void)tcsetattr(UsartSlave, TCSANOW, &settings);
+  }
+
+  if (p_UsartLinkName != NULL)
+  {
+    (void)unlink(p_UsartLinkName);
+
+    if (symlink(p_name, p_UsartLinkName) != 0)
+    {
+      perror("USART link");
+    }
+  }
+
+  (void)printf("USART on %s\n", p_name);
+  (void)fflush(stdout);
+}
+
+/**
+  * @brief  This function is used to De-initialize the USART pins and instance.
+  * @retval None.
+  */
+void OPENBL_USART_DeInit(void)
+{
+  /* Only de-initialize the USART if it is not the current detected interface */
+  if (UsartDetected == 0U)
+  {
+    if (p_UsartLinkName != NULL)
+    {
+      (void)unlink(p_UsartLinkName);
+    }
+
+    if (UsartSlave >= 0)
+    {
+      (void)close(UsartSlave);
+      UsartSlave = -1;
+    }
+
+    if (UsartMaster >= 0)
+    {
+      (void)close(UsartMaster);
+      UsartMaster = -1;
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to detect if there is any activity on USART protocol.
+  * @retval Returns 1 if interface is detected else 0.
+  */
+uint8_t OPENBL_USART_ProtocolDetection(void)
+{
+  struct pollfd poll_fd;
+  uint8_t byte;
+
+  UsartDetected = 0U;
+
+  poll_fd.fd     = UsartMaster;
+  poll_fd.events = POLLIN;
+
+  /* Check if the host sent the synchronization byte */
+  if ((poll(&poll_fd, 1U, USART_DETECTION_TIMEOUT) == 1) && ((poll_fd.revents & POLLIN) != 0))
+  {
+    if ((read(UsartMaster, &byte, 1U) == 1) && (byte == USART_SYNC_BYTE))
+    {
+      /* Acknowledge the host */
+      OPENBL_USART_SendByte(ACK_BYTE);
+
+      UsartDetected = 1U;
+    }
+  }
+
+  return UsartDetected;
+}
+
+/**
+  * @brief  This function is used to get the command opcode from the host.
+  * @retval Returns the command.
+  */
+uint8_t OPENBL_USART_GetCommandOpcode(void)
+{
+  uint8_t command_opc = 0x0;
+
+  /* Get the command opcode */
+  command_opc = OPENBL_USART_ReadByte();
+
+  /* Check the data integrity */
+  if ((command_opc ^ OPENBL_USART_ReadByte()) != 0xFF)
+  {
+    command_opc = ERROR_COMMAND;
+  }
+
+  return command_opc;
+}
+
+/**
+  * @brief  This function is used to read one byte from USART pipe.
+  * @retval Returns the read byte.
+  */
+uint8_t OPENBL_USART_ReadByte(void)
+{
+  uint8_t byte = 0U;
+
+  OPENBL_USART_ReadBytes(&byte, 1U);
+
+  return byte;
+}
+
+/**
+  * @brief  This function is used to send one byte through USART pipe.
+  * @param  Byte The byte to be sent.
+  * @retval None.
+  */
+void OPENBL_USART_SendByte(uint8_t Byte)
+{
+  OPENBL_USART_SendBytes(&Byte, 1U);
+}
+
+/**
+  * @brief  This function is used to read bytes from USART pipe.
+  * @param  pBuffer Pointer to the buffer where the read bytes are stored.
+  * @param  BufferSize The number of bytes to be read.
+  * @retval None.
+  */
+void OPENBL_USART_ReadBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+  uint32_t counter = 0U;
+  ssize_t length;
+
+  while (counter < BufferSize)
+  {
+    length = read(UsartMaster, &pBuffer[counter], BufferSize - counter);
+
+    if (length > 0)
+    {
+      counter += (uint32_t)length;
+    }
+    else if ((length < 0) && (errno != EINTR) && (errno != EAGAIN))
+    {
+      perror("USART read");
+      exit(EXIT_FAILURE);
+    }
+    else
+    {
+      /* Interrupted, retry */
+    }
+  }
+
+  OPENBL_USART_LinkDelay(BufferSize);
+}
+
+/**
+  * @brief  This function is used to send bytes through USART pipe.
+  * @param  pBuffer Pointer to the buffer to be sent.
+  * @param  BufferSize The number of bytes to be sent.
+  * @retval None.
+  */
+void OPENBL_USART_SendBytes(uint8_t *pBuffer, uint32_t BufferSize)
+{
+  uint32_t counter = 0U;
+  ssize_t length;
+
+  OPENBL_USART_LinkDelay(BufferSize);
+
+  while (counter < BufferSize)
+  {
+    length = write(UsartMaster, &pBuffer[counter], BufferSize - counter);
+
+    if (length > 0)
+    {
+      counter += (uint32_t)length;
+    }
+    else if ((length < 0) && (errno != EINTR) && (errno != EAGAIN))
+    {
+      perror("USART write");
+      exit(EXIT_FAILURE);
+    }
+    else
+    {
+      /* Interrupted, retry */
+    }
+  }
+}
+
+/**
+  * @brief  This function is used to process and execute the special commands.
+  *         The user must define the special commands routine here.
+  * @param  SpecialCmd Pointer to the OPENBL_SpecialCmdTypeDef structure.
+  * @retval Returns NACK status in case of error else returns ACK status.
+  */
+void OPENBL_USART_SpecialCommandProcess(OPENBL_SpecialCmdTypeDef *SpecialCmd)
+{
+  switch (SpecialCmd->OpCode)
+  {
+    /* Unknown command opcode */
+    default:
+      if (SpecialCmd->CmdType == OPENBL_SPECIAL_CMD)
+      {
+        /* Send NULL data size */
+        OPENBL_USART_SendByte(0x00U);
+        OPENBL_USART_SendByte(0x00U);
+
+        /* Send NULL status size */
+        OPENBL_USART_SendByte(0x00U);
+        OPENBL_USART_SendByte(0x00U);
+      }
+      else if (SpecialCmd->CmdType == OPENBL_EXTENDED_SPECIAL_CMD)
+      {
+        /* Send NULL status size */
+        OPENBL_USART_SendByte(0x00U);
+        OPENBL_USART_SendByte(0x00U);
+      }
+      break;
+  }
+}
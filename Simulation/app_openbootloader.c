@@ -0,0 +1,162 @@
+/**
+  ******************************************************************************
+  * @file    app_openbootloader.c
+  * @author  MCD Application Team
+  * @brief   Open Bootloader application of the host simulation
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+#include "openbl_core.h"
+#include "openbl_mem.h"
+#include "openbl_usart_cmd.h"
+#include "openbl_can_cmd.h"
+#include "openbl_fdcan_cmd.h"
+#include "app_openbootloader.h"
+#include "usart_interface.h"
+#include "can_interface.h"
+#include "fdcan_interface.h"
+#include "flash_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static OPENBL_HandleTypeDef USART_Handle;
+static OPENBL_HandleTypeDef CAN_Handle;
+static OPENBL_HandleTypeDef FDCAN_Handle;
+
+static OPENBL_OpsTypeDef USART_Ops =
+{
+  OPENBL_USART_Configuration,
+  OPENBL_USART_DeInit,
+  OPENBL_USART_ProtocolDetection,
+  OPENBL_USART_GetCommandOpcode,
+  OPENBL_USART_SendByte,
+  NULL,
+  NULL
+};
+
+static OPENBL_OpsTypeDef CAN_Ops =
+{
+  OPENBL_CAN_Configuration,
+  OPENBL_CAN_DeInit,
+  OPENBL_CAN_ProtocolDetection,
+  OPENBL_CAN_GetCommandOpcode,
+  OPENBL_CAN_SendByte,
+  NULL,
+  NULL
+};
+
+static OPENBL_OpsTypeDef FDCAN_Ops =
+{
+  OPENBL_FDCAN_Configuration,
+  OPENBL_FDCAN_DeInit,
+  OPENBL_FDCAN_ProtocolDetection,
+  OPENBL_FDCAN_GetCommandOpcode,
+  OPENBL_FDCAN_SendByte,
+  NULL,
+  NULL
+};
+
+/* Exported variables --------------------------------------------------------*/
+extern OPENBL_MemoryTypeDef FLASH_Descriptor;
+extern OPENBL_MemoryTypeDef RAM_Descriptor;
+extern OPENBL_MemoryTypeDef OB_Descriptor;
+
+uint16_t SpecialCmdList[SPECIAL_CMD_MAX_NUMBER] =
+{
+  SPECIAL_CMD_DEFAULT
+};
+
+uint16_t ExtendedSpecialCmdList[EXTENDED_SPECIAL_CMD_MAX_NUMBER] =
+{
+  EXTENDED_SPECIAL_CMD_DEFAULT
+};
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Initialize open Bootloader.
+  * @retval None.
+  */
+void OpenBootloader_Init(void)
+{
+  /* Register USART interfaces */
+  USART_Handle.p_Ops = &USART_Ops;
+  USART_Handle.p_Cmd = OPENBL_USART_GetCommandsList();
+
+  (void)OPENBL_RegisterInterface(&USART_Handle);
+
+  /* Register CAN interfaces, only detected when a SocketCAN interface is selected */
+  CAN_Handle.p_Ops = &CAN_Ops;
+  CAN_Handle.p_Cmd = OPENBL_CAN_GetCommandsList();
+
+  (void)OPENBL_RegisterInterface(&CAN_Handle);
+
+  /* Register FDCAN interfaces, only detected when a SocketCAN interface is selected */
+  FDCAN_Handle.p_Ops = &FDCAN_Ops;
+  FDCAN_Handle.p_Cmd = OPENBL_FDCAN_GetCommandsList();
+
+  (void)OPENBL_RegisterInterface(&FDCAN_Handle);
+
+  /* Initialize interfaces */
+  OPENBL_Init();
+
+  /* Register memories */
+  (void)OPENBL_MEM_RegisterMemory(&FLASH_Descriptor);
+  (void)OPENBL_MEM_RegisterMemory(&RAM_Descriptor);
+  (void)OPENBL_MEM_RegisterMemory(&OB_Descriptor);
+}
+
+/**
+  * @brief  DeInitialize open Bootloader.
+  * @retval None.
+  */
+void OpenBootloader_DeInit(void)
+{
+  OPENBL_CAN_PrintStatistics();
+  OPENBL_FDCAN_PrintStatistics();
+
+  OPENBL_InterfacesDeInit();
+
+  OPENBL_FLASH_Close();
+}
+
+/**
+  * @brief  This function is used to select which protocol will be used when communicating with the host.
+  * @retval None.
+  */
+void OpenBootloader_ProtocolDetection(void)
+{
+  static uint32_t interface_detected = 0U;
+
+  if (interface_detected == 0U)
+  {
+    interface_detected = OPENBL_InterfaceDetection();
+
+    /* De-initialize the interfaces that are not detected */
+    if (interface_detected == 1U)
+    {
+      OPENBL_InterfacesDeInit();
+    }
+  }
+
+  if (interface_detected == 1U)
+  {
+    OPENBL_CommandProcess();
+  }
+}
@@ -0,0 +1,52 @@
+/**
+  ******************************************************************************
+  * @file    app_openbootloader.h
+  * @author  MCD Application Team
+  * @brief   Header for app_openbootloader.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef APP_OPENBOOTLOADER_H
+#define APP_OPENBOOTLOADER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "openbl_core.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+#define SPECIAL_CMD_MAX_NUMBER            1U   /* Number of special commands */
+#define EXTENDED_SPECIAL_CMD_MAX_NUMBER   1U   /* Number of extended special commands */
+
+#define SPECIAL_CMD_DEFAULT               0x0102U  /* Special command example, not processed */
+#define EXTENDED_SPECIAL_CMD_DEFAULT      0x0102U  /* Extended special command example, not processed */
+
+/* Exported variables --------------------------------------------------------*/
+extern uint16_t SpecialCmdList[SPECIAL_CMD_MAX_NUMBER];
+extern uint16_t ExtendedSpecialCmdList[EXTENDED_SPECIAL_CMD_MAX_NUMBER];
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void OpenBootloader_Init(void);
+void OpenBootloader_DeInit(void);
+void OpenBootloader_ProtocolDetection(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* APP_OPENBOOTLOADER_H */
@@ -0,0 +1,52 @@
+/**
+  ******************************************************************************
+  * @file    interfaces_conf.h
+  * @author  MCD Application Team
+  * @brief   Contains Interfaces configuration of the host simulation
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INTERFACES_CONF_H
+#define INTERFACES_CONF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#define MEMORIES_SUPPORTED                4U
+
+/*----------------------- Definitions for simulated Flash --------------------*/
+#define SIM_FLASH_FILE                    "openbl_flash.bin"  /* Default file backing the Flash */
+#define SIM_FLASH_PAGE_SIZE               8192U   /* Default page size */
+#define SIM_FLASH_ERASE_TIME              1500U   /* Default page erase time in us */
+#define SIM_FLASH_PROGRAM_TIME            60U     /* Default programming time of one quad-word (16 bytes) in us */
+#define SIM_FLASH_PROGRAM_UNIT            16U     /* Programming unit in bytes */
+
+/*----------------------- Definitions for simulated USART --------------------*/
+#define SIM_USART_BAUDRATE                0U      /* Default emulated baudrate, 0 for no link delay */
+#define SIM_USART_BITS_PER_BYTE           11U     /* Start bit, 8 data bits, even parity and stop bit */
+
+/*----------------------- Definitions for SocketCAN --------------------------*/
+#define SIM_CAN_BITRATE                   1000000U  /* Default nominal bit rate of the CAN and FDCAN buses */
+#define SIM_FDCAN_DATA_BITRATE            8000000U  /* Default data phase bit rate of the FDCAN bus */
+
+/*------------------------ Definitions for the cycle counter -----------------*/
+#define SIM_CYCLE_FREQUENCY               10000000U /* The host monotonic clock is counted in 100 ns cycles */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* INTERFACES_CONF_H */
@@ -0,0 +1,191 @@
+/**
+  ******************************************************************************
+  * @file    main.c
+  * @author  MCD Application Team
+  * @brief   Main program of the Open Bootloader host simulation
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "platform.h"
+#include "interfaces_conf.h"
+#include "app_openbootloader.h"
+#include "common_interface.h"
+#include "flash_interface.h"
+#include "usart_interface.h"
+#include "can_interface.h"
+#include "fdcan_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static void Usage(const char *pName);
+static void Terminate(int Signal);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Print the command line options.
+  * @param  pName The program name.
+  * @retval None.
+  */
+static void Usage(const char *pName)
+{
+  (void)fprintf(stderr,
+                "Usage: %s [options]\n"
+                "  -f file   Flash backing file (default %s)\n"
+                "  -p size   Flash page size in bytes (default %u)\n"
+                "  -e time   Page erase time in us (default %u)\n"
+                "  -w time   Programming time of %u bytes in us (default %u)\n"
+                "  -b baud   Emulated USART baudrate, 0 for none (default %u)\n"
+                "  -l link   Symbolic link created to the USART pseudo-terminal\n"
+                "  -c name   SocketCAN interface of the CAN, vcan0 for instance\n"
+                "  -d name   SocketCAN interface of the FDCAN, it may be the same as the CAN one\n"
+                "  -r rate   CAN nominal bit rate for the bus load statistics (default %u)\n"
+                "  -R rate   FDCAN data bit rate for the bus load statistics (default %u)\n"
+                "  -n id     Node identifier used by the group commands (default 0x%08X)\n"
+                "  -a        No boot request, a valid application in Flash is started (fast boot)\n",
+                pName, SIM_FLASH_FILE, SIM_FLASH_PAGE_SIZE, SIM_FLASH_ERASE_TIME,
+                SIM_FLASH_PROGRAM_UNIT, SIM_FLASH_PROGRAM_TIME, SIM_USART_BAUDRATE,
+                SIM_CAN_BITRATE, SIM_FDCAN_DATA_BITRATE, (unsigned int)Common_GetNodeId());
+}
+
+/**
+  * @brief  Release the simulation resources when the process is stopped.
+  * @param  Signal The received signal.
+  * @retval None.
+  */
+static void Terminate(int Signal)
+{
+  (void)Signal;
+
+  OpenBootloader_DeInit();
+
+  _exit(EXIT_SUCCESS);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Main program.
+  * @param  argc The number of arguments.
+  * @param  argv The arguments.
+  * @retval Returns EXIT_FAILURE on a configuration error, the bootloader loop does not return.
+  */
+int main(int argc, char *argv[])
+{
+  const char *p_file = SIM_FLASH_FILE;
+  const char *p_link = NULL;
+  const char *p_can = NULL;
+  const char *p_fdcan = NULL;
+  uint32_t page_size = SIM_FLASH_PAGE_SIZE;
+  uint32_t erase_time = SIM_FLASH_ERASE_TIME;
+  uint32_t program_time = SIM_FLASH_PROGRAM_TIME;
+  uint32_t baudrate = SIM_USART_BAUDRATE;
+  uint32_t bitrate = SIM_CAN_BITRATE;
+  uint32_t data_bitrate = SIM_FDCAN_DATA_BITRATE;
+  int option;
+
+  while ((option = getopt(argc, argv, "f:p:e:w:b:l:c:d:r:R:n:ah")) != -1)
+  {
+    switch (option)
+    {
+      case 'f':
+        p_file = optarg;
+        break;
+
+      case 'p':
+        page_size = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'e':
+        erase_time = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'w':
+        program_time = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'b':
+        baudrate = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'l':
+        p_link = optarg;
+        break;
+
+      case 'c':
+        p_can = optarg;
+        break;
+
+      case 'd':
+        p_fdcan = optarg;
+        break;
+
+      case 'r':
+        bitrate = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'R':
+        data_bitrate = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+
+      case 'n':
+        Common_SetNodeId((uint32_t)strtoul(optarg, NULL, 0));
+        break;
+
+      case 'a':
+        Common_SetBootRequest(RESET);
+        break;
+
+      default:
+        Usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+
+  if ((bitrate == 0U) || (data_bitrate == 0U))
+  {
+    Usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (OPENBL_FLASH_Open(p_file, page_size) != SUCCESS)
+  {
+    (void)fprintf(stderr, "Cannot open %s with %u-byte pages\n", p_file, (unsigned int)page_size);
+    return EXIT_FAILURE;
+  }
+
+  OPENBL_FLASH_SetTiming(erase_time, program_time);
+  OPENBL_USART_SetLink(p_link, baudrate);
+  OPENBL_CAN_SetLink(p_can, bitrate);
+  OPENBL_FDCAN_SetLink(p_fdcan, bitrate, data_bitrate);
+
+  (void)signal(SIGINT, Terminate);
+  (void)signal(SIGTERM, Terminate);
+
+  /* Initialize the Open Bootloader */
+  OpenBootloader_Init();
+
+  while (1)
+  {
+    OpenBootloader_ProtocolDetection();
+  }
+}
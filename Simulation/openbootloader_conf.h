@@ -0,0 +1,128 @@
+/**
+  ******************************************************************************
+  * @file    openbootloader_conf.h
+  * @author  MCD Application Team
+  * @brief   Contains Open Bootloader configuration of the host simulation
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OPENBOOTLOADER_CONF_H
+#define OPENBOOTLOADER_CONF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include "platform.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+
+/* -------------------------------- Device ID ------------------------------- */
+#define DEVICE_ID_MSB                     0x04U  /* MSB byte of device ID */
+#define DEVICE_ID_LSB                     0x82U  /* LSB byte of device ID */
+
+/* -------------------------- Definitions for Memories ---------------------- */
+#define FLASH_MEM_SIZE                    (2048U * 1024U)                 /* Size of simulated Flash 2 MByte */
+#define FLASH_START_ADDRESS               0x08000000U                     /* Flash start address */
+#define FLASH_END_ADDRESS                 (FLASH_BASE + FLASH_MEM_SIZE)   /* Flash end address */
+#define FLASH_BANK_SIZE                   (FLASH_MEM_SIZE / 2U)           /* Two banks of 1 MByte */
+
+#define RAM_SIZE                          (256U * 1024U)                  /* Size of simulated RAM 256 kByte */
+#define RAM_START_ADDRESS                 0x20000000U                     /* SRAM start address  */
+#define RAM_END_ADDRESS                   (RAM_START_ADDRESS + RAM_SIZE)  /* SRAM end address */
+
+#define OB_SIZE                           432U                            /* Size of OB 432 Byte */
+#define OB_START_ADDRESS                  0x40022050U                     /* Option bytes registers address */
+#define OB_END_ADDRESS                    (OB_START_ADDRESS + OB_SIZE)    /* Option bytes end address */
+
+#define OTP_SIZE                          (2U * 1024U)                    /* Size of OTP 2048 Byte */
+#define OTP_START_ADDRESS                 0x08FFF000U                     /* OTP start address */
+#define OTP_END_ADDRESS                   (OTP_START_ADDRESS + OTP_SIZE)  /* OTP end address */
+
+#define ICP_SIZE                          (35U * 1024U)                   /* Size of ICP 35 kByte */
+#define ICP_START_ADDRESS                 0x0BF97000U                     /* System memory start address */
+#define ICP_END_ADDRESS                   (ICP_START_ADDRESS + ICP_SIZE)  /* System memory end address */
+
+#define EB_SIZE                           156U                            /* Size of Engi bytes 156 Byte */
+#define EB_START_ADDRESS                  0x40022400U                     /* Engi bytes start address */
+#define EB_END_ADDRESS                    (EB_START_ADDRESS + EB_SIZE)    /* Engi bytes end address */
+
+#define OPENBL_RAM_SIZE                   0xF800U   /* RAM used by the Open Bootloader 63488 Bytes */
+
+#define OPENBL_BUFFER_ARENA_SIZE          4096U     /* Command buffer shared by the interfaces (>= 4096 for USB bulk) */
+
+#define FLASH_PROGRAM_TIME_PER_KB         10U       /* Typical time in ms to program 1 kByte of Flash */
+
+#define OPENBL_DEFAULT_MEM                FLASH_START_ADDRESS  /* Used for Erase and Write protect CMDs */
+
+#define RDP_LEVEL_0                       OB_RDP_LEVEL_0
+#define RDP_LEVEL_1                       OB_RDP_LEVEL_1
+#define RDP_LEVEL_2                       OB_RDP_LEVEL_2
+
+#define AREA_ERROR                        0x0U  /* Error Address Area */
+#define FLASH_AREA                        0x1U  /* Flash Address Area */
+#define RAM_AREA                          0x2U  /* RAM Address area */
+#define OB_AREA                           0x3U  /* Option bytes Address area */
+#define OTP_AREA                          0x4U  /* OTP Address area */
+#define ICP_AREA                          0x5U  /* System memory area */
+#define EB_AREA                           0x6U  /* Engi bytes Address area */
+
+#define FLASH_MASS_ERASE                  0xFFFF
+#define FLASH_BANK1_ERASE                 0xFFFE
+#define FLASH_BANK2_ERASE                 0xFFFD
+
+#define INTERFACES_SUPPORTED              7U        /* The benchmark registers all the simulated interfaces */
+
+/* ------------------------------ Lazy init --------------------------------- */
+#define OPENBL_LAZY_INIT                  0U        /* 1: initialize an interface only once activity is seen on its pins */
+
+/* ------------------------------ Fast boot --------------------------------- */
+#define OPENBL_FAST_BOOT                  1U        /* Only without boot request, see the -a option */
+#define OPENBL_APP_ADDRESS                FLASH_START_ADDRESS  /* Address of the application vector table */
+#define OPENBL_APP_CRC_CHECK              0U        /* 1: also check the application CRC-32 stored in its marker */
+#define OPENBL_APP_MARKER_ADDRESS         (FLASH_END_ADDRESS - 16U) /* Application marker [magic, size, CRC-32, reserved] */
+#define OPENBL_APP_MARKER_MAGIC           0x41424C4FU  /* Application marker magic number "OLBA" */
+#define OPENBL_BOOT_REQUEST_MAGIC         0x424F4F54U  /* Boot request magic number */
+
+/* ------------------------------ Statistics -------------------------------- */
+#define OPENBL_PERF_ENABLE                1U        /* 1: record the command latencies, read by the Get Statistics command */
+#define OPENBL_PERF_CMD_SLOTS             16U       /* Number of commands with their own statistics */
+#define OPENBL_PERF_HIST_BUCKETS          8U        /* Number of latency histogram buckets */
+#define OPENBL_PERF_HIST_FIRST_LIMIT      1024U     /* Cycles limit of the first bucket, x4 for each next one */
+
+/* ------------------------------ RAM staging ------------------------------- */
+#define OPENBL_STAGING_ENABLE             1U        /* 1: Commit Memory command programming the Flash from an image staged in RAM */
+#define OPENBL_STAGING_ADDRESS            (RAM_START_ADDRESS + OPENBL_RAM_SIZE) /* Image written by the host before its commit */
+#define OPENBL_STAGING_SIZE               (RAM_END_ADDRESS - OPENBL_STAGING_ADDRESS) /* Largest image committed at once */
+
+/* ---------------------------- Compressed write ---------------------------- */
+#define OPENBL_COMPRESSED_WRITE_ENABLE    1U        /* 1: Compressed Write Memory command, LZ4 block format */
+
+/* ------------------------------ Delta patch ------------------------------- */
+#define OPENBL_PATCH_ENABLE               1U        /* 1: Patch Memory command, new image built from the old one */
+
+/* ---------------------------------- CRC ----------------------------------- */
+#define OPENBL_BLOCK_CRC_ENABLE           1U        /* 1: Get Block CRC command, CRC-32 of each block of a memory range */
+#define OPENBL_HW_CRC_ENABLE              1U        /* 1: CRC-32 of the Flash and RAM computed by the CRC unit */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* OPENBOOTLOADER_CONF_H */
@@ -0,0 +1,67 @@
+/**
+  ******************************************************************************
+  * @file    platform.h
+  * @author  MCD Application Team
+  * @brief   Host platform definitions used by the Open Bootloader simulation
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2019-2021 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Exported types ------------------------------------------------------------*/
+/* Same definitions as the STM32 device headers, the Open Bootloader sources rely on them */
+typedef enum
+{
+  RESET = 0U,
+  SET = !RESET
+} FlagStatus, ITStatus;
+
+typedef enum
+{
+  DISABLE = 0U,
+  ENABLE = !DISABLE
+} FunctionalState;
+
+typedef enum
+{
+  SUCCESS = 0U,
+  ERROR = !SUCCESS
+} ErrorStatus;
+
+/* Exported constants --------------------------------------------------------*/
+#define FLASH_BASE                        0x08000000UL
+
+#define OB_RDP_LEVEL_0                    0xAAU
+#define OB_RDP_LEVEL_1                    0xBBU
+#define OB_RDP_LEVEL_2                    0xCCU
+
+/* Exported macro ------------------------------------------------------------*/
+#define __IO                              volatile
+
+/* Exported functions ------------------------------------------------------- */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* PLATFORM_H */